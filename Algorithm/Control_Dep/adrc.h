@@ -62,6 +62,7 @@ typedef struct
     float c;
 } ADRC_NLSEF_Def;
 
+float adrc_fhan(float v1, float v2, float r0, float h0);
 void adrc_td_init(ADRC_TD_Def *td_t, float h, float r0, float h0);
 void adrc_td(ADRC_TD_Def *td, float v);
 void adrc_td_control_init(TD_Controller_Def *td_controller, float h, float r2, float h2);
@@ -2,13 +2,14 @@
  *         WX_S
  */
 #include "pid.h"
+#include "util.h"
 
 /* internal function */
 static bool PID_P_Progress(PIDObj_TypeDef *p_PIDObj, const float diff);
 static bool PID_I_Progress(PIDObj_TypeDef *p_PIDObj, const float diff);
 static bool PID_D_Progress(PIDObj_TypeDef *p_PIDObj, const float diff);
 
-bool PID_Update(PIDObj_TypeDef *p_PIDObj, const float mea_in, const float exp_in)
+ITCM_CODE bool PID_Update(PIDObj_TypeDef *p_PIDObj, const float mea_in, const float exp_in)
 {
     float diff = mea_in - exp_in;
     float out_tmp = 0.0f;
@@ -43,7 +44,7 @@ bool PID_Update(PIDObj_TypeDef *p_PIDObj, const float mea_in, const float exp_in
     return false;
 }
 
-static bool PID_P_Progress(PIDObj_TypeDef *p_PIDObj, const float diff)
+ITCM_CODE static bool PID_P_Progress(PIDObj_TypeDef *p_PIDObj, const float diff)
 {
     float diff_tmp = 0.0f;
     int16_t diff_fractional = 0;
@@ -94,7 +95,7 @@ static bool PID_P_Progress(PIDObj_TypeDef *p_PIDObj, const float diff)
     return false;
 }
 
-static bool PID_I_Progress(PIDObj_TypeDef *p_PIDObj, const float diff)
+ITCM_CODE static bool PID_I_Progress(PIDObj_TypeDef *p_PIDObj, const float diff)
 {
     int16_t gI_Max_Fractical = 0.0f;
     int16_t gI_Min_Fractical = 0.0f;
@@ -146,7 +147,7 @@ static bool PID_I_Progress(PIDObj_TypeDef *p_PIDObj, const float diff)
     return false;
 }
 
-static bool PID_D_Progress(PIDObj_TypeDef *p_PIDObj, const float diff)
+ITCM_CODE static bool PID_D_Progress(PIDObj_TypeDef *p_PIDObj, const float diff)
 {
     if(p_PIDObj)
     {
@@ -0,0 +1,138 @@
+#include "rate_ctl.h"
+#include "util.h"
+
+#pragma GCC diagnostic warning "-Wdouble-promotion"
+
+#define RATE_CTL_PI 3.14159265358979f
+
+/* internal function */
+static inline float RateCtl_Clampf(float x, float min, float max);
+static void RateCtl_Update_ILimit(RateCtl_Obj_TypeDef *obj, uint8_t axis);
+
+/* compiled into compare and conditional select, no branch */
+static inline float RateCtl_Clampf(float x, float min, float max)
+{
+    x = (x < min) ? min : x;
+    return (x > max) ? max : x;
+}
+
+static void RateCtl_Update_ILimit(RateCtl_Obj_TypeDef *obj, uint8_t axis)
+{
+    /* no integral gain then keep integral at zero */
+    if (obj->gI[axis] > 0.0f)
+    {
+        obj->i_lim[axis] = obj->i_max[axis] / obj->gI[axis];
+    }
+    else
+        obj->i_lim[axis] = 0.0f;
+}
+
+bool RateCtl_Init(RateCtl_Obj_TypeDef *obj, float dt)
+{
+    if ((obj == NULL) || (dt <= 0.0f))
+        return false;
+
+    memset(obj, 0, sizeof(RateCtl_Obj_TypeDef));
+    obj->dt = dt;
+    obj->inv_dt = 1.0f / dt;
+
+    /* d term unfiltered by default */
+    for (uint8_t i = 0; i < RATE_CTL_AXIS_NUM; i++)
+        obj->d_lpf_alpha[i] = 1.0f;
+
+    return true;
+}
+
+bool RateCtl_Set_Gain(RateCtl_Obj_TypeDef *obj, uint8_t axis, float gP, float gI, float gD, float gFF)
+{
+    if ((obj == NULL) || (axis >= RATE_CTL_AXIS_NUM))
+        return false;
+
+    obj->gP[axis] = gP;
+    obj->gI[axis] = gI;
+    obj->gD[axis] = gD;
+    obj->gFF[axis] = gFF;
+    RateCtl_Update_ILimit(obj, axis);
+
+    return true;
+}
+
+bool RateCtl_Set_Limit(RateCtl_Obj_TypeDef *obj, uint8_t axis, float i_max, float out_max)
+{
+    if ((obj == NULL) || (axis >= RATE_CTL_AXIS_NUM) || (i_max < 0.0f) || (out_max < 0.0f))
+        return false;
+
+    obj->i_max[axis] = i_max;
+    obj->out_max[axis] = out_max;
+    RateCtl_Update_ILimit(obj, axis);
+
+    return true;
+}
+
+/* first order low pass on d term, cut_freq 0 disable it */
+bool RateCtl_Set_DTermLpf(RateCtl_Obj_TypeDef *obj, uint8_t axis, float cut_freq)
+{
+    float rc = 0.0f;
+
+    if ((obj == NULL) || (axis >= RATE_CTL_AXIS_NUM) || (cut_freq < 0.0f))
+        return false;
+
+    if (cut_freq == 0.0f)
+    {
+        obj->d_lpf_alpha[axis] = 1.0f;
+        return true;
+    }
+
+    rc = 1.0f / (2.0f * RATE_CTL_PI * cut_freq);
+    obj->d_lpf_alpha[axis] = obj->dt / (obj->dt + rc);
+
+    return true;
+}
+
+void RateCtl_Reset(RateCtl_Obj_TypeDef *obj)
+{
+    if (obj == NULL)
+        return;
+
+    obj->mea_valid = false;
+    memset(obj->integral, 0, sizeof(obj->integral));
+    memset(obj->d_lpf, 0, sizeof(obj->d_lpf));
+    memset(obj->sat, 0, sizeof(obj->sat));
+}
+
+ITCM_CODE void RateCtl_Update(RateCtl_Obj_TypeDef *obj, const float *mea, const float *exp)
+{
+    float diff = 0.0f;
+    float d_raw = 0.0f;
+    float i_dt = 0.0f;
+    float out = 0.0f;
+
+    /* no derivative on the first sample after reset */
+    if (!obj->mea_valid)
+    {
+        memcpy(obj->lst_mea, mea, sizeof(obj->lst_mea));
+        obj->mea_valid = true;
+    }
+
+    for (uint8_t i = 0; i < RATE_CTL_AXIS_NUM; i++)
+    {
+        diff = mea[i] - exp[i];
+
+        /* conditional integration: hold while saturated output and diff share the sign */
+        i_dt = ((diff * obj->sat[i]) > 0.0f) ? 0.0f : obj->dt;
+        obj->integral[i] = RateCtl_Clampf(obj->integral[i] + diff * i_dt, -obj->i_lim[i], obj->i_lim[i]);
+
+        d_raw = (mea[i] - obj->lst_mea[i]) * obj->inv_dt;
+        obj->d_lpf[i] += obj->d_lpf_alpha[i] * (d_raw - obj->d_lpf[i]);
+        obj->lst_mea[i] = mea[i];
+
+        obj->P_out[i] = obj->gP[i] * diff;
+        obj->I_out[i] = obj->gI[i] * obj->integral[i];
+        obj->D_out[i] = obj->gD[i] * obj->d_lpf[i];
+        obj->FF_out[i] = -obj->gFF[i] * exp[i];
+
+        out = obj->P_out[i] + obj->I_out[i] + obj->D_out[i] + obj->FF_out[i];
+        obj->sat[i] = (out > obj->out_max[i]) ? 1.0f : ((out < -obj->out_max[i]) ? -1.0f : 0.0f);
+        obj->fout[i] = RateCtl_Clampf(out, -obj->out_max[i], obj->out_max[i]);
+    }
+}
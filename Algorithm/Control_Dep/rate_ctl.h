@@ -0,0 +1,59 @@
+#ifndef __RATE_CTL_H
+#define __RATE_CTL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * 3 axis angular speed controller
+ * all axis updated in one call from struct-of-arrays state, loop body have no data dependent branch
+ * output sign follow PID_Update: computed on diff = measurement - expectation
+ *
+ *      P  = gP * diff
+ *      I  = gI * sum(diff * dt), integral output clamped into [-i_max, i_max]
+ *           integration hold while output saturated and diff push it further
+ *      D  = gD * lpf(d(measurement) / dt), on measurement so setpoint step give no kick
+ *      FF = -gFF * expectation
+ *      out = clamp(P + I + D + FF, -out_max, out_max)
+ */
+#define RATE_CTL_AXIS_NUM 3
+
+typedef struct
+{
+    float dt;       /* unit: S */
+    float inv_dt;
+
+    /* parameter */
+    float gP[RATE_CTL_AXIS_NUM];
+    float gI[RATE_CTL_AXIS_NUM];
+    float gD[RATE_CTL_AXIS_NUM];
+    float gFF[RATE_CTL_AXIS_NUM];
+    float i_max[RATE_CTL_AXIS_NUM];
+    float out_max[RATE_CTL_AXIS_NUM];
+    float d_lpf_alpha[RATE_CTL_AXIS_NUM];
+    float i_lim[RATE_CTL_AXIS_NUM];     /* integral limit derived from i_max / gI */
+
+    /* state */
+    bool mea_valid;
+    float integral[RATE_CTL_AXIS_NUM];
+    float lst_mea[RATE_CTL_AXIS_NUM];
+    float d_lpf[RATE_CTL_AXIS_NUM];
+    float sat[RATE_CTL_AXIS_NUM];   /* sign of last saturation, 0 when unsaturated */
+
+    /* output */
+    float P_out[RATE_CTL_AXIS_NUM];
+    float I_out[RATE_CTL_AXIS_NUM];
+    float D_out[RATE_CTL_AXIS_NUM];
+    float FF_out[RATE_CTL_AXIS_NUM];
+    float fout[RATE_CTL_AXIS_NUM];
+} RateCtl_Obj_TypeDef;
+
+bool RateCtl_Init(RateCtl_Obj_TypeDef *obj, float dt);
+bool RateCtl_Set_Gain(RateCtl_Obj_TypeDef *obj, uint8_t axis, float gP, float gI, float gD, float gFF);
+bool RateCtl_Set_Limit(RateCtl_Obj_TypeDef *obj, uint8_t axis, float i_max, float out_max);
+bool RateCtl_Set_DTermLpf(RateCtl_Obj_TypeDef *obj, uint8_t axis, float cut_freq);
+void RateCtl_Reset(RateCtl_Obj_TypeDef *obj);
+void RateCtl_Update(RateCtl_Obj_TypeDef *obj, const float *mea, const float *exp);
+
+#endif
@@ -3,6 +3,7 @@
  */
 
 #include "filter.h"
+#include "util.h"
 
 /* internal function */
 static void Filter_Item_Update(item_obj **header, item_obj **ender, float cur_data);
@@ -59,7 +60,7 @@ static bool Filter_List_Create(uint8_t order, item_obj *item, list_obj **header,
     return true;
 }
 
-static void Filter_Item_Update(item_obj **header, item_obj **ender, float cur_data)
+ITCM_CODE static void Filter_Item_Update(item_obj **header, item_obj **ender, float cur_data)
 {
     item_obj *i_tmp = NULL;
 
@@ -172,7 +173,7 @@ static BWF_Object_Handle Butterworth_Init(const FilterParam_Obj_TypeDef *param_o
     return (uint32_t)BWF_Obj;
 }
 
-static float Butterworth_Filter_Update(BWF_Object_Handle obj, float cur_e)
+ITCM_CODE static float Butterworth_Filter_Update(BWF_Object_Handle obj, float cur_e)
 {
     Filter_ButterworthParam_TypeDef *filter_obj = NULL;
     item_obj *u_item = NULL;
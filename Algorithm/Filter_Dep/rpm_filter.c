@@ -0,0 +1,121 @@
+#include "rpm_filter.h"
+#include "util.h"
+#include <math.h>
+
+#pragma GCC diagnostic warning "-Wdouble-promotion"
+
+#define RPM_FILTER_PI 3.14159265358979f
+#define RPM_FILTER_NYQUIST_RATIO 0.48f
+#define RPM_FILTER_FADE_HZ 20.0f
+
+/* internal function */
+static void RpmFilter_Update_Moto(RpmFilter_Obj_TypeDef *obj, uint8_t moto);
+
+bool RpmFilter_Init(RpmFilter_Obj_TypeDef *obj, float sample_hz, uint8_t moto_cnt, uint8_t harmonic, float q, float min_hz)
+{
+    if ((obj == NULL) ||
+        (sample_hz <= 0.0f) ||
+        (moto_cnt == 0) || (moto_cnt > RPM_FILTER_MOTO_MAX) ||
+        (harmonic == 0) || (harmonic > RPM_FILTER_HARMONIC_MAX) ||
+        (q <= 0.0f) || (min_hz <= 0.0f))
+        return false;
+
+    memset(obj, 0, sizeof(RpmFilter_Obj_TypeDef));
+
+    obj->sample_hz = sample_hz;
+    obj->q = q;
+    obj->min_hz = min_hz;
+    obj->fade_hz = RPM_FILTER_FADE_HZ;
+    obj->moto_cnt = moto_cnt;
+    obj->harmonic = harmonic;
+
+    /* every notch start bypassed, weight 0 */
+    obj->init = true;
+    return true;
+}
+
+/* called from the rpm source, coefficient refreshed later in apply */
+void RpmFilter_Set_Freq(RpmFilter_Obj_TypeDef *obj, uint8_t moto, float hz)
+{
+    if ((obj == NULL) || !obj->init || (moto >= obj->moto_cnt))
+        return;
+
+    obj->moto_hz[moto] = (hz > 0.0f) ? hz : 0.0f;
+}
+
+/* rbj notch, b0 = b2 = 1 / (1 + alpha), b1 = a1 = -2cos(w0) * b0, a2 = (1 - alpha) * b0 */
+static void RpmFilter_Update_Moto(RpmFilter_Obj_TypeDef *obj, uint8_t moto)
+{
+    RpmFilter_Notch_TypeDef *notch = NULL;
+    float max_hz = obj->sample_hz * RPM_FILTER_NYQUIST_RATIO;
+    float hz = 0.0f;
+    float w0 = 0.0f;
+    float alpha = 0.0f;
+    float weight = 0.0f;
+    float top = 0.0f;
+
+    for (uint8_t h = 0; h < obj->harmonic; h++)
+    {
+        notch = &obj->notch[moto][h];
+        hz = obj->moto_hz[moto] * (float)(h + 1);
+
+        /* out of band, stale state would ring on re-enable so drop it */
+        if ((hz <= obj->min_hz) || (hz >= max_hz))
+        {
+            notch->weight = 0.0f;
+            memset(notch->s1, 0, sizeof(notch->s1));
+            memset(notch->s2, 0, sizeof(notch->s2));
+            continue;
+        }
+
+        /* ramp in above min_hz and out again toward nyquist */
+        weight = (hz - obj->min_hz) / obj->fade_hz;
+        top = (max_hz - hz) / obj->fade_hz;
+        weight = (top < weight) ? top : weight;
+        notch->weight = (weight > 1.0f) ? 1.0f : weight;
+
+        w0 = 2.0f * RPM_FILTER_PI * hz / obj->sample_hz;
+        alpha = sinf(w0) / (2.0f * obj->q);
+
+        notch->b0 = 1.0f / (1.0f + alpha);
+        notch->b1 = -2.0f * cosf(w0) * notch->b0;
+        notch->a2 = (1.0f - alpha) * notch->b0;
+    }
+}
+
+/* gyr filtered in place, direct form 2 transposed, bypassed notch skipped with its state cleared */
+ITCM_CODE void RpmFilter_Apply(RpmFilter_Obj_TypeDef *obj, float *gyr)
+{
+    RpmFilter_Notch_TypeDef *notch = NULL;
+    float in = 0.0f;
+    float out = 0.0f;
+
+    if ((obj == NULL) || !obj->init || (gyr == NULL))
+        return;
+
+    RpmFilter_Update_Moto(obj, obj->update_moto);
+    obj->update_moto ++;
+    if (obj->update_moto >= obj->moto_cnt)
+        obj->update_moto = 0;
+
+    for (uint8_t m = 0; m < obj->moto_cnt; m++)
+    {
+        for (uint8_t h = 0; h < obj->harmonic; h++)
+        {
+            notch = &obj->notch[m][h];
+
+            if (notch->weight <= 0.0f)
+                continue;
+
+            for (uint8_t axis = 0; axis < RPM_FILTER_AXIS_NUM; axis++)
+            {
+                in = gyr[axis];
+                out = notch->b0 * in + notch->s1[axis];
+                notch->s1[axis] = notch->b1 * in - notch->b1 * out + notch->s2[axis];
+                notch->s2[axis] = notch->b0 * in - notch->a2 * out;
+
+                gyr[axis] = in + notch->weight * (out - in);
+            }
+        }
+    }
+}
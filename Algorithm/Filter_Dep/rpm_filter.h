@@ -0,0 +1,51 @@
+#ifndef __RPM_FILTER_H
+#define __RPM_FILTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * moto rpm tracking notch bank
+ * one biquad notch per moto per harmonic, shared by all gyro axis
+ * notch center follow moto rotation frequency read back by bidirectional dshot
+ * coefficient of one moto refreshed per apply call, so the trig cost of one sample stay bounded
+ * notch weight ramp over fade_hz from 0 at min_hz up to 1, and back down to 0 at 0.48 sample rate
+ * a bypassed notch have its state cleared, so it restart clean and the weight ramp hide the restart
+ */
+#define RPM_FILTER_MOTO_MAX 8
+#define RPM_FILTER_HARMONIC_MAX 3
+#define RPM_FILTER_AXIS_NUM 3
+
+typedef struct
+{
+    float b0;
+    float b1;
+    float a2;   /* b2 = b0, a1 = b1 */
+    float weight;
+
+    float s1[RPM_FILTER_AXIS_NUM];
+    float s2[RPM_FILTER_AXIS_NUM];
+} RpmFilter_Notch_TypeDef;
+
+typedef struct
+{
+    bool init;
+
+    float sample_hz;
+    float q;
+    float min_hz;
+    float fade_hz;      /* weight ramp width on both end of the notch band */
+    uint8_t moto_cnt;
+    uint8_t harmonic;
+    uint8_t update_moto;
+
+    float moto_hz[RPM_FILTER_MOTO_MAX];
+    RpmFilter_Notch_TypeDef notch[RPM_FILTER_MOTO_MAX][RPM_FILTER_HARMONIC_MAX];
+} RpmFilter_Obj_TypeDef;
+
+bool RpmFilter_Init(RpmFilter_Obj_TypeDef *obj, float sample_hz, uint8_t moto_cnt, uint8_t harmonic, float q, float min_hz);
+void RpmFilter_Set_Freq(RpmFilter_Obj_TypeDef *obj, uint8_t moto, float hz);
+void RpmFilter_Apply(RpmFilter_Obj_TypeDef *obj, float *gyr);
+
+#endif
@@ -20,24 +20,23 @@
 #include "MadgwickAHRS.h"
 #include <math.h>
 #include "math_util.h"
+#include "util.h"
 #include <stdbool.h>
 
+/* float only, at32f435 have no double fpu */
+#pragma GCC diagnostic warning "-Wdouble-promotion"
+
 //---------------------------------------------------------------------------------------------------
 // Definitions
 
-#define sampleFreq	100.0f		// sample frequency in Hz
 #define betaDef		1.5f		// 2 * proportional gain
 
-//---------------------------------------------------------------------------------------------------
-// Variable definitions
-
-volatile float beta = betaDef;								// 2 * proportional gain (Kp)
-volatile float q0 = 1.0f, q1 = 0.0f, q2 = 0.0f, q3 = 0.0f;	// quaternion of sensor frame relative to auxiliary frame
-
 //---------------------------------------------------------------------------------------------------
 // Function declarations
 
 float invSqrt(float x);
+static void MadgwickAHRS_Step(MadgwickAHRS_Obj_TypeDef *obj, float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz, float dt);
+static void MadgwickAHRS_StepIMU(MadgwickAHRS_Obj_TypeDef *obj, float gx, float gy, float gz, float ax, float ay, float az, float dt);
 
 //====================================================================================================
 // Functions
@@ -45,7 +44,11 @@ float invSqrt(float x);
 //---------------------------------------------------------------------------------------------------
 // AHRS algorithm update
 
-void MadgwickAHRSupdate(float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz) {
+// state is copied into locals so the whole step run in registers, written back once at the end
+
+ITCM_CODE static void MadgwickAHRS_Step(MadgwickAHRS_Obj_TypeDef *obj, float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz, float dt) {
+	float q0 = obj->q0, q1 = obj->q1, q2 = obj->q2, q3 = obj->q3;
+	float beta = obj->beta;
 	float recipNorm;
 	float s0, s1, s2, s3;
 	float qDot1, qDot2, qDot3, qDot4;
@@ -54,7 +57,7 @@ void MadgwickAHRSupdate(float gx, float gy, float gz, float ax, float ay, float
 
 	// Use IMU algorithm if magnetometer measurement invalid (avoids NaN in magnetometer normalisation)
 	if((mx == 0.0f) && (my == 0.0f) && (mz == 0.0f)) {
-		MadgwickAHRSupdateIMU(gx, gy, gz, ax, ay, az);
+		MadgwickAHRS_StepIMU(obj, gx, gy, gz, ax, ay, az, dt);
 		return;
 	}
 
@@ -104,7 +107,7 @@ void MadgwickAHRSupdate(float gx, float gy, float gz, float ax, float ay, float
 		// Reference direction of Earth's magnetic field
 		hx = mx * q0q0 - _2q0my * q3 + _2q0mz * q2 + mx * q1q1 + _2q1 * my * q2 + _2q1 * mz * q3 - mx * q2q2 - mx * q3q3;
 		hy = _2q0mx * q3 + my * q0q0 - _2q0mz * q1 + _2q1mx * q2 - my * q1q1 + my * q2q2 + _2q2 * mz * q3 - my * q3q3;
-		_2bx = sqrt(hx * hx + hy * hy);
+		_2bx = sqrtf(hx * hx + hy * hy);
 		_2bz = -_2q0mx * q2 + _2q0my * q1 + mz * q0q0 + _2q1mx * q3 - mz * q1q1 + _2q2 * my * q3 - mz * q2q2 + mz * q3q3;
 		_4bx = 2.0f * _2bx;
 		_4bz = 2.0f * _2bz;
@@ -128,22 +131,24 @@ void MadgwickAHRSupdate(float gx, float gy, float gz, float ax, float ay, float
 	}
 
 	// Integrate rate of change of quaternion to yield quaternion
-	q0 += qDot1 * (1.0f / sampleFreq);
-	q1 += qDot2 * (1.0f / sampleFreq);
-	q2 += qDot3 * (1.0f / sampleFreq);
-	q3 += qDot4 * (1.0f / sampleFreq);
+	q0 += qDot1 * dt;
+	q1 += qDot2 * dt;
+	q2 += qDot3 * dt;
+	q3 += qDot4 * dt;
 
 	// Normalise quaternion
 	recipNorm = invSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
-	q0 *= recipNorm;
-	q1 *= recipNorm;
-	q2 *= recipNorm;
-	q3 *= recipNorm;
+	obj->q0 = q0 * recipNorm;
+	obj->q1 = q1 * recipNorm;
+	obj->q2 = q2 * recipNorm;
+	obj->q3 = q3 * recipNorm;
 }
 
 //---------------------------------------------------------------------------------------------------
 // IMU algorithm update
-void MadgwickAHRSupdateIMU(float gx, float gy, float gz, float ax, float ay, float az) {
+ITCM_CODE static void MadgwickAHRS_StepIMU(MadgwickAHRS_Obj_TypeDef *obj, float gx, float gy, float gz, float ax, float ay, float az, float dt) {
+	float q0 = obj->q0, q1 = obj->q1, q2 = obj->q2, q3 = obj->q3;
+	float beta = obj->beta;
 	float recipNorm;
 	float s0, s1, s2, s3;
 	float qDot1, qDot2, qDot3, qDot4;
@@ -198,67 +203,131 @@ void MadgwickAHRSupdateIMU(float gx, float gy, float gz, float ax, float ay, flo
 	}
 
 	// Integrate rate of change of quaternion to yield quaternion
-	q0 += qDot1 * (1.0f / sampleFreq);
-	q1 += qDot2 * (1.0f / sampleFreq);
-	q2 += qDot3 * (1.0f / sampleFreq);
-	q3 += qDot4 * (1.0f / sampleFreq);
+	q0 += qDot1 * dt;
+	q1 += qDot2 * dt;
+	q2 += qDot3 * dt;
+	q3 += qDot4 * dt;
 
 	// Normalise quaternion
 	recipNorm = invSqrt(q0 * q0 + q1 * q1 + q2 * q2 + q3 * q3);
-	q0 *= recipNorm;
-	q1 *= recipNorm;
-	q2 *= recipNorm;
-	q3 *= recipNorm;
+	obj->q0 = q0 * recipNorm;
+	obj->q1 = q1 * recipNorm;
+	obj->q2 = q2 * recipNorm;
+	obj->q3 = q3 * recipNorm;
 }
 
 //---------------------------------------------------------------------------------------------------
 // Fast inverse square-root
 // See: http://en.wikipedia.org/wiki/Fast_inverse_square_root
 
-float invSqrt(float x) {
+// 32 bit pun through a union, long is 64 bit on the host replay build
+ITCM_CODE float invSqrt(float x) {
 	float halfx = 0.5f * x;
-	float y = x;
-	long i = *(long*)&y;
-	i = 0x5f3759df - (i>>1);
-	y = *(float*)&i;
-	y = y * (1.5f - (halfx * y * y));
-	return y;
+	union { float f; int32_t i; } y = {.f = x};
+	y.i = 0x5f3759df - (y.i>>1);
+	y.f = y.f * (1.5f - (halfx * y.f * y.f));
+	return y.f;
+}
+
+//---------------------------------------------------------------------------------------------------
+// Object interface
+
+bool MadgwickAHRS_Init(MadgwickAHRS_Obj_TypeDef *obj, float beta, uint32_t tick_freq)
+{
+	if((obj == NULL) || (tick_freq == 0))
+		return false;
+
+	memset(obj, 0, sizeof(MadgwickAHRS_Obj_TypeDef));
+	obj->beta = (beta > 0.0f) ? beta : betaDef;
+	obj->q0 = 1.0f;
+	obj->tick_freq = tick_freq;
+	obj->tick_to_sec = 1.0f / (float)tick_freq;
+
+	return true;
+}
+
+// time stamp in tick of tick_freq, dt come from the tick delta of two calls (wrap safe)
+// first call and any step out of (0, MADGWICK_DT_MAX] only resync the time stamp
+ITCM_CODE bool MadgwickAHRS_Update(MadgwickAHRS_Obj_TypeDef *obj, uint32_t tick, float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz)
+{
+	float dt = 0.0f;
+
+	if((obj == NULL) || (obj->tick_freq == 0))
+		return false;
+
+	dt = (float)(tick - obj->lst_tick) * obj->tick_to_sec;
+	obj->lst_tick = tick;
+
+	if(!obj->tick_valid)
+	{
+		obj->tick_valid = true;
+		return false;
+	}
+
+	if((dt <= 0.0f) || (dt > MADGWICK_DT_MAX))
+	{
+		obj->dt_err_cnt ++;
+		return false;
+	}
+
+	obj->dt = dt;
+	MadgwickAHRS_Step(obj, gx, gy, gz, ax, ay, az, mx, my, mz, dt);
+	obj->update_cnt ++;
+
+	return true;
 }
 
-bool MadgwickAHRS_Get_Quraterion(float *in_q0, float *in_q1, float *in_q2, float *in_q3)
+// pre-integrated input, delta angle in rad over dt sec
+ITCM_CODE bool MadgwickAHRS_Update_DeltaAngle(MadgwickAHRS_Obj_TypeDef *obj, float dt, float dax, float day, float daz, float ax, float ay, float az, float mx, float my, float mz)
 {
-	if((in_q0 == NULL) || \
+	float inv_dt = 0.0f;
+
+	if((obj == NULL) || (obj->tick_freq == 0) || (dt <= 0.0f) || (dt > MADGWICK_DT_MAX))
+		return false;
+
+	inv_dt = 1.0f / dt;
+	obj->dt = dt;
+	MadgwickAHRS_Step(obj, dax * inv_dt, day * inv_dt, daz * inv_dt, ax, ay, az, mx, my, mz, dt);
+	obj->update_cnt ++;
+
+	return true;
+}
+
+bool MadgwickAHRS_Get_Quraterion(const MadgwickAHRS_Obj_TypeDef *obj, float *in_q0, float *in_q1, float *in_q2, float *in_q3)
+{
+	if((obj == NULL) || \
+	   (in_q0 == NULL) || \
 	   (in_q1 == NULL) || \
 	   (in_q2 == NULL) || \
 	   (in_q3 == NULL))
 	   return false;
 	
-	*in_q0 = q0;
-	*in_q1 = q1;
-	*in_q2 = q2;
-	*in_q3 = q3;
+	*in_q0 = obj->q0;
+	*in_q1 = obj->q1;
+	*in_q2 = obj->q2;
+	*in_q3 = obj->q3;
 	
 	return true;
 }
 
-bool MadgwickAHRS_Get_Attitude(float *pitch, float *roll, float *yaw)
+bool MadgwickAHRS_Get_Attitude(const MadgwickAHRS_Obj_TypeDef *obj, float *pitch, float *roll, float *yaw)
 {
-	double pitch_tmp = 0.0;
-	double roll_tmp = 0.0;
-	double yaw_tmp = 0.0;
+	float q0, q1, q2, q3;
 
-	roll_tmp = atan2(q0 * q1 + q2 * q3, 0.5f - q1 * q1 - q2 * q2);
-	pitch_tmp = asin(-2.0f * (q1 * q3 - q0 * q2));
-	yaw_tmp = atan2(q1 * q2 + q0 * q3, 0.5f - q2 * q2 - q3 *q3);
-
-	if((pitch == NULL) || \
+	if((obj == NULL) || \
+	   (pitch == NULL) || \
 	   (roll == NULL) || \
 	   (yaw == NULL))
 	   return false;
 
-	*pitch = -Rad2Deg((float)pitch_tmp);
-	*roll = Rad2Deg((float)roll_tmp);
-	*yaw = -Rad2Deg((float)yaw_tmp);
+	q0 = obj->q0;
+	q1 = obj->q1;
+	q2 = obj->q2;
+	q3 = obj->q3;
+
+	*pitch = -Rad2Deg(Fast_Asinf(-2.0f * (q1 * q3 - q0 * q2)));
+	*roll = Rad2Deg(Fast_Atan2f(q0 * q1 + q2 * q3, 0.5f - q1 * q1 - q2 * q2));
+	*yaw = -Rad2Deg(Fast_Atan2f(q1 * q2 + q0 * q3, 0.5f - q2 * q2 - q3 * q3));
 
 	return true;
 }
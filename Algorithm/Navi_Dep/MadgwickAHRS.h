@@ -14,20 +14,37 @@
 #define MadgwickAHRS_h
 
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#define MADGWICK_DT_MAX		0.1f	// max integration step in sec, longer gap only resync the time stamp
 
 //----------------------------------------------------------------------------------------------------
-// Variable declaration
+// Object declaration
+
+typedef struct
+{
+	float beta;					// algorithm gain
+	float q0, q1, q2, q3;		// quaternion of sensor frame relative to auxiliary frame
+
+	uint32_t tick_freq;			// time stamp tick per second
+	float tick_to_sec;
+	uint32_t lst_tick;
+	bool tick_valid;
 
-extern volatile float beta;				// algorithm gain
-extern volatile float q0, q1, q2, q3;	// quaternion of sensor frame relative to auxiliary frame
+	float dt;					// last integration step in sec
+	uint32_t update_cnt;
+	uint32_t dt_err_cnt;
+} MadgwickAHRS_Obj_TypeDef;
 
 //---------------------------------------------------------------------------------------------------
 // Function declarations
 
-void MadgwickAHRSupdate(float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz);
-void MadgwickAHRSupdateIMU(float gx, float gy, float gz, float ax, float ay, float az);
-bool MadgwickAHRS_Get_Quraterion(float *q0, float *q1, float *q2, float *q3);
-bool MadgwickAHRS_Get_Attitude(float *pitch, float *roll, float *yaw);
+bool MadgwickAHRS_Init(MadgwickAHRS_Obj_TypeDef *obj, float beta, uint32_t tick_freq);
+bool MadgwickAHRS_Update(MadgwickAHRS_Obj_TypeDef *obj, uint32_t tick, float gx, float gy, float gz, float ax, float ay, float az, float mx, float my, float mz);
+bool MadgwickAHRS_Update_DeltaAngle(MadgwickAHRS_Obj_TypeDef *obj, float dt, float dax, float day, float daz, float ax, float ay, float az, float mx, float my, float mz);
+bool MadgwickAHRS_Get_Quraterion(const MadgwickAHRS_Obj_TypeDef *obj, float *q0, float *q1, float *q2, float *q3);
+bool MadgwickAHRS_Get_Attitude(const MadgwickAHRS_Obj_TypeDef *obj, float *pitch, float *roll, float *yaw);
 
 #endif
 //=====================================================================================================
@@ -0,0 +1,563 @@
+#include "navi_ekf.h"
+#include "util.h"
+#include <math.h>
+
+/* float only, at32f435 have no double fpu */
+#pragma GCC diagnostic warning "-Wdouble-promotion"
+
+#define NAVI_EKF_RAD2DEG 57.2957795130823f
+
+/* packed upper triangle row offset, row r start at r * N - r * (r - 1) / 2 */
+static const uint8_t NaviEKF_RowOffset[NAVI_EKF_STATE_NUM] = {0, 15, 29, 42, 54, 65, 75, 84, 92, 99, 105, 110, 114, 117, 119};
+
+static const NaviEKF_Param_TypeDef NaviEKF_DefParam = {
+    .gyr_noise = 0.01f,
+    .acc_noise = 0.35f,
+    .gyr_bias_noise = 1.0e-4f,
+    .acc_bias_noise = 3.0e-3f,
+    .grav_var = 1.0f,
+    .gate = 5.0f,
+};
+
+/* sparse row of the state transition matrix */
+typedef struct
+{
+    uint8_t num;
+    uint8_t col[7];
+    float val[7];
+} NaviEKF_FRow_TypeDef;
+
+/* internal function */
+static inline uint8_t NaviEKF_PIndex(uint8_t i, uint8_t j);
+static void NaviEKF_Update_Rotation(NaviEKF_Obj_TypeDef *obj);
+static void NaviEKF_Quat_Rotate(float *q, float dx, float dy, float dz);
+static bool NaviEKF_Align(NaviEKF_Obj_TypeDef *obj, const float *d_vel, float dt);
+static void NaviEKF_Predict(NaviEKF_Obj_TypeDef *obj, const float *d_ang, const float *d_vel, float dt);
+static bool NaviEKF_Fuse_Scalar(NaviEKF_Obj_TypeDef *obj, NaviEKF_Meas_TypeDef *meas, const uint8_t *h_idx, const float *h_val, uint8_t h_num, float innov);
+static bool NaviEKF_Fuse_Meas(NaviEKF_Obj_TypeDef *obj, NaviEKF_Meas_List type);
+
+static inline uint8_t NaviEKF_PIndex(uint8_t i, uint8_t j)
+{
+    return (i <= j) ? (NaviEKF_RowOffset[i] + j - i) : (NaviEKF_RowOffset[j] + i - j);
+}
+
+bool NaviEKF_Init(NaviEKF_Obj_TypeDef *obj, const NaviEKF_Param_TypeDef *param)
+{
+    if (obj == NULL)
+        return false;
+
+    memset(obj, 0, sizeof(NaviEKF_Obj_TypeDef));
+    obj->param = param ? *param : NaviEKF_DefParam;
+    obj->q[0] = 1.0f;
+    NaviEKF_Update_Rotation(obj);
+
+    return true;
+}
+
+/* latest value win, fused in the next step */
+bool NaviEKF_Set_Meas(NaviEKF_Obj_TypeDef *obj, NaviEKF_Meas_List type, float val, float var)
+{
+    if ((obj == NULL) || (type >= NaviEKF_Meas_Sum) || (var <= 0.0f))
+        return false;
+
+    obj->meas[type].val = val;
+    obj->meas[type].var = var;
+    obj->meas[type].pending = true;
+
+    return true;
+}
+
+/*
+ * one filter step: predict with one imu window then fuse at most NAVI_EKF_FUSE_PER_STEP pending scalar
+ * left measurement stay pending for the next step, so the step cost have a fixed upper bound
+ */
+ITCM_CODE bool NaviEKF_Step(NaviEKF_Obj_TypeDef *obj, const float *d_ang, const float *d_vel, float dt)
+{
+    float f[3];
+    float f_norm = 0.0f;
+    uint8_t fuse_cnt = 0;
+    uint8_t type = 0;
+
+    if ((obj == NULL) || (d_ang == NULL) || (d_vel == NULL) || (dt <= 0.0f))
+        return false;
+
+    if (!obj->init)
+        return NaviEKF_Align(obj, d_vel, dt);
+
+    NaviEKF_Predict(obj, d_ang, d_vel, dt);
+
+    /* mean specific force close to gravity, use it as tilt reference */
+    f[0] = d_vel[0] / dt;
+    f[1] = d_vel[1] / dt;
+    f[2] = d_vel[2] / dt;
+    f_norm = sqrtf(f[0] * f[0] + f[1] * f[1] + f[2] * f[2]);
+
+    if (fabsf(f_norm - NAVI_EKF_GRAVITY) < (NAVI_EKF_GRAV_GATE * NAVI_EKF_GRAVITY))
+    {
+        NaviEKF_Set_Meas(obj, NaviEKF_Meas_GravX, f[0], obj->param.grav_var);
+        NaviEKF_Set_Meas(obj, NaviEKF_Meas_GravY, f[1], obj->param.grav_var);
+    }
+
+    /* round robin from a moving start so no measurement starve */
+    for (uint8_t i = 0; (i < NaviEKF_Meas_Sum) && (fuse_cnt < NAVI_EKF_FUSE_PER_STEP); i++)
+    {
+        type = (obj->fuse_start + i) % NaviEKF_Meas_Sum;
+
+        if (!obj->meas[type].pending)
+            continue;
+
+        obj->meas[type].pending = false;
+        NaviEKF_Fuse_Meas(obj, type);
+        fuse_cnt ++;
+    }
+
+    obj->fuse_start = (obj->fuse_start + 1) % NaviEKF_Meas_Sum;
+    obj->step_cnt ++;
+
+    return true;
+}
+
+bool NaviEKF_Get_Attitude(const NaviEKF_Obj_TypeDef *obj, float *pitch, float *roll, float *yaw)
+{
+    float sin_pitch = 0.0f;
+
+    if ((obj == NULL) || (pitch == NULL) || (roll == NULL) || (yaw == NULL))
+        return false;
+
+    sin_pitch = -obj->R[2][0];
+    if (sin_pitch > 1.0f)
+        sin_pitch = 1.0f;
+
+    if (sin_pitch < -1.0f)
+        sin_pitch = -1.0f;
+
+    *roll = atan2f(obj->R[2][1], obj->R[2][2]) * NAVI_EKF_RAD2DEG;
+    *pitch = asinf(sin_pitch) * NAVI_EKF_RAD2DEG;
+    *yaw = atan2f(obj->R[1][0], obj->R[0][0]) * NAVI_EKF_RAD2DEG;
+
+    return true;
+}
+
+bool NaviEKF_Get_PosVel(const NaviEKF_Obj_TypeDef *obj, float *pos, float *vel)
+{
+    if ((obj == NULL) || !obj->init)
+        return false;
+
+    if (pos)
+        memcpy(pos, obj->pos, sizeof(obj->pos));
+
+    if (vel)
+        memcpy(vel, obj->vel, sizeof(obj->vel));
+
+    return true;
+}
+
+static void NaviEKF_Update_Rotation(NaviEKF_Obj_TypeDef *obj)
+{
+    float q0 = obj->q[0];
+    float q1 = obj->q[1];
+    float q2 = obj->q[2];
+    float q3 = obj->q[3];
+
+    obj->R[0][0] = q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3;
+    obj->R[0][1] = 2.0f * (q1 * q2 - q0 * q3);
+    obj->R[0][2] = 2.0f * (q1 * q3 + q0 * q2);
+    obj->R[1][0] = 2.0f * (q1 * q2 + q0 * q3);
+    obj->R[1][1] = q0 * q0 - q1 * q1 + q2 * q2 - q3 * q3;
+    obj->R[1][2] = 2.0f * (q2 * q3 - q0 * q1);
+    obj->R[2][0] = 2.0f * (q1 * q3 - q0 * q2);
+    obj->R[2][1] = 2.0f * (q2 * q3 + q0 * q1);
+    obj->R[2][2] = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+}
+
+/* q = q * dq(rotation vector), small angle series, normalised */
+static void NaviEKF_Quat_Rotate(float *q, float dx, float dy, float dz)
+{
+    float ang2 = dx * dx + dy * dy + dz * dz;
+    float w = 1.0f - ang2 * (1.0f / 8.0f);
+    float s = 0.5f * (1.0f - ang2 * (1.0f / 24.0f));
+    float x = dx * s;
+    float y = dy * s;
+    float z = dz * s;
+    float q_tmp[4];
+    float norm = 0.0f;
+
+    q_tmp[0] = q[0] * w - q[1] * x - q[2] * y - q[3] * z;
+    q_tmp[1] = q[0] * x + q[1] * w + q[2] * z - q[3] * y;
+    q_tmp[2] = q[0] * y - q[1] * z + q[2] * w + q[3] * x;
+    q_tmp[3] = q[0] * z + q[1] * y - q[2] * x + q[3] * w;
+
+    norm = 1.0f / sqrtf(q_tmp[0] * q_tmp[0] + q_tmp[1] * q_tmp[1] + q_tmp[2] * q_tmp[2] + q_tmp[3] * q_tmp[3]);
+
+    for (uint8_t i = 0; i < 4; i++)
+        q[i] = q_tmp[i] * norm;
+}
+
+/* level the filter from the first window, yaw start at zero, d_vel already frd specific force */
+static bool NaviEKF_Align(NaviEKF_Obj_TypeDef *obj, const float *d_vel, float dt)
+{
+    float fx = d_vel[0] / dt;
+    float fy = d_vel[1] / dt;
+    float fz = d_vel[2] / dt;
+    float roll = 0.0f;
+    float pitch = 0.0f;
+    float cr, sr, cp, sp;
+    static const float init_std[NAVI_EKF_STATE_NUM] = {0.1f, 0.1f, 0.5f,       /* attitude */
+                                                       0.5f, 0.5f, 0.5f,       /* velocity */
+                                                       1.0f, 1.0f, 1.0f,       /* position */
+                                                       0.01f, 0.01f, 0.01f,    /* gyro bias */
+                                                       0.2f, 0.2f, 0.2f};      /* acc bias */
+
+    /* at rest specific force is -g along ned down */
+    roll = atan2f(-fy, -fz);
+    pitch = atan2f(fx, sqrtf(fy * fy + fz * fz));
+
+    cr = cosf(roll * 0.5f);
+    sr = sinf(roll * 0.5f);
+    cp = cosf(pitch * 0.5f);
+    sp = sinf(pitch * 0.5f);
+
+    obj->q[0] = cr * cp;
+    obj->q[1] = sr * cp;
+    obj->q[2] = cr * sp;
+    obj->q[3] = -sr * sp;
+    NaviEKF_Update_Rotation(obj);
+
+    memset(obj->P, 0, sizeof(obj->P));
+    for (uint8_t i = 0; i < NAVI_EKF_STATE_NUM; i++)
+        obj->P[NaviEKF_PIndex(i, i)] = init_std[i] * init_std[i];
+
+    obj->init = true;
+
+    return true;
+}
+
+/*
+ * nominal : R(q) * (d_vel - ba * dt) + g * dt into velocity, trapezoid into position, q * dq(d_ang - bg * dt)
+ * error transition F (sparse, at most 7 element per row)
+ *      d_att' = (I - [d_ang]x) * d_att - dt * d_bg
+ *      d_vel' = d_vel - R * [d_vel]x * d_att - R * dt * d_ba
+ *      d_pos' = d_pos + dt * d_vel
+ *      bias   : random walk
+ * P' = F * P * F^T + Q, only the upper triangle written back
+ */
+ITCM_CODE static void NaviEKF_Predict(NaviEKF_Obj_TypeDef *obj, const float *d_ang, const float *d_vel, float dt)
+{
+    NaviEKF_FRow_TypeDef F[NAVI_EKF_STATE_NUM];
+    float ang[3];
+    float dv[3];
+    float dv_ned[3];
+    float vel_lst[3];
+    float sum = 0.0f;
+    float q_att = obj->param.gyr_noise * obj->param.gyr_noise * dt;
+    float q_vel = obj->param.acc_noise * obj->param.acc_noise * dt;
+    float q_bg = obj->param.gyr_bias_noise * obj->param.gyr_bias_noise * dt;
+    float q_ba = obj->param.acc_bias_noise * obj->param.acc_bias_noise * dt;
+    uint8_t i, j, k, r;
+
+    for (i = 0; i < 3; i++)
+    {
+        ang[i] = d_ang[i] - obj->gyr_bias[i] * dt;
+        dv[i] = d_vel[i] - obj->acc_bias[i] * dt;
+    }
+
+    /* build F with the rotation at window start */
+    for (i = 0; i < 3; i++)
+    {
+        /* attitude row */
+        r = NaviEKF_State_Att + i;
+        F[r].num = 4;
+        F[r].col[0] = NaviEKF_State_Att + 0;
+        F[r].col[1] = NaviEKF_State_Att + 1;
+        F[r].col[2] = NaviEKF_State_Att + 2;
+        F[r].col[3] = NaviEKF_State_GyrBias + i;
+        F[r].val[3] = -dt;
+
+        /* velocity row */
+        r = NaviEKF_State_Vel + i;
+        F[r].num = 7;
+        F[r].col[0] = NaviEKF_State_Att + 0;
+        F[r].col[1] = NaviEKF_State_Att + 1;
+        F[r].col[2] = NaviEKF_State_Att + 2;
+        F[r].col[3] = NaviEKF_State_Vel + i;
+        F[r].col[4] = NaviEKF_State_AccBias + 0;
+        F[r].col[5] = NaviEKF_State_AccBias + 1;
+        F[r].col[6] = NaviEKF_State_AccBias + 2;
+
+        /* -R * [dv]x */
+        F[r].val[0] = -(obj->R[i][1] * dv[2] - obj->R[i][2] * dv[1]);
+        F[r].val[1] = -(obj->R[i][2] * dv[0] - obj->R[i][0] * dv[2]);
+        F[r].val[2] = -(obj->R[i][0] * dv[1] - obj->R[i][1] * dv[0]);
+        F[r].val[3] = 1.0f;
+        F[r].val[4] = -obj->R[i][0] * dt;
+        F[r].val[5] = -obj->R[i][1] * dt;
+        F[r].val[6] = -obj->R[i][2] * dt;
+
+        /* position row */
+        r = NaviEKF_State_Pos + i;
+        F[r].num = 2;
+        F[r].col[0] = NaviEKF_State_Pos + i;
+        F[r].col[1] = NaviEKF_State_Vel + i;
+        F[r].val[0] = 1.0f;
+        F[r].val[1] = dt;
+
+        /* bias row */
+        r = NaviEKF_State_GyrBias + i;
+        F[r].num = 1;
+        F[r].col[0] = r;
+        F[r].val[0] = 1.0f;
+
+        r = NaviEKF_State_AccBias + i;
+        F[r].num = 1;
+        F[r].col[0] = r;
+        F[r].val[0] = 1.0f;
+    }
+
+    /* I - [ang]x */
+    F[0].val[0] = 1.0f;    F[0].val[1] = ang[2];  F[0].val[2] = -ang[1];
+    F[1].val[0] = -ang[2]; F[1].val[1] = 1.0f;    F[1].val[2] = ang[0];
+    F[2].val[0] = ang[1];  F[2].val[1] = -ang[0]; F[2].val[2] = 1.0f;
+
+    /* nominal propagation */
+    for (i = 0; i < 3; i++)
+    {
+        dv_ned[i] = obj->R[i][0] * dv[0] + obj->R[i][1] * dv[1] + obj->R[i][2] * dv[2];
+        vel_lst[i] = obj->vel[i];
+    }
+
+    dv_ned[2] += NAVI_EKF_GRAVITY * dt;
+
+    for (i = 0; i < 3; i++)
+    {
+        obj->vel[i] += dv_ned[i];
+        obj->pos[i] += 0.5f * (vel_lst[i] + obj->vel[i]) * dt;
+    }
+
+    NaviEKF_Quat_Rotate(obj->q, ang[0], ang[1], ang[2]);
+    NaviEKF_Update_Rotation(obj);
+
+    /* FP = F * P */
+    for (i = 0; i < NAVI_EKF_STATE_NUM; i++)
+    {
+        for (j = 0; j < NAVI_EKF_STATE_NUM; j++)
+        {
+            sum = 0.0f;
+
+            for (k = 0; k < F[i].num; k++)
+                sum += F[i].val[k] * obj->P[NaviEKF_PIndex(F[i].col[k], j)];
+
+            obj->FP[i][j] = sum;
+        }
+    }
+
+    /* P = FP * F^T, upper triangle */
+    for (i = 0; i < NAVI_EKF_STATE_NUM; i++)
+    {
+        for (j = i; j < NAVI_EKF_STATE_NUM; j++)
+        {
+            sum = 0.0f;
+
+            for (k = 0; k < F[j].num; k++)
+                sum += obj->FP[i][F[j].col[k]] * F[j].val[k];
+
+            obj->P[NaviEKF_RowOffset[i] + j - i] = sum;
+        }
+    }
+
+    /* process noise and variance limit */
+    for (i = 0; i < 3; i++)
+    {
+        obj->P[NaviEKF_PIndex(NaviEKF_State_Att + i, NaviEKF_State_Att + i)] += q_att;
+        obj->P[NaviEKF_PIndex(NaviEKF_State_Vel + i, NaviEKF_State_Vel + i)] += q_vel;
+        obj->P[NaviEKF_PIndex(NaviEKF_State_GyrBias + i, NaviEKF_State_GyrBias + i)] += q_bg;
+        obj->P[NaviEKF_PIndex(NaviEKF_State_AccBias + i, NaviEKF_State_AccBias + i)] += q_ba;
+    }
+
+    for (i = 0; i < NAVI_EKF_STATE_NUM; i++)
+    {
+        sum = obj->P[NaviEKF_RowOffset[i]];
+
+        if (sum < NAVI_EKF_VAR_MIN)
+            obj->P[NaviEKF_RowOffset[i]] = NAVI_EKF_VAR_MIN;
+        else if (sum > NAVI_EKF_VAR_MAX)
+            obj->P[NaviEKF_RowOffset[i]] = NAVI_EKF_VAR_MAX;
+    }
+}
+
+/*
+ * scalar update with sparse H
+ *      PHt = P * H^T, S = H * PHt + var, K = PHt / S
+ *      P -= K * PHt^T (symmetric, upper triangle only)
+ * error injected into the nominal state and reset to zero
+ */
+ITCM_CODE static bool NaviEKF_Fuse_Scalar(NaviEKF_Obj_TypeDef *obj, NaviEKF_Meas_TypeDef *meas, const uint8_t *h_idx, const float *h_val, uint8_t h_num, float innov)
+{
+    float PHt[NAVI_EKF_STATE_NUM];
+    float dx[NAVI_EKF_STATE_NUM];
+    float S = meas->var;
+    float inv_S = 0.0f;
+    uint8_t i, j, k;
+
+    for (i = 0; i < NAVI_EKF_STATE_NUM; i++)
+    {
+        PHt[i] = 0.0f;
+
+        for (k = 0; k < h_num; k++)
+            PHt[i] += obj->P[NaviEKF_PIndex(i, h_idx[k])] * h_val[k];
+    }
+
+    for (k = 0; k < h_num; k++)
+        S += h_val[k] * PHt[h_idx[k]];
+
+    meas->innov = innov;
+    meas->innov_var = S;
+
+    if (S <= 0.0f)
+    {
+        meas->reject_cnt ++;
+        return false;
+    }
+
+    /* innovation gate */
+    if ((innov * innov) > (obj->param.gate * obj->param.gate * S))
+    {
+        meas->reject_cnt ++;
+        return false;
+    }
+
+    inv_S = 1.0f / S;
+
+    for (i = 0; i < NAVI_EKF_STATE_NUM; i++)
+    {
+        dx[i] = PHt[i] * inv_S * innov;
+
+        for (j = i; j < NAVI_EKF_STATE_NUM; j++)
+            obj->P[NaviEKF_RowOffset[i] + j - i] -= PHt[i] * PHt[j] * inv_S;
+    }
+
+    for (i = 0; i < NAVI_EKF_STATE_NUM; i++)
+    {
+        if (obj->P[NaviEKF_RowOffset[i]] < NAVI_EKF_VAR_MIN)
+            obj->P[NaviEKF_RowOffset[i]] = NAVI_EKF_VAR_MIN;
+    }
+
+    /* inject */
+    NaviEKF_Quat_Rotate(obj->q, dx[NaviEKF_State_Att + 0], dx[NaviEKF_State_Att + 1], dx[NaviEKF_State_Att + 2]);
+    NaviEKF_Update_Rotation(obj);
+
+    for (i = 0; i < 3; i++)
+    {
+        obj->vel[i] += dx[NaviEKF_State_Vel + i];
+        obj->pos[i] += dx[NaviEKF_State_Pos + i];
+        obj->gyr_bias[i] += dx[NaviEKF_State_GyrBias + i];
+        obj->acc_bias[i] += dx[NaviEKF_State_AccBias + i];
+    }
+
+    meas->fuse_cnt ++;
+
+    return true;
+}
+
+/* build H row and innovation of one measurement */
+static bool NaviEKF_Fuse_Meas(NaviEKF_Obj_TypeDef *obj, NaviEKF_Meas_List type)
+{
+    NaviEKF_Meas_TypeDef *meas = &obj->meas[type];
+    uint8_t h_idx[NAVI_EKF_H_MAX];
+    float h_val[NAVI_EKF_H_MAX];
+    float u[3];
+    float R22 = obj->R[2][2];
+    float pred = 0.0f;
+    uint8_t axis = 0;
+
+    switch ((uint8_t)type)
+    {
+        /* baro altitude relative to the first sample, h = pos_d */
+        case NaviEKF_Meas_Baro:
+            if (!obj->baro_ref_set)
+            {
+                obj->baro_ref = meas->val + obj->pos[2];
+                obj->baro_ref_set = true;
+            }
+
+            h_idx[0] = NaviEKF_State_Pos + 2;
+            h_val[0] = 1.0f;
+            return NaviEKF_Fuse_Scalar(obj, meas, h_idx, h_val, 1, -(meas->val - obj->baro_ref) - obj->pos[2]);
+
+        /* flat ground at pos_d = 0, h = -pos_d / R22 */
+        case NaviEKF_Meas_ToF:
+            if (R22 < NAVI_EKF_TOF_TILT_MIN)
+                return false;
+
+            pred = -obj->pos[2] / R22;
+            h_idx[0] = NaviEKF_State_Pos + 2;
+            h_val[0] = -1.0f / R22;
+            h_idx[1] = NaviEKF_State_Att + 0;
+            h_val[1] = -obj->pos[2] * obj->R[2][1] / (R22 * R22);
+            h_idx[2] = NaviEKF_State_Att + 1;
+            h_val[2] = obj->pos[2] * obj->R[2][0] / (R22 * R22);
+            return NaviEKF_Fuse_Scalar(obj, meas, h_idx, h_val, 3, meas->val - pred);
+
+        /* body velocity u = R^T * vel, du / d_att = [u]x */
+        case NaviEKF_Meas_FlowX:
+        case NaviEKF_Meas_FlowY:
+            axis = (type == NaviEKF_Meas_FlowX) ? 0 : 1;
+
+            for (uint8_t i = 0; i < 3; i++)
+                u[i] = obj->R[0][i] * obj->vel[0] + obj->R[1][i] * obj->vel[1] + obj->R[2][i] * obj->vel[2];
+
+            for (uint8_t i = 0; i < 3; i++)
+            {
+                h_idx[i] = NaviEKF_State_Vel + i;
+                h_val[i] = obj->R[i][axis];
+            }
+
+            h_idx[3] = NaviEKF_State_Att + 0;
+            h_idx[4] = NaviEKF_State_Att + 1;
+            h_idx[5] = NaviEKF_State_Att + 2;
+
+            if (axis == 0)
+            {
+                h_val[3] = 0.0f;
+                h_val[4] = -u[2];
+                h_val[5] = u[1];
+            }
+            else
+            {
+                h_val[3] = u[2];
+                h_val[4] = 0.0f;
+                h_val[5] = -u[0];
+            }
+            return NaviEKF_Fuse_Scalar(obj, meas, h_idx, h_val, 6, meas->val - u[axis]);
+
+        /* specific force at rest f = R^T * (0, 0, -g) + ba */
+        case NaviEKF_Meas_GravX:
+        case NaviEKF_Meas_GravY:
+            axis = (type == NaviEKF_Meas_GravX) ? 0 : 1;
+
+            for (uint8_t i = 0; i < 3; i++)
+                u[i] = -NAVI_EKF_GRAVITY * obj->R[2][i];
+
+            h_idx[0] = NaviEKF_State_Att + 0;
+            h_idx[1] = NaviEKF_State_Att + 1;
+            h_idx[2] = NaviEKF_State_Att + 2;
+            h_idx[3] = NaviEKF_State_AccBias + axis;
+            h_val[3] = 1.0f;
+
+            if (axis == 0)
+            {
+                h_val[0] = 0.0f;
+                h_val[1] = -u[2];
+                h_val[2] = u[1];
+            }
+            else
+            {
+                h_val[0] = u[2];
+                h_val[1] = 0.0f;
+                h_val[2] = -u[0];
+            }
+            return NaviEKF_Fuse_Scalar(obj, meas, h_idx, h_val, 4, meas->val - (u[axis] + obj->acc_bias[axis]));
+
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef __NAVI_EKF_H
+#define __NAVI_EKF_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/*
+ * error state kalman filter
+ * nominal state : attitude quaternion (frd body to ned), ned velocity, ned position, gyro bias, acc bias
+ * error state   : body frame attitude error, velocity, position, gyro bias, acc bias (15 state)
+ * input         : pre-integrated delta angle / delta velocity of one imu window in frd body frame,
+ *                 the SrvIMU window is already frd (specific force read -1g on z at rest) and go in as is,
+ *                 madgwick get the same window turned into its x forward y left z up convention
+ * measurement   : sequential scalar fusion, no matrix inversion
+ */
+#define NAVI_EKF_STATE_NUM 15
+#define NAVI_EKF_P_SIZE ((NAVI_EKF_STATE_NUM * (NAVI_EKF_STATE_NUM + 1)) / 2) /* upper triangle packed */
+#define NAVI_EKF_H_MAX 6                                                    /* max non zero element of one measurement row */
+#define NAVI_EKF_FUSE_PER_STEP 3                                            /* max scalar fusion in one step, bound the step cycle */
+
+#define NAVI_EKF_GRAVITY 9.80665f
+#define NAVI_EKF_TOF_TILT_MIN 0.7f  /* cos(tilt), skip tof fusion beyond 45 deg */
+#define NAVI_EKF_GRAV_GATE 0.1f     /* acc norm within 10% of gravity then fuse tilt */
+#define NAVI_EKF_VAR_MIN 1.0e-9f
+#define NAVI_EKF_VAR_MAX 1.0e4f
+
+typedef enum
+{
+    NaviEKF_State_Att = 0,
+    NaviEKF_State_Vel = 3,
+    NaviEKF_State_Pos = 6,
+    NaviEKF_State_GyrBias = 9,
+    NaviEKF_State_AccBias = 12,
+} NaviEKF_StateIndex_List;
+
+typedef enum
+{
+    NaviEKF_Meas_Baro = 0,  /* altitude, unit: m, up positive */
+    NaviEKF_Meas_ToF,       /* range along body z, unit: m */
+    NaviEKF_Meas_FlowX,     /* body x velocity from flow, unit: m/s */
+    NaviEKF_Meas_FlowY,     /* body y velocity from flow, unit: m/s */
+    NaviEKF_Meas_GravX,     /* body x specific force, unit: m/s^2, filled by step */
+    NaviEKF_Meas_GravY,     /* body y specific force, unit: m/s^2, filled by step */
+    NaviEKF_Meas_Sum,
+} NaviEKF_Meas_List;
+
+typedef struct
+{
+    bool pending;
+    float val;
+    float var;
+
+    float innov;
+    float innov_var;
+    uint32_t fuse_cnt;
+    uint32_t reject_cnt;
+} NaviEKF_Meas_TypeDef;
+
+typedef struct
+{
+    float gyr_noise;        /* unit: rad/s/sqrt(Hz) */
+    float acc_noise;        /* unit: m/s^2/sqrt(Hz) */
+    float gyr_bias_noise;   /* unit: rad/s^2/sqrt(Hz) */
+    float acc_bias_noise;   /* unit: m/s^3/sqrt(Hz) */
+    float grav_var;         /* tilt measurement variance, unit: (m/s^2)^2 */
+    float gate;             /* innovation gate, unit: sigma */
+} NaviEKF_Param_TypeDef;
+
+typedef struct
+{
+    bool init;
+    NaviEKF_Param_TypeDef param;
+
+    /* nominal state */
+    float q[4];
+    float vel[3];
+    float pos[3];
+    float gyr_bias[3];
+    float acc_bias[3];
+
+    /* rotation body to ned of q */
+    float R[3][3];
+
+    /* covariance upper triangle, row major */
+    float P[NAVI_EKF_P_SIZE];
+
+    /* F * P scratch of predict */
+    float FP[NAVI_EKF_STATE_NUM][NAVI_EKF_STATE_NUM];
+
+    NaviEKF_Meas_TypeDef meas[NaviEKF_Meas_Sum];
+    uint8_t fuse_start;
+
+    bool baro_ref_set;
+    float baro_ref;
+
+    uint32_t step_cnt;
+} NaviEKF_Obj_TypeDef;
+
+bool NaviEKF_Init(NaviEKF_Obj_TypeDef *obj, const NaviEKF_Param_TypeDef *param);
+bool NaviEKF_Set_Meas(NaviEKF_Obj_TypeDef *obj, NaviEKF_Meas_List type, float val, float var);
+bool NaviEKF_Step(NaviEKF_Obj_TypeDef *obj, const float *d_ang, const float *d_vel, float dt);
+bool NaviEKF_Get_Attitude(const NaviEKF_Obj_TypeDef *obj, float *pitch, float *roll, float *yaw);
+bool NaviEKF_Get_PosVel(const NaviEKF_Obj_TypeDef *obj, float *pos, float *vel);
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * single precision fast math
+ * every intermediate value stay in float, no double promotion
+ * error bound listed in math_util.h, checked against double libm on host by Analysis_Tool/MathCheck
+ */
+#include "math_util.h"
+#include "util.h"
+#include <math.h>
+
+#pragma GCC diagnostic warning "-Wdouble-promotion"
+
+#define MATH_SQRT2      1.41421356237310f
+#define MATH_LN2        0.693147180559945f
+#define MATH_LOG2E      1.44269504088896f
+
+/* atan on [0, 1], Abramowitz & Stegun 4.4.49, abs error <= 1.0e-5 rad before float rounding */
+#define ATAN_A1     0.9998660f
+#define ATAN_A3     -0.3302995f
+#define ATAN_A5     0.1801410f
+#define ATAN_A7     -0.0851330f
+#define ATAN_A9     0.0208351f
+
+typedef union
+{
+    float f;
+    uint32_t u;
+} Math_FloatBit_TypeDef;
+
+/* internal function */
+static float Fast_Atan_Unit(float x);
+
+ITCM_CODE static float Fast_Atan_Unit(float x)
+{
+    float x2 = x * x;
+
+    return x * (ATAN_A1 + x2 * (ATAN_A3 + x2 * (ATAN_A5 + x2 * (ATAN_A7 + x2 * ATAN_A9))));
+}
+
+ITCM_CODE float Fast_Atan2f(float y, float x)
+{
+    float abs_x = fabsf(x);
+    float abs_y = fabsf(y);
+    float angle = 0.0f;
+
+    if ((abs_x == 0.0f) && (abs_y == 0.0f))
+        return 0.0f;
+
+    /* fold into first octant */
+    if (abs_y <= abs_x)
+    {
+        angle = Fast_Atan_Unit(abs_y / abs_x);
+    }
+    else
+        angle = MATH_HALF_PI - Fast_Atan_Unit(abs_x / abs_y);
+
+    if (x < 0.0f)
+        angle = MATH_PI - angle;
+
+    if (y < 0.0f)
+        angle = -angle;
+
+    return angle;
+}
+
+ITCM_CODE float Fast_Asinf(float x)
+{
+    if (x >= 1.0f)
+        return MATH_HALF_PI;
+
+    if (x <= -1.0f)
+        return -MATH_HALF_PI;
+
+    /* sqrtf map to single vsqrt instruction */
+    return Fast_Atan2f(x, sqrtf((1.0f - x) * (1.0f + x)));
+}
+
+/*
+ * x = m * 2^e, m in [sqrt(2) / 2, sqrt(2))
+ * ln(m) = 2 * atanh(s), s = (m - 1) / (m + 1), |s| <= 0.1716
+ * series truncated after s^9, truncation error < 1.0e-9
+ */
+ITCM_CODE float Fast_Log2f(float x)
+{
+    Math_FloatBit_TypeDef bit;
+    int32_t exp = 0;
+    float m = 0.0f;
+    float s = 0.0f;
+    float s2 = 0.0f;
+    float ln_m = 0.0f;
+
+    if (x <= 0.0f)
+        return -126.0f;
+
+    bit.f = x;
+    exp = (int32_t)((bit.u >> 23) & 0xFF) - 127;
+    bit.u = (bit.u & 0x007FFFFF) | 0x3F800000;
+    m = bit.f;
+
+    if (m > MATH_SQRT2)
+    {
+        m *= 0.5f;
+        exp ++;
+    }
+
+    s = (m - 1.0f) / (m + 1.0f);
+    s2 = s * s;
+    ln_m = 2.0f * s * (1.0f + s2 * (0.333333333f + s2 * (0.2f + s2 * (0.142857143f + s2 * 0.111111111f))));
+
+    return (float)exp + ln_m * MATH_LOG2E;
+}
+
+/*
+ * 2^x = 2^i * e^(f * ln2), i = round(x), f in [-0.5, 0.5]
+ * taylor series truncated after t^6, |t| <= 0.347, truncation error < 2.0e-7
+ */
+ITCM_CODE float Fast_Exp2f(float x)
+{
+    Math_FloatBit_TypeDef bit;
+    int32_t i = 0;
+    float t = 0.0f;
+    float p = 0.0f;
+
+    if (x > 127.0f)
+        x = 127.0f;
+
+    if (x < -126.0f)
+        x = -126.0f;
+
+    i = (int32_t)(x + ((x >= 0.0f) ? 0.5f : -0.5f));
+    t = (x - (float)i) * MATH_LN2;
+    p = 1.0f + t * (1.0f + t * (0.5f + t * (0.166666667f + t * (0.0416666667f + t * (0.00833333333f + t * 0.00138888889f)))));
+
+    bit.u = (uint32_t)(i + 127) << 23;
+
+    return p * bit.f;
+}
+
+ITCM_CODE float Fast_Powf(float x, float y)
+{
+    if (x <= 0.0f)
+        return 0.0f;
+
+    if (y == 0.0f)
+        return 1.0f;
+
+    return Fast_Exp2f(y * Fast_Log2f(x));
+}
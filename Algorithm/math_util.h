@@ -4,20 +4,46 @@
 #include <stdbool.h>
 #include <stdint.h>
 
-inline float Deg2Rad(float deg)
+/*
+ * single precision only
+ * at32f435 (cortex-m4f) have no double fpu, any double literal or double libm call fall into software emulation
+ * keep every constant in this file with 'f' suffix
+ */
+#define MATH_PI             3.14159265358979f
+#define MATH_HALF_PI        1.57079632679490f
+#define MATH_DEG_PER_RAD    57.2957795130823f
+#define MATH_RAD_PER_DEG    0.0174532925199433f
+#define MATH_GRAVITY        9.80665f            /* standard gravity m/s^2 */
+
+static inline float Deg2Rad(float deg)
 {
-    return deg / 57.3f;
+    return deg * MATH_RAD_PER_DEG;
 }
 
-inline float Rad2Deg(float rad)
+static inline float Rad2Deg(float rad)
 {
-    return rad * 57.3f;
+    return rad * MATH_DEG_PER_RAD;
 }
 
 /* g to meter per square sec */
-inline float g2Mpss(float g)
+static inline float g2Mpss(float g)
 {
-    return g * 9.8;
+    return g * MATH_GRAVITY;
 }
 
+/*
+ * fast approximation, error bound measured against double libm
+ * Fast_Atan2f : abs error <= 1.2e-5 rad
+ * Fast_Asinf  : abs error <= 1.2e-5 rad, input clamped into [-1, 1]
+ * Fast_Log2f  : abs error <= 2.5e-7 + 6.0e-8 * |log2(x)| for x in [2^-20, 2^20], the second term is the float
+ *               rounding of the result itself, x must be positive and normal
+ * Fast_Exp2f  : rel error <= 2.5e-7, input clamped into [-126, 127]
+ * Fast_Powf   : rel error <= 1.5e-6 for x in [0.01, 100] and y in [-3, 3], 1.0e-7 on baro pressure ratio, x must be positive
+ */
+float Fast_Atan2f(float y, float x);
+float Fast_Asinf(float x);
+float Fast_Log2f(float x);
+float Fast_Exp2f(float x);
+float Fast_Powf(float x, float y);
+
 #endif
@@ -0,0 +1,95 @@
+/*
+ * host stand in of the service the benched kernel depend on
+ *   os common : malloc / free on the host heap, allocation counted the way heap_5 report it
+ *   kernel    : cycle counter run in ns of the host monotonic clock
+ *   shell     : no instance, print straight to stdout
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <time.h>
+#include "Srv_OsCommon.h"
+#include "kernel.h"
+#include "shell_port.h"
+
+#define BENCH_PORT_CYCLE_CLOCK 1000000000UL
+
+/* internal vriable */
+static uint32_t BenchPort_Malloc_Cnt = 0;
+static uint32_t BenchPort_Free_Cnt = 0;
+
+/* internal function */
+static void *BenchPort_Malloc(uint16_t size);
+static void *BenchPort_Malloc_Tag(SrvOs_HeapRegion_List region, uint32_t size);
+static void BenchPort_Free(void *ptr);
+static void BenchPort_Get_HeapStatus(SrvOs_HeapStatus_TypeDef *status);
+
+SrvOsCommon_TypeDef SrvOsCommon = {
+    .malloc = BenchPort_Malloc,
+    .malloc_tag = BenchPort_Malloc_Tag,
+    .free = BenchPort_Free,
+    .get_heap_status = BenchPort_Get_HeapStatus,
+};
+
+static void *BenchPort_Malloc(uint16_t size)
+{
+    void *ptr = malloc(size);
+
+    if (ptr)
+        BenchPort_Malloc_Cnt ++;
+
+    return ptr;
+}
+
+static void *BenchPort_Malloc_Tag(SrvOs_HeapRegion_List region, uint32_t size)
+{
+    (void)region;
+    return BenchPort_Malloc((uint16_t)size);
+}
+
+static void BenchPort_Free(void *ptr)
+{
+    if (ptr)
+    {
+        BenchPort_Free_Cnt ++;
+        free(ptr);
+    }
+}
+
+static void BenchPort_Get_HeapStatus(SrvOs_HeapStatus_TypeDef *status)
+{
+    if (status == NULL)
+        return;
+
+    memset(status, 0, sizeof(SrvOs_HeapStatus_TypeDef));
+    status->xNumberOfSuccessfulAllocations = BenchPort_Malloc_Cnt;
+    status->xNumberOfSuccessfulFrees = BenchPort_Free_Cnt;
+}
+
+uint32_t Kernel_Get_CycleCnt(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec);
+}
+
+uint32_t Kernel_Get_SysClock(void)
+{
+    return BENCH_PORT_CYCLE_CLOCK;
+}
+
+Shell *Shell_GetInstence(void)
+{
+    return NULL;
+}
+
+void shellPrint(Shell *shell, char *fmt, ...)
+{
+    va_list args;
+
+    (void)shell;
+    va_start(args, fmt);
+    vprintf(fmt, args);
+    va_end(args);
+}
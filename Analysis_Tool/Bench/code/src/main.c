@@ -0,0 +1,93 @@
+/*
+ * host run of the firmware kernel bench (debug/bench.c)
+ * every case is run several times and the fastest pass is kept, host scheduling noise only add time
+ * csv output is meant to be diffed between two build to catch hot path regression
+ *
+ * usage : bench [-r repeat] [-o csv path]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "bench.h"
+
+#define BENCH_REPEAT_DEF 5
+
+int main(int argc, char *argv[])
+{
+    Bench_Result_TypeDef result[Bench_Case_Sum];
+    Bench_Result_TypeDef pass;
+    const char *csv_path = NULL;
+    FILE *csv_file = NULL;
+    uint32_t repeat = BENCH_REPEAT_DEF;
+    double ns_per_op = 0.0;
+    int opt = 0;
+
+    while ((opt = getopt(argc, argv, "r:o:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'r': repeat = (uint32_t)atoi(optarg); break;
+            case 'o': csv_path = optarg; break;
+            default:
+                printf("usage : %s [-r repeat] [-o csv path]\r\n", argv[0]);
+                return -1;
+        }
+    }
+
+    if (repeat == 0)
+        repeat = 1;
+
+    for (uint8_t i = 0; i < Bench_Case_Sum; i++)
+    {
+        for (uint32_t r = 0; r < repeat; r++)
+        {
+            if (!Bench.run((Bench_Case_List)i, &pass))
+            {
+                printf("[Bench] case %d init failed\r\n", i);
+                return -1;
+            }
+
+            if ((r == 0) || (pass.loop_cyc < result[i].loop_cyc))
+                result[i] = pass;
+        }
+    }
+
+    if (csv_path)
+    {
+        csv_file = fopen(csv_path, "w");
+        if (csv_file == NULL)
+        {
+            printf("[Bench] open %s failed\r\n", csv_path);
+            return -1;
+        }
+
+        fprintf(csv_file, "case,ns_per_op,min_ns,max_ns,alloc,init_ns,init_alloc\n");
+    }
+
+    printf("[Bench] %d loop, best of %d\r\n", BENCH_LOOP, repeat);
+    printf("%-20s %9s %8s %8s %10s %6s %10s %6s\r\n", "case", "ns/op", "min", "max", "Mop/s", "alloc", "init ns", "alloc");
+
+    for (uint8_t i = 0; i < Bench_Case_Sum; i++)
+    {
+        ns_per_op = (double)Bench.cyc_to_ns(result[i].loop_cyc) / result[i].loop;
+
+        printf("%-20s %9.1f %8u %8u %10.2f %6u %10u %6u\r\n",
+               result[i].name, ns_per_op,
+               Bench.cyc_to_ns(result[i].min_cyc), Bench.cyc_to_ns(result[i].max_cyc),
+               (ns_per_op > 0.0) ? (1000.0 / ns_per_op) : 0.0,
+               result[i].alloc, Bench.cyc_to_ns(result[i].init_cyc), result[i].init_alloc);
+
+        if (csv_file)
+        {
+            fprintf(csv_file, "%s,%.1f,%u,%u,%u,%u,%u\n",
+                    result[i].name, ns_per_op,
+                    Bench.cyc_to_ns(result[i].min_cyc), Bench.cyc_to_ns(result[i].max_cyc),
+                    result[i].alloc, Bench.cyc_to_ns(result[i].init_cyc), result[i].init_alloc);
+        }
+    }
+
+    if (csv_file)
+        fclose(csv_file);
+
+    return 0;
+}
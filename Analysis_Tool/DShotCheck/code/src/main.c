@@ -0,0 +1,248 @@
+/*
+ * host check of the dshot frame encoder in Dev_Dshot_Frame.h
+ * every throttle / command value with and without telemetry request is encoded by the lut expansion
+ * and compared against a bit by bit reference, single channel (stride 1) and interleaved burst buffer (stride 2 ~ 4)
+ * bidirectional telemetry: every erpm period is gcr encoded into jittered 16 bit capture timestamp and decoded back
+ *
+ * usage : dshot_check
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Dev_Dshot_Frame.h"
+
+#define CHECK_VALUE_NUM 2048
+#define CHECK_MAX_STRIDE 4
+#define CHECK_BENCH_LOOP 1000000
+#define CHECK_ERPM_JITTER_SEED 4
+
+/* nibble to 5 bit gcr symbol */
+static const uint8_t Check_GCR_Encode[16] = {
+    0x19, 0x1B, 0x12, 0x13, 0x1D, 0x15, 0x16, 0x17,
+    0x1A, 0x09, 0x0A, 0x0B, 0x1E, 0x0D, 0x0E, 0x0F,
+};
+
+/* reference encoder, straight from the dshot frame description */
+static void Check_Reference(uint32_t *buf, uint16_t value, bool telemetry)
+{
+    uint16_t data = (value << 1) | (telemetry ? 1 : 0);
+    uint16_t csum = 0;
+    uint16_t csum_data = data;
+    uint16_t packet = 0;
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        csum ^= csum_data;
+        csum_data >>= 4;
+    }
+
+    packet = (data << 4) | (csum & 0xF);
+
+    for (uint8_t i = 0; i < DSHOT_FRAME_SIZE; i++)
+    {
+        buf[i] = (packet & (0x8000 >> i)) ? MOTOR_BIT_1 : MOTOR_BIT_0;
+    }
+
+    buf[DSHOT_FRAME_SIZE] = 0;
+    buf[DSHOT_FRAME_SIZE + 1] = 0;
+}
+
+/*
+ * esc side of the telemetry answer
+ * 12 bit eee mmmmmmmmm + inverted checksum -> 4 gcr symbol -> start bit + 20 bit, each '1' toggle the line
+ * return the capture timestamp of every edge, masked to the 16 bit capture counter
+ */
+static uint16_t Check_Telemetry_Payload(uint16_t value)
+{
+    return (value << 4) | (~(value ^ (value >> 4) ^ (value >> 8)) & 0xF);
+}
+
+static uint8_t Check_Telemetry_Edge(uint16_t value, uint16_t base, int32_t jitter, uint32_t *edge, uint32_t *tx)
+{
+    uint16_t payload = Check_Telemetry_Payload(value);
+    uint32_t gcr = 1 << 20;
+    uint8_t edge_num = 0;
+    int32_t offset = 0;
+
+    for (uint8_t nibble = 0; nibble < 4; nibble++)
+    {
+        gcr |= (uint32_t)Check_GCR_Encode[(payload >> (nibble * 4)) & 0xF] << (nibble * 5);
+    }
+
+    for (uint8_t bit = 0; bit < DSHOT_GCR_BIT_NUM; bit++)
+    {
+        if (gcr & (1 << (20 - bit)))
+        {
+            /* alternate early / late edge */
+            offset = (edge_num & 1) ? jitter : -jitter;
+            edge[edge_num ++] = (uint32_t)((int32_t)base + bit * DSHOT_GCR_BIT_TICK + offset) & DSHOT_TELEMETRY_EDGE_MASK;
+        }
+    }
+
+    *tx = gcr;
+    return edge_num;
+}
+
+static uint32_t Check_Telemetry(void)
+{
+    uint32_t edge[DSHOT_TELEMETRY_EDGE_MAX];
+    uint32_t frame_cnt = 0;
+    uint32_t err_cnt = 0;
+    uint32_t tx = 0;
+    uint32_t gcr = 0;
+    uint32_t erpm = 0;
+    uint32_t ref_erpm = 0;
+    uint32_t period = 0;
+    uint16_t base = 0;
+    uint8_t edge_num = 0;
+    int32_t jitter = 0;
+    uint8_t nibble = 0;
+    uint8_t corrupt = 0;
+    bool state = false;
+
+    for (uint16_t value = 0; value < 0x1000; value++)
+    {
+        period = (value & 0x1FF) << (value >> 9);
+        if ((period == 0) && (value != 0x0FFF))
+            continue;
+
+        ref_erpm = (value == 0x0FFF) ? 0 : (60000000 + period / 2) / period;
+
+        for (uint8_t seed = 0; seed < CHECK_ERPM_JITTER_SEED; seed++)
+        {
+            /* timestamp base close to the counter wrap, edge jitter up to a fifth bit, run length off by 0.4 bit at worst */
+            base = (uint16_t)(0xFFFF - value * 7 - seed * 97);
+            jitter = (int32_t)((DSHOT_GCR_BIT_TICK / 5) * seed) / (CHECK_ERPM_JITTER_SEED - 1);
+
+            edge_num = Check_Telemetry_Edge(value, base, jitter, edge, &tx);
+            state = DevDshot_Decode_Edge(edge, edge_num, DSHOT_GCR_BIT_TICK, &gcr) && DevDshot_Decode_eRPM(gcr, &erpm);
+
+            if (!state || (gcr != tx) || (erpm != ref_erpm))
+            {
+                if (err_cnt < 10)
+                    printf("telemetry mismatch value 0x%03X seed %d : state %d gcr 0x%06X / 0x%06X erpm %u / %u\r\n",
+                           value, seed, state, gcr, tx, erpm, ref_erpm);
+                err_cnt ++;
+            }
+
+            /* one corrupted nibble still on a valid gcr symbol, must fail on checksum */
+            nibble = seed % 4;
+            corrupt = (Check_Telemetry_Payload(value) >> (nibble * 4)) & 0xF;
+            gcr = (tx & ~(0x1F << (nibble * 5))) | ((uint32_t)Check_GCR_Encode[corrupt ^ (1 << seed)] << (nibble * 5));
+            if (DevDshot_Decode_eRPM(gcr, &erpm))
+            {
+                if (err_cnt < 10)
+                    printf("corrupted telemetry accepted value 0x%03X nibble %d\r\n", value, nibble);
+                err_cnt ++;
+            }
+
+            frame_cnt ++;
+        }
+    }
+
+    printf("[DShot Telemetry Check] %u frame, %u error\r\n", frame_cnt, err_cnt);
+    return err_cnt;
+}
+
+/* bidirectional request carry the inverted checksum */
+static uint32_t Check_Bidir_Packet(void)
+{
+    uint32_t err_cnt = 0;
+    uint16_t data = 0;
+    uint16_t csum = 0;
+
+    for (uint16_t v = 0; v < CHECK_VALUE_NUM; v++)
+    {
+        data = v << 1;
+        csum = (~(data ^ (data >> 4) ^ (data >> 8))) & 0xF;
+
+        if (DevDshot_Prepare_Bidir_Packet(v) != (uint16_t)((data << 4) | csum))
+            err_cnt ++;
+    }
+
+    printf("[DShot Bidir Packet Check] %u packet, %u error\r\n", CHECK_VALUE_NUM, err_cnt);
+    return err_cnt;
+}
+
+static uint64_t Check_Get_Ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+int main(void)
+{
+    uint32_t ref[DSHOT_DMA_BUFFER_SIZE];
+    uint32_t buf[DSHOT_DMA_BUFFER_SIZE * CHECK_MAX_STRIDE];
+    uint32_t frame_cnt = 0;
+    uint32_t err_cnt = 0;
+    uint16_t val[CHECK_MAX_STRIDE];
+    uint64_t ns = 0;
+    volatile uint32_t sink = 0;
+
+    for (uint8_t stride = 1; stride <= CHECK_MAX_STRIDE; stride++)
+    {
+        for (uint32_t v = 0; v < CHECK_VALUE_NUM; v++)
+        {
+            for (uint8_t tlm = 0; tlm < 2; tlm++)
+            {
+                /* every slot carry a different value, catch cross slot overwrite */
+                for (uint8_t slot = 0; slot < stride; slot++)
+                {
+                    val[slot] = (v + slot * 517) % CHECK_VALUE_NUM;
+                }
+
+                memset(buf, 0xA5, sizeof(buf));
+                for (uint8_t slot = 0; slot < stride; slot++)
+                {
+                    DevDshot_Expand_Packet(&buf[slot], stride, DevDshot_Prepare_Packet(val[slot], tlm));
+                }
+
+                for (uint8_t slot = 0; slot < stride; slot++)
+                {
+                    Check_Reference(ref, val[slot], tlm);
+
+                    for (uint8_t bit = 0; bit < DSHOT_DMA_BUFFER_SIZE; bit++)
+                    {
+                        if (buf[bit * stride + slot] != ref[bit])
+                        {
+                            if (err_cnt < 10)
+                                printf("mismatch stride %d slot %d value %d tlm %d bit %d : %u / %u\r\n",
+                                       stride, slot, val[slot], tlm, bit, buf[bit * stride + slot], ref[bit]);
+                            err_cnt ++;
+                        }
+                    }
+
+                    frame_cnt ++;
+                }
+            }
+        }
+    }
+
+    printf("[DShot Frame Check] %u frame, %u error\r\n", frame_cnt, err_cnt);
+
+    err_cnt += Check_Bidir_Packet();
+    err_cnt += Check_Telemetry();
+
+    /* encode cost, lut expansion against the reference loop */
+    ns = Check_Get_Ns();
+    for (uint32_t i = 0; i < CHECK_BENCH_LOOP; i++)
+    {
+        DevDshot_Expand_Packet(buf, 1, DevDshot_Prepare_Packet(i & 0x7FF, false));
+        sink += buf[i & 0xF];
+    }
+    printf("\tlut encode       : %.2f ns/frame\r\n", (double)(Check_Get_Ns() - ns) / CHECK_BENCH_LOOP);
+
+    ns = Check_Get_Ns();
+    for (uint32_t i = 0; i < CHECK_BENCH_LOOP; i++)
+    {
+        Check_Reference(buf, i & 0x7FF, false);
+        sink += buf[i & 0xF];
+    }
+    printf("\treference encode : %.2f ns/frame\r\n", (double)(Check_Get_Ns() - ns) / CHECK_BENCH_LOOP);
+
+    return err_cnt ? EXIT_FAILURE : EXIT_SUCCESS;
+}
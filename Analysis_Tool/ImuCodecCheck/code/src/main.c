@@ -0,0 +1,193 @@
+/*
+ * host check of the imu log codec in common/compess/imu_codec.c
+ *      quantize : every int16 lsb of every sensor scale go through lsb / scale and back to the same lsb,
+ *                 value past full scale and nan saturate without sign wrap
+ *      codec    : synthetic imu stream (noise, full range step, scale change, time jitter) encoded in random
+ *                 sized batch the same way the log task do, decoded and compared sample by sample
+ * the run fail on any mismatch, compress ratio is reported
+ *
+ * usage : imu_codec_check [seed]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "imu_codec.h"
+
+#define CHECK_SAMPLE_NUM 20000
+#define CHECK_BATCH_MAX 96
+#define CHECK_SCALE_CHANGE_AT (CHECK_SAMPLE_NUM / 2)
+#define CHECK_DEF_SEED 1
+
+/* gyro 2000 / 1000 / 500 / 250 dps, acc 16 / 8 / 4 / 2 g */
+static const float Check_Gyr_Scale[] = {16.4f, 32.8f, 65.5f, 131.0f};
+static const float Check_Acc_Scale[] = {2048.0f, 4096.0f, 8192.0f, 16384.0f};
+
+static ImuCodec_Sample_TypeDef Check_In[CHECK_SAMPLE_NUM];
+static ImuCodec_Sample_TypeDef Check_Out[CHECK_BATCH_MAX];
+static uint8_t Check_Buf[((CHECK_BATCH_MAX + IMU_CODEC_BLOCK_SIZE - 1) / IMU_CODEC_BLOCK_SIZE + 1) * IMU_CODEC_BLOCK_MAX_BYTE];
+
+static uint32_t Check_Report(const char *name, uint32_t err_cnt, uint32_t total)
+{
+    printf("\t%-12s %u / %u mismatch %s\r\n", name, err_cnt, total, err_cnt ? "<- FAILED" : "");
+
+    return err_cnt ? 1 : 0;
+}
+
+static uint32_t Check_Quantize_Scale(float scale)
+{
+    uint32_t err_cnt = 0;
+    uint32_t trunc_cnt = 0;
+    float val = 0.0f;
+
+    for (int32_t lsb = INT16_MIN; lsb <= INT16_MAX; lsb++)
+    {
+        val = (float)lsb / scale;
+
+        if (ImuCodec_Quantize(val, scale) != lsb)
+            err_cnt ++;
+
+        /* plain cast the log task used before, reported only */
+        if ((int32_t)(int16_t)(scale * val) != lsb)
+            trunc_cnt ++;
+    }
+
+    printf("\tscale %-7.1f %u / 65536 mismatch (truncate cast %u) %s\r\n", (double)scale, err_cnt, trunc_cnt, err_cnt ? "<- FAILED" : "");
+
+    return err_cnt ? 1 : 0;
+}
+
+static uint32_t Check_Saturate(void)
+{
+    uint32_t err_cnt = 0;
+    float full_scale = 0.0f;
+
+    for (uint8_t i = 0; i < sizeof(Check_Gyr_Scale) / sizeof(Check_Gyr_Scale[0]); i++)
+    {
+        full_scale = INT16_MAX / Check_Gyr_Scale[i];
+
+        err_cnt += (ImuCodec_Quantize(full_scale * 1.05f, Check_Gyr_Scale[i]) != INT16_MAX);
+        err_cnt += (ImuCodec_Quantize(-full_scale * 1.05f, Check_Gyr_Scale[i]) != INT16_MIN);
+        err_cnt += (ImuCodec_Quantize(full_scale * 1000.0f, Check_Gyr_Scale[i]) != INT16_MAX);
+        err_cnt += (ImuCodec_Quantize(-full_scale * 1000.0f, Check_Gyr_Scale[i]) != INT16_MIN);
+        err_cnt += (ImuCodec_Quantize(INFINITY, Check_Gyr_Scale[i]) != INT16_MAX);
+        err_cnt += (ImuCodec_Quantize(-INFINITY, Check_Gyr_Scale[i]) != INT16_MIN);
+        err_cnt += (ImuCodec_Quantize(NAN, Check_Gyr_Scale[i]) != INT16_MIN);
+    }
+
+    return Check_Report("saturate", err_cnt, 7 * sizeof(Check_Gyr_Scale) / sizeof(Check_Gyr_Scale[0]));
+}
+
+static int16_t Check_Clamp(int32_t val)
+{
+    if (val > INT16_MAX)
+        return INT16_MAX;
+
+    if (val < INT16_MIN)
+        return INT16_MIN;
+
+    return (int16_t)val;
+}
+
+/* random walk plus sensor noise, every channel jump across the full range now and then */
+static void Check_Gen_Stream(void)
+{
+    int32_t level[IMU_CODEC_CH_NUM] = {0};
+    uint32_t time = 1000;
+    uint8_t cyc = 0;
+
+    for (uint32_t i = 0; i < CHECK_SAMPLE_NUM; i++)
+    {
+        /* 1ms sample with the odd late or missed one */
+        time += ((rand() % 50) == 0) ? (1 + rand() % 3) : 1;
+        cyc += ((rand() % 200) == 0) ? 2 : 1;
+
+        Check_In[i].time = time;
+        Check_In[i].cyc = cyc;
+        Check_In[i].acc_scale = (i < CHECK_SCALE_CHANGE_AT) ? Check_Acc_Scale[0] : Check_Acc_Scale[1];
+        Check_In[i].gyr_scale = (i < CHECK_SCALE_CHANGE_AT) ? Check_Gyr_Scale[0] : Check_Gyr_Scale[1];
+
+        for (uint8_t ch = 0; ch < IMU_CODEC_CH_NUM; ch++)
+        {
+            level[ch] += (rand() % 201) - 100;
+
+            if ((rand() % 1000) == 0)
+                level[ch] = (rand() & 1) ? INT16_MAX : INT16_MIN;
+
+            level[ch] = Check_Clamp(level[ch]);
+            Check_In[i].ch[ch] = Check_Clamp(level[ch] + (rand() % 33) - 16);
+        }
+    }
+}
+
+static uint32_t Check_Codec(void)
+{
+    uint32_t err_cnt = 0;
+    uint32_t batch_cnt = 0;
+    uint64_t raw_byte = 0;
+    uint64_t enc_byte = 0;
+    uint16_t batch = 0;
+    uint16_t size = 0;
+    uint16_t num = 0;
+
+    Check_Gen_Stream();
+
+    for (uint32_t i = 0; i < CHECK_SAMPLE_NUM; i += batch)
+    {
+        batch = 1 + rand() % CHECK_BATCH_MAX;
+        if (batch > (CHECK_SAMPLE_NUM - i))
+            batch = CHECK_SAMPLE_NUM - i;
+
+        batch_cnt ++;
+        size = ImuCodec_Encode(&Check_In[i], batch, Check_Buf, sizeof(Check_Buf));
+        if (size == 0)
+        {
+            err_cnt += batch;
+            continue;
+        }
+
+        memset(Check_Out, 0, sizeof(Check_Out));
+        num = ImuCodec_Decode(Check_Buf, size, Check_Out, CHECK_BATCH_MAX);
+        if (num != batch)
+        {
+            err_cnt += batch;
+            continue;
+        }
+
+        for (uint16_t s = 0; s < batch; s++)
+        {
+            if (memcmp(&Check_In[i + s], &Check_Out[s], sizeof(ImuCodec_Sample_TypeDef)) != 0)
+                err_cnt ++;
+        }
+
+        raw_byte += batch * sizeof(ImuCodec_Sample_TypeDef);
+        enc_byte += size;
+    }
+
+    printf("[Codec] %d sample in %u batch, %.1f%% of raw size\r\n", CHECK_SAMPLE_NUM, batch_cnt, enc_byte ? (100.0 * enc_byte / raw_byte) : 0.0);
+    return Check_Report("round trip", err_cnt, CHECK_SAMPLE_NUM);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t seed = CHECK_DEF_SEED;
+    uint32_t err_cnt = 0;
+
+    if (argc > 1)
+        seed = (uint32_t)strtoul(argv[1], NULL, 0);
+
+    srand(seed);
+
+    printf("[IMU Codec Check] seed %u\r\n", seed);
+    printf("[Quantize] lsb / scale -> lsb\r\n");
+    for (uint8_t i = 0; i < sizeof(Check_Gyr_Scale) / sizeof(Check_Gyr_Scale[0]); i++)
+        err_cnt += Check_Quantize_Scale(Check_Gyr_Scale[i]);
+
+    for (uint8_t i = 0; i < sizeof(Check_Acc_Scale) / sizeof(Check_Acc_Scale[0]); i++)
+        err_cnt += Check_Quantize_Scale(Check_Acc_Scale[i]);
+
+    err_cnt += Check_Saturate();
+    err_cnt += Check_Codec();
+
+    return err_cnt ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -10,6 +10,7 @@
 
 #define DEFAULT_DECOMPESS_BUF_SIZE 1024
 #define LOG_COMPESS_HEADER 0xCA
+#define LOG_CODEC_HEADER 0xCB
 #define LOG_COMPESS_ENDER 0xED
 
 typedef struct
@@ -13,8 +13,8 @@
 #define CONVERT_EXTEND_FILE_NAME ".txt"
 
 #define FILE_GET_B(x) (x % BASE_SIZE_UNIT)
-#define FILE_GET_KB(x) ((x / FILE_SIZE_K(1)) % FILE_SIZE_M(1))
-#define FILE_GET_MB(x) (x % FILE_SIZE_M(1))
+#define FILE_GET_KB(x) ((x / FILE_SIZE_K(1)) % BASE_SIZE_UNIT)
+#define FILE_GET_MB(x) (x / FILE_SIZE_M(1))
 
 #define MIN_LOG_FILENAME_LEN 5
 #define EXTEND_FILETYPE_NAME ".log"
@@ -0,0 +1,30 @@
+#ifndef __SEGMENT_DECODE_H
+#define __SEGMENT_DECODE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include "../inc/logfile.h"
+
+/* same layout as the segment header in System/storage/Blackbox.h */
+#define BLACKBOX_SEGMENT_TAG 0x424C4B42 /* "BLKB" */
+#define BLACKBOX_SEGMENT_SIZE 4096
+
+#pragma pack(1)
+typedef struct
+{
+    uint32_t tag;
+    uint32_t seq;
+    uint16_t session;
+    uint16_t crc16;
+} BlackboxSeg_Header_TypeDef;
+#pragma pack()
+
+#define BLACKBOX_SEGMENT_HEADER_SIZE sizeof(BlackboxSeg_Header_TypeDef)
+
+bool LogFile_Segment_Strip(LogFileObj_TypeDef *file);
+
+#endif
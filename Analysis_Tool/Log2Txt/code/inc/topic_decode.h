@@ -0,0 +1,36 @@
+#ifndef __TOPIC_DECODE_H
+#define __TOPIC_DECODE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "../inc/logfile.h"
+#include "log_topic.h"
+
+typedef struct
+{
+    char name[LOG_TOPIC_NAME_LEN];
+    uint8_t type;
+    uint8_t num;
+} TopicField_TypeDef;
+
+typedef struct
+{
+    bool valid;
+    char name[LOG_TOPIC_NAME_LEN];
+    uint16_t period_ms;
+    uint16_t record_size;
+    uint8_t field_num;
+    TopicField_TypeDef field[LOG_TOPIC_FIELD_MAX];
+
+    FILE *cnv_file;
+    uint64_t record_cnt;
+} TopicDesc_TypeDef;
+
+bool LogFile_Topic_Schema(LogFileObj_TypeDef *file, const uint8_t *p_data, uint32_t size);
+bool LogFile_Topic_Data(const uint8_t *p_data, uint32_t size);
+void LogFile_Topic_Close(void);
+
+#endif
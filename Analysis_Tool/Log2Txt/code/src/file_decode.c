@@ -1,6 +1,8 @@
 #include "../inc/var_def.h"
 #include "../inc/file_decode.h"
 #include "minilzo.h"
+#include "imu_codec.h"
+#include "../inc/topic_decode.h"
 
 /* create a 4M buffer */
 static uint8_t decompess_file_buff[4 * 1024 * 1024] __attribute__((align(32))) = {0};
@@ -16,6 +18,43 @@ uint32_t done = 0;
 
 static uint16_t LogFile_Decode_IMUData(FILE *cnv_file, uint8_t *data, uint16_t size);
 
+/* expand codec frame into the same header + imu record stream lzo frame decompess into */
+static bool LogFile_Codec_Expand(const uint8_t *p_in, uint32_t size, uint8_t *p_out, uint32_t *out_len)
+{
+    static ImuCodec_Sample_TypeDef sample[IMU_CODEC_BLOCK_SIZE * 8];
+    IMU_LogUnionData_TypeDef IMU_Data;
+    LogData_Header_TypeDef header = {.header = LOG_HEADER, .type = LOG_DATATYPE_IMU, .size = LOG_IMU_DATA_SIZE};
+    uint16_t num = ImuCodec_Decode(p_in, size, sample, sizeof(sample) / sizeof(sample[0]));
+
+    *out_len = 0;
+    if (num == 0)
+        return false;
+
+    for (uint16_t i = 0; i < num; i++)
+    {
+        memset(IMU_Data.buff, 0, sizeof(IMU_Data.buff));
+        IMU_Data.data.time = sample[i].time;
+        IMU_Data.data.cyc = sample[i].cyc;
+        IMU_Data.data.acc_scale = sample[i].acc_scale;
+        IMU_Data.data.gyr_scale = sample[i].gyr_scale;
+
+        for (uint8_t axis = Axis_X; axis < Axis_Sum; axis++)
+        {
+            IMU_Data.data.org_acc[axis] = sample[i].ch[ImuCodec_OrgAcc + axis];
+            IMU_Data.data.org_gyr[axis] = sample[i].ch[ImuCodec_OrgGyr + axis];
+            IMU_Data.data.flt_acc[axis] = sample[i].ch[ImuCodec_FltAcc + axis];
+            IMU_Data.data.flt_gyr[axis] = sample[i].ch[ImuCodec_FltGyr + axis];
+        }
+
+        memcpy(p_out + *out_len, &header, sizeof(header));
+        *out_len += sizeof(header);
+        memcpy(p_out + *out_len, IMU_Data.buff, sizeof(IMU_Data.buff));
+        *out_len += sizeof(IMU_Data.buff);
+    }
+
+    return true;
+}
+
 decompess_io_stream *LogFile_Decompess_Init(LogFileObj_TypeDef *file)
 {
     uint32_t first_header_match = 0;
@@ -25,6 +64,8 @@ decompess_io_stream *LogFile_Decompess_Init(LogFileObj_TypeDef *file)
     uint32_t compess_ender_cnt = 0;
 
     uint32_t cur_header_pos = 0;
+    uint8_t cur_pck_type = LOG_COMPESS_HEADER;
+    bool decompess_state = false;
 
     uint32_t cur_pck_size = 0;
     uint32_t check_pck_size = 0;
@@ -59,8 +100,12 @@ decompess_io_stream *LogFile_Decompess_Init(LogFileObj_TypeDef *file)
     /* decompess file down below */
     for(uint32_t i = 0; i < file->logfile_size.total_byte; i++)
     {
-        if(file->bin_data[i] == LOG_COMPESS_HEADER)
+        /* 0xCA lzo frame from old firmware, 0xCB imu codec frame, 0xCC / 0xCD topic data / schema frame */
+        if((file->bin_data[i] == LOG_COMPESS_HEADER) || (file->bin_data[i] == LOG_CODEC_HEADER) ||
+           (file->bin_data[i] == LOG_TOPIC_DATA_HEADER) || (file->bin_data[i] == LOG_TOPIC_SCHEMA_HEADER))
         {
+            cur_pck_type = file->bin_data[i];
+
             if(compess_header_cnt == 0)
                 first_header_match = i;
 
@@ -109,7 +154,24 @@ decompess_io_stream *LogFile_Decompess_Init(LogFileObj_TypeDef *file)
                 memcpy(compess_buff, &file->bin_data[cur_header_pos + 5], check_pck_size);
 
                 /* decompess data */
-                if(lzo1x_decompress(compess_buff, check_pck_size, decompess_file_buff, &decompess_len, NULL) == LZO_E_OK)
+                if(cur_pck_type == LOG_TOPIC_SCHEMA_HEADER)
+                {
+                    decompess_state = LogFile_Topic_Schema(file, compess_buff, check_pck_size);
+                    decompess_len = 0;
+                }
+                else if(cur_pck_type == LOG_TOPIC_DATA_HEADER)
+                {
+                    decompess_state = LogFile_Topic_Data(compess_buff, check_pck_size);
+                    decompess_len = 0;
+                }
+                else if(cur_pck_type == LOG_CODEC_HEADER)
+                {
+                    decompess_state = LogFile_Codec_Expand(compess_buff, check_pck_size, decompess_file_buff, &decompess_len);
+                }
+                else
+                    decompess_state = (lzo1x_decompress(compess_buff, check_pck_size, decompess_file_buff, &decompess_len, NULL) == LZO_E_OK);
+
+                if(decompess_state)
                 {
                     stream_size += decompess_len;
                     /* decode data */
@@ -205,6 +267,7 @@ Decode_EOF:
     printf("[INFO]  Match IMU Header              : %d\r\n", match_imu_frame_cnt);
 
     /* close convert file */
+    LogFile_Topic_Close();
     fclose(file->cnv_log_file);
 
     return &decompess_stream;
@@ -1,6 +1,7 @@
 #include "../inc/var_def.h"
 #include "../inc/logfile.h"
 #include "../inc/file_decode.h"
+#include "../inc/segment_decode.h"
 #include <sys/stat.h>
 
 #define MAX_LOAD_MB_SIZE 64
@@ -40,7 +41,7 @@ static bool Load_File(char *path, LogFileObj_TypeDef *obj)
     struct stat file_stat;
     bool state = false;
     uint16_t offset = 0;
-    char path_tmp[128] = "";
+    static char path_tmp[128] = ""; /* file path is kept in obj after load */
     char *logfile_name_tmp = NULL;
     char *cnvfile_name_tmp = NULL;
     char cnvfile_path[1024] = "";
@@ -66,15 +67,16 @@ static bool Load_File(char *path, LogFileObj_TypeDef *obj)
                 memset(path_tmp, '\0', offset);
                 memcpy(path_tmp, path, offset);
 
-                logfile_name_tmp = malloc(strlen(path) - offset);
-                cnvfile_name_tmp = malloc(strlen(path) - offset - strlen(EXTEND_FILETYPE_NAME) + strlen(CONVERT_EXTEND_FILE_NAME));
+                /* one more byte for the terminator */
+                logfile_name_tmp = malloc(strlen(path) - offset + 1);
+                cnvfile_name_tmp = malloc(strlen(path) - offset - strlen(EXTEND_FILETYPE_NAME) + strlen(CONVERT_EXTEND_FILE_NAME) + 1);
 
-                memset(logfile_name_tmp, '\0', strlen(path) - offset);
-                memset(cnvfile_name_tmp, '\0', strlen(path) - offset - strlen(EXTEND_FILETYPE_NAME) + strlen(CONVERT_EXTEND_FILE_NAME));
+                memset(logfile_name_tmp, '\0', strlen(path) - offset + 1);
+                memset(cnvfile_name_tmp, '\0', strlen(path) - offset - strlen(EXTEND_FILETYPE_NAME) + strlen(CONVERT_EXTEND_FILE_NAME) + 1);
 
                 memcpy(logfile_name_tmp, path + offset, strlen(path) - offset);
                 memcpy(cnvfile_name_tmp, path + offset, strlen(path) - offset - strlen(EXTEND_FILETYPE_NAME));
-                memcpy(cnvfile_name_tmp + strlen(CONVERT_EXTEND_FILE_NAME) - 1, CONVERT_EXTEND_FILE_NAME, strlen(CONVERT_EXTEND_FILE_NAME));
+                memcpy(cnvfile_name_tmp + strlen(path) - offset - strlen(EXTEND_FILETYPE_NAME), CONVERT_EXTEND_FILE_NAME, strlen(CONVERT_EXTEND_FILE_NAME));
 
                 obj->path = path_tmp;
                 obj->log_file_name = logfile_name_tmp;
@@ -174,6 +176,8 @@ int main()
     // printf("[INFO]\tFile Name:\t\t\t%s\r\n", LogFile.file_name);
     // printf("[INFO]\tFile Total Byte Size:\t\t%lld\r\n", LogFile.logfile_size.total_byte);
     
+    /* blackbox dump come in 4K segment, strip the segment header before frame decode */
+    LogFile_Segment_Strip(&LogFile);
     LogFile_Decompess_Init(&LogFile);
 
     while (1)
@@ -0,0 +1,132 @@
+#include "../inc/segment_decode.h"
+#include "util.h"
+
+typedef struct
+{
+    uint32_t seq;
+    uint16_t session;
+    uint64_t offset;
+    uint32_t payload_size;
+} BlackboxSeg_Info_TypeDef;
+
+static bool LogFile_Segment_Check(const uint8_t *p_data)
+{
+    BlackboxSeg_Header_TypeDef header;
+
+    memcpy(&header, p_data, BLACKBOX_SEGMENT_HEADER_SIZE);
+
+    if (header.tag != BLACKBOX_SEGMENT_TAG)
+        return false;
+
+    return (header.crc16 == (uint16_t)Common_CRC16((const uint8_t *)&header, offsetof(BlackboxSeg_Header_TypeDef, crc16)));
+}
+
+static int LogFile_Segment_Compare(const void *l, const void *r)
+{
+    const BlackboxSeg_Info_TypeDef *l_seg = (const BlackboxSeg_Info_TypeDef *)l;
+    const BlackboxSeg_Info_TypeDef *r_seg = (const BlackboxSeg_Info_TypeDef *)r;
+
+    if (l_seg->seq == r_seg->seq)
+        return 0;
+
+    return (l_seg->seq < r_seg->seq) ? -1 : 1;
+}
+
+/*
+ * blackbox dump is a row of 4K segment, each start with a "BLKB" header and log frame cross the segment boundary
+ * find the first segment (shell text may lead the dump), drop broken segment, order the rest by seq
+ * and replace the loaded data with the payload stream, sd card log without segment header is left untouched
+ */
+bool LogFile_Segment_Strip(LogFileObj_TypeDef *file)
+{
+    BlackboxSeg_Header_TypeDef header;
+    BlackboxSeg_Info_TypeDef *seg_list = NULL;
+    uint8_t *p_stream = NULL;
+    uint64_t start = 0;
+    uint64_t stream_size = 0;
+    uint32_t seg_num = 0;
+    uint32_t bad_seg_num = 0;
+    uint32_t gap_num = 0;
+    uint32_t session_num = 0;
+    bool found = false;
+
+    if ((file == NULL) || (file->bin_data == NULL) || (file->logfile_size.total_byte <= BLACKBOX_SEGMENT_HEADER_SIZE))
+        return false;
+
+    for (start = 0; (start + BLACKBOX_SEGMENT_HEADER_SIZE) <= file->logfile_size.total_byte; start++)
+    {
+        if (LogFile_Segment_Check(&file->bin_data[start]))
+        {
+            found = true;
+            break;
+        }
+    }
+
+    if (!found)
+        return false;
+
+    seg_list = malloc(((file->logfile_size.total_byte - start) / BLACKBOX_SEGMENT_SIZE + 1) * sizeof(BlackboxSeg_Info_TypeDef));
+    p_stream = malloc(file->logfile_size.total_byte);
+    if ((seg_list == NULL) || (p_stream == NULL))
+    {
+        free(seg_list);
+        free(p_stream);
+        printf("[Error]\tSegment Strip Memory Malloc Failed\r\n");
+        return false;
+    }
+
+    for (uint64_t offset = start; (offset + BLACKBOX_SEGMENT_HEADER_SIZE) <= file->logfile_size.total_byte; offset += BLACKBOX_SEGMENT_SIZE)
+    {
+        /* erased or broken segment is sent as default data by the dump */
+        if (!LogFile_Segment_Check(&file->bin_data[offset]))
+        {
+            bad_seg_num ++;
+            continue;
+        }
+
+        memcpy(&header, &file->bin_data[offset], BLACKBOX_SEGMENT_HEADER_SIZE);
+        seg_list[seg_num].seq = header.seq;
+        seg_list[seg_num].session = header.session;
+        seg_list[seg_num].offset = offset + BLACKBOX_SEGMENT_HEADER_SIZE;
+
+        /* last segment may be cut by the capture */
+        if ((offset + BLACKBOX_SEGMENT_SIZE) <= file->logfile_size.total_byte)
+        {
+            seg_list[seg_num].payload_size = BLACKBOX_SEGMENT_SIZE - BLACKBOX_SEGMENT_HEADER_SIZE;
+        }
+        else
+            seg_list[seg_num].payload_size = file->logfile_size.total_byte - seg_list[seg_num].offset;
+
+        seg_num ++;
+    }
+
+    qsort(seg_list, seg_num, sizeof(BlackboxSeg_Info_TypeDef), LogFile_Segment_Compare);
+
+    for (uint32_t i = 0; i < seg_num; i++)
+    {
+        if ((i == 0) || (seg_list[i].session != seg_list[i - 1].session))
+            session_num ++;
+
+        /* frame across a missing segment fail its ender check and is skipped by the frame decoder */
+        if (i && (seg_list[i].seq != (seg_list[i - 1].seq + 1)))
+            gap_num ++;
+
+        memcpy(&p_stream[stream_size], &file->bin_data[seg_list[i].offset], seg_list[i].payload_size);
+        stream_size += seg_list[i].payload_size;
+    }
+
+    printf("[INFO]\tBlackbox Dump First Segment At:\t%lld\r\n", start);
+    printf("[INFO]\tBlackbox Segment Num:\t\t%d\r\n", seg_num);
+    printf("[INFO]\tBlackbox Broken Segment Num:\t%d\r\n", bad_seg_num);
+    printf("[INFO]\tBlackbox Session Num:\t\t%d\r\n", session_num);
+    printf("[INFO]\tBlackbox Seq Gap Num:\t\t%d\r\n", gap_num);
+    printf("[INFO]\tBlackbox Payload Byte Size:\t%lld\r\n", stream_size);
+    printf("\r\n");
+
+    free(seg_list);
+    free(file->bin_data);
+    file->bin_data = p_stream;
+    file->logfile_size.total_byte = stream_size;
+
+    return true;
+}
@@ -0,0 +1,279 @@
+#include "../inc/topic_decode.h"
+
+/*
+ * generic decoder of the multi topic log frames
+ * schema frame describe every topic, each topic is converted into its own text file
+ * <log file name>_<topic name>.txt, first line is the column name, then one record per line
+ */
+static const uint8_t Topic_TypeSize[LogTopic_Type_Sum] = LOG_TOPIC_TYPE_SIZE_TABLE;
+static TopicDesc_TypeDef Topic_Desc[LOG_TOPIC_MAX];
+static bool Topic_Schema_Ready = false;
+static bool Topic_Schema_Match_State = false;   /* last schema seen match the one files were opened with */
+static uint32_t Topic_Schema_Mismatch_Cnt = 0;
+
+static uint16_t Topic_Get_String(const uint8_t *p_data, uint32_t size, char *str)
+{
+    uint16_t len = 0;
+
+    while ((len < size) && (len < (LOG_TOPIC_NAME_LEN - 1)) && p_data[len])
+    {
+        str[len] = p_data[len];
+        len ++;
+    }
+
+    str[len] = '\0';
+
+    if ((len >= size) || p_data[len])
+        return 0;
+
+    return len + 1;
+}
+
+static void Topic_Print_Value(FILE *fp, uint8_t type, const uint8_t *p_val)
+{
+    uint16_t u16 = 0;
+    int16_t i16 = 0;
+    uint32_t u32 = 0;
+    int32_t i32 = 0;
+    float f32 = 0.0f;
+    double f64 = 0.0;
+
+    switch (type)
+    {
+        case LogTopic_U8: fprintf(fp, " %u", p_val[0]); break;
+        case LogTopic_I8: fprintf(fp, " %d", (int8_t)p_val[0]); break;
+        case LogTopic_U16: memcpy(&u16, p_val, sizeof(u16)); fprintf(fp, " %u", u16); break;
+        case LogTopic_I16: memcpy(&i16, p_val, sizeof(i16)); fprintf(fp, " %d", i16); break;
+        case LogTopic_U32: memcpy(&u32, p_val, sizeof(u32)); fprintf(fp, " %u", u32); break;
+        case LogTopic_I32: memcpy(&i32, p_val, sizeof(i32)); fprintf(fp, " %d", i32); break;
+        case LogTopic_F32: memcpy(&f32, p_val, sizeof(f32)); fprintf(fp, " %f", f32); break;
+        case LogTopic_F64: memcpy(&f64, p_val, sizeof(f64)); fprintf(fp, " %lf", f64); break;
+        default: break;
+    }
+}
+
+/* parse one schema frame into desc table, nothing opened here */
+static bool Topic_Parse_Schema(const uint8_t *p_data, uint32_t size, TopicDesc_TypeDef *desc_tab)
+{
+    TopicDesc_TypeDef *desc = NULL;
+    uint32_t offset = 0;
+    uint16_t len = 0;
+    uint16_t record_size = 0;
+    uint8_t topic_num = 0;
+    uint8_t id = 0;
+
+    if ((size < 2) || (p_data[0] != LOG_TOPIC_VERSION))
+        return false;
+
+    memset(desc_tab, 0, sizeof(TopicDesc_TypeDef) * LOG_TOPIC_MAX);
+    topic_num = p_data[1];
+    offset = 2;
+
+    for (uint8_t t = 0; t < topic_num; t++)
+    {
+        if ((offset + 6) > size)
+            return false;
+
+        id = p_data[offset++];
+        if (id >= LOG_TOPIC_MAX)
+            return false;
+
+        desc = &desc_tab[id];
+        memcpy(&desc->period_ms, &p_data[offset], sizeof(uint16_t));
+        offset += sizeof(uint16_t);
+        memcpy(&desc->record_size, &p_data[offset], sizeof(uint16_t));
+        offset += sizeof(uint16_t);
+        desc->field_num = p_data[offset++];
+
+        if (desc->field_num > LOG_TOPIC_FIELD_MAX)
+            return false;
+
+        len = Topic_Get_String(&p_data[offset], size - offset, desc->name);
+        if (len == 0)
+            return false;
+        offset += len;
+
+        record_size = 0;
+        for (uint8_t i = 0; i < desc->field_num; i++)
+        {
+            if ((offset + 2) > size)
+                return false;
+
+            desc->field[i].type = p_data[offset++];
+            desc->field[i].num = p_data[offset++];
+
+            if (desc->field[i].type >= LogTopic_Type_Sum)
+                return false;
+
+            len = Topic_Get_String(&p_data[offset], size - offset, desc->field[i].name);
+            if (len == 0)
+                return false;
+            offset += len;
+
+            record_size += Topic_TypeSize[desc->field[i].type] * desc->field[i].num;
+        }
+
+        if (record_size != desc->record_size)
+            return false;
+
+        desc->valid = true;
+    }
+
+    return true;
+}
+
+/* same topic layout, output file and record count are not compared */
+static bool Topic_Schema_Match(const TopicDesc_TypeDef *l_tab, const TopicDesc_TypeDef *r_tab)
+{
+    for (uint8_t id = 0; id < LOG_TOPIC_MAX; id++)
+    {
+        if (l_tab[id].valid != r_tab[id].valid)
+            return false;
+
+        if (!l_tab[id].valid)
+            continue;
+
+        if (strcmp(l_tab[id].name, r_tab[id].name) ||
+            (l_tab[id].period_ms != r_tab[id].period_ms) ||
+            (l_tab[id].record_size != r_tab[id].record_size) ||
+            (l_tab[id].field_num != r_tab[id].field_num))
+            return false;
+
+        for (uint8_t i = 0; i < l_tab[id].field_num; i++)
+        {
+            if ((l_tab[id].field[i].type != r_tab[id].field[i].type) ||
+                (l_tab[id].field[i].num != r_tab[id].field[i].num) ||
+                strcmp(l_tab[id].field[i].name, r_tab[id].field[i].name))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * firmware repeat the schema through the log, so a wrapped blackbox decode from the first schema found
+ * the first one open the output files, a repeated one only has to match
+ * a different layout (another session in the same dump) is not converted, its data frames are dropped
+ */
+bool LogFile_Topic_Schema(LogFileObj_TypeDef *file, const uint8_t *p_data, uint32_t size)
+{
+    static TopicDesc_TypeDef parse_tab[LOG_TOPIC_MAX];
+    TopicDesc_TypeDef *desc = NULL;
+    uint8_t id = 0;
+    char cnv_path[1024];
+
+    if (!Topic_Parse_Schema(p_data, size, parse_tab))
+        return false;
+
+    if (Topic_Schema_Ready)
+    {
+        Topic_Schema_Match_State = Topic_Schema_Match(Topic_Desc, parse_tab);
+
+        if (!Topic_Schema_Match_State)
+            Topic_Schema_Mismatch_Cnt ++;
+
+        return Topic_Schema_Match_State;
+    }
+
+    memcpy(Topic_Desc, parse_tab, sizeof(Topic_Desc));
+
+    /* one convert file per topic */
+    for (id = 0; id < LOG_TOPIC_MAX; id++)
+    {
+        desc = &Topic_Desc[id];
+        if (!desc->valid)
+            continue;
+
+        snprintf(cnv_path, sizeof(cnv_path), "%s%.*s_%s%s", file->path,
+                 (int)(strlen(file->log_file_name) - EXTEND_FILETYPE_NAME_LEN), file->log_file_name,
+                 desc->name, CONVERT_EXTEND_FILE_NAME);
+
+        desc->cnv_file = fopen(cnv_path, "w");
+        if (desc->cnv_file == NULL)
+        {
+            printf("[ERROR]\tTopic File Create Error %s\r\n", cnv_path);
+            desc->valid = false;
+            continue;
+        }
+
+        fprintf(desc->cnv_file, "time_ms");
+        for (uint8_t i = 0; i < desc->field_num; i++)
+        {
+            if (desc->field[i].num == 1)
+            {
+                fprintf(desc->cnv_file, " %s", desc->field[i].name);
+            }
+            else
+            {
+                for (uint8_t n = 0; n < desc->field[i].num; n++)
+                    fprintf(desc->cnv_file, " %s[%d]", desc->field[i].name, n);
+            }
+        }
+        fprintf(desc->cnv_file, "\r\n");
+
+        printf("[INFO]\tTopic %-8s period %4d ms record %3d byte -> %s\r\n", desc->name, desc->period_ms, desc->record_size, cnv_path);
+    }
+
+    Topic_Schema_Ready = true;
+    Topic_Schema_Match_State = true;
+    return true;
+}
+
+bool LogFile_Topic_Data(const uint8_t *p_data, uint32_t size)
+{
+    TopicDesc_TypeDef *desc = NULL;
+    const uint8_t *p_val = NULL;
+    uint32_t offset = 0;
+    uint32_t time_ms = 0;
+    uint8_t id = 0;
+
+    if (!Topic_Schema_Ready || !Topic_Schema_Match_State)
+        return false;
+
+    while ((offset + LOG_TOPIC_RECORD_HEAD) <= size)
+    {
+        id = p_data[offset];
+        if ((id >= LOG_TOPIC_MAX) || !Topic_Desc[id].valid)
+            return false;
+
+        desc = &Topic_Desc[id];
+        if ((offset + LOG_TOPIC_RECORD_HEAD + desc->record_size) > size)
+            return false;
+
+        memcpy(&time_ms, &p_data[offset + 1], sizeof(uint32_t));
+        p_val = &p_data[offset + LOG_TOPIC_RECORD_HEAD];
+
+        fprintf(desc->cnv_file, "%u", time_ms);
+        for (uint8_t i = 0; i < desc->field_num; i++)
+        {
+            for (uint8_t n = 0; n < desc->field[i].num; n++)
+            {
+                Topic_Print_Value(desc->cnv_file, desc->field[i].type, p_val);
+                p_val += Topic_TypeSize[desc->field[i].type];
+            }
+        }
+        fprintf(desc->cnv_file, "\r\n");
+
+        desc->record_cnt ++;
+        offset += LOG_TOPIC_RECORD_HEAD + desc->record_size;
+    }
+
+    return offset == size;
+}
+
+void LogFile_Topic_Close(void)
+{
+    if (Topic_Schema_Mismatch_Cnt)
+        printf("[WARN]  Topic Schema Mismatch     : %u, data of other session skipped\r\n", Topic_Schema_Mismatch_Cnt);
+
+    for (uint8_t id = 0; id < LOG_TOPIC_MAX; id++)
+    {
+        if (Topic_Desc[id].valid && Topic_Desc[id].cnv_file)
+        {
+            printf("[INFO]  Topic %-8s Record Num       : %lld\r\n", Topic_Desc[id].name, (long long)Topic_Desc[id].record_cnt);
+            fclose(Topic_Desc[id].cnv_file);
+            Topic_Desc[id].cnv_file = NULL;
+        }
+    }
+}
@@ -0,0 +1,154 @@
+/*
+ * host check of the single precision fast math in Algorithm/math_util.c
+ * every routine is swept densely over the range documented in math_util.h and compared against double libm
+ * the run fail when any error exceed the documented bound, call cost is reported against libm float
+ *
+ * usage : math_check
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "math_util.h"
+
+#define CHECK_SWEEP_NUM 200000
+#define CHECK_BENCH_LOOP 1000000
+
+#define CHECK_ATAN2_BOUND 1.2e-5
+#define CHECK_ASIN_BOUND 1.2e-5
+#define CHECK_LOG2_BOUND 2.5e-7
+#define CHECK_LOG2_ROUND 6.0e-8     /* per unit of |log2(x)|, rounding of the float result */
+#define CHECK_EXP2_BOUND 2.5e-7
+#define CHECK_POW_BOUND 1.5e-6
+#define CHECK_BARO_POW_BOUND 1.0e-7
+#define CHECK_BARO_EXP 0.1903f
+
+typedef struct
+{
+    const char *name;
+    double bound;
+    double max_err;
+    float worst_in;
+} Check_Result_TypeDef;
+
+typedef float (*Check_Func)(float x);
+
+static volatile float Check_Sink = 0.0f;
+
+static uint64_t Check_Get_Ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void Check_Update(Check_Result_TypeDef *result, double err, float in)
+{
+    if (err > result->max_err)
+    {
+        result->max_err = err;
+        result->worst_in = in;
+    }
+}
+
+static uint32_t Check_Report(const Check_Result_TypeDef *result)
+{
+    bool pass = result->max_err <= result->bound;
+
+    printf("\t%-10s max error %.3e (bound %.1e) at %g %s\r\n", result->name, result->max_err, result->bound,
+           result->worst_in, pass ? "" : "<- FAILED");
+
+    return pass ? 0 : 1;
+}
+
+/* unary wrapper so every routine is timed through the same call path */
+static float Check_Fast_Atan2(float x) { return Fast_Atan2f(x, 0.5f); }
+static float Check_Libm_Atan2(float x) { return atan2f(x, 0.5f); }
+static float Check_Fast_Pow(float x) { return Fast_Powf(x, CHECK_BARO_EXP); }
+static float Check_Libm_Pow(float x) { return powf(x, CHECK_BARO_EXP); }
+
+static double Check_Cost(Check_Func func, float start, float step)
+{
+    uint64_t ns = Check_Get_Ns();
+    float in = start;
+
+    for (uint32_t i = 0; i < CHECK_BENCH_LOOP; i++)
+    {
+        Check_Sink = func(in);
+        in += step;
+
+        if ((i & 0x3FF) == 0x3FF)
+            in = start;
+    }
+
+    return (double)(Check_Get_Ns() - ns) / CHECK_BENCH_LOOP;
+}
+
+int main(void)
+{
+    Check_Result_TypeDef atan2_res = {"atan2", CHECK_ATAN2_BOUND, 0.0, 0.0f};
+    Check_Result_TypeDef asin_res = {"asin", CHECK_ASIN_BOUND, 0.0, 0.0f};
+    Check_Result_TypeDef log2_res = {"log2", CHECK_LOG2_BOUND, 0.0, 0.0f};
+    Check_Result_TypeDef exp2_res = {"exp2", CHECK_EXP2_BOUND, 0.0, 0.0f};
+    Check_Result_TypeDef pow_res = {"pow", CHECK_POW_BOUND, 0.0, 0.0f};
+    Check_Result_TypeDef baro_res = {"baro pow", CHECK_BARO_POW_BOUND, 0.0, 0.0f};
+    uint32_t err_cnt = 0;
+    double ref = 0.0;
+    double t = 0.0;
+    float ang = 0.0f;
+    float radius = 0.0f;
+    float x = 0.0f;
+    float y = 0.0f;
+
+    for (uint32_t i = 0; i <= CHECK_SWEEP_NUM; i++)
+    {
+        t = (double)i / CHECK_SWEEP_NUM;
+
+        /* full circle, radius from 1e-3 to 1e3 so the octant folding see every ratio */
+        ang = (float)(t * 2.0 * M_PI - M_PI);
+        radius = (float)pow(10.0, 3.0 * sin(t * 97.0));
+        x = radius * cosf(ang);
+        y = radius * sinf(ang);
+        ref = atan2((double)y, (double)x);
+        Check_Update(&atan2_res, fabs((double)Fast_Atan2f(y, x) - ref), ang);
+
+        x = (float)(t * 2.0 - 1.0);
+        Check_Update(&asin_res, fabs((double)Fast_Asinf(x) - asin((double)x)), x);
+
+        /* result rounding grow with |log2(x)|, scaled back to the bound at x = 1 */
+        x = (float)pow(2.0, t * 40.0 - 20.0);
+        ref = log2((double)x);
+        Check_Update(&log2_res, fabs((double)Fast_Log2f(x) - ref) * CHECK_LOG2_BOUND / (CHECK_LOG2_BOUND + CHECK_LOG2_ROUND * fabs(ref)), x);
+
+        x = (float)(t * 253.0 - 126.0);
+        ref = exp2((double)x);
+        Check_Update(&exp2_res, fabs(((double)Fast_Exp2f(x) - ref) / ref), x);
+
+        /* log spaced base, exponent swept by a faster sine so the whole plane is covered */
+        x = (float)pow(10.0, t * 4.0 - 2.0);
+        y = (float)(3.0 * sin(t * 1013.0));
+        ref = pow((double)x, (double)y);
+        Check_Update(&pow_res, fabs(((double)Fast_Powf(x, y) - ref) / ref), x);
+
+        /* baro pressure ratio */
+        x = (float)(0.3 + t * 0.8);
+        ref = pow((double)x, (double)CHECK_BARO_EXP);
+        Check_Update(&baro_res, fabs(((double)Fast_Powf(x, CHECK_BARO_EXP) - ref) / ref), x);
+    }
+
+    printf("[Fast Math Check] %d sample per routine, reference double libm\r\n", CHECK_SWEEP_NUM + 1);
+    err_cnt += Check_Report(&atan2_res);
+    err_cnt += Check_Report(&asin_res);
+    err_cnt += Check_Report(&log2_res);
+    err_cnt += Check_Report(&exp2_res);
+    err_cnt += Check_Report(&pow_res);
+    err_cnt += Check_Report(&baro_res);
+
+    printf("\r\n\t[ns per call]  fast / libm float\r\n");
+    printf("\tatan2 : %6.2f / %6.2f\r\n", Check_Cost(Check_Fast_Atan2, -1.0f, 0.002f), Check_Cost(Check_Libm_Atan2, -1.0f, 0.002f));
+    printf("\tasin  : %6.2f / %6.2f\r\n", Check_Cost(Fast_Asinf, -1.0f, 0.002f), Check_Cost(asinf, -1.0f, 0.002f));
+    printf("\tpow   : %6.2f / %6.2f\r\n", Check_Cost(Check_Fast_Pow, 0.3f, 0.0008f), Check_Cost(Check_Libm_Pow, 0.3f, 0.0008f));
+
+    return err_cnt ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,168 @@
+/*
+ * replay imu text log converted by log2txt through the navigation ekf
+ * line format : time_ms gyr_x gyr_y gyr_z (deg/s) acc_x acc_y acc_z (g) ... cycle_cnt
+ * sample summed into fixed window by plain rectangle integration, no coning / sculling compensation like
+ * the firmware SrvIMU window, so replay attitude drift under vibration is somewhat worse than on target
+ * log axis is frd like the SrvIMU window, ekf get the window as is and madgwick get it as (x, -y, -z) the same as
+ * Task_Navi, both attitude are printed so a body frame mismatch between the two estimator show up here
+ *
+ * usage : navi_replay <imu.txt> [window sample num]
+ *         no baro in the log, a zero altitude pseudo baro is fused every window to bound vertical drift
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "navi_ekf.h"
+#include "MadgwickAHRS.h"
+
+#define REPLAY_WINDOW_DEF 10
+#define REPLAY_DEG2RAD 0.0174532925199433f
+#define REPLAY_BARO_VAR 0.25f
+
+static NaviEKF_Obj_TypeDef Replay_EKF;
+static MadgwickAHRS_Obj_TypeDef Replay_AHRS;
+
+static uint64_t Replay_Get_Ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *imu_file = NULL;
+    char line[512];
+    uint32_t window = REPLAY_WINDOW_DEF;
+    uint32_t time_ms = 0;
+    uint32_t lst_time_ms = 0;
+    uint32_t win_start_ms = 0;
+    float gyr[3];
+    float acc[3];
+    float d_ang[3] = {0.0f};
+    float d_vel[3] = {0.0f};
+    float dt = 0.0f;
+    float pos[3];
+    float vel[3];
+    float pitch = 0.0f;
+    float roll = 0.0f;
+    float yaw = 0.0f;
+    float ahrs_pitch = 0.0f;
+    float ahrs_roll = 0.0f;
+    float ahrs_yaw = 0.0f;
+    uint32_t smp_cnt = 0;
+    uint32_t line_cnt = 0;
+    uint32_t step_cnt = 0;
+    uint64_t ns = 0;
+    uint64_t ns_sum = 0;
+    uint64_t ns_min = UINT64_MAX;
+    uint64_t ns_max = 0;
+    bool first = true;
+
+    if (argc < 2)
+    {
+        printf("usage : %s <imu.txt> [window sample num]\r\n", argv[0]);
+        return -1;
+    }
+
+    if (argc > 2)
+        window = (uint32_t)atoi(argv[2]);
+
+    if (window == 0)
+        window = REPLAY_WINDOW_DEF;
+
+    imu_file = fopen(argv[1], "r");
+    if (imu_file == NULL)
+    {
+        printf("[Error]\tOpen %s failed\r\n", argv[1]);
+        return -1;
+    }
+
+    NaviEKF_Init(&Replay_EKF, NULL);
+    MadgwickAHRS_Init(&Replay_AHRS, 0.0f, 1000);
+
+    while (fgets(line, sizeof(line), imu_file))
+    {
+        if (sscanf(line, "%u %f %f %f %f %f %f", &time_ms, &gyr[0], &gyr[1], &gyr[2], &acc[0], &acc[1], &acc[2]) != 7)
+            continue;
+
+        line_cnt ++;
+
+        if (first)
+        {
+            lst_time_ms = time_ms;
+            win_start_ms = time_ms;
+            first = false;
+            continue;
+        }
+
+        /* rectangle integration over the sample interval */
+        dt = (float)(time_ms - lst_time_ms) * 0.001f;
+        lst_time_ms = time_ms;
+
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            d_ang[i] += gyr[i] * REPLAY_DEG2RAD * dt;
+            d_vel[i] += acc[i] * NAVI_EKF_GRAVITY * dt;
+        }
+
+        smp_cnt ++;
+        if (smp_cnt < window)
+            continue;
+
+        dt = (float)(time_ms - win_start_ms) * 0.001f;
+        win_start_ms = time_ms;
+
+        if (dt > 0.0f)
+        {
+            NaviEKF_Set_Meas(&Replay_EKF, NaviEKF_Meas_Baro, 0.0f, REPLAY_BARO_VAR);
+
+            ns = Replay_Get_Ns();
+            NaviEKF_Step(&Replay_EKF, d_ang, d_vel, dt);
+            ns = Replay_Get_Ns() - ns;
+
+            MadgwickAHRS_Update_DeltaAngle(&Replay_AHRS, dt, d_ang[0], -d_ang[1], -d_ang[2], \
+                                           d_vel[0] / dt, -d_vel[1] / dt, -d_vel[2] / dt, 0.0f, 0.0f, 0.0f);
+
+            ns_sum += ns;
+            if (ns < ns_min)
+                ns_min = ns;
+
+            if (ns > ns_max)
+                ns_max = ns;
+
+            step_cnt ++;
+        }
+
+        memset(d_ang, 0, sizeof(d_ang));
+        memset(d_vel, 0, sizeof(d_vel));
+        smp_cnt = 0;
+    }
+
+    fclose(imu_file);
+
+    if (step_cnt == 0)
+    {
+        printf("[Error]\tNo imu window replayed\r\n");
+        return -1;
+    }
+
+    NaviEKF_Get_Attitude(&Replay_EKF, &pitch, &roll, &yaw);
+    MadgwickAHRS_Get_Attitude(&Replay_AHRS, &ahrs_pitch, &ahrs_roll, &ahrs_yaw);
+    NaviEKF_Get_PosVel(&Replay_EKF, pos, vel);
+
+    printf("[Replay]\t%u line %u step, window %u sample\r\n", line_cnt, step_cnt, window);
+    printf("[Step]\t\tmin %llu ns avg %llu ns max %llu ns\r\n", (unsigned long long)ns_min, (unsigned long long)(ns_sum / step_cnt), (unsigned long long)ns_max);
+    printf("[Attitude]\tpitch %.3f roll %.3f yaw %.3f deg\r\n", (double)pitch, (double)roll, (double)yaw);
+    printf("[Madgwick]\tpitch %.3f roll %.3f yaw %.3f deg\r\n", (double)ahrs_pitch, (double)ahrs_roll, (double)ahrs_yaw);
+    printf("[Pos]\t\t%.3f %.3f %.3f m\r\n", (double)pos[0], (double)pos[1], (double)pos[2]);
+    printf("[Vel]\t\t%.3f %.3f %.3f m/s\r\n", (double)vel[0], (double)vel[1], (double)vel[2]);
+    printf("[GyrBias]\t%.5f %.5f %.5f rad/s\r\n", (double)Replay_EKF.gyr_bias[0], (double)Replay_EKF.gyr_bias[1], (double)Replay_EKF.gyr_bias[2]);
+    printf("[AccBias]\t%.4f %.4f %.4f m/s^2\r\n", (double)Replay_EKF.acc_bias[0], (double)Replay_EKF.acc_bias[1], (double)Replay_EKF.acc_bias[2]);
+
+    for (uint8_t i = 0; i < NaviEKF_Meas_Sum; i++)
+        printf("[Meas %u]\tfuse %u reject %u innov %.4f\r\n", i, Replay_EKF.meas[i].fuse_cnt, Replay_EKF.meas[i].reject_cnt, (double)Replay_EKF.meas[i].innov);
+
+    return 0;
+}
@@ -0,0 +1,212 @@
+/*
+ * host check of the moto rpm notch bank in Algorithm/Filter_Dep/rpm_filter.c
+ * quad at 1khz sample, 3 harmonic, q 5, min 80Hz, the same setting SrvIMU run with
+ *      tone     : moto tone removed, low frequency body motion passed
+ *      re-enable: moto spin up, chop below min_hz and up again with its own tone on gyro, no ring out of the
+ *                 restarted notch
+ *      nyquist  : 3rd harmonic swept toward 0.48 fs, weight ramp down without step
+ * the run fail when any item exceed its bound, apply cost is reported
+ *
+ * usage : rpm_filter_check [tone hz]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "rpm_filter.h"
+
+#define CHECK_SAMPLE_HZ 1000.0f
+#define CHECK_MOTO_NUM 4
+#define CHECK_HARMONIC 3
+#define CHECK_Q 5.0f
+#define CHECK_MIN_HZ 80.0f
+#define CHECK_PI 3.14159265358979f
+
+#define CHECK_TONE_DEF 150
+#define CHECK_TONE_LEN 2000
+#define CHECK_TONE_RESIDUAL_BOUND 1.0e-3f   /* tone power left over input power */
+#define CHECK_PASS_BOUND 0.95f              /* 10Hz power kept over input power */
+#define CHECK_SPINUP_LEN 3000
+#define CHECK_SPINUP_PEAK_BOUND 1.1f        /* peak output over tone amplitude */
+#define CHECK_NYQUIST_STEP_BOUND 0.1f       /* max weight change between two frequency step */
+#define CHECK_BENCH_LOOP 200000
+
+static RpmFilter_Obj_TypeDef Check_Obj;
+
+static uint64_t Check_Get_Ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static bool Check_Init(float moto_hz)
+{
+    if (!RpmFilter_Init(&Check_Obj, CHECK_SAMPLE_HZ, CHECK_MOTO_NUM, CHECK_HARMONIC, CHECK_Q, CHECK_MIN_HZ))
+        return false;
+
+    for (uint8_t m = 0; m < CHECK_MOTO_NUM; m++)
+        RpmFilter_Set_Freq(&Check_Obj, m, moto_hz);
+
+    return true;
+}
+
+static uint32_t Check_Report(const char *name, float val, float bound, bool upper)
+{
+    bool pass = upper ? (val <= bound) : (val >= bound);
+
+    printf("\t%-10s %.4e (%s %.1e) %s\r\n", name, (double)val, upper ? "max" : "min", (double)bound, pass ? "" : "<- FAILED");
+
+    return pass ? 0 : 1;
+}
+
+/* pure moto tone on x, 10Hz body motion on y */
+static uint32_t Check_Tone(float tone_hz)
+{
+    float gyr[RPM_FILTER_AXIS_NUM];
+    float in_pow = 0.0f;
+    float on_pow = 0.0f;
+    float off_pow = 0.0f;
+    float t = 0.0f;
+    uint32_t err_cnt = 0;
+
+    if (!Check_Init(tone_hz))
+        return 1;
+
+    for (uint16_t i = 0; i < CHECK_TONE_LEN; i++)
+    {
+        t = (float)i / CHECK_SAMPLE_HZ;
+        gyr[0] = sinf(2.0f * CHECK_PI * tone_hz * t);
+        gyr[1] = sinf(2.0f * CHECK_PI * 10.0f * t);
+        gyr[2] = 0.0f;
+
+        RpmFilter_Apply(&Check_Obj, gyr);
+
+        /* skip settling */
+        if (i >= (CHECK_TONE_LEN / 2))
+        {
+            in_pow += 0.5f;
+            on_pow += gyr[0] * gyr[0];
+            off_pow += gyr[1] * gyr[1];
+        }
+    }
+
+    printf("[Tone] %.0f Hz\r\n", (double)tone_hz);
+    err_cnt += Check_Report("residual", on_pow / in_pow, CHECK_TONE_RESIDUAL_BOUND, true);
+    err_cnt += Check_Report("10Hz pass", off_pow / in_pow, CHECK_PASS_BOUND, false);
+
+    return err_cnt;
+}
+
+/* moto 40 -> 200 -> 40 -> 200 Hz with its tone on gyro, notch leave and come back through min_hz */
+static uint32_t Check_SpinUp(void)
+{
+    float gyr[RPM_FILTER_AXIS_NUM];
+    float moto_hz = 0.0f;
+    float phase = 0.0f;
+    float peak = 0.0f;
+    float ramp = 0.0f;
+
+    if (!Check_Init(0.0f))
+        return 1;
+
+    for (uint16_t i = 0; i < CHECK_SPINUP_LEN; i++)
+    {
+        ramp = 3.0f * (float)i / CHECK_SPINUP_LEN;
+        ramp = (ramp < 1.0f) ? ramp : ((ramp < 2.0f) ? (2.0f - ramp) : (ramp - 2.0f));
+        moto_hz = 40.0f + 160.0f * ramp;
+        phase += 2.0f * CHECK_PI * moto_hz / CHECK_SAMPLE_HZ;
+
+        for (uint8_t m = 0; m < CHECK_MOTO_NUM; m++)
+            RpmFilter_Set_Freq(&Check_Obj, m, moto_hz);
+
+        gyr[0] = sinf(phase);
+        gyr[1] = cosf(phase);
+        gyr[2] = 0.0f;
+
+        RpmFilter_Apply(&Check_Obj, gyr);
+
+        for (uint8_t axis = 0; axis < RPM_FILTER_AXIS_NUM; axis++)
+            peak = (fabsf(gyr[axis]) > peak) ? fabsf(gyr[axis]) : peak;
+    }
+
+    printf("[Re-enable] moto 40 -> 200 -> 40 -> 200 Hz\r\n");
+    return Check_Report("peak", peak, CHECK_SPINUP_PEAK_BOUND, true);
+}
+
+/* step the moto frequency so the 3rd harmonic cross 0.48 fs, watch the weight of that notch */
+static uint32_t Check_Nyquist(void)
+{
+    float gyr[RPM_FILTER_AXIS_NUM] = {0.0f};
+    float weight = 0.0f;
+    float lst_weight = 0.0f;
+    float max_step = 0.0f;
+    bool first = true;
+    float top_hz = CHECK_SAMPLE_HZ * 0.5f / CHECK_HARMONIC;
+
+    if (!Check_Init(0.0f))
+        return 1;
+
+    for (float moto_hz = top_hz - 20.0f; moto_hz <= top_hz; moto_hz += 0.25f)
+    {
+        RpmFilter_Set_Freq(&Check_Obj, 0, moto_hz);
+
+        /* one apply per moto so moto 0 coefficient get refreshed */
+        for (uint8_t m = 0; m < CHECK_MOTO_NUM; m++)
+            RpmFilter_Apply(&Check_Obj, gyr);
+
+        weight = Check_Obj.notch[0][CHECK_HARMONIC - 1].weight;
+        if (first)
+        {
+            lst_weight = weight;
+            first = false;
+        }
+
+        if (fabsf(weight - lst_weight) > max_step)
+            max_step = fabsf(weight - lst_weight);
+
+        lst_weight = weight;
+    }
+
+    printf("[Nyquist] 3rd harmonic %.0f -> %.0f Hz\r\n", (double)((top_hz - 20.0f) * CHECK_HARMONIC), (double)(top_hz * CHECK_HARMONIC));
+    return Check_Report("weight step", max_step, CHECK_NYQUIST_STEP_BOUND, true);
+}
+
+static double Check_Cost(void)
+{
+    float gyr[RPM_FILTER_AXIS_NUM] = {0.0f};
+    uint64_t ns = 0;
+
+    Check_Init(150.0f);
+
+    ns = Check_Get_Ns();
+    for (uint32_t i = 0; i < CHECK_BENCH_LOOP; i++)
+    {
+        gyr[0] = (float)(i & 0xFF) * 0.01f;
+        RpmFilter_Apply(&Check_Obj, gyr);
+    }
+
+    return (double)(Check_Get_Ns() - ns) / CHECK_BENCH_LOOP;
+}
+
+int main(int argc, char *argv[])
+{
+    float tone_hz = CHECK_TONE_DEF;
+    uint32_t err_cnt = 0;
+
+    if (argc > 1)
+        tone_hz = (float)atof(argv[1]);
+
+    if ((tone_hz <= CHECK_MIN_HZ) || (tone_hz >= (CHECK_SAMPLE_HZ / 2)))
+        tone_hz = CHECK_TONE_DEF;
+
+    printf("[RPM Filter Check] %d moto x %d harmonic, q %.1f, fs %.0f Hz\r\n", CHECK_MOTO_NUM, CHECK_HARMONIC, (double)CHECK_Q, (double)CHECK_SAMPLE_HZ);
+    err_cnt += Check_Tone(tone_hz);
+    err_cnt += Check_SpinUp();
+    err_cnt += Check_Nyquist();
+
+    printf("\r\n\t[ns per apply] %.2f\r\n", Check_Cost());
+
+    return err_cnt ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,21 @@
+#ifndef __SITL_MODEL_H
+#define __SITL_MODEL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * peripheral model of the matek h743 board
+ * every model attach on the sitl bsp stand in, must be set up before the firmware init the bus
+ */
+#define SITL_IMU_ODR_HZ 1000
+#define SITL_RC_PERIOD_US 4000 /* crsf 250Hz */
+#define SITL_CARD_SIZE_MB 256
+
+bool SitlIMU_Init(void);
+bool SitlBaro_Init(void);
+bool SitlRC_Init(void);
+bool SitlDShot_Init(void);
+bool SitlCard_Init(const char *path, uint32_t size_mb);
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef __SITL_STAT_H
+#define __SITL_STAT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#define SITL_STAT_TASK_MAX 16
+#define SITL_STAT_NAME_LEN 16
+
+typedef enum
+{
+    SitlStat_Cnt_PriIMU_Drdy = 0,
+    SitlStat_Cnt_PriIMU_Read,
+    SitlStat_Cnt_SecIMU_Drdy,
+    SitlStat_Cnt_SecIMU_Read,
+    SitlStat_Cnt_Baro_Read,
+    SitlStat_Cnt_RC_Frame,
+    SitlStat_Cnt_DShot_Frame,
+    SitlStat_Cnt_DShot_Update,
+    SitlStat_Cnt_Sum,
+} SitlStat_Counter_List;
+
+typedef struct
+{
+    void *tcb;
+    char name[SITL_STAT_NAME_LEN];
+
+    uint64_t switch_in_ns;
+    uint64_t run_ns;
+
+    /* one activation is a switch in after the task delayed itself */
+    bool delayed;
+    uint32_t act_cnt;
+    uint64_t act_ns;
+    uint64_t act_run_ns;
+    uint64_t exec_max_ns;
+
+    uint32_t period_cnt;
+    uint64_t period_sum_ns;
+    uint64_t period_min_ns;
+    uint64_t period_max_ns;
+} SitlStat_Task_TypeDef;
+
+typedef struct
+{
+    uint32_t cnt;
+    uint64_t sum_ns;
+    uint64_t min_ns;
+    uint64_t max_ns;
+} SitlStat_Latency_TypeDef;
+
+void SitlStat_Init(void);
+void SitlStat_Count(SitlStat_Counter_List item);
+void SitlStat_IMU_Read(uint64_t drdy_ns);
+void SitlStat_DShot_Frame(uint32_t moto, uint16_t value);
+void SitlStat_Print(FILE *out);
+
+#endif
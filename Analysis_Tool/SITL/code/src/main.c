@@ -0,0 +1,89 @@
+/*
+ * software in the loop run of the flight firmware on host
+ * firmware boot the same way as the target main, sensor / receiver / esc / sd card are host model
+ * after the run time every simulated interrupt is blocked, task statistic printed then exit
+ *
+ * usage : sitl [-t run time s] [-c sd card image path] [-s]
+ *         -s bind the usb vcp (shell / mavlink port) to stdin and stdout
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "kernel.h"
+#include "Task_Manager.h"
+#include "Bsp_USB.h"
+#include "sitl_model.h"
+#include "sitl_stat.h"
+
+#define SITL_RUN_TIME_DEF 10
+
+static uint32_t Sitl_RunTime = SITL_RUN_TIME_DEF;
+
+static void *Sitl_Stop_Thread(void *arg)
+{
+    struct timespec run_time;
+
+    (void)arg;
+    run_time.tv_sec = Sitl_RunTime;
+    run_time.tv_nsec = 0;
+    while (nanosleep(&run_time, &run_time) != 0);
+
+    /* hold the simulated interrupt lock for good, every task and model stay parked */
+    SitlPort_Isr_Enter();
+    SitlPort_End_Scheduler();
+
+    return NULL;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *card_path = NULL;
+    bool shell = false;
+    int opt = 0;
+
+    while ((opt = getopt(argc, argv, "t:c:s")) != -1)
+    {
+        switch (opt)
+        {
+            case 't': Sitl_RunTime = (uint32_t)atoi(optarg); break;
+            case 'c': card_path = optarg; break;
+            case 's': shell = true; break;
+            default:
+                printf("usage : %s [-t run time s] [-c sd card image path] [-s]\r\n", argv[0]);
+                return -1;
+        }
+    }
+
+    SitlStat_Init();
+
+    if (!SitlIMU_Init() ||
+        !SitlBaro_Init() ||
+        !SitlRC_Init() ||
+        !SitlDShot_Init() ||
+        !SitlCard_Init(card_path, SITL_CARD_SIZE_MB))
+    {
+        printf("[SITL] model init failed\r\n");
+        return -1;
+    }
+
+    if (shell)
+        BspUSB_VCP_Sitl_Bind(STDIN_FILENO, STDOUT_FILENO);
+
+    if (SitlPort_Thread_Create(Sitl_Stop_Thread, NULL) != pdPASS)
+        return -1;
+
+    if (!Kernel_Init())
+        return -1;
+
+    /* return once the stop thread end the scheduler */
+    Task_Manager_Init();
+
+    SitlStat_Print(stdout);
+    fflush(stdout);
+
+    /* task thread are still parked, skip the exit handler */
+    _exit(0);
+}
@@ -0,0 +1,144 @@
+/*
+ * sd card backed by a host image file
+ * image is formatted as fat32 without mbr (boot sector at lba 0), the layout the disk io module expect
+ * file is sparse, only the written sector take host disk space
+ */
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include "FreeRTOS.h"
+#include "sitl_hal.h"
+#include "Bsp_SDMMC.h"
+#include "sitl_model.h"
+
+#define SITL_CARD_SEC_SIZE 512
+#define SITL_CARD_SEC_PER_CLUS 4
+#define SITL_CARD_RSVD_SEC 32
+#define SITL_CARD_FAT_NUM 2
+#define SITL_CARD_FSINFO_SEC 1
+#define SITL_CARD_BACKUP_SEC 6
+#define SITL_CARD_ROOT_CLUS 2
+
+/* internal function */
+static void SitlCard_Put16(uint8_t *p, uint16_t val);
+static void SitlCard_Put32(uint8_t *p, uint32_t val);
+static bool SitlCard_Write_Sec(int fd, uint32_t sec, const uint8_t *p_data);
+static bool SitlCard_Format(int fd, uint32_t total_sec);
+
+static void SitlCard_Put16(uint8_t *p, uint16_t val)
+{
+    p[0] = (uint8_t)val;
+    p[1] = (uint8_t)(val >> 8);
+}
+
+static void SitlCard_Put32(uint8_t *p, uint32_t val)
+{
+    SitlCard_Put16(p, (uint16_t)val);
+    SitlCard_Put16(p + 2, (uint16_t)(val >> 16));
+}
+
+static bool SitlCard_Write_Sec(int fd, uint32_t sec, const uint8_t *p_data)
+{
+    return pwrite(fd, p_data, SITL_CARD_SEC_SIZE, (off_t)sec * SITL_CARD_SEC_SIZE) == SITL_CARD_SEC_SIZE;
+}
+
+static bool SitlCard_Format(int fd, uint32_t total_sec)
+{
+    uint8_t boot[SITL_CARD_SEC_SIZE];
+    uint8_t fsinfo[SITL_CARD_SEC_SIZE];
+    uint8_t fat[SITL_CARD_SEC_SIZE];
+    uint32_t fat_sec = 0;
+    uint32_t clus_num = 0;
+
+    /* fat size over estimated by the two reserved entry, a few tail cluster unused */
+    fat_sec = (((total_sec - SITL_CARD_RSVD_SEC) / SITL_CARD_SEC_PER_CLUS + 2) * 4 + SITL_CARD_SEC_SIZE - 1) / SITL_CARD_SEC_SIZE;
+    clus_num = (total_sec - SITL_CARD_RSVD_SEC - SITL_CARD_FAT_NUM * fat_sec) / SITL_CARD_SEC_PER_CLUS;
+
+    if (clus_num < 65525)
+        return false;
+
+    memset(boot, 0, sizeof(boot));
+    boot[0] = 0xEB;
+    boot[1] = 0x58;
+    boot[2] = 0x90;
+    memcpy(&boot[3], "MSWIN4.1", 8);
+    SitlCard_Put16(&boot[11], SITL_CARD_SEC_SIZE);
+    boot[13] = SITL_CARD_SEC_PER_CLUS;
+    SitlCard_Put16(&boot[14], SITL_CARD_RSVD_SEC);
+    boot[16] = SITL_CARD_FAT_NUM;
+    boot[21] = 0xF8;
+    SitlCard_Put16(&boot[24], 63);
+    SitlCard_Put16(&boot[26], 255);
+    SitlCard_Put32(&boot[32], total_sec);
+    SitlCard_Put32(&boot[36], fat_sec);
+    SitlCard_Put32(&boot[44], SITL_CARD_ROOT_CLUS);
+    SitlCard_Put16(&boot[48], SITL_CARD_FSINFO_SEC);
+    SitlCard_Put16(&boot[50], SITL_CARD_BACKUP_SEC);
+    boot[64] = 0x80;
+    boot[66] = 0x29;
+    SitlCard_Put32(&boot[67], 0x5172E000);
+    memcpy(&boot[71], "SITL CARD  ", 11);
+    memcpy(&boot[82], "FAT32   ", 8);
+    boot[510] = 0x55;
+    boot[511] = 0xAA;
+
+    memset(fsinfo, 0, sizeof(fsinfo));
+    memcpy(&fsinfo[0], "RRaA", 4);
+    memcpy(&fsinfo[484], "rrAa", 4);
+    SitlCard_Put32(&fsinfo[488], clus_num - 1);
+    SitlCard_Put32(&fsinfo[492], SITL_CARD_ROOT_CLUS + 1);
+    fsinfo[510] = 0x55;
+    fsinfo[511] = 0xAA;
+
+    /* media, reserved and end of chain for root directory */
+    memset(fat, 0, sizeof(fat));
+    SitlCard_Put32(&fat[0], 0x0FFFFFF8);
+    SitlCard_Put32(&fat[4], 0x0FFFFFFF);
+    SitlCard_Put32(&fat[8], 0x0FFFFFFF);
+
+    if ((ftruncate(fd, (off_t)total_sec * SITL_CARD_SEC_SIZE) != 0) ||
+        !SitlCard_Write_Sec(fd, 0, boot) ||
+        !SitlCard_Write_Sec(fd, SITL_CARD_FSINFO_SEC, fsinfo) ||
+        !SitlCard_Write_Sec(fd, SITL_CARD_BACKUP_SEC, boot) ||
+        !SitlCard_Write_Sec(fd, SITL_CARD_BACKUP_SEC + SITL_CARD_FSINFO_SEC, fsinfo))
+        return false;
+
+    for (uint8_t i = 0; i < SITL_CARD_FAT_NUM; i++)
+    {
+        if (!SitlCard_Write_Sec(fd, SITL_CARD_RSVD_SEC + i * fat_sec, fat))
+            return false;
+    }
+
+    return true;
+}
+
+/* path NULL use a temporary image removed on exit */
+bool SitlCard_Init(const char *path, uint32_t size_mb)
+{
+    char tmp_path[] = "/tmp/sitl_card_XXXXXX";
+    uint32_t total_sec = size_mb * (1024 * 1024 / SITL_CARD_SEC_SIZE);
+    int fd = -1;
+
+    if (path)
+    {
+        fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    }
+    else
+    {
+        fd = mkstemp(tmp_path);
+        if (fd >= 0)
+            unlink(tmp_path);
+    }
+
+    if (fd < 0)
+        return false;
+
+    if (!SitlCard_Format(fd, total_sec))
+    {
+        close(fd);
+        return false;
+    }
+
+    return BspSDMMC_Sitl_Bind(SDMMC1, fd, total_sec);
+}
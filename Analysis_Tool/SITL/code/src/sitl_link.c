@@ -0,0 +1,171 @@
+/*
+ * radio and esc side of the simulation
+ *   receiver : crsf rc channel frame pushed into the receiver uart at the link rate
+ *   esc      : dshot frame decoded from the timer compare buffer, moto index given by first output order
+ */
+#include <string.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "HW_Def.h"
+#include "Bsp_Uart.h"
+#include "Bsp_Timer.h"
+#include "Dev_CRSF.h"
+#include "Dev_Dshot_Frame.h"
+#include "sitl_model.h"
+#include "sitl_stat.h"
+
+#define SITL_RC_CHANNEL_NUM 16
+#define SITL_RC_CHANNEL_BIT 11
+#define SITL_RC_FRAME_SIZE (CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_NON_PAYLOAD)
+#define SITL_RC_CRC_POLY 0xD5
+
+#define SITL_DSHOT_MOTO_MAX 8
+
+typedef struct
+{
+    TIM_TypeDef *instance;
+    uint32_t channel;
+} SitlDShot_Moto_TypeDef;
+
+/* internal vriable */
+static SitlDShot_Moto_TypeDef SitlDShot_Moto[SITL_DSHOT_MOTO_MAX];
+static uint8_t SitlDShot_Moto_Num = 0;
+
+/* internal function */
+static uint8_t SitlRC_Crc8(const uint8_t *p_data, uint8_t len);
+static uint8_t SitlRC_Pack(uint8_t *frame, const uint16_t *ch);
+static void *SitlRC_Thread(void *arg);
+static int8_t SitlDShot_Get_Moto(TIM_TypeDef *instance, uint32_t channel);
+static void SitlDShot_Sink(TIM_TypeDef *instance, uint32_t channel, const uint32_t *ccr, uint32_t bit_num, uint32_t stride, uint32_t auto_reload);
+
+/************************************************** receiver section ************************************************/
+static uint8_t SitlRC_Crc8(const uint8_t *p_data, uint8_t len)
+{
+    uint8_t crc = 0;
+
+    for (uint8_t i = 0; i < len; i++)
+    {
+        crc ^= p_data[i];
+        for (uint8_t bit = 0; bit < 8; bit++)
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ SITL_RC_CRC_POLY) : (uint8_t)(crc << 1);
+    }
+
+    return crc;
+}
+
+/* 16 channel of 11 bit, lsb first */
+static uint8_t SitlRC_Pack(uint8_t *frame, const uint16_t *ch)
+{
+    uint8_t *payload = &frame[3];
+    uint32_t bits = 0;
+    uint8_t bit_num = 0;
+    uint8_t index = 0;
+
+    frame[0] = CRSF_ADDRESS_FLIGHT_CONTROLLER;
+    frame[1] = CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE_CRC;
+    frame[2] = CRSF_FRAMETYPE_RC_CHANNELS_PACKED;
+
+    for (uint8_t i = 0; i < SITL_RC_CHANNEL_NUM; i++)
+    {
+        bits |= (uint32_t)(ch[i] & 0x7FF) << bit_num;
+        bit_num += SITL_RC_CHANNEL_BIT;
+
+        while (bit_num >= 8)
+        {
+            payload[index++] = (uint8_t)bits;
+            bits >>= 8;
+            bit_num -= 8;
+        }
+    }
+
+    /* crc cover type and payload */
+    frame[SITL_RC_FRAME_SIZE - 1] = SitlRC_Crc8(&frame[2], CRSF_FRAME_RC_CHANNELS_PAYLOAD_SIZE + CRSF_FRAME_LENGTH_TYPE);
+
+    return SITL_RC_FRAME_SIZE;
+}
+
+/* stick centered, throttle low, every switch low */
+static void *SitlRC_Thread(void *arg)
+{
+    struct timespec next;
+    uint16_t ch[SITL_RC_CHANNEL_NUM];
+    uint8_t frame[SITL_RC_FRAME_SIZE];
+    uint8_t size = 0;
+
+    (void)arg;
+
+    for (uint8_t i = 0; i < SITL_RC_CHANNEL_NUM; i++)
+        ch[i] = CRSF_DIGITAL_CHANNEL_MIN;
+
+    ch[0] = CRSF_DIGITAL_CHANNEL_MID;
+    ch[1] = CRSF_DIGITAL_CHANNEL_MID;
+    ch[3] = CRSF_DIGITAL_CHANNEL_MID;
+
+    size = SitlRC_Pack(frame, ch);
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    while (true)
+    {
+        next.tv_nsec += SITL_RC_PERIOD_US * 1000L;
+        if (next.tv_nsec >= 1000000000L)
+        {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+        /* dropped until the receiver port is initialized */
+        if (BspUart_Sitl_Rx(RECEIVER_PORT, frame, size))
+            SitlStat_Count(SitlStat_Cnt_RC_Frame);
+    }
+
+    return NULL;
+}
+
+bool SitlRC_Init(void)
+{
+    return SitlPort_Thread_Create(SitlRC_Thread, NULL) == pdPASS;
+}
+
+/************************************************** esc section ************************************************/
+static int8_t SitlDShot_Get_Moto(TIM_TypeDef *instance, uint32_t channel)
+{
+    for (uint8_t i = 0; i < SitlDShot_Moto_Num; i++)
+    {
+        if ((SitlDShot_Moto[i].instance == instance) && (SitlDShot_Moto[i].channel == channel))
+            return i;
+    }
+
+    if (SitlDShot_Moto_Num >= SITL_DSHOT_MOTO_MAX)
+        return -1;
+
+    SitlDShot_Moto[SitlDShot_Moto_Num].instance = instance;
+    SitlDShot_Moto[SitlDShot_Moto_Num].channel = channel;
+
+    return SitlDShot_Moto_Num++;
+}
+
+/* called in firmware context when the output dma is started */
+static void SitlDShot_Sink(TIM_TypeDef *instance, uint32_t channel, const uint32_t *ccr, uint32_t bit_num, uint32_t stride, uint32_t auto_reload)
+{
+    int8_t moto = SitlDShot_Get_Moto(instance, channel);
+    uint16_t packet = 0;
+
+    (void)auto_reload;
+
+    if ((moto < 0) || (ccr == NULL) || (bit_num < DSHOT_FRAME_SIZE))
+        return;
+
+    for (uint8_t i = 0; i < DSHOT_FRAME_SIZE; i++)
+        packet = (packet << 1) | ((ccr[i * stride] > (MOTOR_BITLENGTH / 2)) ? 1 : 0);
+
+    SitlStat_DShot_Frame((uint32_t)moto, packet >> 5);
+}
+
+bool SitlDShot_Init(void)
+{
+    SitlDShot_Moto_Num = 0;
+    BspTimer_Sitl_Set_FrameSink(SitlDShot_Sink);
+
+    return true;
+}
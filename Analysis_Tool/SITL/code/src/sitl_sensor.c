@@ -0,0 +1,328 @@
+/*
+ * register level model of the on board sensor
+ *   primary imu   : mpu6000 on spi1
+ *   secondary imu : icm20602 on spi4
+ *   baro          : dps310 on i2c2
+ *
+ * imu register file echo every write, pwr_mgmt_1 reset bit restore the default value
+ * spi burst read come from a copy latched on cs falling edge, same as the chip output register
+ * model thread refresh the data register at the odr inside the simulated isr then pulse the int pin
+ */
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "HW_Def.h"
+#include "Bsp_GPIO.h"
+#include "Bsp_SPI.h"
+#include "Bsp_IIC.h"
+#include "sitl_model.h"
+#include "sitl_stat.h"
+
+#define SITL_IMU_REG_NUM 128
+#define SITL_IMU_READ_MASK 0x80
+#define SITL_IMU_RESET_BIT 0x80
+
+#define SITL_IMU_REG_INT_STATUS 0x3A
+#define SITL_IMU_REG_DATA 0x3B
+#define SITL_IMU_REG_DATA_SIZE 14
+#define SITL_IMU_REG_PWR_MGMT_1 0x6B
+#define SITL_IMU_REG_WHO_AM_I 0x75
+
+#define SITL_IMU_ACC_1G 2048      /* 16G range */
+#define SITL_IMU_GYR_1DPS 16.4f   /* 2000dps range */
+#define SITL_IMU_GYR_AMP 20.0f    /* unit: deg/s */
+#define SITL_IMU_GYR_FREQ 2.0f    /* unit: Hz */
+
+#define SITL_BARO_ADDR 0x76
+#define SITL_BARO_REG_NUM 0x40
+#define SITL_BARO_REG_PRS_CFG 0x06
+#define SITL_BARO_REG_MEAS_CFG 0x08
+#define SITL_BARO_REG_RESET 0x0C
+#define SITL_BARO_REG_PROD_ID 0x0D
+#define SITL_BARO_REG_COEF 0x10
+#define SITL_BARO_REG_COEF_SRCE 0x28
+#define SITL_BARO_MEAS_RDY 0xF0   /* coef ready, sensor ready, tmp ready, prs ready */
+#define SITL_BARO_SOFT_RESET 0x09
+
+typedef struct
+{
+    uint8_t who_am_i;
+    uint8_t pwr_mgmt_1_def;
+    SitlStat_Counter_List drdy_cnt;
+    SitlStat_Counter_List read_cnt;
+    GPIO_TypeDef *int_port;
+    uint16_t int_pin;
+
+    /* bus state of one cs window */
+    bool addr_phase;
+    bool read;
+    uint8_t addr;
+
+    /* refreshed by model thread, odd sequence while updating */
+    volatile uint32_t seq;
+    uint64_t drdy_ns;
+    uint8_t reg[SITL_IMU_REG_NUM];
+
+    uint64_t latch_drdy_ns;
+    uint8_t latch[SITL_IMU_REG_NUM];
+} SitlIMU_Model_TypeDef;
+
+/* internal vriable */
+static SitlIMU_Model_TypeDef SitlIMU_Pri = {
+    .who_am_i = 0x68,
+    .pwr_mgmt_1_def = 0x40,
+    .drdy_cnt = SitlStat_Cnt_PriIMU_Drdy,
+    .read_cnt = SitlStat_Cnt_PriIMU_Read,
+};
+
+static SitlIMU_Model_TypeDef SitlIMU_Sec = {
+    .who_am_i = 0x12,
+    .pwr_mgmt_1_def = 0x41,
+    .drdy_cnt = SitlStat_Cnt_SecIMU_Drdy,
+    .read_cnt = SitlStat_Cnt_SecIMU_Read,
+};
+
+static uint8_t SitlBaro_Reg[SITL_BARO_REG_NUM];
+
+/* internal function */
+static void SitlIMU_Reset(SitlIMU_Model_TypeDef *model);
+static void SitlIMU_Select(SitlIMU_Model_TypeDef *model, bool cs);
+static void SitlIMU_Xfer(SitlIMU_Model_TypeDef *model, const uint8_t *tx, uint8_t *rx, uint16_t size);
+static void SitlIMU_Update(SitlIMU_Model_TypeDef *model, uint64_t now, float t);
+static void SitlIMU_Pri_CS(bool state);
+static void SitlIMU_Sec_CS(bool state);
+static void SitlIMU_Pri_Xfer(const uint8_t *tx, uint8_t *rx, uint16_t size);
+static void SitlIMU_Sec_Xfer(const uint8_t *tx, uint8_t *rx, uint16_t size);
+static void *SitlIMU_Thread(void *arg);
+static void SitlBaro_Reset(void);
+static bool SitlBaro_Read(uint16_t reg, uint8_t *p_data, uint16_t len);
+static bool SitlBaro_Write(uint16_t reg, const uint8_t *p_data, uint16_t len);
+
+/************************************************** imu section ************************************************/
+static void SitlIMU_Reset(SitlIMU_Model_TypeDef *model)
+{
+    memset(model->reg, 0, SITL_IMU_REG_NUM);
+    model->reg[SITL_IMU_REG_WHO_AM_I] = model->who_am_i;
+    model->reg[SITL_IMU_REG_PWR_MGMT_1] = model->pwr_mgmt_1_def;
+}
+
+/* cs low start a new transaction, output register latched */
+static void SitlIMU_Select(SitlIMU_Model_TypeDef *model, bool cs)
+{
+    uint32_t seq = 0;
+
+    if (cs)
+        return;
+
+    model->addr_phase = true;
+
+    do
+    {
+        seq = model->seq;
+        memcpy(model->latch, model->reg, SITL_IMU_REG_NUM);
+        model->latch_drdy_ns = model->drdy_ns;
+    } while ((seq & 1) || (seq != model->seq));
+}
+
+static void SitlIMU_Xfer(SitlIMU_Model_TypeDef *model, const uint8_t *tx, uint8_t *rx, uint16_t size)
+{
+    for (uint16_t i = 0; i < size; i++)
+    {
+        rx[i] = 0;
+
+        if (model->addr_phase)
+        {
+            model->addr_phase = false;
+            model->read = (tx[i] & SITL_IMU_READ_MASK) ? true : false;
+            model->addr = tx[i] & (SITL_IMU_REG_NUM - 1);
+
+            if (model->read && (model->addr == SITL_IMU_REG_DATA))
+            {
+                SitlStat_Count(model->read_cnt);
+                if (model == &SitlIMU_Pri)
+                    SitlStat_IMU_Read(model->latch_drdy_ns);
+            }
+            continue;
+        }
+
+        if (model->read)
+        {
+            rx[i] = model->latch[model->addr];
+        }
+        else if (model->addr == SITL_IMU_REG_PWR_MGMT_1 && (tx[i] & SITL_IMU_RESET_BIT))
+        {
+            SitlIMU_Reset(model);
+        }
+        else if (model->addr != SITL_IMU_REG_WHO_AM_I)
+        {
+            model->reg[model->addr] = tx[i];
+            model->latch[model->addr] = tx[i];
+        }
+
+        model->addr = (model->addr + 1) & (SITL_IMU_REG_NUM - 1);
+    }
+}
+
+/* called inside simulated isr, task level reader retry on sequence change */
+static void SitlIMU_Update(SitlIMU_Model_TypeDef *model, uint64_t now, float t)
+{
+    int16_t data[SITL_IMU_REG_DATA_SIZE / 2];
+    uint8_t *p = &model->reg[SITL_IMU_REG_DATA];
+
+    /* level attitude with a roll rate sine wave and one lsb dither */
+    data[0] = (int16_t)(now & 1);
+    data[1] = 0;
+    data[2] = SITL_IMU_ACC_1G;
+    data[3] = 0;
+    data[4] = (int16_t)(SITL_IMU_GYR_AMP * SITL_IMU_GYR_1DPS * sinf(2.0f * (float)M_PI * SITL_IMU_GYR_FREQ * t));
+    data[5] = (int16_t)((now >> 1) & 1);
+    data[6] = 0;
+
+    model->seq++;
+    for (uint8_t i = 0; i < SITL_IMU_REG_DATA_SIZE / 2; i++)
+    {
+        p[i * 2] = (uint8_t)((uint16_t)data[i] >> 8);
+        p[i * 2 + 1] = (uint8_t)data[i];
+    }
+    model->reg[SITL_IMU_REG_INT_STATUS] |= 0x01;
+    model->drdy_ns = now;
+    model->seq++;
+
+    SitlStat_Count(model->drdy_cnt);
+}
+
+static void SitlIMU_Pri_CS(bool state)
+{
+    SitlIMU_Select(&SitlIMU_Pri, state);
+}
+
+static void SitlIMU_Sec_CS(bool state)
+{
+    SitlIMU_Select(&SitlIMU_Sec, state);
+}
+
+static void SitlIMU_Pri_Xfer(const uint8_t *tx, uint8_t *rx, uint16_t size)
+{
+    SitlIMU_Xfer(&SitlIMU_Pri, tx, rx, size);
+}
+
+static void SitlIMU_Sec_Xfer(const uint8_t *tx, uint8_t *rx, uint16_t size)
+{
+    SitlIMU_Xfer(&SitlIMU_Sec, tx, rx, size);
+}
+
+static void *SitlIMU_Thread(void *arg)
+{
+    struct timespec next;
+    uint64_t start = SitlPort_Get_Time();
+    uint64_t now = 0;
+
+    (void)arg;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    while (true)
+    {
+        next.tv_nsec += 1000000000L / SITL_IMU_ODR_HZ;
+        if (next.tv_nsec >= 1000000000L)
+        {
+            next.tv_nsec -= 1000000000L;
+            next.tv_sec++;
+        }
+        clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL);
+
+        now = SitlPort_Get_Time();
+
+        SitlPort_Isr_Enter();
+        SitlIMU_Update(&SitlIMU_Pri, now, (now - start) / 1.0e9f);
+        SitlIMU_Update(&SitlIMU_Sec, now, (now - start) / 1.0e9f);
+        SitlPort_Isr_Exit();
+
+        /* data ready pulse, active high */
+        BspGPIO_Sitl_Set_Input(SitlIMU_Pri.int_port, SitlIMU_Pri.int_pin, true);
+        BspGPIO_Sitl_Set_Input(SitlIMU_Sec.int_port, SitlIMU_Sec.int_pin, true);
+        BspGPIO_Sitl_Set_Input(SitlIMU_Pri.int_port, SitlIMU_Pri.int_pin, false);
+        BspGPIO_Sitl_Set_Input(SitlIMU_Sec.int_port, SitlIMU_Sec.int_pin, false);
+    }
+
+    return NULL;
+}
+
+bool SitlIMU_Init(void)
+{
+    SitlIMU_Pri.int_port = PriIMU_INT_PORT;
+    SitlIMU_Pri.int_pin = PriIMU_INT_PIN;
+    SitlIMU_Sec.int_port = SecIMU_INT_PORT;
+    SitlIMU_Sec.int_pin = SecIMU_INT_PIN;
+
+    SitlIMU_Reset(&SitlIMU_Pri);
+    SitlIMU_Reset(&SitlIMU_Sec);
+
+    if (!BspSPI_Sitl_Attach(PriIMU_SPI_BUS, SitlIMU_Pri_Xfer) ||
+        !BspSPI_Sitl_Attach(SecIMU_SPI_BUS, SitlIMU_Sec_Xfer) ||
+        !BspGPIO_Sitl_Set_OutputHook(PriIMU_CS_PORT, PriIMU_CS_PIN, SitlIMU_Pri_CS) ||
+        !BspGPIO_Sitl_Set_OutputHook(SecIMU_CS_PORT, SecIMU_CS_PIN, SitlIMU_Sec_CS))
+        return false;
+
+    return SitlPort_Thread_Create(SitlIMU_Thread, NULL) == pdPASS;
+}
+
+/************************************************** baro section ************************************************/
+/*
+ * coefficient chosen so raw reading 0 compensate into 101325 Pa and 25 C
+ * c0 = 50, c1 = 0, c00 = 101325, other = 0
+ */
+static void SitlBaro_Reset(void)
+{
+    static const uint8_t coef[18] = {0x03, 0x20, 0x00, 0x18, 0xBC, 0xD0};
+
+    memset(SitlBaro_Reg, 0, sizeof(SitlBaro_Reg));
+    memcpy(&SitlBaro_Reg[SITL_BARO_REG_COEF], coef, sizeof(coef));
+
+    SitlBaro_Reg[SITL_BARO_REG_PROD_ID] = 0x10;
+    SitlBaro_Reg[SITL_BARO_REG_COEF_SRCE] = 0x80;
+}
+
+static bool SitlBaro_Read(uint16_t reg, uint8_t *p_data, uint16_t len)
+{
+    if (reg == 0)
+        SitlStat_Count(SitlStat_Cnt_Baro_Read);
+
+    for (uint16_t i = 0; i < len; i++, reg++)
+    {
+        if (reg >= SITL_BARO_REG_NUM)
+            p_data[i] = 0;
+        else if (reg == SITL_BARO_REG_MEAS_CFG)
+            p_data[i] = SITL_BARO_MEAS_RDY | SitlBaro_Reg[reg];
+        else
+            p_data[i] = SitlBaro_Reg[reg];
+    }
+
+    return true;
+}
+
+static bool SitlBaro_Write(uint16_t reg, const uint8_t *p_data, uint16_t len)
+{
+    for (uint16_t i = 0; i < len; i++, reg++)
+    {
+        if ((reg == SITL_BARO_REG_RESET) && ((p_data[i] & 0x0F) == SITL_BARO_SOFT_RESET))
+        {
+            SitlBaro_Reset();
+            continue;
+        }
+
+        /* measurement result, product id and coefficient are read only */
+        if ((reg < SITL_BARO_REG_PRS_CFG) || (reg >= SITL_BARO_REG_PROD_ID))
+            continue;
+
+        SitlBaro_Reg[reg] = p_data[i];
+    }
+
+    return true;
+}
+
+bool SitlBaro_Init(void)
+{
+    SitlBaro_Reset();
+    return BspIIC_Sitl_Attach(BARO_BUS, SITL_BARO_ADDR, SitlBaro_Read, SitlBaro_Write);
+}
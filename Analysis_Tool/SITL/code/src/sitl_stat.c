@@ -0,0 +1,239 @@
+/*
+ * scheduler trace and latency statistic of the sitl run
+ * trace hook called by the os port with the interrupt lock held, so no extra lock in here
+ * cpu time of a task is the host time between its switch in and switch out
+ * idle task time include the wait for interrupt of the idle hook, cpu load = 1 - idle share
+ */
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "sitl_stat.h"
+
+#define SITL_STAT_NS_PER_US 1000.0
+
+static const char *SitlStat_Counter_Name[SitlStat_Cnt_Sum] = {
+    "pri imu drdy",
+    "pri imu read",
+    "sec imu drdy",
+    "sec imu read",
+    "baro read",
+    "rc frame",
+    "dshot frame",
+    "dshot update",
+};
+
+/* internal vriable */
+static SitlStat_Task_TypeDef SitlStat_Task[SITL_STAT_TASK_MAX];
+static uint8_t SitlStat_Task_Num = 0;
+static uint32_t SitlStat_Counter[SitlStat_Cnt_Sum];
+static SitlStat_Latency_TypeDef SitlStat_IMU2DShot;
+static uint64_t SitlStat_IMU_Latest = 0;
+static uint16_t SitlStat_DShot_Value = 0;
+static uint64_t SitlStat_Start_ns = 0;
+
+/* internal function */
+static SitlStat_Task_TypeDef *SitlStat_Search_Task(void *tcb);
+static void SitlStat_Latency_Update(SitlStat_Latency_TypeDef *lat, uint64_t ns);
+
+void SitlStat_Init(void)
+{
+    memset(SitlStat_Task, 0, sizeof(SitlStat_Task));
+    memset(SitlStat_Counter, 0, sizeof(SitlStat_Counter));
+    memset(&SitlStat_IMU2DShot, 0, sizeof(SitlStat_IMU2DShot));
+
+    SitlStat_Task_Num = 0;
+    SitlStat_IMU_Latest = 0;
+    SitlStat_Start_ns = SitlPort_Get_Time();
+}
+
+static SitlStat_Task_TypeDef *SitlStat_Search_Task(void *tcb)
+{
+    SitlStat_Task_TypeDef *task = NULL;
+
+    for (uint8_t i = 0; i < SitlStat_Task_Num; i++)
+    {
+        if (SitlStat_Task[i].tcb == tcb)
+            return &SitlStat_Task[i];
+    }
+
+    if (SitlStat_Task_Num >= SITL_STAT_TASK_MAX)
+        return NULL;
+
+    /* task name copied, tcb of a deleted task is freed */
+    task = &SitlStat_Task[SitlStat_Task_Num++];
+    task->tcb = tcb;
+    task->period_min_ns = UINT64_MAX;
+    strncpy(task->name, pcTaskGetName((TaskHandle_t)tcb), SITL_STAT_NAME_LEN - 1);
+
+    return task;
+}
+
+static void SitlStat_Latency_Update(SitlStat_Latency_TypeDef *lat, uint64_t ns)
+{
+    if (lat->cnt == 0)
+        lat->min_ns = ns;
+
+    lat->cnt++;
+    lat->sum_ns += ns;
+
+    if (ns < lat->min_ns)
+        lat->min_ns = ns;
+
+    if (ns > lat->max_ns)
+        lat->max_ns = ns;
+}
+
+/*************************************************** os trace hook **************************************************/
+void SitlTrace_Task_SwitchIn(void *tcb)
+{
+    SitlStat_Task_TypeDef *task = SitlStat_Search_Task(tcb);
+    uint64_t now = SitlPort_Get_Time();
+    uint64_t period = 0;
+
+    if (task == NULL)
+        return;
+
+    task->switch_in_ns = now;
+
+    if (!task->delayed)
+        return;
+
+    task->delayed = false;
+    if (task->act_cnt)
+    {
+        period = now - task->act_ns;
+        task->period_cnt++;
+        task->period_sum_ns += period;
+
+        if (period < task->period_min_ns)
+            task->period_min_ns = period;
+
+        if (period > task->period_max_ns)
+            task->period_max_ns = period;
+    }
+
+    task->act_cnt++;
+    task->act_ns = now;
+    task->act_run_ns = 0;
+}
+
+void SitlTrace_Task_SwitchOut(void *tcb)
+{
+    SitlStat_Task_TypeDef *task = SitlStat_Search_Task(tcb);
+    uint64_t slice = 0;
+
+    if ((task == NULL) || (task->switch_in_ns == 0))
+        return;
+
+    slice = SitlPort_Get_Time() - task->switch_in_ns;
+    task->run_ns += slice;
+    task->act_run_ns += slice;
+    task->switch_in_ns = 0;
+}
+
+/* called by the delaying task itself before it switch out */
+void SitlTrace_Task_Delay(void *tcb)
+{
+    SitlStat_Task_TypeDef *task = SitlStat_Search_Task(tcb);
+    uint64_t exec = 0;
+
+    if (task == NULL)
+        return;
+
+    exec = task->act_run_ns;
+    if (task->switch_in_ns)
+        exec += SitlPort_Get_Time() - task->switch_in_ns;
+
+    if (task->act_cnt && (exec > task->exec_max_ns))
+        task->exec_max_ns = exec;
+
+    task->delayed = true;
+}
+
+/* idle hook is the wfi of the simulated core */
+void vApplicationIdleHook(void)
+{
+    SitlPort_Wait_Interrupt(1000);
+}
+
+/*************************************************** model event **************************************************/
+void SitlStat_Count(SitlStat_Counter_List item)
+{
+    if (item < SitlStat_Cnt_Sum)
+        SitlStat_Counter[item]++;
+}
+
+/* data ready time of the imu sample firmware just read out */
+void SitlStat_IMU_Read(uint64_t drdy_ns)
+{
+    SitlStat_IMU_Latest = drdy_ns;
+}
+
+/* age of the newest imu sample when the first moto frame of one update go out */
+void SitlStat_DShot_Frame(uint32_t moto, uint16_t value)
+{
+    SitlStat_Counter[SitlStat_Cnt_DShot_Frame]++;
+
+    if (moto != 0)
+        return;
+
+    SitlStat_Counter[SitlStat_Cnt_DShot_Update]++;
+    SitlStat_DShot_Value = value;
+
+    if (SitlStat_IMU_Latest)
+        SitlStat_Latency_Update(&SitlStat_IMU2DShot, SitlPort_Get_Time() - SitlStat_IMU_Latest);
+}
+
+/*************************************************** report **************************************************/
+void SitlStat_Print(FILE *out)
+{
+    uint64_t elapsed = SitlPort_Get_Time() - SitlStat_Start_ns;
+    double idle_share = 0.0;
+    SitlStat_Task_TypeDef *task = NULL;
+    double sec = elapsed / 1.0e9;
+
+    fprintf(out, "\r\n[SITL] run time %.3f s\r\n", sec);
+    fprintf(out, "%-16s %8s %8s %10s %10s %10s %10s %10s\r\n",
+            "task", "cpu(%)", "rate(Hz)", "period(us)", "min(us)", "max(us)", "jitter(us)", "exec(us)");
+
+    for (uint8_t i = 0; i < SitlStat_Task_Num; i++)
+    {
+        task = &SitlStat_Task[i];
+
+        if (strcmp(task->name, "IDLE") == 0)
+            idle_share = (double)task->run_ns / elapsed;
+
+        if (task->period_cnt == 0)
+        {
+            fprintf(out, "%-16s %8.2f %8s\r\n", task->name, 100.0 * task->run_ns / elapsed, "-");
+            continue;
+        }
+
+        fprintf(out, "%-16s %8.2f %8.1f %10.1f %10.1f %10.1f %10.1f %10.1f\r\n",
+                task->name,
+                100.0 * task->run_ns / elapsed,
+                task->act_cnt / sec,
+                task->period_sum_ns / (double)task->period_cnt / SITL_STAT_NS_PER_US,
+                task->period_min_ns / SITL_STAT_NS_PER_US,
+                task->period_max_ns / SITL_STAT_NS_PER_US,
+                (task->period_max_ns - task->period_min_ns) / SITL_STAT_NS_PER_US,
+                task->exec_max_ns / SITL_STAT_NS_PER_US);
+    }
+
+    fprintf(out, "[SITL] cpu load %.2f %%\r\n", 100.0 * (1.0 - idle_share));
+
+    for (uint8_t i = 0; i < SitlStat_Cnt_Sum; i++)
+        fprintf(out, "[SITL] %-14s %10u  %8.1f Hz\r\n", SitlStat_Counter_Name[i], SitlStat_Counter[i], SitlStat_Counter[i] / sec);
+
+    if (SitlStat_IMU2DShot.cnt)
+    {
+        fprintf(out, "[SITL] imu to dshot latency avg %.1f us min %.1f us max %.1f us (%u sample)\r\n",
+                SitlStat_IMU2DShot.sum_ns / (double)SitlStat_IMU2DShot.cnt / SITL_STAT_NS_PER_US,
+                SitlStat_IMU2DShot.min_ns / SITL_STAT_NS_PER_US,
+                SitlStat_IMU2DShot.max_ns / SITL_STAT_NS_PER_US,
+                SitlStat_IMU2DShot.cnt);
+        fprintf(out, "[SITL] last moto 1 dshot value %u\r\n", SitlStat_DShot_Value);
+    }
+    else
+        fprintf(out, "[SITL] imu to dshot latency: no dshot update after imu read\r\n");
+}
@@ -0,0 +1,356 @@
+/*
+ * convert the event trace image from debug/evt_trace.c into chrome / perfetto trace json
+ * input is either the raw image (Trace_Save on sd card) or a terminal capture of Trace_Dump
+ * open the output in chrome://tracing or ui.perfetto.dev
+ *
+ *   pid 1 : one track per freertos task, scheduled in / out
+ *   pid 2 : datapipe / spi / iic / log flush as duration, uart rx / tx as instant event
+ *
+ * usage : trace2json <input> [output.json]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "evt_trace.h"
+
+#define TRACE_DUMP_TAG "[Trace Dump Start]"
+#define TRACE_TASK_PID 1
+#define TRACE_BUS_PID 2
+
+typedef enum
+{
+    Trace_Track_Pipe = 1,
+    Trace_Track_SPI,
+    Trace_Track_IIC,
+    Trace_Track_Log,
+    Trace_Track_Uart,
+    Trace_Track_Sum,
+} Trace_Track_List;
+
+static const char *Trace_Track_Name[Trace_Track_Sum] = {
+    [Trace_Track_Pipe] = "DataPipe",
+    [Trace_Track_SPI] = "SPI",
+    [Trace_Track_IIC] = "IIC",
+    [Trace_Track_Log] = "Log Flush",
+    [Trace_Track_Uart] = "Uart",
+};
+
+static const char *Trace_SPI_Dir[3] = {"spi tx", "spi rx", "spi txrx"};
+
+/* open duration count, end without begin is dropped */
+static uint32_t Trace_TaskOpen[256];
+static uint32_t Trace_BusOpen[Trace_Track_Sum];
+static uint8_t Trace_TaskOpenOrder[256];
+static uint32_t Trace_EventOut = 0;
+
+static uint8_t *Trace_Load(const char *path, long *size)
+{
+    FILE *fp = fopen(path, "rb");
+    uint8_t *buf = NULL;
+
+    if (fp == NULL)
+        return NULL;
+
+    fseek(fp, 0, SEEK_END);
+    *size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    buf = malloc(*size + 1);
+    if (buf && (fread(buf, 1, *size, fp) != (size_t)*size))
+    {
+        free(buf);
+        buf = NULL;
+    }
+
+    fclose(fp);
+    return buf;
+}
+
+/* raw image start with the magic, capture carry the image right after the start tag line */
+static uint8_t *Trace_Locate(uint8_t *buf, long size, long *image_size)
+{
+    uint32_t magic = 0;
+    uint8_t *p_tag = NULL;
+    uint8_t *p_line_end = NULL;
+    long tag_len = strlen(TRACE_DUMP_TAG);
+
+    if (size >= (long)sizeof(uint32_t))
+    {
+        memcpy(&magic, buf, sizeof(uint32_t));
+        if (magic == EVT_TRACE_MAGIC)
+        {
+            *image_size = size;
+            return buf;
+        }
+    }
+
+    for (long i = 0; i + tag_len < size; i++)
+    {
+        if (memcmp(&buf[i], TRACE_DUMP_TAG, tag_len) == 0)
+        {
+            p_tag = &buf[i];
+            break;
+        }
+    }
+
+    if (p_tag == NULL)
+        return NULL;
+
+    *image_size = strtol((const char *)p_tag + tag_len, NULL, 10);
+    p_line_end = memchr(p_tag, '\n', size - (p_tag - buf));
+    if ((p_line_end == NULL) || ((p_line_end + 1 + *image_size) > (buf + size)))
+        return NULL;
+
+    return p_line_end + 1;
+}
+
+static void Trace_Emit(FILE *fp, const char *fmt_head)
+{
+    fprintf(fp, "%s\n    %s", Trace_EventOut ? "," : "", fmt_head);
+    Trace_EventOut++;
+}
+
+static void Trace_Emit_Duration(FILE *fp, char ph, const char *name, uint8_t pid, uint32_t tid, double ts, const char *args)
+{
+    char head[256];
+
+    snprintf(head, sizeof(head), "{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f%s%s}",
+             name, ph, pid, tid, ts, args ? ",\"args\":" : "", args ? args : "");
+    Trace_Emit(fp, head);
+}
+
+static void Trace_Emit_Instant(FILE *fp, const char *name, uint32_t tid, double ts, const char *args)
+{
+    char head[256];
+
+    snprintf(head, sizeof(head), "{\"name\":\"%s\",\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f,\"args\":%s}",
+             name, TRACE_BUS_PID, tid, ts, args);
+    Trace_Emit(fp, head);
+}
+
+static void Trace_Emit_Meta(FILE *fp, const char *meta, uint8_t pid, uint32_t tid, const char *name)
+{
+    char head[256];
+
+    snprintf(head, sizeof(head), "{\"name\":\"%s\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+             meta, pid, tid, name);
+    Trace_Emit(fp, head);
+}
+
+static const char *Trace_Task_Name(const EvtTrace_Task_TypeDef *task, uint8_t task_num, uint8_t number)
+{
+    static char unknown[24];
+
+    for (uint8_t i = 0; i < task_num; i++)
+    {
+        if ((uint8_t)task[i].number == number)
+            return task[i].name;
+    }
+
+    snprintf(unknown, sizeof(unknown), "task %d", number);
+    return unknown;
+}
+
+static void Trace_Bus_Begin(FILE *fp, Trace_Track_List track, const char *name, double ts, const char *args)
+{
+    Trace_BusOpen[track]++;
+    Trace_Emit_Duration(fp, 'B', name, TRACE_BUS_PID, track, ts, args);
+}
+
+static void Trace_Bus_End(FILE *fp, Trace_Track_List track, double ts, uint8_t state)
+{
+    char args[32];
+
+    if (Trace_BusOpen[track] == 0)
+        return;
+
+    Trace_BusOpen[track]--;
+    snprintf(args, sizeof(args), "{\"state\":%d}", state);
+    Trace_Emit_Duration(fp, 'E', "", TRACE_BUS_PID, track, ts, args);
+}
+
+int main(int argc, char *argv[])
+{
+    uint8_t *file_buf = NULL;
+    uint8_t *image = NULL;
+    long file_size = 0;
+    long image_size = 0;
+    char out_path[512];
+    char args[96];
+    FILE *fp = NULL;
+    EvtTrace_Header_TypeDef header;
+    const EvtTrace_Task_TypeDef *task = NULL;
+    const EvtTrace_Event_TypeDef *evt = NULL;
+    EvtTrace_Event_TypeDef cur;
+    uint64_t time_cyc = 0;
+    uint32_t lst_cyc = 0;
+    uint32_t unknown_cnt = 0;
+    uint8_t order_num = 0;
+    double ts = 0.0;
+
+    if (argc < 2)
+    {
+        printf("usage : trace2json <input> [output.json]\r\n");
+        return -1;
+    }
+
+    file_buf = Trace_Load(argv[1], &file_size);
+    if (file_buf == NULL)
+    {
+        printf("[Trace2Json] open %s failed\r\n", argv[1]);
+        return -1;
+    }
+
+    image = Trace_Locate(file_buf, file_size, &image_size);
+    if ((image == NULL) || (image_size < (long)sizeof(header)))
+    {
+        printf("[Trace2Json] no trace image found\r\n");
+        free(file_buf);
+        return -1;
+    }
+
+    memcpy(&header, image, sizeof(header));
+    if ((header.magic != EVT_TRACE_MAGIC) || (header.version != EVT_TRACE_VERSION) ||
+        (header.clock == 0) || (image_size < (long)(header.header_size + header.task_num * sizeof(EvtTrace_Task_TypeDef) +
+                                                     header.event_num * sizeof(EvtTrace_Event_TypeDef))))
+    {
+        printf("[Trace2Json] bad image header\r\n");
+        free(file_buf);
+        return -1;
+    }
+
+    task = (const EvtTrace_Task_TypeDef *)(image + header.header_size);
+    evt = (const EvtTrace_Event_TypeDef *)((const uint8_t *)task + header.task_num * sizeof(EvtTrace_Task_TypeDef));
+
+    if (argc > 2)
+        snprintf(out_path, sizeof(out_path), "%s", argv[2]);
+    else
+        snprintf(out_path, sizeof(out_path), "%s.json", argv[1]);
+
+    fp = fopen(out_path, "w");
+    if (fp == NULL)
+    {
+        printf("[Trace2Json] create %s failed\r\n", out_path);
+        free(file_buf);
+        return -1;
+    }
+
+    fprintf(fp, "{\"traceEvents\":[");
+
+    Trace_Emit_Meta(fp, "process_name", TRACE_TASK_PID, 0, "Task");
+    Trace_Emit_Meta(fp, "process_name", TRACE_BUS_PID, 0, "Bus");
+    for (uint8_t i = 0; i < header.task_num; i++)
+    {
+        if (task[i].name[0] != '\0')
+            Trace_Emit_Meta(fp, "thread_name", TRACE_TASK_PID, (uint8_t)task[i].number, task[i].name);
+    }
+
+    for (uint8_t i = Trace_Track_Pipe; i < Trace_Track_Sum; i++)
+        Trace_Emit_Meta(fp, "thread_name", TRACE_BUS_PID, i, Trace_Track_Name[i]);
+
+    for (uint32_t i = 0; i < header.event_num; i++)
+    {
+        memcpy(&cur, &evt[i], sizeof(cur));
+
+        /* 32 bit cycle counter wrap, event recorded from an interrupt may land slightly out of order */
+        if (i)
+            time_cyc += (int64_t)(int32_t)(cur.cyc - lst_cyc);
+        lst_cyc = cur.cyc;
+        ts = (double)(int64_t)time_cyc * 1e6 / header.clock;
+
+        switch (cur.id)
+        {
+            case EvtTrace_Task_In:
+                if (Trace_TaskOpen[cur.sub] == 0)
+                    Trace_TaskOpenOrder[order_num++] = cur.sub;
+                Trace_TaskOpen[cur.sub]++;
+                Trace_Emit_Duration(fp, 'B', Trace_Task_Name(task, header.task_num, cur.sub), TRACE_TASK_PID, cur.sub, ts, NULL);
+                break;
+
+            case EvtTrace_Task_Out:
+                if (Trace_TaskOpen[cur.sub] == 0)
+                    break;
+
+                Trace_TaskOpen[cur.sub]--;
+                Trace_Emit_Duration(fp, 'E', "", TRACE_TASK_PID, cur.sub, ts, NULL);
+                break;
+
+            case EvtTrace_Pipe_Start:
+                snprintf(args, sizeof(args), "{\"size\":%d}", cur.arg);
+                Trace_Bus_Begin(fp, Trace_Track_Pipe, "pipe", ts, args);
+                break;
+
+            case EvtTrace_Pipe_Finish:
+                /* datapipe report 0 as done */
+                Trace_Bus_End(fp, Trace_Track_Pipe, ts, !cur.sub);
+                break;
+
+            case EvtTrace_SPI_Start:
+                snprintf(args, sizeof(args), "{\"size\":%d}", cur.arg);
+                Trace_Bus_Begin(fp, Trace_Track_SPI, (cur.sub < 3) ? Trace_SPI_Dir[cur.sub] : "spi", ts, args);
+                break;
+
+            case EvtTrace_SPI_End:
+                Trace_Bus_End(fp, Trace_Track_SPI, ts, cur.sub);
+                break;
+
+            case EvtTrace_IIC_Start:
+                snprintf(args, sizeof(args), "{\"addr\":\"0x%02X\",\"size\":%d}", cur.sub, cur.arg);
+                Trace_Bus_Begin(fp, Trace_Track_IIC, "iic", ts, args);
+                break;
+
+            case EvtTrace_IIC_End:
+                Trace_Bus_End(fp, Trace_Track_IIC, ts, cur.sub);
+                break;
+
+            case EvtTrace_Log_Flush_Start:
+                snprintf(args, sizeof(args), "{\"size\":%d}", cur.arg);
+                Trace_Bus_Begin(fp, Trace_Track_Log, "flush", ts, args);
+                break;
+
+            case EvtTrace_Log_Flush_End:
+                Trace_Bus_End(fp, Trace_Track_Log, ts, cur.sub);
+                break;
+
+            case EvtTrace_Uart_Rx:
+                snprintf(args, sizeof(args), "{\"port\":%d,\"size\":%d}", cur.sub, cur.arg);
+                Trace_Emit_Instant(fp, "uart rx", Trace_Track_Uart, ts, args);
+                break;
+
+            case EvtTrace_Uart_Tx:
+                snprintf(args, sizeof(args), "{\"port\":%d}", cur.sub);
+                Trace_Emit_Instant(fp, "uart tx", Trace_Track_Uart, ts, args);
+                break;
+
+            default:
+                unknown_cnt++;
+                break;
+        }
+    }
+
+    /* close whatever still running when recording was frozen */
+    for (uint16_t i = 0; i < order_num; i++)
+    {
+        while (Trace_TaskOpen[Trace_TaskOpenOrder[i]])
+        {
+            Trace_TaskOpen[Trace_TaskOpenOrder[i]]--;
+            Trace_Emit_Duration(fp, 'E', "", TRACE_TASK_PID, Trace_TaskOpenOrder[i], ts, NULL);
+        }
+    }
+
+    for (uint8_t i = Trace_Track_Pipe; i < Trace_Track_Sum; i++)
+    {
+        while (Trace_BusOpen[i])
+            Trace_Bus_End(fp, i, ts, 0);
+    }
+
+    fprintf(fp, "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"clock\":%u,\"event_num\":%u,\"lost_num\":%u}}\n",
+            header.clock, header.event_num, header.lost_num);
+    fclose(fp);
+
+    printf("[Trace2Json] %u event, %u lost before dump, %u unknown, span %.3f ms -> %s\r\n",
+           header.event_num, header.lost_num, unknown_cnt, ts / 1000.0, out_path);
+
+    free(file_buf);
+    return 0;
+}
@@ -1,4 +1,5 @@
 #include "Dev_Dshot.h"
+#include "util.h"
 #include <math.h>
 
 __attribute__((weak)) void *DShot_Malloc(uint32_t size){return NULL;}
@@ -8,11 +9,22 @@ __attribute__((weak)) void DShot_Free(void *ptr){return;}
 static bool DevDshot_Init(DevDshotObj_TypeDef *obj, void *timer_ins, uint32_t ch, BspGPIO_Obj_TypeDef pin, uint8_t dma, uint8_t stream);
 static void DevDshot_Control(DevDshotObj_TypeDef *obj, uint16_t value);
 static void DevDshot_Command(DevDshotObj_TypeDef *obj, uint8_t cmd);
+static bool DevDshot_Get_eRPM(DevDshotObj_TypeDef *obj, uint32_t *erpm);
+static bool DevDshot_Burst_Init(DevDshotBurstObj_TypeDef *obj, void *timer_ins, const uint32_t *ch, const BspGPIO_Obj_TypeDef *pin, uint8_t ch_num, uint8_t dma, uint8_t stream);
+static void DevDshot_Burst_Set(DevDshotBurstObj_TypeDef *obj, uint8_t index, uint16_t value);
+static void DevDshot_Burst_Control(DevDshotBurstObj_TypeDef *obj);
+static void DevDshot_Burst_Command(DevDshotBurstObj_TypeDef *obj, uint8_t index, uint8_t cmd);
 
 DevDshot_TypeDef DevDshot = {
     .init = DevDshot_Init,
     .command = DevDshot_Command,
     .control = DevDshot_Control,
+    .get_erpm = DevDshot_Get_eRPM,
+
+    .burst_init = DevDshot_Burst_Init,
+    .burst_set = DevDshot_Burst_Set,
+    .burst_control = DevDshot_Burst_Control,
+    .burst_command = DevDshot_Burst_Command,
 };
 
 static uint32_t DevDshot_GetType_Clock(DevDshotType_List type)
@@ -75,29 +87,38 @@ static bool DevDshot_Init(DevDshotObj_TypeDef *obj,
 
     BspTimer_PWM.start_pwm(&obj->pwm_obj);
 
+    memset(&obj->telemetry, 0, sizeof(obj->telemetry));
+    if (obj->bidir && !BspTimer_PWM.set_bidir(&obj->pwm_obj, (uint32_t)obj->capture_buf, DSHOT_TELEMETRY_EDGE_MAX))
+        obj->bidir = false;
+
     return true;
 }
 
-static uint16_t DevDshot_Prepare_Packet(const uint16_t value, int8_t requestTelemetry)
+/* decode the answer of the last frame, must be called before the next frame start */
+ITCM_CODE static void DevDshot_Telemetry_Update(DevDshotObj_TypeDef *obj)
 {
-    uint16_t packet = (value << 1) | (requestTelemetry ? 1 : 0);
+    uint32_t edge_num = BspTimer_PWM.get_capture(&obj->pwm_obj);
+    uint32_t gcr = 0;
+    uint32_t erpm = 0;
 
-    // compute checksum
-    int csum = 0;
-    int csum_data = packet;
-    for (int i = 0; i < 3; i++)
+    if (edge_num == 0)
     {
-        csum ^= csum_data; // xor data by nibbles
-        csum_data >>= 4;
+        obj->telemetry.miss_cnt ++;
+        return;
     }
 
-    csum &= 0xf;
-    // append checksum
-    packet = (packet << 4) | csum;
-    return packet;
+    if (!DevDshot_Decode_Edge(obj->capture_buf, edge_num, DSHOT_GCR_BIT_TICK, &gcr) ||
+        !DevDshot_Decode_eRPM(gcr, &erpm))
+    {
+        obj->telemetry.error_cnt ++;
+        return;
+    }
+
+    obj->telemetry.erpm = erpm;
+    obj->telemetry.update_cnt ++;
 }
 
-static void DevDshot_Control(DevDshotObj_TypeDef *obj, uint16_t value)
+ITCM_CODE static void DevDshot_Control(DevDshotObj_TypeDef *obj, uint16_t value)
 {
     uint16_t packet;
     bool dshot_telemetry = false;
@@ -111,16 +132,15 @@ static void DevDshot_Control(DevDshotObj_TypeDef *obj, uint16_t value)
     if (value < DSHOT_MIN_THROTTLE)
         value = DSHOT_LOCK_THROTTLE;
 
-    packet = DevDshot_Prepare_Packet(value, dshot_telemetry);
-
-    for (int i = 0; i < 16; i++)
+    if (obj->bidir)
     {
-        obj->ctl_buf[i] = (packet & 0x8000) ? MOTOR_BIT_1 : MOTOR_BIT_0;
-        packet <<= 1;
+        DevDshot_Telemetry_Update(obj);
+        packet = DevDshot_Prepare_Bidir_Packet(value);
     }
+    else
+        packet = DevDshot_Prepare_Packet(value, dshot_telemetry);
 
-    obj->ctl_buf[16] = 0;
-    obj->ctl_buf[17] = 0;
+    DevDshot_Expand_Packet(obj->ctl_buf, 1, packet);
 
     obj->pwm_obj.buffer_addr = (uint32_t)obj->ctl_buf;
     obj->pwm_obj.buffer_size = DSHOT_DMA_BUFFER_SIZE;
@@ -136,16 +156,127 @@ static void DevDshot_Command(DevDshotObj_TypeDef *obj, uint8_t cmd)
     if (!obj || cmd >= DSHOT_MIN_THROTTLE)
         return;
 
-    packet = DevDshot_Prepare_Packet(cmd, dshot_telemetry);
-
-    for (int i = 0; i < 16; i++)
+    if (obj->bidir)
     {
-        obj->ctl_buf[i] = (packet & 0x8000) ? MOTOR_BIT_1 : MOTOR_BIT_0;
-        packet <<= 1;
+        /* no erpm answer on command frame, release the capture only */
+        BspTimer_PWM.get_capture(&obj->pwm_obj);
+        packet = DevDshot_Prepare_Bidir_Packet(cmd);
     }
+    else
+        packet = DevDshot_Prepare_Packet(cmd, dshot_telemetry);
 
-    obj->ctl_buf[16] = 0;
-    obj->ctl_buf[17] = 0;
+    DevDshot_Expand_Packet(obj->ctl_buf, 1, packet);
 
     BspTimer_PWM.dma_trans(&obj->pwm_obj);
 }
+
+static bool DevDshot_Get_eRPM(DevDshotObj_TypeDef *obj, uint32_t *erpm)
+{
+    if ((obj == NULL) || (erpm == NULL) || !obj->bidir || (obj->telemetry.update_cnt == 0))
+        return false;
+
+    *erpm = obj->telemetry.erpm;
+    return true;
+}
+
+/************************************************** Burst Section ************************************************/
+/* channel in ch list must belong to timer_ins, burst cover ccr of the lowest to the highest channel */
+static bool DevDshot_Burst_Init(DevDshotBurstObj_TypeDef *obj,
+                                void *timer_ins,
+                                const uint32_t *ch,
+                                const BspGPIO_Obj_TypeDef *pin,
+                                uint8_t ch_num,
+                                uint8_t dma,
+                                uint8_t stream)
+{
+    uint32_t prescaler = 0;
+
+    if ((obj == NULL) || (ch == NULL) || (pin == NULL) || (ch_num == 0) || (ch_num > DSHOT_BURST_MAX_CH))
+        return false;
+
+    if ((obj->type < DevDshot_150) || (obj->type > DevDshot_600))
+    {
+        obj->type = DevDshot_300;
+    }
+
+    prescaler = lrintf((float)DSHOT_TIMER_CLK_HZ / DevDshot_GetType_Clock(obj->type) + 0.01f) - 1;
+
+#if defined STM32H743xx
+    obj->burst_obj.tim_hdl = DShot_Malloc(TIM_HandleType_Size);
+    if (obj->burst_obj.tim_hdl == NULL)
+        return false;
+
+    obj->burst_obj.dma_hdl = DShot_Malloc(TIM_DMA_HandleType_Size);
+    if (obj->burst_obj.dma_hdl == NULL)
+    {
+        DShot_Free(obj->burst_obj.tim_hdl);
+        return false;
+    }
+#endif
+
+    memset(obj->val, 0, sizeof(obj->val));
+    memset(obj->ctl_buf, 0, sizeof(obj->ctl_buf));
+
+    if (!BspTimer_Burst.init(&obj->burst_obj, timer_ins, ch, pin, ch_num, dma, stream, (uint32_t)obj->ctl_buf, DSHOT_DMA_BUFFER_SIZE))
+        return false;
+
+    BspTimer_Burst.set_prescaler(&obj->burst_obj, prescaler);
+    BspTimer_Burst.set_autoreload(&obj->burst_obj, MOTOR_BITLENGTH);
+    BspTimer_Burst.start_pwm(&obj->burst_obj);
+
+    return true;
+}
+
+/* index is the position of the channel in the list passed to burst init */
+static void DevDshot_Burst_Set(DevDshotBurstObj_TypeDef *obj, uint8_t index, uint16_t value)
+{
+    if ((obj == NULL) || (index >= DSHOT_BURST_MAX_CH) || ((obj->burst_obj.ch_mask & (1 << obj->burst_obj.slot[index])) == 0))
+        return;
+
+    if (value > DSHOT_MAX_THROTTLE)
+        value = DSHOT_MAX_THROTTLE;
+
+    if (value < DSHOT_MIN_THROTTLE)
+        value = DSHOT_LOCK_THROTTLE;
+
+    obj->val[obj->burst_obj.slot[index]] = value;
+}
+
+/* encode every slot then one dma for the whole timer, all moto frame start on the same update edge */
+ITCM_CODE static void DevDshot_Burst_Control(DevDshotBurstObj_TypeDef *obj)
+{
+    uint8_t len = 0;
+
+    if (obj == NULL)
+        return;
+
+    len = obj->burst_obj.burst_len;
+
+    for (uint8_t slot = 0; slot < len; slot++)
+    {
+        /* channel in the gap of the burst keep compare value 0 */
+        if (obj->burst_obj.ch_mask & (1 << slot))
+            DevDshot_Expand_Packet(&obj->ctl_buf[slot], len, DevDshot_Prepare_Packet(obj->val[slot], false));
+    }
+
+    BspTimer_Burst.dma_trans(&obj->burst_obj);
+}
+
+/* command on one channel, other channel send their current value */
+static void DevDshot_Burst_Command(DevDshotBurstObj_TypeDef *obj, uint8_t index, uint8_t cmd)
+{
+    uint16_t val_tmp = 0;
+    uint8_t slot = 0;
+
+    if ((obj == NULL) || (index >= DSHOT_BURST_MAX_CH) || (cmd >= DSHOT_MIN_THROTTLE))
+        return;
+
+    slot = obj->burst_obj.slot[index];
+    if ((obj->burst_obj.ch_mask & (1 << slot)) == 0)
+        return;
+
+    val_tmp = obj->val[slot];
+    obj->val[slot] = cmd;
+    DevDshot_Burst_Control(obj);
+    obj->val[slot] = val_tmp;
+}
@@ -6,6 +6,7 @@
 #include <stdbool.h>
 #include "Bsp_GPIO.h"
 #include "Bsp_Timer.h"
+#include "Dev_Dshot_Frame.h"
 
 #define MHZ_TO_HZ(x) (x * 1000000)
 
@@ -14,12 +15,7 @@
 #define DSHOT300_CLK_HZ MHZ_TO_HZ(6)
 #define DSHOT150_CLK_HZ MHZ_TO_HZ(3)
 
-#define MOTOR_BIT_0 7
-#define MOTOR_BIT_1 14
-#define MOTOR_BITLENGTH 20
-
-#define DSHOT_FRAME_SIZE 16
-#define DSHOT_DMA_BUFFER_SIZE 18 /* resolution + frame reset (2us) */
+#define DSHOT_BURST_MAX_CH BSP_TIMER_BURST_MAX_CH
 
 #define DSHOT_LOCK_THROTTLE 0
 #define DSHOT_MIN_THROTTLE 48
@@ -55,19 +51,49 @@ typedef enum
     DevDshot_600,
 } DevDshotType_List;
 
+typedef struct
+{
+    uint32_t erpm;          /* electrical rpm of the last valid answer */
+    uint32_t update_cnt;    /* valid answer */
+    uint32_t miss_cnt;      /* no edge captured */
+    uint32_t error_cnt;     /* edge timing or checksum error */
+} DevDshot_Telemetry_TypeDef;
+
 typedef struct
 {
     DevDshotType_List type;
+    bool bidir;             /* set before init, esc must run a bidirectional dshot firmware */
     BspTimerPWMObj_TypeDef pwm_obj;
 
     uint32_t ctl_buf[DSHOT_DMA_BUFFER_SIZE];
+    uint32_t capture_buf[DSHOT_TELEMETRY_EDGE_MAX];
+    DevDshot_Telemetry_TypeDef telemetry;
 } DevDshotObj_TypeDef;
 
+/*
+ * all moto on one timer driven by a single update dma in timer burst mode
+ * burst buffer interleaved by bit: | bit0 ccr_a | bit0 ccr_b | ... | bit1 ccr_a | ...
+ */
+typedef struct
+{
+    DevDshotType_List type;
+    BspTimerBurstObj_TypeDef burst_obj;
+
+    uint16_t val[DSHOT_BURST_MAX_CH];   /* indexed by burst slot */
+    uint32_t ctl_buf[DSHOT_DMA_BUFFER_SIZE * DSHOT_BURST_MAX_CH];
+} DevDshotBurstObj_TypeDef;
+
 typedef struct
 {
     bool (*init)(DevDshotObj_TypeDef *obj, void *timer_ins, uint32_t ch, BspGPIO_Obj_TypeDef pin, uint8_t dma, uint8_t stream);
     bool (*command)(DevDshotObj_TypeDef *obj, DevDshot_Command_List cmd);
     bool (*control)(DevDshotObj_TypeDef *obj, uint16_t val);
+    bool (*get_erpm)(DevDshotObj_TypeDef *obj, uint32_t *erpm);
+
+    bool (*burst_init)(DevDshotBurstObj_TypeDef *obj, void *timer_ins, const uint32_t *ch, const BspGPIO_Obj_TypeDef *pin, uint8_t ch_num, uint8_t dma, uint8_t stream);
+    void (*burst_set)(DevDshotBurstObj_TypeDef *obj, uint8_t index, uint16_t val);
+    void (*burst_control)(DevDshotBurstObj_TypeDef *obj);
+    void (*burst_command)(DevDshotBurstObj_TypeDef *obj, uint8_t index, uint8_t cmd);
 } DevDshot_TypeDef;
 
 extern DevDshot_TypeDef DevDshot;
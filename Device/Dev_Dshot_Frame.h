@@ -0,0 +1,183 @@
+#ifndef __DEV_DSHOT_FRAME_H
+#define __DEV_DSHOT_FRAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * dshot frame encode, no hardware dependence
+ * 11 bit value | 1 bit telemetry request | 4 bit checksum, msb first
+ * every bit expanded into one timer compare value, MOTOR_BIT_0 / MOTOR_BIT_1 out of MOTOR_BITLENGTH
+ */
+#define MOTOR_BIT_0 7
+#define MOTOR_BIT_1 14
+#define MOTOR_BITLENGTH 20
+
+#define DSHOT_FRAME_SIZE 16
+#define DSHOT_DMA_BUFFER_SIZE 18 /* resolution + frame reset (2us) */
+
+/*
+ * bidirectional (inverted) dshot telemetry
+ * esc answer 20 bit gcr (4 nibble, 5 bit each) at 5 / 4 of the command bit rate, nrzi coded with a leading start transition
+ * timer keep the command prescaler during capture, one gcr bit last MOTOR_BITLENGTH * 4 / 5 tick
+ */
+#define DSHOT_GCR_BIT_TICK ((MOTOR_BITLENGTH * 4) / 5)
+#define DSHOT_GCR_BIT_NUM 21
+#define DSHOT_TELEMETRY_EDGE_MAX 24
+#define DSHOT_TELEMETRY_EDGE_MASK 0xFFFF    /* capture timer run as 16 bit free counter */
+
+/* compare value of one nibble, msb first */
+static const uint32_t DevDshot_Nibble_LUT[16][4] = {
+    {MOTOR_BIT_0, MOTOR_BIT_0, MOTOR_BIT_0, MOTOR_BIT_0},
+    {MOTOR_BIT_0, MOTOR_BIT_0, MOTOR_BIT_0, MOTOR_BIT_1},
+    {MOTOR_BIT_0, MOTOR_BIT_0, MOTOR_BIT_1, MOTOR_BIT_0},
+    {MOTOR_BIT_0, MOTOR_BIT_0, MOTOR_BIT_1, MOTOR_BIT_1},
+    {MOTOR_BIT_0, MOTOR_BIT_1, MOTOR_BIT_0, MOTOR_BIT_0},
+    {MOTOR_BIT_0, MOTOR_BIT_1, MOTOR_BIT_0, MOTOR_BIT_1},
+    {MOTOR_BIT_0, MOTOR_BIT_1, MOTOR_BIT_1, MOTOR_BIT_0},
+    {MOTOR_BIT_0, MOTOR_BIT_1, MOTOR_BIT_1, MOTOR_BIT_1},
+    {MOTOR_BIT_1, MOTOR_BIT_0, MOTOR_BIT_0, MOTOR_BIT_0},
+    {MOTOR_BIT_1, MOTOR_BIT_0, MOTOR_BIT_0, MOTOR_BIT_1},
+    {MOTOR_BIT_1, MOTOR_BIT_0, MOTOR_BIT_1, MOTOR_BIT_0},
+    {MOTOR_BIT_1, MOTOR_BIT_0, MOTOR_BIT_1, MOTOR_BIT_1},
+    {MOTOR_BIT_1, MOTOR_BIT_1, MOTOR_BIT_0, MOTOR_BIT_0},
+    {MOTOR_BIT_1, MOTOR_BIT_1, MOTOR_BIT_0, MOTOR_BIT_1},
+    {MOTOR_BIT_1, MOTOR_BIT_1, MOTOR_BIT_1, MOTOR_BIT_0},
+    {MOTOR_BIT_1, MOTOR_BIT_1, MOTOR_BIT_1, MOTOR_BIT_1},
+};
+
+static inline uint16_t DevDshot_Prepare_Packet(const uint16_t value, bool telemetry)
+{
+    uint16_t packet = (value << 1) | (telemetry ? 1 : 0);
+
+    /* xor of the three data nibble */
+    packet = (packet << 4) | ((packet ^ (packet >> 4) ^ (packet >> 8)) & 0xF);
+
+    return packet;
+}
+
+/* bidirectional frame carry the inverted checksum, esc answer erpm on every frame */
+static inline uint16_t DevDshot_Prepare_Bidir_Packet(const uint16_t value)
+{
+    uint16_t packet = value << 1;
+
+    packet = (packet << 4) | (~(packet ^ (packet >> 4) ^ (packet >> 8)) & 0xF);
+
+    return packet;
+}
+
+/*
+ * expand one packet into buf[bit * stride], stride is the word count between two bit of the same moto
+ * single channel buffer use stride 1, timer burst buffer use the burst length
+ * the two trailing reset slot are zero
+ */
+static inline void DevDshot_Expand_Packet(uint32_t *buf, uint8_t stride, uint16_t packet)
+{
+    const uint32_t *bit = NULL;
+
+    for (uint8_t nibble = 0; nibble < (DSHOT_FRAME_SIZE / 4); nibble++)
+    {
+        bit = DevDshot_Nibble_LUT[(packet >> (12 - nibble * 4)) & 0xF];
+
+        buf[0] = bit[0];
+        buf[stride] = bit[1];
+        buf[stride * 2] = bit[2];
+        buf[stride * 3] = bit[3];
+        buf += stride * 4;
+    }
+
+    buf[0] = 0;
+    buf[stride] = 0;
+}
+
+/* 5 bit gcr symbol to nibble, invalid symbol decode as 0 and fail on checksum */
+static const uint8_t DevDshot_GCR_Decode_LUT[32] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 9, 10, 11, 0, 13, 14, 15,
+    0, 0, 2, 3, 0, 5, 6, 7, 0, 0, 8, 1, 0, 4, 12, 0,
+};
+
+/*
+ * rebuild the gcr word from capture timestamp of every edge
+ * each edge is a '1' followed by (run length - 1) '0', the run after the last edge fill up to 21 bit
+ */
+static inline bool DevDshot_Decode_Edge(const uint32_t *edge, uint8_t edge_num, uint32_t bit_tick, uint32_t *gcr)
+{
+    uint32_t value = 0;
+    uint32_t diff = 0;
+    uint8_t bits = 0;
+    uint8_t len = 0;
+
+    if ((edge == NULL) || (gcr == NULL) || (edge_num < 2) || (bit_tick == 0))
+        return false;
+
+    for (uint8_t i = 1; i <= edge_num; i++)
+    {
+        if (i < edge_num)
+        {
+            if (bits >= DSHOT_GCR_BIT_NUM)
+                break;
+
+            diff = (edge[i] - edge[i - 1]) & DSHOT_TELEMETRY_EDGE_MASK;
+            len = (diff + bit_tick / 2) / bit_tick;
+        }
+        else
+            len = DSHOT_GCR_BIT_NUM - bits;
+
+        if ((len == 0) || ((bits + len) > DSHOT_GCR_BIT_NUM))
+            return false;
+
+        value <<= len;
+        value |= 1 << (len - 1);
+        bits += len;
+    }
+
+    if (bits != DSHOT_GCR_BIT_NUM)
+        return false;
+
+    *gcr = value;
+    return true;
+}
+
+/*
+ * gcr word to erpm
+ * 16 bit payload: eee mmmmmmmmm cccc, period = m << e in us, checksum xor of all nibble equal 0xF
+ * period 0xFFF stand for a stopped moto
+ */
+static inline bool DevDshot_Decode_eRPM(uint32_t gcr, uint32_t *erpm)
+{
+    uint32_t value = 0;
+    uint32_t csum = 0;
+    uint32_t period_us = 0;
+
+    if (erpm == NULL)
+        return false;
+
+    value = DevDshot_GCR_Decode_LUT[gcr & 0x1F];
+    value |= DevDshot_GCR_Decode_LUT[(gcr >> 5) & 0x1F] << 4;
+    value |= DevDshot_GCR_Decode_LUT[(gcr >> 10) & 0x1F] << 8;
+    value |= DevDshot_GCR_Decode_LUT[(gcr >> 15) & 0x1F] << 12;
+
+    csum = value ^ (value >> 8);
+    csum ^= csum >> 4;
+
+    if ((csum & 0xF) != 0xF)
+        return false;
+
+    value >>= 4;
+
+    if (value == 0x0FFF)
+    {
+        *erpm = 0;
+        return true;
+    }
+
+    period_us = (value & 0x1FF) << (value >> 9);
+    if (period_us == 0)
+        return false;
+
+    /* one electrical revolution per period */
+    *erpm = (60000000 + period_us / 2) / period_us;
+    return true;
+}
+
+#endif
@@ -7,9 +7,13 @@ static DevW25Qxx_ProdType_List DevW25Qxx_Get_ProdType(DevW25QxxObj_TypeDef *dev,
 static DevW25Qxx_Error_List DevW25Qxx_Init(DevW25QxxObj_TypeDef *dev);
 static DevW25Qxx_Error_List DevW25Qxx_Reset(DevW25QxxObj_TypeDef *dev);
 static DevW25Qxx_Error_List DevW25Qxx_Write(DevW25QxxObj_TypeDef *dev, uint32_t WriteAddr, uint8_t *pData, uint32_t Size);
-static DevW25Qxx_Error_List DevW25Qxx_Read(DevW25QxxObj_TypeDef *dev, uint32_t ReadAddr, uint32_t *pData, uint32_t Size);
+static DevW25Qxx_Error_List DevW25Qxx_Read(DevW25QxxObj_TypeDef *dev, uint32_t ReadAddr, uint8_t *pData, uint32_t Size);
 static DevW25Qxx_Error_List DevW25Qxx_EraseSector(DevW25QxxObj_TypeDef *dev, uint32_t Address);
 static DevW25Qxx_Error_List DevW25Qxx_EraseChip(DevW25QxxObj_TypeDef *dev);
+static DevW25Qxx_Error_List DevW25Qxx_Set_ReadMode(DevW25QxxObj_TypeDef *dev, DevW25Qxx_ReadMode_List mode);
+static DevW25Qxx_Error_List DevW25Qxx_WritePage_NoWait(DevW25QxxObj_TypeDef *dev, uint32_t WriteAddr, uint8_t *pData, uint32_t Size);
+static DevW25Qxx_Error_List DevW25Qxx_EraseSector_NoWait(DevW25QxxObj_TypeDef *dev, uint32_t Address);
+static DevW25Qxx_Error_List DevW25Qxx_Busy_Check(DevW25QxxObj_TypeDef *dev);
 static DevW25Qxx_DeviceInfo_TypeDef DevW25Qxx_Get_Info(DevW25QxxObj_TypeDef *dev);
 static uint32_t DevW25Qxx_Get_Section_StartAddr(DevW25QxxObj_TypeDef *dev, uint32_t addr);
 
@@ -20,6 +24,10 @@ DevW25Qxx_TypeDef DevW25Qxx = {
     .read = DevW25Qxx_Read,
     .erase_sector = DevW25Qxx_EraseSector,
     .erase_chip = DevW25Qxx_EraseChip,
+    .set_read_mode = DevW25Qxx_Set_ReadMode,
+    .write_page_nowait = DevW25Qxx_WritePage_NoWait,
+    .erase_sector_nowait = DevW25Qxx_EraseSector_NoWait,
+    .busy = DevW25Qxx_Busy_Check,
     .info = DevW25Qxx_Get_Info,
     .get_section_start_addr = DevW25Qxx_Get_Section_StartAddr,
 };
@@ -60,6 +68,18 @@ static bool DevW25Qxx_BusTrans_Receive(DevW25QxxObj_TypeDef *dev, uint8_t *tx, u
     return false;
 }
 
+static bool DevW25Qxx_BusReceive_Multi(DevW25QxxObj_TypeDef *dev, uint8_t *rx, uint16_t size, uint8_t line)
+{
+    if ((dev == NULL) || \
+        (dev->bus_rx_multi == NULL))
+        return false;
+
+    if (dev->bus_rx_multi(rx, size, line, W25Qx_TIMEOUT_VALUE))
+        return true;
+
+    return false;
+}
+
 static DevW25Qxx_Error_List DevW25Qxx_Reset(DevW25QxxObj_TypeDef *dev)
 {
     uint8_t cmd[2] = {RESET_ENABLE_CMD, RESET_MEMORY_CMD};
@@ -102,33 +122,57 @@ static DevW25Qxx_Error_List DevW25Qxx_GetStatue(DevW25QxxObj_TypeDef *dev)
     return DevW25Qxx_Ok;
 }
 
+/* 
+ * poll status register until chip idle
+ * when yield is set and delay callback available, give up cpu between each poll
+ * erase take tens of ms, spin on it will starve other task
+ */
+static DevW25Qxx_Error_List DevW25Qxx_WaitIdle(DevW25QxxObj_TypeDef *dev, uint32_t time_out, bool yield)
+{
+    DevW25Qxx_Error_List state = DevW25Qxx_Ok;
+    uint32_t tickstart = 0;
+
+    if ((dev == NULL) || (dev->systick == NULL))
+        return DevW25Qxx_Error;
+
+    tickstart = dev->systick();
+
+    while ((state = DevW25Qxx_GetStatue(dev)) == DevW25Qxx_Busy)
+    {
+        /* Check for the Timeout */
+        if ((dev->systick() - tickstart) > time_out)
+            return DevW25Qxx_TimeOut;
+
+        if (yield && dev->delay)
+            dev->delay(1);
+    }
+
+    if (state == DevW25Qxx_Ok)
+        dev->in_progress = false;
+
+    return state;
+}
+
 static DevW25Qxx_Error_List DevW25Qxx_WriteEnable(DevW25QxxObj_TypeDef *dev)
 {
     uint8_t cmd = WRITE_ENABLE_CMD;
-    uint32_t tickstart = 0;
     bool trans_state = false;
 
     if ((dev == NULL) || (dev->cs_ctl == NULL) || (dev->systick == NULL))
         return DevW25Qxx_Error;
 
-    /* Send the read ID command */
+    /* write enable is ignored while chip busy, wait last none blocking program / erase done */
+    if (DevW25Qxx_WaitIdle(dev, W25Qx_TIMEOUT_VALUE, dev->in_progress) != DevW25Qxx_Ok)
+        return DevW25Qxx_TimeOut;
+
+    /* Send the write enable command */
     dev->cs_ctl(true);
     trans_state = DevW25Qxx_BusTrans(dev, &cmd, sizeof(cmd));
     dev->cs_ctl(false);
 
-    tickstart = dev->systick();
-
     if (!trans_state)
         return DevW25Qxx_Error;
 
-    /* Wait the end of Flash writing */
-    while (DevW25Qxx_GetStatue(dev) == DevW25Qxx_Busy)
-    {
-        /* Check for the Timeout */
-        if ((dev->systick() - tickstart) > W25Qx_TIMEOUT_VALUE)
-            return DevW25Qxx_TimeOut;
-    }
-
     return DevW25Qxx_Ok;
 }
 
@@ -199,22 +243,64 @@ static DevW25Qxx_ProdType_List DevW25Qxx_Get_ProdType(DevW25QxxObj_TypeDef *dev,
     }
 }
 
-static DevW25Qxx_Error_List DevW25Qxx_Read(DevW25QxxObj_TypeDef *dev, uint32_t ReadAddr, uint32_t *pData, uint32_t Size)
+static DevW25Qxx_Error_List DevW25Qxx_Read(DevW25QxxObj_TypeDef *dev, uint32_t ReadAddr, uint8_t *pData, uint32_t Size)
 {
-    uint8_t cmd[4];
+    uint8_t cmd[4 + W25QXX_FAST_READ_DUMMY_BYTE];
+    uint8_t cmd_len = 4;
+    uint8_t line = 1;
     bool read_state = false;
 
+    if ((dev == NULL) || (dev->cs_ctl == NULL) || (pData == NULL) || (Size == 0))
+        return DevW25Qxx_Error; 
+
+    /* array can not be read while none blocking program / erase is still on going */
+    if (dev->in_progress && (DevW25Qxx_WaitIdle(dev, W25Q128FV_SECTOR_ERASE_MAX_TIME, true) != DevW25Qxx_Ok))
+        return DevW25Qxx_Busy;
+
     /* Configure the command */
-    cmd[0] = READ_CMD;
+    switch ((uint8_t)dev->read_mode)
+    {
+        case DevW25Qxx_Read_DualOut:
+            cmd[0] = DUAL_OUT_FAST_READ_CMD;
+            line = 2;
+            break;
+
+        case DevW25Qxx_Read_QuadOut:
+            cmd[0] = QUAD_OUT_FAST_READ_CMD;
+            line = 4;
+            break;
+
+        case DevW25Qxx_Read_Fast:
+            cmd[0] = FAST_READ_CMD;
+            break;
+
+        default:
+            cmd[0] = READ_CMD;
+            break;
+    }
+
     cmd[1] = (uint8_t)(ReadAddr >> 16);
     cmd[2] = (uint8_t)(ReadAddr >> 8);
     cmd[3] = (uint8_t)(ReadAddr);
 
-    if ((dev == NULL) || (dev->cs_ctl == NULL) || (pData == NULL) || (Size == 0))
-        return DevW25Qxx_Error; 
+    /* fast read family clock out 8 dummy cycle after address */
+    if (cmd[0] != READ_CMD)
+    {
+        memset(&cmd[4], 0, W25QXX_FAST_READ_DUMMY_BYTE);
+        cmd_len += W25QXX_FAST_READ_DUMMY_BYTE;
+    }
 
     dev->cs_ctl(true);
-    read_state = DevW25Qxx_BusTrans(dev, cmd, sizeof(cmd)) & DevW25Qxx_BusReceive(dev, pData, Size);
+    read_state = DevW25Qxx_BusTrans(dev, cmd, cmd_len);
+    if (read_state)
+    {
+        if (line > 1)
+        {
+            read_state = DevW25Qxx_BusReceive_Multi(dev, pData, Size, line);
+        }
+        else
+            read_state = DevW25Qxx_BusReceive(dev, pData, Size);
+    }
     dev->cs_ctl(false);
 
     if (read_state)
@@ -223,24 +309,101 @@ static DevW25Qxx_Error_List DevW25Qxx_Read(DevW25QxxObj_TypeDef *dev, uint32_t R
     return DevW25Qxx_Error; 
 }
 
-static DevW25Qxx_Error_List DevW25Qxx_Write(DevW25QxxObj_TypeDef *dev, uint32_t WriteAddr, uint8_t *pData, uint32_t Size)
+static DevW25Qxx_Error_List DevW25Qxx_Set_QuadEnable(DevW25QxxObj_TypeDef *dev)
+{
+    uint8_t cmd[2] = {READ_STATUS_REG2_CMD, 0};
+    uint8_t reg = 0;
+    bool state = false;
+
+    dev->cs_ctl(true);
+    state = DevW25Qxx_BusTrans(dev, cmd, 1) && DevW25Qxx_BusReceive(dev, &reg, sizeof(reg));
+    dev->cs_ctl(false);
+
+    if (!state)
+        return DevW25Qxx_Error;
+
+    if (reg & W25Q128FV_FSR_QE)
+        return DevW25Qxx_Ok;
+
+    if (DevW25Qxx_WriteEnable(dev) != DevW25Qxx_Ok)
+        return DevW25Qxx_Error;
+
+    cmd[0] = WRITE_STATUS_REG2_CMD;
+    cmd[1] = reg | W25Q128FV_FSR_QE;
+
+    dev->cs_ctl(true);
+    state = DevW25Qxx_BusTrans(dev, cmd, sizeof(cmd));
+    dev->cs_ctl(false);
+
+    if (!state)
+        return DevW25Qxx_Error;
+
+    /* status register write cycle time max 15ms */
+    return DevW25Qxx_WaitIdle(dev, W25Q128FV_SUBSECTOR_ERASE_MAX_TIME, false);
+}
+
+static DevW25Qxx_Error_List DevW25Qxx_Set_ReadMode(DevW25QxxObj_TypeDef *dev, DevW25Qxx_ReadMode_List mode)
+{
+    if ((dev == NULL) || (dev->cs_ctl == NULL) || (dev->init_state != DevW25Qxx_Ok))
+        return DevW25Qxx_Error;
+
+    switch ((uint8_t)mode)
+    {
+        case DevW25Qxx_Read_Normal:
+        case DevW25Qxx_Read_Fast:
+            break;
+
+        /* multi line read only available when bus is able to sample on io1 ~ io3 */
+        case DevW25Qxx_Read_DualOut:
+            if (dev->bus_rx_multi == NULL)
+                return DevW25Qxx_Error;
+            break;
+
+        case DevW25Qxx_Read_QuadOut:
+            if ((dev->bus_rx_multi == NULL) || (DevW25Qxx_Set_QuadEnable(dev) != DevW25Qxx_Ok))
+                return DevW25Qxx_Error;
+            break;
+
+        default:
+            return DevW25Qxx_Error;
+    }
+
+    dev->read_mode = mode;
+    return DevW25Qxx_Ok;
+}
+
+static bool DevW25Qxx_PageProgram(DevW25QxxObj_TypeDef *dev, uint32_t addr, uint8_t *p_data, uint32_t size)
 {
     uint8_t cmd[4];
-    uint32_t end_addr, current_size, current_addr;
-    uint32_t tickstart = 0;
     bool write_state = false;
 
+    /* Configure the command */
+    cmd[0] = PAGE_PROG_CMD;
+    cmd[1] = (uint8_t)(addr >> 16);
+    cmd[2] = (uint8_t)(addr >> 8);
+    cmd[3] = (uint8_t)(addr);
+
+    /* Enable write operations */
+    if (DevW25Qxx_WriteEnable(dev) != DevW25Qxx_Ok)
+        return false;
+
+    /* Send the command Transmission of the data */
+    dev->cs_ctl(true);
+    write_state = DevW25Qxx_BusTrans(dev, cmd, sizeof(cmd)) && DevW25Qxx_BusTrans(dev, p_data, size);
+    dev->cs_ctl(false);
+
+    return write_state;
+}
+
+static DevW25Qxx_Error_List DevW25Qxx_Write(DevW25QxxObj_TypeDef *dev, uint32_t WriteAddr, uint8_t *pData, uint32_t Size)
+{
+    uint32_t end_addr, current_size, current_addr;
+
     if ((dev == NULL) || (dev->cs_ctl == NULL) || (dev->systick == NULL) || (pData == NULL) || (Size == 0))
         return DevW25Qxx_Error;
 
     /* Calculation of the size between the write address and the end of the page */
-    current_addr = 0;
-
-    while (current_addr <= WriteAddr)
-    {
-        current_addr += W25Q128FV_PAGE_SIZE;
-    }
-    current_size = current_addr - WriteAddr;
+    current_size = W25QXX_PAGE_REMAIN(WriteAddr);
 
     /* Check if the size of the data is less than the remaining place in the page */
     if (current_size > Size)
@@ -252,56 +415,52 @@ static DevW25Qxx_Error_List DevW25Qxx_Write(DevW25QxxObj_TypeDef *dev, uint32_t
     current_addr = WriteAddr;
     end_addr = WriteAddr + Size;
 
-    tickstart = dev->systick();
-
     /* Perform the write page by page */
     do
     {
-        /* Configure the command */
-        cmd[0] = PAGE_PROG_CMD;
-        cmd[1] = (uint8_t)(current_addr >> 16);
-        cmd[2] = (uint8_t)(current_addr >> 8);
-        cmd[3] = (uint8_t)(current_addr);
-
-        /* Enable write operations */
-        if (DevW25Qxx_WriteEnable(dev) != DevW25Qxx_Ok)
+        if (!DevW25Qxx_PageProgram(dev, current_addr, pData, current_size))
             return DevW25Qxx_Error;
 
-        /* Send the command Transmission of the data */
-        dev->cs_ctl(true);
-        write_state = DevW25Qxx_BusTrans(dev, cmd, sizeof(cmd)) & DevW25Qxx_BusTrans(dev, pData, current_size);
-        dev->cs_ctl(false);
-
-        /* Wait the end of Flash writing */
-        while (DevW25Qxx_GetStatue(dev) == DevW25Qxx_Busy)
-        {
-            /* Check for the Timeout */
-            if ((dev->systick() - tickstart) > W25Qx_TIMEOUT_VALUE)
-            {
-                return DevW25Qxx_TimeOut;
-            }
-        }
+        /* Wait the end of Flash writing, page program typ 0.7ms spin on it */
+        if (DevW25Qxx_WaitIdle(dev, W25Qx_TIMEOUT_VALUE, false) != DevW25Qxx_Ok)
+            return DevW25Qxx_TimeOut;
 
         /* Update the address and size variables for next page programming */
         current_addr += current_size;
         pData += current_size;
-        current_size = ((current_addr + W25Q128FV_PAGE_SIZE) > end_addr) ? (end_addr - current_addr) : W25Q128FV_PAGE_SIZE;
+        current_size = ((current_addr + W25QXX_PAGE_SIZE) > end_addr) ? (end_addr - current_addr) : W25QXX_PAGE_SIZE;
     } while (current_addr < end_addr);
 
     return DevW25Qxx_Ok;
 }
 
+static DevW25Qxx_Error_List DevW25Qxx_WritePage_NoWait(DevW25QxxObj_TypeDef *dev, uint32_t WriteAddr, uint8_t *pData, uint32_t Size)
+{
+    if ((dev == NULL) || (dev->cs_ctl == NULL) || (dev->systick == NULL) || (pData == NULL) || (Size == 0))
+        return DevW25Qxx_Error;
+
+    /* single page only */
+    if (Size > W25QXX_PAGE_REMAIN(WriteAddr))
+        return DevW25Qxx_Error;
+
+    if (dev->in_progress && (DevW25Qxx_Busy_Check(dev) != DevW25Qxx_Ok))
+        return DevW25Qxx_Busy;
+
+    if (!DevW25Qxx_PageProgram(dev, WriteAddr, pData, Size))
+        return DevW25Qxx_Error;
+
+    dev->in_progress = true;
+    return DevW25Qxx_Ok;
+}
+
 static DevW25Qxx_Error_List DevW25Qxx_EraseChip(DevW25QxxObj_TypeDef *dev)
 {
     uint8_t cmd = CHIP_ERASE_CMD;
-    uint32_t tickstart = 0;
     bool erase_state = false;
 
     if ((dev == NULL) || (dev->cs_ctl == NULL) || (dev->systick == NULL))
         return DevW25Qxx_Error;
 
-    tickstart = dev->systick();
-
     if (DevW25Qxx_WriteEnable(dev) != DevW25Qxx_Ok)
         return DevW25Qxx_Error;
 
@@ -313,57 +472,67 @@ static DevW25Qxx_Error_List DevW25Qxx_EraseChip(DevW25QxxObj_TypeDef *dev)
         return DevW25Qxx_Error;
 
     /* Wait the end of Flash writing */
-    while (DevW25Qxx_GetStatue(dev) != DevW25Qxx_Busy)
-    {
-        /* Check for the Timeout */
-        if ((dev->systick() - tickstart) > W25Q128FV_BULK_ERASE_MAX_TIME)
-        {
-            return DevW25Qxx_TimeOut;
-        }
-    }
-
-    return DevW25Qxx_Ok;
+    return DevW25Qxx_WaitIdle(dev, W25Q128FV_BULK_ERASE_MAX_TIME, true);
 }
 
-static DevW25Qxx_Error_List DevW25Qxx_EraseSector(DevW25QxxObj_TypeDef *dev, uint32_t Address)
+static bool DevW25Qxx_SectorErase_Cmd(DevW25QxxObj_TypeDef *dev, uint32_t Address)
 {
     uint8_t cmd[4];
-    uint32_t tickstart = 0;
     bool erase_state = false;
+
     cmd[0] = SECTOR_ERASE_CMD;
     cmd[1] = (uint8_t)(Address >> 16);
     cmd[2] = (uint8_t)(Address >> 8);
     cmd[3] = (uint8_t)(Address);
 
-    if ((dev == NULL) || (dev->cs_ctl == NULL) || (dev->systick == NULL))
-        return DevW25Qxx_Error;
-
-    tickstart = dev->systick();
-
     /* Enable write operations Send the read ID command */
     if (DevW25Qxx_WriteEnable(dev) != DevW25Qxx_Ok)
-        return DevW25Qxx_Error;
+        return false;
 
     dev->cs_ctl(true);
     erase_state = DevW25Qxx_BusTrans(dev, cmd, sizeof(cmd));
     dev->cs_ctl(false);
 
-    if (!erase_state)
+    return erase_state;
+}
+
+static DevW25Qxx_Error_List DevW25Qxx_EraseSector(DevW25QxxObj_TypeDef *dev, uint32_t Address)
+{
+    if ((dev == NULL) || (dev->cs_ctl == NULL) || (dev->systick == NULL))
         return DevW25Qxx_Error;
 
-    /* Wait the end of Flash writing */
-    while (DevW25Qxx_GetStatue(dev) == DevW25Qxx_Busy)
-    {
-        /* Check for the Timeout */
-        if ((dev->systick() - tickstart) > W25Q128FV_SECTOR_ERASE_MAX_TIME)
-        {
-            return DevW25Qxx_TimeOut;
-        }
-    }
+    if (!DevW25Qxx_SectorErase_Cmd(dev, Address))
+        return DevW25Qxx_Error;
+
+    /* Wait the end of Flash erasing, sector erase typ 45ms yield when we can */
+    return DevW25Qxx_WaitIdle(dev, W25Q128FV_SECTOR_ERASE_MAX_TIME, true);
+}
+
+static DevW25Qxx_Error_List DevW25Qxx_EraseSector_NoWait(DevW25QxxObj_TypeDef *dev, uint32_t Address)
+{
+    if ((dev == NULL) || (dev->cs_ctl == NULL) || (dev->systick == NULL))
+        return DevW25Qxx_Error;
+
+    if (dev->in_progress && (DevW25Qxx_Busy_Check(dev) != DevW25Qxx_Ok))
+        return DevW25Qxx_Busy;
+
+    if (!DevW25Qxx_SectorErase_Cmd(dev, Address))
+        return DevW25Qxx_Error;
 
+    dev->in_progress = true;
     return DevW25Qxx_Ok;
 }
 
+static DevW25Qxx_Error_List DevW25Qxx_Busy_Check(DevW25QxxObj_TypeDef *dev)
+{
+    DevW25Qxx_Error_List state = DevW25Qxx_GetStatue(dev);
+
+    if ((state == DevW25Qxx_Ok) && dev)
+        dev->in_progress = false;
+
+    return state;
+}
+
 static DevW25Qxx_DeviceInfo_TypeDef DevW25Qxx_Get_Info(DevW25QxxObj_TypeDef *dev)
 {
     DevW25Qxx_DeviceInfo_TypeDef info;
@@ -37,6 +37,11 @@
 #define W25Q128FV_DUMMY_CYCLES_READ             4
 #define W25Q128FV_DUMMY_CYCLES_READ_QUAD        10
 
+/* fast read (0x0B) and dual/quad output read (0x3B/0x6B) need 8 dummy clock after address */
+#define W25QXX_FAST_READ_DUMMY_BYTE             1
+#define W25QXX_PAGE_OFFSET(x)                   ((x) & (W25QXX_PAGE_SIZE - 1))
+#define W25QXX_PAGE_REMAIN(x)                   (W25QXX_PAGE_SIZE - W25QXX_PAGE_OFFSET(x))
+
 #define W25Q128FV_BULK_ERASE_MAX_TIME           250000
 #define W25Q128FV_SECTOR_ERASE_MAX_TIME         3000
 #define W25Q128FV_SUBSECTOR_ERASE_MAX_TIME      800
@@ -97,6 +102,7 @@
 
 typedef bool (*cs_pin_ctl)(bool state);
 typedef uint32_t (*get_systick)(void);
+typedef int32_t (*sys_delay)(uint32_t ms);
 
 typedef BspSPI_PinConfig_TypeDef DevW25QxxPin_Config_TypeDef;
 
@@ -118,6 +124,14 @@ typedef enum
     DevW25Qxx_TimeOut,
 } DevW25Qxx_Error_List;
 
+typedef enum
+{
+    DevW25Qxx_Read_Normal = 0,  /* 0x03 max 50MHz */
+    DevW25Qxx_Read_Fast,        /* 0x0B */
+    DevW25Qxx_Read_DualOut,     /* 0x3B only when bus can receive on 2 line */
+    DevW25Qxx_Read_QuadOut,     /* 0x6B only when bus can receive on 4 line */
+} DevW25Qxx_ReadMode_List;
+
 typedef struct
 {
     DevW25Qxx_ProdType_List prod_type;
@@ -143,10 +157,18 @@ typedef struct
     uint16_t (*bus_tx)(uint8_t *p_data, uint16_t len, uint32_t time_out);
     uint16_t (*bus_rx)(uint8_t *p_data, uint16_t len, uint32_t time_out);
     uint16_t (*bus_trans)(uint8_t *tx_data, uint8_t *rx_data, uint16_t len, uint32_t time_out);
+    /* optional, receive data on multiple data line (2 or 4) for dual / quad output read */
+    uint16_t (*bus_rx_multi)(uint8_t *p_data, uint16_t len, uint8_t line, uint32_t time_out);
     bool (*cs_ctl)(bool state);
 
     DevW25Qxx_Error_List init_state;
+    DevW25Qxx_ReadMode_List read_mode;
     get_systick systick;
+    /* optional, when set long busy wait give up cpu to other task */
+    sys_delay delay;
+
+    /* set by none blocking program / erase, cleared once status register shows idle */
+    bool in_progress;
 } DevW25QxxObj_TypeDef;
 
 typedef struct
@@ -158,6 +180,12 @@ typedef struct
     DevW25Qxx_Error_List (*read)(DevW25QxxObj_TypeDef *dev, uint32_t addr, uint8_t *rx, uint32_t size);
     DevW25Qxx_Error_List (*erase_sector)(DevW25QxxObj_TypeDef *dev, uint32_t addr);
     DevW25Qxx_Error_List (*erase_chip)(DevW25QxxObj_TypeDef *dev);
+    DevW25Qxx_Error_List (*set_read_mode)(DevW25QxxObj_TypeDef *dev, DevW25Qxx_ReadMode_List mode);
+
+    /* none blocking section, return right after command issued. use busy to poll */
+    DevW25Qxx_Error_List (*write_page_nowait)(DevW25QxxObj_TypeDef *dev, uint32_t addr, uint8_t *tx, uint32_t size);
+    DevW25Qxx_Error_List (*erase_sector_nowait)(DevW25QxxObj_TypeDef *dev, uint32_t addr);
+    DevW25Qxx_Error_List (*busy)(DevW25QxxObj_TypeDef *dev);
     DevW25Qxx_DeviceInfo_TypeDef (*info)(DevW25QxxObj_TypeDef *dev);
     uint32_t (*get_section_start_addr)(DevW25QxxObj_TypeDef *dev, uint32_t addr);
 } DevW25Qxx_TypeDef;
@@ -18,6 +18,7 @@
 #define SD_CARD_ENABLE_STATE ON
 #define FLASH_CHIP_ENABLE_STATE OFF
 #define RADIO_NUM 1
+#define DSHOT_BIDIR_ENABLE_STATE OFF    /* ON only when every esc run a bidirectional dshot firmware */
 
 #elif defined BATEAT32F435_AIO
 
@@ -27,6 +28,7 @@
 #define SD_CARD_ENABLE_STATE OFF
 #define FLASH_CHIP_ENABLE_STATE ON
 #define RADIO_NUM 1
+#define DSHOT_BIDIR_ENABLE_STATE OFF
 
 #endif
 
@@ -40,5 +42,6 @@
 #define SD_CARD SD_CARD_ENABLE_STATE
 #define FLASH_CHIP_STATE FLASH_CHIP_ENABLE_STATE
 #define RADIO_UART_NUM RADIO_NUM
+#define DSHOT_BIDIR DSHOT_BIDIR_ENABLE_STATE
 
 #endif
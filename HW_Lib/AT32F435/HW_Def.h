@@ -143,6 +143,13 @@
 #define ExternalFlash_SysDataSec_Size (64 Kb)
 #define ExternalFlash_UserDataSec_Size (64 Kb)
 
+/* one subsector between parameter section and blackbox, free to destroy by flash test */
+#define ExtFlash_Scratch_Addr (ExtFlash_Start_Addr + ExtFlash_Storage_TotalSize)
+#define ExtFlash_Scratch_Size (4 Kb)
+
+/* blackbox log use the rest of the chip behind scratch subsector */
+#define ExtFlash_Blackbox_Addr (ExtFlash_Scratch_Addr + ExtFlash_Scratch_Size)
+
 extern BspGPIO_Obj_TypeDef ExtFlash_CSPin;
 extern BspSPI_PinConfig_TypeDef ExtFlash_SPIPin;
 #endif
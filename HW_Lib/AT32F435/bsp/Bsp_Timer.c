@@ -14,6 +14,21 @@ static void BspTimer_SetPreScale(BspTimerPWMObj_TypeDef *obj, uint32_t prescale)
 static void BspTimer_SetAutoReload(BspTimerPWMObj_TypeDef *obj, uint32_t auto_reload);
 static void BspTimer_PWM_Start(BspTimerPWMObj_TypeDef *obj);
 static void BspTimer_DMA_Start(BspTimerPWMObj_TypeDef *obj);
+static bool BspTimer_Set_Bidir(BspTimerPWMObj_TypeDef *obj, uint32_t capture_addr, uint32_t capture_size);
+static uint32_t BspTimer_Get_Capture(BspTimerPWMObj_TypeDef *obj);
+static bool BspTimer_Burst_Init(BspTimerBurstObj_TypeDef *obj,
+                                void *instance,
+                                const uint32_t *ch,
+                                const BspGPIO_Obj_TypeDef *pin,
+                                uint8_t ch_num,
+                                uint8_t dma,
+                                uint8_t stream,
+                                uint32_t buf_addr,
+                                uint32_t frame_size);
+static void BspTimer_Burst_SetPreScale(BspTimerBurstObj_TypeDef *obj, uint32_t prescale);
+static void BspTimer_Burst_SetAutoReload(BspTimerBurstObj_TypeDef *obj, uint32_t auto_reload);
+static void BspTimer_Burst_PWM_Start(BspTimerBurstObj_TypeDef *obj);
+static void BspTimer_Burst_DMA_Start(BspTimerBurstObj_TypeDef *obj);
 
 BspTimerPWM_TypeDef BspTimer_PWM = {
     .init = BspTimer_PWM_Init,
@@ -21,6 +36,16 @@ BspTimerPWM_TypeDef BspTimer_PWM = {
     .set_autoreload = BspTimer_SetAutoReload,
     .start_pwm = BspTimer_PWM_Start,
     .dma_trans = BspTimer_DMA_Start,
+    .set_bidir = BspTimer_Set_Bidir,
+    .get_capture = BspTimer_Get_Capture,
+};
+
+BspTimerBurst_TypeDef BspTimer_Burst = {
+    .init = BspTimer_Burst_Init,
+    .set_prescaler = BspTimer_Burst_SetPreScale,
+    .set_autoreload = BspTimer_Burst_SetAutoReload,
+    .start_pwm = BspTimer_Burst_PWM_Start,
+    .dma_trans = BspTimer_Burst_DMA_Start,
 };
 
 static bool BspTimer_PWM_Init(BspTimerPWMObj_TypeDef *obj,
@@ -55,3 +80,45 @@ static void BspTimer_DMA_Start(BspTimerPWMObj_TypeDef *obj)
     
 }
 
+static bool BspTimer_Set_Bidir(BspTimerPWMObj_TypeDef *obj, uint32_t capture_addr, uint32_t capture_size)
+{
+    return false;
+}
+
+static uint32_t BspTimer_Get_Capture(BspTimerPWMObj_TypeDef *obj)
+{
+    return 0;
+}
+
+static bool BspTimer_Burst_Init(BspTimerBurstObj_TypeDef *obj,
+                                void *instance,
+                                const uint32_t *ch,
+                                const BspGPIO_Obj_TypeDef *pin,
+                                uint8_t ch_num,
+                                uint8_t dma,
+                                uint8_t stream,
+                                uint32_t buf_addr,
+                                uint32_t frame_size)
+{
+    return false;
+}
+
+static void BspTimer_Burst_SetPreScale(BspTimerBurstObj_TypeDef *obj, uint32_t prescale)
+{
+
+}
+
+static void BspTimer_Burst_SetAutoReload(BspTimerBurstObj_TypeDef *obj, uint32_t auto_reload)
+{
+
+}
+
+static void BspTimer_Burst_PWM_Start(BspTimerBurstObj_TypeDef *obj)
+{
+
+}
+
+static void BspTimer_Burst_DMA_Start(BspTimerBurstObj_TypeDef *obj)
+{
+
+}
\ No newline at end of file
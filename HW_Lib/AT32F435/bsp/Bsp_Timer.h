@@ -9,5 +9,6 @@
 bool BspTimer_SysTick_Init(void);
 
 extern BspTimerPWM_TypeDef BspTimer_PWM;
+extern BspTimerBurst_TypeDef BspTimer_Burst;
 
 #endif
@@ -32,6 +32,7 @@
 #include "Bsp_Uart.h"
 #include "Bsp_USB.h"
 #include "Bsp_Timer.h"
+#include "profiler.h"
 #include "FreeRTOS.h"
 #include "task.h"
 
@@ -124,176 +125,219 @@ void DebugMon_Handler(void)
 
 void EXINT0_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Exti);
   BspGPIO_IRQ_Polling(EXINT_LINE_0);
+  Profiler.isr_exit(Profiler_Isr_Exti);
 }
 
 void EXINT1_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Exti);
   BspGPIO_IRQ_Polling(EXINT_LINE_1);
+  Profiler.isr_exit(Profiler_Isr_Exti);
 }
 
 void EXINT2_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Exti);
   BspGPIO_IRQ_Polling(EXINT_LINE_2);
+  Profiler.isr_exit(Profiler_Isr_Exti);
 }
 
 void EXINT3_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Exti);
   BspGPIO_IRQ_Polling(EXINT_LINE_3);
+  Profiler.isr_exit(Profiler_Isr_Exti);
 }
 
 void EXINT4_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Exti);
   BspGPIO_IRQ_Polling(EXINT_LINE_4);
+  Profiler.isr_exit(Profiler_Isr_Exti);
 }
 
 void EXINT9_5_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Exti);
   BspGPIO_IRQ_Polling(EXINT_LINE_5);
   BspGPIO_IRQ_Polling(EXINT_LINE_6);
   BspGPIO_IRQ_Polling(EXINT_LINE_7);
   BspGPIO_IRQ_Polling(EXINT_LINE_8);
   BspGPIO_IRQ_Polling(EXINT_LINE_9);
+  Profiler.isr_exit(Profiler_Isr_Exti);
 }
 
 void EXINT15_10_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Exti);
   BspGPIO_IRQ_Polling(EXINT_LINE_10);
   BspGPIO_IRQ_Polling(EXINT_LINE_11);
   BspGPIO_IRQ_Polling(EXINT_LINE_12);
   BspGPIO_IRQ_Polling(EXINT_LINE_13);
   BspGPIO_IRQ_Polling(EXINT_LINE_14);
   BspGPIO_IRQ_Polling(EXINT_LINE_15);
+  Profiler.isr_exit(Profiler_Isr_Exti);
 }
 
 void DMA1_Channel1_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_DMA);
   if(dma_flag_get(DMA1_FDT1_FLAG))
   {
     BspDMA_Irq_Callback((void *)DMA1_CHANNEL1);
     dma_flag_clear(DMA1_FDT1_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA1_Channel2_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_DMA);
   if(dma_flag_get(DMA1_FDT2_FLAG))
   {
     BspDMA_Irq_Callback((void *)DMA1_CHANNEL2);
     dma_flag_clear(DMA1_FDT2_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA1_Channel3_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_DMA);
   if(dma_flag_get(DMA1_FDT3_FLAG))
   {
     BspDMA_Irq_Callback((void *)DMA1_CHANNEL3);
     dma_flag_clear(DMA1_FDT3_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA1_Channel4_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_DMA);
   if(dma_flag_get(DMA1_FDT4_FLAG))
   {
     BspDMA_Irq_Callback((void *)DMA1_CHANNEL4);
     dma_flag_clear(DMA1_FDT4_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA1_Channel5_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_DMA);
   if(dma_flag_get(DMA1_FDT5_FLAG))
   {
     BspDMA_Irq_Callback((void *)DMA1_CHANNEL5);
     dma_flag_clear(DMA1_FDT5_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA1_Channel6_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_DMA);
   if(dma_flag_get(DMA1_FDT6_FLAG))
   {
     BspDMA_Irq_Callback((void *)DMA1_CHANNEL6);
     dma_flag_clear(DMA1_FDT6_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA1_Channel7_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_DMA);
   if(dma_flag_get(DMA1_FDT7_FLAG))
   {
     BspDMA_Irq_Callback((void *)DMA1_CHANNEL7);
     dma_flag_clear(DMA1_FDT7_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA2_Channel1_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_DMA);
   if(dma_flag_get(DMA2_FDT1_FLAG) != RESET)
   {
     BspDMA_Irq_Callback((void *)DMA2_CHANNEL1);
     dma_flag_clear(DMA2_FDT1_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA2_Channel2_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_DMA);
   if(dma_flag_get(DMA2_FDT2_FLAG) != RESET)
   {
     BspDMA_Irq_Callback((void *)DMA2_CHANNEL2);
     dma_flag_clear(DMA2_FDT2_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA2_Channel3_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_DMA);
   if(dma_flag_get(DMA2_FDT3_FLAG) != RESET)
   {
     BspDMA_Irq_Callback((void *)DMA2_CHANNEL3);
     dma_flag_clear(DMA2_FDT3_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA2_Channel4_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_DMA);
   if(dma_flag_get(DMA2_FDT4_FLAG) != RESET)
   {
     BspDMA_Irq_Callback((void *)DMA2_CHANNEL4);
     dma_flag_clear(DMA2_FDT4_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA2_Channel5_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_DMA);
   if(dma_flag_get(DMA2_FDT5_FLAG) != RESET)
   {
     BspDMA_Irq_Callback((void *)DMA2_CHANNEL5);
     dma_flag_clear(DMA2_FDT5_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA2_Channel6_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_DMA);
     BspDMA_Irq_Callback((void *)DMA2_CHANNEL6);
   if(dma_flag_get(DMA2_FDT6_FLAG) != RESET)
   {
     dma_flag_clear(DMA2_FDT6_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA2_Channel7_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_DMA);
   if(dma_flag_get(DMA2_FDT7_FLAG) != RESET)
   {
     BspDMA_Pipe_Irq_Callback();
     dma_flag_clear(DMA2_FDT7_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void USART1_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Uart);
   if(usart_flag_get(USART1, USART_IDLEF_FLAG) != RESET)
   {
     BspUart_Irq_Callback(USART1);
@@ -304,10 +348,12 @@ void USART1_IRQHandler(void)
     BspUart_Irq_Callback(USART1);
     usart_flag_clear(USART1, USART_RDBF_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_Uart);
 }
 
 void USART2_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Uart);
   if(usart_flag_get(USART2, USART_IDLEF_FLAG) != RESET)
   {
     BspUart_Irq_Callback(USART2);
@@ -318,10 +364,12 @@ void USART2_IRQHandler(void)
     BspUart_Irq_Callback(USART2);
     usart_flag_clear(USART2, USART_RDBF_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_Uart);
 }
 
 void USART3_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Uart);
   if(usart_flag_get(USART3, USART_IDLEF_FLAG) != RESET)
   {
     BspUart_Irq_Callback(USART3);
@@ -332,10 +380,12 @@ void USART3_IRQHandler(void)
     BspUart_Irq_Callback(USART3);
     usart_flag_clear(USART3, USART_RDBF_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_Uart);
 }
 
 void UART4_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Uart);
   if(usart_flag_get(UART4, USART_IDLEF_FLAG) != RESET)
   {
     BspUart_Irq_Callback(UART4);
@@ -346,10 +396,12 @@ void UART4_IRQHandler(void)
     BspUart_Irq_Callback(UART4);
     usart_flag_clear(UART4, USART_RDBF_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_Uart);
 }
 
 void UART5_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Uart);
   if(usart_flag_get(UART5, USART_IDLEF_FLAG) != RESET)
   {
     BspUart_Irq_Callback(UART5);
@@ -360,10 +412,12 @@ void UART5_IRQHandler(void)
     BspUart_Irq_Callback(UART5);
     usart_flag_clear(UART5, USART_RDBF_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_Uart);
 }
 
 void USART6_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Uart);
   if(usart_flag_get(USART6, USART_IDLEF_FLAG) != RESET)
   {
     BspUart_Irq_Callback(USART6);
@@ -374,10 +428,12 @@ void USART6_IRQHandler(void)
     BspUart_Irq_Callback(USART6);
     usart_flag_clear(USART6, USART_RDBF_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_Uart);
 }
 
 void UART7_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Uart);
   if(usart_flag_get(UART7, USART_IDLEF_FLAG) != RESET)
   {
     BspUart_Irq_Callback(UART7);
@@ -388,10 +444,12 @@ void UART7_IRQHandler(void)
     BspUart_Irq_Callback(UART7);
     usart_flag_clear(UART7, USART_RDBF_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_Uart);
 }
 
 void UART8_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Uart);
   if(usart_flag_get(UART8, USART_IDLEF_FLAG) != RESET)
   {
     BspUart_Irq_Callback(UART8);
@@ -402,11 +460,14 @@ void UART8_IRQHandler(void)
     BspUart_Irq_Callback(UART8);
     usart_flag_clear(UART8, USART_RDBF_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_Uart);
 }
 
 void OTGFS1_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_USB);
   BspUSB_Irq_Callback();
+  Profiler.isr_exit(Profiler_Isr_USB);
 }
 
 /**
@@ -431,6 +492,7 @@ void SysTick_Handler(void)
 /* os timer */
 void TMR20_OVF_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Tick);
   if(tmr_flag_get(TMR20, TMR_OVF_FLAG) == SET)
   {
 #if (INCLUDE_xTaskGetSchedulerState == 1 )
@@ -447,6 +509,7 @@ void TMR20_OVF_IRQHandler(void)
 
     tmr_flag_clear(TMR20, TMR_OVF_FLAG);
   }
+  Profiler.isr_exit(Profiler_Isr_Tick);
 }
 
 /**
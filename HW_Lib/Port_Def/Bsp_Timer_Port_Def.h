@@ -32,8 +32,37 @@ typedef struct
 
     uint32_t buffer_addr;
     uint32_t buffer_size;
+    BspGPIO_Obj_TypeDef pin;
+
+    /* bidirectional output, channel turn into input capture of both edge once the output frame sent */
+    bool bidir;
+    uint32_t capture_addr;
+    uint32_t capture_size;
+    uint32_t capture_cnt;
 } BspTimerPWMObj_TypeDef;
 
+#define BSP_TIMER_BURST_MAX_CH 4
+
+/* compare channel of one timer updated together through DCR / DMAR by the update dma request */
+typedef struct
+{
+    void *instance;
+    uint8_t dma;
+    uint8_t stream;
+    void *dma_hdl;
+    void *tim_hdl;
+    uint32_t prescale;
+    uint32_t auto_reload;
+
+    uint8_t base_ch;                            /* lowest compare channel index in burst, 0 ~ 3 */
+    uint8_t burst_len;                          /* ccr num of one burst, from base_ch to the highest channel */
+    uint8_t ch_mask;                            /* bit n set when ccr (base_ch + n) in use */
+    uint8_t slot[BSP_TIMER_BURST_MAX_CH];       /* init channel list index to burst slot */
+
+    uint32_t buffer_addr;
+    uint32_t buffer_size;
+} BspTimerBurstObj_TypeDef;
+
 typedef struct
 {
     bool (*init)(BspTimerPWMObj_TypeDef *obj,
@@ -48,8 +77,27 @@ typedef struct
     void (*set_autoreload)(BspTimerPWMObj_TypeDef *obj, uint32_t autoreload);
     void (*start_pwm)(BspTimerPWMObj_TypeDef *obj);
     void (*dma_trans)(BspTimerPWMObj_TypeDef *obj);
+    bool (*set_bidir)(BspTimerPWMObj_TypeDef *obj, uint32_t capture_addr, uint32_t capture_size);
+    uint32_t (*get_capture)(BspTimerPWMObj_TypeDef *obj);
 } BspTimerPWM_TypeDef;
 
+typedef struct
+{
+    bool (*init)(BspTimerBurstObj_TypeDef *obj,
+                 void *instance,
+                 const uint32_t *ch,
+                 const BspGPIO_Obj_TypeDef *pin,
+                 uint8_t ch_num,
+                 uint8_t dma,
+                 uint8_t stream,
+                 uint32_t buf_addr,
+                 uint32_t frame_size);
+    void (*set_prescaler)(BspTimerBurstObj_TypeDef *obj, uint32_t prescale);
+    void (*set_autoreload)(BspTimerBurstObj_TypeDef *obj, uint32_t autoreload);
+    void (*start_pwm)(BspTimerBurstObj_TypeDef *obj);
+    void (*dma_trans)(BspTimerBurstObj_TypeDef *obj);
+} BspTimerBurst_TypeDef;
+
 typedef struct
 {
     bool (*init)(BspTimerTickObj_TypeDef *obj, uint32_t perscale, uint32_t period);
@@ -0,0 +1,128 @@
+#include "Bsp_DMA.h"
+#include "FreeRTOS.h"
+#include "profiler.h"
+
+/*
+ * host memory is coherent, stream transfer is done by the owner module stand in
+ * datapipe memory to memory copy finished at once and the finish callback run in isr context
+ */
+
+/* internal vriable */
+static DMA_HandleTypeDef *BspDMA_Map[Bsp_DMA_Sum][Bsp_DMA_Stream_Sum] = {NULL};
+static DMA_HandleTypeDef DataPipe_DMA;
+static bool DataPipe_DMA_Init = false;
+static BspDMA_Pipe_TransFin_Cb DataPipe_FinCallback = NULL;
+static BspDMA_Pipe_TransErr_Cb DataPipe_ErrCallback = NULL;
+
+/* external function */
+static bool BspDMA_Regist_Obj(int8_t dma, int8_t stream, void *hdl);
+static bool BspDMA_Unregist_Obj(int8_t dma, int8_t stream);
+static void *BspDMA_Get_Handle(int8_t dma, int8_t stream);
+static void *BspDMA_Get_Instance(int8_t dma, int8_t stream);
+static void BspDMA_EnableIRQ(int8_t dma, int8_t stream, uint32_t preempt, uint32_t sub, uint32_t mux_seq, void *cb);
+
+BspDMA_TypeDef BspDMA = {
+    .regist = BspDMA_Regist_Obj,
+    .unregist = BspDMA_Unregist_Obj,
+    .get_handle = BspDMA_Get_Handle,
+    .get_instance = BspDMA_Get_Instance,
+    .enable_irq = BspDMA_EnableIRQ,
+};
+
+static bool BspDMA_Pipe_Init(BspDMA_Pipe_TransFin_Cb fin_cb, BspDMA_Pipe_TransErr_Cb err_cb);
+static bool BspDMA_Pipe_Trans(uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength);
+static void* BspDMA_Get_Pipe_Handle(void);
+
+BspDMA_Pipe_TypeDef BspDMA_Pipe = {
+    .init = BspDMA_Pipe_Init,
+    .trans = BspDMA_Pipe_Trans,
+    .get_hanle = BspDMA_Get_Pipe_Handle,
+};
+
+static bool BspDMA_Check(int8_t dma, int8_t stream)
+{
+    return (dma >= Bsp_DMA_1) && (dma < Bsp_DMA_Sum) && (stream >= Bsp_DMA_Stream_0) && (stream < Bsp_DMA_Stream_Sum);
+}
+
+static void *BspDMA_Get_Instance(int8_t dma, int8_t stream)
+{
+    if (!BspDMA_Check(dma, stream))
+        return NULL;
+
+    return &BspDMA_Map[dma][stream];
+}
+
+static bool BspDMA_Regist_Obj(int8_t dma, int8_t stream, void *hdl)
+{
+    if (!BspDMA_Check(dma, stream) || (hdl == NULL))
+        return false;
+
+    BspDMA_Map[dma][stream] = hdl;
+    return true;
+}
+
+static bool BspDMA_Unregist_Obj(int8_t dma, int8_t stream)
+{
+    if (!BspDMA_Check(dma, stream))
+        return false;
+
+    BspDMA_Map[dma][stream] = NULL;
+    return true;
+}
+
+static void *BspDMA_Get_Handle(int8_t dma, int8_t stream)
+{
+    if (!BspDMA_Check(dma, stream))
+        return NULL;
+
+    return BspDMA_Map[dma][stream];
+}
+
+static void BspDMA_EnableIRQ(int8_t dma, int8_t stream, uint32_t preempt, uint32_t sub, uint32_t mux_seq, void *cb)
+{
+    (void)dma;
+    (void)stream;
+    (void)preempt;
+    (void)sub;
+    (void)mux_seq;
+    (void)cb;
+}
+
+static bool BspDMA_Pipe_Init(BspDMA_Pipe_TransFin_Cb fin_cb, BspDMA_Pipe_TransErr_Cb err_cb)
+{
+    if (fin_cb == NULL)
+        return false;
+
+    memset(&DataPipe_DMA, 0, sizeof(DataPipe_DMA));
+    DataPipe_FinCallback = fin_cb;
+    DataPipe_ErrCallback = err_cb;
+    DataPipe_DMA_Init = true;
+
+    return true;
+}
+
+static bool BspDMA_Pipe_Trans(uint32_t SrcAddress, uint32_t DstAddress, uint32_t DataLength)
+{
+    if (!DataPipe_DMA_Init || \
+        (SrcAddress == 0) || \
+        (DstAddress == 0) || \
+        (DataLength == 0))
+        return false;
+
+    memcpy((void *)(uintptr_t)DstAddress, (void *)(uintptr_t)SrcAddress, DataLength);
+    DataPipe_DMA.ErrorCode = HAL_DMA_ERROR_NONE;
+
+    SitlPort_Isr_Enter();
+
+    Profiler.isr_enter(Profiler_Isr_DMA);
+    DataPipe_FinCallback(&DataPipe_DMA);
+    Profiler.isr_exit(Profiler_Isr_DMA);
+    SitlPort_Isr_Exit();
+
+    return true;
+}
+
+static void* BspDMA_Get_Pipe_Handle(void)
+{
+    return &DataPipe_DMA;
+}
@@ -0,0 +1,104 @@
+/*
+ * host stand in of the on chip flash
+ * bank 1 is mapped on a ram image, erase take effect on whole 128 Kbytes sector same as the target
+ * content is lost once the process exit, each run start with a blank storage section
+ */
+#include "Bsp_Flash.h"
+
+#define BSP_FLASH_ADDR_ALIGN_SIZE 4
+#define BSP_FLASH_SECTOR_SIZE FLASH_SECTOR_0_SIZE
+
+/* internal variable */
+static uint8_t BspFlash_Image[FLASH_BANK_SIZE];
+static bool BspFlash_Image_Init = false;
+
+/* internal function */
+static bool BspFlash_Check_Range(uint32_t addr, uint32_t size);
+
+/* external function */
+static bool BspFlash_Init(void);
+static void BspFlash_DeInit(void);
+static bool BspFlash_Read_From_Addr(uint32_t addr, uint8_t *p_data, uint32_t size);
+static bool BspFlash_Write_To_Addr(uint32_t addr, uint8_t *p_data, uint32_t size);
+static bool BspFlash_Erase(uint32_t addr, uint32_t len);
+static uint8_t BspFlash_Get_AlignSize(void);
+
+BspFlash_TypeDef BspFlash = {
+    .init = BspFlash_Init,
+    .de_init = BspFlash_DeInit,
+    .erase = BspFlash_Erase,
+    .read = BspFlash_Read_From_Addr,
+    .write = BspFlash_Write_To_Addr,
+    .get_align_size = BspFlash_Get_AlignSize,
+};
+
+static bool BspFlash_Check_Range(uint32_t addr, uint32_t size)
+{
+    if ((addr < FLASH_BASE_ADDR) || \
+        (size > FLASH_BANK_SIZE) || \
+        ((addr - FLASH_BASE_ADDR) > (FLASH_BANK_SIZE - size)))
+        return false;
+
+    return true;
+}
+
+static bool BspFlash_Init(void)
+{
+    if (!BspFlash_Image_Init)
+    {
+        memset(BspFlash_Image, FLASH_DEFAULT_DATA, sizeof(BspFlash_Image));
+        BspFlash_Image_Init = true;
+    }
+
+    return true;
+}
+
+static void BspFlash_DeInit(void)
+{
+}
+
+static bool BspFlash_Read_From_Addr(uint32_t addr, uint8_t *p_data, uint32_t size)
+{
+    if ((addr % BSP_FLASH_ADDR_ALIGN_SIZE) || (p_data == NULL) || (size == 0) || !BspFlash_Check_Range(addr, size))
+        return false;
+
+    memcpy(p_data, &BspFlash_Image[addr - FLASH_BASE_ADDR], size);
+    return true;
+}
+
+static bool BspFlash_Write_To_Addr(uint32_t addr, uint8_t *p_data, uint32_t size)
+{
+    uint8_t *p_dst = NULL;
+
+    if ((addr % BSP_FLASH_ADDR_ALIGN_SIZE) || (p_data == NULL) || (size == 0) || !BspFlash_Check_Range(addr, size))
+        return false;
+
+    /* programming can only clear bit, same as nor flash */
+    p_dst = &BspFlash_Image[addr - FLASH_BASE_ADDR];
+    for (uint32_t i = 0; i < size; i++)
+        p_dst[i] &= p_data[i];
+
+    return (memcmp(p_dst, p_data, size) == 0);
+}
+
+static bool BspFlash_Erase(uint32_t addr, uint32_t len)
+{
+    uint32_t start = 0;
+    uint32_t end = 0;
+
+    if ((len == 0) || !BspFlash_Check_Range(addr, len))
+        return false;
+
+    start = ((addr - FLASH_BASE_ADDR) / BSP_FLASH_SECTOR_SIZE) * BSP_FLASH_SECTOR_SIZE;
+    end = addr - FLASH_BASE_ADDR + len;
+    if (end % BSP_FLASH_SECTOR_SIZE)
+        end += BSP_FLASH_SECTOR_SIZE - (end % BSP_FLASH_SECTOR_SIZE);
+
+    memset(&BspFlash_Image[start], FLASH_DEFAULT_DATA, end - start);
+    return true;
+}
+
+static uint8_t BspFlash_Get_AlignSize(void)
+{
+    return BSP_FLASH_ADDR_ALIGN_SIZE;
+}
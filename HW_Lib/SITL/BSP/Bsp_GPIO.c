@@ -0,0 +1,215 @@
+#include "Bsp_GPIO.h"
+#include "FreeRTOS.h"
+#include "profiler.h"
+
+/*
+ * pin level kept in the port object
+ * exti edge raised by the simulation side run the callback in isr context
+ */
+typedef struct
+{
+    GPIO_TypeDef *port;
+    uint16_t pin;
+    BspGPOP_ExtiMode_List mode;
+    EXTI_Callback callback;
+} BspGPIO_Exti_TypeDef;
+
+typedef struct
+{
+    GPIO_TypeDef *port;
+    uint16_t pin;
+    BspGPIO_Sitl_Output_Callback callback;
+} BspGPIO_OutHook_TypeDef;
+
+#define BSPGPIO_OUTHOOK_SUM 8
+
+/* external vriable */
+GPIO_TypeDef SitlHal_GPIO[SITL_GPIO_PORT_SUM] = {
+    {.id = 0}, {.id = 1}, {.id = 2}, {.id = 3}, {.id = 4}, {.id = 5},
+    {.id = 6}, {.id = 7}, {.id = 8}, {.id = 9}, {.id = 10},
+};
+
+/* internal vriable */
+static BspGPIO_Exti_TypeDef EXTI_List[GPIO_EXTI_SUM] = {0};
+static BspGPIO_OutHook_TypeDef OutHook_List[BSPGPIO_OUTHOOK_SUM] = {0};
+
+/* internal function */
+static uint8_t BspGPIO_GetEXTI_Index(uint16_t pin);
+
+/* external function */
+static bool BspGPIO_Output_Init(BspGPIO_Obj_TypeDef IO_Obj);
+static bool BspGPIO_Input_Init(BspGPIO_Obj_TypeDef IO_Obj);
+static bool BspGPIO_Alternate_Init(BspGPIO_Obj_TypeDef IO_Obj, uint32_t af_mode);
+static bool BspGPIO_Read(BspGPIO_Obj_TypeDef IO_Obj);
+static void BspGPIO_Write(BspGPIO_Obj_TypeDef IO_Obj, bool state);
+static bool BspGPIO_ExtiInit(BspGPIO_Obj_TypeDef IO_Obj, EXTI_Callback callback);
+static bool BspGPIO_ResetExtiCallback(BspGPIO_Obj_TypeDef IO_Obj, EXTI_Callback callback);
+static bool BspGPIO_ExtiSetMode(BspGPIO_Obj_TypeDef IO_Obj, BspGPOP_ExtiMode_List mode);
+
+BspGPIO_TypeDef BspGPIO = {
+    .exti_init = BspGPIO_ExtiInit,
+    .in_init = BspGPIO_Input_Init,
+    .out_init = BspGPIO_Output_Init,
+    .alt_init = BspGPIO_Alternate_Init,
+    .read = BspGPIO_Read,
+    .write = BspGPIO_Write,
+    .set_exti_callback = BspGPIO_ResetExtiCallback,
+    .set_exti_mode = BspGPIO_ExtiSetMode,
+};
+
+static uint8_t BspGPIO_GetEXTI_Index(uint16_t pin)
+{
+    return (uint8_t)(__builtin_ctz(pin) & 0x0F);
+}
+
+static bool BspGPIO_ExtiInit(BspGPIO_Obj_TypeDef IO_Obj, EXTI_Callback callback)
+{
+    uint8_t index = 0;
+
+    if ((IO_Obj.port == NULL) || (IO_Obj.pin == 0))
+        return false;
+
+    /* one exti line per pin index, same as target */
+    index = BspGPIO_GetEXTI_Index(IO_Obj.pin);
+    EXTI_List[index].port = IO_Obj.port;
+    EXTI_List[index].pin = IO_Obj.pin;
+    EXTI_List[index].mode = GPIO_Exti_Falling;
+    EXTI_List[index].callback = callback;
+
+    return true;
+}
+
+static bool BspGPIO_ResetExtiCallback(BspGPIO_Obj_TypeDef IO_Obj, EXTI_Callback callback)
+{
+    uint8_t index = 0;
+
+    if (IO_Obj.pin == 0)
+        return false;
+
+    index = BspGPIO_GetEXTI_Index(IO_Obj.pin);
+    if (EXTI_List[index].port != IO_Obj.port)
+        return false;
+
+    EXTI_List[index].callback = callback;
+    return true;
+}
+
+static bool BspGPIO_ExtiSetMode(BspGPIO_Obj_TypeDef IO_Obj, BspGPOP_ExtiMode_List mode)
+{
+    uint8_t index = 0;
+
+    if (IO_Obj.pin == 0)
+        return false;
+
+    index = BspGPIO_GetEXTI_Index(IO_Obj.pin);
+    if (EXTI_List[index].port != IO_Obj.port)
+        return false;
+
+    EXTI_List[index].mode = mode;
+    return true;
+}
+
+static bool BspGPIO_Output_Init(BspGPIO_Obj_TypeDef IO_Obj)
+{
+    if (IO_Obj.port == NULL)
+        return false;
+
+    BspGPIO_Write(IO_Obj, IO_Obj.init_state);
+    return true;
+}
+
+static bool BspGPIO_Input_Init(BspGPIO_Obj_TypeDef IO_Obj)
+{
+    return (IO_Obj.port != NULL);
+}
+
+static bool BspGPIO_Alternate_Init(BspGPIO_Obj_TypeDef IO_Obj, uint32_t af_mode)
+{
+    (void)af_mode;
+    return (IO_Obj.port != NULL);
+}
+
+static bool BspGPIO_Read(BspGPIO_Obj_TypeDef IO_Obj)
+{
+    if (IO_Obj.port == NULL)
+        return false;
+
+    return (((GPIO_TypeDef *)IO_Obj.port)->idr & IO_Obj.pin) ? true : false;
+}
+
+static void BspGPIO_Write(BspGPIO_Obj_TypeDef IO_Obj, bool state)
+{
+    GPIO_TypeDef *port = (GPIO_TypeDef *)IO_Obj.port;
+
+    if (port == NULL)
+        return;
+
+    if (state)
+        port->odr |= IO_Obj.pin;
+    else
+        port->odr &= ~IO_Obj.pin;
+
+    for (uint8_t i = 0; i < BSPGPIO_OUTHOOK_SUM; i++)
+    {
+        if ((OutHook_List[i].port == port) && (OutHook_List[i].pin & IO_Obj.pin) && OutHook_List[i].callback)
+            OutHook_List[i].callback(state);
+    }
+}
+
+/************************************************** Simulation Section ************************************************/
+bool BspGPIO_Sitl_Set_OutputHook(GPIO_TypeDef *port, uint16_t pin, BspGPIO_Sitl_Output_Callback callback)
+{
+    for (uint8_t i = 0; i < BSPGPIO_OUTHOOK_SUM; i++)
+    {
+        if (OutHook_List[i].port == NULL)
+        {
+            OutHook_List[i].port = port;
+            OutHook_List[i].pin = pin;
+            OutHook_List[i].callback = callback;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* called by model thread, edge matched exti mode run the callback inside simulated isr */
+void BspGPIO_Sitl_Set_Input(GPIO_TypeDef *port, uint16_t pin, bool state)
+{
+    BspGPIO_Exti_TypeDef *exti = NULL;
+    bool last = false;
+    bool trigger = false;
+
+    if ((port == NULL) || (pin == 0))
+        return;
+
+    last = (port->idr & pin) ? true : false;
+    if (state)
+        port->idr |= pin;
+    else
+        port->idr &= ~pin;
+
+    if (last == state)
+        return;
+
+    exti = &EXTI_List[BspGPIO_GetEXTI_Index(pin)];
+    if ((exti->port != port) || (exti->callback == NULL))
+        return;
+
+    switch ((uint8_t)exti->mode)
+    {
+        case GPIO_Exti_Rasing: trigger = state; break;
+        case GPIO_Exti_Falling: trigger = !state; break;
+        case GPIO_Exti_TwoEdge: trigger = true; break;
+        default: break;
+    }
+
+    if (trigger)
+    {
+        SitlPort_Isr_Enter();
+        Profiler.isr_enter(Profiler_Isr_Exti);
+        exti->callback();
+        Profiler.isr_exit(Profiler_Isr_Exti);
+        SitlPort_Isr_Exit();
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef __BSP_GPIO_H
+#define __BSP_GPIO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Bsp_GPIO_Port_Def.h"
+#include "sitl_hal.h"
+
+#define GPIO_EXTI_SUM 16
+
+/* simulation side, model watch the output pin (chip select) and raise the input edge (data ready) */
+typedef void (*BspGPIO_Sitl_Output_Callback)(bool state);
+
+bool BspGPIO_Sitl_Set_OutputHook(GPIO_TypeDef *port, uint16_t pin, BspGPIO_Sitl_Output_Callback callback);
+void BspGPIO_Sitl_Set_Input(GPIO_TypeDef *port, uint16_t pin, bool state);
+
+extern BspGPIO_TypeDef BspGPIO;
+
+#endif
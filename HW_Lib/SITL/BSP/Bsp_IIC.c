@@ -0,0 +1,129 @@
+#include "Bsp_IIC.h"
+#include "evt_trace.h"
+
+#define BSPIIC_SLAVE_SUM 4
+
+typedef struct
+{
+    uint16_t dev_addr;
+    BspIIC_Sitl_Read_Callback read;
+    BspIIC_Sitl_Write_Callback write;
+} BspIIC_Slave_TypeDef;
+
+/* internal vriable */
+static BspIIC_Slave_TypeDef BspIIC_Slave_List[BspIIC_Instance_I2C_Sum][BSPIIC_SLAVE_SUM];
+static I2C_HandleTypeDef *BspIIC_HandleList[BspIIC_Instance_I2C_Sum] = {NULL};
+
+/* internal function */
+static BspIIC_Slave_TypeDef *BspIIC_Search_Slave(BspIICObj_TypeDef *obj, uint16_t addr);
+
+/* external function */
+static bool BspIIC_Init(BspIICObj_TypeDef *obj);
+static bool BspIIC_DeInit(BspIICObj_TypeDef *obj);
+static bool BspIIC_Read(BspIICObj_TypeDef *obj, uint16_t dev_addr, uint16_t reg, uint8_t *p_buf, uint16_t len);
+static bool BspIIC_Write(BspIICObj_TypeDef *obj, uint16_t dev_addr, uint16_t reg, uint8_t *p_buf, uint16_t len);
+
+BspIIC_TypeDef BspIIC = {
+    .init = BspIIC_Init,
+    .de_init = BspIIC_DeInit,
+    .read = BspIIC_Read,
+    .write = BspIIC_Write,
+};
+
+void *BspIIC_Get_HandlePtr(uint8_t index)
+{
+    if (index >= BspIIC_Instance_I2C_Sum)
+        return NULL;
+
+    return BspIIC_HandleList[index];
+}
+
+static bool BspIIC_Init(BspIICObj_TypeDef *obj)
+{
+    if ((obj == NULL) || (obj->handle == NULL) || (obj->instance_id >= BspIIC_Instance_I2C_Sum))
+        return false;
+
+    ((I2C_HandleTypeDef *)obj->handle)->instance_id = obj->instance_id;
+    ((I2C_HandleTypeDef *)obj->handle)->ErrorCode = 0;
+    BspIIC_HandleList[obj->instance_id] = obj->handle;
+    obj->init = true;
+
+    return true;
+}
+
+static bool BspIIC_DeInit(BspIICObj_TypeDef *obj)
+{
+    if ((obj == NULL) || (obj->instance_id >= BspIIC_Instance_I2C_Sum))
+        return false;
+
+    BspIIC_HandleList[obj->instance_id] = NULL;
+    obj->init = false;
+
+    return true;
+}
+
+/* address on the bus api is left shifted as hal use */
+static BspIIC_Slave_TypeDef *BspIIC_Search_Slave(BspIICObj_TypeDef *obj, uint16_t addr)
+{
+    if ((obj == NULL) || !obj->init || (obj->instance_id >= BspIIC_Instance_I2C_Sum))
+        return NULL;
+
+    for (uint8_t i = 0; i < BSPIIC_SLAVE_SUM; i++)
+    {
+        if (BspIIC_Slave_List[obj->instance_id][i].dev_addr == (addr >> 1))
+            return &BspIIC_Slave_List[obj->instance_id][i];
+    }
+
+    return NULL;
+}
+
+/* no ack from absent slave */
+static bool BspIIC_Read(BspIICObj_TypeDef *obj, uint16_t dev_addr, uint16_t reg, uint8_t *p_buf, uint16_t len)
+{
+    BspIIC_Slave_TypeDef *slave = BspIIC_Search_Slave(obj, dev_addr);
+    bool state = false;
+
+    if ((slave == NULL) || (slave->read == NULL) || (p_buf == NULL) || (len == 0))
+        return false;
+
+    EvtTrace.record(EvtTrace_IIC_Start, (uint8_t)dev_addr, len);
+    state = slave->read(reg, p_buf, len);
+    EvtTrace.record(EvtTrace_IIC_End, state, 0);
+
+    return state;
+}
+
+static bool BspIIC_Write(BspIICObj_TypeDef *obj, uint16_t dev_addr, uint16_t reg, uint8_t *p_buf, uint16_t len)
+{
+    BspIIC_Slave_TypeDef *slave = BspIIC_Search_Slave(obj, dev_addr);
+    bool state = false;
+
+    if ((slave == NULL) || (slave->write == NULL) || (p_buf == NULL) || (len == 0))
+        return false;
+
+    EvtTrace.record(EvtTrace_IIC_Start, (uint8_t)dev_addr, len);
+    state = slave->write(reg, p_buf, len);
+    EvtTrace.record(EvtTrace_IIC_End, state, 0);
+
+    return state;
+}
+
+/************************************************** Simulation Section ************************************************/
+bool BspIIC_Sitl_Attach(BspIIC_Instance_List instance, uint16_t dev_addr, BspIIC_Sitl_Read_Callback read, BspIIC_Sitl_Write_Callback write)
+{
+    if ((instance < BspIIC_Instance_I2C_1) || (instance >= BspIIC_Instance_I2C_Sum) || (dev_addr == 0))
+        return false;
+
+    for (uint8_t i = 0; i < BSPIIC_SLAVE_SUM; i++)
+    {
+        if (BspIIC_Slave_List[instance][i].dev_addr == 0)
+        {
+            BspIIC_Slave_List[instance][i].dev_addr = dev_addr;
+            BspIIC_Slave_List[instance][i].read = read;
+            BspIIC_Slave_List[instance][i].write = write;
+            return true;
+        }
+    }
+
+    return false;
+}
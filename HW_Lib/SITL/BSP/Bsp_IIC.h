@@ -0,0 +1,31 @@
+#ifndef __BSP_IIC_H
+#define __BSP_IIC_H
+
+#include <stdbool.h>
+#include <string.h>
+#include <stdint.h>
+#include "Bsp_IIC_Port_Def.h"
+#include "Bsp_GPIO.h"
+#include "sitl_hal.h"
+
+#define I2C_HandleType_Size sizeof(I2C_HandleTypeDef)
+#define I2C_PeriphCLKInitType_Size sizeof(RCC_PeriphCLKInitTypeDef)
+
+typedef enum
+{
+    BspIIC_Instance_I2C_1 = 0,
+    BspIIC_Instance_I2C_2,
+    BspIIC_Instance_I2C_3,
+    BspIIC_Instance_I2C_4,
+    BspIIC_Instance_I2C_Sum,
+}BspIIC_Instance_List;
+
+/* simulation side, register mapped slave model, dev_addr in 7 bit */
+typedef bool (*BspIIC_Sitl_Read_Callback)(uint16_t reg, uint8_t *p_data, uint16_t len);
+typedef bool (*BspIIC_Sitl_Write_Callback)(uint16_t reg, const uint8_t *p_data, uint16_t len);
+
+bool BspIIC_Sitl_Attach(BspIIC_Instance_List instance, uint16_t dev_addr, BspIIC_Sitl_Read_Callback read, BspIIC_Sitl_Write_Callback write);
+
+extern BspIIC_TypeDef BspIIC;
+
+#endif
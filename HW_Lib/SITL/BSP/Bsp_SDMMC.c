@@ -0,0 +1,307 @@
+/*
+ * host stand in of the sdmmc port
+ * card content is a host image file, block io is done by a host worker thread
+ * completion callback is raised in isr context once the worker finish, same as the idma transfer complete irq
+ * a fixed bus latency is added before the completion so the caller get its wait flag set first, as on target
+ */
+#include "Bsp_SDMMC.h"
+#include "FreeRTOS.h"
+#include "profiler.h"
+#include <unistd.h>
+#include <semaphore.h>
+#include <time.h>
+
+#define BSP_SDMMC_SITL_LATENCY_US 100
+#define BSP_SDMMC_SITL_BLOCK_US 25
+
+#define HAL_SD_STATE_READY 0x00000001U
+#define HAL_SD_STATE_BUSY  0x00000003U
+
+typedef enum
+{
+    BspSDMMC_Sitl_Req_Read = 0,
+    BspSDMMC_Sitl_Req_Write,
+} BspSDMMC_Sitl_Req_List;
+
+typedef struct
+{
+    int fd;
+    uint32_t block_num;
+    bool worker_on;
+    sem_t req_sem;
+
+    BspSDMMC_Obj_TypeDef *obj;
+    BspSDMMC_Sitl_Req_List type;
+    uint8_t *p_data;
+    uint32_t block;
+    uint32_t block_cnt;
+} BspSDMMC_Sitl_Card_TypeDef;
+
+/* external vriable */
+SD_TypeDef SitlHal_SDMMC[SITL_SDMMC_SUM] = {{.id = 1}, {.id = 2}};
+
+/* internal variable */
+static BspSDMMC_Callback_List_TypeDef BspSCMMC_Callback_List[BspSDMMC_Callback_Index_Sum] = {0};
+static BspSDMMC_Sitl_Card_TypeDef BspSDMMC_Card[BspSDMMC_Callback_Index_Sum] = {
+    {.fd = -1},
+    {.fd = -1},
+};
+
+/* internal function */
+static int8_t BspSDMMC_Get_Index(SD_TypeDef *instance);
+static bool BspSDMMC_Request(BspSDMMC_Obj_TypeDef *obj, BspSDMMC_Sitl_Req_List type, uint8_t *p_data, uint32_t block, uint32_t block_cnt);
+static void *BspSDMMC_Worker(void *arg);
+
+/* external function */
+static bool BspSDMMC_Init(BspSDMMC_Obj_TypeDef *obj);
+static bool BspSDMMC_Read(BspSDMMC_Obj_TypeDef *obj, uint32_t *pData, uint32_t ReadAddr, uint32_t NumOfBlocks);
+static bool BspSDMMC_Write(BspSDMMC_Obj_TypeDef *obj, uint32_t *pData, uint32_t WriteAddr, uint32_t NumOfBlocks);
+static bool BspSDMMC_Erase(BspSDMMC_Obj_TypeDef *obj, uint32_t StartAddr, uint32_t EndAddr);
+static bool BspSDMMC_GetCardStatus(BspSDMMC_Obj_TypeDef *obj);
+static bool BspSDMMC_GetInfo(BspSDMMC_Obj_TypeDef *obj, HAL_SD_CardInfoTypeDef *info_out);
+static void BspSDMMC_Set_Callback(BspSDMMC_Obj_TypeDef *obj, BspSDMMC_Callback_TypeList type, SDMMC_Callback cb);
+static BspSDMMC_OperationState_List BspSDMMC_Get_Operation_State(BspSDMMC_Obj_TypeDef *obj);
+
+BspSDMMC_TypeDef BspSDMMC = {
+    .init = BspSDMMC_Init,
+    .read = BspSDMMC_Read,
+    .write = BspSDMMC_Write,
+    .erase = BspSDMMC_Erase,
+    .card_status = BspSDMMC_GetCardStatus,
+    .info = BspSDMMC_GetInfo,
+    .set_callback = BspSDMMC_Set_Callback,
+    .get_opr_state = BspSDMMC_Get_Operation_State,
+};
+
+static int8_t BspSDMMC_Get_Index(SD_TypeDef *instance)
+{
+    if (instance == SDMMC1)
+        return BspSDMMC_1_Callback;
+    else if (instance == SDMMC2)
+        return BspSDMMC_2_Callback;
+
+    return -1;
+}
+
+static bool BspSDMMC_Init(BspSDMMC_Obj_TypeDef *obj)
+{
+    int8_t index = 0;
+
+    if (obj == NULL)
+        return false;
+
+    memset(BspSCMMC_Callback_List, 0, sizeof(BspSCMMC_Callback_List));
+
+    index = BspSDMMC_Get_Index(obj->instance);
+    if (index < 0)
+        return false;
+
+    obj->ref_callback_item = &BspSCMMC_Callback_List[index];
+    obj->hdl.Instance = obj->instance;
+    obj->hdl.ErrorCode = 0;
+    obj->hdl.State = HAL_SD_STATE_READY;
+
+    /* no card inserted */
+    if (BspSDMMC_Card[index].fd < 0)
+        return false;
+
+    if (!BspSDMMC_Card[index].worker_on)
+    {
+        sem_init(&BspSDMMC_Card[index].req_sem, 0, 0);
+        if (!SitlPort_Thread_Create(BspSDMMC_Worker, &BspSDMMC_Card[index]))
+            return false;
+
+        BspSDMMC_Card[index].worker_on = true;
+    }
+
+    return true;
+}
+
+static bool BspSDMMC_Request(BspSDMMC_Obj_TypeDef *obj, BspSDMMC_Sitl_Req_List type, uint8_t *p_data, uint32_t block, uint32_t block_cnt)
+{
+    BspSDMMC_Sitl_Card_TypeDef *card = NULL;
+    int8_t index = 0;
+
+    if ((obj == NULL) || (p_data == NULL) || (block_cnt == 0))
+        return false;
+
+    index = BspSDMMC_Get_Index(obj->instance);
+    if ((index < 0) || !BspSDMMC_Card[index].worker_on)
+        return false;
+
+    card = &BspSDMMC_Card[index];
+    if ((obj->hdl.State != HAL_SD_STATE_READY) || (block >= card->block_num) || (block_cnt > (card->block_num - block)))
+        return false;
+
+    obj->hdl.State = HAL_SD_STATE_BUSY;
+    card->obj = obj;
+    card->type = type;
+    card->p_data = p_data;
+    card->block = block;
+    card->block_cnt = block_cnt;
+
+    if (type == BspSDMMC_Sitl_Req_Read)
+        obj->hdl.RxXferSize = block_cnt * BLOCKSIZE;
+    else
+        obj->hdl.TxXferSize = block_cnt * BLOCKSIZE;
+
+    sem_post(&card->req_sem);
+    return true;
+}
+
+static bool BspSDMMC_Read(BspSDMMC_Obj_TypeDef *obj, uint32_t *pData, uint32_t ReadAddr, uint32_t NumOfBlocks)
+{
+    return BspSDMMC_Request(obj, BspSDMMC_Sitl_Req_Read, (uint8_t *)pData, ReadAddr, NumOfBlocks);
+}
+
+static bool BspSDMMC_Write(BspSDMMC_Obj_TypeDef *obj, uint32_t *pData, uint32_t WriteAddr, uint32_t NumOfBlocks)
+{
+    return BspSDMMC_Request(obj, BspSDMMC_Sitl_Req_Write, (uint8_t *)pData, WriteAddr, NumOfBlocks);
+}
+
+static bool BspSDMMC_Erase(BspSDMMC_Obj_TypeDef *obj, uint32_t StartAddr, uint32_t EndAddr)
+{
+    UNUSED(StartAddr);
+    UNUSED(EndAddr);
+
+    return (obj != NULL);
+}
+
+static BspSDMMC_OperationState_List BspSDMMC_Get_Operation_State(BspSDMMC_Obj_TypeDef *obj)
+{
+    if (obj)
+        return (BspSDMMC_OperationState_List)obj->hdl.State;
+
+    return BspSDMMC_Opr_State_ERROR;
+}
+
+static bool BspSDMMC_GetCardStatus(BspSDMMC_Obj_TypeDef *obj)
+{
+    if (obj == NULL)
+        return false;
+
+    return (obj->hdl.State == HAL_SD_STATE_READY);
+}
+
+static bool BspSDMMC_GetInfo(BspSDMMC_Obj_TypeDef *obj, HAL_SD_CardInfoTypeDef *info_out)
+{
+    int8_t index = 0;
+
+    if ((obj == NULL) || (info_out == NULL))
+        return false;
+
+    index = BspSDMMC_Get_Index(obj->instance);
+    if (index < 0)
+        return false;
+
+    memset(&(obj->info), 0, sizeof(obj->info));
+    obj->info.CardType = 1;     /* sdhc / sdxc */
+    obj->info.CardVersion = 1;
+    obj->info.RelCardAdd = 1;
+    obj->info.BlockNbr = BspSDMMC_Card[index].block_num;
+    obj->info.BlockSize = BLOCKSIZE;
+    obj->info.LogBlockNbr = BspSDMMC_Card[index].block_num;
+    obj->info.LogBlockSize = BLOCKSIZE;
+    obj->info.CardSpeed = 1;    /* high speed */
+
+    if (info_out != &(obj->info))
+        memcpy(info_out, &(obj->info), sizeof(obj->info));
+
+    return true;
+}
+
+static void BspSDMMC_Set_Callback(BspSDMMC_Obj_TypeDef *obj, BspSDMMC_Callback_TypeList type, SDMMC_Callback cb)
+{
+    if(obj)
+    {
+        switch((uint8_t)type)
+        {
+            case BspSDMMC_Callback_Type_Write:
+                obj->Write_Callback = cb;
+                if(obj->ref_callback_item)
+                    obj->ref_callback_item->Write_Callback = cb;
+                break;
+
+            case BspSDMMC_Callback_Type_Read:
+                obj->Read_Callback = cb;
+                if(obj->ref_callback_item)
+                    obj->ref_callback_item->Read_Callback = cb;
+                break;
+
+            case BspSDMMC_Callback_Type_Error:
+                obj->Error_Callback = cb;
+                if(obj->ref_callback_item)
+                    obj->ref_callback_item->Error_Callback = cb;
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
+/* host thread, stand for the sdmmc idma and its transfer complete irq */
+static void *BspSDMMC_Worker(void *arg)
+{
+    BspSDMMC_Sitl_Card_TypeDef *card = (BspSDMMC_Sitl_Card_TypeDef *)arg;
+    BspSDMMC_Obj_TypeDef *obj = NULL;
+    struct timespec delay;
+    off_t offset = 0;
+    size_t size = 0;
+    ssize_t done = 0;
+    SDMMC_Callback callback = NULL;
+
+    while (true)
+    {
+        while (sem_wait(&card->req_sem) != 0);
+
+        obj = card->obj;
+        offset = (off_t)card->block * BLOCKSIZE;
+        size = (size_t)card->block_cnt * BLOCKSIZE;
+
+        delay.tv_sec = 0;
+        delay.tv_nsec = (BSP_SDMMC_SITL_LATENCY_US + BSP_SDMMC_SITL_BLOCK_US * card->block_cnt) * 1000L;
+        nanosleep(&delay, NULL);
+
+        if (card->type == BspSDMMC_Sitl_Req_Read)
+            done = pread(card->fd, card->p_data, size, offset);
+        else
+            done = pwrite(card->fd, card->p_data, size, offset);
+
+        SitlPort_Isr_Enter();
+
+        Profiler.isr_enter(Profiler_Isr_SDMMC);
+        obj->hdl.State = HAL_SD_STATE_READY;
+        if (done != (ssize_t)size)
+        {
+            obj->hdl.ErrorCode = 1;
+            callback = obj->ref_callback_item->Error_Callback;
+        }
+        else if (card->type == BspSDMMC_Sitl_Req_Read)
+        {
+            callback = obj->ref_callback_item->Read_Callback;
+        }
+        else
+            callback = obj->ref_callback_item->Write_Callback;
+
+        if (callback)
+            callback((uint8_t *)&(obj->hdl), sizeof(SD_HandleTypeDef));
+        Profiler.isr_exit(Profiler_Isr_SDMMC);
+        SitlPort_Isr_Exit();
+    }
+
+    return NULL;
+}
+
+/************************************************** Simulation Section ************************************************/
+bool BspSDMMC_Sitl_Bind(SD_TypeDef *instance, int fd, uint32_t block_num)
+{
+    int8_t index = BspSDMMC_Get_Index(instance);
+
+    if ((index < 0) || (fd < 0) || (block_num == 0))
+        return false;
+
+    BspSDMMC_Card[index].fd = fd;
+    BspSDMMC_Card[index].block_num = block_num;
+    return true;
+}
@@ -0,0 +1,148 @@
+#include "Bsp_SPI.h"
+#include "evt_trace.h"
+
+#define To_SPI_Handle_Ptr(x) ((SPI_HandleTypeDef *)x)
+
+/* external vriable */
+SPI_TypeDef SitlHal_SPI[SITL_SPI_SUM] = {{.id = 1}, {.id = 2}, {.id = 3}, {.id = 4}, {.id = 5}, {.id = 6}};
+
+/* internal vriable */
+static BspSPI_Sitl_Xfer_Callback BspSPI_Slave_List[SITL_SPI_SUM] = {NULL};
+
+/* internal function */
+static int8_t BspSPI_Get_Index(SPI_TypeDef *instance);
+
+/* external function */
+static bool BspSPI_NormalMode_Init(BspSPI_NorModeConfig_TypeDef spi_cfg, void *spi_instance);
+static bool BspSPI_DeInit(BspSPI_NorModeConfig_TypeDef spi_cfg);
+static bool BspSPI_Trans(void *spi_instance, uint8_t *tx, uint16_t size, uint16_t time_out);
+static bool BspSPI_Receive(void *spi_instance, uint8_t *rx, uint16_t size, uint16_t time_out);
+static uint16_t BspSPI_TransReceive(void *spi_instance, uint8_t *tx, uint8_t *rx, uint16_t size, uint16_t time_out);
+static bool BspSPI_Set_CLKSpeed(void *spi_instance, uint32_t speed);
+
+BspSpi_TypeDef BspSPI = {
+    .init = BspSPI_NormalMode_Init,
+    .deinit = BspSPI_DeInit,
+    .trans = BspSPI_Trans,
+    .receive = BspSPI_Receive,
+    .trans_receive = BspSPI_TransReceive,
+    .set_speed = BspSPI_Set_CLKSpeed,
+};
+
+static int8_t BspSPI_Get_Index(SPI_TypeDef *instance)
+{
+    if ((instance < &SitlHal_SPI[0]) || (instance >= &SitlHal_SPI[SITL_SPI_SUM]))
+        return -1;
+
+    return (int8_t)(instance - &SitlHal_SPI[0]);
+}
+
+static bool BspSPI_NormalMode_Init(BspSPI_NorModeConfig_TypeDef spi_cfg, void *spi_instance)
+{
+    if ((spi_instance == NULL) || (BspSPI_Get_Index(spi_cfg.Instance) < 0))
+        return false;
+
+    To_SPI_Handle_Ptr(spi_instance)->Instance = spi_cfg.Instance;
+    To_SPI_Handle_Ptr(spi_instance)->CLKPolarity = spi_cfg.CLKPolarity;
+    To_SPI_Handle_Ptr(spi_instance)->CLKPhase = spi_cfg.CLKPhase;
+    To_SPI_Handle_Ptr(spi_instance)->BaudRatePrescaler = spi_cfg.BaudRatePrescaler;
+
+    return true;
+}
+
+static bool BspSPI_DeInit(BspSPI_NorModeConfig_TypeDef spi_cfg)
+{
+    return (BspSPI_Get_Index(spi_cfg.Instance) >= 0);
+}
+
+static bool BspSPI_Set_CLKSpeed(void *spi_instance, uint32_t speed)
+{
+    if (spi_instance == NULL)
+        return false;
+
+    To_SPI_Handle_Ptr(spi_instance)->BaudRatePrescaler = speed;
+
+    return true;
+}
+
+/* no slave on bus read back 0xFF, same as a floating miso with pull up */
+static uint16_t BspSPI_TransReceive(void *spi_instance, uint8_t *tx, uint8_t *rx, uint16_t size, uint16_t time_out)
+{
+    int8_t index = -1;
+
+    (void)time_out;
+
+    if ((spi_instance == NULL) || (tx == NULL) || (rx == NULL) || (size == 0))
+        return 0;
+
+    index = BspSPI_Get_Index(To_SPI_Handle_Ptr(spi_instance)->Instance);
+    if (index < 0)
+        return 0;
+
+    /* transmit and receive only are split into transfer here, so the trace see them as one */
+    EvtTrace.record(EvtTrace_SPI_Start, 2, size);
+    if (BspSPI_Slave_List[index] == NULL)
+    {
+        memset(rx, 0xFF, size);
+    }
+    else
+        BspSPI_Slave_List[index](tx, rx, size);
+    EvtTrace.record(EvtTrace_SPI_End, 1, 0);
+
+    return size;
+}
+
+static bool BspSPI_Trans(void *spi_instance, uint8_t *tx, uint16_t size, uint16_t time_out)
+{
+    uint8_t dummy[64];
+    uint16_t len = 0;
+
+    if (tx == NULL)
+        return false;
+
+    while (size)
+    {
+        len = (size > sizeof(dummy)) ? sizeof(dummy) : size;
+        if (BspSPI_TransReceive(spi_instance, tx, dummy, len, time_out) != len)
+            return false;
+
+        tx += len;
+        size -= len;
+    }
+
+    return true;
+}
+
+static bool BspSPI_Receive(void *spi_instance, uint8_t *rx, uint16_t size, uint16_t time_out)
+{
+    uint8_t dummy[64];
+    uint16_t len = 0;
+
+    if (rx == NULL)
+        return false;
+
+    memset(dummy, 0xFF, sizeof(dummy));
+    while (size)
+    {
+        len = (size > sizeof(dummy)) ? sizeof(dummy) : size;
+        if (BspSPI_TransReceive(spi_instance, dummy, rx, len, time_out) != len)
+            return false;
+
+        rx += len;
+        size -= len;
+    }
+
+    return true;
+}
+
+/************************************************** Simulation Section ************************************************/
+bool BspSPI_Sitl_Attach(SPI_TypeDef *instance, BspSPI_Sitl_Xfer_Callback callback)
+{
+    int8_t index = BspSPI_Get_Index(instance);
+
+    if (index < 0)
+        return false;
+
+    BspSPI_Slave_List[index] = callback;
+    return true;
+}
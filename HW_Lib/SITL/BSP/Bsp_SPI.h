@@ -0,0 +1,16 @@
+#ifndef __BSP_SPI_H
+#define __BSP_SPI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Bsp_SPI_Port_Def.h"
+#include "sitl_hal.h"
+
+/* simulation side, slave model exchange byte in full duplex, chip select come from the gpio output hook */
+typedef void (*BspSPI_Sitl_Xfer_Callback)(const uint8_t *tx, uint8_t *rx, uint16_t size);
+
+bool BspSPI_Sitl_Attach(SPI_TypeDef *instance, BspSPI_Sitl_Xfer_Callback callback);
+
+extern BspSpi_TypeDef BspSPI;
+
+#endif
@@ -0,0 +1,343 @@
+/*
+ * host stand in of the timer port
+ * no waveform is generated, every dma triggered output frame is handed to the frame sink instead
+ * bidirectional capture never receive an edge, so get_capture always return 0
+ */
+#include "Bsp_Timer.h"
+
+#define To_TIM_Instance_Ptr(x) ((TIM_TypeDef *)x)
+#define To_TIM_Handle_Ptr(x) ((TIM_HandleTypeDef *)x)
+
+/* external vriable */
+TIM_TypeDef SitlHal_TIM[SITL_TIM_SUM] = {{.id = 1},  {.id = 2},  {.id = 3},  {.id = 4},  {.id = 5},  {.id = 6},
+                                         {.id = 7},  {.id = 8},  {.id = 9},  {.id = 10}, {.id = 11}, {.id = 12},
+                                         {.id = 13}, {.id = 14}, {.id = 15}, {.id = 16}, {.id = 17}};
+
+/* internal variable */
+static BspTimer_Sitl_Frame_Callback BspTimer_FrameSink = NULL;
+
+/* internal function */
+static int8_t BspTimer_Get_Channel_Index(uint32_t ch);
+
+/* external function */
+static bool BspTimer_PWM_Init(BspTimerPWMObj_TypeDef *obj,
+                              void *instance,
+                              uint32_t ch,
+                              BspGPIO_Obj_TypeDef pin,
+                              uint8_t dma,
+                              uint8_t stream,
+                              uint32_t buf_aadr,
+                              uint32_t buf_size);
+static void BspTimer_SetPreScale(BspTimerPWMObj_TypeDef *obj, uint32_t prescale);
+static void BspTimer_SetAutoReload(BspTimerPWMObj_TypeDef *obj, uint32_t auto_reload);
+static void BspTimer_PWM_Start(BspTimerPWMObj_TypeDef *obj);
+static void BspTimer_DMA_Start(BspTimerPWMObj_TypeDef *obj);
+static bool BspTimer_Set_Bidir(BspTimerPWMObj_TypeDef *obj, uint32_t capture_addr, uint32_t capture_size);
+static uint32_t BspTimer_Get_Capture(BspTimerPWMObj_TypeDef *obj);
+static bool BspTimer_Burst_Init(BspTimerBurstObj_TypeDef *obj,
+                                void *instance,
+                                const uint32_t *ch,
+                                const BspGPIO_Obj_TypeDef *pin,
+                                uint8_t ch_num,
+                                uint8_t dma,
+                                uint8_t stream,
+                                uint32_t buf_addr,
+                                uint32_t frame_size);
+static void BspTimer_Burst_SetPreScale(BspTimerBurstObj_TypeDef *obj, uint32_t prescale);
+static void BspTimer_Burst_SetAutoReload(BspTimerBurstObj_TypeDef *obj, uint32_t auto_reload);
+static void BspTimer_Burst_PWM_Start(BspTimerBurstObj_TypeDef *obj);
+static void BspTimer_Burst_DMA_Start(BspTimerBurstObj_TypeDef *obj);
+static bool BspTimer_Tick_Init(BspTimerTickObj_TypeDef *obj, uint32_t perscale, uint32_t period);
+static void BspTimer_Tick_Set_Callback(BspTimerTickObj_TypeDef *obj, BspTimer_Tick_Callback cb);
+static bool BspTimer_Tick_Start(BspTimerTickObj_TypeDef *obj);
+static bool BspTimer_Tick_Stop(BspTimerTickObj_TypeDef *obj);
+static bool BspTimer_Tick_Reset(BspTimerTickObj_TypeDef *obj);
+static void BspTimer_Tick_Check_Counter(BspTimerTickObj_TypeDef *obj);
+static void BspTimer_Tick_Trim_Reload(BspTimerTickObj_TypeDef *obj, uint32_t reload_val);
+static void BspTimer_Tick_Trim_Counter(BspTimerTickObj_TypeDef *obj, uint32_t counter_val);
+
+BspTimerPWM_TypeDef BspTimer_PWM = {
+    .init = BspTimer_PWM_Init,
+    .set_prescaler = BspTimer_SetPreScale,
+    .set_autoreload = BspTimer_SetAutoReload,
+    .start_pwm = BspTimer_PWM_Start,
+    .dma_trans = BspTimer_DMA_Start,
+    .set_bidir = BspTimer_Set_Bidir,
+    .get_capture = BspTimer_Get_Capture,
+};
+
+BspTimerBurst_TypeDef BspTimer_Burst = {
+    .init = BspTimer_Burst_Init,
+    .set_prescaler = BspTimer_Burst_SetPreScale,
+    .set_autoreload = BspTimer_Burst_SetAutoReload,
+    .start_pwm = BspTimer_Burst_PWM_Start,
+    .dma_trans = BspTimer_Burst_DMA_Start,
+};
+
+BspTimerTick_TypeDef BspTimer_Tick = {
+    .init = BspTimer_Tick_Init,
+    .set_callback = BspTimer_Tick_Set_Callback,
+    .start = BspTimer_Tick_Start,
+    .stop = BspTimer_Tick_Stop,
+    .reset = BspTimer_Tick_Reset,
+    .check_counter = BspTimer_Tick_Check_Counter,
+    .trim_reload = BspTimer_Tick_Trim_Reload,
+    .trim_counter = BspTimer_Tick_Trim_Counter,
+};
+
+/***************************************************************** General Function ***********************************************************************/
+static int8_t BspTimer_Get_Channel_Index(uint32_t ch)
+{
+    switch (ch)
+    {
+        case TIM_CHANNEL_1: return 0;
+        case TIM_CHANNEL_2: return 1;
+        case TIM_CHANNEL_3: return 2;
+        case TIM_CHANNEL_4: return 3;
+        default: return -1;
+    }
+}
+
+/***************************************************************** PWM Function ***********************************************************************/
+static bool BspTimer_PWM_Init(BspTimerPWMObj_TypeDef *obj,
+                              void *instance,
+                              uint32_t ch,
+                              BspGPIO_Obj_TypeDef pin,
+                              uint8_t dma,
+                              uint8_t stream,
+                              uint32_t buf_aadr,
+                              uint32_t buf_size)
+{
+    UNUSED(pin);
+
+    if ((obj == NULL) || \
+        (obj->tim_hdl == NULL) || \
+        (obj->dma_hdl == NULL) || \
+        (instance == NULL) || \
+        (BspTimer_Get_Channel_Index(ch) < 0))
+        return false;
+
+    obj->instance = instance;
+    obj->tim_channel = ch;
+    obj->dma = dma;
+    obj->stream = stream;
+    obj->buffer_addr = buf_aadr;
+    obj->buffer_size = buf_size;
+    obj->bidir = false;
+
+    memset(obj->tim_hdl, 0, sizeof(TIM_HandleTypeDef));
+    To_TIM_Handle_Ptr(obj->tim_hdl)->Instance = instance;
+
+    return true;
+}
+
+static void BspTimer_SetPreScale(BspTimerPWMObj_TypeDef *obj, uint32_t prescale)
+{
+    obj->prescale = prescale;
+    if (obj->tim_hdl)
+        To_TIM_Handle_Ptr(obj->tim_hdl)->Prescaler = prescale;
+}
+
+static void BspTimer_SetAutoReload(BspTimerPWMObj_TypeDef *obj, uint32_t auto_reload)
+{
+    obj->auto_reload = auto_reload;
+    if (obj->tim_hdl)
+        To_TIM_Handle_Ptr(obj->tim_hdl)->Period = auto_reload;
+}
+
+static void BspTimer_PWM_Start(BspTimerPWMObj_TypeDef *obj)
+{
+    UNUSED(obj);
+}
+
+static void BspTimer_DMA_Start(BspTimerPWMObj_TypeDef *obj)
+{
+    if ((obj == NULL) || (obj->tim_hdl == NULL) || (obj->buffer_addr == 0) || (obj->buffer_size == 0))
+        return;
+
+    if (BspTimer_FrameSink)
+        BspTimer_FrameSink(obj->instance, obj->tim_channel, (const uint32_t *)(uintptr_t)obj->buffer_addr, obj->buffer_size, 1, obj->auto_reload);
+}
+
+static bool BspTimer_Set_Bidir(BspTimerPWMObj_TypeDef *obj, uint32_t capture_addr, uint32_t capture_size)
+{
+    if ((obj == NULL) || (obj->tim_hdl == NULL) || (capture_addr == 0) || (capture_size == 0))
+        return false;
+
+    obj->capture_addr = capture_addr;
+    obj->capture_size = capture_size;
+    obj->capture_cnt = 0;
+    obj->bidir = true;
+
+    return true;
+}
+
+static uint32_t BspTimer_Get_Capture(BspTimerPWMObj_TypeDef *obj)
+{
+    UNUSED(obj);
+    return 0;
+}
+
+/***************************************************************** Burst Function ***********************************************************************/
+static bool BspTimer_Burst_Init(BspTimerBurstObj_TypeDef *obj,
+                                void *instance,
+                                const uint32_t *ch,
+                                const BspGPIO_Obj_TypeDef *pin,
+                                uint8_t ch_num,
+                                uint8_t dma,
+                                uint8_t stream,
+                                uint32_t buf_addr,
+                                uint32_t frame_size)
+{
+    int8_t ch_index = 0;
+    uint8_t ch_min = BSP_TIMER_BURST_MAX_CH;
+    uint8_t ch_max = 0;
+
+    if ((obj == NULL) || \
+        (obj->tim_hdl == NULL) || \
+        (obj->dma_hdl == NULL) || \
+        (instance == NULL) || \
+        (ch == NULL) || \
+        (pin == NULL) || \
+        (ch_num == 0) || \
+        (ch_num > BSP_TIMER_BURST_MAX_CH) || \
+        (buf_addr == 0) || \
+        (frame_size == 0))
+        return false;
+
+    for (uint8_t i = 0; i < ch_num; i++)
+    {
+        ch_index = BspTimer_Get_Channel_Index(ch[i]);
+        if (ch_index < 0)
+            return false;
+
+        if (ch_index < ch_min)
+            ch_min = ch_index;
+
+        if (ch_index > ch_max)
+            ch_max = ch_index;
+    }
+
+    obj->base_ch = ch_min;
+    obj->burst_len = ch_max - ch_min + 1;
+    obj->ch_mask = 0;
+    for (uint8_t i = 0; i < ch_num; i++)
+    {
+        obj->slot[i] = BspTimer_Get_Channel_Index(ch[i]) - ch_min;
+        obj->ch_mask |= 1 << obj->slot[i];
+    }
+
+    obj->instance = instance;
+    obj->dma = dma;
+    obj->stream = stream;
+    obj->buffer_addr = buf_addr;
+    obj->buffer_size = frame_size * obj->burst_len;
+
+    memset(obj->tim_hdl, 0, sizeof(TIM_HandleTypeDef));
+    To_TIM_Handle_Ptr(obj->tim_hdl)->Instance = instance;
+
+    return true;
+}
+
+static void BspTimer_Burst_PWM_Start(BspTimerBurstObj_TypeDef *obj)
+{
+    UNUSED(obj);
+}
+
+static void BspTimer_Burst_DMA_Start(BspTimerBurstObj_TypeDef *obj)
+{
+    if ((obj == NULL) || (obj->tim_hdl == NULL) || (obj->buffer_addr == 0) || (obj->buffer_size == 0))
+        return;
+
+    if (BspTimer_FrameSink == NULL)
+        return;
+
+    /* one sink call per channel in use, ccr of the channel step by burst_len in the interleaved buffer */
+    for (uint8_t i = 0; i < obj->burst_len; i++)
+    {
+        if (obj->ch_mask & (1 << i))
+        {
+            BspTimer_FrameSink(obj->instance,
+                               (uint32_t)(obj->base_ch + i) << 2,
+                               (const uint32_t *)(uintptr_t)obj->buffer_addr + i,
+                               obj->buffer_size / obj->burst_len,
+                               obj->burst_len,
+                               obj->auto_reload);
+        }
+    }
+}
+
+static void BspTimer_Burst_SetPreScale(BspTimerBurstObj_TypeDef *obj, uint32_t prescale)
+{
+    obj->prescale = prescale;
+    if (obj->tim_hdl)
+        To_TIM_Handle_Ptr(obj->tim_hdl)->Prescaler = prescale;
+}
+
+static void BspTimer_Burst_SetAutoReload(BspTimerBurstObj_TypeDef *obj, uint32_t auto_reload)
+{
+    obj->auto_reload = auto_reload;
+    if (obj->tim_hdl)
+        To_TIM_Handle_Ptr(obj->tim_hdl)->Period = auto_reload;
+}
+
+/***************************************************************** Tick Function ***********************************************************************/
+static bool BspTimer_Tick_Init(BspTimerTickObj_TypeDef *obj, uint32_t perscale, uint32_t period)
+{
+    if ((obj == NULL) || (obj->tim_hdl == NULL) || (obj->instance == NULL))
+        return false;
+
+    obj->prescale = perscale;
+    obj->auto_reload = period;
+
+    memset(obj->tim_hdl, 0, sizeof(TIM_HandleTypeDef));
+    To_TIM_Handle_Ptr(obj->tim_hdl)->Instance = obj->instance;
+    To_TIM_Handle_Ptr(obj->tim_hdl)->Prescaler = perscale;
+    To_TIM_Handle_Ptr(obj->tim_hdl)->Period = period;
+
+    return true;
+}
+
+static void BspTimer_Tick_Set_Callback(BspTimerTickObj_TypeDef *obj, BspTimer_Tick_Callback cb)
+{
+    if (obj)
+        obj->tick_callback = cb;
+}
+
+static bool BspTimer_Tick_Start(BspTimerTickObj_TypeDef *obj)
+{
+    return (obj && obj->tim_hdl);
+}
+
+static bool BspTimer_Tick_Stop(BspTimerTickObj_TypeDef *obj)
+{
+    return (obj && obj->tim_hdl);
+}
+
+static bool BspTimer_Tick_Reset(BspTimerTickObj_TypeDef *obj)
+{
+    return (obj && obj->tim_hdl);
+}
+
+static void BspTimer_Tick_Check_Counter(BspTimerTickObj_TypeDef *obj)
+{
+    UNUSED(obj);
+}
+
+static void BspTimer_Tick_Trim_Reload(BspTimerTickObj_TypeDef *obj, uint32_t reload_val)
+{
+    if (obj && obj->tim_hdl)
+        To_TIM_Handle_Ptr(obj->tim_hdl)->Period = reload_val;
+}
+
+static void BspTimer_Tick_Trim_Counter(BspTimerTickObj_TypeDef *obj, uint32_t counter_val)
+{
+    UNUSED(obj);
+    UNUSED(counter_val);
+}
+
+/************************************************** Simulation Section ************************************************/
+void BspTimer_Sitl_Set_FrameSink(BspTimer_Sitl_Frame_Callback callback)
+{
+    BspTimer_FrameSink = callback;
+}
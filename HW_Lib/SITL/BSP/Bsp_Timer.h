@@ -0,0 +1,40 @@
+#ifndef __BSP_TIMER_H
+#define __BSP_TIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "Bsp_Timer_Port_Def.h"
+#include "Bsp_DMA.h"
+#include "Bsp_GPIO.h"
+#include "sitl_hal.h"
+
+#define TIM_HandleType_Size sizeof(TIM_HandleTypeDef)
+#define TIM_DMA_HandleType_Size sizeof(DMA_HandleTypeDef)
+
+typedef enum
+{
+    BspTimer_1 = 0,
+    BspTimer_2,
+    BspTimer_3,
+    BspTimer_4,
+    BspTimer_5,
+    BspTimer_6,
+    BspTimer_7,
+    BspTimer_8,
+    BspTimer_TickObj_Sum,
+}BspTimer_Instance_List;
+
+/*
+ * simulation side
+ * every dma triggered output frame is handed to the sink with the compare value of each channel
+ * buffer layout is kept as the target, pwm : one ccr per bit, burst : burst_len ccr per bit
+ */
+typedef void (*BspTimer_Sitl_Frame_Callback)(TIM_TypeDef *instance, uint32_t channel, const uint32_t *ccr, uint32_t bit_num, uint32_t stride, uint32_t auto_reload);
+
+void BspTimer_Sitl_Set_FrameSink(BspTimer_Sitl_Frame_Callback callback);
+
+extern BspTimerPWM_TypeDef BspTimer_PWM;
+extern BspTimerBurst_TypeDef BspTimer_Burst;
+extern BspTimerTick_TypeDef BspTimer_Tick;
+
+#endif
@@ -0,0 +1,154 @@
+/*
+ * host stand in of the usb vcp
+ * tx is written to the bound host descriptor and complete at once
+ * rx is read by a host thread and delivered to the firmware in isr context
+ */
+#include "Bsp_USB.h"
+#include "sitl_hal.h"
+#include "FreeRTOS.h"
+#include "profiler.h"
+#include <unistd.h>
+
+#define BSP_USB_SITL_RX_SIZE 64
+
+/* internal variable */
+static BspUSB_VCP_Obj_TypeDef BspUSB_VCPMonitor = {
+    .init_state = BspUSB_None_Init,
+};
+static int BspUSB_Rx_FD = -1;
+static int BspUSB_Tx_FD = -1;
+
+/* internal function */
+static void *BspUSB_VCP_Rx_Thread(void *arg);
+
+/* external function */
+static BspUSB_Error_List BspUSB_VCP_Init(uint32_t cus_data_addr);
+static BspUSB_Error_List BspUSB_VCP_SendData(uint8_t *p_data, uint16_t len);
+static void BspUSB_VCP_Set_Rx_Callback(BspUSB_Rx_Callback_Def callback);
+static void BspUSB_VCP_Set_Tx_CPLT_Callback(BspUSB_Tx_Cplt_Callback_Def callback);
+static BspUSB_VCP_TxStatistic_TypeDef BspUSB_VCP_Get_TxStatistic(void);
+static BspUSB_Error_List BspUSB_VCP_DeInit(void);
+
+BspUSB_VCP_TypeDef BspUSB_VCP = {
+    .init = BspUSB_VCP_Init,
+    .de_init = BspUSB_VCP_DeInit,
+    .send = BspUSB_VCP_SendData,
+    .set_rx_callback = BspUSB_VCP_Set_Rx_Callback,
+    .set_tx_cpl_callback = BspUSB_VCP_Set_Tx_CPLT_Callback,
+    .get_tx_statistic = BspUSB_VCP_Get_TxStatistic,
+};
+
+static BspUSB_Error_List BspUSB_VCP_DeInit(void)
+{
+    if (BspUSB_VCPMonitor.init_state == BspUSB_Error_None)
+        BspUSB_VCPMonitor.init_state = BspUSB_None_Init;
+
+    return BspUSB_VCPMonitor.init_state;
+}
+
+static BspUSB_Error_List BspUSB_VCP_Init(uint32_t cus_data_addr)
+{
+    if (BspUSB_VCPMonitor.init_state == BspUSB_None_Init)
+    {
+        if ((BspUSB_Rx_FD >= 0) && !SitlPort_Thread_Create(BspUSB_VCP_Rx_Thread, NULL))
+        {
+            BspUSB_VCPMonitor.init_state = BspUSB_Error_Init;
+            return BspUSB_Error_Init;
+        }
+
+        BspUSB_VCPMonitor.init_state = BspUSB_Error_None;
+        BspUSB_VCPMonitor.cus_data_addr = cus_data_addr;
+    }
+
+    return BspUSB_VCPMonitor.init_state;
+}
+
+static BspUSB_Error_List BspUSB_VCP_SendData(uint8_t *p_data, uint16_t len)
+{
+    uint32_t size = len;
+
+    if ((BspUSB_VCPMonitor.init_state != BspUSB_Error_None) || (p_data == NULL) || (len == 0))
+        return BspUSB_Error_Fail;
+
+    BspUSB_VCPMonitor.tx_cnt++;
+    if ((BspUSB_Tx_FD >= 0) && (write(BspUSB_Tx_FD, p_data, len) != len))
+    {
+        BspUSB_VCPMonitor.tx_err_cnt++;
+        return BspUSB_Error_Fail;
+    }
+
+    BspUSB_VCPMonitor.tx_byte_sum += len;
+
+    SitlPort_Isr_Enter();
+
+    Profiler.isr_enter(Profiler_Isr_USB);
+    BspUSB_VCPMonitor.tx_fin_cnt++;
+    if (BspUSB_VCPMonitor.tx_fin_callback)
+        BspUSB_VCPMonitor.tx_fin_callback(BspUSB_VCPMonitor.cus_data_addr, p_data, &size);
+    Profiler.isr_exit(Profiler_Isr_USB);
+    SitlPort_Isr_Exit();
+
+    return BspUSB_Error_None;
+}
+
+static BspUSB_VCP_TxStatistic_TypeDef BspUSB_VCP_Get_TxStatistic(void)
+{
+    BspUSB_VCP_TxStatistic_TypeDef statistic;
+
+    statistic.tx_cnt = BspUSB_VCPMonitor.tx_cnt;
+    statistic.tx_abort = BspUSB_VCPMonitor.tx_abort_cnt;
+    statistic.tx_fin_cnt = BspUSB_VCPMonitor.tx_fin_cnt;
+    statistic.tx_err_cnt = BspUSB_VCPMonitor.tx_err_cnt;
+
+    return statistic;
+}
+
+static void BspUSB_VCP_Set_Rx_Callback(BspUSB_Rx_Callback_Def callback)
+{
+    BspUSB_VCPMonitor.rx_callback = callback;
+}
+
+static void BspUSB_VCP_Set_Tx_CPLT_Callback(BspUSB_Tx_Cplt_Callback_Def callback)
+{
+    BspUSB_VCPMonitor.tx_fin_callback = callback;
+}
+
+/* host thread, stand for the usb rx irq */
+static void *BspUSB_VCP_Rx_Thread(void *arg)
+{
+    uint8_t rx_buf[BSP_USB_SITL_RX_SIZE];
+    ssize_t len = 0;
+
+    UNUSED(arg);
+
+    while (true)
+    {
+        len = read(BspUSB_Rx_FD, rx_buf, sizeof(rx_buf));
+        if (len <= 0)
+            break;
+
+        SitlPort_Isr_Enter();
+
+        Profiler.isr_enter(Profiler_Isr_USB);
+        BspUSB_VCPMonitor.rx_byte_sum += len;
+        BspUSB_VCPMonitor.rx_irq_cnt++;
+
+        if (BspUSB_VCPMonitor.rx_callback)
+            BspUSB_VCPMonitor.rx_callback(BspUSB_VCPMonitor.cus_data_addr, rx_buf, len);
+        Profiler.isr_exit(Profiler_Isr_USB);
+        SitlPort_Isr_Exit();
+    }
+
+    return NULL;
+}
+
+/************************************************** Simulation Section ************************************************/
+bool BspUSB_VCP_Sitl_Bind(int rx_fd, int tx_fd)
+{
+    if (BspUSB_VCPMonitor.init_state != BspUSB_None_Init)
+        return false;
+
+    BspUSB_Rx_FD = rx_fd;
+    BspUSB_Tx_FD = tx_fd;
+    return true;
+}
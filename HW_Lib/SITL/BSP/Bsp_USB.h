@@ -0,0 +1,14 @@
+#ifndef __BSP_USB_H
+#define __BSP_USB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "Bsp_USB_Port_Def.h"
+
+/* simulation side, vcp stream mapped on host file descriptor */
+bool BspUSB_VCP_Sitl_Bind(int rx_fd, int tx_fd);
+
+extern BspUSB_VCP_TypeDef BspUSB_VCP;
+
+#endif
@@ -0,0 +1,230 @@
+/*
+ * host stand in of the uart port
+ * port with rx dma is driven in idle line mode: one pushed frame land in rx_buf and raise one callback
+ * port without rx dma is driven in byte mode: one callback per byte
+ * transmit finish at once, tx complete callback run in isr context
+ */
+#include "Bsp_Uart.h"
+#include "FreeRTOS.h"
+#include "profiler.h"
+#include "evt_trace.h"
+
+#define To_Uart_Instance(x) ((USART_TypeDef *)x)
+#define To_Uart_Handle_Ptr(x) ((UART_HandleTypeDef *)x)
+
+/* external vriable */
+USART_TypeDef SitlHal_UART[SITL_UART_SUM] = {{.id = 1}, {.id = 2}, {.id = 3}, {.id = 4}, {.id = 5}, {.id = 6}, {.id = 7}, {.id = 8}};
+
+/* internal variable */
+static BspUARTObj_TypeDef *BspUart_Obj_List[BspUART_Port_Sum] = {NULL};
+static BspUart_Sitl_Tx_Callback BspUart_TxHook_List[BspUART_Port_Sum] = {NULL};
+
+/* internal function */
+static int8_t BspUart_Get_Index(USART_TypeDef *instance);
+
+/* external function */
+static bool BspUart_Init(BspUARTObj_TypeDef *obj);
+static bool BspUart_Set_DataBit(BspUARTObj_TypeDef *obj, uint32_t bit);
+static bool BspUart_Set_Parity(BspUARTObj_TypeDef *obj, uint32_t parity);
+static bool BspUart_Set_StopBit(BspUARTObj_TypeDef *obj, uint32_t stop_bit);
+static bool BspUart_Swap_Pin(BspUARTObj_TypeDef *obj, bool swap);
+static bool BspUart_Transfer(BspUARTObj_TypeDef *obj, uint8_t *tx_buf, uint32_t size);
+static bool BspUart_Set_Rx_Callback(BspUARTObj_TypeDef *obj, BspUART_Callback callback);
+static bool BspUart_Set_Tx_Callback(BspUARTObj_TypeDef *obj, BspUART_Callback callback);
+
+BspUART_TypeDef BspUart = {
+    .init = BspUart_Init,
+    .set_parity = BspUart_Set_Parity,
+    .set_stop_bit = BspUart_Set_StopBit,
+    .set_data_bit = BspUart_Set_DataBit,
+    .set_swap = BspUart_Swap_Pin,
+    .send = BspUart_Transfer,
+    .set_rx_callback = BspUart_Set_Rx_Callback,
+    .set_tx_callback = BspUart_Set_Tx_Callback,
+};
+
+static int8_t BspUart_Get_Index(USART_TypeDef *instance)
+{
+    if (instance == USART1)
+        return BspUART_Port_1;
+    else if (instance == UART4)
+        return BspUART_Port_4;
+    else if (instance == USART6)
+        return BspUART_Port_6;
+    else if (instance == UART7)
+        return BspUART_Port_7;
+
+    return Bspuart_None_Index;
+}
+
+static bool BspUart_Init(BspUARTObj_TypeDef *obj)
+{
+    int8_t port_index = Bspuart_None_Index;
+
+    if (obj == NULL)
+        return false;
+
+    obj->init_state = false;
+
+    port_index = BspUart_Get_Index(To_Uart_Instance(obj->instance));
+    if ((port_index < 0) || (obj->hdl == NULL) || (obj->rx_buf == NULL) || (obj->rx_size == 0))
+        return false;
+
+    memset(obj->hdl, 0, sizeof(UART_HandleTypeDef));
+    To_Uart_Handle_Ptr(obj->hdl)->Instance = To_Uart_Instance(obj->instance);
+    To_Uart_Handle_Ptr(obj->hdl)->BaudRate = obj->baudrate;
+
+    obj->irq_type = (obj->rx_dma == Bsp_DMA_None) ? BspUart_IRQ_Type_Byte : BspUart_IRQ_Type_Idle;
+    memset(&(obj->monitor), 0, sizeof(obj->monitor));
+
+    BspUart_Obj_List[port_index] = obj;
+    obj->init_state = true;
+
+    return true;
+}
+
+static bool BspUart_Set_DataBit(BspUARTObj_TypeDef *obj, uint32_t bit)
+{
+    if ((obj == NULL) || (obj->hdl == NULL))
+        return false;
+
+    To_Uart_Handle_Ptr(obj->hdl)->WordLength = bit;
+    return true;
+}
+
+static bool BspUart_Set_Parity(BspUARTObj_TypeDef *obj, uint32_t parity)
+{
+    if ((obj == NULL) || (obj->hdl == NULL))
+        return false;
+
+    To_Uart_Handle_Ptr(obj->hdl)->Parity = parity;
+    return true;
+}
+
+static bool BspUart_Set_StopBit(BspUARTObj_TypeDef *obj, uint32_t stop_bit)
+{
+    if ((obj == NULL) || (obj->hdl == NULL))
+        return false;
+
+    To_Uart_Handle_Ptr(obj->hdl)->StopBits = stop_bit;
+    return true;
+}
+
+static bool BspUart_Swap_Pin(BspUARTObj_TypeDef *obj, bool swap)
+{
+    if (obj == NULL)
+        return false;
+
+    obj->pin_swap = swap;
+    return true;
+}
+
+static bool BspUart_Transfer(BspUARTObj_TypeDef *obj, uint8_t *tx_buf, uint32_t size)
+{
+    int8_t index = Bspuart_None_Index;
+
+    if ((obj == NULL) || !obj->init_state || (tx_buf == NULL) || (size == 0))
+        return false;
+
+    /* last pack still in transmitting */
+    if (obj->monitor.tx_success_cnt != obj->monitor.tx_cnt)
+        return false;
+
+    index = BspUart_Get_Index(To_Uart_Instance(obj->instance));
+    obj->monitor.tx_cnt++;
+
+    if ((index >= 0) && BspUart_TxHook_List[index])
+        BspUart_TxHook_List[index](tx_buf, size);
+
+    SitlPort_Isr_Enter();
+
+    Profiler.isr_enter(Profiler_Isr_Uart);
+    EvtTrace.record(EvtTrace_Uart_Tx, index, 0);
+    obj->monitor.tx_success_cnt++;
+    if (obj->TxCallback)
+        obj->TxCallback((uint8_t *)(uintptr_t)obj->cust_data_addr, NULL, 0);
+    Profiler.isr_exit(Profiler_Isr_Uart);
+    SitlPort_Isr_Exit();
+
+    return true;
+}
+
+static bool BspUart_Set_Rx_Callback(BspUARTObj_TypeDef *obj, BspUART_Callback callback)
+{
+    if (obj)
+    {
+        obj->RxCallback = callback;
+        return true;
+    }
+
+    return false;
+}
+
+static bool BspUart_Set_Tx_Callback(BspUARTObj_TypeDef *obj, BspUART_Callback callback)
+{
+    if (obj)
+    {
+        obj->TxCallback = callback;
+        return true;
+    }
+
+    return false;
+}
+
+/************************************************** Simulation Section ************************************************/
+bool BspUart_Sitl_Rx(USART_TypeDef *instance, const uint8_t *p_data, uint16_t size)
+{
+    int8_t index = BspUart_Get_Index(instance);
+    BspUARTObj_TypeDef *obj = NULL;
+    uint16_t len = 0;
+
+    if ((index < 0) || (p_data == NULL) || (size == 0))
+        return false;
+
+    obj = BspUart_Obj_List[index];
+    if ((obj == NULL) || !obj->init_state)
+        return false;
+
+    SitlPort_Isr_Enter();
+
+    Profiler.isr_enter(Profiler_Isr_Uart);
+    EvtTrace.record(EvtTrace_Uart_Rx, index, size);
+    if (obj->irq_type == BspUart_IRQ_Type_Idle)
+    {
+        len = (size > obj->rx_size) ? obj->rx_size : size;
+        if (len < size)
+            obj->monitor.rx_full_cnt++;
+
+        memcpy(obj->rx_buf, p_data, len);
+        if (obj->RxCallback)
+            obj->RxCallback((uint8_t *)(uintptr_t)obj->cust_data_addr, obj->rx_buf, len);
+
+        obj->monitor.rx_cnt++;
+    }
+    else
+    {
+        for (uint16_t i = 0; i < size; i++)
+        {
+            obj->rx_single_byte = p_data[i];
+            if (obj->RxCallback)
+                obj->RxCallback((uint8_t *)(uintptr_t)obj->cust_data_addr, &obj->rx_single_byte, 1);
+
+            obj->monitor.rx_cnt++;
+        }
+    }
+    Profiler.isr_exit(Profiler_Isr_Uart);
+    SitlPort_Isr_Exit();
+
+    return true;
+}
+
+bool BspUart_Sitl_Set_TxHook(USART_TypeDef *instance, BspUart_Sitl_Tx_Callback callback)
+{
+    int8_t index = BspUart_Get_Index(instance);
+
+    if (index < 0)
+        return false;
+
+    BspUart_TxHook_List[index] = callback;
+    return true;
+}
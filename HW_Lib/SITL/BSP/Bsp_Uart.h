@@ -0,0 +1,36 @@
+#ifndef __BSP_UART_H
+#define __BSP_UART_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "Bsp_Uart_Port_Def.h"
+#include "Bsp_GPIO.h"
+#include "Bsp_DMA.h"
+#include "sitl_hal.h"
+
+#define UART_HandleType_Size sizeof(UART_HandleTypeDef)
+#define UART_DMA_Handle_Size sizeof(DMA_HandleTypeDef)
+
+typedef enum
+{
+    BspUART_Port_1 = 0,
+    BspUART_Port_4,
+    BspUART_Port_6,
+    BspUART_Port_7,
+    BspUART_Port_Sum,
+} BspUART_Port_List;
+
+/*
+ * simulation side
+ * rx push byte stream into the port as one idle line frame (dma port) or byte by byte (irq port)
+ * tx hook see every byte the firmware send, called from the sender context
+ */
+typedef void (*BspUart_Sitl_Tx_Callback)(const uint8_t *p_data, uint32_t size);
+
+bool BspUart_Sitl_Rx(USART_TypeDef *instance, const uint8_t *p_data, uint16_t size);
+bool BspUart_Sitl_Set_TxHook(USART_TypeDef *instance, BspUart_Sitl_Tx_Callback callback);
+
+extern BspUART_TypeDef BspUart;
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*
+ * host simulation build of the os
+ * scheduling parameter (tick, priority, heap, stack depth) stay the same as the target config
+ * so task timing and heap usage measured on host are comparable
+ */
+#include <stdint.h>
+
+void SitlPort_Assert(const char *file, int line);
+uint32_t Kernel_Get_CycleCnt(void);
+
+/* trace hook implemented by the sitl statistic module, all called with scheduler locked */
+void SitlTrace_Task_SwitchIn(void *task);
+void SitlTrace_Task_SwitchOut(void *task);
+void SitlTrace_Task_Delay(void *task);
+
+/* firmware event trace ring, recorded next to the sitl statistic */
+void EvtTrace_Task_SwitchIn(uint32_t number);
+void EvtTrace_Task_SwitchOut(uint32_t number);
+
+#define configENABLE_FPU                         1
+#define configENABLE_MPU                         0
+#define configUSE_PREEMPTION                     1
+#define configSUPPORT_STATIC_ALLOCATION          1
+#define configSUPPORT_DYNAMIC_ALLOCATION         1
+#define configUSE_IDLE_HOOK                      1
+#define configUSE_TICK_HOOK                      0
+#define configCPU_CLOCK_HZ                       ( 1000000000UL )
+#define configTICK_RATE_HZ                       ((TickType_t)1000)
+#define configMAX_PRIORITIES                     ( 5 )
+#define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
+#define configTOTAL_HEAP_SIZE                    ((size_t)(128 * 1024))
+#define configMAX_TASK_NAME_LEN                  ( 16 )
+#define configUSE_16_BIT_TICKS                   0
+#define configUSE_MUTEXES                        1
+#define configQUEUE_REGISTRY_SIZE                32
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION  0
+#define configMESSAGE_BUFFER_LENGTH_TYPE         size_t
+#define configUSE_CO_ROUTINES                    0
+#define configMAX_CO_ROUTINE_PRIORITIES          ( 2 )
+#define configUSE_COUNTING_SEMAPHORES            1
+#define configAPPLICATION_ALLOCATED_HEAP         1
+
+#define INCLUDE_vTaskPrioritySet             1
+#define INCLUDE_uxTaskPriorityGet            1
+#define INCLUDE_vTaskDelete                  1
+#define INCLUDE_vTaskCleanUpResources        0
+#define INCLUDE_vTaskSuspend                 1
+#define INCLUDE_vTaskDelayUntil              1
+#define INCLUDE_vTaskDelay                   1
+#define INCLUDE_xTaskGetSchedulerState       1
+#define INCLUDE_uxTaskGetStackHighWaterMark  1
+#define INCLUDE_xTaskGetCurrentTaskHandle    1
+
+#define configUSE_TRACE_FACILITY                 1
+#define configGENERATE_RUN_TIME_STATS            1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()         Kernel_Get_CycleCnt()
+
+#define configASSERT( x ) if ((x) == 0) { SitlPort_Assert(__FILE__, __LINE__); }
+
+#define traceTASK_SWITCHED_IN()         do { SitlTrace_Task_SwitchIn(pxCurrentTCB); EvtTrace_Task_SwitchIn(pxCurrentTCB->uxTCBNumber); } while (0)
+#define traceTASK_SWITCHED_OUT()        do { EvtTrace_Task_SwitchOut(pxCurrentTCB->uxTCBNumber); SitlTrace_Task_SwitchOut(pxCurrentTCB); } while (0)
+#define traceTASK_DELAY_UNTIL(x)        SitlTrace_Task_Delay(pxCurrentTCB)
+#define traceTASK_DELAY()               SitlTrace_Task_Delay(pxCurrentTCB)
+
+#endif /* FREERTOS_CONFIG_H */
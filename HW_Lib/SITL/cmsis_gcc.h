@@ -0,0 +1,21 @@
+#ifndef __CMSIS_GCC_H
+#define __CMSIS_GCC_H
+
+/*
+ * core intrinsic of the host simulation target
+ * ipsr report the port isr context, so cmsis_os pick the FromISR api the same way as on target
+ */
+#include <stdint.h>
+#include "FreeRTOS.h"
+
+#define __DSB() __sync_synchronize()
+#define __DMB() __sync_synchronize()
+#define __ISB() __sync_synchronize()
+#define __NOP()
+
+__STATIC_INLINE uint32_t __get_IPSR(void)
+{
+    return (uint32_t)SitlPort_In_Isr();
+}
+
+#endif
@@ -0,0 +1,243 @@
+#ifndef __SITL_HAL_H
+#define __SITL_HAL_H
+
+/*
+ * peripheral handle and register name of the host simulation target
+ * same name as stm32h7 hal, so the firmware code under STM32H743xx / MATEKH743_V1_5 compile as it is
+ * instance is a plain ram object, the simulated device model use its address as the bus id
+ */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define SITL_GPIO_PORT_SUM  11
+#define SITL_SPI_SUM        6
+#define SITL_UART_SUM       8
+#define SITL_TIM_SUM        17
+#define SITL_SDMMC_SUM      2
+
+#define UNUSED(x) ((void)(x))
+
+/* gpio */
+typedef struct
+{
+    uint8_t id;
+    volatile uint16_t odr;
+    volatile uint16_t idr;
+} GPIO_TypeDef;
+
+extern GPIO_TypeDef SitlHal_GPIO[SITL_GPIO_PORT_SUM];
+
+#define GPIOA (&SitlHal_GPIO[0])
+#define GPIOB (&SitlHal_GPIO[1])
+#define GPIOC (&SitlHal_GPIO[2])
+#define GPIOD (&SitlHal_GPIO[3])
+#define GPIOE (&SitlHal_GPIO[4])
+#define GPIOF (&SitlHal_GPIO[5])
+#define GPIOG (&SitlHal_GPIO[6])
+#define GPIOH (&SitlHal_GPIO[7])
+#define GPIOI (&SitlHal_GPIO[8])
+#define GPIOJ (&SitlHal_GPIO[9])
+#define GPIOK (&SitlHal_GPIO[10])
+
+#define GPIO_PIN_0  ((uint16_t)0x0001)
+#define GPIO_PIN_1  ((uint16_t)0x0002)
+#define GPIO_PIN_2  ((uint16_t)0x0004)
+#define GPIO_PIN_3  ((uint16_t)0x0008)
+#define GPIO_PIN_4  ((uint16_t)0x0010)
+#define GPIO_PIN_5  ((uint16_t)0x0020)
+#define GPIO_PIN_6  ((uint16_t)0x0040)
+#define GPIO_PIN_7  ((uint16_t)0x0080)
+#define GPIO_PIN_8  ((uint16_t)0x0100)
+#define GPIO_PIN_9  ((uint16_t)0x0200)
+#define GPIO_PIN_10 ((uint16_t)0x0400)
+#define GPIO_PIN_11 ((uint16_t)0x0800)
+#define GPIO_PIN_12 ((uint16_t)0x1000)
+#define GPIO_PIN_13 ((uint16_t)0x2000)
+#define GPIO_PIN_14 ((uint16_t)0x4000)
+#define GPIO_PIN_15 ((uint16_t)0x8000)
+
+/* alternate function is meaningless on host, keep the name used by board define */
+#define GPIO_AF2_TIM3   2
+#define GPIO_AF2_TIM4   2
+#define GPIO_AF2_TIM5   2
+#define GPIO_AF2_TIM15  2
+#define GPIO_AF4_I2C2   4
+#define GPIO_AF5_SPI1   5
+#define GPIO_AF5_SPI4   5
+#define GPIO_AF6_SPI3   6
+#define GPIO_AF7_USART1 7
+#define GPIO_AF8_UART4  8
+#define GPIO_AF12_SDIO1 12
+
+/* spi */
+typedef struct
+{
+    uint8_t id;
+} SPI_TypeDef;
+
+typedef struct
+{
+    SPI_TypeDef *Instance;
+    uint32_t CLKPolarity;
+    uint32_t CLKPhase;
+    uint32_t BaudRatePrescaler;
+} SPI_HandleTypeDef;
+
+extern SPI_TypeDef SitlHal_SPI[SITL_SPI_SUM];
+
+#define SPI1 (&SitlHal_SPI[0])
+#define SPI2 (&SitlHal_SPI[1])
+#define SPI3 (&SitlHal_SPI[2])
+#define SPI4 (&SitlHal_SPI[3])
+#define SPI5 (&SitlHal_SPI[4])
+#define SPI6 (&SitlHal_SPI[5])
+
+#define SPI_POLARITY_LOW            0
+#define SPI_POLARITY_HIGH           1
+#define SPI_PHASE_1EDGE             0
+#define SPI_PHASE_2EDGE             1
+#define SPI_BAUDRATEPRESCALER_2     2
+#define SPI_BAUDRATEPRESCALER_4     4
+#define SPI_BAUDRATEPRESCALER_8     8
+#define SPI_BAUDRATEPRESCALER_16    16
+#define SPI_BAUDRATEPRESCALER_32    32
+
+/* iic */
+typedef struct
+{
+    uint8_t instance_id;
+    uint32_t ErrorCode;
+} I2C_HandleTypeDef;
+
+typedef struct
+{
+    uint32_t PeriphClockSelection;
+} RCC_PeriphCLKInitTypeDef;
+
+/* dma, error bit keep the same value as stm32h7 hal */
+#define HAL_DMA_ERROR_NONE          (0x00000000U)
+#define HAL_DMA_ERROR_TE            (0x00000001U)
+#define HAL_DMA_ERROR_FE            (0x00000002U)
+#define HAL_DMA_ERROR_DME           (0x00000004U)
+#define HAL_DMA_ERROR_TIMEOUT       (0x00000020U)
+#define HAL_DMA_ERROR_PARAM         (0x00000040U)
+#define HAL_DMA_ERROR_NO_XFER       (0x00000080U)
+#define HAL_DMA_ERROR_NOT_SUPPORTED (0x00000100U)
+#define HAL_DMA_ERROR_SYNC          (0x00000200U)
+#define HAL_DMA_ERROR_REQGEN        (0x00000400U)
+#define HAL_DMA_ERROR_BUSY          (0x00000800U)
+
+typedef struct
+{
+    void *Instance;
+    void *Parent;
+    volatile uint32_t ErrorCode;
+} DMA_HandleTypeDef;
+
+/* uart */
+typedef struct
+{
+    uint8_t id;
+} USART_TypeDef;
+
+typedef struct
+{
+    USART_TypeDef *Instance;
+    uint32_t BaudRate;
+    uint32_t Parity;
+    uint32_t StopBits;
+    uint32_t WordLength;
+} UART_HandleTypeDef;
+
+extern USART_TypeDef SitlHal_UART[SITL_UART_SUM];
+
+#define USART1 (&SitlHal_UART[0])
+#define USART2 (&SitlHal_UART[1])
+#define USART3 (&SitlHal_UART[2])
+#define UART4  (&SitlHal_UART[3])
+#define UART5  (&SitlHal_UART[4])
+#define USART6 (&SitlHal_UART[5])
+#define UART7  (&SitlHal_UART[6])
+#define UART8  (&SitlHal_UART[7])
+
+/* timer */
+typedef struct
+{
+    uint8_t id;
+} TIM_TypeDef;
+
+typedef struct
+{
+    TIM_TypeDef *Instance;
+    uint32_t Prescaler;
+    uint32_t Period;
+} TIM_HandleTypeDef;
+
+extern TIM_TypeDef SitlHal_TIM[SITL_TIM_SUM];
+
+#define TIM1  (&SitlHal_TIM[0])
+#define TIM2  (&SitlHal_TIM[1])
+#define TIM3  (&SitlHal_TIM[2])
+#define TIM4  (&SitlHal_TIM[3])
+#define TIM5  (&SitlHal_TIM[4])
+#define TIM6  (&SitlHal_TIM[5])
+#define TIM7  (&SitlHal_TIM[6])
+#define TIM8  (&SitlHal_TIM[7])
+#define TIM12 (&SitlHal_TIM[11])
+#define TIM15 (&SitlHal_TIM[14])
+#define TIM16 (&SitlHal_TIM[15])
+#define TIM17 (&SitlHal_TIM[16])
+
+#define TIM_CHANNEL_1 0x00000000U
+#define TIM_CHANNEL_2 0x00000004U
+#define TIM_CHANNEL_3 0x00000008U
+#define TIM_CHANNEL_4 0x0000000CU
+
+/* sdmmc */
+typedef struct
+{
+    uint8_t id;
+} SD_TypeDef;
+
+typedef SD_TypeDef SDMMC_TypeDef;
+
+typedef struct
+{
+    uint32_t CardType;
+    uint32_t CardVersion;
+    uint32_t Class;
+    uint32_t RelCardAdd;
+    uint32_t BlockNbr;
+    uint32_t BlockSize;
+    uint32_t LogBlockNbr;
+    uint32_t LogBlockSize;
+    uint32_t CardSpeed;
+} HAL_SD_CardInfoTypeDef;
+
+typedef struct
+{
+    SD_TypeDef *Instance;
+    volatile uint32_t State;
+    volatile uint32_t ErrorCode;
+    uint32_t RxXferSize;
+    uint32_t TxXferSize;
+} SD_HandleTypeDef;
+
+typedef struct
+{
+    void *Instance;
+} MDMA_HandleTypeDef;
+
+extern SD_TypeDef SitlHal_SDMMC[SITL_SDMMC_SUM];
+
+#define SDMMC1 (&SitlHal_SDMMC[0])
+#define SDMMC2 (&SitlHal_SDMMC[1])
+
+#define BLOCKSIZE 512U
+
+/* on chip flash */
+#define FLASH_BANK1_BASE 0x08000000UL
+#define FLASH_BANK_SIZE  0x00100000UL
+
+#endif
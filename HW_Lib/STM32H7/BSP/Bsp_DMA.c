@@ -3,6 +3,7 @@
 #include "stm32h7xx_hal.h"
 #include "stm32h7xx_hal_rcc.h"
 #include "Bsp_DMA.h"
+#include "kernel.h"
 
 static DMA_HandleTypeDef *BspDMA_Map[Bsp_DMA_Sum][Bsp_DMA_Stream_Sum] = {NULL};
 static DMA_HandleTypeDef DataPipe_DMA;
@@ -282,6 +283,10 @@ static bool BspDMA_Pipe_Trans(uint32_t SrcAddress, uint32_t DstAddress, uint32_t
         (DataLength == 0))
         return false;
 
+    /* pipe data object placed in none cacheable perph section, maintenance only for cacheable address */
+    Kernel_DCache_Clean((void *)SrcAddress, DataLength);
+    Kernel_DCache_Invalidate((void *)DstAddress, DataLength);
+
     if(HAL_DMA_Start_IT(&DataPipe_DMA, SrcAddress, DstAddress, DataLength) != HAL_OK)
     {
         HAL_DMA_Abort_IT(&DataPipe_DMA);
@@ -1,4 +1,5 @@
 #include "Bsp_IIC.h"
+#include "evt_trace.h"
 
 #define To_IIC_Handle_Ptr(x) ((I2C_HandleTypeDef *)x)
 #define To_IIC_PeriphCLKInitType(x) ((RCC_PeriphCLKInitTypeDef *)x)
@@ -123,24 +124,30 @@ static bool BspIIC_DeInit(BspIICObj_TypeDef *obj)
 
 static bool BspIIC_Read(BspIICObj_TypeDef *obj, uint16_t dev_addr, uint16_t reg, uint8_t *p_buf, uint16_t len)
 {
+    bool state = false;
+
     if(obj && p_buf && len)
     {
-        if(HAL_I2C_Mem_Read(obj->handle, dev_addr, reg, I2C_MEMADD_SIZE_8BIT, p_buf, len, 100) == HAL_OK)
-            return true;
+        EvtTrace.record(EvtTrace_IIC_Start, (uint8_t)dev_addr, len);
+        state = (HAL_I2C_Mem_Read(obj->handle, dev_addr, reg, I2C_MEMADD_SIZE_8BIT, p_buf, len, 100) == HAL_OK);
+        EvtTrace.record(EvtTrace_IIC_End, state, 0);
     }
 
-    return false;
+    return state;
 }
 
 static bool BspIIC_Write(BspIICObj_TypeDef *obj, uint16_t dev_addr, uint16_t reg, uint8_t *p_buf, uint16_t len)
 {
+    bool state = false;
+
     if(obj && p_buf && len)
     {
-        if(HAL_I2C_Mem_Write(obj->handle, dev_addr, reg, I2C_MEMADD_SIZE_8BIT, p_buf, len, 100) == HAL_OK)
-            return true;
+        EvtTrace.record(EvtTrace_IIC_Start, (uint8_t)dev_addr, len);
+        state = (HAL_I2C_Mem_Write(obj->handle, dev_addr, reg, I2C_MEMADD_SIZE_8BIT, p_buf, len, 100) == HAL_OK);
+        EvtTrace.record(EvtTrace_IIC_End, state, 0);
     }
 
-    return false;
+    return state;
 }
 
 void *BspIIC_Get_HandlePtr(BspIIC_Instance_List index)
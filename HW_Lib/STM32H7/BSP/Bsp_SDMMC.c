@@ -1,4 +1,5 @@
 #include "Bsp_SDMMC.h"
+#include "kernel.h"
 
 static const GPIO_InitTypeDef BspSDMMC_PinCfg = {
     .Mode = GPIO_MODE_AF_PP,
@@ -213,7 +214,10 @@ static bool BspSDMMC_Init(BspSDMMC_Obj_TypeDef *obj)
 
 static bool BspSDMMC_Read(BspSDMMC_Obj_TypeDef *obj, uint32_t *pData, uint32_t ReadAddr, uint32_t NumOfBlocks)
 {
-    HAL_StatusTypeDef state = HAL_SD_ReadBlocks_DMA(&(obj->hdl), pData, ReadAddr, NumOfBlocks);
+    HAL_StatusTypeDef state;
+
+    Kernel_DCache_Invalidate(pData, NumOfBlocks * BLOCKSIZE);
+    state = HAL_SD_ReadBlocks_DMA(&(obj->hdl), pData, ReadAddr, NumOfBlocks);
     if(state == HAL_OK)
         return true;
 
@@ -222,7 +226,10 @@ static bool BspSDMMC_Read(BspSDMMC_Obj_TypeDef *obj, uint32_t *pData, uint32_t R
 
 static bool BspSDMMC_Write(BspSDMMC_Obj_TypeDef *obj, uint32_t *pData, uint32_t WriteAddr, uint32_t NumOfBlocks)
 {
-    HAL_StatusTypeDef state = HAL_SD_WriteBlocks_DMA(&(obj->hdl), pData, WriteAddr, NumOfBlocks);
+    HAL_StatusTypeDef state;
+
+    Kernel_DCache_Clean(pData, NumOfBlocks * BLOCKSIZE);
+    state = HAL_SD_WriteBlocks_DMA(&(obj->hdl), pData, WriteAddr, NumOfBlocks);
     if(state == HAL_OK)
         return true;
 
@@ -282,6 +289,9 @@ void HAL_SD_RxCpltCallback(SD_HandleTypeDef *hsd)
 {
     if (hsd->Instance == SDMMC1)
     {
+        /* drop cache line speculative loaded during idma transfer */
+        Kernel_DCache_Invalidate((void *)hsd->Instance->IDMABASE0, hsd->RxXferSize);
+
         if(BspSCMMC_Callback_List[BspSDMMC_1_Callback].Read_Callback)
         {
             BspSCMMC_Callback_List[BspSDMMC_1_Callback].Read_Callback((uint8_t *)hsd, sizeof(SD_HandleTypeDef));
@@ -1,4 +1,5 @@
 #include "Bsp_SPI.h"
+#include "evt_trace.h"
 
 #define To_SPI_Handle_Ptr(x) ((SPI_HandleTypeDef *)x)
 
@@ -212,24 +213,33 @@ static bool BspSPI_DeInit(BspSPI_NorModeConfig_TypeDef spi_cfg)
 
 static bool BspSPI_Trans(void *spi_instance, uint8_t *tx, uint16_t size, uint16_t time_out)
 {
-    if (HAL_SPI_Transmit(To_SPI_Handle_Ptr(spi_instance), tx, size, time_out) == HAL_OK)
-        return true;
+    bool state = false;
 
-    return false;
+    EvtTrace.record(EvtTrace_SPI_Start, 0, size);
+    state = (HAL_SPI_Transmit(To_SPI_Handle_Ptr(spi_instance), tx, size, time_out) == HAL_OK);
+    EvtTrace.record(EvtTrace_SPI_End, state, 0);
+
+    return state;
 }
 
 static bool BspSPI_Receive(void *spi_instance, uint8_t *rx, uint16_t size, uint16_t time_out)
 {
-    if (HAL_SPI_Receive(To_SPI_Handle_Ptr(spi_instance), rx, size, time_out) == HAL_OK)
-        return true;
+    bool state = false;
+
+    EvtTrace.record(EvtTrace_SPI_Start, 1, size);
+    state = (HAL_SPI_Receive(To_SPI_Handle_Ptr(spi_instance), rx, size, time_out) == HAL_OK);
+    EvtTrace.record(EvtTrace_SPI_End, state, 0);
 
-    return false;
+    return state;
 }
 
 static uint16_t BspSPI_TransReceive(void *spi_instance, uint8_t *tx, uint8_t *rx, uint16_t size, uint16_t time_out)
 {
-    if (HAL_SPI_TransmitReceive(To_SPI_Handle_Ptr(spi_instance), tx, rx, size, time_out) == HAL_OK)
-        return size;
+    bool state = false;
+
+    EvtTrace.record(EvtTrace_SPI_Start, 2, size);
+    state = (HAL_SPI_TransmitReceive(To_SPI_Handle_Ptr(spi_instance), tx, rx, size, time_out) == HAL_OK);
+    EvtTrace.record(EvtTrace_SPI_End, state, 0);
 
-    return 0;
+    return state ? size : 0;
 }
@@ -1,4 +1,5 @@
 #include "Bsp_Timer.h"
+#include "kernel.h"
 
 #define To_TIM_Handle_Ptr(x) ((TIM_HandleTypeDef *)x)
 #define To_TIM_Instance_Ptr(x) ((TIM_TypeDef *)x)
@@ -15,11 +16,32 @@ BspTIM_PWMInitMonitor_TypeDef monitor = {
     .monitor_init = false,
 };
 
+#define BSP_TIMER_BIDIR_TIM_MAX 4
+#define BSP_TIMER_BIDIR_CAPTURE_PERIOD 0xFFFF
+
+/* every bidirectional channel of one timer switch between output and capture together, timer period is shared */
+typedef struct
+{
+    TIM_TypeDef *instance;
+    BspTimerPWMObj_TypeDef *obj[BSP_TIMER_BURST_MAX_CH];
+    uint8_t obj_cnt;
+    volatile uint8_t pending;
+    volatile bool capture;
+} BspTimer_BidirMonitor_TypeDef;
+
+static BspTimer_BidirMonitor_TypeDef BspTimer_Bidir_List[BSP_TIMER_BIDIR_TIM_MAX];
+
 static TIM_HandleTypeDef *BspTimer_TickObj_List[BspTimer_TickObj_Sum] = {NULL};
 
 /* internal function */
 static void BspTimer_DMA_Callback(DMA_HandleTypeDef *hdma);
+static void BspTimer_Burst_DMA_Callback(DMA_HandleTypeDef *hdma);
 static bool BspTimer_Clk_Enable(TIM_TypeDef *tim);
+static uint32_t BspTimer_Get_CCR_Addr(BspTimerPWMObj_TypeDef *obj);
+static BspTimer_BidirMonitor_TypeDef *BspTimer_Bidir_Get(TIM_TypeDef *tim);
+static void BspTimer_Bidir_Input(BspTimer_BidirMonitor_TypeDef *bidir);
+static void BspTimer_Bidir_Output(BspTimer_BidirMonitor_TypeDef *bidir);
+static void BspTimer_Pin_PullUp(BspGPIO_Obj_TypeDef pin);
 
 /* external function */
 static bool BspTimer_PWM_Init(BspTimerPWMObj_TypeDef *obj,
@@ -34,6 +56,21 @@ static void BspTimer_SetPreScale(BspTimerPWMObj_TypeDef *obj, uint32_t prescale)
 static void BspTimer_SetAutoReload(BspTimerPWMObj_TypeDef *obj, uint32_t auto_reload);
 static void BspTimer_PWM_Start(BspTimerPWMObj_TypeDef *obj);
 static void BspTimer_DMA_Start(BspTimerPWMObj_TypeDef *obj);
+static bool BspTimer_Set_Bidir(BspTimerPWMObj_TypeDef *obj, uint32_t capture_addr, uint32_t capture_size);
+static uint32_t BspTimer_Get_Capture(BspTimerPWMObj_TypeDef *obj);
+static bool BspTimer_Burst_Init(BspTimerBurstObj_TypeDef *obj,
+                                void *instance,
+                                const uint32_t *ch,
+                                const BspGPIO_Obj_TypeDef *pin,
+                                uint8_t ch_num,
+                                uint8_t dma,
+                                uint8_t stream,
+                                uint32_t buf_addr,
+                                uint32_t frame_size);
+static void BspTimer_Burst_SetPreScale(BspTimerBurstObj_TypeDef *obj, uint32_t prescale);
+static void BspTimer_Burst_SetAutoReload(BspTimerBurstObj_TypeDef *obj, uint32_t auto_reload);
+static void BspTimer_Burst_PWM_Start(BspTimerBurstObj_TypeDef *obj);
+static void BspTimer_Burst_DMA_Start(BspTimerBurstObj_TypeDef *obj);
 
 BspTimerPWM_TypeDef BspTimer_PWM = {
     .init = BspTimer_PWM_Init,
@@ -41,6 +78,16 @@ BspTimerPWM_TypeDef BspTimer_PWM = {
     .set_autoreload = BspTimer_SetAutoReload,
     .start_pwm = BspTimer_PWM_Start,
     .dma_trans = BspTimer_DMA_Start,
+    .set_bidir = BspTimer_Set_Bidir,
+    .get_capture = BspTimer_Get_Capture,
+};
+
+BspTimerBurst_TypeDef BspTimer_Burst = {
+    .init = BspTimer_Burst_Init,
+    .set_prescaler = BspTimer_Burst_SetPreScale,
+    .set_autoreload = BspTimer_Burst_SetAutoReload,
+    .start_pwm = BspTimer_Burst_PWM_Start,
+    .dma_trans = BspTimer_Burst_DMA_Start,
 };
 
 /***************************************************************** General Function ***********************************************************************/
@@ -159,6 +206,7 @@ static bool BspTimer_Clk_Enable(TIM_TypeDef *tim)
 static void BspTimer_DMA_Callback(DMA_HandleTypeDef *hdma)
 {
     TIM_HandleTypeDef *htim = (TIM_HandleTypeDef *)((DMA_HandleTypeDef *)hdma)->Parent;
+    BspTimer_BidirMonitor_TypeDef *bidir = BspTimer_Bidir_Get(htim->Instance);
 
     if (hdma == htim->hdma[TIM_DMA_ID_CC1])
     {
@@ -176,6 +224,14 @@ static void BspTimer_DMA_Callback(DMA_HandleTypeDef *hdma)
     {
         __HAL_TIM_DISABLE_DMA(htim, TIM_DMA_CC4);
     }
+
+    /* bidirectional frame sent, whole timer turn into capture after the last channel finished */
+    if ((bidir != NULL) && !bidir->capture && bidir->pending)
+    {
+        bidir->pending --;
+        if (bidir->pending == 0)
+            BspTimer_Bidir_Input(bidir);
+    }
 }
 
 /***************************************************************** DMA PWM Function ***********************************************************************/
@@ -373,6 +429,7 @@ static bool BspTimer_PWM_Init(BspTimerPWMObj_TypeDef *obj,
         return false;
 
     obj->tim_channel = ch;
+    obj->pin = pin;
 
     /* pin init */
     BspGPIO.alt_init(pin, GPIO_MODE_AF_PP);
@@ -397,35 +454,57 @@ static void BspTimer_PWM_Start(BspTimerPWMObj_TypeDef *obj)
     }
 }
 
-static void BspTimer_DMA_Start(BspTimerPWMObj_TypeDef *obj)
+static uint32_t BspTimer_Get_CCR_Addr(BspTimerPWMObj_TypeDef *obj)
 {
-    uint32_t dst_addr = 0;
-
-    if ((obj->buffer_addr == 0) || (obj->buffer_size == 0))
-        return;
-
     switch (obj->tim_dma_id_cc)
     {
     case TIM_DMA_ID_CC1:
-        dst_addr = (uint32_t)&To_TIM_Handle_Ptr(obj->tim_hdl)->Instance->CCR1;
-        break;
+        return (uint32_t)&To_TIM_Handle_Ptr(obj->tim_hdl)->Instance->CCR1;
 
     case TIM_DMA_ID_CC2:
-        dst_addr = (uint32_t)&To_TIM_Handle_Ptr(obj->tim_hdl)->Instance->CCR2;
-        break;
+        return (uint32_t)&To_TIM_Handle_Ptr(obj->tim_hdl)->Instance->CCR2;
 
     case TIM_DMA_ID_CC3:
-        dst_addr = (uint32_t)&To_TIM_Handle_Ptr(obj->tim_hdl)->Instance->CCR3;
-        break;
+        return (uint32_t)&To_TIM_Handle_Ptr(obj->tim_hdl)->Instance->CCR3;
 
     case TIM_DMA_ID_CC4:
-        dst_addr = (uint32_t)&To_TIM_Handle_Ptr(obj->tim_hdl)->Instance->CCR4;
-        break;
+        return (uint32_t)&To_TIM_Handle_Ptr(obj->tim_hdl)->Instance->CCR4;
 
     default:
+        return 0;
+    }
+}
+
+static void BspTimer_DMA_Start(BspTimerPWMObj_TypeDef *obj)
+{
+    uint32_t dst_addr = 0;
+    BspTimer_BidirMonitor_TypeDef *bidir = NULL;
+
+    if ((obj->buffer_addr == 0) || (obj->buffer_size == 0))
+        return;
+
+    dst_addr = BspTimer_Get_CCR_Addr(obj);
+    if (dst_addr == 0)
         return;
+
+    if (obj->bidir)
+    {
+        bidir = BspTimer_Bidir_Get(obj->instance);
+        if (bidir == NULL)
+            return;
+
+        /* capture result not taken by get_capture, drop it */
+        if (bidir->capture)
+            BspTimer_Bidir_Output(bidir);
+
+        /* first channel of the round arm every channel of the timer before its dma start,
+         * otherwise its transfer complete could reach 0 and turn the timer into capture while the rest still to send */
+        if (bidir->pending == 0)
+            bidir->pending = bidir->obj_cnt;
     }
 
+    /* dshot buffer fall back to cacheable os heap when no dma heap region, write back before dma transfer */
+    Kernel_DCache_Clean((void *)obj->buffer_addr, obj->buffer_size * sizeof(uint32_t));
     HAL_DMA_Start_IT(To_TIM_Handle_Ptr(obj->tim_hdl)->hdma[obj->tim_dma_id_cc], obj->buffer_addr, dst_addr, obj->buffer_size);
     __HAL_TIM_ENABLE_DMA(To_TIM_Handle_Ptr(obj->tim_hdl), obj->tim_dma_cc);
 }
@@ -444,6 +523,408 @@ static void BspTimer_SetAutoReload(BspTimerPWMObj_TypeDef *obj, uint32_t auto_re
         __HAL_TIM_SET_AUTORELOAD(To_TIM_Handle_Ptr(obj->tim_hdl), auto_reload);
 }
 
+/***************************************************************** DMA Burst Function ***********************************************************************/
+static void BspTimer_Burst_DMA_Callback(DMA_HandleTypeDef *hdma)
+{
+    TIM_HandleTypeDef *htim = (TIM_HandleTypeDef *)((DMA_HandleTypeDef *)hdma)->Parent;
+
+    __HAL_TIM_DISABLE_DMA(htim, TIM_DMA_UPDATE);
+}
+
+static uint32_t BspTimer_Get_Burst_DMA_Request(TIM_TypeDef *instance)
+{
+    switch ((uint32_t)instance)
+    {
+    case (uint32_t)TIM3:
+        return DMA_REQUEST_TIM3_UP;
+
+    case (uint32_t)TIM4:
+        return DMA_REQUEST_TIM4_UP;
+
+    case (uint32_t)TIM5:
+        return DMA_REQUEST_TIM5_UP;
+
+    case (uint32_t)TIM15:
+        return DMA_REQUEST_TIM15_UP;
+
+    default:
+        return 0;
+    }
+}
+
+static int8_t BspTimer_Get_Channel_Index(uint32_t ch)
+{
+    switch (ch)
+    {
+    case TIM_CHANNEL_1:
+        return 0;
+
+    case TIM_CHANNEL_2:
+        return 1;
+
+    case TIM_CHANNEL_3:
+        return 2;
+
+    case TIM_CHANNEL_4:
+        return 3;
+
+    default:
+        return -1;
+    }
+}
+
+/*
+ * every update event the dma write burst_len word into DMAR, timer spread them into CCR(base) ~ CCR(base + len - 1)
+ * buffer layout: frame_size group of burst_len word
+ */
+static bool BspTimer_Burst_Init(BspTimerBurstObj_TypeDef *obj,
+                                void *instance,
+                                const uint32_t *ch,
+                                const BspGPIO_Obj_TypeDef *pin,
+                                uint8_t ch_num,
+                                uint8_t dma,
+                                uint8_t stream,
+                                uint32_t buf_addr,
+                                uint32_t frame_size)
+{
+    TIM_MasterConfigTypeDef sMasterConfig = {0};
+    TIM_OC_InitTypeDef sConfigOC = {0};
+    int8_t ch_index = 0;
+    uint8_t ch_min = BSP_TIMER_BURST_MAX_CH;
+    uint8_t ch_max = 0;
+
+    if ((obj == NULL) || \
+        (obj->tim_hdl == NULL) || \
+        (obj->dma_hdl == NULL) || \
+        (instance == NULL) || \
+        (ch == NULL) || \
+        (pin == NULL) || \
+        (ch_num == 0) || \
+        (ch_num > BSP_TIMER_BURST_MAX_CH) || \
+        (buf_addr == 0) || \
+        (frame_size == 0) || \
+        (BspTimer_Get_Burst_DMA_Request(instance) == 0))
+        return false;
+
+    for (uint8_t i = 0; i < ch_num; i++)
+    {
+        ch_index = BspTimer_Get_Channel_Index(ch[i]);
+        if (ch_index < 0)
+            return false;
+
+        if (ch_index < ch_min)
+            ch_min = ch_index;
+
+        if (ch_index > ch_max)
+            ch_max = ch_index;
+    }
+
+    obj->base_ch = ch_min;
+    obj->burst_len = ch_max - ch_min + 1;
+    obj->ch_mask = 0;
+    for (uint8_t i = 0; i < ch_num; i++)
+    {
+        obj->slot[i] = BspTimer_Get_Channel_Index(ch[i]) - ch_min;
+        obj->ch_mask |= 1 << obj->slot[i];
+    }
+
+    obj->dma = dma;
+    obj->stream = stream;
+    obj->buffer_addr = buf_addr;
+    obj->buffer_size = frame_size * obj->burst_len;
+
+    BspTimer_PWM_InitMonit(instance);
+    obj->instance = instance;
+    To_TIM_Handle_Ptr(obj->tim_hdl)->Instance = instance;
+    To_TIM_Handle_Ptr(obj->tim_hdl)->Init.Prescaler = 0;
+    To_TIM_Handle_Ptr(obj->tim_hdl)->Init.CounterMode = TIM_COUNTERMODE_UP;
+    To_TIM_Handle_Ptr(obj->tim_hdl)->Init.Period = 0;
+    To_TIM_Handle_Ptr(obj->tim_hdl)->Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    To_TIM_Handle_Ptr(obj->tim_hdl)->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_DISABLE;
+
+    /* dma init */
+    To_TIM_DMA_Ptr(obj->dma_hdl)->Instance = BspDMA.get_instance(dma, stream);
+    To_TIM_DMA_Ptr(obj->dma_hdl)->Init.Request = BspTimer_Get_Burst_DMA_Request(instance);
+    To_TIM_DMA_Ptr(obj->dma_hdl)->Init.Direction = DMA_MEMORY_TO_PERIPH;
+    To_TIM_DMA_Ptr(obj->dma_hdl)->Init.PeriphInc = DMA_PINC_DISABLE;
+    To_TIM_DMA_Ptr(obj->dma_hdl)->Init.MemInc = DMA_MINC_ENABLE;
+    To_TIM_DMA_Ptr(obj->dma_hdl)->Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    To_TIM_DMA_Ptr(obj->dma_hdl)->Init.MemDataAlignment = DMA_PDATAALIGN_WORD;
+    To_TIM_DMA_Ptr(obj->dma_hdl)->Init.Mode = DMA_NORMAL;
+    To_TIM_DMA_Ptr(obj->dma_hdl)->Init.Priority = DMA_PRIORITY_HIGH;
+    To_TIM_DMA_Ptr(obj->dma_hdl)->Init.FIFOMode = DMA_FIFOMODE_ENABLE;
+    To_TIM_DMA_Ptr(obj->dma_hdl)->Init.FIFOThreshold = DMA_FIFO_THRESHOLD_1QUARTERFULL;
+    To_TIM_DMA_Ptr(obj->dma_hdl)->Init.MemBurst = DMA_MBURST_SINGLE;
+    To_TIM_DMA_Ptr(obj->dma_hdl)->Init.PeriphBurst = DMA_PBURST_SINGLE;
+
+    if (HAL_DMA_Init(To_TIM_DMA_Ptr(obj->dma_hdl)) != HAL_OK)
+        return false;
+
+    __HAL_LINKDMA(To_TIM_Handle_Ptr(obj->tim_hdl), hdma[TIM_DMA_ID_UPDATE], *To_TIM_DMA_Ptr(obj->dma_hdl));
+
+    if (HAL_TIM_PWM_Init(To_TIM_Handle_Ptr(obj->tim_hdl)) != HAL_OK)
+        return false;
+
+    sMasterConfig.MasterOutputTrigger = TIM_TRGO_RESET;
+    sMasterConfig.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+
+    if (HAL_TIMEx_MasterConfigSynchronization(To_TIM_Handle_Ptr(obj->tim_hdl), &sMasterConfig) != HAL_OK)
+        return false;
+
+    sConfigOC.OCMode = TIM_OCMODE_PWM1;
+    sConfigOC.Pulse = 0;
+    sConfigOC.OCPolarity = TIM_OCPOLARITY_HIGH;
+    sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+
+    for (uint8_t i = 0; i < ch_num; i++)
+    {
+        if (HAL_TIM_PWM_ConfigChannel(To_TIM_Handle_Ptr(obj->tim_hdl), &sConfigOC, ch[i]) != HAL_OK)
+            return false;
+
+        /* preload keep the new compare value off the running bit until next update */
+        __HAL_TIM_ENABLE_OCxPRELOAD(To_TIM_Handle_Ptr(obj->tim_hdl), ch[i]);
+
+        /* pin init */
+        BspGPIO.alt_init(pin[i], GPIO_MODE_AF_PP);
+    }
+
+    /* dma regist */
+    if (BspDMA.regist(dma, stream, obj->dma_hdl))
+    {
+        /* init DMA IRQ */
+        BspDMA.enable_irq(dma, stream, 5, 0, 0, NULL);
+    }
+
+    return true;
+}
+
+static void BspTimer_Burst_PWM_Start(BspTimerBurstObj_TypeDef *obj)
+{
+    uint32_t ch_list[BSP_TIMER_BURST_MAX_CH] = {TIM_CHANNEL_1, TIM_CHANNEL_2, TIM_CHANNEL_3, TIM_CHANNEL_4};
+
+    if (obj->tim_hdl)
+    {
+        To_TIM_Handle_Ptr(obj->tim_hdl)->hdma[TIM_DMA_ID_UPDATE]->XferCpltCallback = BspTimer_Burst_DMA_Callback;
+
+        for (uint8_t i = 0; i < obj->burst_len; i++)
+        {
+            if (obj->ch_mask & (1 << i))
+                HAL_TIM_PWM_Start(To_TIM_Handle_Ptr(obj->tim_hdl), ch_list[obj->base_ch + i]);
+        }
+    }
+}
+
+static void BspTimer_Burst_DMA_Start(BspTimerBurstObj_TypeDef *obj)
+{
+    TIM_TypeDef *tim = NULL;
+
+    if ((obj->tim_hdl == NULL) || (obj->buffer_addr == 0) || (obj->buffer_size == 0))
+        return;
+
+    tim = To_TIM_Handle_Ptr(obj->tim_hdl)->Instance;
+
+    /* last burst still on going */
+    if (tim->DIER & TIM_DMA_UPDATE)
+        return;
+
+    /* DBA: offset of CCR(base) in register word, DBL: transfer num of each burst minus 1 */
+    tim->DCR = (TIM_DMABASE_CCR1 + obj->base_ch) | ((uint32_t)(obj->burst_len - 1) << TIM_DCR_DBL_Pos);
+
+    /* dshot buffer fall back to cacheable os heap when no dma heap region, write back before dma transfer */
+    Kernel_DCache_Clean((void *)obj->buffer_addr, obj->buffer_size * sizeof(uint32_t));
+    HAL_DMA_Start_IT(To_TIM_Handle_Ptr(obj->tim_hdl)->hdma[TIM_DMA_ID_UPDATE], obj->buffer_addr, (uint32_t)&tim->DMAR, obj->buffer_size);
+    __HAL_TIM_ENABLE_DMA(To_TIM_Handle_Ptr(obj->tim_hdl), TIM_DMA_UPDATE);
+}
+
+static void BspTimer_Burst_SetPreScale(BspTimerBurstObj_TypeDef *obj, uint32_t prescale)
+{
+    obj->prescale = prescale;
+    if(obj->tim_hdl)
+        __HAL_TIM_SET_PRESCALER(To_TIM_Handle_Ptr(obj->tim_hdl), prescale);
+}
+
+static void BspTimer_Burst_SetAutoReload(BspTimerBurstObj_TypeDef *obj, uint32_t auto_reload)
+{
+    obj->auto_reload = auto_reload;
+    if(obj->tim_hdl)
+        __HAL_TIM_SET_AUTORELOAD(To_TIM_Handle_Ptr(obj->tim_hdl), auto_reload);
+}
+
+/***************************************************************** Bidirectional Function ***********************************************************************/
+static BspTimer_BidirMonitor_TypeDef *BspTimer_Bidir_Get(TIM_TypeDef *tim)
+{
+    for (uint8_t i = 0; i < BSP_TIMER_BIDIR_TIM_MAX; i++)
+    {
+        if (BspTimer_Bidir_List[i].instance == tim)
+            return &BspTimer_Bidir_List[i];
+    }
+
+    return NULL;
+}
+
+static void BspTimer_DMA_Set_Direction(DMA_HandleTypeDef *hdma, uint32_t dir)
+{
+    /* stream disabled, HAL_DMA_Start_IT take the address order from Init.Direction */
+    hdma->Init.Direction = dir;
+    ((DMA_Stream_TypeDef *)hdma->Instance)->CR = (((DMA_Stream_TypeDef *)hdma->Instance)->CR & ~DMA_SxCR_DIR) | dir;
+}
+
+static void BspTimer_Pin_PullUp(BspGPIO_Obj_TypeDef pin)
+{
+    GPIO_InitTypeDef cfg_structure;
+
+    cfg_structure.Pin = pin.pin;
+    cfg_structure.Mode = GPIO_MODE_AF_PP;
+    cfg_structure.Pull = GPIO_PULLUP;
+    cfg_structure.Speed = GPIO_SPEED_FREQ_HIGH;
+    cfg_structure.Alternate = pin.alternate;
+
+    HAL_GPIO_Init(pin.port, &cfg_structure);
+}
+
+/* channel index 0 ~ 3 */
+static void BspTimer_Channel_Set_Mode(TIM_TypeDef *tim, uint8_t ch_index, bool input)
+{
+    volatile uint32_t *ccmr = (ch_index < 2) ? &tim->CCMR1 : &tim->CCMR2;
+    uint32_t ccmr_shift = (ch_index & 1) * 8;
+    uint32_t ccer_shift = ch_index * 4;
+
+    /* CCxS only writable while the channel is off */
+    tim->CCER &= ~(TIM_CCER_CC1E << ccer_shift);
+
+    if (input)
+    {
+        /* map on TIx, no filter, capture both edge */
+        *ccmr = (*ccmr & ~(0xFFUL << ccmr_shift)) | (TIM_CCMR1_CC1S_0 << ccmr_shift);
+        tim->CCER |= (TIM_CCER_CC1P | TIM_CCER_CC1NP) << ccer_shift;
+    }
+    else
+    {
+        /* pwm mode 1 with preload, active low so the line idle high between frame */
+        *ccmr = (*ccmr & ~(0xFFUL << ccmr_shift)) | ((TIM_CCMR1_OC1M_1 | TIM_CCMR1_OC1M_2 | TIM_CCMR1_OC1PE) << ccmr_shift);
+        tim->CCER = (tim->CCER & ~(TIM_CCER_CC1NP << ccer_shift)) | (TIM_CCER_CC1P << ccer_shift);
+    }
+
+    tim->CCER |= TIM_CCER_CC1E << ccer_shift;
+}
+
+/* called in dma irq once the last output frame of the timer sent */
+static void BspTimer_Bidir_Input(BspTimer_BidirMonitor_TypeDef *bidir)
+{
+    BspTimerPWMObj_TypeDef *obj = NULL;
+    DMA_HandleTypeDef *hdma = NULL;
+
+    bidir->instance->ARR = BSP_TIMER_BIDIR_CAPTURE_PERIOD;
+    bidir->instance->CNT = 0;
+
+    for (uint8_t i = 0; i < bidir->obj_cnt; i++)
+    {
+        obj = bidir->obj[i];
+        hdma = To_TIM_Handle_Ptr(obj->tim_hdl)->hdma[obj->tim_dma_id_cc];
+
+        BspTimer_Channel_Set_Mode(bidir->instance, BspTimer_Get_Channel_Index(obj->tim_channel), true);
+        BspTimer_DMA_Set_Direction(hdma, DMA_PERIPH_TO_MEMORY);
+        HAL_DMA_Start_IT(hdma, BspTimer_Get_CCR_Addr(obj), obj->capture_addr, obj->capture_size);
+        __HAL_TIM_ENABLE_DMA(To_TIM_Handle_Ptr(obj->tim_hdl), obj->tim_dma_cc);
+    }
+
+    bidir->capture = true;
+}
+
+/* stop capture, latch edge count of every channel and give the timer back to output */
+static void BspTimer_Bidir_Output(BspTimer_BidirMonitor_TypeDef *bidir)
+{
+    BspTimerPWMObj_TypeDef *obj = NULL;
+    DMA_HandleTypeDef *hdma = NULL;
+
+    for (uint8_t i = 0; i < bidir->obj_cnt; i++)
+    {
+        obj = bidir->obj[i];
+        hdma = To_TIM_Handle_Ptr(obj->tim_hdl)->hdma[obj->tim_dma_id_cc];
+
+        __HAL_TIM_DISABLE_DMA(To_TIM_Handle_Ptr(obj->tim_hdl), obj->tim_dma_cc);
+        obj->capture_cnt = obj->capture_size - __HAL_DMA_GET_COUNTER(hdma);
+        HAL_DMA_Abort(hdma);
+        Kernel_DCache_Invalidate((void *)obj->capture_addr, obj->capture_size * sizeof(uint32_t));
+
+        BspTimer_DMA_Set_Direction(hdma, DMA_MEMORY_TO_PERIPH);
+        BspTimer_Channel_Set_Mode(bidir->instance, BspTimer_Get_Channel_Index(obj->tim_channel), false);
+        *(volatile uint32_t *)BspTimer_Get_CCR_Addr(obj) = 0;
+    }
+
+    bidir->instance->ARR = bidir->obj[0]->auto_reload;
+    bidir->instance->CNT = 0;
+    bidir->pending = 0;
+    bidir->capture = false;
+}
+
+/*
+ * every channel of the timer must be bidirectional, all of them output in the same control round
+ * capture buffer must be reachable by dma and hold at least DSHOT_TELEMETRY_EDGE_MAX word
+ */
+static bool BspTimer_Set_Bidir(BspTimerPWMObj_TypeDef *obj, uint32_t capture_addr, uint32_t capture_size)
+{
+    BspTimer_BidirMonitor_TypeDef *bidir = NULL;
+    int8_t ch_index = 0;
+
+    if ((obj == NULL) || (obj->tim_hdl == NULL) || (capture_addr == 0) || (capture_size == 0))
+        return false;
+
+    ch_index = BspTimer_Get_Channel_Index(obj->tim_channel);
+    if (ch_index < 0)
+        return false;
+
+    bidir = BspTimer_Bidir_Get(obj->instance);
+    if (bidir == NULL)
+    {
+        /* take a free slot */
+        bidir = BspTimer_Bidir_Get(NULL);
+        if (bidir == NULL)
+            return false;
+
+        memset(bidir, 0, sizeof(BspTimer_BidirMonitor_TypeDef));
+        bidir->instance = obj->instance;
+    }
+
+    if (bidir->obj_cnt >= BSP_TIMER_BURST_MAX_CH)
+        return false;
+
+    obj->capture_addr = capture_addr;
+    obj->capture_size = capture_size;
+    obj->capture_cnt = 0;
+    obj->bidir = true;
+
+    bidir->obj[bidir->obj_cnt] = obj;
+    bidir->obj_cnt ++;
+
+    BspTimer_Channel_Set_Mode(obj->instance, ch_index, false);
+    *(volatile uint32_t *)BspTimer_Get_CCR_Addr(obj) = 0;
+
+    /* esc pull the line low to answer, keep it high while nobody drive it */
+    BspTimer_Pin_PullUp(obj->pin);
+
+    return true;
+}
+
+/* edge num captured since the last frame, 0 when nothing captured */
+static uint32_t BspTimer_Get_Capture(BspTimerPWMObj_TypeDef *obj)
+{
+    BspTimer_BidirMonitor_TypeDef *bidir = NULL;
+    uint32_t cnt = 0;
+
+    if ((obj == NULL) || !obj->bidir)
+        return 0;
+
+    bidir = BspTimer_Bidir_Get(obj->instance);
+    if ((bidir != NULL) && bidir->capture)
+        BspTimer_Bidir_Output(bidir);
+
+    cnt = obj->capture_cnt;
+    obj->capture_cnt = 0;
+
+    return cnt;
+}
+
 /***************************************************************** Tick Function ***********************************************************************/
 static IRQn_Type BspTimer_Get_IRQType(TIM_TypeDef *tim)
 {
@@ -32,6 +32,7 @@ typedef enum
 TIM_HandleTypeDef* BspTimer_Get_Tick_HandlePtr(BspTimer_Instance_List index);
 
 extern BspTimerPWM_TypeDef BspTimer_PWM;
+extern BspTimerBurst_TypeDef BspTimer_Burst;
 extern BspTimerTick_TypeDef BspTimer_Tick;
 
 #endif
@@ -7,6 +7,8 @@
 #include "stm32h7xx_hal_rcc.h"
 #include "stm32h7xx_hal_uart.h"
 #include "Bsp_Uart.h"
+#include "kernel.h"
+#include "evt_trace.h"
 
 #define To_Uart_Instance(x) ((USART_TypeDef *)x)
 #define To_Uart_Handle_Ptr(x) ((UART_HandleTypeDef *)x)
@@ -312,6 +314,7 @@ static bool BspUart_Init(BspUARTObj_TypeDef *obj)
     if (obj->irq_type == BspUart_IRQ_Type_Idle)
     {
         /* start dma receive data */
+        Kernel_DCache_Invalidate(obj->rx_buf, obj->rx_size);
         HAL_UART_Receive_DMA(To_Uart_Handle_Ptr(obj->hdl), obj->rx_buf, obj->rx_size);
     }
     else if (obj->irq_type == BspUart_IRQ_Type_Byte)
@@ -402,6 +405,9 @@ static bool BspUart_Transfer(BspUARTObj_TypeDef *obj, uint8_t *tx_buf, uint16_t
     if(obj->monitor.tx_success_cnt != obj->monitor.tx_cnt)
         return false;
 
+    /* make sure dma get the data cpu wrote */
+    Kernel_DCache_Clean(tx_buf, size);
+
     /* send data */
     switch (HAL_UART_Transmit_DMA(To_Uart_Handle_Ptr(obj->hdl), tx_buf, size))
     {
@@ -515,6 +521,9 @@ void UART_IRQ_Callback(BspUART_Port_List index)
 
                 if (len)
                 {
+                    EvtTrace.record(EvtTrace_Uart_Rx, index, len);
+                    Kernel_DCache_Invalidate(BspUart_Obj_List[index]->rx_buf, BspUart_Obj_List[index]->rx_size);
+
                     /* idle receive callback process */
                     if (BspUart_Obj_List[index]->RxCallback)
                         BspUart_Obj_List[index]->RxCallback(BspUart_Obj_List[index]->cust_data_addr,
@@ -563,6 +572,9 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
     {
         if (BspUart_Obj_List[index]->irq_type == BspUart_IRQ_Type_Idle)
         {
+            EvtTrace.record(EvtTrace_Uart_Rx, index, BspUart_Obj_List[index]->rx_size);
+            Kernel_DCache_Invalidate(BspUart_Obj_List[index]->rx_buf, BspUart_Obj_List[index]->rx_size);
+
             if (BspUart_Obj_List[index]->RxCallback)
                 BspUart_Obj_List[index]->RxCallback(BspUart_Obj_List[index]->cust_data_addr,
                                                     BspUart_Obj_List[index]->rx_buf,
@@ -611,6 +623,7 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 
     if (BspUart_Obj_List[index])
     {
+        EvtTrace.record(EvtTrace_Uart_Tx, index, 0);
         BspUart_Obj_List[index]->monitor.tx_success_cnt ++;
 
         if(BspUart_Obj_List[index]->TxCallback)
@@ -11,6 +11,7 @@
 #include "Bsp_IIC.h"
 #include "Bsp_Uart.h" 
 #include "Bsp_Timer.h"
+#include "profiler.h"
 
 extern PCD_HandleTypeDef hpcd_USB_OTG_FS;
 extern DevCard_Obj_TypeDef DevTFCard_Obj;
@@ -64,212 +65,266 @@ void SysTick_Handler(void)
 
 void OTG_FS_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_USB);
   HAL_PCD_IRQHandler(&hpcd_USB_OTG_FS);
+  Profiler.isr_exit(Profiler_Isr_USB);
 }
 
 void EXTI0_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Exti);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_0);
+  Profiler.isr_exit(Profiler_Isr_Exti);
 }
 
 void EXTI1_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Exti);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_1);
+  Profiler.isr_exit(Profiler_Isr_Exti);
 }
 
 void EXTI2_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Exti);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_2);
+  Profiler.isr_exit(Profiler_Isr_Exti);
 }
 
 void EXTI3_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Exti);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_3);
+  Profiler.isr_exit(Profiler_Isr_Exti);
 }
 
 void EXTI4_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Exti);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_4);
+  Profiler.isr_exit(Profiler_Isr_Exti);
 }
 
 void EXTI9_5_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Exti);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_5);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_6);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_7);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_8);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_9);
+  Profiler.isr_exit(Profiler_Isr_Exti);
 }
 
 void EXTI15_10_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Exti);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_10);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_11);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_12);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_13);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_14);
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_15);
+  Profiler.isr_exit(Profiler_Isr_Exti);
 }
 
 void SDMMC1_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_SDMMC);
   HAL_SD_IRQHandler(&DevTFCard_Obj.SDMMC_Obj.hdl);
+  Profiler.isr_exit(Profiler_Isr_SDMMC);
 }
 
 void MDMA_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_SDMMC);
   HAL_MDMA_IRQHandler(&DevTFCard_Obj.SDMMC_Obj.mdma);
+  Profiler.isr_exit(Profiler_Isr_SDMMC);
 }
 
 void DMA2_Stream7_IRQHandler(void)
 {
-  DMA_HandleTypeDef *dma_hdl = BspDMA_Pipe.get_hanle();
+  DMA_HandleTypeDef *dma_hdl = NULL;
+  Profiler.isr_enter(Profiler_Isr_DMA);
+  dma_hdl = BspDMA_Pipe.get_hanle();
   if(dma_hdl)
     HAL_DMA_IRQHandler(dma_hdl);
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA1_Stream0_IRQHandler(void)
 {
   DMA_HandleTypeDef *hdl = NULL;
+  Profiler.isr_enter(Profiler_Isr_DMA);
   hdl = BspDMA.get_handle(Bsp_DMA_1, Bsp_DMA_Stream_0);
 
   if (hdl)
     HAL_DMA_IRQHandler(hdl);
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA1_Stream1_IRQHandler(void)
 {
   DMA_HandleTypeDef *hdl = NULL;
+  Profiler.isr_enter(Profiler_Isr_DMA);
   hdl = BspDMA.get_handle(Bsp_DMA_1, Bsp_DMA_Stream_1);
 
   if (hdl)
     HAL_DMA_IRQHandler(hdl);
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA1_Stream2_IRQHandler(void)
 {
   DMA_HandleTypeDef *hdl = NULL;
+  Profiler.isr_enter(Profiler_Isr_DMA);
   hdl = BspDMA.get_handle(Bsp_DMA_1, Bsp_DMA_Stream_2);
 
   if (hdl)
     HAL_DMA_IRQHandler(hdl);
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA1_Stream3_IRQHandler(void)
 {
   DMA_HandleTypeDef *hdl = NULL;
+  Profiler.isr_enter(Profiler_Isr_DMA);
   hdl = BspDMA.get_handle(Bsp_DMA_1, Bsp_DMA_Stream_3);
 
   if (hdl)
     HAL_DMA_IRQHandler(hdl);
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA1_Stream4_IRQHandler(void)
 {
   DMA_HandleTypeDef *hdl = NULL;
+  Profiler.isr_enter(Profiler_Isr_DMA);
   hdl = BspDMA.get_handle(Bsp_DMA_1, Bsp_DMA_Stream_4);
 
   if (hdl)
     HAL_DMA_IRQHandler(hdl);
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA1_Stream5_IRQHandler(void)
 {
   DMA_HandleTypeDef *hdl = NULL;
+  Profiler.isr_enter(Profiler_Isr_DMA);
   hdl = BspDMA.get_handle(Bsp_DMA_1, Bsp_DMA_Stream_5);
 
   if (hdl)
     HAL_DMA_IRQHandler(hdl);
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA2_Stream0_IRQHandler(void)
 {
   DMA_HandleTypeDef *hdl = NULL;
+  Profiler.isr_enter(Profiler_Isr_DMA);
   hdl = BspDMA.get_handle(Bsp_DMA_2, Bsp_DMA_Stream_0);
 
   if (hdl)
     HAL_DMA_IRQHandler(hdl);
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void DMA2_Stream1_IRQHandler(void)
 {
   DMA_HandleTypeDef *hdl = NULL;
+  Profiler.isr_enter(Profiler_Isr_DMA);
   hdl = BspDMA.get_handle(Bsp_DMA_2, Bsp_DMA_Stream_1);
 
   if (hdl)
     HAL_DMA_IRQHandler(hdl);
+  Profiler.isr_exit(Profiler_Isr_DMA);
 }
 
 void USART1_IRQHandler(void)
 {
   UART_HandleTypeDef *hdl = NULL;
+  Profiler.isr_enter(Profiler_Isr_Uart);
   UART_IRQ_Callback(BspUART_Port_1);
   hdl = BspUart_GetObj_Handle(BspUART_Port_1);
 
   if (hdl && (hdl->Instance == USART1))
     HAL_UART_IRQHandler(hdl);
+  Profiler.isr_exit(Profiler_Isr_Uart);
 }
 
 void UART4_IRQHandler(void)
 {
   UART_HandleTypeDef *hdl = NULL;
+  Profiler.isr_enter(Profiler_Isr_Uart);
   UART_IRQ_Callback(BspUART_Port_4);
   hdl = BspUart_GetObj_Handle(BspUART_Port_4);
 
   if (hdl && (hdl->Instance == UART4))
     HAL_UART_IRQHandler(hdl);
+  Profiler.isr_exit(Profiler_Isr_Uart);
 }
 
 void USART6_IRQHandler(void)
 {
   UART_HandleTypeDef *hdl = NULL;
+  Profiler.isr_enter(Profiler_Isr_Uart);
   UART_IRQ_Callback(BspUART_Port_6);
   hdl = BspUart_GetObj_Handle(BspUART_Port_6);
 
   if (hdl && (hdl->Instance == USART6))
     HAL_UART_IRQHandler(hdl);
+  Profiler.isr_exit(Profiler_Isr_Uart);
 }
 
 void UART7_IRQHandler(void)
 {
   UART_HandleTypeDef *hdl = NULL;
+  Profiler.isr_enter(Profiler_Isr_Uart);
   UART_IRQ_Callback(BspUART_Port_7);
   hdl = BspUart_GetObj_Handle(BspUART_Port_7);
 
   if (hdl && (hdl->Instance == UART7))
     HAL_UART_IRQHandler(hdl);
+  Profiler.isr_exit(Profiler_Isr_Uart);
 }
 
 void I2C2_ER_IRQHandler(void)
 {
   I2C_HandleTypeDef *hdl = NULL;
+  Profiler.isr_enter(Profiler_Isr_IIC);
   hdl = BspIIC_Get_HandlePtr(BspIIC_Instance_I2C_2);
 
   if(hdl)
     HAL_I2C_ER_IRQHandler(hdl);
+  Profiler.isr_exit(Profiler_Isr_IIC);
 }
 
 void TIM7_IRQHandler(void)
 {
   TIM_HandleTypeDef *hdl;
+  Profiler.isr_enter(Profiler_Isr_Timer);
   hdl = BspTimer_Get_Tick_HandlePtr(BspTimer_7);
 
   if(hdl)
     HAL_TIM_IRQHandler(hdl);
+  Profiler.isr_exit(Profiler_Isr_Timer);
 }
 
 /* SYSTEM Call */
 void TIM17_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Timer);
   /* check tick frequence */
   /* set 1K tick freq on configuration */
   HAL_IncTick();
   HAL_TIM_IRQHandler(&htim17);
+  Profiler.isr_exit(Profiler_Isr_Timer);
 }
 
 /* use timer16 as systime tick timer */
 void TIM16_IRQHandler(void)
 {
+  Profiler.isr_enter(Profiler_Isr_Tick);
   // DebugPin.ctl(Debug_PB5, true);
 
 #if (INCLUDE_xTaskGetSchedulerState == 1 )
@@ -283,4 +338,5 @@ void TIM16_IRQHandler(void)
   
   HAL_TIM_IRQHandler(&htim16);
   // DebugPin.ctl(Debug_PB5, false);
+  Profiler.isr_exit(Profiler_Isr_Tick);
 }
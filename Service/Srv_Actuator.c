@@ -16,7 +16,8 @@
 #include "Srv_Actuator.h"
 #include "Srv_DataHub.h"
 #include "Srv_OsCommon.h"
-#include "datapipe.h"
+#include "util.h"
+#include "DataPipe.h"
 
 const SrvActuator_PeriphSet_TypeDef SrvActuator_Periph_List[Actuator_PWM_SigSUM] = {
     SRVACTUATOR_PB0_SIG_1,
@@ -54,6 +55,117 @@ const uint8_t default_sig_serial[Actuator_PWM_SigSUM] = {
 #endif
 };
 
+/*
+ * mixing table
+ * X axis -> Roll   weight follow moto forward offset
+ * Y axis -> Pitch  weight follow moto right offset
+ * Z axis -> Yaw    +1 on clockwise spin moto, -1 on anticlockwise spin moto
+ * each column normalised to max abs weight 1, moto order is the output signal order
+ */
+
+/*
+ * M1    M2
+ *   \  /
+ *    \/
+ *    /\
+ *   /  \
+ * M3    M4
+ */
+static const SrvActuator_MixTable_TypeDef SrvActuator_Mix_QuadX = {
+    .moto_cnt = 4,
+    .factor = {
+        { 1.0f, -1.0f, -1.0f},
+        { 1.0f,  1.0f,  1.0f},
+        {-1.0f, -1.0f,  1.0f},
+        {-1.0f,  1.0f, -1.0f},
+    },
+};
+
+/*
+ *     M1
+ *     |
+ * M4--+--M2
+ *     |
+ *     M3
+ */
+static const SrvActuator_MixTable_TypeDef SrvActuator_Mix_QuadPlus = {
+    .moto_cnt = 4,
+    .factor = {
+        { 1.0f,  0.0f,  1.0f},
+        { 0.0f,  1.0f, -1.0f},
+        {-1.0f,  0.0f,  1.0f},
+        { 0.0f, -1.0f, -1.0f},
+    },
+};
+
+/*
+ *   M1  M2
+ *    \  /
+ * M6--  --M3
+ *    /  \
+ *   M5  M4
+ */
+static const SrvActuator_MixTable_TypeDef SrvActuator_Mix_HexX = {
+    .moto_cnt = 6,
+    .factor = {
+        { 1.0f, -0.5f, -1.0f},
+        { 1.0f,  0.5f,  1.0f},
+        { 0.0f,  1.0f, -1.0f},
+        {-1.0f,  0.5f,  1.0f},
+        {-1.0f, -0.5f, -1.0f},
+        { 0.0f, -1.0f,  1.0f},
+    },
+};
+
+/* M1 ~ M8 clockwise from front left, 45 deg apart */
+static const SrvActuator_MixTable_TypeDef SrvActuator_Mix_OctX = {
+    .moto_cnt = 8,
+    .factor = {
+        { 1.0000f, -0.4142f, -1.0f},
+        { 1.0000f,  0.4142f,  1.0f},
+        { 0.4142f,  1.0000f, -1.0f},
+        {-0.4142f,  1.0000f,  1.0f},
+        {-1.0000f,  0.4142f, -1.0f},
+        {-1.0000f, -0.4142f,  1.0f},
+        {-0.4142f, -1.0000f, -1.0f},
+        { 0.4142f, -1.0000f,  1.0f},
+    },
+};
+
+/* coaxial quad X, M1 ~ M4 upper layer, M5 ~ M8 lower layer at the same arm with opposite spin */
+static const SrvActuator_MixTable_TypeDef SrvActuator_Mix_X8 = {
+    .moto_cnt = 8,
+    .factor = {
+        { 1.0f, -1.0f, -1.0f},
+        { 1.0f,  1.0f,  1.0f},
+        {-1.0f, -1.0f,  1.0f},
+        {-1.0f,  1.0f, -1.0f},
+        { 1.0f, -1.0f,  1.0f},
+        { 1.0f,  1.0f, -1.0f},
+        {-1.0f, -1.0f, -1.0f},
+        {-1.0f,  1.0f,  1.0f},
+    },
+};
+
+/*
+ * coaxial Y frame, M1 ~ M3 upper layer, M4 ~ M6 lower layer
+ * M1  M2
+ *  \  /
+ *   ||
+ *   M3
+ */
+static const SrvActuator_MixTable_TypeDef SrvActuator_Mix_Y6 = {
+    .moto_cnt = 6,
+    .factor = {
+        { 0.5f, -1.0f,  1.0f},
+        { 0.5f,  1.0f,  1.0f},
+        {-1.0f,  0.0f,  1.0f},
+        { 0.5f, -1.0f, -1.0f},
+        { 0.5f,  1.0f, -1.0f},
+        {-1.0f,  0.0f, -1.0f},
+    },
+};
+
 /* internal variable */
 SrvActuatorObj_TypeDef SrvActuator_Obj;
 SrcActuatorCTL_Obj_TypeDef SrvActuator_ControlStream;
@@ -65,7 +177,14 @@ DataPipe_CreateDataObj(SrvActuatorPipeData_TypeDef, Actuator_Data);
 static void SrcActuator_Get_ChannelRemap(void);
 static bool SrvActuator_Config_MotoSpinDir(void);
 static void SrvActuator_PipeData(void);
-static bool SrvActuator_QuadDrone_MotoMixControl(uint16_t *rc_ctl);
+static bool SrvActuator_MultiRotor_MotoMixControl(uint16_t *pid_ctl);
+static void SrvActuator_Moto_Output(SrvActuator_PWMOutObj_TypeDef *moto, uint16_t val);
+static void SrvActuator_Moto_Command(SrvActuator_PWMOutObj_TypeDef *moto, uint8_t cmd);
+static void SrvActuator_Moto_Flush(void);
+static float SrvActuator_Get_MotoRPM(SrvActuator_PWMOutObj_TypeDef *moto);
+#if SRV_ACTUATOR_DSHOT_BURST
+static void SrvActuator_Burst_Init(void);
+#endif
 
 /* external function */
 static bool SrvActuator_Init(SrvActuator_Model_List model, uint8_t esc_type);
@@ -98,23 +217,33 @@ static bool SrvActuator_Init(SrvActuator_Model_List model, uint8_t esc_type)
     {
     case Model_Quad:
         SrvActuator_Obj.drive_module.num = QUAD_CONTROL_COMPONENT;
+        SrvActuator_Obj.mix_table = &SrvActuator_Mix_QuadX;
+        break;
+
+    case Model_Quad_Plus:
+        SrvActuator_Obj.drive_module.num = QUAD_CONTROL_COMPONENT;
+        SrvActuator_Obj.mix_table = &SrvActuator_Mix_QuadPlus;
         break;
 
 #if defined MATEKH743_V1_5
     case Model_Hex:
         SrvActuator_Obj.drive_module.num = HEX_CONTROL_COMPONENT;
+        SrvActuator_Obj.mix_table = &SrvActuator_Mix_HexX;
         break;
 
     case Model_Oct:
         SrvActuator_Obj.drive_module.num = OCT_CONTROL_COMPONENT;
+        SrvActuator_Obj.mix_table = &SrvActuator_Mix_OctX;
         break;
 
     case Model_X8:
         SrvActuator_Obj.drive_module.num = X8_CONTROL_COMPONENT;
+        SrvActuator_Obj.mix_table = &SrvActuator_Mix_X8;
         break;
 
     case Model_Y6:
         SrvActuator_Obj.drive_module.num = Y6_CONTROL_CONPONENT;
+        SrvActuator_Obj.mix_table = &SrvActuator_Mix_Y6;
         break;
 
     case Model_Tri:
@@ -160,9 +289,16 @@ static bool SrvActuator_Init(SrvActuator_Model_List model, uint8_t esc_type)
                 SrvActuator_Obj.drive_module.obj_list[i].max_val = DSHOT_MAX_THROTTLE;
                 SrvActuator_Obj.drive_module.obj_list[i].idle_val = DSHOT_IDLE_THROTTLE;
                 SrvActuator_Obj.drive_module.obj_list[i].lock_val = DSHOT_LOCK_THROTTLE;
-
-                SrvActuator_Obj.drive_module.obj_list[i].drv_obj = (DevDshotObj_TypeDef *)SrvOsCommon.malloc(sizeof(DevDshotObj_TypeDef));
+                SrvActuator_Obj.drive_module.obj_list[i].burst_id = SRV_ACTUATOR_BURST_NONE;
+
+#if SRV_ACTUATOR_DSHOT_BURST
+                /* driver object shared by each timer group, created in channel remap */
+                SrvActuator_Obj.drive_module.obj_list[i].drv_obj = NULL;
+                continue;
+#else
+                SrvActuator_Obj.drive_module.obj_list[i].drv_obj = (DevDshotObj_TypeDef *)SrvOsCommon.malloc_tag(SrvOs_Heap_DMA, sizeof(DevDshotObj_TypeDef));
                 break;
+#endif
 
             case Actuator_DevType_ServoPWM:
                 break;
@@ -224,6 +360,25 @@ static void SrcActuator_Get_ChannelRemap(void)
         {
             SrvActuator_Obj.drive_module.obj_list[i].sig_id = storage_serial[storage_serial[i]];
             SrvActuator_Obj.drive_module.obj_list[i].periph_ptr = &SrvActuator_Periph_List[storage_serial[i]];
+        }
+
+#if SRV_ACTUATOR_DSHOT_BURST
+        SrvActuator_Burst_Init();
+#endif
+
+        for (uint8_t i = 0; i < SrvActuator_Obj.drive_module.num.moto_cnt; i++)
+        {
+            if (SrvActuator_Obj.drive_module.obj_list[i].burst_id != SRV_ACTUATOR_BURST_NONE)
+                continue;
+
+#if SRV_ACTUATOR_DSHOT_BURST
+            /* timer group burst unavailable, fall back to single channel dma */
+            SrvActuator_Obj.drive_module.obj_list[i].drv_obj = (DevDshotObj_TypeDef *)SrvOsCommon.malloc_tag(SrvOs_Heap_DMA, sizeof(DevDshotObj_TypeDef));
+            if (SrvActuator_Obj.drive_module.obj_list[i].drv_obj == NULL)
+                continue;
+#endif
+            ((DevDshotObj_TypeDef *)SrvActuator_Obj.drive_module.obj_list[i].drv_obj)->type = SrvActuator_Obj.drive_module.obj_list[i].drv_type;
+            ((DevDshotObj_TypeDef *)SrvActuator_Obj.drive_module.obj_list[i].drv_obj)->bidir = (DSHOT_BIDIR == ON);
             periph_ptr = SrvActuator_Obj.drive_module.obj_list[i].periph_ptr;
 
             DevDshot.init(SrvActuator_Obj.drive_module.obj_list[i].drv_obj,
@@ -255,7 +410,7 @@ static bool SrvActuator_Lock(void)
         case Actuator_DevType_DShot150:
         case Actuator_DevType_DShot300:
         case Actuator_DevType_DShot600:
-            DevDshot.control(SrvActuator_Obj.drive_module.obj_list[i].drv_obj, SrvActuator_Obj.drive_module.obj_list[i].lock_val);
+            SrvActuator_Moto_Output(&SrvActuator_Obj.drive_module.obj_list[i], SrvActuator_Obj.drive_module.obj_list[i].lock_val);
             break;
 
         /* servo part still in developping */
@@ -265,6 +420,7 @@ static bool SrvActuator_Lock(void)
         }
     }
 
+    SrvActuator_Moto_Flush();
     SrvActuator_PipeData();
     return true;
 }
@@ -274,15 +430,9 @@ static void SrvActuator_MotoControl(uint16_t *p_val)
     if ((p_val == NULL) || !SrvActuator_Obj.init)
         return;
 
-    switch (SrvActuator_Obj.model)
-    {
-    case Model_Quad:
-        SrvActuator_QuadDrone_MotoMixControl(p_val);
-        break;
-
-    default:
+    /* servo frame have no mixing table yet */
+    if ((SrvActuator_Obj.mix_table == NULL) || !SrvActuator_MultiRotor_MotoMixControl(p_val))
         return;
-    }
 
     SrvActuator_PipeData();
 }
@@ -316,9 +466,9 @@ static bool SrvActuator_SetMotoSpinDir(uint8_t component_index, SrvActuator_Spin
         else
             dir_cmd = DSHOT_CMD_SET_SPIN_ANTICLOCKWISE;
 
-        DevDshot.command(SrvActuator_Obj.drive_module.obj_list[component_index].drv_obj, dir_cmd);
+        SrvActuator_Moto_Command(&SrvActuator_Obj.drive_module.obj_list[component_index], dir_cmd);
         SrvOsCommon.delay_ms(10);
-        DevDshot.command(SrvActuator_Obj.drive_module.obj_list[component_index].drv_obj, DSHOT_CMD_SAVE_SETTING);
+        SrvActuator_Moto_Command(&SrvActuator_Obj.drive_module.obj_list[component_index], DSHOT_CMD_SAVE_SETTING);
         break;
 
     case Actuator_DevType_ServoPWM:
@@ -335,26 +485,20 @@ static bool SrvActuator_Config_MotoSpinDir(void)
 {
     /* we should read moto spin direction info from storage module */
     /* if read failed use default setting down below */
-    switch (SrvActuator_Obj.model)
+    /* default spin direction follow the yaw weight sign of the mixing table */
+    if (SrvActuator_Obj.mix_table == NULL)
+        return true;
+
+    for (uint8_t i = 0; i < SrvActuator_Obj.drive_module.num.moto_cnt; i++)
     {
-    case Model_Quad:
-        for (uint8_t i = 0; i < SrvActuator_Obj.drive_module.num.moto_cnt; i++)
+        if (SrvActuator_Obj.mix_table->factor[i].gyr_z < 0.0f)
         {
-            if ((i == 0) || (i == 3))
-            {
-                SrvActuator_Obj.drive_module.obj_list[i].spin_dir = Actuator_MS_ACW;
-            }
-            else if ((i == 1) || (i == 2))
-            {
-                SrvActuator_Obj.drive_module.obj_list[i].spin_dir = Actuator_MS_CW;
-            }
-
-            SrvActuator_SetMotoSpinDir(i, SrvActuator_Obj.drive_module.obj_list[i].spin_dir);
+            SrvActuator_Obj.drive_module.obj_list[i].spin_dir = Actuator_MS_ACW;
         }
-        break;
+        else
+            SrvActuator_Obj.drive_module.obj_list[i].spin_dir = Actuator_MS_CW;
 
-    default:
-        break;
+        SrvActuator_SetMotoSpinDir(i, SrvActuator_Obj.drive_module.obj_list[i].spin_dir);
     }
 
     return true;
@@ -410,6 +554,7 @@ static void SrvActuator_PipeData(void)
         if (i < SrvActuator_Obj.drive_module.num.moto_cnt)
         {
             DataPipe_DataObj(Actuator_Data).moto[i] = SrvActuator_Obj.drive_module.obj_list[i].ctl_val;
+            DataPipe_DataObj(Actuator_Data).moto_rpm[i] = SrvActuator_Get_MotoRPM(&SrvActuator_Obj.drive_module.obj_list[i]);
         }
         else
         {
@@ -421,60 +566,98 @@ static void SrvActuator_PipeData(void)
 }
 
 /*
- * X axis -> Roll
- * Y axis -> Pitch
- * Z axis -> Yaw
- *
- * M1    M2
- *   \  /
- *    \/
- *    /\
- *   /  \
- * M3    M4
- *
+ * one multiply accumulate pass over the mixing table, then airmode style desaturation
+ * attitude demand scaled down only when its spread exceed the usable moto range (idle ~ max)
+ * throttle shifted inside the range so no moto get clipped and attitude authority is kept
+ * all moto of one frame use the same esc type, range taken from the first moto
  */
-static bool SrvActuator_QuadDrone_MotoMixControl(uint16_t *pid_ctl)
+ITCM_CODE static bool SrvActuator_MultiRotor_MotoMixControl(uint16_t *pid_ctl)
 {
-    float throttle_base_percent = 0.0f;
+    const SrvActuator_MixTable_TypeDef *table = SrvActuator_Obj.mix_table;
+    SrvActuator_PWMOutObj_TypeDef *moto = SrvActuator_Obj.drive_module.obj_list;
+    float mix[SRV_ACTUATOR_MAX_MIX_MOTO];
+    float gyr_x = 0.0f;
+    float gyr_y = 0.0f;
+    float gyr_z = 0.0f;
+    float mix_max = 0.0f;
+    float mix_min = 0.0f;
+    float range = 0.0f;
+    float scale = 1.0f;
+    float base = 0.0f;
+    float base_min = 0.0f;
+    float base_max = 0.0f;
+    uint8_t moto_cnt = 0;
+    uint8_t i = 0;
 
     if ((!SrvActuator_Obj.init) ||
+        (table == NULL) ||
         (pid_ctl == NULL))
         return false;
 
+    moto_cnt = table->moto_cnt;
+    if (moto_cnt > SrvActuator_Obj.drive_module.num.moto_cnt)
+        moto_cnt = SrvActuator_Obj.drive_module.num.moto_cnt;
+
     /* limit throttle max output at 80% */
     if (pid_ctl[Actuator_Ctl_Throttle] >= SRV_ACTUATOR_MAX_THROTTLE_PERCENT)
         pid_ctl[Actuator_Ctl_Throttle] = SRV_ACTUATOR_MAX_THROTTLE_PERCENT;
 
-    throttle_base_percent = pid_ctl[Actuator_Ctl_Throttle] / 100.0f;
+    /* control channel carry signed value */
+    gyr_x = (int16_t)pid_ctl[Actuator_Ctl_GyrX];
+    gyr_y = (int16_t)pid_ctl[Actuator_Ctl_GyrY];
+    gyr_z = (int16_t)pid_ctl[Actuator_Ctl_GyrZ];
 
-    for (uint8_t i = 0; i < 4; i++)
+    for (i = 0; i < moto_cnt; i++)
     {
-        SrvActuator_Obj.drive_module.obj_list[i].ctl_val = (SrvActuator_Obj.drive_module.obj_list[i].max_val -
-                                                            SrvActuator_Obj.drive_module.obj_list[i].min_val) *
-                                                            throttle_base_percent +
-                                                            SrvActuator_Obj.drive_module.obj_list[i].min_val;
+        mix[i] = table->factor[i].gyr_x * gyr_x + table->factor[i].gyr_y * gyr_y + table->factor[i].gyr_z * gyr_z;
+        mix_max = (mix[i] > mix_max) ? mix[i] : mix_max;
+        mix_min = (mix[i] < mix_min) ? mix[i] : mix_min;
     }
 
-    SrvActuator_Obj.drive_module.obj_list[0].ctl_val += pid_ctl[Actuator_Ctl_GyrX] - pid_ctl[Actuator_Ctl_GyrY] - pid_ctl[Actuator_Ctl_GyrZ];
-    SrvActuator_Obj.drive_module.obj_list[1].ctl_val += pid_ctl[Actuator_Ctl_GyrX] + pid_ctl[Actuator_Ctl_GyrY] + pid_ctl[Actuator_Ctl_GyrZ];
-    SrvActuator_Obj.drive_module.obj_list[2].ctl_val -= pid_ctl[Actuator_Ctl_GyrX] + pid_ctl[Actuator_Ctl_GyrY] - pid_ctl[Actuator_Ctl_GyrZ];
-    SrvActuator_Obj.drive_module.obj_list[3].ctl_val -= pid_ctl[Actuator_Ctl_GyrX] - pid_ctl[Actuator_Ctl_GyrY] + pid_ctl[Actuator_Ctl_GyrZ];
+    /* attitude demand wider than the moto range, scale it down */
+    range = (float)(moto[0].max_val - moto[0].idle_val);
+    if ((mix_max - mix_min) > range)
+    {
+        scale = range / (mix_max - mix_min);
+        mix_max *= scale;
+        mix_min *= scale;
+        SrvActuator_Obj.mix_statistic.desat_cnt ++;
+    }
 
-    for (uint8_t i = 0; i < SrvActuator_Obj.drive_module.num.moto_cnt; i++)
+    /* shift throttle so the lowest moto stay above idle and the highest stay under max */
+    base = (moto[0].max_val - moto[0].min_val) * (pid_ctl[Actuator_Ctl_Throttle] / 100.0f) + moto[0].min_val;
+    base_min = moto[0].idle_val - mix_min;
+    base_max = moto[0].max_val - mix_max;
+
+    if (base < base_min)
+    {
+        base = base_min;
+        SrvActuator_Obj.mix_statistic.shift_cnt ++;
+    }
+    else if (base > base_max)
+    {
+        base = base_max;
+        SrvActuator_Obj.mix_statistic.shift_cnt ++;
+    }
+
+    for (i = 0; i < moto_cnt; i++)
     {
-        if (SrvActuator_Obj.drive_module.obj_list[i].ctl_val <= SrvActuator_Obj.drive_module.obj_list[i].idle_val)
+        moto[i].ctl_val = (uint16_t)(base + mix[i] * scale + 0.5f);
+
+        /* rounding guard only, desaturation already keep value in range */
+        if (moto[i].ctl_val < moto[i].idle_val)
         {
-            SrvActuator_Obj.drive_module.obj_list[i].ctl_val = SrvActuator_Obj.drive_module.obj_list[i].idle_val;
+            moto[i].ctl_val = moto[i].idle_val;
         }
-        else if (SrvActuator_Obj.drive_module.obj_list[i].ctl_val >= SrvActuator_Obj.drive_module.obj_list[i].max_val)
-            SrvActuator_Obj.drive_module.obj_list[i].ctl_val = SrvActuator_Obj.drive_module.obj_list[i].max_val;
+        else if (moto[i].ctl_val > moto[i].max_val)
+            moto[i].ctl_val = moto[i].max_val;
 
-        switch (SrvActuator_Obj.drive_module.obj_list[i].drv_type)
+        switch (moto[i].drv_type)
         {
             case Actuator_DevType_DShot150:
             case Actuator_DevType_DShot300:
             case Actuator_DevType_DShot600:
-                DevDshot.control(SrvActuator_Obj.drive_module.obj_list[i].drv_obj, SrvActuator_Obj.drive_module.obj_list[i].ctl_val);
+                SrvActuator_Moto_Output(&moto[i], moto[i].ctl_val);
                 break;
 
             default:
@@ -482,9 +665,145 @@ static bool SrvActuator_QuadDrone_MotoMixControl(uint16_t *pid_ctl)
         }
     }
 
+    SrvActuator_Moto_Flush();
     return true;
 }
 
+/* burst moto only latch the value here, frame sent by SrvActuator_Moto_Flush */
+static void SrvActuator_Moto_Output(SrvActuator_PWMOutObj_TypeDef *moto, uint16_t val)
+{
+#if SRV_ACTUATOR_DSHOT_BURST
+    if (moto->burst_id != SRV_ACTUATOR_BURST_NONE)
+    {
+        DevDshot.burst_set(moto->drv_obj, moto->burst_index, val);
+        return;
+    }
+#endif
+
+    DevDshot.control(moto->drv_obj, val);
+}
+
+static void SrvActuator_Moto_Command(SrvActuator_PWMOutObj_TypeDef *moto, uint8_t cmd)
+{
+#if SRV_ACTUATOR_DSHOT_BURST
+    if (moto->burst_id != SRV_ACTUATOR_BURST_NONE)
+    {
+        DevDshot.burst_command(moto->drv_obj, moto->burst_index, cmd);
+        return;
+    }
+#endif
+
+    DevDshot.command(moto->drv_obj, cmd);
+}
+
+static float SrvActuator_Get_MotoRPM(SrvActuator_PWMOutObj_TypeDef *moto)
+{
+    uint32_t erpm = 0;
+
+    if (moto->drv_obj == NULL)
+        return 0.0f;
+
+#if SRV_ACTUATOR_DSHOT_BURST
+    /* no answer capture in burst mode */
+    if (moto->burst_id != SRV_ACTUATOR_BURST_NONE)
+        return 0.0f;
+#endif
+
+    if (!DevDshot.get_erpm(moto->drv_obj, &erpm))
+        return 0.0f;
+
+    return (float)erpm / (SRV_ACTUATOR_MOTO_POLE_NUM / 2);
+}
+
+/* one dma per timer group */
+static void SrvActuator_Moto_Flush(void)
+{
+#if SRV_ACTUATOR_DSHOT_BURST
+    for (uint8_t i = 0; i < SrvActuator_Obj.burst_cnt; i++)
+    {
+        DevDshot.burst_control(SrvActuator_Obj.burst_list[i]);
+    }
+#endif
+}
+
+#if SRV_ACTUATOR_DSHOT_BURST
+/*
+ * group moto by timer, each group driven by the update dma of its timer
+ * the stream of the first group member that own one is taken by the burst, stream of the other member stay unused
+ */
+static void SrvActuator_Burst_Init(void)
+{
+    SrvActuator_PWMOutObj_TypeDef *moto = SrvActuator_Obj.drive_module.obj_list;
+    SrvActuator_PeriphSet_TypeDef *periph_ptr = NULL;
+    DevDshotBurstObj_TypeDef *burst_obj = NULL;
+    uint32_t ch[DSHOT_BURST_MAX_CH];
+    BspGPIO_Obj_TypeDef pin[DSHOT_BURST_MAX_CH];
+    uint8_t member[DSHOT_BURST_MAX_CH];
+    uint8_t member_cnt = 0;
+    uint32_t dma = 0;
+    uint32_t stream = 0;
+
+    SrvActuator_Obj.burst_cnt = 0;
+
+    for (uint8_t i = 0; i < SrvActuator_Obj.drive_module.num.moto_cnt; i++)
+    {
+        if (moto[i].burst_id != SRV_ACTUATOR_BURST_NONE)
+            continue;
+
+        if (SrvActuator_Obj.burst_cnt >= SRV_ACTUATOR_MAX_BURST_GROUP)
+            return;
+
+        member_cnt = 0;
+        dma = (uint32_t)Bsp_DMA_None;
+        stream = (uint32_t)Bsp_DMA_Stream_None;
+
+        for (uint8_t j = i; (j < SrvActuator_Obj.drive_module.num.moto_cnt) && (member_cnt < DSHOT_BURST_MAX_CH); j++)
+        {
+            periph_ptr = moto[j].periph_ptr;
+
+            if ((moto[j].burst_id != SRV_ACTUATOR_BURST_NONE) ||
+                (periph_ptr->tim_base != moto[i].periph_ptr->tim_base))
+                continue;
+
+            ch[member_cnt] = periph_ptr->tim_channel;
+            pin[member_cnt] = periph_ptr->pin;
+            member[member_cnt] = j;
+            member_cnt ++;
+
+            if ((dma == (uint32_t)Bsp_DMA_None) && (periph_ptr->dma != (uint32_t)Bsp_DMA_None))
+            {
+                dma = periph_ptr->dma;
+                stream = periph_ptr->dma_channel;
+            }
+        }
+
+        if (dma == (uint32_t)Bsp_DMA_None)
+            continue;
+
+        burst_obj = (DevDshotBurstObj_TypeDef *)SrvOsCommon.malloc_tag(SrvOs_Heap_DMA, sizeof(DevDshotBurstObj_TypeDef));
+        if (burst_obj == NULL)
+            return;
+
+        burst_obj->type = moto[i].drv_type;
+        if (!DevDshot.burst_init(burst_obj, moto[i].periph_ptr->tim_base, ch, pin, member_cnt, dma, stream))
+        {
+            SrvOsCommon.free(burst_obj);
+            continue;
+        }
+
+        for (uint8_t k = 0; k < member_cnt; k++)
+        {
+            moto[member[k]].drv_obj = burst_obj;
+            moto[member[k]].burst_id = SrvActuator_Obj.burst_cnt;
+            moto[member[k]].burst_index = k;
+        }
+
+        SrvActuator_Obj.burst_list[SrvActuator_Obj.burst_cnt] = burst_obj;
+        SrvActuator_Obj.burst_cnt ++;
+    }
+}
+#endif
+
 static bool SrvActuator_Get_MotoControlRange(uint8_t moto_index, int16_t *min, int16_t *idle, int16_t *max)
 {
     (*min) = 0;
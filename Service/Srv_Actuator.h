@@ -9,6 +9,7 @@
 #include "Bsp_DMA.h"
 #include "Dev_Dshot.h"
 #include "HW_Def.h"
+#include "../FCHW_Config.h"
 
 #define SRVACTUATOR_PB0_SIG_1       \
     (SrvActuator_PeriphSet_TypeDef) \
@@ -229,11 +230,28 @@
     }
 
 #define SRV_ACTUATOR_MAX_THROTTLE_PERCENT 80
+#define SRV_ACTUATOR_MAX_MIX_MOTO 8
+
+/*
+ * dshot moto on the same timer share one update dma burst, timer burst only implemented on stm32h7
+ * bidirectional dshot capture the answer on each channel dma, no burst then
+ */
+#if defined MATEKH743_V1_5 && (DSHOT_BIDIR == OFF)
+#define SRV_ACTUATOR_DSHOT_BURST 1
+#else
+#define SRV_ACTUATOR_DSHOT_BURST 0
+#endif
+#define SRV_ACTUATOR_MAX_BURST_GROUP 4
+#define SRV_ACTUATOR_BURST_NONE 0xFF
+
+/* erpm to mechanical rpm, read back through bidirectional dshot */
+#define SRV_ACTUATOR_MOTO_POLE_NUM 14
 
 typedef enum
 {
     Model_Quad = 0,
     Model_Hex,
+    Model_Quad_Plus,
 #if defined MATEKH743_V1_5
     Model_Oct,
     Model_X8,
@@ -310,6 +328,10 @@ typedef struct
     SrvActuator_PeriphSet_TypeDef *periph_ptr;
     void *drv_obj;
     SrvActuator_SpinDir_List spin_dir;
+
+    /* drv_obj point to the shared burst object when burst_id is not SRV_ACTUATOR_BURST_NONE */
+    uint8_t burst_id;
+    uint8_t burst_index;
 } SrvActuator_PWMOutObj_TypeDef;
 
 typedef struct
@@ -325,11 +347,36 @@ typedef struct
     SrvActuator_PWMOutObj_TypeDef *obj_list;
 } SrcActuatorCTL_Obj_TypeDef;
 
+/* per moto weight of each angular speed control channel */
+typedef struct
+{
+    float gyr_x;
+    float gyr_y;
+    float gyr_z;    /* positive on clockwise spin moto */
+} SrvActuator_MixFactor_TypeDef;
+
+typedef struct
+{
+    uint8_t moto_cnt;
+    SrvActuator_MixFactor_TypeDef factor[SRV_ACTUATOR_MAX_MIX_MOTO];
+} SrvActuator_MixTable_TypeDef;
+
+typedef struct
+{
+    uint32_t desat_cnt;     /* attitude demand scaled down to fit moto range */
+    uint32_t shift_cnt;     /* throttle shifted to keep attitude authority */
+} SrvActuator_MixStatistic_TypeDef;
+
 typedef struct
 {
     SrvActuator_Model_List model;
     bool init;
     SrcActuatorCTL_Obj_TypeDef drive_module;
+    const SrvActuator_MixTable_TypeDef *mix_table;
+    SrvActuator_MixStatistic_TypeDef mix_statistic;
+
+    uint8_t burst_cnt;
+    DevDshotBurstObj_TypeDef *burst_list[SRV_ACTUATOR_MAX_BURST_GROUP];
 } SrvActuatorObj_TypeDef;
 
 typedef struct
@@ -341,6 +388,9 @@ typedef struct
 
     uint16_t moto[8];
     uint16_t servo[8];
+
+    /* mechanical rpm, 0 when no telemetry */
+    float moto_rpm[SRV_ACTUATOR_MAX_MIX_MOTO];
 } SrvActuatorPipeData_TypeDef;
 
 typedef struct
@@ -4,9 +4,13 @@
 #include "HW_Def.h"
 #include "debug_util.h"
 #include "error_log.h"
-#include "bsp_iic.h"
-#include "bsp_gpio.h"
+#include "Bsp_IIC.h"
+#include "Bsp_GPIO.h"
 #include <math.h>
+#include "math_util.h"
+
+/* float only, at32f435 have no double fpu */
+#pragma GCC diagnostic warning "-Wdouble-promotion"
 
 #define STANDER_ATMOSPHERIC_PRESSURE (101.325f * 1000)
 #define SRVBARO_SMOOTHWINDOW_SIZE 5
@@ -345,7 +349,7 @@ static GenCalib_State_TypeList SrvBaro_Get_Calib(void)
 
 static float SrvBaro_PessureCnvToMeter(float pa)
 {
-    return ((1 - pow((pa / STANDER_ATMOSPHERIC_PRESSURE), 0.1903))) * 44330;
+    return (1.0f - Fast_Powf((pa / STANDER_ATMOSPHERIC_PRESSURE), 0.1903f)) * 44330.0f;
 }
 
 static bool SrvBaro_Get_Date(SrvBaroData_TypeDef *data)
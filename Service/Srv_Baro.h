@@ -6,7 +6,7 @@
 #include <string.h>
 #include <math.h>
 #include "Dev_DPS310.h"
-#include "../algorithm/Filter_Dep/filter.h"
+#include "../Algorithm/Filter_Dep/filter.h"
 #include "gen_calib.h"
 
 #define SRVBARO_SAMPLE_RATE_LIMIT SRVBARO_SAMPLE_RATE_100HZ   /* max sample rate 100Hz */
@@ -3,6 +3,9 @@
 #include "DataPipe.h"
 #include "Srv_OsCommon.h"
 #include "Bsp_Uart.h"
+#include "kernel.h"
+#include "profiler.h"
+#include "Srv_Param.h"
 
 #define To_DataPack_Callback(x) (DataPack_Callback)x
 
@@ -14,12 +17,19 @@ SrvComProto_Monitor_TypeDef SrvComProto_monitor = {
     .init_state = false,
 };
 
+/* parameter answer is packed on demand, only used in scheduler run */
+static mavlink_message_t SrvComProto_ParamMsg;
+static uint8_t SrvComProto_ParamBuf[MAVLINK_MAX_PACKET_LEN];
+
 /* internal function */
+static uint16_t SrvComProto_MavMsg_ParamValue(uint16_t index);
+static void SrvComProto_Sched_Param(SrvComProto_SchedPort_TypeDef *p_port);
 static uint16_t SrvComProto_MavMsg_Raw_IMU(SrvComProto_MsgInfo_TypeDef *pck);
 static uint16_t SrvComProto_MavMsg_Scaled_IMU(SrvComProto_MsgInfo_TypeDef *pck);
 static uint16_t SrvComProto_MavMsg_Attitude(SrvComProto_MsgInfo_TypeDef *pck);
 static uint16_t SrvConProto_MavMsg_RC(SrvComProto_MsgInfo_TypeDef *pck);
 static uint16_t SrvComProto_MavMsg_Altitude(SrvComProto_MsgInfo_TypeDef *pck);
+static uint16_t SrvComProto_MavMsg_Profiler(SrvComProto_MsgInfo_TypeDef *pck);
 
 /* just fot temporary will create custom message in the next */
 static uint16_t SrvComProto_MavMsg_Exp_Attitude(SrvComProto_MsgInfo_TypeDef *pck);
@@ -31,6 +41,13 @@ static void SrvComProto_MsgToStream(SrvComProto_MsgInfo_TypeDef *msg, SrvComProt
 static bool SrvComProto_MsgEnable_Control(SrvComProto_MsgInfo_TypeDef *msg, bool state);
 static SrvComProto_Type_List Srv_ComProto_GetType(void);
 static SrvComProto_Msg_StreamIn_TypeDef SrvComProto_MavMsg_Input_Decode(uint8_t *p_data, uint16_t size);
+static bool SrvComProto_Sched_Init(SrvComProto_Scheduler_TypeDef *sched);
+static int8_t SrvComProto_Sched_AddMsg(SrvComProto_Scheduler_TypeDef *sched, SrvComProto_MsgInfo_TypeDef *msg, uint8_t *p_buf, uint16_t buf_size);
+static int8_t SrvComProto_Sched_AddPort(SrvComProto_Scheduler_TypeDef *sched, void *port_arg, ComProto_Callback tx_cb, uint32_t baudrate);
+static bool SrvComProto_Sched_SetRate(SrvComProto_Scheduler_TypeDef *sched, int8_t port_id, int8_t msg_id, uint16_t period);
+static bool SrvComProto_Sched_PortCtl(SrvComProto_Scheduler_TypeDef *sched, int8_t port_id, bool state);
+static void SrvComProto_Sched_Run(SrvComProto_Scheduler_TypeDef *sched);
+static bool SrvComProto_MavPort_Input(SrvComProto_Scheduler_TypeDef *sched, int8_t port_id, uint8_t *p_data, uint16_t size);
 
 SrvComProto_TypeDef SrvComProto = {
     .init = Srv_ComProto_Init,
@@ -39,6 +56,13 @@ SrvComProto_TypeDef SrvComProto = {
     .mav_msg_stream = SrvComProto_MsgToStream,
     .mav_msg_enable_ctl = SrvComProto_MsgEnable_Control,
     .msg_decode = SrvComProto_MavMsg_Input_Decode,
+    .mav_sched_init = SrvComProto_Sched_Init,
+    .mav_sched_add_msg = SrvComProto_Sched_AddMsg,
+    .mav_sched_add_port = SrvComProto_Sched_AddPort,
+    .mav_sched_set_rate = SrvComProto_Sched_SetRate,
+    .mav_sched_port_ctl = SrvComProto_Sched_PortCtl,
+    .mav_sched_run = SrvComProto_Sched_Run,
+    .mav_port_input = SrvComProto_MavPort_Input,
 };
 
 static bool Srv_ComProto_Init(SrvComProto_Type_List type, uint8_t *arg)
@@ -114,6 +138,10 @@ static bool Srv_ComProto_MsgObj_Init(SrvComProto_MsgInfo_TypeDef *msg, SrvComPro
         msg->pack_callback = To_DataPack_Callback(SrvComProto_MavMsg_Scaled_IMU);
         break;
 
+    case MAV_CompoID_Profiler:
+        msg->pack_callback = To_DataPack_Callback(SrvComProto_MavMsg_Profiler);
+        break;
+
     case MAV_CompoID_MotoCtl:
         break;
 
@@ -171,6 +199,427 @@ static bool SrvComProto_MsgEnable_Control(SrvComProto_MsgInfo_TypeDef *msg, bool
     return true;
 }
 
+/************************************** telemetry scheduler section ********************************************/
+/* 
+ * every message is packed (datahub read + crc) at most once per period into its own serialized buffer,
+ * then the same frame is fanned out to every port whose rate schedule wants it.
+ * each port owns a byte credit refilled from its baudrate, frames that do not fit are deferred to the next run.
+ */
+static bool SrvComProto_Sched_Init(SrvComProto_Scheduler_TypeDef *sched)
+{
+    if (sched == NULL)
+        return false;
+
+    memset(sched, 0, sizeof(SrvComProto_Scheduler_TypeDef));
+    return true;
+}
+
+static int8_t SrvComProto_Sched_AddMsg(SrvComProto_Scheduler_TypeDef *sched, SrvComProto_MsgInfo_TypeDef *msg, uint8_t *p_buf, uint16_t buf_size)
+{
+    SrvComProto_SchedMsg_TypeDef *p_slot = NULL;
+
+    if ((sched == NULL) || (msg == NULL) || (msg->msg_obj == NULL) || \
+        (p_buf == NULL) || (buf_size < MAVLINK_NUM_NON_PAYLOAD_BYTES) || \
+        (sched->msg_num >= SrvComProto_Sched_MaxMsg))
+        return -1;
+
+    p_slot = &sched->msg_list[sched->msg_num];
+    memset(p_slot, 0, sizeof(SrvComProto_SchedMsg_TypeDef));
+
+    p_slot->msg = msg;
+    p_slot->stream.p_buf = p_buf;
+    p_slot->stream.size = 0;
+    p_slot->stream.max_size = buf_size;
+
+    sched->msg_num ++;
+    return (sched->msg_num - 1);
+}
+
+static int8_t SrvComProto_Sched_AddPort(SrvComProto_Scheduler_TypeDef *sched, void *port_arg, ComProto_Callback tx_cb, uint32_t baudrate)
+{
+    SrvComProto_SchedPort_TypeDef *p_port = NULL;
+
+    if ((sched == NULL) || (tx_cb == NULL) || (sched->port_num >= SrvComProto_Sched_MaxPort))
+        return -1;
+
+    p_port = &sched->port_list[sched->port_num];
+    memset(p_port, 0, sizeof(SrvComProto_SchedPort_TypeDef));
+
+    p_port->port_arg = port_arg;
+    p_port->tx_cb = tx_cb;
+    p_port->chan = sched->port_num;
+    p_port->baudrate = baudrate;
+
+    if (baudrate != SrvComProto_Sched_Unlimited)
+    {
+        /* 8N1 frame 10 bit per byte */
+        p_port->byte_rate = ((baudrate / 10) * SrvComProto_Sched_LinkUsage) / 100;
+        p_port->credit_max = p_port->byte_rate * SrvComProto_Sched_BurstTime;
+
+        /* at least one full mavlink frame can be send in one burst */
+        if (p_port->credit_max < (MAVLINK_MAX_PACKET_LEN * 1000))
+            p_port->credit_max = MAVLINK_MAX_PACKET_LEN * 1000;
+
+        p_port->credit = p_port->credit_max;
+    }
+
+    p_port->refill_time = SrvOsCommon.get_os_ms();
+    p_port->enable = true;
+
+    sched->port_num ++;
+    return (sched->port_num - 1);
+}
+
+static bool SrvComProto_Sched_SetRate(SrvComProto_Scheduler_TypeDef *sched, int8_t port_id, int8_t msg_id, uint16_t period)
+{
+    if ((sched == NULL) || \
+        (port_id < 0) || (port_id >= sched->port_num) || \
+        (msg_id < 0) || (msg_id >= sched->msg_num))
+        return false;
+
+    sched->port_list[port_id].period[msg_id] = period;
+    sched->port_list[port_id].send_time[msg_id] = 0;
+    return true;
+}
+
+static bool SrvComProto_Sched_PortCtl(SrvComProto_Scheduler_TypeDef *sched, int8_t port_id, bool state)
+{
+    if ((sched == NULL) || (port_id < 0) || (port_id >= sched->port_num))
+        return false;
+
+    sched->port_list[port_id].enable = state;
+    return true;
+}
+
+static inline bool SrvComProto_Sched_PortDue(SrvComProto_SchedPort_TypeDef *p_port, uint8_t msg_id, uint32_t sys_time)
+{
+    if (!p_port->enable || (p_port->period[msg_id] == 0))
+        return false;
+
+    if (p_port->send_time[msg_id] && ((sys_time - p_port->send_time[msg_id]) < p_port->period[msg_id]))
+        return false;
+
+    return true;
+}
+
+static void SrvComProto_Sched_Refill(SrvComProto_SchedPort_TypeDef *p_port, uint32_t sys_time)
+{
+    uint32_t elapsed = sys_time - p_port->refill_time;
+
+    if ((p_port->byte_rate == 0) || (elapsed == 0))
+        return;
+
+    p_port->refill_time = sys_time;
+
+    /* byte_rate in byte/s equal to 1/1000 byte per ms */
+    if (elapsed >= SrvComProto_Sched_BurstTime)
+    {
+        p_port->credit = p_port->credit_max;
+        return;
+    }
+
+    p_port->credit += elapsed * p_port->byte_rate;
+    if (p_port->credit > p_port->credit_max)
+        p_port->credit = p_port->credit_max;
+}
+
+static bool SrvComProto_Sched_Pack(SrvComProto_SchedMsg_TypeDef *p_slot, uint32_t sys_time)
+{
+    SrvComProto_MsgInfo_TypeDef *msg = p_slot->msg;
+    uint16_t payload_size = 0;
+
+    /* already packed in this period, reuse serialized frame */
+    if (p_slot->stream.size && (p_slot->pack_time == sys_time))
+        return true;
+
+    if (!msg->enable || (msg->pack_callback == NULL) || msg->lock_proto)
+        return false;
+
+    msg->in_proto = true;
+
+    p_slot->stream.size = 0;
+    payload_size = msg->pack_callback((uint8_t *)msg);
+
+    if (payload_size && ((payload_size + MAVLINK_NUM_NON_PAYLOAD_BYTES) <= p_slot->stream.max_size))
+    {
+        p_slot->stream.size = mavlink_msg_to_send_buffer(p_slot->stream.p_buf, msg->msg_obj);
+        p_slot->pack_time = sys_time;
+        p_slot->pack_cnt ++;
+        msg->proto_time = sys_time;
+    }
+
+    msg->in_proto = false;
+
+    return (p_slot->stream.size != 0);
+}
+
+static void SrvComProto_Sched_Run(SrvComProto_Scheduler_TypeDef *sched)
+{
+    SrvComProto_SchedMsg_TypeDef *p_slot = NULL;
+    SrvComProto_SchedPort_TypeDef *p_port = NULL;
+    uint32_t sys_time = 0;
+    uint32_t cost = 0;
+    bool due = false;
+
+    if ((sched == NULL) || (sched->port_num == 0))
+        return;
+
+    sys_time = SrvOsCommon.get_os_ms();
+
+    for (uint8_t p = 0; p < sched->port_num; p++)
+        SrvComProto_Sched_Refill(&sched->port_list[p], sys_time);
+
+    for (uint8_t m = 0; m < sched->msg_num; m++)
+    {
+        p_slot = &sched->msg_list[m];
+        due = false;
+
+        for (uint8_t p = 0; p < sched->port_num; p++)
+        {
+            if (SrvComProto_Sched_PortDue(&sched->port_list[p], m, sys_time))
+            {
+                due = true;
+                break;
+            }
+        }
+
+        /* pack once then send to all port in need */
+        if (!due || !SrvComProto_Sched_Pack(p_slot, sys_time))
+            continue;
+
+        cost = p_slot->stream.size * 1000;
+
+        for (uint8_t p = 0; p < sched->port_num; p++)
+        {
+            p_port = &sched->port_list[p];
+
+            if (!SrvComProto_Sched_PortDue(p_port, m, sys_time))
+                continue;
+
+            if (p_port->byte_rate)
+            {
+                /* out of bandwidth budget, try again on next scheduler run */
+                if (p_port->credit < cost)
+                {
+                    p_port->throttle_cnt ++;
+                    continue;
+                }
+
+                p_port->credit -= cost;
+            }
+
+            p_port->tx_cb(p_port->port_arg, p_slot->stream.p_buf, p_slot->stream.size);
+            p_port->send_time[m] = sys_time;
+            p_port->send_cnt ++;
+            p_port->send_byte += p_slot->stream.size;
+            p_slot->msg->proto_cnt ++;
+        }
+    }
+
+    /* parameter answer take the bandwidth left by telemetry */
+    for (uint8_t p = 0; p < sched->port_num; p++)
+        SrvComProto_Sched_Param(&sched->port_list[p]);
+}
+
+/************************************************** parameter section ************************************************/
+static uint16_t SrvComProto_MavMsg_ParamValue(uint16_t index)
+{
+    SrvParam_Info_TypeDef info;
+    uint8_t mav_type = MAV_PARAM_TYPE_REAL32;
+
+    if (!SrvParam.get(index, &info))
+        return 0;
+
+    switch ((uint8_t)info.type)
+    {
+        case SrvParam_U8: mav_type = MAV_PARAM_TYPE_UINT8; break;
+        case SrvParam_I32: mav_type = MAV_PARAM_TYPE_INT32; break;
+        default: break;
+    }
+
+    mavlink_msg_param_value_pack_chan(MAV_SysID_Drone, SrvComProto_Param_CompoID, 0, &SrvComProto_ParamMsg,
+                                      info.name, info.val, mav_type, SrvParam.get_num(), index);
+
+    return mavlink_msg_to_send_buffer(SrvComProto_ParamBuf, &SrvComProto_ParamMsg);
+}
+
+/* single read / set answer first then the list, value is read from ram table at the time it is sent */
+static void SrvComProto_Sched_Param(SrvComProto_SchedPort_TypeDef *p_port)
+{
+    SrvComProto_ParamStream_TypeDef *p_param = &p_port->param;
+    SrvComProto_ParamReq_TypeDef *p_req = NULL;
+    uint16_t param_num = SrvParam.get_num();
+    uint16_t index = 0;
+    uint16_t size = 0;
+    uint32_t cost = 0;
+    bool from_queue = false;
+
+    if (!p_port->enable)
+        return;
+
+    if (p_param->list_req)
+    {
+        p_param->list_req = false;
+        p_param->list_active = true;
+        p_param->list_index = 0;
+    }
+
+    for (uint8_t burst = 0; burst < SrvComProto_Param_BurstNum; )
+    {
+        from_queue = (p_param->req_tail != __atomic_load_n(&p_param->req_head, __ATOMIC_ACQUIRE));
+
+        if (from_queue)
+        {
+            p_req = &p_param->req[p_param->req_tail & (SrvComProto_Param_QueueSize - 1)];
+
+            /* apply once, answer may wait for bandwidth
+             * rejected set is answered too, with the value still in use so the gcs stop retrying and show it */
+            if (p_req->set)
+            {
+                p_req->set = false;
+                if (!SrvParam.set(p_req->index, p_req->val))
+                    p_param->reject_cnt ++;
+            }
+
+            index = p_req->index;
+        }
+        else if (p_param->list_active && (p_param->list_index < param_num))
+        {
+            index = p_param->list_index;
+        }
+        else
+        {
+            p_param->list_active = false;
+            return;
+        }
+
+        size = SrvComProto_MavMsg_ParamValue(index);
+        cost = size * 1000;
+
+        if (size && p_port->byte_rate)
+        {
+            if (p_port->credit < cost)
+            {
+                p_port->throttle_cnt ++;
+                return;
+            }
+
+            p_port->credit -= cost;
+        }
+
+        if (from_queue)
+        {
+            p_param->req_tail ++;
+        }
+        else
+            p_param->list_index ++;
+
+        if (size == 0)
+            continue;
+
+        p_port->tx_cb(p_port->port_arg, SrvComProto_ParamBuf, size);
+        p_port->send_cnt ++;
+        p_port->send_byte += size;
+        p_param->send_cnt ++;
+        burst ++;
+    }
+}
+
+static void SrvComProto_Param_Push(SrvComProto_ParamStream_TypeDef *p_param, uint16_t index, bool set, float val)
+{
+    SrvComProto_ParamReq_TypeDef *p_req = NULL;
+    uint8_t head = p_param->req_head;
+
+    if ((uint8_t)(head - p_param->req_tail) >= SrvComProto_Param_QueueSize)
+    {
+        p_param->drop_cnt ++;
+        return;
+    }
+
+    p_req = &p_param->req[head & (SrvComProto_Param_QueueSize - 1)];
+    p_req->index = index;
+    p_req->set = set;
+    p_req->val = val;
+
+    __atomic_store_n(&p_param->req_head, (uint8_t)(head + 1), __ATOMIC_RELEASE);
+}
+
+/* feed new received byte to the parser channel of this port, each byte only once
+ * frame split between two receive keep in the channel state, parameter request is queued for the scheduler run
+ * called from port receive context so nothing but queueing is done in here
+ * return true when at least one mavlink frame is completed */
+static bool SrvComProto_MavPort_Input(SrvComProto_Scheduler_TypeDef *sched, int8_t port_id, uint8_t *p_data, uint16_t size)
+{
+    SrvComProto_ParamStream_TypeDef *p_param = NULL;
+    mavlink_message_t mav_msg;
+    mavlink_status_t mav_sta;
+    mavlink_param_request_list_t req_list;
+    mavlink_param_request_read_t req_read;
+    mavlink_param_set_t req_set;
+    char param_id[SRV_PARAM_NAME_LEN];
+    int16_t index = 0;
+    bool frame = false;
+
+    if ((sched == NULL) || (port_id < 0) || (port_id >= sched->port_num) || (p_data == NULL) || (size == 0))
+        return false;
+
+    p_param = &sched->port_list[port_id].param;
+
+    for (uint16_t i = 0; i < size; i++)
+    {
+        if (mavlink_frame_char(sched->port_list[port_id].chan, p_data[i], &mav_msg, &mav_sta) != MAVLINK_FRAMING_OK)
+            continue;
+
+        frame = true;
+
+        switch (mav_msg.msgid)
+        {
+            case MAVLINK_MSG_ID_PARAM_REQUEST_LIST:
+                mavlink_msg_param_request_list_decode(&mav_msg, &req_list);
+                if ((req_list.target_system != 0) && (req_list.target_system != MAV_SysID_Drone))
+                    break;
+
+                p_param->list_req = true;
+                break;
+
+            case MAVLINK_MSG_ID_PARAM_REQUEST_READ:
+                mavlink_msg_param_request_read_decode(&mav_msg, &req_read);
+                if ((req_read.target_system != 0) && (req_read.target_system != MAV_SysID_Drone))
+                    break;
+
+                index = req_read.param_index;
+                if (index < 0)
+                {
+                    memcpy(param_id, req_read.param_id, SRV_PARAM_NAME_LEN);
+                    index = SrvParam.search(param_id);
+                }
+
+                if ((index >= 0) && (index < SrvParam.get_num()))
+                    SrvComProto_Param_Push(p_param, index, false, 0.0f);
+
+                break;
+
+            case MAVLINK_MSG_ID_PARAM_SET:
+                mavlink_msg_param_set_decode(&mav_msg, &req_set);
+                if ((req_set.target_system != 0) && (req_set.target_system != MAV_SysID_Drone))
+                    break;
+
+                memcpy(param_id, req_set.param_id, SRV_PARAM_NAME_LEN);
+                index = SrvParam.search(param_id);
+
+                if (index >= 0)
+                    SrvComProto_Param_Push(p_param, index, true, req_set.param_value);
+
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    return frame;
+}
+
 static uint16_t SrvComProto_MavMsg_Moto(SrvComProto_MsgInfo_TypeDef *pck)
 {
     uint32_t time_stamp = 0;
@@ -386,16 +835,75 @@ static uint16_t SrvComProto_MavMsg_Altitude(SrvComProto_MsgInfo_TypeDef *pck)
                                           baro_alt, baro_pressure, 0, 0, 0, 0);
 }
 
+/*
+ * profiler entry in debug vector, one entry each frame in round robin
+ * task    : x load (%)     y stack free (word)  z 0
+ * section : x avg (us)     y max (us)           z overrun count
+ * "cpu"   : x cpu load (%) y isr load (%)       z window count
+ */
+static uint16_t SrvComProto_MavMsg_Profiler(SrvComProto_MsgInfo_TypeDef *pck)
+{
+    static uint8_t entry = 0;
+    Profiler_Summary_TypeDef summary;
+    Profiler_Task_TypeDef task;
+    Profiler_Section_TypeDef section;
+    char name[MAVLINK_MSG_DEBUG_VECT_FIELD_NAME_LEN];
+    float cyc_per_us = Kernel_Get_SysClock() / 1000000.0f;
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+
+    memset(name, 0, sizeof(name));
+    Profiler.get_summary(&summary);
+
+    if (entry >= (summary.task_num + Profiler_Sec_Sum + 1))
+        entry = 0;
+
+    if (entry < summary.task_num)
+    {
+        Profiler.get_task(entry, &task);
+        strncpy(name, task.name, sizeof(name));
+        x = task.load / 100.0f;
+        y = task.stack_free;
+    }
+    else if (entry < (summary.task_num + Profiler_Sec_Sum))
+    {
+        Profiler.get_section((Profiler_Section_List)(entry - summary.task_num), &section);
+        strncpy(name, section.name, sizeof(name));
+
+        if (section.cnt)
+            x = (section.sum_cyc / section.cnt) / cyc_per_us;
+
+        y = section.max_cyc / cyc_per_us;
+        z = section.overrun_cnt;
+    }
+    else
+    {
+        strncpy(name, "cpu", sizeof(name));
+        x = summary.cpu_load / 100.0f;
+        y = summary.isr_load / 100.0f;
+        z = summary.window_cnt;
+    }
+
+    entry ++;
+
+    return mavlink_msg_debug_vect_pack_chan(pck->pck_info.system_id,
+                                            pck->pck_info.component_id,
+                                            pck->pck_info.chan, pck->msg_obj,
+                                            name, SrvOsCommon.get_os_ms() * 1000ULL,
+                                            x, y, z);
+}
+
+/* mavlink frame is parsed byte by byte on its own port channel by mav_port_input, only cli line is matched in here */
 static SrvComProto_Msg_StreamIn_TypeDef SrvComProto_MavMsg_Input_Decode(uint8_t *p_data, uint16_t size)
 {
     SrvComProto_Msg_StreamIn_TypeDef stream_in; 
-    uint8_t default_channel = 0;
-    mavlink_message_t mav_msg;
-    mavlink_status_t mav_sta;
-    uint8_t mav_decode = 0;
 
     memset(&stream_in, 0, sizeof(SrvComProto_Msg_StreamIn_TypeDef));
 
+    if ((p_data == NULL) || (size < 2))
+        goto input_stream_valid;
+
     /* match cli */
     if((p_data[size - 1] == '\n') && (p_data[size - 2] == '\r'))
     {
@@ -403,32 +911,6 @@ static SrvComProto_Msg_StreamIn_TypeDef SrvComProto_MavMsg_Input_Decode(uint8_t
         stream_in.valid = true;
         stream_in.size = size;
         stream_in.p_buf = p_data;
-    
-        goto input_stream_valid;
-    }
-    
-    memset(&mav_msg, 0, sizeof(mavlink_message_t));
-    memset(&mav_sta, 0, sizeof(mavlink_status_t));
-    
-    /* match mavlink message */
-    for(uint16_t i = 0; i < size; i++)
-    {
-        mav_decode = mavlink_frame_char(default_channel, p_data[i], &mav_msg, &mav_sta);
-
-        if(mav_decode && (i < size))
-        {
-            /* get multi protocol frame in one transmition and first protocol frame is mavlink message */
-            /* only decode first pack */
-            break;
-        }
-    }
-
-    if(mav_decode)
-    {
-        stream_in.pac_type = ComFrame_MavMsg;
-        stream_in.valid = true;
-        stream_in.size = size;
-        stream_in.p_buf = p_data;
     }
 
     /* custom frame input check */
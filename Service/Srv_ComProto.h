@@ -12,6 +12,21 @@ typedef bool (*ComProto_Callback)(void *arg, uint8_t *p_data, uint32_t len);
 typedef uint16_t (*DataPack_Callback)(uint8_t *pck);
 typedef uint32_t ComPort_Handle;
 
+#define SrvComProto_Sched_MaxMsg 12
+#define SrvComProto_Sched_MaxPort 4
+#define SrvComProto_Sched_LinkUsage 80  /* unit: % of link bandwidth telemetry is allowed to use */
+#define SrvComProto_Sched_BurstTime 20  /* unit: ms max bandwidth credit a port can accumulate */
+#define SrvComProto_Sched_Unlimited 0   /* port baudrate 0 means no bandwidth limit (USB VCP) */
+
+#define SrvComProto_Param_QueueSize 8   /* read / set answer pending on one port, power of 2 */
+#define SrvComProto_Param_BurstNum 8    /* max PARAM_VALUE sent on one port in one scheduler run */
+#define SrvComProto_Param_CompoID 1     /* MAV_COMP_ID_AUTOPILOT1 ground station only list parameter of the autopilot */
+
+/* every scheduler port own one mavlink parser channel */
+#if (SrvComProto_Sched_MaxPort > MAVLINK_COMM_NUM_BUFFERS)
+#error "SrvComProto_Sched_MaxPort exceed MAVLINK_COMM_NUM_BUFFERS"
+#endif
+
 typedef enum
 {
     ComFrame_Unknow = 0,
@@ -50,6 +65,7 @@ typedef enum
     MAV_CompoID_RC_Channel,
     MAV_CompoID_MotoCtl,
     MAV_CompoID_ServoCtl,
+    MAV_CompoID_Profiler,
 } SrvComProto_ComponentID_List;
 
 typedef enum
@@ -97,6 +113,70 @@ typedef struct
     bool lock_proto;
 } SrvComProto_MsgInfo_TypeDef;
 
+/* one slot per message type, packed once and shared by every port */
+typedef struct
+{
+    SrvComProto_MsgInfo_TypeDef *msg;
+    SrvComProto_Stream_TypeDef stream;
+    uint32_t pack_time;
+    uint32_t pack_cnt;
+} SrvComProto_SchedMsg_TypeDef;
+
+typedef struct
+{
+    bool set;
+    uint16_t index;
+    float val;
+} SrvComProto_ParamReq_TypeDef;
+
+/* request pushed in from port receive context, answered in the scheduler run */
+typedef struct
+{
+    volatile bool list_req;
+    bool list_active;
+    uint16_t list_index;
+
+    SrvComProto_ParamReq_TypeDef req[SrvComProto_Param_QueueSize];
+    volatile uint8_t req_head;
+    uint8_t req_tail;
+
+    uint32_t send_cnt;
+    uint32_t drop_cnt;
+    uint32_t reject_cnt;
+} SrvComProto_ParamStream_TypeDef;
+
+typedef struct
+{
+    bool enable;
+    void *port_arg;
+    ComProto_Callback tx_cb;
+    uint8_t chan;           /* mavlink parser channel, partial frame of one link never mix with another */
+
+    uint32_t baudrate;
+    uint32_t byte_rate;     /* unit: byte/s */
+    uint32_t credit;        /* unit: 1/1000 byte */
+    uint32_t credit_max;    /* unit: 1/1000 byte */
+    uint32_t refill_time;
+
+    uint16_t period[SrvComProto_Sched_MaxMsg];   /* unit: ms 0 means not send on this port */
+    uint32_t send_time[SrvComProto_Sched_MaxMsg];
+
+    uint32_t send_cnt;
+    uint32_t send_byte;
+    uint32_t throttle_cnt;
+
+    SrvComProto_ParamStream_TypeDef param;
+} SrvComProto_SchedPort_TypeDef;
+
+typedef struct
+{
+    uint8_t msg_num;
+    uint8_t port_num;
+
+    SrvComProto_SchedMsg_TypeDef msg_list[SrvComProto_Sched_MaxMsg];
+    SrvComProto_SchedPort_TypeDef port_list[SrvComProto_Sched_MaxPort];
+} SrvComProto_Scheduler_TypeDef;
+
 typedef struct
 {
     bool init_state;
@@ -123,6 +203,14 @@ typedef struct
     bool (*mav_msg_obj_init)(SrvComProto_MsgInfo_TypeDef *msg, SrvComProto_MavPackInfo_TypeDef pck_info, uint32_t period);
     bool (*mav_msg_enable_ctl)(SrvComProto_MsgInfo_TypeDef *msg, bool state);
     bool (*mav_msg_stream)(SrvComProto_MsgInfo_TypeDef *msg, SrvComProto_Stream_TypeDef *com_stream, void *arg, ComProto_Callback tx_cb);
+
+    bool (*mav_sched_init)(SrvComProto_Scheduler_TypeDef *sched);
+    int8_t (*mav_sched_add_msg)(SrvComProto_Scheduler_TypeDef *sched, SrvComProto_MsgInfo_TypeDef *msg, uint8_t *p_buf, uint16_t buf_size);
+    int8_t (*mav_sched_add_port)(SrvComProto_Scheduler_TypeDef *sched, void *port_arg, ComProto_Callback tx_cb, uint32_t baudrate);
+    bool (*mav_sched_set_rate)(SrvComProto_Scheduler_TypeDef *sched, int8_t port_id, int8_t msg_id, uint16_t period);
+    bool (*mav_sched_port_ctl)(SrvComProto_Scheduler_TypeDef *sched, int8_t port_id, bool state);
+    void (*mav_sched_run)(SrvComProto_Scheduler_TypeDef *sched);
+    bool (*mav_port_input)(SrvComProto_Scheduler_TypeDef *sched, int8_t port_id, uint8_t *p_data, uint16_t size);
 } SrvComProto_TypeDef;
 
 extern SrvComProto_TypeDef SrvComProto;
@@ -9,6 +9,7 @@ SrvDataHub_Monitor_TypeDef SrvDataHub_Monitor = {
 
 /* Pipe Object */
 DataPipe_CreateDataObj(SrvIMU_UnionData_TypeDef, PtlIMU_Data);
+DataPipe_CreateDataObj(SrvIMU_Delta_TypeDef, Hub_IMU_Delta);
 DataPipe_CreateDataObj(SrvActuatorPipeData_TypeDef, PtlActuator_Data);
 DataPipe_CreateDataObj(ControlData_TypeDef, Hub_InUse_CtlData);
 DataPipe_CreateDataObj(ControlData_TypeDef, Hub_OPC_CtlData);
@@ -18,6 +19,7 @@ DataPipe_CreateDataObj(SrvSensorMonitor_GenReg_TypeDef, Sensor_Init);
 DataPipe_CreateDataObj(IMUAtt_TypeDef, Hub_Attitude);
 DataPipe_CreateDataObj(SrvBaroData_TypeDef, Hub_Baro_Data);
 DataPipe_CreateDataObj(PosData_TypeDef, Hub_Pos);
+DataPipe_CreateDataObj(PosVelData_TypeDef, Hub_Vel);
 DataPipe_CreateDataObj(SrvIMU_Range_TypeDef, Hub_PriIMU_Range);
 DataPipe_CreateDataObj(SrvIMU_Range_TypeDef, Hub_SecIMU_Range);
 
@@ -26,10 +28,12 @@ static void SrvDataHub_PipeRcTelemtryDataFinish_Callback(DataPipeObj_TypeDef *ob
 static void SrvDataHub_PipeInUseControlDataFinish_Callback(DataPipeObj_TypeDef *obj);
 static void SrvDataHub_SensorState_DataPipe_Finish_Callback(DataPipeObj_TypeDef *obj);
 static void SrvDataHub_IMU_DataPipe_Finish_Callback(DataPipeObj_TypeDef *obj);
+static void SrvDataHub_IMU_Delta_DataPipe_Finish_Callback(DataPipeObj_TypeDef *obj);
 static void SrvDataHub_Actuator_DataPipe_Finish_Callback(DataPipeObj_TypeDef *obj);
 static void SrvDataHub_Attitude_DataPipe_Finish_Callback(DataPipeObj_TypeDef *obj);
 static void SrvDataHub_Baro_DataPipe_Finish_Callback(DataPipeObj_TypeDef *obj);
 static void SrvDataHub_Pos_DataPipe_Finish_Callback(DataPipeObj_TypeDef *obj);
+static void SrvDataHub_Vel_DataPipe_Finish_Callback(DataPipeObj_TypeDef *obj);
 static void SrvDataHub_IMU_Range_DataPipe_Finish_Callback(DataPipeObj_TypeDef *obj);
 
 /* external function */
@@ -38,17 +42,20 @@ static bool SrvDataHub_Get_Raw_IMU(uint32_t *time_stamp, float *acc_scale, float
 static bool SrvDataHub_Get_Scaled_IMU(uint32_t *time_stamp, float *acc_scale, float *gyr_scale, float *acc_x, float *acc_y, float *acc_z, float *gyr_x, float *gyr_y, float *gyr_z, float *tmpr, uint8_t *err);
 static bool SrvDataHub_Get_Raw_Mag(uint32_t *time_stamp, float *scale, float *mag_x, float *mag_y, float *mag_z, uint8_t *err);
 static bool SrvDataHub_Get_Scaled_Mag(uint32_t *time_stamp, float *scale, float *mag_x, float *mag_y, float *mag_z, uint8_t *err);
+static bool SrvDataHub_Get_IMU_Delta(SrvIMU_Delta_TypeDef *delta);
 static bool SrvDataHub_Get_Arm(bool *arm);
 static bool SrvDataHub_Get_Failsafe(bool *failsafe);
 static bool SrvDataHub_Get_InUse_ControlData(ControlData_TypeDef *data);
 static bool SrvDataHub_Get_Telemetry_ControlData(ControlData_TypeDef *data);
 static bool SrvDataHub_Get_OnPlaneComputer_ControlData(ControlData_TypeDef *data);
 static bool SrvDataHub_Get_MotoChannel(uint32_t *time_stamp, uint8_t *cnt, uint16_t *moto_ch, uint8_t *moto_dir);
+static bool SrvDataHub_Get_MotoRPM(uint32_t *time_stamp, uint8_t *cnt, float *rpm);
 static bool SrvDataHub_Get_ServoChannel(uint32_t *time_stamp, uint8_t *cnt, uint16_t *servo_ch, uint8_t *servo_dir);
 static bool SrvDataHub_Get_IMU_InitState(bool *state);
 static bool SrvDataHub_Get_Mag_InitState(bool *state);
 static bool SrvDataHub_Get_Scaled_Baro(uint32_t *time_stamp, float *baro_pressure, float *baro_alt, float *baro_alt_offset, float *tempra, uint8_t *error);
 static bool SrvDataHub_Get_Attitude(uint32_t *time_stamp, float *pitch, float *roll, float *yaw, float *q0, float *q1, float *q2, float *q3, bool *flip_over);
+static bool SrvDataHub_Get_Pos(uint32_t *time_stamp, double *pos_x, double *pos_y, double *pos_z, double *vel_x, double *vel_y, double *vel_z);
 static bool SrvDataHub_Get_TunningState(uint32_t *time_stamp, bool *state, uint32_t *port_addr);
 static bool SrvDataHub_Get_ConfigratorAttachState(uint32_t *time_stamp, bool *state);
 static bool SrvDataHub_Get_CLI_State(bool *state);
@@ -64,18 +71,21 @@ SrvDataHub_TypeDef SrvDataHub = {
     .init = SrvDataHub_Init,
     .get_raw_imu = SrvDataHub_Get_Raw_IMU,
     .get_scaled_imu = SrvDataHub_Get_Scaled_IMU,
+    .get_imu_delta = SrvDataHub_Get_IMU_Delta,
     .get_pri_imu_range = SrvDataHub_Get_PriIMU_Range,
     .get_sec_imu_range = SrvDataHub_Get_SecIMU_Range,
     .get_attitude = SrvDataHub_Get_Attitude,
     .get_raw_mag = SrvDataHub_Get_Raw_Mag,
     .get_scaled_mag = SrvDataHub_Get_Scaled_Mag,
     .get_baro_altitude = SrvDataHub_Get_Scaled_Baro,
+    .get_pos = SrvDataHub_Get_Pos,
     .get_arm_state = SrvDataHub_Get_Arm,
     .get_failsafe = SrvDataHub_Get_Failsafe,
     .get_inuse_control_data = SrvDataHub_Get_InUse_ControlData,
     .get_opc_control_data = SrvDataHub_Get_OnPlaneComputer_ControlData,
     .get_rc_control_data = SrvDataHub_Get_Telemetry_ControlData,
     .get_moto = SrvDataHub_Get_MotoChannel,
+    .get_moto_rpm = SrvDataHub_Get_MotoRPM,
     .get_servo = SrvDataHub_Get_ServoChannel,
     .get_imu_init_state = SrvDataHub_Get_IMU_InitState,
     .get_mag_init_state = SrvDataHub_Get_Mag_InitState,
@@ -102,6 +112,12 @@ static void SrvDataHub_Init(void)
     IMU_hub_DataPipe.trans_finish_cb = To_Pipe_TransFinish_Callback(SrvDataHub_IMU_DataPipe_Finish_Callback);
     DataPipe_Enable(&IMU_hub_DataPipe);
 
+    memset(DataPipe_DataObjAddr(Hub_IMU_Delta), 0, DataPipe_DataSize(Hub_IMU_Delta));
+    IMU_Delta_hub_DataPipe.data_addr = (uint32_t)DataPipe_DataObjAddr(Hub_IMU_Delta);
+    IMU_Delta_hub_DataPipe.data_size = DataPipe_DataSize(Hub_IMU_Delta);
+    IMU_Delta_hub_DataPipe.trans_finish_cb = To_Pipe_TransFinish_Callback(SrvDataHub_IMU_Delta_DataPipe_Finish_Callback);
+    DataPipe_Enable(&IMU_Delta_hub_DataPipe);
+
     memset(DataPipe_DataObjAddr(Hub_PriIMU_Range), 0, DataPipe_DataSize(Hub_PriIMU_Range));
     IMU_PriRange_hub_DataPipe.data_addr = (uint32_t)DataPipe_DataObjAddr(Hub_PriIMU_Range);
     IMU_PriRange_hub_DataPipe.data_size = DataPipe_DataSize(Hub_PriIMU_Range);
@@ -163,6 +179,12 @@ static void SrvDataHub_Init(void)
     POS_hub_DataPipe.trans_finish_cb = To_Pipe_TransFinish_Callback(SrvDataHub_Pos_DataPipe_Finish_Callback);
     DataPipe_Enable(&POS_hub_DataPipe);
 
+    memset(DataPipe_DataObjAddr(Hub_Vel), 0, DataPipe_DataSize(Hub_Vel));
+    Vel_hub_DataPipe.data_addr = (uint32_t)DataPipe_DataObjAddr(Hub_Vel);
+    Vel_hub_DataPipe.data_size = DataPipe_DataSize(Hub_Vel);
+    Vel_hub_DataPipe.trans_finish_cb = To_Pipe_TransFinish_Callback(SrvDataHub_Vel_DataPipe_Finish_Callback);
+    DataPipe_Enable(&Vel_hub_DataPipe);
+
     memset(&SrvDataHub_Monitor, 0, sizeof(SrvDataHub_Monitor));
     SrvDataHub_Monitor.init_state = true;
     SrvDataHub_Monitor.data.InUse_Control_Data.arm_state = DRONE_ARM;
@@ -172,7 +194,35 @@ static void SrvDataHub_Pos_DataPipe_Finish_Callback(DataPipeObj_TypeDef *obj)
 {
     if(obj == &POS_hub_DataPipe)
     {
-        
+        SrvDataHub_Monitor.update_reg.bit.pos = true;
+
+        if(SrvDataHub_Monitor.inuse_reg.bit.pos)
+            SrvDataHub_Monitor.inuse_reg.bit.pos = false;
+
+        SrvDataHub_Monitor.data.pos_init_state = true;
+        SrvDataHub_Monitor.data.pos_update_time = SrvOsCommon.get_os_ms();
+        SrvDataHub_Monitor.data.pos_x = DataPipe_DataObj(Hub_Pos).XYZ_Pos.Pos_X;
+        SrvDataHub_Monitor.data.pos_y = DataPipe_DataObj(Hub_Pos).XYZ_Pos.Pos_Y;
+        SrvDataHub_Monitor.data.pos_z = DataPipe_DataObj(Hub_Pos).XYZ_Pos.Pos_Z;
+
+        SrvDataHub_Monitor.update_reg.bit.pos = false;
+    }
+}
+
+static void SrvDataHub_Vel_DataPipe_Finish_Callback(DataPipeObj_TypeDef *obj)
+{
+    if(obj == &Vel_hub_DataPipe)
+    {
+        SrvDataHub_Monitor.update_reg.bit.pos_vel = true;
+
+        if(SrvDataHub_Monitor.inuse_reg.bit.pos_vel)
+            SrvDataHub_Monitor.inuse_reg.bit.pos_vel = false;
+
+        SrvDataHub_Monitor.data.pos_x_vel = DataPipe_DataObj(Hub_Vel).XYZ_Vel.Vel_X;
+        SrvDataHub_Monitor.data.pos_y_vel = DataPipe_DataObj(Hub_Vel).XYZ_Vel.Vel_Y;
+        SrvDataHub_Monitor.data.pos_z_vel = DataPipe_DataObj(Hub_Vel).XYZ_Vel.Vel_Z;
+
+        SrvDataHub_Monitor.update_reg.bit.pos_vel = false;
     }
 }
 
@@ -235,10 +285,12 @@ static void SrvDataHub_Actuator_DataPipe_Finish_Callback(DataPipeObj_TypeDef *ob
 
         memset(SrvDataHub_Monitor.data.moto, 0, sizeof(SrvDataHub_Monitor.data.moto));
         memset(SrvDataHub_Monitor.data.servo, 0, sizeof(SrvDataHub_Monitor.data.servo));
+        memset(SrvDataHub_Monitor.data.moto_rpm, 0, sizeof(SrvDataHub_Monitor.data.moto_rpm));
 
         for (uint8_t moto_i = 0; moto_i < SrvDataHub_Monitor.data.moto_num; moto_i++)
         {
             SrvDataHub_Monitor.data.moto[moto_i] = DataPipe_DataObj(PtlActuator_Data).moto[moto_i];
+            SrvDataHub_Monitor.data.moto_rpm[moto_i] = DataPipe_DataObj(PtlActuator_Data).moto_rpm[moto_i];
         }
 
         for (uint8_t servo_i = 0; servo_i < SrvDataHub_Monitor.data.servo_num; servo_i++)
@@ -317,6 +369,22 @@ static void SrvDataHub_IMU_DataPipe_Finish_Callback(DataPipeObj_TypeDef *obj)
     }
 }
 
+static void SrvDataHub_IMU_Delta_DataPipe_Finish_Callback(DataPipeObj_TypeDef *obj)
+{
+    if (obj == &IMU_Delta_hub_DataPipe)
+    {
+        SrvDataHub_Monitor.update_reg.bit.imu_delta = true;
+
+        if (SrvDataHub_Monitor.inuse_reg.bit.imu_delta)
+            SrvDataHub_Monitor.inuse_reg.bit.imu_delta = false;
+
+        /* navi not take the last one yet, append instead of overwrite so no window get lost */
+        SrvIMU.merge_delta(&SrvDataHub_Monitor.data.imu_delta, DataPipe_DataObjAddr(Hub_IMU_Delta));
+
+        SrvDataHub_Monitor.update_reg.bit.imu_delta = false;
+    }
+}
+
 static void SrvDataHub_SensorState_DataPipe_Finish_Callback(DataPipeObj_TypeDef *obj)
 {
     if((obj == &SensorInitState_hub_DataPipe) || (obj == &SensorEnableState_hub_DataPipe))
@@ -563,6 +631,54 @@ reupdate_scaled_baro:
     return true;
 }
 
+/* local ned position and velocity from navigation task */
+static bool SrvDataHub_Get_Pos(uint32_t *time_stamp, double *pos_x, double *pos_y, double *pos_z, double *vel_x, double *vel_y, double *vel_z)
+{
+    if ((time_stamp == NULL) ||
+        (pos_x == NULL) ||
+        (pos_y == NULL) ||
+        (pos_z == NULL) ||
+        (vel_x == NULL) ||
+        (vel_y == NULL) ||
+        (vel_z == NULL))
+        return false;
+
+reupdate_pos:
+    SrvDataHub_Monitor.inuse_reg.bit.pos = true;
+    SrvDataHub_Monitor.inuse_reg.bit.pos_vel = true;
+
+    *time_stamp = SrvDataHub_Monitor.data.pos_update_time;
+    *pos_x = SrvDataHub_Monitor.data.pos_x;
+    *pos_y = SrvDataHub_Monitor.data.pos_y;
+    *pos_z = SrvDataHub_Monitor.data.pos_z;
+    *vel_x = SrvDataHub_Monitor.data.pos_x_vel;
+    *vel_y = SrvDataHub_Monitor.data.pos_y_vel;
+    *vel_z = SrvDataHub_Monitor.data.pos_z_vel;
+
+    if (!SrvDataHub_Monitor.inuse_reg.bit.pos || !SrvDataHub_Monitor.inuse_reg.bit.pos_vel)
+        goto reupdate_pos;
+
+    SrvDataHub_Monitor.inuse_reg.bit.pos = false;
+    SrvDataHub_Monitor.inuse_reg.bit.pos_vel = false;
+
+    return SrvDataHub_Monitor.data.pos_init_state;
+}
+
+/* take every window piped in since last call, clear on read, single consumer (navi task) */
+static bool SrvDataHub_Get_IMU_Delta(SrvIMU_Delta_TypeDef *delta)
+{
+    if (delta == NULL)
+        return false;
+
+    /* pipe callback append in irq, copy and clear must not be split */
+    SrvOsCommon.enter_critical();
+    *delta = SrvDataHub_Monitor.data.imu_delta;
+    SrvDataHub_Monitor.data.imu_delta.win_cnt = 0;
+    SrvOsCommon.exit_critical();
+
+    return (delta->win_cnt != 0);
+}
+
 static bool SrvDataHub_Get_Scaled_Mag(uint32_t *time_stamp, float *scale, float *mag_x, float *mag_y, float *mag_z, uint8_t *err)
 {
     if ((time_stamp == NULL) ||
@@ -722,7 +838,7 @@ reupdate_moto_channel:
 
     if (*cnt)
     {
-        memcpy(moto_ch, SrvDataHub_Monitor.data.moto, *cnt);
+        memcpy(moto_ch, SrvDataHub_Monitor.data.moto, *cnt * sizeof(uint16_t));
     }
 
     if (!SrvDataHub_Monitor.inuse_reg.bit.actuator)
@@ -733,6 +849,30 @@ reupdate_moto_channel:
     return true;
 }
 
+static bool SrvDataHub_Get_MotoRPM(uint32_t *time_stamp, uint8_t *cnt, float *rpm)
+{
+    if ((time_stamp == NULL) || (cnt == NULL) || (rpm == NULL))
+        return false;
+
+reupdate_moto_rpm:
+    SrvDataHub_Monitor.inuse_reg.bit.actuator = true;
+
+    *time_stamp = SrvDataHub_Monitor.data.actuator_update_time;
+    *cnt = SrvDataHub_Monitor.data.moto_num;
+
+    if (*cnt)
+    {
+        memcpy(rpm, SrvDataHub_Monitor.data.moto_rpm, *cnt * sizeof(float));
+    }
+
+    if (!SrvDataHub_Monitor.inuse_reg.bit.actuator)
+        goto reupdate_moto_rpm;
+
+    SrvDataHub_Monitor.inuse_reg.bit.actuator = false;
+
+    return true;
+}
+
 static bool SrvDataHub_Get_IMU_InitState(bool *state)
 {
 reupdate_imu_state:
@@ -24,6 +24,7 @@ typedef union
         uint64_t raw_imu : 1;
         uint64_t scaled_imu : 1;
         uint64_t range_imu : 1;
+        uint64_t imu_delta : 1;
 
         uint64_t raw_mag : 1;
         uint64_t scaled_mag : 1;
@@ -50,6 +51,8 @@ typedef union
 
         uint64_t actuator : 1;
         uint64_t attitude : 1;
+        uint64_t pos : 1;
+        uint64_t pos_vel : 1;
 
         uint64_t mag_init : 1;
         uint64_t imu_init : 1;
@@ -99,6 +102,9 @@ typedef struct
     float imu_temp;
     uint8_t imu_error_code;
 
+    /* coning / sculling compensated integral of every window not taken by navi yet */
+    SrvIMU_Delta_TypeDef imu_delta;
+
     bool mag_enabled;
     bool mag_init_state;
     uint32_t mag_update_time;
@@ -195,6 +201,7 @@ typedef struct
     uint8_t servo_num;
     uint16_t moto[8];
     uint8_t servo[8];
+    float moto_rpm[SRV_ACTUATOR_MAX_MIX_MOTO];
 
     /* when receiver configrator`s heartbeat */
     uint32_t configrator_time_stamp;
@@ -246,6 +253,7 @@ typedef struct
     bool (*get_tof_init_state)(bool *state);
     bool (*get_raw_imu)(uint32_t *time_stamp, float *acc_scale, float *gyr_scale, float *acc_x, float *acc_y, float *acc_z, float *gyr_x, float *gyr_y, float *gyr_z, float *tmp, uint8_t *err);
     bool (*get_scaled_imu)(uint32_t *time_stamp, float *acc_scale, float *gyr_scale, float *acc_x, float *acc_y, float *acc_z, float *gyr_x, float *gyr_y, float *gyr_z, float *tmp, uint8_t *err);
+    bool (*get_imu_delta)(SrvIMU_Delta_TypeDef *delta);
     bool (*get_raw_mag)(uint32_t *time_stamp, float *scale, float *mag_x, float *mag_y, float *mag_z, uint8_t *err);
     bool (*get_scaled_mag)(uint32_t *time_stamp, float *scale, float *mag_x, float *mag_y, float *mag_z, uint8_t *err);
     bool (*get_attitude)(uint32_t *time_stamp, float *pitch, float *roll, float *yaw, float *q0, float *q1, float *q2, float *q3, bool *flip_over);
@@ -253,9 +261,11 @@ typedef struct
     bool (*get_rc_control_data)(ControlData_TypeDef *data);
     bool (*get_opc_control_data)(ControlData_TypeDef *data);
     bool (*get_baro_altitude)(uint32_t *time_stamp, float *baro_pressure, float *baro_alt, float *baro_alt_offset, float *baro_temp, uint8_t *error);
+    bool (*get_pos)(uint32_t *time_stamp, double *pos_x, double *pos_y, double *pos_z, double *vel_x, double *vel_y, double *vel_z);
     bool (*get_arm_state)(bool *arm);
     bool (*get_failsafe)(bool *failsafe);
     bool (*get_moto)(uint32_t *time_stamp, uint8_t *cnt, uint16_t *ch, uint8_t *dir);
+    bool (*get_moto_rpm)(uint32_t *time_stamp, uint8_t *cnt, float *rpm);
     bool (*get_servo)(uint32_t *time_stamp, uint8_t *cnt, uint16_t *ch, uint8_t *dir);
 } SrvDataHub_TypeDef;
 
@@ -12,6 +12,9 @@
 #include "error_log.h"
 #include "Dev_Led.h"
 #include "../Algorithm/Filter_Dep/filter.h"
+#include "../Algorithm/Filter_Dep/rpm_filter.h"
+#include "math_util.h"
+#include "kernel.h"
 #include <math.h>
 
 /* use ENU coordinate */
@@ -23,6 +26,12 @@
  */
 #define ANGULAR_ACCECLERATION_THRESHOLD 10 / 1.0f // angular speed accelerate from 0 to 100 deg/s in 1 Ms
 
+/* moto rpm notch, only fed when bidirectional dshot telemetry is on */
+#define SRVIMU_RPM_FILTER_SAMPLE_HZ 1000.0f
+#define SRVIMU_RPM_FILTER_HARMONIC 3
+#define SRVIMU_RPM_FILTER_Q 5.0f
+#define SRVIMU_RPM_FILTER_MIN_HZ 80.0f
+
 typedef struct
 {
     SrvIMU_SensorID_List type;
@@ -51,6 +60,10 @@ static BWF_Object_Handle PriIMU_Acc_LPF_Handle[Axis_Sum] = {0};
 static BWF_Object_Handle SecIMU_Gyr_LPF_Handle[Axis_Sum] = {0};
 static BWF_Object_Handle SecIMU_Acc_LPF_Handle[Axis_Sum] = {0};
 
+/* moto rpm tracking notch, placed ahead of gyro lowpass */
+static RpmFilter_Obj_TypeDef PriIMU_RpmFilter;
+static RpmFilter_Obj_TypeDef SecIMU_RpmFilter;
+
 /* Gyro Calibration Monitor */
 static SrvIMU_CalibMonitor_TypeDef Gyro_Calib_Monitor;
 
@@ -70,6 +83,9 @@ static SrvIMU_Data_TypeDef PriIMU_Data_Lst;
 static SrvIMU_Data_TypeDef SecIMU_Data_Lst;
 static SrvIMU_Data_TypeDef IMU_Data;
 static SrvIMU_Data_TypeDef IMU_Data_Lst;
+DTCM_DATA static SrvIMU_DeltaAcc_TypeDef IMU_DeltaAcc;
+static SrvIMU_Delta_TypeDef IMU_Delta;
+static bool IMU_Delta_Update = false;
 static Error_Handler SrvMPU_Error_Handle = NULL;
 
 /* internal variable */
@@ -261,16 +277,18 @@ static Error_Obj_Typedef SrvIMU_ErrorList[] = {
 static SrvIMU_ErrorCode_List SrvIMU_Init(void);
 static bool SrvIMU_Sample(SrvIMU_SampleMode_List mode);
 static bool SrvIMU_Get_Data(SrvIMU_Module_Type type, SrvIMU_Data_TypeDef *data);
-static void SrvIMU_ErrorProc(void);
 static float SrvIMU_Get_MaxAngularSpeed_Diff(void);
 static GenCalib_State_TypeList SrvIMU_Calib_GyroZeroOffset(uint32_t calib_cycle, uint16_t *calib_cycle_cnt, float *pri_gyr, float *sec_gyr);
 static GenCalib_State_TypeList SrvIMU_Set_Calib(uint32_t calb_cycle);
 static GenCalib_State_TypeList SrvIMU_Get_Calib(void);
 static bool SrvIMU_Get_Range(SrvIMU_Module_Type module, SrvIMU_Range_TypeDef *range);
+static bool SrvIMU_Get_Delta(SrvIMU_Delta_TypeDef *delta);
+static void SrvIMU_Merge_Delta(SrvIMU_Delta_TypeDef *dst, const SrvIMU_Delta_TypeDef *src);
+static bool SrvIMU_Set_MotoRPM(const float *rpm, uint8_t cnt);
 
 /* internal function */
-static int8_t SrvIMU_PriIMU_Init(void);
-static int8_t SrvIMU_SecIMU_Init(void);
+static SrvIMU_ErrorCode_List SrvIMU_PriIMU_Init(void);
+static SrvIMU_ErrorCode_List SrvIMU_SecIMU_Init(void);
 static void SrvIMU_PriIMU_ExtiCallback(void);
 static void SrvIMU_SecIMU_ExtiCallback(void);
 static void SrvIMU_PriIMU_CS_Ctl(bool state);
@@ -279,16 +297,19 @@ static bool SrvIMU_PriIMU_BusTrans_Rec(uint8_t *Tx, uint8_t *Rx, uint16_t size);
 static bool SrvIMU_SecIMU_BusTrans_Rec(uint8_t *Tx, uint8_t *Rx, uint16_t size);
 static bool SrvIMU_Detect_AngularOverSpeed(float angular_speed, float lst_angular_speed, float ms_diff);
 static SrvIMU_SensorID_List SrvIMU_AutoDetect(bus_trans_callback trans, cs_ctl_callback cs_ctl);
+static void SrvIMU_Delta_Accumulate(const float *gyr, const float *acc, uint32_t cyc);
 
 SrvIMU_TypeDef SrvIMU = {
     .init = SrvIMU_Init,
     .sample = SrvIMU_Sample,
     .get_data = SrvIMU_Get_Data,
     .get_range = SrvIMU_Get_Range,
-    .error_proc = SrvIMU_ErrorProc,
     .set_calib = SrvIMU_Set_Calib,
     .get_calib = SrvIMU_Get_Calib,
     .get_max_angular_speed_diff = SrvIMU_Get_MaxAngularSpeed_Diff,
+    .get_delta = SrvIMU_Get_Delta,
+    .merge_delta = SrvIMU_Merge_Delta,
+    .set_moto_rpm = SrvIMU_Set_MotoRPM,
 };
 
 static SrvIMU_ErrorCode_List SrvIMU_Init(void)
@@ -296,7 +317,12 @@ static SrvIMU_ErrorCode_List SrvIMU_Init(void)
     FilterParam_Obj_TypeDef *Gyr_Filter_Ptr = NULL;
     FilterParam_Obj_TypeDef *Acc_Filter_Ptr = NULL;
 
+#if (DSHOT_BIDIR == ON)
+    /* moto noise removed by rpm notch, lowpass cut off can be raised for less phase delay */
+    CREATE_FILTER_PARAM_OBJ(Gyr, 5, 50Hz, 1K, Gyr_Filter_Ptr);
+#else
     CREATE_FILTER_PARAM_OBJ(Gyr, 5, 30Hz, 1K, Gyr_Filter_Ptr);
+#endif
     CREATE_FILTER_PARAM_OBJ(Acc, 5, 30Hz, 1K, Acc_Filter_Ptr);
 
     memset(&InUse_PriIMU_Obj, 0, sizeof(InUse_PriIMU_Obj));
@@ -308,6 +334,14 @@ static SrvIMU_ErrorCode_List SrvIMU_Init(void)
     memset(&PriIMU_Data_Lst, 0, sizeof(PriIMU_Data_Lst));
     memset(&SecIMU_Data_Lst, 0, sizeof(SecIMU_Data_Lst));
 
+    memset(&IMU_DeltaAcc, 0, sizeof(IMU_DeltaAcc));
+    memset(&IMU_Delta, 0, sizeof(IMU_Delta));
+
+    memset(&PriIMU_RpmFilter, 0, sizeof(PriIMU_RpmFilter));
+    memset(&SecIMU_RpmFilter, 0, sizeof(SecIMU_RpmFilter));
+    IMU_DeltaAcc.cyc_to_sec = 1.0f / (float)Kernel_Get_SysClock();
+    IMU_Delta_Update = false;
+
     /* init gyro calibration monitor */
     Gyro_Calib_Monitor.state = Calib_Start;
     Gyro_Calib_Monitor.calib_cycle = GYR_STATIC_CALIB_CYCLE;
@@ -861,7 +895,7 @@ reset_calib_var:
     return state;
 }
 
-static bool SrvIMU_Sample(SrvIMU_SampleMode_List mode)
+ITCM_CODE static bool SrvIMU_Sample(SrvIMU_SampleMode_List mode)
 {
     static uint32_t PriSample_Rt_Lst = 0;
     static uint32_t SecSample_Rt_Lst = 0;
@@ -871,6 +905,7 @@ static bool SrvIMU_Sample(SrvIMU_SampleMode_List mode)
     IMUModuleScale_TypeDef pri_imu_scale;
     IMUModuleScale_TypeDef sec_imu_scale;
     float Sample_MsDiff = 0.0f;
+    float notch_gyr[Axis_Sum] = {0.0f};
     bool PriSample_Enable = mode & SrvIMU_Priori_Pri;
     bool SecSample_Enable = mode & SrvIMU_Priori_Sec;
 
@@ -918,11 +953,19 @@ static bool SrvIMU_Sample(SrvIMU_SampleMode_List mode)
 
                 for (i = Axis_X; i < Axis_Sum; i++)
                 {
-                    PriIMU_Data.org_acc[i] = InUse_PriIMU_Obj.OriData_ptr->acc_flt[i];
                     PriIMU_Data.org_gyr[i] = InUse_PriIMU_Obj.OriData_ptr->gyr_flt[i] - PriIMU_Gyr_ZeroOffset[i];
+                    notch_gyr[i] = PriIMU_Data.org_gyr[i];
+                }
+
+                /* org_gyr stay unnotched, rpm notch only feed the lowpass */
+                RpmFilter_Apply(&PriIMU_RpmFilter, notch_gyr);
+
+                for (i = Axis_X; i < Axis_Sum; i++)
+                {
+                    PriIMU_Data.org_acc[i] = InUse_PriIMU_Obj.OriData_ptr->acc_flt[i];
 
                     /* filted imu data */
-                    PriIMU_Data.flt_gyr[i] = Butterworth.update(PriIMU_Gyr_LPF_Handle[i], PriIMU_Data.org_gyr[i]);
+                    PriIMU_Data.flt_gyr[i] = Butterworth.update(PriIMU_Gyr_LPF_Handle[i], notch_gyr[i]);
                     PriIMU_Data.flt_acc[i] = Butterworth.update(PriIMU_Acc_LPF_Handle[i], PriIMU_Data.org_acc[i]);
 
                     /* update last time value */
@@ -991,10 +1034,18 @@ static bool SrvIMU_Sample(SrvIMU_SampleMode_List mode)
 
                 for (i = Axis_X; i < Axis_Sum; i++)
                 {
-                    SecIMU_Data.org_acc[i] = InUse_SecIMU_Obj.OriData_ptr->acc_flt[i];
                     SecIMU_Data.org_gyr[i] = InUse_SecIMU_Obj.OriData_ptr->gyr_flt[i] - SecIMU_Gyr_ZeroOffset[i];
+                    notch_gyr[i] = SecIMU_Data.org_gyr[i];
+                }
+
+                /* org_gyr stay unnotched, rpm notch only feed the lowpass */
+                RpmFilter_Apply(&SecIMU_RpmFilter, notch_gyr);
 
-                    SecIMU_Data.flt_gyr[i] = Butterworth.update(SecIMU_Gyr_LPF_Handle[i], SecIMU_Data.org_gyr[i]);
+                for (i = Axis_X; i < Axis_Sum; i++)
+                {
+                    SecIMU_Data.org_acc[i] = InUse_SecIMU_Obj.OriData_ptr->acc_flt[i];
+
+                    SecIMU_Data.flt_gyr[i] = Butterworth.update(SecIMU_Gyr_LPF_Handle[i], notch_gyr[i]);
                     SecIMU_Data.flt_acc[i] = Butterworth.update(SecIMU_Acc_LPF_Handle[i], SecIMU_Data.org_acc[i]);
 
                     /* update Sec last value */
@@ -1093,9 +1144,191 @@ static bool SrvIMU_Sample(SrvIMU_SampleMode_List mode)
     SrvMpu_Update_Reg.sec.Fus_State = false;
     IMU_Data_Lst = IMU_Data;
 
+    /* integrate every fresh sample, unfiltered data keep the phase */
+    if (pri_sample_state | sec_sample_state)
+        SrvIMU_Delta_Accumulate(IMU_Data.org_gyr, IMU_Data.org_acc, Kernel_Get_CycleCnt());
+
     return (pri_sample_state | sec_sample_state);
 }
 
+/*
+ * coning / sculling compensated integration (Savage recursive form)
+ * per sample : d_ang = w * dt, d_vel = f * dt
+ *      beta += 1/2 * (alpha + 1/6 * lst_d_ang) x d_ang
+ *      scul += 1/2 * ((alpha + 1/6 * lst_d_ang) x d_vel + (vel + 1/6 * lst_d_vel) x d_ang)
+ * window close : delta angle = alpha + beta
+ *                delta velocity = vel + 1/2 * (alpha x vel) + scul
+ */
+ITCM_CODE static void SrvIMU_Delta_Accumulate(const float *gyr, const float *acc, uint32_t cyc)
+{
+    SrvIMU_DeltaAcc_TypeDef *p_acc = &IMU_DeltaAcc;
+    SrvIMU_Delta_TypeDef win;
+    float d_ang[Axis_Sum];
+    float d_vel[Axis_Sum];
+    float ang_ref[Axis_Sum];
+    float vel_ref[Axis_Sum];
+    float rot[Axis_Sum];
+    float dt = 0.0f;
+    uint8_t i = Axis_X;
+
+    dt = (float)(cyc - p_acc->lst_cyc) * p_acc->cyc_to_sec;
+    p_acc->lst_cyc = cyc;
+
+    /* first sample or sample stall, restart the open window */
+    if (!p_acc->cyc_valid || (dt <= 0.0f) || (dt > SRVIMU_DELTA_DT_MAX))
+    {
+        dt = p_acc->cyc_to_sec;
+        memset(p_acc, 0, sizeof(SrvIMU_DeltaAcc_TypeDef));
+        p_acc->cyc_to_sec = dt;
+        p_acc->lst_cyc = cyc;
+        p_acc->cyc_valid = true;
+        return;
+    }
+
+    for (i = Axis_X; i < Axis_Sum; i++)
+    {
+        d_ang[i] = Deg2Rad(gyr[i]) * dt;
+        d_vel[i] = g2Mpss(acc[i]) * dt;
+        ang_ref[i] = p_acc->alpha[i] + p_acc->lst_d_ang[i] * (1.0f / 6.0f);
+        vel_ref[i] = p_acc->vel[i] + p_acc->lst_d_vel[i] * (1.0f / 6.0f);
+    }
+
+    /* coning */
+    p_acc->beta[Axis_X] += 0.5f * (ang_ref[Axis_Y] * d_ang[Axis_Z] - ang_ref[Axis_Z] * d_ang[Axis_Y]);
+    p_acc->beta[Axis_Y] += 0.5f * (ang_ref[Axis_Z] * d_ang[Axis_X] - ang_ref[Axis_X] * d_ang[Axis_Z]);
+    p_acc->beta[Axis_Z] += 0.5f * (ang_ref[Axis_X] * d_ang[Axis_Y] - ang_ref[Axis_Y] * d_ang[Axis_X]);
+
+    /* sculling */
+    p_acc->scul[Axis_X] += 0.5f * ((ang_ref[Axis_Y] * d_vel[Axis_Z] - ang_ref[Axis_Z] * d_vel[Axis_Y]) + (vel_ref[Axis_Y] * d_ang[Axis_Z] - vel_ref[Axis_Z] * d_ang[Axis_Y]));
+    p_acc->scul[Axis_Y] += 0.5f * ((ang_ref[Axis_Z] * d_vel[Axis_X] - ang_ref[Axis_X] * d_vel[Axis_Z]) + (vel_ref[Axis_Z] * d_ang[Axis_X] - vel_ref[Axis_X] * d_ang[Axis_Z]));
+    p_acc->scul[Axis_Z] += 0.5f * ((ang_ref[Axis_X] * d_vel[Axis_Y] - ang_ref[Axis_Y] * d_vel[Axis_X]) + (vel_ref[Axis_X] * d_ang[Axis_Y] - vel_ref[Axis_Y] * d_ang[Axis_X]));
+
+    for (i = Axis_X; i < Axis_Sum; i++)
+    {
+        p_acc->alpha[i] += d_ang[i];
+        p_acc->vel[i] += d_vel[i];
+        p_acc->lst_d_ang[i] = d_ang[i];
+        p_acc->lst_d_vel[i] = d_vel[i];
+    }
+
+    p_acc->dt += dt;
+    p_acc->cnt ++;
+
+    /* close the window when the next sample would overrun the period */
+    if ((p_acc->dt + 0.5f * dt) < (SRVIMU_DELTA_PERIOD_DEF / 1000.0f))
+        return;
+
+    rot[Axis_X] = p_acc->alpha[Axis_Y] * p_acc->vel[Axis_Z] - p_acc->alpha[Axis_Z] * p_acc->vel[Axis_Y];
+    rot[Axis_Y] = p_acc->alpha[Axis_Z] * p_acc->vel[Axis_X] - p_acc->alpha[Axis_X] * p_acc->vel[Axis_Z];
+    rot[Axis_Z] = p_acc->alpha[Axis_X] * p_acc->vel[Axis_Y] - p_acc->alpha[Axis_Y] * p_acc->vel[Axis_X];
+
+    for (i = Axis_X; i < Axis_Sum; i++)
+    {
+        win.d_ang[i] = p_acc->alpha[i] + p_acc->beta[i];
+        win.d_vel[i] = p_acc->vel[i] + 0.5f * rot[i] + p_acc->scul[i];
+    }
+
+    win.time_stamp = SrvOsCommon.get_os_ms();
+    win.dt = p_acc->dt;
+    win.sample_cnt = p_acc->cnt;
+    win.win_cnt = 1;
+    win.seq = IMU_Delta.seq + 1;
+
+    /* window not taken yet, fold the new one in rather than overwrite it */
+    if (!IMU_Delta_Update)
+        IMU_Delta.win_cnt = 0;
+
+    SrvIMU_Merge_Delta(&IMU_Delta, &win);
+    IMU_Delta_Update = true;
+
+    /* open next window, keep last increment for the 1/6 term */
+    memset(p_acc->alpha, 0, sizeof(p_acc->alpha));
+    memset(p_acc->beta, 0, sizeof(p_acc->beta));
+    memset(p_acc->vel, 0, sizeof(p_acc->vel));
+    memset(p_acc->scul, 0, sizeof(p_acc->scul));
+    p_acc->dt = 0.0f;
+    p_acc->cnt = 0;
+}
+
+/* return true when any window closed since last call, call in sample task */
+static bool SrvIMU_Get_Delta(SrvIMU_Delta_TypeDef *delta)
+{
+    if ((delta == NULL) || !IMU_Delta_Update)
+        return false;
+
+    *delta = IMU_Delta;
+    IMU_Delta_Update = false;
+
+    return true;
+}
+
+/*
+ * append window src behind window dst, result stay in the body frame at the start of dst
+ * first order composition, both window angle are small
+ *      d_ang = a1 + a2 + 1/2 * (a1 x a2)
+ *      d_vel = v1 + v2 + a1 x v2
+ */
+static void SrvIMU_Merge_Delta(SrvIMU_Delta_TypeDef *dst, const SrvIMU_Delta_TypeDef *src)
+{
+    float d_ang[Axis_Sum];
+    float d_vel[Axis_Sum];
+    const float *a1 = NULL;
+    uint8_t i = Axis_X;
+
+    if ((dst == NULL) || (src == NULL) || (src->win_cnt == 0))
+        return;
+
+    if (dst->win_cnt == 0)
+    {
+        *dst = *src;
+        return;
+    }
+
+    a1 = dst->d_ang;
+    d_ang[Axis_X] = 0.5f * (a1[Axis_Y] * src->d_ang[Axis_Z] - a1[Axis_Z] * src->d_ang[Axis_Y]);
+    d_ang[Axis_Y] = 0.5f * (a1[Axis_Z] * src->d_ang[Axis_X] - a1[Axis_X] * src->d_ang[Axis_Z]);
+    d_ang[Axis_Z] = 0.5f * (a1[Axis_X] * src->d_ang[Axis_Y] - a1[Axis_Y] * src->d_ang[Axis_X]);
+
+    d_vel[Axis_X] = a1[Axis_Y] * src->d_vel[Axis_Z] - a1[Axis_Z] * src->d_vel[Axis_Y];
+    d_vel[Axis_Y] = a1[Axis_Z] * src->d_vel[Axis_X] - a1[Axis_X] * src->d_vel[Axis_Z];
+    d_vel[Axis_Z] = a1[Axis_X] * src->d_vel[Axis_Y] - a1[Axis_Y] * src->d_vel[Axis_X];
+
+    for (i = Axis_X; i < Axis_Sum; i++)
+    {
+        dst->d_vel[i] += src->d_vel[i] + d_vel[i];
+        dst->d_ang[i] += src->d_ang[i] + d_ang[i];
+    }
+
+    dst->time_stamp = src->time_stamp;
+    dst->seq = src->seq;
+    dst->dt += src->dt;
+    dst->sample_cnt += src->sample_cnt;
+    dst->win_cnt = ((dst->win_cnt + src->win_cnt) > UINT8_MAX) ? UINT8_MAX : (dst->win_cnt + src->win_cnt);
+}
+
+/* moto rpm in, notch bank built on the first call with the moto count reported by actuator */
+static bool SrvIMU_Set_MotoRPM(const float *rpm, uint8_t cnt)
+{
+    if ((rpm == NULL) || (cnt == 0) || (cnt > RPM_FILTER_MOTO_MAX))
+        return false;
+
+    if (!PriIMU_RpmFilter.init || (PriIMU_RpmFilter.moto_cnt != cnt))
+    {
+        if (!RpmFilter_Init(&PriIMU_RpmFilter, SRVIMU_RPM_FILTER_SAMPLE_HZ, cnt, SRVIMU_RPM_FILTER_HARMONIC, SRVIMU_RPM_FILTER_Q, SRVIMU_RPM_FILTER_MIN_HZ) ||
+            !RpmFilter_Init(&SecIMU_RpmFilter, SRVIMU_RPM_FILTER_SAMPLE_HZ, cnt, SRVIMU_RPM_FILTER_HARMONIC, SRVIMU_RPM_FILTER_Q, SRVIMU_RPM_FILTER_MIN_HZ))
+            return false;
+    }
+
+    for (uint8_t i = 0; i < cnt; i++)
+    {
+        /* rpm to rotation frequency in Hz */
+        RpmFilter_Set_Freq(&PriIMU_RpmFilter, i, rpm[i] / 60.0f);
+        RpmFilter_Set_Freq(&SecIMU_RpmFilter, i, rpm[i] / 60.0f);
+    }
+
+    return true;
+}
+
 static bool SrvIMU_Get_Range(SrvIMU_Module_Type module, SrvIMU_Range_TypeDef *range)
 {
 #if (IMU_SUM >= 2)
@@ -1205,11 +1438,6 @@ static bool SrvIMU_Detect_AngularOverSpeed(float angular_speed, float lst_angula
     return false;
 }
 
-static void SrvIMU_ErrorProc(void)
-{
-    ErrorLog.proc(SrvMPU_Error_Handle);
-}
-
 static SrvIMU_SensorID_List SrvIMU_AutoDetect(bus_trans_callback trans, cs_ctl_callback cs_ctl)
 {
     SrvOsCommon.delay_ms(20);
@@ -25,6 +25,10 @@
 
 #define IMU_DATA_SIZE sizeof(SrvIMU_Data_TypeDef)
 
+/* delta angle / velocity integration window, match navi task period */
+#define SRVIMU_DELTA_PERIOD_DEF 10  /* unit: ms */
+#define SRVIMU_DELTA_DT_MAX 0.02f   /* unit: s, longer sample gap restart the window */
+
 typedef union
 {
     struct
@@ -125,6 +129,37 @@ typedef union
     SrvIMU_Data_TypeDef data;
 } SrvIMU_UnionData_TypeDef;
 
+/* closed integration window, imu coordinate, unread windows are folded into one until consumer take it */
+typedef struct
+{
+    uint32_t time_stamp;    /* last window close time, unit: ms */
+    uint32_t seq;           /* last window sequence */
+    uint16_t sample_cnt;
+    uint8_t win_cnt;        /* window folded in, 0 means empty */
+    float dt;               /* unit: s */
+    float d_ang[Axis_Sum];  /* coning compensated delta angle, unit: rad */
+    float d_vel[Axis_Sum];  /* rotation and sculling compensated delta velocity, unit: m/s */
+} SrvIMU_Delta_TypeDef;
+
+/* running accumulator of the open window */
+typedef struct
+{
+    float alpha[Axis_Sum];      /* raw angle sum */
+    float beta[Axis_Sum];       /* coning correction */
+    float lst_d_ang[Axis_Sum];
+
+    float vel[Axis_Sum];        /* raw velocity sum */
+    float scul[Axis_Sum];       /* sculling correction */
+    float lst_d_vel[Axis_Sum];
+
+    float dt;
+    uint16_t cnt;
+
+    float cyc_to_sec;
+    uint32_t lst_cyc;
+    bool cyc_valid;
+} SrvIMU_DeltaAcc_TypeDef;
+
 typedef struct
 {
     GenCalib_State_TypeList state;
@@ -139,9 +174,11 @@ typedef struct
     bool (*get_data)(SrvIMU_Module_Type type, SrvIMU_Data_TypeDef *data);
     bool (*get_range)(SrvIMU_Module_Type type, SrvIMU_Range_TypeDef *range);
     float (*get_max_angular_speed_diff)(void);
-    void (*error_proc)(void);
     GenCalib_State_TypeList (*get_calib)(void);
     GenCalib_State_TypeList (*set_calib)(uint32_t calib_cycle);
+    bool (*get_delta)(SrvIMU_Delta_TypeDef *delta);
+    void (*merge_delta)(SrvIMU_Delta_TypeDef *dst, const SrvIMU_Delta_TypeDef *src);
+    bool (*set_moto_rpm)(const float *rpm, uint8_t cnt);
 } SrvIMU_TypeDef;
 
 extern SrvIMU_TypeDef SrvIMU;
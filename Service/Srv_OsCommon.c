@@ -1,5 +1,25 @@
 #include "Srv_OsCommon.h"
 #include "kernel.h"
+#include "util.h"
+#include "shell_port.h"
+
+/*
+ * default os heap is build on heap_5, D1 sram spread in two region
+ * tagged region (fast / dma / low priority) have their own heap instance
+ * use the same algorithm as heap_5: address ordered free list, first fit, merge neighbour on free
+ */
+#if defined STM32H743xx
+#define SRVOS_HEAP_D1_EXT_SIZE      (320 Kb)    /* whole RAM_D1 except os heap and perph part */
+#define SRVOS_HEAP_FAST_SIZE        (16 Kb)     /* DTCM share with .data / .bss / msp stack */
+#define SRVOS_HEAP_DMA_SIZE         (288 Kb)    /* whole RAM_D2 */
+#define SRVOS_HEAP_LOWPRIO_SIZE     (64 Kb)     /* whole RAM_D3 */
+#endif
+
+#define SRVOS_HEAP_ALIGN            8
+#define SRVOS_HEAP_ALIGN_MASK       (SRVOS_HEAP_ALIGN - 1)
+#define SRVOS_HEAP_BLOCK_SIZE       ((sizeof(SrvOs_HeapBlock_TypeDef) + SRVOS_HEAP_ALIGN_MASK) & ~SRVOS_HEAP_ALIGN_MASK)
+#define SRVOS_HEAP_MIN_BLOCK_SIZE   (SRVOS_HEAP_BLOCK_SIZE << 1)
+#define SRVOS_HEAP_ALLOCATED_BIT    0x80000000
 
 typedef struct
 {
@@ -13,23 +33,71 @@ typedef struct
     uint32_t free_faile_cnt;
 }SrvOsCommon_HeapMonitor_TypeDef;
 
+typedef struct SrvOs_HeapBlock
+{
+    struct SrvOs_HeapBlock *nxt;
+    uint32_t size;
+} SrvOs_HeapBlock_TypeDef;
+
+typedef struct
+{
+    bool init;
+    uint8_t *addr;
+    uint32_t size;
+
+    SrvOs_HeapBlock_TypeDef start;
+    SrvOs_HeapBlock_TypeDef *end;
+
+    SrvOs_RegionStatus_TypeDef status;
+} SrvOs_RegionHeap_TypeDef;
+
 /* internal vriable */
 static bool first_call = true;
 static SrvOsCommon_HeapMonitor_TypeDef OsHeap_Monitor = {0};
+static SrvOs_RegionHeap_TypeDef SrvOs_RegionHeap[SrvOs_Heap_Sum];
+
+#if defined STM32H743xx
+static uint8_t ucHeap_D1Ext[SRVOS_HEAP_D1_EXT_SIZE] __attribute__((section(".D1_Section")));
+static uint8_t SrvOs_FastHeap[SRVOS_HEAP_FAST_SIZE];
+static uint8_t SrvOs_DMAHeap[SRVOS_HEAP_DMA_SIZE] __attribute__((section(".D2_Section")));
+static uint8_t SrvOs_LowPrioHeap[SRVOS_HEAP_LOWPRIO_SIZE] __attribute__((section(".D3_Section")));
+#endif
 
 /* external vriable */
 uint8_t ucHeap[ configTOTAL_HEAP_SIZE ] __attribute__((section(".OsHeap_Section")));
 
+/* heap_5 region must be listed in address ascending order */
+static const HeapRegion_t SrvOs_OsHeap_Region[] = {
+#if defined STM32H743xx
+    {ucHeap_D1Ext, SRVOS_HEAP_D1_EXT_SIZE},
+#endif
+    {ucHeap, configTOTAL_HEAP_SIZE},
+    {NULL, 0},
+};
+
+/* internal function */
+static void SrvOsCommon_RegionHeap_Init(SrvOs_RegionHeap_TypeDef *heap, uint8_t *addr, uint32_t size);
+static void SrvOsCommon_RegionHeap_Insert(SrvOs_RegionHeap_TypeDef *heap, SrvOs_HeapBlock_TypeDef *block);
+static void *SrvOsCommon_RegionHeap_Malloc(SrvOs_RegionHeap_TypeDef *heap, uint32_t size);
+static bool SrvOsCommon_RegionHeap_Free(SrvOs_RegionHeap_TypeDef *heap, void *ptr);
+static SrvOs_RegionHeap_TypeDef *SrvOsCommon_RegionHeap_Search(void *ptr);
+
 /* external function */
+static void SrvOsCommon_Init(void);
 static void* SrvOsCommon_Malloc(uint32_t size);
+static void *SrvOsCommon_Malloc_Tag(SrvOs_HeapRegion_List region, uint32_t size);
 static bool SrvOsCommon_Free(void *ptr);
+static bool SrvOsCommon_Get_RegionStatus(SrvOs_HeapRegion_List region, SrvOs_RegionStatus_TypeDef *status);
 
 SrvOsCommon_TypeDef SrvOsCommon = {
+    .init = SrvOsCommon_Init,
     .get_os_ms = osKernelSysTick,
     .delay_ms = osDelay,
     .precise_delay = osDelayUntil,
     .malloc = SrvOsCommon_Malloc,
+    .malloc_tag = SrvOsCommon_Malloc_Tag,
     .free = SrvOsCommon_Free,
+    .get_region_status = SrvOsCommon_Get_RegionStatus,
     .enter_critical = vPortEnterCritical,
     .exit_critical = vPortExitCritical,
     .get_heap_status = vPortGetHeapStats,
@@ -42,6 +110,80 @@ SrvOsCommon_TypeDef SrvOsCommon = {
     .systimer_enable = Kernel_EnableTimer_IRQ,
 };
 
+/* must be called before any os object created */
+static void SrvOsCommon_Init(void)
+{
+    SrvOs_HeapStatus_TypeDef status;
+
+    memset(&status, 0, sizeof(SrvOs_HeapStatus_TypeDef));
+    memset(SrvOs_RegionHeap, 0, sizeof(SrvOs_RegionHeap));
+
+    vPortDefineHeapRegions(SrvOs_OsHeap_Region);
+    vPortGetHeapStats(&status);
+    SrvOs_RegionHeap[SrvOs_Heap_Default].status.total_size = status.xAvailableHeapSpaceInBytes;
+
+#if defined STM32H743xx
+    SrvOsCommon_RegionHeap_Init(&SrvOs_RegionHeap[SrvOs_Heap_Fast], SrvOs_FastHeap, SRVOS_HEAP_FAST_SIZE);
+    SrvOsCommon_RegionHeap_Init(&SrvOs_RegionHeap[SrvOs_Heap_DMA], SrvOs_DMAHeap, SRVOS_HEAP_DMA_SIZE);
+    SrvOsCommon_RegionHeap_Init(&SrvOs_RegionHeap[SrvOs_Heap_LowPrio], SrvOs_LowPrioHeap, SRVOS_HEAP_LOWPRIO_SIZE);
+#endif
+}
+
+/* tagged region not available on this target fall back to default os heap */
+static void *SrvOsCommon_Malloc_Tag(SrvOs_HeapRegion_List region, uint32_t size)
+{
+    SrvOs_RegionHeap_TypeDef *heap = NULL;
+    void *req_tmp = NULL;
+
+    if ((region <= SrvOs_Heap_Default) || (region >= SrvOs_Heap_Sum) || !SrvOs_RegionHeap[region].init)
+        return SrvOsCommon_Malloc(size);
+
+    heap = &SrvOs_RegionHeap[region];
+
+    vTaskSuspendAll();
+    req_tmp = SrvOsCommon_RegionHeap_Malloc(heap, size);
+    (void)xTaskResumeAll();
+
+    if (req_tmp == NULL)
+    {
+        heap->status.malloc_failed_cnt ++;
+        return NULL;
+    }
+
+    heap->status.malloc_cnt ++;
+    memset(req_tmp, 0, size);
+
+    return req_tmp;
+}
+
+static bool SrvOsCommon_Get_RegionStatus(SrvOs_HeapRegion_List region, SrvOs_RegionStatus_TypeDef *status)
+{
+    SrvOs_HeapStatus_TypeDef os_status;
+
+    if ((region < SrvOs_Heap_Default) || (region >= SrvOs_Heap_Sum) || (status == NULL))
+        return false;
+
+    if (region == SrvOs_Heap_Default)
+    {
+        memset(&os_status, 0, sizeof(SrvOs_HeapStatus_TypeDef));
+        vPortGetHeapStats(&os_status);
+
+        status->total_size = SrvOs_RegionHeap[SrvOs_Heap_Default].status.total_size;
+        status->remain_size = os_status.xAvailableHeapSpaceInBytes;
+        status->min_remain_size = os_status.xMinimumEverFreeBytesRemaining;
+        status->malloc_cnt = OsHeap_Monitor.malloc_cnt;
+        status->malloc_failed_cnt = OsHeap_Monitor.malloc_failed_cnt;
+        status->free_cnt = OsHeap_Monitor.free_cnt;
+        return true;
+    }
+
+    if (!SrvOs_RegionHeap[region].init)
+        return false;
+
+    *status = SrvOs_RegionHeap[region].status;
+    return true;
+}
+
 static void* SrvOsCommon_Malloc(uint32_t size)
 {
     void *req_tmp = NULL;
@@ -88,11 +230,26 @@ static bool SrvOsCommon_Free(void *ptr)
 {
     uint32_t free_cnt = 0;
     SrvOs_HeapStatus_TypeDef status;
+    SrvOs_RegionHeap_TypeDef *heap = NULL;
+    bool free_state = false;
 
     memset(&status, 0, sizeof(SrvOs_HeapStatus_TypeDef));
 
     if(ptr)
     {
+        heap = SrvOsCommon_RegionHeap_Search(ptr);
+        if (heap)
+        {
+            vTaskSuspendAll();
+            free_state = SrvOsCommon_RegionHeap_Free(heap, ptr);
+            (void)xTaskResumeAll();
+
+            if (free_state)
+                heap->status.free_cnt ++;
+
+            return free_state;
+        }
+
         vPortGetHeapStats(&status);
         free_cnt = status.xNumberOfSuccessfulFrees;
         
@@ -116,3 +273,165 @@ static bool SrvOsCommon_Free(void *ptr)
     return false;
 }
 
+/************************************************** Region Heap Section ************************************************/
+static void SrvOsCommon_RegionHeap_Init(SrvOs_RegionHeap_TypeDef *heap, uint8_t *addr, uint32_t size)
+{
+    uint32_t start_addr = (uint32_t)addr;
+    uint32_t end_addr = (uint32_t)addr + size;
+    SrvOs_HeapBlock_TypeDef *first_block = NULL;
+
+    if ((heap == NULL) || (addr == NULL) || (size <= SRVOS_HEAP_MIN_BLOCK_SIZE * 2))
+        return;
+
+    start_addr = (start_addr + SRVOS_HEAP_ALIGN_MASK) & ~SRVOS_HEAP_ALIGN_MASK;
+    end_addr = (end_addr - SRVOS_HEAP_BLOCK_SIZE) & ~SRVOS_HEAP_ALIGN_MASK;
+
+    /* end marker placed at the top of the region */
+    heap->end = (SrvOs_HeapBlock_TypeDef *)end_addr;
+    heap->end->nxt = NULL;
+    heap->end->size = 0;
+
+    /* single free block take up the whole region at the beginning */
+    first_block = (SrvOs_HeapBlock_TypeDef *)start_addr;
+    first_block->size = end_addr - start_addr;
+    first_block->nxt = heap->end;
+
+    heap->start.nxt = first_block;
+    heap->start.size = 0;
+
+    heap->addr = addr;
+    heap->size = size;
+    heap->status.total_size = first_block->size;
+    heap->status.remain_size = first_block->size;
+    heap->status.min_remain_size = first_block->size;
+    heap->init = true;
+}
+
+/* insert block into address ordered free list, merge with neighbour if adjacent */
+static void SrvOsCommon_RegionHeap_Insert(SrvOs_RegionHeap_TypeDef *heap, SrvOs_HeapBlock_TypeDef *block)
+{
+    SrvOs_HeapBlock_TypeDef *iter = &heap->start;
+
+    while (iter->nxt < block)
+        iter = iter->nxt;
+
+    if (((uint8_t *)iter + iter->size) == (uint8_t *)block)
+    {
+        iter->size += block->size;
+        block = iter;
+    }
+
+    if ((iter->nxt != heap->end) && (((uint8_t *)block + block->size) == (uint8_t *)iter->nxt))
+    {
+        block->size += iter->nxt->size;
+        block->nxt = iter->nxt->nxt;
+    }
+    else
+        block->nxt = iter->nxt;
+
+    if (iter != block)
+        iter->nxt = block;
+}
+
+static void *SrvOsCommon_RegionHeap_Malloc(SrvOs_RegionHeap_TypeDef *heap, uint32_t size)
+{
+    SrvOs_HeapBlock_TypeDef *prv = &heap->start;
+    SrvOs_HeapBlock_TypeDef *block = heap->start.nxt;
+    SrvOs_HeapBlock_TypeDef *split = NULL;
+    uint32_t wanted = 0;
+
+    if ((size == 0) || (size & SRVOS_HEAP_ALLOCATED_BIT))
+        return NULL;
+
+    wanted = (size + SRVOS_HEAP_BLOCK_SIZE + SRVOS_HEAP_ALIGN_MASK) & ~SRVOS_HEAP_ALIGN_MASK;
+    if (wanted > heap->status.remain_size)
+        return NULL;
+
+    /* first fit */
+    while ((block->size < wanted) && (block->nxt != NULL))
+    {
+        prv = block;
+        block = block->nxt;
+    }
+
+    if (block == heap->end)
+        return NULL;
+
+    prv->nxt = block->nxt;
+
+    /* split the rest into a new free block */
+    if ((block->size - wanted) > SRVOS_HEAP_MIN_BLOCK_SIZE)
+    {
+        split = (SrvOs_HeapBlock_TypeDef *)((uint8_t *)block + wanted);
+        split->size = block->size - wanted;
+        block->size = wanted;
+        SrvOsCommon_RegionHeap_Insert(heap, split);
+    }
+
+    heap->status.remain_size -= block->size;
+    if (heap->status.remain_size < heap->status.min_remain_size)
+        heap->status.min_remain_size = heap->status.remain_size;
+
+    block->size |= SRVOS_HEAP_ALLOCATED_BIT;
+    block->nxt = NULL;
+
+    return (uint8_t *)block + SRVOS_HEAP_BLOCK_SIZE;
+}
+
+static bool SrvOsCommon_RegionHeap_Free(SrvOs_RegionHeap_TypeDef *heap, void *ptr)
+{
+    SrvOs_HeapBlock_TypeDef *block = (SrvOs_HeapBlock_TypeDef *)((uint8_t *)ptr - SRVOS_HEAP_BLOCK_SIZE);
+
+    /* double free or not a block head */
+    if (((block->size & SRVOS_HEAP_ALLOCATED_BIT) == 0) || (block->nxt != NULL))
+        return false;
+
+    block->size &= ~SRVOS_HEAP_ALLOCATED_BIT;
+    heap->status.remain_size += block->size;
+    SrvOsCommon_RegionHeap_Insert(heap, block);
+
+    return true;
+}
+
+static SrvOs_RegionHeap_TypeDef *SrvOsCommon_RegionHeap_Search(void *ptr)
+{
+    uint8_t i = 0;
+
+    for (i = SrvOs_Heap_Fast; i < SrvOs_Heap_Sum; i++)
+    {
+        if (SrvOs_RegionHeap[i].init && \
+            ((uint8_t *)ptr >= SrvOs_RegionHeap[i].addr) && \
+            ((uint8_t *)ptr < (SrvOs_RegionHeap[i].addr + SrvOs_RegionHeap[i].size)))
+            return &SrvOs_RegionHeap[i];
+    }
+
+    return NULL;
+}
+
+/************************************************** Shell Section ************************************************/
+static void SrvOsCommon_Show_HeapInfo(void)
+{
+    Shell *shell_obj = Shell_GetInstence();
+    SrvOs_RegionStatus_TypeDef status;
+    const char *region_name[SrvOs_Heap_Sum] = {"default", "fast", "dma", "lowprio"};
+    uint8_t i = 0;
+
+    if (shell_obj == NULL)
+        return;
+
+    shellPrint(shell_obj, "\t[Heap Region]\r\n");
+    for (i = SrvOs_Heap_Default; i < SrvOs_Heap_Sum; i++)
+    {
+        memset(&status, 0, sizeof(SrvOs_RegionStatus_TypeDef));
+
+        if (!SrvOsCommon_Get_RegionStatus(i, &status))
+        {
+            shellPrint(shell_obj, "\t%-8s : [Unavaliable, use default]\r\n", region_name[i]);
+            continue;
+        }
+
+        shellPrint(shell_obj, "\t%-8s : total %d remain %d min remain %d\r\n", region_name[i], status.total_size, status.remain_size, status.min_remain_size);
+        shellPrint(shell_obj, "\t           malloc %d failed %d free %d\r\n", status.malloc_cnt, status.malloc_failed_cnt, status.free_cnt);
+    }
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Heap_Info, SrvOsCommon_Show_HeapInfo, Heap Region Info);
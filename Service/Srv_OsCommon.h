@@ -9,8 +9,32 @@ typedef HeapStats_t SrvOs_HeapStatus_TypeDef;
 
 #define MS_PER_S 1000
 
+/*
+ * memory region tag for malloc_tag
+ * target have only one sram (at32f435) put all tag into default os heap
+ */
+typedef enum
+{
+    SrvOs_Heap_Default = 0, /* os heap, D1 AXI sram (heap_5), cached, task stack and general object */
+    SrvOs_Heap_Fast,        /* DTCM, cpu only data, dma can not access */
+    SrvOs_Heap_DMA,         /* D2 sram, none cacheable, dma buffer */
+    SrvOs_Heap_LowPrio,     /* D3 sram, none cacheable, low priority buffer */
+    SrvOs_Heap_Sum,
+} SrvOs_HeapRegion_List;
+
+typedef struct
+{
+    uint32_t total_size;
+    uint32_t remain_size;
+    uint32_t min_remain_size;
+    uint32_t malloc_cnt;
+    uint32_t malloc_failed_cnt;
+    uint32_t free_cnt;
+} SrvOs_RegionStatus_TypeDef;
+
 typedef struct
 {
+    void (*init)(void);
     uint32_t (*get_os_ms)(void);
     int32_t (*delay_ms)(uint32_t ms);
     int32_t (*precise_delay)(uint32_t *p_time, uint32_t ms);
@@ -23,7 +47,9 @@ typedef struct
     uint32_t (*systimer_enable)(void);
 
     void *(*malloc)(uint16_t size);
+    void *(*malloc_tag)(SrvOs_HeapRegion_List region, uint32_t size);
     void (*free)(void *ptr);
+    bool (*get_region_status)(SrvOs_HeapRegion_List region, SrvOs_RegionStatus_TypeDef *status);
 
     void (*enter_critical)(void);
     void (*exit_critical)(void);
@@ -0,0 +1,318 @@
+#include "Srv_Param.h"
+#include "shell_port.h"
+
+/* internal vriable */
+static SrvParam_Monitor_TypeDef SrvParam_Monitor = {
+    .init_state = false,
+};
+static SrvParam_Store_TypeDef SrvParam_Store;
+
+/* internal function */
+static uint8_t SrvParam_Type_Size(SrvParam_Type_List type);
+static int16_t SrvParam_Search_Record(const char *name);
+static float SrvParam_To_Float(SrvParam_Type_List type, const void *p_val);
+
+/* external function */
+static bool SrvParam_Init(Storage_MediumType_List medium);
+static bool SrvParam_Regist(const char *name, SrvParam_Type_List type, void *p_val, SrvParam_Update_Callback callback);
+static uint16_t SrvParam_Get_Num(void);
+static int16_t SrvParam_Search(const char *name);
+static bool SrvParam_Get(uint16_t index, SrvParam_Info_TypeDef *p_info);
+static bool SrvParam_Set(uint16_t index, float val);
+static bool SrvParam_Proc(void);
+
+SrvParam_TypeDef SrvParam = {
+    .init = SrvParam_Init,
+    .regist = SrvParam_Regist,
+    .get_num = SrvParam_Get_Num,
+    .search = SrvParam_Search,
+    .get = SrvParam_Get,
+    .set = SrvParam_Set,
+    .proc = SrvParam_Proc,
+};
+
+/* load stored table once, record of parameter not registered in this build is kept and written back as it is */
+static bool SrvParam_Init(Storage_MediumType_List medium)
+{
+    if (SrvParam_Monitor.init_state)
+        return true;
+
+    memset(&SrvParam_Monitor, 0, sizeof(SrvParam_Monitor));
+    memset(&SrvParam_Store, 0, sizeof(SrvParam_Store));
+
+    SrvParam_Monitor.medium = medium;
+    SrvParam_Monitor.hdl = Storage.search(medium, Para_User, SRV_PARAM_STORAGE_NAME);
+
+    if (SrvParam_Monitor.hdl)
+    {
+        SrvParam_Monitor.load_err = Storage.get(medium, Para_User, SrvParam_Monitor.hdl, (uint8_t *)&SrvParam_Store, sizeof(SrvParam_Store));
+
+        if ((SrvParam_Monitor.load_err != Storage_Error_None) || \
+            (SrvParam_Store.tag != SRV_PARAM_STORE_TAG) || \
+            (SrvParam_Store.num > SRV_PARAM_MAX))
+        {
+            /* stored table unusable, run on default value */
+            if (SrvParam_Monitor.load_err == Storage_Error_None)
+                SrvParam_Monitor.load_err = Storage_DataInfo_Error;
+
+            memset(&SrvParam_Store, 0, sizeof(SrvParam_Store));
+        }
+    }
+
+    SrvParam_Store.tag = SRV_PARAM_STORE_TAG;
+    SrvParam_Monitor.init_state = true;
+
+    return true;
+}
+
+static uint8_t SrvParam_Type_Size(SrvParam_Type_List type)
+{
+    switch ((uint8_t)type)
+    {
+        case SrvParam_U8: return sizeof(uint8_t);
+        case SrvParam_I32: return sizeof(int32_t);
+        case SrvParam_F32: return sizeof(float);
+        default: return 0;
+    }
+}
+
+static int16_t SrvParam_Search_Record(const char *name)
+{
+    for (uint16_t i = 0; i < SrvParam_Store.num; i++)
+    {
+        if (strncmp(SrvParam_Store.record[i].name, name, SRV_PARAM_NAME_LEN) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+/* variable keep its initial value as default, stored value of the same name and type override it */
+static bool SrvParam_Regist(const char *name, SrvParam_Type_List type, void *p_val, SrvParam_Update_Callback callback)
+{
+    SrvParam_Entry_TypeDef *entry = NULL;
+    SrvParam_Record_TypeDef *record = NULL;
+    uint8_t size = SrvParam_Type_Size(type);
+    int16_t record_index = 0;
+
+    if (!SrvParam_Monitor.init_state || (name == NULL) || (strlen(name) == 0) || \
+        (strlen(name) > SRV_PARAM_NAME_LEN) || (p_val == NULL) || (size == 0) || \
+        (SrvParam_Monitor.num >= SRV_PARAM_MAX) || (SrvParam_Search(name) >= 0))
+        return false;
+
+    record_index = SrvParam_Search_Record(name);
+    if (record_index < 0)
+    {
+        if (SrvParam_Store.num >= SRV_PARAM_MAX)
+            return false;
+
+        record_index = SrvParam_Store.num;
+        record = &SrvParam_Store.record[record_index];
+        memset(record, 0, sizeof(SrvParam_Record_TypeDef));
+        strncpy(record->name, name, SRV_PARAM_NAME_LEN);
+        record->type = type;
+        memcpy(&record->val, p_val, size);
+        SrvParam_Store.num ++;
+    }
+    else
+    {
+        record = &SrvParam_Store.record[record_index];
+
+        if (record->type == type)
+        {
+            memcpy(p_val, &record->val, size);
+        }
+        else
+        {
+            /* type changed since it was stored, drop the stored value */
+            record->type = type;
+            record->val = 0;
+            memcpy(&record->val, p_val, size);
+        }
+    }
+
+    entry = &SrvParam_Monitor.entry[SrvParam_Monitor.num];
+    entry->type = type;
+    entry->p_val = p_val;
+    entry->record = record_index;
+    entry->callback = callback;
+    SrvParam_Monitor.num ++;
+
+    if (callback)
+        callback(p_val);
+
+    return true;
+}
+
+static uint16_t SrvParam_Get_Num(void)
+{
+    return SrvParam_Monitor.num;
+}
+
+/* name compare up to SRV_PARAM_NAME_LEN char, return -1 when not registered */
+static int16_t SrvParam_Search(const char *name)
+{
+    if (name == NULL)
+        return -1;
+
+    for (uint16_t i = 0; i < SrvParam_Monitor.num; i++)
+    {
+        if (strncmp(SrvParam_Store.record[SrvParam_Monitor.entry[i].record].name, name, SRV_PARAM_NAME_LEN) == 0)
+            return i;
+    }
+
+    return -1;
+}
+
+static float SrvParam_To_Float(SrvParam_Type_List type, const void *p_val)
+{
+    switch ((uint8_t)type)
+    {
+        case SrvParam_U8: return (float)(*(const uint8_t *)p_val);
+        case SrvParam_I32: return (float)(*(const int32_t *)p_val);
+        case SrvParam_F32: return *(const float *)p_val;
+        default: return 0.0f;
+    }
+}
+
+static bool SrvParam_Get(uint16_t index, SrvParam_Info_TypeDef *p_info)
+{
+    SrvParam_Entry_TypeDef *entry = NULL;
+
+    if ((index >= SrvParam_Monitor.num) || (p_info == NULL))
+        return false;
+
+    entry = &SrvParam_Monitor.entry[index];
+    p_info->name = SrvParam_Store.record[entry->record].name;
+    p_info->type = entry->type;
+    p_info->val = SrvParam_To_Float(entry->type, entry->p_val);
+
+    return true;
+}
+
+/* integer parameter is carried as float, value is rounded to the nearest integer */
+static bool SrvParam_Set(uint16_t index, float val)
+{
+    SrvParam_Entry_TypeDef *entry = NULL;
+    SrvParam_Record_TypeDef *record = NULL;
+    uint8_t u8 = 0;
+    int32_t i32 = 0;
+
+    if ((index >= SrvParam_Monitor.num) || (val != val))
+        return false;
+
+    entry = &SrvParam_Monitor.entry[index];
+    record = &SrvParam_Store.record[entry->record];
+
+    switch ((uint8_t)entry->type)
+    {
+        case SrvParam_U8:
+            if ((val < 0.0f) || (val > 255.0f))
+                return false;
+
+            u8 = (uint8_t)(val + 0.5f);
+            *(uint8_t *)entry->p_val = u8;
+            record->val = u8;
+            break;
+
+        case SrvParam_I32:
+            if ((val < -2147483648.0f) || (val >= 2147483648.0f))
+                return false;
+
+            i32 = (int32_t)(val + ((val >= 0.0f) ? 0.5f : -0.5f));
+            *(int32_t *)entry->p_val = i32;
+            memcpy(&record->val, &i32, sizeof(i32));
+            break;
+
+        case SrvParam_F32:
+            *(float *)entry->p_val = val;
+            memcpy(&record->val, &val, sizeof(val));
+            break;
+
+        default:
+            return false;
+    }
+
+    if (entry->callback)
+        entry->callback(entry->p_val);
+
+    SrvParam_Monitor.set_cnt ++;
+    SrvParam_Monitor.dirty_ms = SrvOsCommon.get_os_ms();
+    SrvParam_Monitor.dirty = true;
+
+    return true;
+}
+
+/*
+ * write the table back once set stop coming in, a burst of set end up in a single flash commit
+ * run in low priority task, set during the commit mark the table dirty again and get written on the next call
+ */
+static bool SrvParam_Proc(void)
+{
+    Storage_ErrorCode_List err = Storage_Error_None;
+
+    if (!SrvParam_Monitor.init_state || !SrvParam_Monitor.dirty || \
+        ((SrvOsCommon.get_os_ms() - SrvParam_Monitor.dirty_ms) < SRV_PARAM_COMMIT_DELAY))
+        return false;
+
+    SrvParam_Monitor.dirty = false;
+
+    if (SrvParam_Monitor.hdl == 0)
+    {
+        err = Storage.create(SrvParam_Monitor.medium, Para_User, SRV_PARAM_STORAGE_NAME, (uint8_t *)&SrvParam_Store, sizeof(SrvParam_Store));
+
+        if (err == Storage_Error_None)
+            SrvParam_Monitor.hdl = Storage.search(SrvParam_Monitor.medium, Para_User, SRV_PARAM_STORAGE_NAME);
+    }
+    else
+        err = Storage.update(SrvParam_Monitor.medium, Para_User, SrvParam_Monitor.hdl, (uint8_t *)&SrvParam_Store, sizeof(SrvParam_Store));
+
+    if (!Storage.flush(SrvParam_Monitor.medium) && (err == Storage_Error_None))
+        err = Storage_Write_Error;
+
+    if (err != Storage_Error_None)
+    {
+        SrvParam_Monitor.commit_err ++;
+        SrvParam_Monitor.commit_err_code = err;
+        return false;
+    }
+
+    SrvParam_Monitor.commit_cnt ++;
+    return true;
+}
+
+/************************************************** shell section ************************************************/
+static void SrvParam_Show(void)
+{
+    Shell *shell_obj = Shell_GetInstence();
+    SrvParam_Info_TypeDef info;
+    float abs_val = 0.0f;
+    uint32_t int_part = 0;
+
+    if (shell_obj == NULL)
+        return;
+
+    shellPrint(shell_obj, "\t[Param] %d registered %d stored\r\n", SrvParam_Monitor.num, SrvParam_Store.num);
+    shellPrint(shell_obj, "\t[Param] storage handle 0x%08x load error %d\r\n", SrvParam_Monitor.hdl, SrvParam_Monitor.load_err);
+    shellPrint(shell_obj, "\t[Param] set %d commit %d commit error %d (last %d) %s\r\n", SrvParam_Monitor.set_cnt, SrvParam_Monitor.commit_cnt,
+               SrvParam_Monitor.commit_err, SrvParam_Monitor.commit_err_code, SrvParam_Monitor.dirty ? "dirty" : "clean");
+
+    for (uint16_t i = 0; i < SrvParam_Monitor.num; i++)
+    {
+        if (!SrvParam_Get(i, &info))
+            continue;
+
+        /* nano printf has no float support */
+        abs_val = (info.val < 0.0f) ? -info.val : info.val;
+        if (abs_val >= 2000000000.0f)
+        {
+            shellPrint(shell_obj, "\t%3d %-16.16s out of print range\r\n", i, info.name);
+            continue;
+        }
+
+        int_part = (uint32_t)abs_val;
+        shellPrint(shell_obj, "\t%3d %-16.16s %s%d.%06d\r\n", i, info.name, (info.val < 0.0f) ? "-" : "", int_part,
+                   (uint32_t)((abs_val - int_part) * 1000000.0f));
+    }
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Param_Show, SrvParam_Show, Show tunable parameter);
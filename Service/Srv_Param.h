@@ -0,0 +1,97 @@
+#ifndef __SRV_PARAM_H
+#define __SRV_PARAM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "Srv_OsCommon.h"
+#include "Storage.h"
+
+/*
+ * tunable parameter table
+ * module register a variable by name, the whole table is kept in ram and indexed by register order
+ * so reading / listing never touch the flash, changed value is written back as one storage item
+ * once no more set come in for SRV_PARAM_COMMIT_DELAY
+ */
+#define SRV_PARAM_MAX 128
+#define SRV_PARAM_NAME_LEN 16           /* same as mavlink param id, not null terminated when 16 char long */
+#define SRV_PARAM_STORAGE_NAME "Param_Table"
+#define SRV_PARAM_STORE_TAG 0x50524D31  /* "PRM1" change it when the record layout change */
+#define SRV_PARAM_COMMIT_DELAY 500      /* unit: ms */
+
+typedef enum
+{
+    SrvParam_U8 = 0,
+    SrvParam_I32,
+    SrvParam_F32,
+} SrvParam_Type_List;
+
+/* called after the value changed, apply derived value in here */
+typedef void (*SrvParam_Update_Callback)(void *p_val);
+
+#pragma pack(1)
+typedef struct
+{
+    char name[SRV_PARAM_NAME_LEN];
+    uint8_t type;
+    uint8_t reserved[3];
+    uint32_t val;           /* raw value, u8 in the low byte */
+} SrvParam_Record_TypeDef;
+
+/* storage item layout, fixed size so the item is updated in place */
+typedef struct
+{
+    uint32_t tag;
+    uint16_t num;
+    uint16_t reserved;
+    SrvParam_Record_TypeDef record[SRV_PARAM_MAX];
+} SrvParam_Store_TypeDef;
+#pragma pack()
+
+typedef struct
+{
+    SrvParam_Type_List type;
+    void *p_val;
+    uint16_t record;        /* record index in store */
+    SrvParam_Update_Callback callback;
+} SrvParam_Entry_TypeDef;
+
+typedef struct
+{
+    const char *name;       /* point to the record name, SRV_PARAM_NAME_LEN byte */
+    SrvParam_Type_List type;
+    float val;
+} SrvParam_Info_TypeDef;
+
+typedef struct
+{
+    bool init_state;
+    Storage_MediumType_List medium;
+    storage_handle hdl;
+    Storage_ErrorCode_List load_err;
+
+    uint16_t num;
+    SrvParam_Entry_TypeDef entry[SRV_PARAM_MAX];
+
+    volatile bool dirty;
+    volatile uint32_t dirty_ms;
+    uint32_t set_cnt;
+    uint32_t commit_cnt;
+    uint32_t commit_err;
+    Storage_ErrorCode_List commit_err_code;
+} SrvParam_Monitor_TypeDef;
+
+typedef struct
+{
+    bool (*init)(Storage_MediumType_List medium);
+    bool (*regist)(const char *name, SrvParam_Type_List type, void *p_val, SrvParam_Update_Callback callback);
+    uint16_t (*get_num)(void);
+    int16_t (*search)(const char *name);
+    bool (*get)(uint16_t index, SrvParam_Info_TypeDef *p_info);
+    bool (*set)(uint16_t index, float val);
+    bool (*proc)(void);
+} SrvParam_TypeDef;
+
+extern SrvParam_TypeDef SrvParam;
+
+#endif
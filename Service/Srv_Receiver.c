@@ -157,7 +157,7 @@ static bool SrvReceiver_Init(SrvReceiverObj_TypeDef *obj, uint8_t *port_obj)
         }
 
         Uart_Receiver_Obj->tx_dma_hdl = SrvOsCommon.malloc(UART_DMA_Handle_Size);
-        if(Uart_Receiver_Obj->tx_dma_hdl)
+        if(Uart_Receiver_Obj->tx_dma_hdl == NULL)
         {
             SrvOsCommon.free(Uart_Receiver_Obj->tx_dma_hdl);
             SrvOsCommon.free(Uart_Receiver_Obj->hdl);
@@ -165,7 +165,7 @@ static bool SrvReceiver_Init(SrvReceiverObj_TypeDef *obj, uint8_t *port_obj)
         }
 
         Uart_Receiver_Obj->rx_dma_hdl = SrvOsCommon.malloc(UART_DMA_Handle_Size);
-        if(Uart_Receiver_Obj->rx_dma_hdl)
+        if(Uart_Receiver_Obj->rx_dma_hdl == NULL)
         {
             SrvOsCommon.free(Uart_Receiver_Obj->rx_dma_hdl);
             SrvOsCommon.free(Uart_Receiver_Obj->tx_dma_hdl);
@@ -22,6 +22,8 @@ static bool SrvSensorMonitor_Tof_Init(void);
 static bool SrvSensorMonitor_Init(SrvSensorMonitorObj_TypeDef *obj);
 static bool SrvSensorMonitor_SampleCTL(SrvSensorMonitorObj_TypeDef *obj);
 static SrvIMU_UnionData_TypeDef SrvSensorMonitor_Get_IMUData(SrvSensorMonitorObj_TypeDef *obj);
+static bool SrvSensorMonitor_Get_IMUDelta(SrvSensorMonitorObj_TypeDef *obj, SrvIMU_Delta_TypeDef *delta);
+static bool SrvSensorMonitor_Set_MotoRPM(SrvSensorMonitorObj_TypeDef *obj, const float *rpm, uint8_t cnt);
 static GenCalib_State_TypeList SrvSensorMonitor_Set_Module_Calib(SrvSensorMonitorObj_TypeDef *obj, SrvSensorMonitor_Type_List type);
 static GenCalib_State_TypeList SrvSensorMonitor_Get_Module_Calib(SrvSensorMonitorObj_TypeDef *obj, SrvSensorMonitor_Type_List type);
 static SrvBaroData_TypeDef SrvSensorMonitor_Get_BaroData(SrvSensorMonitorObj_TypeDef *obj);
@@ -34,6 +36,8 @@ SrvSensorMonitor_TypeDef SrvSensorMonitor = {
     .get_imu_num = SrvSensorMonitor_IMU_Get_Num,
     .get_imu_range = SrvSensorMonitor_Get_IMU_Range,
     .get_imu_data = SrvSensorMonitor_Get_IMUData,
+    .get_imu_delta = SrvSensorMonitor_Get_IMUDelta,
+    .set_moto_rpm = SrvSensorMonitor_Set_MotoRPM,
     .get_baro_data = SrvSensorMonitor_Get_BaroData,
     .set_calib = SrvSensorMonitor_Set_Module_Calib,
     .get_calib = SrvSensorMonitor_Get_Module_Calib,
@@ -88,7 +92,9 @@ static bool SrvSensorMonitor_Init(SrvSensorMonitorObj_TypeDef *obj)
         }
         else
         {
-            obj->statistic_mag->is_calid = Calib_None;
+            if(obj->statistic_mag)
+                obj->statistic_mag->is_calid = Calib_None;
+
             obj->init_state_reg.bit.mag = false;
         }
 
@@ -105,7 +111,9 @@ static bool SrvSensorMonitor_Init(SrvSensorMonitorObj_TypeDef *obj)
         }
         else
         {
-            obj->statistic_baro->is_calid = Calib_None;
+            if(obj->statistic_baro)
+                obj->statistic_baro->is_calid = Calib_None;
+
             obj->init_state_reg.bit.baro = false;
         }
 
@@ -341,8 +349,8 @@ static bool SrvSensorMonitor_IMU_SampleCTL(SrvSensorMonitorObj_TypeDef *obj)
     {
         sample_interval_ms = SrvSensorMonitor_GetSampleInterval(obj->statistic_imu->set_period);
         
+        /* error event raised here are drained by the manager task, never in this sample context */
         if( SrvIMU.sample && \
-            SrvIMU.error_proc && 
             ((obj->statistic_imu->start_time == 0) || \
              (sample_interval_ms && \
              (cur_time >= obj->statistic_imu->nxt_sample_time))))
@@ -354,7 +362,6 @@ static bool SrvSensorMonitor_IMU_SampleCTL(SrvSensorMonitorObj_TypeDef *obj)
             if(SrvIMU.sample(obj->IMU_SampleMode))
             { 
                 end_tick = SrvOsCommon.get_systimer_current_tick();
-                SrvIMU.error_proc();
 
                 obj->statistic_imu->sample_cnt ++;
                 obj->statistic_imu->nxt_sample_time = cur_time + sample_interval_ms;
@@ -445,6 +452,40 @@ static SrvIMU_UnionData_TypeDef SrvSensorMonitor_Get_IMUData(SrvSensorMonitorObj
     return imu_data_tmp;
 }
 
+/* true once per closed integration window */
+static bool SrvSensorMonitor_Get_IMUDelta(SrvSensorMonitorObj_TypeDef *obj, SrvIMU_Delta_TypeDef *delta)
+{
+    if((obj == NULL) || (delta == NULL) || !obj->enabled_reg.bit.imu || !obj->init_state_reg.bit.imu || (SrvIMU.get_delta == NULL))
+        return false;
+
+    if(!SrvIMU.get_delta(delta))
+        return false;
+
+    /* same axis adjustment as sample data, pure rotation keep coning and sculling term valid */
+#if defined MATEKH743_V1_5
+    delta->d_ang[Axis_X] *= -1;
+    delta->d_ang[Axis_Y] *= -1;
+
+    delta->d_vel[Axis_X] *= -1;
+    delta->d_vel[Axis_Y] *= -1;
+#elif defined MATEKH743_V3_0
+
+#elif defined BETA_AT32_AIO
+
+#endif
+
+    return true;
+}
+
+/* moto rpm feed the gyro rpm notch, moto rotation is independent of imu mounting */
+static bool SrvSensorMonitor_Set_MotoRPM(SrvSensorMonitorObj_TypeDef *obj, const float *rpm, uint8_t cnt)
+{
+    if((obj == NULL) || (rpm == NULL) || !obj->enabled_reg.bit.imu || !obj->init_state_reg.bit.imu || (SrvIMU.set_moto_rpm == NULL))
+        return false;
+
+    return SrvIMU.set_moto_rpm(rpm, cnt);
+}
+
 /******************************************* Mag Section **********************************************/
 /* still in developing */
 static bool SrvSensorMonitor_Mag_Init(void)
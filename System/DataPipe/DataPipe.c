@@ -1,6 +1,7 @@
 #include "DataPipe.h"
 #include "Bsp_DMA.h"
 #include "Srv_OsCommon.h"
+#include "evt_trace.h"
 
 #define MAX_RETRY_CNT 200
 #define MAX_PIPE_FREQ 2000
@@ -48,6 +49,7 @@ bool DataPipe_SendTo(DataPipeObj_TypeDef *p_org, DataPipeObj_TypeDef *p_dst)
 
     Cur_Pluged_PipeObj.dst = p_dst;
     Cur_Pluged_PipeObj.org = p_org;
+    EvtTrace.record(EvtTrace_Pipe_Start, 0, p_org->data_size);
 
 retry:
     Pipe_State = Pipe_Busy;
@@ -83,6 +85,7 @@ static void DataPipe_TransFinish_Callback(void *dma_hdl)
 
     if (BspDMA_Pipe.get_hanle && (To_DMA_Handle_Ptr(dma_hdl) == To_DMA_Handle_Ptr(BspDMA_Pipe.get_hanle())))
     {
+        EvtTrace.record(EvtTrace_Pipe_Finish, 0, 0);
         Pipe_State = Pipe_Ready;
 
         Cur_Pluged_PipeObj.dst->rx_cnt++;
@@ -109,6 +112,7 @@ static void DataPipe_TransError_Callback(void *dma_hdl)
 {
     if (BspDMA_Pipe.get_hanle && (To_DMA_Handle_Ptr(dma_hdl) == To_DMA_Handle_Ptr(BspDMA_Pipe.get_hanle())))
     {
+        EvtTrace.record(EvtTrace_Pipe_Finish, 1, 0);
         Pipe_State = Pipe_Error;
 
         Cur_Pluged_PipeObj.dst->er_cnt++;
@@ -94,6 +94,9 @@ extern DataPipeObj_TypeDef IMU_Smp_DataPipe;
 extern DataPipeObj_TypeDef IMU_Log_DataPipe;
 extern DataPipeObj_TypeDef IMU_hub_DataPipe;
 
+extern DataPipeObj_TypeDef IMU_Delta_Smp_DataPipe;
+extern DataPipeObj_TypeDef IMU_Delta_hub_DataPipe;
+
 extern DataPipeObj_TypeDef IMU_PriRange_Smp_DataPipe;
 extern DataPipeObj_TypeDef IMU_PriRange_hub_DataPipe;
 extern DataPipeObj_TypeDef IMU_SecRange_Smp_DataPipe;
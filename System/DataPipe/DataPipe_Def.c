@@ -15,6 +15,9 @@ DataPipeObj_TypeDef IMU_Log_DataPipe = {.enable = true};
 DataPipeObj_TypeDef IMU_Smp_DataPipe = {.enable = true};
 DataPipeObj_TypeDef IMU_hub_DataPipe = {.enable = true};
 
+DataPipeObj_TypeDef IMU_Delta_Smp_DataPipe = {.enable = true};
+DataPipeObj_TypeDef IMU_Delta_hub_DataPipe = {.enable = true};
+
 DataPipeObj_TypeDef IMU_PriRange_Smp_DataPipe = {.enable = true};
 DataPipeObj_TypeDef IMU_PriRange_hub_DataPipe = {.enable = true};
 DataPipeObj_TypeDef IMU_SecRange_Smp_DataPipe = {.enable = true};
@@ -56,6 +56,9 @@
   static uint32_t systemcoreclock = 288000000;
   #endif
   void xPortSysTickHandler(void);
+  uint32_t Kernel_Get_CycleCnt(void);
+  void EvtTrace_Task_SwitchIn(uint32_t number);
+  void EvtTrace_Task_SwitchOut(uint32_t number);
 #endif
 #define configENABLE_FPU                         1
 #define configENABLE_MPU                         0
@@ -106,6 +109,16 @@ to exclude the API function. */
 
 #define configAPPLICATION_ALLOCATED_HEAP 1
 
+/* task run time on the dwt cycle counter, read by the profiler as a per window delta so the 32 bit wrap is harmless */
+#define configUSE_TRACE_FACILITY                 1
+#define configGENERATE_RUN_TIME_STATS            1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()         Kernel_Get_CycleCnt()
+
+/* task switch into the event trace ring */
+#define traceTASK_SWITCHED_IN()                  EvtTrace_Task_SwitchIn(pxCurrentTCB->uxTCBNumber)
+#define traceTASK_SWITCHED_OUT()                 EvtTrace_Task_SwitchOut(pxCurrentTCB->uxTCBNumber)
+
 /* Cortex-M specific definitions. */
 #ifdef __NVIC_PRIO_BITS
  /* __BVIC_PRIO_BITS will be specified when CMSIS is being used. */
@@ -0,0 +1,563 @@
+/*
+ * FreeRTOS Kernel V10.3.1 host simulation port
+ *
+ * single core model on posix thread
+ *   every task own a host thread, the thread hold the cpu only when Port_Running point to it
+ *   Port_IrqLock stand for the interrupt mask, critical section and isr context both hold it
+ *   isr entry park the running task thread by signal and wait the ack, so task code never run along with an isr
+ *   context switch request inside critical section is pended and done on the last critical exit, like PendSV
+ *
+ * task stack is only used to carry the host thread object, the real stack is the host thread stack
+ * all host thread stack are mapped under 4GB, address stored in uint32_t by firmware keep valid
+ */
+#define _GNU_SOURCE
+#include <pthread.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <errno.h>
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define PORT_SUSPEND_SIGNAL SIGUSR1
+#define PORT_THREAD_STACK_SIZE (512 * 1024)
+#define PORT_NS_PER_SEC 1000000000ULL
+
+typedef struct
+{
+    pthread_t thread;
+    sem_t resume;
+    TaskFunction_t code;
+    void *param;
+    volatile BaseType_t deleted;
+} PortThread_TypeDef;
+
+/* internal vriable */
+static sem_t Port_IrqLock;
+static sem_t Port_SuspendAck;
+static sem_t Port_IrqEvent;
+static sem_t Port_End;
+static PortThread_TypeDef *volatile Port_Running = NULL;
+static volatile UBaseType_t Port_CriticalNesting = 0;
+static volatile BaseType_t Port_YieldPending = pdFALSE;
+static volatile BaseType_t Port_IrqMasked = pdFALSE;
+static volatile BaseType_t Port_IsrYield = pdFALSE;
+static volatile BaseType_t Port_SchedulerRun = pdFALSE;
+static volatile BaseType_t Port_Init = pdFALSE;
+static PortThread_TypeDef *Port_IsrPreempted = NULL;
+static UBaseType_t Port_IsrNesting = 0;
+static BaseType_t Port_IsrBorrowLock = pdFALSE;
+
+static __thread PortThread_TypeDef *Port_Self = NULL;
+static __thread BaseType_t Port_InIsr = pdFALSE;
+static __thread volatile sig_atomic_t Port_Parked = 0;
+
+/* internal function */
+static void Port_Setup(void);
+static void Port_Lock(void);
+static void Port_Unlock(void);
+static void Port_Wait(PortThread_TypeDef *self);
+static void Port_Switch(void);
+static PortThread_TypeDef *Port_Get_Thread(TaskHandle_t task);
+static void Port_Suspend_Handler(int sig);
+static void *Port_Task_Entry(void *arg);
+static void *Port_Tick_Entry(void *arg);
+static BaseType_t Port_Create_Thread(pthread_t *thread, SitlPort_ThreadFunc func, void *arg);
+
+static void Port_Setup(void)
+{
+    struct sigaction sig;
+
+    if (Port_Init)
+        return;
+
+    sem_init(&Port_IrqLock, 0, 1);
+    sem_init(&Port_SuspendAck, 0, 0);
+    sem_init(&Port_IrqEvent, 0, 0);
+    sem_init(&Port_End, 0, 0);
+
+    /* handler may nest when the signal land between the wait loop exit and the handler return */
+    memset(&sig, 0, sizeof(sig));
+    sig.sa_handler = Port_Suspend_Handler;
+    sig.sa_flags = SA_NODEFER | SA_RESTART;
+    sigemptyset(&sig.sa_mask);
+    sigaction(PORT_SUSPEND_SIGNAL, &sig, NULL);
+
+    Port_Init = pdTRUE;
+}
+
+static void Port_Lock(void)
+{
+    while (sem_wait(&Port_IrqLock) != 0);
+}
+
+static void Port_Unlock(void)
+{
+    sem_post(&Port_IrqLock);
+}
+
+/* stale resume post is harmless, ownership is decided by Port_Running only
+ * suspend signal caught while parked only ack, the loop check Port_Running again
+ * otherwise a thread picked and preempted again before it get the host cpu stack one handler frame every time */
+static void Port_Wait(PortThread_TypeDef *self)
+{
+    do
+    {
+        Port_Parked = 1;
+        while (Port_Running != self)
+        {
+            if (self->deleted)
+                pthread_exit(NULL);
+
+            sem_wait(&self->resume);
+        }
+        Port_Parked = 0;
+    } while (Port_Running != self);
+}
+
+static PortThread_TypeDef *Port_Get_Thread(TaskHandle_t task)
+{
+    PortThread_TypeDef *thread = NULL;
+    StackType_t *top = NULL;
+
+    if (task == NULL)
+        return NULL;
+
+    /* pxTopOfStack is the first member of tcb */
+    top = *(StackType_t **)task;
+    memcpy(&thread, top, sizeof(thread));
+
+    return thread;
+}
+
+static void Port_Suspend_Handler(int sig)
+{
+    int err = errno;
+    PortThread_TypeDef *self = Port_Self;
+
+    (void)sig;
+
+    sem_post(&Port_SuspendAck);
+
+    if (self && !Port_Parked)
+        Port_Wait(self);
+
+    errno = err;
+}
+
+/* caller hold the irq lock in task context, lock released on return */
+static void Port_Switch(void)
+{
+    PortThread_TypeDef *self = Port_Self;
+    PortThread_TypeDef *next = NULL;
+
+    vTaskSwitchContext();
+    next = Port_Get_Thread(xTaskGetCurrentTaskHandle());
+
+    if ((next == NULL) || (next == self))
+    {
+        Port_Unlock();
+        return;
+    }
+
+    Port_Running = next;
+    sem_post(&next->resume);
+    Port_Unlock();
+
+    if (self)
+        Port_Wait(self);
+}
+
+static BaseType_t Port_Create_Thread(pthread_t *thread, SitlPort_ThreadFunc func, void *arg)
+{
+    pthread_attr_t attr;
+    sigset_t block;
+    sigset_t old;
+    void *stack = NULL;
+    int err = 0;
+
+    stack = mmap(NULL, PORT_THREAD_STACK_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_32BIT, -1, 0);
+    if (stack == MAP_FAILED)
+        return pdFALSE;
+
+    pthread_attr_init(&attr);
+    pthread_attr_setstack(&attr, stack, PORT_THREAD_STACK_SIZE);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+
+    /* new thread start with suspend signal blocked, unblocked once it know who it is */
+    sigemptyset(&block);
+    sigaddset(&block, PORT_SUSPEND_SIGNAL);
+    pthread_sigmask(SIG_BLOCK, &block, &old);
+    err = pthread_create(thread, &attr, func, arg);
+    pthread_sigmask(SIG_SETMASK, &old, NULL);
+    pthread_attr_destroy(&attr);
+
+    if (err)
+    {
+        munmap(stack, PORT_THREAD_STACK_SIZE);
+        return pdFALSE;
+    }
+
+    return pdTRUE;
+}
+
+static void *Port_Task_Entry(void *arg)
+{
+    PortThread_TypeDef *self = (PortThread_TypeDef *)arg;
+    sigset_t unblock;
+
+    Port_Self = self;
+    sigemptyset(&unblock);
+    sigaddset(&unblock, PORT_SUSPEND_SIGNAL);
+    pthread_sigmask(SIG_UNBLOCK, &unblock, NULL);
+
+    Port_Wait(self);
+    self->code(self->param);
+
+    /* task function should never return */
+    vTaskDelete(NULL);
+    return NULL;
+}
+
+static void *Port_Tick_Entry(void *arg)
+{
+    struct timespec next;
+    uint64_t period = PORT_NS_PER_SEC / configTICK_RATE_HZ;
+
+    (void)arg;
+    clock_gettime(CLOCK_MONOTONIC, &next);
+
+    while (1)
+    {
+        next.tv_nsec += period;
+        while (next.tv_nsec >= (long)PORT_NS_PER_SEC)
+        {
+            next.tv_nsec -= PORT_NS_PER_SEC;
+            next.tv_sec ++;
+        }
+
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &next, NULL) == EINTR);
+
+        xPortSysTickHandler();
+    }
+
+    return NULL;
+}
+
+/************************************************** Port Section ************************************************/
+StackType_t *pxPortInitialiseStack(StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters)
+{
+    PortThread_TypeDef *thread = NULL;
+    StackType_t *top = NULL;
+
+    Port_Setup();
+
+    thread = calloc(1, sizeof(PortThread_TypeDef));
+    configASSERT(thread);
+
+    thread->code = pxCode;
+    thread->param = pvParameters;
+    sem_init(&thread->resume, 0, 0);
+
+    /* thread object pointer stored on top of the task stack */
+    top = (StackType_t *)(((uintptr_t)(pxTopOfStack - 1) - sizeof(thread)) & ~(uintptr_t)(portBYTE_ALIGNMENT - 1));
+    memcpy(top, &thread, sizeof(thread));
+
+    configASSERT(Port_Create_Thread(&thread->thread, Port_Task_Entry, thread));
+
+    return top;
+}
+
+BaseType_t xPortStartScheduler(void)
+{
+    PortThread_TypeDef *first = NULL;
+    pthread_t tick_thread;
+
+    Port_Setup();
+
+    /* interrupt turned off by vTaskStartScheduler, first task start with interrupt on */
+    if (Port_IrqMasked)
+        Port_IrqMasked = pdFALSE;
+    else
+        Port_Lock();
+
+    Port_CriticalNesting = 0;
+    Port_SchedulerRun = pdTRUE;
+
+    first = Port_Get_Thread(xTaskGetCurrentTaskHandle());
+    Port_Running = first;
+    sem_post(&first->resume);
+    Port_Unlock();
+
+    configASSERT(Port_Create_Thread(&tick_thread, Port_Tick_Entry, NULL));
+
+    while (sem_wait(&Port_End) != 0);
+
+    return pdFALSE;
+}
+
+void vPortEndScheduler(void)
+{
+    sem_post(&Port_End);
+}
+
+void vPortCleanUpTCB(void *pxTCB)
+{
+    PortThread_TypeDef *thread = Port_Get_Thread((TaskHandle_t)pxTCB);
+
+    /* thread parked forever after self delete, wake it up to exit */
+    if (thread && (thread != Port_Self))
+    {
+        thread->deleted = pdTRUE;
+        sem_post(&thread->resume);
+    }
+}
+
+/* systick isr, also referred by cmsis_os */
+void xPortSysTickHandler(void)
+{
+    SitlPort_Isr_Enter();
+    if (xTaskIncrementTick() != pdFALSE)
+        Port_IsrYield = pdTRUE;
+    SitlPort_Isr_Exit();
+}
+
+void vPortYield(void)
+{
+    if (Port_InIsr)
+    {
+        Port_IsrYield = pdTRUE;
+        return;
+    }
+
+    if (!Port_SchedulerRun)
+        return;
+
+    if (Port_CriticalNesting || Port_IrqMasked)
+    {
+        Port_YieldPending = pdTRUE;
+        return;
+    }
+
+    Port_Lock();
+    Port_Switch();
+}
+
+void vPortYieldFromISR(void)
+{
+    if (Port_InIsr)
+    {
+        Port_IsrYield = pdTRUE;
+        return;
+    }
+
+    vPortYield();
+}
+
+void vPortEnterCritical(void)
+{
+    if (Port_InIsr)
+        return;
+
+    if ((Port_CriticalNesting == 0) && !Port_IrqMasked)
+        Port_Lock();
+
+    Port_CriticalNesting ++;
+}
+
+void vPortExitCritical(void)
+{
+    if (Port_InIsr || (Port_CriticalNesting == 0))
+        return;
+
+    Port_CriticalNesting --;
+    if ((Port_CriticalNesting == 0) && !Port_IrqMasked)
+    {
+        if (Port_YieldPending && Port_SchedulerRun)
+        {
+            Port_YieldPending = pdFALSE;
+            Port_Switch();
+        }
+        else
+            Port_Unlock();
+    }
+}
+
+UBaseType_t xPortSetInterruptMask(void)
+{
+    if (Port_InIsr)
+        return 0;
+
+    vPortEnterCritical();
+    return 1;
+}
+
+void vPortClearInterruptMask(UBaseType_t uxMask)
+{
+    if (uxMask)
+        vPortExitCritical();
+}
+
+void vPortDisableInterrupts(void)
+{
+    if (Port_InIsr || Port_IrqMasked)
+        return;
+
+    if (Port_CriticalNesting == 0)
+        Port_Lock();
+
+    Port_IrqMasked = pdTRUE;
+}
+
+void vPortEnableInterrupts(void)
+{
+    if (Port_InIsr || !Port_IrqMasked)
+        return;
+
+    Port_IrqMasked = pdFALSE;
+    if (Port_CriticalNesting == 0)
+        Port_Unlock();
+}
+
+/************************************************** Simulation Section ************************************************/
+void SitlPort_Isr_Enter(void)
+{
+    PortThread_TypeDef *preempted = NULL;
+
+    /* nested isr run inside the outer one */
+    if (Port_InIsr)
+    {
+        Port_IsrNesting ++;
+        return;
+    }
+
+    Port_Setup();
+
+    /* raised by the running task inside its own critical section, lock already held by the caller */
+    if (Port_Self && (Port_Running == Port_Self) && (Port_CriticalNesting || Port_IrqMasked))
+    {
+        Port_IsrBorrowLock = pdTRUE;
+        Port_InIsr = pdTRUE;
+        Port_IsrNesting = 1;
+        Port_IsrPreempted = Port_Self;
+        return;
+    }
+
+    Port_Lock();
+    Port_InIsr = pdTRUE;
+    Port_IsrNesting = 1;
+
+    preempted = Port_Running;
+    if (preempted && (preempted != Port_Self))
+    {
+        Port_Running = NULL;
+        pthread_kill(preempted->thread, PORT_SUSPEND_SIGNAL);
+        while (sem_wait(&Port_SuspendAck) != 0);
+    }
+
+    Port_IsrPreempted = preempted;
+}
+
+void SitlPort_Isr_Exit(void)
+{
+    PortThread_TypeDef *self = Port_Self;
+    PortThread_TypeDef *next = Port_IsrPreempted;
+    int event = 0;
+
+    if (!Port_InIsr)
+        return;
+
+    if (-- Port_IsrNesting)
+        return;
+
+    /* switch request wait for the critical exit of the task, the same as a pended PendSV */
+    if (Port_IsrBorrowLock)
+    {
+        if (Port_IsrYield)
+            Port_YieldPending = pdTRUE;
+
+        Port_IsrYield = pdFALSE;
+        Port_IsrBorrowLock = pdFALSE;
+        Port_IsrPreempted = NULL;
+        Port_InIsr = pdFALSE;
+
+        sem_getvalue(&Port_IrqEvent, &event);
+        if (event <= 0)
+            sem_post(&Port_IrqEvent);
+        return;
+    }
+
+    if (Port_IsrYield && Port_SchedulerRun)
+    {
+        vTaskSwitchContext();
+        next = Port_Get_Thread(xTaskGetCurrentTaskHandle());
+    }
+
+    Port_IsrYield = pdFALSE;
+    Port_IsrPreempted = NULL;
+    Port_InIsr = pdFALSE;
+    Port_Running = next;
+
+    if (next && (next != self))
+        sem_post(&next->resume);
+
+    sem_getvalue(&Port_IrqEvent, &event);
+    if (event <= 0)
+        sem_post(&Port_IrqEvent);
+
+    Port_Unlock();
+
+    /* isr raised from a task thread and the task got switched out */
+    if (self && (next != self))
+        Port_Wait(self);
+}
+
+BaseType_t SitlPort_In_Isr(void)
+{
+    return Port_InIsr;
+}
+
+void SitlPort_Wait_Interrupt(uint32_t timeout_us)
+{
+    struct timespec until;
+    uint64_t ns = 0;
+
+    clock_gettime(CLOCK_REALTIME, &until);
+    ns = (uint64_t)until.tv_nsec + (uint64_t)timeout_us * 1000ULL;
+    until.tv_sec += ns / PORT_NS_PER_SEC;
+    until.tv_nsec = ns % PORT_NS_PER_SEC;
+
+    sem_timedwait(&Port_IrqEvent, &until);
+}
+
+uint64_t SitlPort_Get_Time(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * PORT_NS_PER_SEC + (uint64_t)now.tv_nsec;
+}
+
+BaseType_t SitlPort_Thread_Create(SitlPort_ThreadFunc func, void *arg)
+{
+    pthread_t thread;
+
+    Port_Setup();
+    return Port_Create_Thread(&thread, func, arg);
+}
+
+void SitlPort_End_Scheduler(void)
+{
+    vPortEndScheduler();
+}
+
+void SitlPort_Assert(const char *file, int line)
+{
+    fprintf(stderr, "[SITL] os assert at %s line %d\r\n", file, line);
+    abort();
+}
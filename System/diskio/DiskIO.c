@@ -118,6 +118,7 @@ DevCard_Obj_TypeDef DevTFCard_Obj = {
 };
 
 static const uint8_t DiskCard_NoneMBR_Label[] = {0xEB, 0x58, 0x90};
+static const uint8_t Disk_Zero_Frame[11] = {0}; /* compare source of an empty label or name */
 static uint8_t Disk_Card_SectionBuff[DISK_CARD_SECTION_SZIE] __attribute__((section(".Perph_Section"))) = {0};
 static uint8_t Disk_FileSection_DataCache[DISK_CARD_SECTION_SZIE] __attribute__((section(".Perph_Section"))) = {0};
 
@@ -278,7 +279,7 @@ static void Disk_ParseMBR(Disk_FATFileSys_TypeDef *FATObj)
     DevCard.read(&DevTFCard_Obj, DISK_CARD_MBR_SECTION, Disk_Card_SectionBuff, DISK_CARD_SECTION_SZIE, 1);
 
     if ((memcmp(DiskCard_NoneMBR_Label, Disk_Card_SectionBuff, sizeof(DiskCard_NoneMBR_Label)) == 0) ||
-        (memcmp(Disk_Card_SectionBuff, NULL, sizeof(DiskCard_NoneMBR_Label)) == 0))
+        (memcmp(Disk_Card_SectionBuff, Disk_Zero_Frame, sizeof(DiskCard_NoneMBR_Label)) == 0))
     {
         FATObj->has_mbr = false;
     }
@@ -1057,22 +1058,22 @@ static FATCluster_Addr Disk_WriteTo_TargetFFTable(Disk_FATFileSys_TypeDef *FATOb
     DiskFATCluster_State_List Cluster_State = Disk_GetClusterState(target_file_cluster);
     Disk_FFInfoTable_TypeDef FFInfo;
     Disk_FFAttr_TypeDef attr_tmp;
-    char file_name[12] = {'\0'};
-    char folder_name[9] = {'\0'};
+    char file_name[13] = {'\0'};
+    char folder_name[12] = {'\0'}; /* 8.3 frame output take 11 byte */
     char *name_tmp;
     bool state = false;
 
     if (type != Disk_DataType_Folder)
     {
         name_tmp = file_name;
-        memset(name_tmp, '\0', 12);
-        memcpy(name_tmp, name, 12);
+        memset(name_tmp, '\0', sizeof(file_name));
+        strncpy(name_tmp, name, 12);
     }
     else
     {
         name_tmp = folder_name;
-        memset(name_tmp, '\0', 9);
-        memcpy(name_tmp, name, 9);
+        memset(name_tmp, '\0', sizeof(folder_name));
+        strncpy(name_tmp, name, 9);
     }
 
     if (!Disk_Name_ConvertTo83Frame(name_tmp, name_tmp))
@@ -1656,7 +1657,7 @@ static Disk_Write_State Disk_WriteData_ToFile(Disk_FATFileSys_TypeDef *FATObj, D
     if ((FATObj == NULL) || (!FATObj->init) || (FileObj == NULL) || (p_data == NULL) || (len == 0) || (FileObj->cursor_pos > FATObj->BytePerSection))
         return Disk_Write_Error;
 
-    if (memcmp(FileObj->info.name, 0, sizeof(FileObj->info.name)) == 0)
+    if (memcmp(FileObj->info.name, Disk_Zero_Frame, sizeof(FileObj->info.name)) == 0)
         return Disk_Write_Error;
 
     if (FileObj->info.size == 0)
@@ -15,4 +15,23 @@ uint32_t Kernel_Get_SysTimer_TickUnit(void);
 uint32_t Kernel_Get_PeriodValue(void);
 uint32_t Kernel_TickVal_To_Us(void);
 
+/* cpu cache control and dma coherency maintenance, empty on core without data cache */
+bool Kernel_Cache_State(void);
+void Kernel_Cache_Ctl(bool state);
+void Kernel_DCache_Clean(void *addr, uint32_t size);
+void Kernel_DCache_Invalidate(void *addr, uint32_t size);
+
+/* cpu cycle counter */
+typedef struct
+{
+    uint32_t last;
+    uint32_t max;
+    uint32_t sum;
+    uint32_t cnt;
+} Kernel_CycleStatistic_TypeDef;
+
+uint32_t Kernel_Get_CycleCnt(void);
+uint32_t Kernel_Get_SysClock(void);
+void Kernel_CycleStatistic_Update(Kernel_CycleStatistic_TypeDef *stat, uint32_t start_cyc);
+
 #endif
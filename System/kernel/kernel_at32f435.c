@@ -1,6 +1,7 @@
 #include "at32f435_437.h"
 #include "at32f435_437_clock.h"
 #include <stdbool.h>
+#include "kernel.h"
 
 #define Kernel_DisableIRQ() __asm("cpsid i")
 #define Kernel_EnableIRQ() __asm("cpsie i")
@@ -11,6 +12,11 @@ bool Kernel_Init(void)
 {
     system_clock_config();
 
+    /* enable dwt cycle counter */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
     crm_clocks_freq_type crm_clocks_freq_struct = {0};
 
     /* enable tmr1 clock */
@@ -139,3 +145,49 @@ uint32_t Kernel_TickVal_To_Us(void)
 
     return 0;
 }
+
+uint32_t Kernel_Get_CycleCnt(void)
+{
+    return DWT->CYCCNT;
+}
+
+uint32_t Kernel_Get_SysClock(void)
+{
+    return system_core_clock;
+}
+
+void Kernel_CycleStatistic_Update(Kernel_CycleStatistic_TypeDef *stat, uint32_t start_cyc)
+{
+    if (stat == NULL)
+        return;
+
+    stat->last = Kernel_Get_CycleCnt() - start_cyc;
+    stat->sum += stat->last;
+    stat->cnt ++;
+
+    if (stat->last > stat->max)
+        stat->max = stat->last;
+}
+
+/* cortex-m4 have no data cache, flash access accelerate by at32 zero wait area */
+bool Kernel_Cache_State(void)
+{
+    return false;
+}
+
+void Kernel_Cache_Ctl(bool state)
+{
+    (void)state;
+}
+
+void Kernel_DCache_Clean(void *addr, uint32_t size)
+{
+    (void)addr;
+    (void)size;
+}
+
+void Kernel_DCache_Invalidate(void *addr, uint32_t size)
+{
+    (void)addr;
+    (void)size;
+}
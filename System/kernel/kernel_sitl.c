@@ -0,0 +1,147 @@
+/*
+ * coder: 8_B!T0
+ * Kernel Funciont portable for host simulation
+ * system timer and cycle counter are derived from host monotonic time
+ * tick unit keep the same scale as stm32h743 (9980 tick unit represent 1Ms), so the timing code above run unchanged
+ */
+
+#include "kernel.h"
+#include <stdlib.h>
+#include "FreeRTOS.h"
+
+#define KERNEL_SITL_PERIOD_VALUE 9980
+#define KERNEL_SITL_NS_PER_MS 1000000ULL
+#define KERNEL_SITL_CYCLE_CLOCK 1000000000UL /* cycle counter run in ns */
+
+static bool Kernel_TickTimer_Init = false;
+static bool Kernel_TickTimer_Enable = false;
+static uint32_t Kernel_TickTimer_Period = KERNEL_SITL_PERIOD_VALUE;
+
+bool Kernel_Init(void)
+{
+    Kernel_TickTimer_Period = KERNEL_SITL_PERIOD_VALUE;
+    Kernel_TickTimer_Init = true;
+    Kernel_TickTimer_Enable = true;
+
+    return true;
+}
+
+uint32_t Kernel_Get_CycleCnt(void)
+{
+    return (uint32_t)SitlPort_Get_Time();
+}
+
+uint32_t Kernel_Get_SysClock(void)
+{
+    return KERNEL_SITL_CYCLE_CLOCK;
+}
+
+void Kernel_CycleStatistic_Update(Kernel_CycleStatistic_TypeDef *stat, uint32_t start_cyc)
+{
+    if (stat == NULL)
+        return;
+
+    stat->last = Kernel_Get_CycleCnt() - start_cyc;
+    stat->sum += stat->last;
+    stat->cnt ++;
+
+    if (stat->last > stat->max)
+        stat->max = stat->last;
+}
+
+/* host memory is coherent, no cache maintenance needed */
+bool Kernel_Cache_State(void)
+{
+    return false;
+}
+
+void Kernel_Cache_Ctl(bool state)
+{
+    (void)state;
+}
+
+void Kernel_DCache_Clean(void *addr, uint32_t size)
+{
+    (void)addr;
+    (void)size;
+}
+
+void Kernel_DCache_Invalidate(void *addr, uint32_t size)
+{
+    (void)addr;
+    (void)size;
+}
+
+bool Kernel_EnableTimer_IRQ(void)
+{
+    if (Kernel_TickTimer_Init)
+    {
+        Kernel_TickTimer_Enable = true;
+        return true;
+    }
+
+    return false;
+}
+
+bool Kernel_DisableTimer_IRQ(void)
+{
+    if (Kernel_TickTimer_Init)
+    {
+        Kernel_TickTimer_Enable = false;
+        return true;
+    }
+
+    return false;
+}
+
+uint32_t Kernel_TickVal_To_Us(void)
+{
+    if (Kernel_TickTimer_Init)
+        return Kernel_TickTimer_Period / 1000;
+
+    return 0;
+}
+
+uint32_t Kernel_Get_PeriodValue(void)
+{
+    if (Kernel_TickTimer_Init)
+        return Kernel_TickTimer_Period;
+
+    return 0;
+}
+
+/* host time can not be trimmed, period is only recorded */
+bool Kernel_Set_PeriodValue(uint32_t value)
+{
+    if (Kernel_TickTimer_Init && value)
+    {
+        Kernel_TickTimer_Period = value;
+        return true;
+    }
+
+    return false;
+}
+
+uint32_t Kernel_Get_SysTimer_TickUnit(void)
+{
+    uint64_t ns_in_ms = 0;
+
+    if (Kernel_TickTimer_Init)
+    {
+        ns_in_ms = SitlPort_Get_Time() % KERNEL_SITL_NS_PER_MS;
+        return (uint32_t)((ns_in_ms * Kernel_TickTimer_Period) / KERNEL_SITL_NS_PER_MS);
+    }
+
+    return 0;
+}
+
+bool Kernel_Set_SysTimer_TickUnit(uint32_t unit)
+{
+    (void)unit;
+    return Kernel_TickTimer_Init;
+}
+
+void Kernel_reboot(void)
+{
+    exit(EXIT_SUCCESS);
+}
@@ -5,6 +5,7 @@
  */
 
 #include "kernel_stm32xxx.h"
+#include "kernel.h"
 #include "stm32h7xx_hal_rcc.h"
 #include "stm32h7xx_hal_pwr.h"
 #include "stm32h7xx_hal.h"
@@ -18,15 +19,169 @@ TIM_HandleTypeDef htim16;
 bool Kernel_TickTimer_Init = false;
 
 static bool KernelClock_Init(void);
+static void Kernel_MPU_Config(void);
+static void Kernel_CycleCnt_Init(void);
+static bool Kernel_Is_NoneCacheable(uint32_t addr, uint32_t size);
 bool HAL_BaseTick_Init(void);
 bool Kernel_BaseTick_Init(void);
 
 bool Kernel_Init(void)
 {
+    /* mpu must be set before data cache enabled, or dma buffer in perph section will be cached */
+    Kernel_MPU_Config();
+    Kernel_Cache_Ctl(true);
+    Kernel_CycleCnt_Init();
+
     HAL_Init();
     return HAL_BaseTick_Init() && KernelClock_Init() && Kernel_BaseTick_Init();
 }
 
+/*
+ * region 0: 0x60000000 ~ 0xDFFFFFFF no access, block speculative read on external memory bus
+ * region 1: perph section in D1 AXI sram, dma buffer, none cacheable
+ * region 2: D2 sram, none cacheable
+ * region 3: D3 sram, bdma buffer, none cacheable
+ * other area use default memory map, AXI sram write-back / write-allocate
+ */
+static void Kernel_MPU_Config(void)
+{
+    MPU_Region_InitTypeDef MPU_InitStruct = {0};
+
+    HAL_MPU_Disable();
+
+    MPU_InitStruct.Enable = MPU_REGION_ENABLE;
+    MPU_InitStruct.Number = MPU_REGION_NUMBER0;
+    MPU_InitStruct.BaseAddress = 0x00000000;
+    MPU_InitStruct.Size = MPU_REGION_SIZE_4GB;
+    MPU_InitStruct.SubRegionDisable = 0x87;
+    MPU_InitStruct.TypeExtField = MPU_TEX_LEVEL0;
+    MPU_InitStruct.AccessPermission = MPU_REGION_NO_ACCESS;
+    MPU_InitStruct.DisableExec = MPU_INSTRUCTION_ACCESS_DISABLE;
+    MPU_InitStruct.IsShareable = MPU_ACCESS_SHAREABLE;
+    MPU_InitStruct.IsCacheable = MPU_ACCESS_NOT_CACHEABLE;
+    MPU_InitStruct.IsBufferable = MPU_ACCESS_NOT_BUFFERABLE;
+    HAL_MPU_ConfigRegion(&MPU_InitStruct);
+
+    /* normal memory, none cacheable (TEX 1, C 0, B 0) */
+    MPU_InitStruct.SubRegionDisable = 0x00;
+    MPU_InitStruct.TypeExtField = MPU_TEX_LEVEL1;
+    MPU_InitStruct.AccessPermission = MPU_REGION_FULL_ACCESS;
+    MPU_InitStruct.IsShareable = MPU_ACCESS_NOT_SHAREABLE;
+
+    MPU_InitStruct.Number = MPU_REGION_NUMBER1;
+    MPU_InitStruct.BaseAddress = KERNEL_PERPH_SECTION_ADDR;
+    MPU_InitStruct.Size = MPU_REGION_SIZE_64KB;
+    HAL_MPU_ConfigRegion(&MPU_InitStruct);
+
+    MPU_InitStruct.Number = MPU_REGION_NUMBER2;
+    MPU_InitStruct.BaseAddress = KERNEL_D2_SRAM_ADDR;
+    MPU_InitStruct.Size = MPU_REGION_SIZE_512KB;
+    HAL_MPU_ConfigRegion(&MPU_InitStruct);
+
+    MPU_InitStruct.Number = MPU_REGION_NUMBER3;
+    MPU_InitStruct.BaseAddress = KERNEL_D3_SRAM_ADDR;
+    MPU_InitStruct.Size = MPU_REGION_SIZE_64KB;
+    HAL_MPU_ConfigRegion(&MPU_InitStruct);
+
+    HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
+}
+
+static void Kernel_CycleCnt_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t Kernel_Get_CycleCnt(void)
+{
+    return DWT->CYCCNT;
+}
+
+uint32_t Kernel_Get_SysClock(void)
+{
+    return HAL_RCC_GetSysClockFreq();
+}
+
+void Kernel_CycleStatistic_Update(Kernel_CycleStatistic_TypeDef *stat, uint32_t start_cyc)
+{
+    if (stat == NULL)
+        return;
+
+    stat->last = Kernel_Get_CycleCnt() - start_cyc;
+    stat->sum += stat->last;
+    stat->cnt ++;
+
+    if (stat->last > stat->max)
+        stat->max = stat->last;
+}
+
+bool Kernel_Cache_State(void)
+{
+    return (SCB->CCR & SCB_CCR_DC_Msk) && (SCB->CCR & SCB_CCR_IC_Msk);
+}
+
+/* data cache will be cleaned before disable, runtime switch is safe */
+void Kernel_Cache_Ctl(bool state)
+{
+    if (state)
+    {
+        if ((SCB->CCR & SCB_CCR_IC_Msk) == 0)
+            SCB_EnableICache();
+
+        if ((SCB->CCR & SCB_CCR_DC_Msk) == 0)
+            SCB_EnableDCache();
+    }
+    else
+    {
+        if (SCB->CCR & SCB_CCR_DC_Msk)
+            SCB_DisableDCache();
+
+        if (SCB->CCR & SCB_CCR_IC_Msk)
+            SCB_DisableICache();
+    }
+}
+
+/* buffer in tcm or none cacheable region need no maintenance */
+static bool Kernel_Is_NoneCacheable(uint32_t addr, uint32_t size)
+{
+    uint32_t end = addr + size;
+
+    if ((SCB->CCR & SCB_CCR_DC_Msk) == 0)
+        return true;
+
+    if (((addr >= KERNEL_DTCM_ADDR) && (end <= (KERNEL_DTCM_ADDR + KERNEL_DTCM_SIZE))) || \
+        (end <= (KERNEL_ITCM_ADDR + KERNEL_ITCM_SIZE)) || \
+        ((addr >= KERNEL_PERPH_SECTION_ADDR) && (end <= (KERNEL_PERPH_SECTION_ADDR + KERNEL_PERPH_SECTION_SIZE))) || \
+        ((addr >= KERNEL_D2_SRAM_ADDR) && (end <= (KERNEL_D2_SRAM_ADDR + KERNEL_D2_SRAM_SIZE))) || \
+        ((addr >= KERNEL_D3_SRAM_ADDR) && (end <= (KERNEL_D3_SRAM_ADDR + KERNEL_D3_SRAM_SIZE))))
+        return true;
+
+    return false;
+}
+
+/* write back cpu modified data before dma read it from memory (memory to peripheral) */
+void Kernel_DCache_Clean(void *addr, uint32_t size)
+{
+    if ((addr == NULL) || (size == 0) || Kernel_Is_NoneCacheable((uint32_t)addr, size))
+        return;
+
+    SCB_CleanDCache_by_Addr((uint32_t *)addr, size);
+}
+
+/*
+ * drop cache line for dma written memory (peripheral to memory)
+ * call it before dma start and after dma finished
+ * line is cleaned first, data shared the edge line with the buffer will not be lost
+ */
+void Kernel_DCache_Invalidate(void *addr, uint32_t size)
+{
+    if ((addr == NULL) || (size == 0) || Kernel_Is_NoneCacheable((uint32_t)addr, size))
+        return;
+
+    SCB_CleanInvalidateDCache_by_Addr((uint32_t *)addr, size);
+}
+
 /*
  * clock init
  * general by stm32cubemx
@@ -105,6 +260,11 @@ static bool KernelClock_Init(void)
 
     __HAL_RCC_GPIOH_CLK_ENABLE();
 
+    /* D2 sram used as dma heap region */
+    __HAL_RCC_D2SRAM1_CLK_ENABLE();
+    __HAL_RCC_D2SRAM2_CLK_ENABLE();
+    __HAL_RCC_D2SRAM3_CLK_ENABLE();
+
     return true;
 }
 
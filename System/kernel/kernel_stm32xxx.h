@@ -6,4 +6,18 @@
 #include <string.h>
 #include "stm32h7xx.h"
 
+/* memory map, keep in consist with STM32H743VIHx_FLASH.ld */
+#define KERNEL_DTCM_ADDR            0x20000000
+#define KERNEL_DTCM_SIZE            (128 * 1024)
+#define KERNEL_ITCM_ADDR            0x00000000
+#define KERNEL_ITCM_SIZE            (64 * 1024)
+
+/* dma accessable section, mark as none cacheable by mpu */
+#define KERNEL_PERPH_SECTION_ADDR   0x24070000
+#define KERNEL_PERPH_SECTION_SIZE   (64 * 1024)
+#define KERNEL_D2_SRAM_ADDR         0x30000000
+#define KERNEL_D2_SRAM_SIZE         (512 * 1024)   /* 288KB sram, mpu region size must be power of 2 */
+#define KERNEL_D3_SRAM_ADDR         0x38000000
+#define KERNEL_D3_SRAM_SIZE         (64 * 1024)
+
 #endif
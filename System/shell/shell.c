@@ -142,6 +142,15 @@ static const char *shellText[] =
  */
 static Shell *shellList[SHELL_MAX_NUMBER] = {NULL};
 
+#if SHELL_COMMAND_INDEX_MAX > 0
+/**
+ * @brief 命令索引, 所有shell共用同一命令表
+ */
+static unsigned short shellCommandIndex[SHELL_COMMAND_INDEX_MAX];
+static unsigned short shellCommandIndexCount = 0;
+static void *shellCommandIndexBase = NULL;
+#endif
+
 static void shellAdd(Shell *shell);
 static void shellWriteCommandLine(Shell *shell, unsigned char newline);
 static void shellWriteReturnValue(Shell *shell, int value);
@@ -151,6 +160,11 @@ ShellCommand *shellSeekCommand(Shell *shell,
                                const char *cmd,
                                ShellCommand *base,
                                unsigned short compareLength);
+static const char *shellGetCommandName(ShellCommand *command);
+#if SHELL_COMMAND_INDEX_MAX > 0
+static void shellBuildIndex(Shell *shell);
+static unsigned short shellIndexLowerBound(Shell *shell, const char *cmd, unsigned short compareLength);
+#endif
 
 /**
  * @brief shell 初始化
@@ -193,6 +207,10 @@ void shellInit(Shell *shell, char *buffer, unsigned short size)
     shell->commandList.count = shellCommandCount;
 #endif
 
+#if SHELL_COMMAND_INDEX_MAX > 0
+    shellBuildIndex(shell);
+#endif
+
     shellAdd(shell);
 
     shellSetUser(shell, shellSeekCommand(shell,
@@ -876,6 +894,90 @@ static void shellRemoveParamQuotes(Shell *shell)
     }
 }
 
+#if SHELL_COMMAND_INDEX_MAX > 0
+/**
+ * @brief shell 建立命令索引
+ *        按键不参与索引, 同名命令保持命令表中的先后顺序
+ *
+ * @param shell shell对象
+ */
+static void shellBuildIndex(Shell *shell)
+{
+    ShellCommand *base = (ShellCommand *)shell->commandList.base;
+    unsigned short count = 0;
+    unsigned short index;
+    short j;
+
+    if (shellCommandIndexBase != shell->commandList.base)
+    {
+        for (unsigned short i = 0; i < shell->commandList.count; i++)
+        {
+            if (base[i].attr.attrs.type == SHELL_TYPE_KEY)
+            {
+                continue;
+            }
+            if (count >= SHELL_COMMAND_INDEX_MAX)
+            {
+                count = 0;
+                break;
+            }
+            /* 插入排序, 只在初始化时执行一次 */
+            index = i;
+            for (j = count - 1; j >= 0; j--)
+            {
+                if (strcmp(shellGetCommandName(&base[shellCommandIndex[j]]),
+                           shellGetCommandName(&base[index])) <= 0)
+                {
+                    break;
+                }
+                shellCommandIndex[j + 1] = shellCommandIndex[j];
+            }
+            shellCommandIndex[j + 1] = index;
+            count++;
+        }
+        shellCommandIndexCount = count;
+        shellCommandIndexBase = shell->commandList.base;
+    }
+
+    shell->commandList.index = shellCommandIndexCount ? shellCommandIndex : NULL;
+    shell->commandList.indexCount = shellCommandIndexCount;
+}
+
+/**
+ * @brief shell 索引二分查找
+ *
+ * @param shell shell对象
+ * @param cmd 命令
+ * @param compareLength 匹配字符串长度, 为0时整串比较
+ * @return unsigned short 第一个不小于cmd的索引位置
+ */
+static unsigned short shellIndexLowerBound(Shell *shell, const char *cmd, unsigned short compareLength)
+{
+    ShellCommand *base = (ShellCommand *)shell->commandList.base;
+    unsigned short low = 0;
+    unsigned short high = shell->commandList.indexCount;
+    unsigned short mid;
+    const char *name;
+    int ret;
+
+    while (low < high)
+    {
+        mid = low + (high - low) / 2;
+        name = shellGetCommandName(&base[shell->commandList.index[mid]]);
+        ret = compareLength ? strncmp(name, cmd, compareLength) : strcmp(name, cmd);
+        if (ret < 0)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+#endif
+
 /**
  * @brief shell匹配命令
  *
@@ -894,6 +996,28 @@ ShellCommand *shellSeekCommand(Shell *shell,
     int ret;
     unsigned short count = shell->commandList.count -
                            ((int)base - (int)shell->commandList.base) / sizeof(ShellCommand);
+#if SHELL_COMMAND_INDEX_MAX > 0
+    if (shell->commandList.index && base == shell->commandList.base)
+    {
+        ShellCommand *command;
+        for (unsigned short i = shellIndexLowerBound(shell, cmd, compareLength);
+             i < shell->commandList.indexCount; i++)
+        {
+            command = &base[shell->commandList.index[i]];
+            name = shellGetCommandName(command);
+            ret = compareLength ? strncmp(name, cmd, compareLength) : strcmp(name, cmd);
+            if (ret != 0)
+            {
+                break;
+            }
+            if (shellCheckPermission(shell, command) == 0)
+            {
+                return command;
+            }
+        }
+        return NULL;
+    }
+#endif
     for (unsigned short i = 0; i < count; i++)
     {
         if (base[i].attr.attrs.type == SHELL_TYPE_KEY || shellCheckPermission(shell, &base[i]) != 0)
@@ -1397,6 +1521,9 @@ void shellTab(Shell *shell)
     unsigned short lastMatchIndex = 0;
     unsigned short matchNum = 0;
     unsigned short length;
+    unsigned short start = 0;
+    unsigned short end;
+    unsigned short i;
 
     if (shell->parser.length == 0)
     {
@@ -1407,8 +1534,31 @@ void shellTab(Shell *shell)
     {
         shell->parser.buffer[shell->parser.length] = 0;
         ShellCommand *base = (ShellCommand *)shell->commandList.base;
-        for (short i = 0; i < shell->commandList.count; i++)
+        end = shell->commandList.count;
+#if SHELL_COMMAND_INDEX_MAX > 0
+        /* 有索引时只遍历前缀匹配的区间 */
+        if (shell->commandList.index)
         {
+            start = shellIndexLowerBound(shell, shell->parser.buffer, shell->parser.length);
+            for (end = start; end < shell->commandList.indexCount; end++)
+            {
+                if (strncmp(shellGetCommandName(&base[shell->commandList.index[end]]),
+                            shell->parser.buffer, shell->parser.length) != 0)
+                {
+                    break;
+                }
+            }
+        }
+#endif
+        for (unsigned short n = start; n < end; n++)
+        {
+            i = n;
+#if SHELL_COMMAND_INDEX_MAX > 0
+            if (shell->commandList.index)
+            {
+                i = shell->commandList.index[n];
+            }
+#endif
             if (shellCheckPermission(shell, &base[i]) == 0 && shellStringCompare(shell->parser.buffer,
                                                                                  (char *)shellGetCommandName(&base[i])) == shell->parser.length)
             {
@@ -331,6 +331,8 @@ typedef struct shell_def
     {
         void *base;           /**< 命令表基址 */
         unsigned short count; /**< 命令数量 */
+        unsigned short *index;      /**< 按命令名排序的索引, 为NULL时线性查找 */
+        unsigned short indexCount;  /**< 索引数量 */
     } commandList;
     struct
     {
@@ -99,6 +99,13 @@
  */
 #define SHELL_DOUBLE_CLICK_TIME 200
 
+/**
+ * @brief 命令索引最大数量
+ *        shell初始化时按命令名排序建立索引, 命令查找和tab补全使用二分查找
+ *        为0或命令数量超过此值时使用线性查找
+ */
+#define SHELL_COMMAND_INDEX_MAX 128
+
 /**
  * @brief 管理的最大shell数量
  */
@@ -0,0 +1,710 @@
+/*
+ * Auther: 8_B!T0
+ * WARNING: NOT ALL CIRCUMSTANCES BEEN TESTED
+ *
+ * Bref: log structured flight data recorder on external nor flash for the board without sd card
+ *       flash region behind parameter section is split into 4K append only segment and used as a ring
+ *       oldest segment is recycled first so every sector get the same erase count
+ *       next segment is erased in background while current one is programmed page by page
+ */
+#include "Blackbox.h"
+#include "shell_port.h"
+
+#define To_Blackbox_DevApi(x) To_DevW25Qxx_API(x)
+#define To_Blackbox_DevObj(x) To_DevW25Qxx_OBJ(x)
+
+#define Blackbox_SegAddr(x) (Blackbox_Monitor.base_addr + (x) * BLACKBOX_SEGMENT_SIZE)
+#define Blackbox_AddrToSeg(x) (((x) - Blackbox_Monitor.base_addr) / BLACKBOX_SEGMENT_SIZE)
+#define Blackbox_NxtSeg(x) (((x) + 1) % Blackbox_Monitor.seg_num)
+
+/* internal vriable */
+static Blackbox_Monitor_TypeDef Blackbox_Monitor = {
+    .state = Blackbox_State_None,
+};
+
+/* program side segment, only touched by process */
+static uint32_t Blackbox_ProgSeg = 0;
+
+/* internal function */
+static bool Blackbox_Read_SegHeader(uint32_t seg, Blackbox_SegHeader_TypeDef *p_header);
+static bool Blackbox_Read(uint32_t addr, uint8_t *p_data, uint32_t len);
+static bool Blackbox_Erase_Seg(uint32_t seg);
+static bool Blackbox_Check_SegHeader(const Blackbox_SegHeader_TypeDef *p_header);
+static void Blackbox_Recycle(uint32_t seg);
+static void Blackbox_Flush(void);
+static void Blackbox_Stop_Proc(void);
+static void Blackbox_Req_Proc(void);
+static bool Blackbox_Request(Blackbox_Request_List req, uint32_t time_out);
+static bool Blackbox_Program_Step(void);
+static bool Blackbox_Issue_Op(void);
+static bool Blackbox_Lock(uint32_t time_out);
+static void Blackbox_Unlock(void);
+
+/* external function */
+static bool Blackbox_Init(Storage_ExtFLashDevObj_TypeDef *ExtDev, uint32_t base_addr);
+static bool Blackbox_Start(void);
+static bool Blackbox_Stop(void);
+static uint32_t Blackbox_Write(uint8_t *p_data, uint32_t len);
+static void Blackbox_Process(void);
+static bool Blackbox_Ready(void);
+
+Blackbox_TypeDef Blackbox = {
+    .init = Blackbox_Init,
+    .start = Blackbox_Start,
+    .stop = Blackbox_Stop,
+    .write = Blackbox_Write,
+    .process = Blackbox_Process,
+    .ready = Blackbox_Ready,
+};
+
+static bool Blackbox_Init(Storage_ExtFLashDevObj_TypeDef *ExtDev, uint32_t base_addr)
+{
+    DevW25Qxx_DeviceInfo_TypeDef info;
+    Blackbox_SegHeader_TypeDef header;
+
+    memset(&Blackbox_Monitor, 0, sizeof(Blackbox_Monitor));
+    Blackbox_Monitor.state = Blackbox_State_None;
+
+    if ((ExtDev == NULL) || \
+        (ExtDev->chip_type != Storage_ChipType_W25Qxx) || \
+        (ExtDev->dev_obj == NULL) || \
+        (ExtDev->dev_api == NULL))
+        return false;
+
+    info = To_Blackbox_DevApi(ExtDev->dev_api)->info(To_Blackbox_DevObj(ExtDev->dev_obj));
+    if ((info.flash_size == 0) || \
+        (info.page_size != BLACKBOX_PAGE_SIZE) || \
+        (info.subsector_size != BLACKBOX_SEGMENT_SIZE) || \
+        (base_addr % BLACKBOX_SEGMENT_SIZE) || \
+        (base_addr < info.start_addr) || \
+        ((base_addr + BLACKBOX_SEGMENT_SIZE * 2) > (info.start_addr + info.flash_size)))
+        return false;
+
+    Blackbox_Monitor.ext_dev = ExtDev;
+    Blackbox_Monitor.base_addr = base_addr;
+    Blackbox_Monitor.seg_num = (info.start_addr + info.flash_size - base_addr) / BLACKBOX_SEGMENT_SIZE;
+
+    /* scan segment header, find the newest and the oldest segment left by last power up */
+    for (uint32_t i = 0; i < Blackbox_Monitor.seg_num; i++)
+    {
+        if (!Blackbox_Read_SegHeader(i, &header))
+            return false;
+
+        if (!Blackbox_Check_SegHeader(&header))
+            continue;
+
+        if (!Blackbox_Monitor.used || (header.seq > Blackbox_Monitor.head_seq))
+        {
+            Blackbox_Monitor.head_seq = header.seq;
+            Blackbox_Monitor.head_seg = i;
+            Blackbox_Monitor.session = header.session;
+        }
+
+        if (!Blackbox_Monitor.used || (header.seq < Blackbox_Monitor.oldest_seq))
+        {
+            Blackbox_Monitor.oldest_seq = header.seq;
+            Blackbox_Monitor.oldest_seg = i;
+        }
+
+        Blackbox_Monitor.used = true;
+    }
+
+    Blackbox_Monitor.state = Blackbox_State_Ready;
+    return true;
+}
+
+/* ready also cover the pause between a dump stop and its resume, write drop data in that window */
+static bool Blackbox_Ready(void)
+{
+    return (Blackbox_Monitor.state == Blackbox_State_Ready) || (Blackbox_Monitor.state == Blackbox_State_Logging);
+}
+
+/* every start open a new session on a new segment */
+static bool Blackbox_Start(void)
+{
+    uint32_t seg = 0;
+
+    if (Blackbox_Monitor.state != Blackbox_State_Ready)
+        return false;
+
+    if (Blackbox_Monitor.used)
+    {
+        seg = Blackbox_NxtSeg(Blackbox_Monitor.head_seg);
+        Blackbox_Monitor.session ++;
+    }
+
+    /* first segment erase in blocking mode, after this erase run in background */
+    Blackbox_Recycle(seg);
+    if (!Blackbox_Erase_Seg(seg))
+    {
+        Blackbox_Monitor.state = Blackbox_State_Halt;
+        return false;
+    }
+
+    if (Blackbox_Monitor.used)
+    {
+        Blackbox_Monitor.head_seq ++;
+    }
+    else
+    {
+        Blackbox_Monitor.head_seq = 0;
+        Blackbox_Monitor.oldest_seq = 0;
+        Blackbox_Monitor.oldest_seg = seg;
+        Blackbox_Monitor.used = true;
+    }
+
+    Blackbox_Monitor.head_seg = seg;
+    Blackbox_Monitor.statistic.erase_cnt ++;
+    Blackbox_ProgSeg = seg;
+    Blackbox_Monitor.nxt_seg_erased = false;
+
+    Blackbox_Monitor.cache_in = 0;
+    Blackbox_Monitor.cache_out = 0;
+    Blackbox_Monitor.cache_cnt = 0;
+    memset(Blackbox_Monitor.cache, BLACKBOX_DEFAULT_DATA, sizeof(Blackbox_Monitor.cache));
+    for (uint8_t i = 0; i < BLACKBOX_CACHE_PAGE_NUM; i++)
+        Blackbox_Monitor.cache[i].size = 0;
+
+    /* header of the first segment is pushed in by write */
+    Blackbox_Monitor.fill_addr = Blackbox_SegAddr(seg);
+    Blackbox_Monitor.state = Blackbox_State_Logging;
+
+    return true;
+}
+
+/* called from any task, wait until log task drained the cache into flash */
+static bool Blackbox_Stop(void)
+{
+    return Blackbox_Request(Blackbox_Req_Stop, BLACKBOX_REQ_TIMEOUT);
+}
+
+/* hand the request over to the log task and wait for it, false on time out or when other request pending */
+static bool Blackbox_Request(Blackbox_Request_List req, uint32_t time_out)
+{
+    uint32_t time_start = SrvOsCommon.get_os_ms();
+    uint8_t none = Blackbox_Req_None;
+
+    if ((Blackbox_Monitor.state == Blackbox_State_None) || \
+        !__atomic_compare_exchange_n(&Blackbox_Monitor.req, &none, (uint8_t)req, false, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        return false;
+
+    while (__atomic_load_n(&Blackbox_Monitor.req, __ATOMIC_ACQUIRE) != Blackbox_Req_None)
+    {
+        if ((SrvOsCommon.get_os_ms() - time_start) > time_out)
+            return false;
+
+        SrvOsCommon.delay_ms(10);
+    }
+
+    return Blackbox_Monitor.req_result;
+}
+
+/* log task side, ring state is only changed in here and in process */
+static void Blackbox_Req_Proc(void)
+{
+    bool logging = (Blackbox_Monitor.state == Blackbox_State_Logging);
+    uint32_t seg_cnt = 0;
+    uint32_t seg = 0;
+    bool state = true;
+
+    Blackbox_Stop_Proc();
+    Blackbox_Monitor.req_seg = 0;
+
+    if (Blackbox_Monitor.state != Blackbox_State_Ready)
+    {
+        state = false;
+    }
+    else if (Blackbox_Monitor.req == Blackbox_Req_Start)
+    {
+        state = Blackbox_Start();
+    }
+    else if ((Blackbox_Monitor.req == Blackbox_Req_Erase) && Blackbox_Monitor.used)
+    {
+        seg_cnt = Blackbox_Monitor.head_seq - Blackbox_Monitor.oldest_seq + 1;
+        seg = Blackbox_Monitor.oldest_seg;
+
+        for (uint32_t i = 0; i < seg_cnt; i++)
+        {
+            /* lock segment by segment, storage still get the bus between two erase */
+            if (!Blackbox_Erase_Seg(seg))
+            {
+                state = false;
+                break;
+            }
+
+            Blackbox_Monitor.req_seg ++;
+            seg = Blackbox_NxtSeg(seg);
+        }
+
+        if (state)
+        {
+            Blackbox_Monitor.used = false;
+            Blackbox_Monitor.session = 0;
+            Blackbox_Monitor.head_seg = 0;
+            Blackbox_Monitor.head_seq = 0;
+            Blackbox_Monitor.oldest_seg = 0;
+            Blackbox_Monitor.oldest_seq = 0;
+        }
+    }
+
+    /* erase keep the running session going on a new segment, stop is resumed by its own start request */
+    if ((Blackbox_Monitor.req == Blackbox_Req_Erase) && logging && (Blackbox_Monitor.state == Blackbox_State_Ready))
+        state &= Blackbox_Start();
+
+    Blackbox_Monitor.req_result = state;
+    __atomic_store_n(&Blackbox_Monitor.req, Blackbox_Req_None, __ATOMIC_RELEASE);
+}
+
+/* flush all cached data into flash and wait until chip idle, halt when chip or bus never come back */
+static void Blackbox_Stop_Proc(void)
+{
+    uint32_t time_start = SrvOsCommon.get_os_ms();
+
+    if (Blackbox_Monitor.state != Blackbox_State_Logging)
+        return;
+
+    /* block write and background process, drain cache here */
+    Blackbox_Monitor.state = Blackbox_State_Flush;
+    Blackbox_Flush();
+
+    while (Blackbox_Monitor.cache_cnt && (Blackbox_Monitor.state == Blackbox_State_Flush))
+    {
+        if ((SrvOsCommon.get_os_ms() - time_start) > BLACKBOX_REQ_TIMEOUT)
+        {
+            Blackbox_Monitor.state = Blackbox_State_Halt;
+            return;
+        }
+
+        Blackbox_Program_Step();
+        SrvOsCommon.delay_ms(1);
+    }
+
+    if (Blackbox_Monitor.state == Blackbox_State_Halt)
+        return;
+
+    while (true)
+    {
+        if ((SrvOsCommon.get_os_ms() - time_start) > BLACKBOX_REQ_TIMEOUT)
+        {
+            Blackbox_Monitor.state = Blackbox_State_Halt;
+            return;
+        }
+
+        if (Blackbox_Lock(ExtFlash_BusLock_TimeOut))
+        {
+            if (To_Blackbox_DevApi(Blackbox_Monitor.ext_dev->dev_api)->busy(To_Blackbox_DevObj(Blackbox_Monitor.ext_dev->dev_obj)) != DevW25Qxx_Busy)
+            {
+                Blackbox_Unlock();
+                break;
+            }
+
+            Blackbox_Unlock();
+        }
+
+        SrvOsCommon.delay_ms(1);
+    }
+
+    Blackbox_Monitor.state = Blackbox_State_Ready;
+}
+
+/*
+ * push data into page cache, data is dropped when cache is full
+ * return the byte count accepted
+ */
+static uint32_t Blackbox_Write(uint8_t *p_data, uint32_t len)
+{
+    Blackbox_CachePage_TypeDef *p_page = NULL;
+    Blackbox_SegHeader_TypeDef header;
+    uint32_t accept = 0;
+    uint16_t cpy_size = 0;
+
+    if ((p_data == NULL) || (len == 0))
+        return 0;
+
+    if (Blackbox_Monitor.state != Blackbox_State_Logging)
+    {
+        /* paused by dump, counted so the gap show up in the statistic */
+        if (Blackbox_Monitor.state == Blackbox_State_Ready)
+            Blackbox_Monitor.statistic.drop_byte += len;
+
+        return 0;
+    }
+
+    while (accept < len)
+    {
+        if (Blackbox_Monitor.cache_cnt >= BLACKBOX_CACHE_PAGE_NUM)
+        {
+            Blackbox_Monitor.statistic.drop_byte += len - accept;
+            break;
+        }
+
+        p_page = &Blackbox_Monitor.cache[Blackbox_Monitor.cache_in];
+
+        if (p_page->size == 0)
+        {
+            p_page->addr = Blackbox_Monitor.fill_addr;
+
+            /* segment start, put segment header in front of the payload */
+            if ((p_page->addr % BLACKBOX_SEGMENT_SIZE) == 0)
+            {
+                if (Blackbox_AddrToSeg(p_page->addr) != Blackbox_Monitor.head_seg)
+                {
+                    Blackbox_Monitor.head_seg = Blackbox_AddrToSeg(p_page->addr);
+                    Blackbox_Monitor.head_seq ++;
+                }
+
+                header.tag = BLACKBOX_SEGMENT_TAG;
+                header.seq = Blackbox_Monitor.head_seq;
+                header.session = Blackbox_Monitor.session;
+                header.crc16 = (uint16_t)Common_CRC16((uint8_t *)&header, offsetof(Blackbox_SegHeader_TypeDef, crc16));
+
+                memcpy(p_page->buf, &header, BLACKBOX_SEGMENT_HEADER_SIZE);
+                p_page->size = BLACKBOX_SEGMENT_HEADER_SIZE;
+            }
+        }
+
+        cpy_size = BLACKBOX_PAGE_SIZE - p_page->size;
+        if (cpy_size > (len - accept))
+            cpy_size = len - accept;
+
+        memcpy(&p_page->buf[p_page->size], &p_data[accept], cpy_size);
+        p_page->size += cpy_size;
+        accept += cpy_size;
+
+        /* page full commit to flash */
+        if (p_page->size == BLACKBOX_PAGE_SIZE)
+        {
+            Blackbox_Monitor.fill_addr = p_page->addr + BLACKBOX_PAGE_SIZE;
+            if (Blackbox_Monitor.fill_addr >= Blackbox_SegAddr(Blackbox_Monitor.seg_num))
+                Blackbox_Monitor.fill_addr = Blackbox_Monitor.base_addr;
+
+            Blackbox_Monitor.cache_in = (Blackbox_Monitor.cache_in + 1) % BLACKBOX_CACHE_PAGE_NUM;
+            Blackbox_Monitor.cache_cnt ++;
+
+            if (Blackbox_Monitor.cache_cnt > Blackbox_Monitor.statistic.cache_max)
+                Blackbox_Monitor.statistic.cache_max = Blackbox_Monitor.cache_cnt;
+        }
+    }
+
+    Blackbox_Monitor.statistic.log_byte += accept;
+    return accept;
+}
+
+/*
+ * call periodically in log task
+ * only yield to other task for chip busy when page cache start to pile up
+ */
+static void Blackbox_Process(void)
+{
+    if (__atomic_load_n(&Blackbox_Monitor.req, __ATOMIC_ACQUIRE) != Blackbox_Req_None)
+    {
+        Blackbox_Req_Proc();
+        return;
+    }
+
+    for (uint8_t i = 0; (i < BLACKBOX_PROCESS_OP_MAX) && (Blackbox_Monitor.state == Blackbox_State_Logging); i++)
+    {
+        if (!Blackbox_Program_Step())
+        {
+            if (Blackbox_Monitor.cache_cnt < (BLACKBOX_CACHE_PAGE_NUM / 4))
+                break;
+
+            SrvOsCommon.delay_ms(1);
+        }
+    }
+}
+
+/*
+ * issue one flash operation, return false when chip is busy or nothing to do
+ * never wait for the bus, storage holding it count as chip busy
+ */
+static bool Blackbox_Program_Step(void)
+{
+    bool state = false;
+
+    if (!Blackbox_Lock(0))
+    {
+        Blackbox_Monitor.statistic.busy_cnt ++;
+        return false;
+    }
+
+    state = Blackbox_Issue_Op();
+    Blackbox_Unlock();
+
+    return state;
+}
+
+static bool Blackbox_Issue_Op(void)
+{
+    DevW25Qxx_TypeDef *p_api = NULL;
+    DevW25QxxObj_TypeDef *p_dev = NULL;
+    Blackbox_CachePage_TypeDef *p_page = NULL;
+    uint32_t seg = 0;
+
+    p_api = To_Blackbox_DevApi(Blackbox_Monitor.ext_dev->dev_api);
+    p_dev = To_Blackbox_DevObj(Blackbox_Monitor.ext_dev->dev_obj);
+
+    if (p_api->busy(p_dev) != DevW25Qxx_Ok)
+    {
+        Blackbox_Monitor.statistic.busy_cnt ++;
+        return false;
+    }
+
+    /* pre-erase next segment */
+    if (!Blackbox_Monitor.nxt_seg_erased)
+    {
+        Blackbox_Recycle(Blackbox_NxtSeg(Blackbox_ProgSeg));
+
+        if (p_api->erase_sector_nowait(p_dev, Blackbox_SegAddr(Blackbox_NxtSeg(Blackbox_ProgSeg))) != DevW25Qxx_Ok)
+        {
+            Blackbox_Monitor.state = Blackbox_State_Halt;
+            return false;
+        }
+
+        Blackbox_Monitor.nxt_seg_erased = true;
+        Blackbox_Monitor.statistic.erase_cnt ++;
+        return true;
+    }
+
+    if (Blackbox_Monitor.cache_cnt == 0)
+        return false;
+
+    p_page = &Blackbox_Monitor.cache[Blackbox_Monitor.cache_out];
+    seg = Blackbox_AddrToSeg(p_page->addr);
+
+    /* cache hold one segment at most, page here is either in current or in the erased next segment */
+    if (seg != Blackbox_ProgSeg)
+    {
+        Blackbox_ProgSeg = seg;
+        Blackbox_Monitor.nxt_seg_erased = false;
+    }
+
+    if (p_api->write_page_nowait(p_dev, p_page->addr, p_page->buf, BLACKBOX_PAGE_SIZE) != DevW25Qxx_Ok)
+    {
+        Blackbox_Monitor.state = Blackbox_State_Halt;
+        return false;
+    }
+
+    memset(p_page->buf, BLACKBOX_DEFAULT_DATA, BLACKBOX_PAGE_SIZE);
+    p_page->size = 0;
+    Blackbox_Monitor.cache_out = (Blackbox_Monitor.cache_out + 1) % BLACKBOX_CACHE_PAGE_NUM;
+    Blackbox_Monitor.cache_cnt --;
+    Blackbox_Monitor.statistic.page_cnt ++;
+
+    return true;
+}
+
+/* pad current page with default data and commit it */
+static void Blackbox_Flush(void)
+{
+    Blackbox_CachePage_TypeDef *p_page = &Blackbox_Monitor.cache[Blackbox_Monitor.cache_in];
+
+    if ((p_page->size == 0) || (Blackbox_Monitor.cache_cnt >= BLACKBOX_CACHE_PAGE_NUM))
+        return;
+
+    memset(&p_page->buf[p_page->size], BLACKBOX_DEFAULT_DATA, BLACKBOX_PAGE_SIZE - p_page->size);
+    p_page->size = BLACKBOX_PAGE_SIZE;
+
+    Blackbox_Monitor.fill_addr = p_page->addr + BLACKBOX_PAGE_SIZE;
+    if (Blackbox_Monitor.fill_addr >= Blackbox_SegAddr(Blackbox_Monitor.seg_num))
+        Blackbox_Monitor.fill_addr = Blackbox_Monitor.base_addr;
+
+    Blackbox_Monitor.cache_in = (Blackbox_Monitor.cache_in + 1) % BLACKBOX_CACHE_PAGE_NUM;
+    Blackbox_Monitor.cache_cnt ++;
+}
+
+/* segment is going to be erased, move oldest segment forward when ring wrapped */
+static void Blackbox_Recycle(uint32_t seg)
+{
+    if (Blackbox_Monitor.used && \
+        (seg == Blackbox_Monitor.oldest_seg) && \
+        (Blackbox_Monitor.oldest_seq != Blackbox_Monitor.head_seq))
+    {
+        Blackbox_Monitor.oldest_seg = Blackbox_NxtSeg(Blackbox_Monitor.oldest_seg);
+        Blackbox_Monitor.oldest_seq ++;
+    }
+}
+
+static bool Blackbox_Read_SegHeader(uint32_t seg, Blackbox_SegHeader_TypeDef *p_header)
+{
+    return (p_header && (seg < Blackbox_Monitor.seg_num) && \
+            Blackbox_Read(Blackbox_SegAddr(seg), (uint8_t *)p_header, BLACKBOX_SEGMENT_HEADER_SIZE));
+}
+
+static bool Blackbox_Read(uint32_t addr, uint8_t *p_data, uint32_t len)
+{
+    DevW25Qxx_Error_List state = DevW25Qxx_Error;
+
+    if (!Blackbox_Lock(ExtFlash_BusLock_TimeOut))
+        return false;
+
+    state = To_Blackbox_DevApi(Blackbox_Monitor.ext_dev->dev_api)->read(To_Blackbox_DevObj(Blackbox_Monitor.ext_dev->dev_obj), addr, p_data, len);
+    Blackbox_Unlock();
+
+    return (state == DevW25Qxx_Ok);
+}
+
+/* blocking erase */
+static bool Blackbox_Erase_Seg(uint32_t seg)
+{
+    DevW25Qxx_Error_List state = DevW25Qxx_Error;
+
+    if (!Blackbox_Lock(ExtFlash_BusLock_TimeOut))
+        return false;
+
+    state = To_Blackbox_DevApi(Blackbox_Monitor.ext_dev->dev_api)->erase_sector(To_Blackbox_DevObj(Blackbox_Monitor.ext_dev->dev_obj), Blackbox_SegAddr(seg));
+    Blackbox_Unlock();
+
+    return (state == DevW25Qxx_Ok);
+}
+
+/* chip is shared with storage, lock come with the external flash object */
+static bool Blackbox_Lock(uint32_t time_out)
+{
+    if (Blackbox_Monitor.ext_dev->bus_lock == NULL)
+        return true;
+
+    return (osMutexWait(Blackbox_Monitor.ext_dev->bus_lock, time_out) == osOK);
+}
+
+static void Blackbox_Unlock(void)
+{
+    if (Blackbox_Monitor.ext_dev->bus_lock)
+        osMutexRelease(Blackbox_Monitor.ext_dev->bus_lock);
+}
+
+static bool Blackbox_Check_SegHeader(const Blackbox_SegHeader_TypeDef *p_header)
+{
+    if ((p_header == NULL) || (p_header->tag != BLACKBOX_SEGMENT_TAG))
+        return false;
+
+    if (p_header->crc16 != (uint16_t)Common_CRC16((const uint8_t *)p_header, offsetof(Blackbox_SegHeader_TypeDef, crc16)))
+        return false;
+
+    return true;
+}
+
+/************************************************** Shell Section ************************************************/
+static void Blackbox_Show_Info(void)
+{
+    Shell *shell_obj = Shell_GetInstence();
+
+    if (shell_obj == NULL)
+        return;
+
+    shellPrint(shell_obj, "\t[Blackbox]\r\n");
+    if (Blackbox_Monitor.state == Blackbox_State_None)
+    {
+        shellPrint(shell_obj, "\t[Unavaliable]\r\n");
+        return;
+    }
+
+    shellPrint(shell_obj, "\tstate         : %d\r\n", Blackbox_Monitor.state);
+    shellPrint(shell_obj, "\tbase address  : 0x%08x\r\n", Blackbox_Monitor.base_addr);
+    shellPrint(shell_obj, "\tsegment num   : %d\r\n", Blackbox_Monitor.seg_num);
+
+    if (Blackbox_Monitor.used)
+    {
+        shellPrint(shell_obj, "\tsession       : %d\r\n", Blackbox_Monitor.session);
+        shellPrint(shell_obj, "\toldest        : seg %d seq %d\r\n", Blackbox_Monitor.oldest_seg, Blackbox_Monitor.oldest_seq);
+        shellPrint(shell_obj, "\tnewest        : seg %d seq %d\r\n", Blackbox_Monitor.head_seg, Blackbox_Monitor.head_seq);
+        shellPrint(shell_obj, "\tlog size      : %d byte\r\n", (Blackbox_Monitor.head_seq - Blackbox_Monitor.oldest_seq + 1) * BLACKBOX_SEGMENT_SIZE);
+    }
+    else
+        shellPrint(shell_obj, "\t[Empty]\r\n");
+
+    shellPrint(shell_obj, "\tlog byte      : %d\r\n", Blackbox_Monitor.statistic.log_byte);
+    shellPrint(shell_obj, "\tdrop byte     : %d\r\n", Blackbox_Monitor.statistic.drop_byte);
+    shellPrint(shell_obj, "\tpage program  : %d\r\n", Blackbox_Monitor.statistic.page_cnt);
+    shellPrint(shell_obj, "\tsector erase  : %d\r\n", Blackbox_Monitor.statistic.erase_cnt);
+    shellPrint(shell_obj, "\tbusy skip     : %d\r\n", Blackbox_Monitor.statistic.busy_cnt);
+    shellPrint(shell_obj, "\tcache max use : %d / %d\r\n", Blackbox_Monitor.statistic.cache_max, BLACKBOX_CACHE_PAGE_NUM);
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Blackbox_Show_Info, Blackbox_Show_Info, Blackbox Info);
+
+/*
+ * stop logging and stream raw segment (header included) from the oldest to the newest, then resume logging
+ * host side (Log2Txt) strip the segment header, order segment by seq and decode the 0xCB/0xCC/0xCD frame in payload
+ */
+static void Blackbox_Dump(void)
+{
+    Shell *shell_obj = Shell_GetInstence();
+    Blackbox_SegHeader_TypeDef header;
+    uint8_t page_buf[BLACKBOX_PAGE_SIZE];
+    uint32_t seg_cnt = 0;
+    uint32_t seg = 0;
+    bool logging = false;
+
+    if (shell_obj == NULL)
+        return;
+
+    if (!Blackbox_Ready() || !Blackbox_Monitor.used)
+    {
+        shellPrint(shell_obj, "\t[Blackbox Empty]\r\n");
+        return;
+    }
+
+    /* ring is left alone by the log task once stopped */
+    logging = (Blackbox_Monitor.state == Blackbox_State_Logging);
+    if (!Blackbox_Stop())
+    {
+        shellPrint(shell_obj, "\t[Blackbox Stop Failed]\r\n");
+        return;
+    }
+
+    seg_cnt = Blackbox_Monitor.head_seq - Blackbox_Monitor.oldest_seq + 1;
+    shellPrint(shell_obj, "[Blackbox Dump Start] %d\r\n", seg_cnt * BLACKBOX_SEGMENT_SIZE);
+
+    seg = Blackbox_Monitor.oldest_seg;
+    for (uint32_t i = 0; i < seg_cnt; i++)
+    {
+        /* segment header broken then send default data, keep the total size as announced */
+        if (!Blackbox_Read_SegHeader(seg, &header) || !Blackbox_Check_SegHeader(&header))
+        {
+            memset(page_buf, BLACKBOX_DEFAULT_DATA, BLACKBOX_PAGE_SIZE);
+            for (uint32_t offset = 0; offset < BLACKBOX_SEGMENT_SIZE; offset += BLACKBOX_PAGE_SIZE)
+                shell_obj->write((const char *)page_buf, BLACKBOX_PAGE_SIZE);
+        }
+        else
+        {
+            for (uint32_t offset = 0; offset < BLACKBOX_SEGMENT_SIZE; offset += BLACKBOX_PAGE_SIZE)
+            {
+                if (!Blackbox_Read(Blackbox_SegAddr(seg) + offset, page_buf, BLACKBOX_PAGE_SIZE))
+                    memset(page_buf, BLACKBOX_DEFAULT_DATA, BLACKBOX_PAGE_SIZE);
+
+                shell_obj->write((const char *)page_buf, BLACKBOX_PAGE_SIZE);
+            }
+        }
+
+        seg = Blackbox_NxtSeg(seg);
+    }
+
+    shellPrint(shell_obj, "\r\n[Blackbox Dump End]\r\n");
+
+    /* new session on the next segment, dump window is counted as dropped byte */
+    if (logging && !Blackbox_Request(Blackbox_Req_Start, BLACKBOX_REQ_TIMEOUT + BLACKBOX_SEG_ERASE_TIMEOUT))
+        shellPrint(shell_obj, "\t[Blackbox Resume Failed]\r\n");
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Blackbox_Dump, Blackbox_Dump, Dump Blackbox Log);
+
+static void Blackbox_Erase(void)
+{
+    Shell *shell_obj = Shell_GetInstence();
+    uint32_t seg_cnt = 0;
+
+    if ((shell_obj == NULL) || !Blackbox_Ready())
+        return;
+
+    if (Blackbox_Monitor.used)
+        seg_cnt = Blackbox_Monitor.head_seq - Blackbox_Monitor.oldest_seq + 1;
+
+    /* one more segment for the session restart after erase */
+    if (!Blackbox_Request(Blackbox_Req_Erase, BLACKBOX_REQ_TIMEOUT + (seg_cnt + 1) * BLACKBOX_SEG_ERASE_TIMEOUT))
+    {
+        shellPrint(shell_obj, "\t[Blackbox Erase Failed %d / %d Segment]\r\n", Blackbox_Monitor.req_seg, seg_cnt);
+        return;
+    }
+
+    shellPrint(shell_obj, "\t[Blackbox Erased %d Segment]\r\n", Blackbox_Monitor.req_seg);
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Blackbox_Erase, Blackbox_Erase, Erase Blackbox Log);
@@ -0,0 +1,127 @@
+#ifndef __BLACKBOX_H
+#define __BLACKBOX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stddef.h>
+#include "Storage.h"
+#include "Dev_W25Qxx.h"
+#include "Srv_OsCommon.h"
+#include "util.h"
+
+#define BLACKBOX_SEGMENT_TAG 0x424C4B42 /* "BLKB" */
+#define BLACKBOX_PAGE_SIZE 256
+#define BLACKBOX_SEGMENT_SIZE (4 Kb)
+#define BLACKBOX_CACHE_PAGE_NUM 16      /* 4KB cache, hold data during one background sector erase */
+#define BLACKBOX_DEFAULT_DATA 0xFF
+#define BLACKBOX_PROCESS_OP_MAX 4       /* max flash operation issued in one process call */
+#define BLACKBOX_REQ_TIMEOUT 1000       /* unit: ms, stop / start request, also bound the chip idle wait on stop */
+#define BLACKBOX_SEG_ERASE_TIMEOUT 500  /* unit: ms, erase request wait this per segment */
+
+#define BLACKBOX_SEGMENT_HEADER_SIZE sizeof(Blackbox_SegHeader_TypeDef)
+#define BLACKBOX_SEGMENT_PAYLOAD_SIZE (BLACKBOX_SEGMENT_SIZE - BLACKBOX_SEGMENT_HEADER_SIZE)
+
+typedef enum
+{
+    Blackbox_State_None = 0,
+    Blackbox_State_Ready,
+    Blackbox_State_Logging,
+    Blackbox_State_Flush,
+    Blackbox_State_Halt,
+} Blackbox_State_List;
+
+/* other task never touch the chip or the ring directly, stop / start / erase are done by the log task on request */
+typedef enum
+{
+    Blackbox_Req_None = 0,
+    Blackbox_Req_Stop,
+    Blackbox_Req_Start,
+    Blackbox_Req_Erase,
+} Blackbox_Request_List;
+
+#pragma pack(1)
+/*
+ * every 4K subsector is a append only segment, header placed at the segment start
+ * log stream is the payload of all segment concatenated by seq, log frame may cross the segment boundary
+ *  _____________________________________________________________________
+ * |   tag   |   seq   | session |  crc16  |   payload (0xCB/0xCC/0xCD frame) |
+ * |  4Byte  |  4Byte  |  2Byte  |  2Byte  |   4084Byte                       |
+ * |_________|_________|_________|_________|__________________________________|
+ */
+typedef struct
+{
+    uint32_t tag;
+    uint32_t seq;
+    uint16_t session;
+    uint16_t crc16;
+} Blackbox_SegHeader_TypeDef;
+#pragma pack()
+
+typedef struct
+{
+    uint32_t addr;
+    uint16_t size;
+    uint8_t buf[BLACKBOX_PAGE_SIZE];
+} Blackbox_CachePage_TypeDef;
+
+typedef struct
+{
+    uint32_t page_cnt;
+    uint32_t erase_cnt;
+    uint32_t busy_cnt;
+    uint32_t drop_byte;
+    uint32_t log_byte;
+    uint32_t cache_max;
+} Blackbox_Statistic_TypeDef;
+
+typedef struct
+{
+    Blackbox_State_List state;
+
+    /* set by requester, cleared by log task when done */
+    volatile uint8_t req;
+    bool req_result;
+    uint32_t req_seg;
+
+    Storage_ExtFLashDevObj_TypeDef *ext_dev;
+
+    uint32_t base_addr;
+    uint32_t seg_num;
+
+    /* segment seq / index */
+    uint32_t oldest_seq;
+    uint32_t oldest_seg;
+    uint32_t head_seq;
+    uint32_t head_seg;
+    uint16_t session;
+
+    /* next byte address in flash the incoming data belong to */
+    uint32_t fill_addr;
+
+    /* segment erased and ready for program */
+    bool nxt_seg_erased;
+    bool used;
+
+    /* page cache, written by log task and drained to flash in background */
+    uint8_t cache_in;
+    uint8_t cache_out;
+    uint8_t cache_cnt;
+    Blackbox_CachePage_TypeDef cache[BLACKBOX_CACHE_PAGE_NUM];
+
+    Blackbox_Statistic_TypeDef statistic;
+} Blackbox_Monitor_TypeDef;
+
+typedef struct
+{
+    bool (*init)(Storage_ExtFLashDevObj_TypeDef *ExtDev, uint32_t base_addr);
+    bool (*start)(void);
+    bool (*stop)(void);
+    uint32_t (*write)(uint8_t *p_data, uint32_t len);
+    void (*process)(void);
+    bool (*ready)(void);
+} Blackbox_TypeDef;
+
+extern Blackbox_TypeDef Blackbox;
+
+#endif
@@ -20,6 +20,9 @@
 
 #define Item_Capacity_Per_Tab (Storage_TabSize / sizeof(Storage_Item_TypeDef))
 
+/* external flash write back sector cache, buffer share flash_write_tmp */
+#define Storage_ExtFlash_Cache_Num 2
+
 /* flash io object */
 typedef struct
 {
@@ -27,13 +30,33 @@ typedef struct
     bool (*write)(uint32_t addr_offset, uint8_t *p_data, uint32_t len);
     bool (*erase)(uint32_t addr_offset, uint32_t len);
     bool (*erase_all)(void);
+    bool (*flush)(void);
 } StorageIO_TypeDef;
 
+typedef struct
+{
+    bool valid;
+    bool dirty;
+    uint32_t addr;      /* sector start address on chip */
+    uint32_t use_stamp;
+    uint8_t *p_buf;
+} Storage_SectorCache_TypeDef;
+
+typedef struct
+{
+    uint32_t stamp;
+    uint32_t hit_cnt;
+    uint32_t miss_cnt;
+    uint32_t flush_cnt;
+    Storage_SectorCache_TypeDef sector[Storage_ExtFlash_Cache_Num];
+} Storage_ExtFlashCache_TypeDef;
+
 /* internal vriable */
 Storage_Monitor_TypeDef Storage_Monitor;
 static uint8_t page_data_tmp[Storage_TabSize * 2] __attribute__((aligned(4))) = {0};
 static uint8_t flash_write_tmp[Storage_TabSize * 2] __attribute__((aligned(4))) = {0};
 static uint8_t flash_read_tmp[Storage_TabSize * 2] __attribute__((aligned(4))) = {0};
+static Storage_ExtFlashCache_TypeDef ExtFlash_Cache;
 
 static bool Storage_OnChipFlash_Read(uint32_t addr_offset, uint8_t *p_data, uint32_t len);
 static bool Storage_OnChipFlash_Write(uint32_t addr_offset, uint8_t *p_data, uint32_t len);
@@ -46,12 +69,16 @@ static bool Storage_ExtFlash_Read(uint32_t addr_offset, uint8_t *p_data, uint32_
 static bool Storage_ExtFlash_Write(uint32_t addr_offset, uint8_t *p_data, uint32_t len);
 static bool Storage_ExtFlash_Erase(uint32_t addr_offset, uint32_t len);
 static bool Storage_ExtFlash_EraseAll(void);
+static bool Storage_ExtFlash_Flush(void);
+static bool Storage_ExtFlash_Lock(Storage_ExtFLashDevObj_TypeDef *dev);
+static void Storage_ExtFlash_Unlock(Storage_ExtFLashDevObj_TypeDef *dev);
 
 StorageIO_TypeDef InternalFlash_IO = {
     .erase = Storage_OnChipFlash_Erase,
     .erase_all = NULL,
     .read = Storage_OnChipFlash_Read,
     .write = Storage_OnChipFlash_Write,
+    .flush = NULL,
 };
 
 StorageIO_TypeDef ExternalFlash_IO = {
@@ -59,6 +86,7 @@ StorageIO_TypeDef ExternalFlash_IO = {
     .erase_all = Storage_ExtFlash_EraseAll,
     .read = Storage_ExtFlash_Read,
     .write = Storage_ExtFlash_Write,
+    .flush = Storage_ExtFlash_Flush,
 };
 
 /* internal function */
@@ -73,13 +101,30 @@ static Storage_ErrorCode_List Storage_CreateItem(Storage_MediumType_List type, S
 static bool Storage_Compare_ItemSlot_CRC(const Storage_Item_TypeDef item);
 static bool Storage_Comput_ItemSlot_CRC(Storage_Item_TypeDef *p_item);
 static Storage_BaseSecInfo_TypeDef* Storage_Get_SecInfo(Storage_FlashInfo_TypeDef *info, Storage_ParaClassType_List class);
+static Storage_Item_TypeDef Storage_Search_Tab(Storage_MediumType_List type, Storage_ParaClassType_List class, const char *name);
+static bool Storage_Index_Build(Storage_MediumType_List type);
+static bool Storage_Index_Insert(Storage_MediumType_List type, const Storage_Item_TypeDef *p_item, uint32_t item_addr);
+static void Storage_Index_Drop(Storage_MediumType_List type, Storage_ParaClassType_List class);
+static void Storage_Index_Free(Storage_MediumType_List type);
+static Storage_IndexItem_TypeDef* Storage_Index_Find(Storage_Index_TypeDef *p_index, uint8_t class, const char *name, uint8_t name_len);
+static Storage_Index_TypeDef* Storage_Get_Index(Storage_MediumType_List type);
+static uint8_t Storage_Name_Len(const char *name);
 
 /* external function */
 static bool Storage_Init(Storage_ModuleState_TypeDef enable, Storage_ExtFLashDevObj_TypeDef *ExtDev);
 static Storage_Item_TypeDef Storage_Search(Storage_MediumType_List type, Storage_ParaClassType_List class, const char *name);
+static storage_handle Storage_Search_Handle(Storage_MediumType_List type, Storage_ParaClassType_List class, const char *name);
+static Storage_ErrorCode_List Storage_SlotData_Update(Storage_MediumType_List type, Storage_ParaClassType_List class, storage_handle data_slot_hdl, uint8_t *p_data, uint16_t size);
+static Storage_ErrorCode_List Storage_SlotData_Get(Storage_MediumType_List type, Storage_ParaClassType_List class, storage_handle data_slot_hdl, uint8_t *p_data, uint16_t size);
+static bool Storage_Flush(Storage_MediumType_List type);
 
 Storage_TypeDef Storage = {
     .init = Storage_Init,
+    .search = Storage_Search_Handle,
+    .create = Storage_CreateItem,
+    .update = Storage_SlotData_Update,
+    .get = Storage_SlotData_Get,
+    .flush = Storage_Flush,
 };
 
 static bool Storage_Init(Storage_ModuleState_TypeDef enable, Storage_ExtFLashDevObj_TypeDef *ExtDev)
@@ -87,6 +132,7 @@ static bool Storage_Init(Storage_ModuleState_TypeDef enable, Storage_ExtFLashDev
     void *ext_flash_bus_cfg = NULL;
     uint8_t extmodule_init_state;
     memset(&Storage_Monitor, 0, sizeof(Storage_Monitor));
+    memset(&ExtFlash_Cache, 0, sizeof(ExtFlash_Cache));
 
     Storage_Monitor.module_enable_reg.val = enable.val;
     Storage_Monitor.module_init_reg.val = 0;
@@ -148,6 +194,9 @@ reformat_internal_flash_info:
     {
         if (ExtDev->bus_type == Storage_ChipBus_Spi)
         {
+            osMutexDef(ExtFlash_Bus);
+            ExtDev->bus_lock = osMutexCreate(osMutex(ExtFlash_Bus));
+
             Storage_Monitor.ExtDev_ptr = NULL;
             ext_flash_bus_cfg = SrvOsCommon.malloc(sizeof(BspSPI_NorModeConfig_TypeDef));
 
@@ -174,6 +223,8 @@ reformat_internal_flash_info:
                         {
                             /* set get time callback */
                             To_DevW25Qxx_OBJ(ExtDev->dev_obj)->systick = SrvOsCommon.get_os_ms;
+                            /* let long erase wait give cpu to other task */
+                            To_DevW25Qxx_OBJ(ExtDev->dev_obj)->delay = SrvOsCommon.delay_ms;
 
                             /* set bus control callback */
                             To_DevW25Qxx_OBJ(ExtDev->dev_obj)->cs_ctl = Storage_External_Chip_W25Qxx_SelectPin_Ctl;
@@ -190,6 +241,9 @@ reinit_external_flash_module:
 
                             if (extmodule_init_state == DevW25Qxx_Ok)
                             {
+                                /* spi bus only have single data line, use fast read (0x0B) */
+                                To_DevW25Qxx_API(ExtDev->dev_api)->set_read_mode(To_DevW25Qxx_OBJ(ExtDev->dev_obj), DevW25Qxx_Read_Fast);
+
                                 ExtDev->sector_num  = To_DevW25Qxx_API(ExtDev->dev_api)->info(To_DevW25Qxx_OBJ(ExtDev->dev_obj)).subsector_num;
                                 ExtDev->sector_size = To_DevW25Qxx_API(ExtDev->dev_api)->info(To_DevW25Qxx_OBJ(ExtDev->dev_obj)).subsector_size;
                                 ExtDev->total_size  = To_DevW25Qxx_API(ExtDev->dev_api)->info(To_DevW25Qxx_OBJ(ExtDev->dev_obj)).flash_size;
@@ -260,6 +314,16 @@ reformat_external_flash_info:
         }
     }
  
+    /* write back all format and tab build result */
+    Storage_ExtFlash_Flush();
+
+    /* load every tab once and build name index, search never touch the flash after this */
+    if (Storage_Monitor.module_init_reg.bit.internal)
+        Storage_Index_Build(Internal_Flash);
+
+    if (Storage_Monitor.module_init_reg.bit.external)
+        Storage_Index_Build(External_Flash);
+
     Storage_Monitor.init_state = Storage_Monitor.module_init_reg.bit.external | \
                                  Storage_Monitor.module_init_reg.bit.internal;
 
@@ -539,6 +603,50 @@ static bool Storage_Clear_Tab(StorageIO_TypeDef *storage_api, uint32_t addr, uin
  * else return 0
  */
 static Storage_Item_TypeDef Storage_Search(Storage_MediumType_List type, Storage_ParaClassType_List class, const char *name)
+{
+    Storage_Item_TypeDef data_slot;
+    Storage_Index_TypeDef *p_index = NULL;
+    Storage_IndexItem_TypeDef *p_entry = NULL;
+    uint8_t name_len = 0;
+
+    memset(&data_slot, 0, sizeof(data_slot));
+
+    if (!Storage_Monitor.init_state || \
+        (name == NULL) || \
+        (strlen(name) == 0) || \
+        (class > Para_User))
+        return data_slot;
+
+    p_index = Storage_Get_Index(type);
+    if ((p_index == NULL) || (p_index->p_item == NULL))
+    {
+        /* index not available, traverse tab on flash */
+        return Storage_Search_Tab(type, class, name);
+    }
+
+    name_len = Storage_Name_Len(name);
+    p_entry = Storage_Index_Find(p_index, class, name, name_len);
+    if (p_entry == NULL)
+        return data_slot;
+
+    /* rebuild tab item from index, same as the one on flash */
+    data_slot.head_tag = STORAGE_ITEM_HEAD_TAG;
+    data_slot.class = p_entry->class;
+    memcpy(data_slot.name, name, name_len);
+    data_slot.data_addr = p_entry->data_addr;
+    data_slot.len = p_entry->len;
+    data_slot.crc16 = p_entry->item_crc;
+    data_slot.end_tag = STORAGE_ITEM_END_TAG;
+
+    return data_slot;
+}
+
+static storage_handle Storage_Search_Handle(Storage_MediumType_List type, Storage_ParaClassType_List class, const char *name)
+{
+    return Storage_Search(type, class, name).data_addr;
+}
+
+static Storage_Item_TypeDef Storage_Search_Tab(Storage_MediumType_List type, Storage_ParaClassType_List class, const char *name)
 {
     Storage_Item_TypeDef data_slot;
     StorageIO_TypeDef *StorageIO_API = NULL;
@@ -774,12 +882,121 @@ static Storage_ErrorCode_List Storage_SlotData_Update(Storage_MediumType_List ty
             return Storage_Error_None;
         }
 
+        /* item split into multi slot, write back current segment before moving on */
+        if (!StorageIO_API->write(read_addr, page_data_tmp, p_slotdata->cur_slot_size + sizeof(Storage_DataSlot_TypeDef)))
+            return Storage_Write_Error;
+
         read_addr = p_slotdata->nxt_addr;
     }
 
     return Storage_Error_None;
 }
 
+/* read item data back through the handle return by search, size must match the size it was created with */
+static Storage_ErrorCode_List Storage_SlotData_Get(Storage_MediumType_List type, Storage_ParaClassType_List class, storage_handle data_slot_hdl, uint8_t *p_data, uint16_t size)
+{
+    StorageIO_TypeDef *StorageIO_API = NULL;
+    Storage_BaseSecInfo_TypeDef *p_Sec = NULL;
+    Storage_DataSlot_TypeDef DataSlot;
+    uint8_t *p_read_out = NULL;
+    uint32_t read_addr = 0;
+    uint32_t read_size = 0;
+    uint32_t data_size = 0;
+
+    if (!Storage_Monitor.init_state || \
+        (type > External_Flash) || \
+        (class > Para_User) || \
+        (data_slot_hdl == 0) || \
+        (p_data == NULL) || \
+        (size == 0))
+        return Storage_Param_Error;
+
+    switch((uint8_t)type)
+    {
+        case External_Flash:
+            if (!Storage_Monitor.module_enable_reg.bit.external || \
+                !Storage_Monitor.module_init_reg.bit.external)
+                return Storage_ModuleInit_Error;
+
+            p_Sec = Storage_Get_SecInfo(&Storage_Monitor.external_info, class);
+            StorageIO_API = &ExternalFlash_IO;
+            break;
+
+        case Internal_Flash:
+            if (!Storage_Monitor.module_enable_reg.bit.internal || \
+                !Storage_Monitor.module_init_reg.bit.internal)
+                return Storage_ModuleInit_Error;
+
+            p_Sec = Storage_Get_SecInfo(&Storage_Monitor.internal_info, class);
+            StorageIO_API = &InternalFlash_IO;
+            break;
+
+        default:
+            return Storage_Param_Error;
+    }
+
+    if (p_Sec == NULL)
+        return Storage_Param_Error;
+
+    read_addr = data_slot_hdl;
+    while (read_addr)
+    {
+        if ((read_addr < p_Sec->data_sec_addr) || \
+            (read_addr > (p_Sec->data_sec_addr + p_Sec->data_sec_size)))
+            return Storage_DataInfo_Error;
+
+        memset(&DataSlot, 0, sizeof(DataSlot));
+        if (!StorageIO_API->read(read_addr, page_data_tmp, sizeof(Storage_DataSlot_TypeDef)))
+            return Storage_Read_Error;
+
+        p_read_out = page_data_tmp;
+        memcpy(&DataSlot.head_tag, p_read_out, sizeof(DataSlot.head_tag));
+        p_read_out += sizeof(DataSlot.head_tag) + STORAGE_NAME_LEN;
+        memcpy(&DataSlot.total_data_size, p_read_out, sizeof(DataSlot.total_data_size));
+        p_read_out += sizeof(DataSlot.total_data_size);
+        memcpy(&DataSlot.cur_slot_size, p_read_out, sizeof(DataSlot.cur_slot_size));
+        p_read_out += sizeof(DataSlot.cur_slot_size);
+        memcpy(&DataSlot.nxt_addr, p_read_out, sizeof(DataSlot.nxt_addr));
+        p_read_out += sizeof(DataSlot.nxt_addr);
+        memcpy(&DataSlot.align_size, p_read_out, sizeof(DataSlot.align_size));
+
+        if ((DataSlot.head_tag != STORAGE_SLOT_HEAD_TAG) || \
+            (DataSlot.cur_slot_size == 0) || \
+            (DataSlot.cur_slot_size > DataSlot.total_data_size) || \
+            (DataSlot.align_size >= STORAGE_DATA_ALIGN) || \
+            (DataSlot.align_size > DataSlot.cur_slot_size))
+            return Storage_DataInfo_Error;
+
+        if ((data_size + DataSlot.cur_slot_size - DataSlot.align_size) > size)
+            return Storage_DataSize_Overrange;
+
+        /* whole slot with crc and end tag */
+        read_size = sizeof(Storage_DataSlot_TypeDef) + DataSlot.cur_slot_size;
+        if ((read_size > sizeof(page_data_tmp)) || \
+            !StorageIO_API->read(read_addr, page_data_tmp, read_size))
+            return Storage_Read_Error;
+
+        p_read_out = page_data_tmp + sizeof(Storage_DataSlot_TypeDef) - sizeof(DataSlot.slot_crc) - sizeof(DataSlot.end_tag);
+        memcpy(&DataSlot.slot_crc, p_read_out + DataSlot.cur_slot_size, sizeof(DataSlot.slot_crc));
+        memcpy(&DataSlot.end_tag, p_read_out + DataSlot.cur_slot_size + sizeof(DataSlot.slot_crc), sizeof(DataSlot.end_tag));
+
+        if (DataSlot.end_tag != STORAGE_SLOT_END_TAG)
+            return Storage_DataInfo_Error;
+
+        if (Common_CRC16(p_read_out, DataSlot.cur_slot_size) != DataSlot.slot_crc)
+            return Storage_CRC_Error;
+
+        memcpy(p_data + data_size, p_read_out, DataSlot.cur_slot_size - DataSlot.align_size);
+        data_size += DataSlot.cur_slot_size - DataSlot.align_size;
+        read_addr = DataSlot.nxt_addr;
+    }
+
+    if (data_size != size)
+        return Storage_Update_DataSize_Error;
+
+    return Storage_Error_None;
+}
+
 static bool Storage_DeleteItem(Storage_MediumType_List type, Storage_ParaClassType_List class, const char *name, uint32_t size)
 {
     Storage_BaseSecInfo_TypeDef *p_SecInfo = NULL;
@@ -1082,6 +1299,10 @@ static Storage_ErrorCode_List Storage_CreateItem(Storage_MediumType_List type, S
             /* write back item slot list to tab */
             if (!StorageIO_API->write(storage_tab_addr, page_data_tmp, (p_Sec->tab_size / p_Sec->page_num)))
                 return Storage_Write_Error;
+
+            /* index can`t hold the new item, drop it and let search traverse tab on flash */
+            if (!Storage_Index_Insert(type, &crt_item_slot, storage_tab_addr + item_index * StorageItem_Size))
+                Storage_Index_Free(type);
         }
         else
             /* don`t have enough space for target data */
@@ -1186,6 +1407,7 @@ static bool Storage_Establish_Tab(Storage_MediumType_List type, Storage_ParaClas
         p_SecInfo->free_slot_addr = p_SecInfo->data_sec_addr;
         p_SecInfo->para_num = 0;
         p_SecInfo->para_size = 0;
+        Storage_Index_Drop(type, class);
 
         /* read out whole section info data from storage info section */
         if (!StorageIO_API->read(From_Start_Address, page_data_tmp, Storage_TabSize))
@@ -1470,6 +1692,292 @@ static Storage_BaseSecInfo_TypeDef* Storage_Get_SecInfo(Storage_FlashInfo_TypeDe
     return NULL;
 }
 
+/************************************************** Parameter Index Section ************************************************/
+static uint8_t Storage_Name_Len(const char *name)
+{
+    uint8_t len = 0;
+
+    while ((len < STORAGE_NAME_LEN) && (name[len] != '\0'))
+        len ++;
+
+    return len;
+}
+
+static uint32_t Storage_Name_Hash(const uint8_t *name, uint8_t len)
+{
+    uint32_t hash = STORAGE_FNV_OFFSET_BASIS;
+
+    for (uint8_t i = 0; i < len; i++)
+    {
+        hash ^= name[i];
+        hash *= STORAGE_FNV_PRIME;
+    }
+
+    return hash;
+}
+
+static Storage_Index_TypeDef* Storage_Get_Index(Storage_MediumType_List type)
+{
+    switch ((uint8_t)type)
+    {
+        case Internal_Flash: return &Storage_Monitor.internal_index;
+        case External_Flash: return &Storage_Monitor.external_index;
+        default:             return NULL;
+    }
+}
+
+/* capacity round up to power of 2 */
+static bool Storage_Index_Create(Storage_Index_TypeDef *p_index, uint32_t capacity)
+{
+    uint32_t size = STORAGE_INDEX_MIN_CAPACITY;
+
+    if (p_index == NULL)
+        return false;
+
+    while (size < capacity)
+        size <<= 1;
+
+    if (size > UINT16_MAX)
+        return false;
+
+    memset(p_index, 0, sizeof(Storage_Index_TypeDef));
+    p_index->p_item = SrvOsCommon.malloc_tag(SrvOs_Heap_Fast, size * sizeof(Storage_IndexItem_TypeDef));
+    if (p_index->p_item == NULL)
+        return false;
+
+    memset(p_index->p_item, 0, size * sizeof(Storage_IndexItem_TypeDef));
+    p_index->capacity = size;
+
+    return true;
+}
+
+/* put item into the first none used slot, caller make sure item not exist */
+static void Storage_Index_Place(Storage_Index_TypeDef *p_index, const Storage_IndexItem_TypeDef *p_item)
+{
+    uint16_t mask = p_index->capacity - 1;
+    uint16_t pos = p_item->name_hash & mask;
+    uint16_t probe = 0;
+
+    while (p_index->p_item[pos].state == Storage_IndexItem_Used)
+    {
+        pos = (pos + 1) & mask;
+        probe ++;
+    }
+
+    if (p_index->p_item[pos].state == Storage_IndexItem_Deleted)
+        p_index->deleted --;
+
+    p_index->p_item[pos] = *p_item;
+    p_index->p_item[pos].state = Storage_IndexItem_Used;
+    p_index->num ++;
+
+    if (probe > p_index->max_probe)
+        p_index->max_probe = probe;
+}
+
+static bool Storage_Index_Rehash(Storage_Index_TypeDef *p_index, uint32_t capacity)
+{
+    Storage_Index_TypeDef index_new;
+
+    if (!Storage_Index_Create(&index_new, capacity))
+        return false;
+
+    for (uint16_t i = 0; i < p_index->capacity; i++)
+    {
+        if (p_index->p_item[i].state == Storage_IndexItem_Used)
+            Storage_Index_Place(&index_new, &p_index->p_item[i]);
+    }
+
+    SrvOsCommon.free(p_index->p_item);
+    *p_index = index_new;
+
+    return true;
+}
+
+static Storage_IndexItem_TypeDef* Storage_Index_Find(Storage_Index_TypeDef *p_index, uint8_t class, const char *name, uint8_t name_len)
+{
+    Storage_IndexItem_TypeDef *p_entry = NULL;
+    uint32_t hash = 0;
+    uint16_t name_crc = 0;
+    uint16_t mask = 0;
+    uint16_t pos = 0;
+
+    if ((p_index == NULL) || (p_index->p_item == NULL) || (name == NULL) || (name_len == 0))
+        return NULL;
+
+    hash = Storage_Name_Hash((const uint8_t *)name, name_len);
+    name_crc = Common_CRC16((const uint8_t *)name, name_len);
+    mask = p_index->capacity - 1;
+    pos = hash & mask;
+
+    for (uint16_t probe = 0; probe < p_index->capacity; probe ++)
+    {
+        p_entry = &p_index->p_item[pos];
+
+        if (p_entry->state == Storage_IndexItem_Empty)
+            return NULL;
+
+        if ((p_entry->state == Storage_IndexItem_Used) && \
+            (p_entry->name_hash == hash) && \
+            (p_entry->name_crc == name_crc) && \
+            (p_entry->class == class))
+            return p_entry;
+
+        pos = (pos + 1) & mask;
+    }
+
+    return NULL;
+}
+
+/* add new item into index or update the existing one */
+static bool Storage_Index_Insert(Storage_MediumType_List type, const Storage_Item_TypeDef *p_item, uint32_t item_addr)
+{
+    Storage_Index_TypeDef *p_index = Storage_Get_Index(type);
+    Storage_IndexItem_TypeDef *p_entry = NULL;
+    Storage_IndexItem_TypeDef entry;
+    uint8_t name_len = 0;
+
+    if ((p_index == NULL) || (p_index->p_item == NULL) || (p_item == NULL))
+        return false;
+
+    name_len = Storage_Name_Len((const char *)p_item->name);
+    if (name_len == 0)
+        return false;
+
+    memset(&entry, 0, sizeof(entry));
+    entry.name_hash = Storage_Name_Hash(p_item->name, name_len);
+    entry.name_crc = Common_CRC16(p_item->name, name_len);
+    entry.class = p_item->class;
+    entry.item_addr = item_addr;
+    entry.data_addr = p_item->data_addr;
+    entry.len = p_item->len;
+    entry.item_crc = p_item->crc16;
+
+    p_entry = Storage_Index_Find(p_index, p_item->class, (const char *)p_item->name, name_len);
+    if (p_entry)
+    {
+        entry.state = Storage_IndexItem_Used;
+        *p_entry = entry;
+        return true;
+    }
+
+    /* keep probe chain short, grow index before load factor reached */
+    if (((uint32_t)(p_index->num + p_index->deleted + 1) * 100) > ((uint32_t)p_index->capacity * STORAGE_INDEX_LOAD_FACTOR))
+    {
+        if (!Storage_Index_Rehash(p_index, (uint32_t)(p_index->num + 1) * 2))
+            return false;
+    }
+
+    Storage_Index_Place(p_index, &entry);
+    return true;
+}
+
+/* section tab cleared, remove all item belong to this class */
+static void Storage_Index_Drop(Storage_MediumType_List type, Storage_ParaClassType_List class)
+{
+    Storage_Index_TypeDef *p_index = Storage_Get_Index(type);
+
+    if ((p_index == NULL) || (p_index->p_item == NULL))
+        return;
+
+    for (uint16_t i = 0; i < p_index->capacity; i++)
+    {
+        if ((p_index->p_item[i].state == Storage_IndexItem_Used) && \
+            (p_index->p_item[i].class == class))
+        {
+            p_index->p_item[i].state = Storage_IndexItem_Deleted;
+            p_index->num --;
+            p_index->deleted ++;
+        }
+    }
+}
+
+/* release index, search traverse tab on flash from now on */
+static void Storage_Index_Free(Storage_MediumType_List type)
+{
+    Storage_Index_TypeDef *p_index = Storage_Get_Index(type);
+
+    if ((p_index == NULL) || (p_index->p_item == NULL))
+        return;
+
+    SrvOsCommon.free(p_index->p_item);
+    memset(p_index, 0, sizeof(Storage_Index_TypeDef));
+}
+
+/* read every tab once and index all valid item, any failure leave no index behind */
+static bool Storage_Index_Build(Storage_MediumType_List type)
+{
+    StorageIO_TypeDef *StorageIO_API = NULL;
+    Storage_FlashInfo_TypeDef *p_Flash = NULL;
+    Storage_BaseSecInfo_TypeDef *p_Sec = NULL;
+    Storage_Index_TypeDef *p_index = NULL;
+    Storage_Item_TypeDef *item_list = NULL;
+    uint32_t tab_addr = 0;
+    uint32_t tab_page_size = 0;
+    uint32_t para_num = 0;
+
+    switch((uint8_t)type)
+    {
+        case Internal_Flash:
+            StorageIO_API = &InternalFlash_IO;
+            p_Flash = &Storage_Monitor.internal_info;
+            break;
+
+        case External_Flash:
+            StorageIO_API = &ExternalFlash_IO;
+            p_Flash = &Storage_Monitor.external_info;
+            break;
+
+        default:
+            return false;
+    }
+
+    p_index = Storage_Get_Index(type);
+    Storage_Index_Free(type);
+
+    para_num = p_Flash->boot_sec.para_num + p_Flash->sys_sec.para_num + p_Flash->user_sec.para_num;
+    if (!Storage_Index_Create(p_index, para_num * 2))
+        return false;
+
+    for (uint8_t class = Para_Boot; class <= Para_User; class ++)
+    {
+        p_Sec = Storage_Get_SecInfo(p_Flash, class);
+        if ((p_Sec == NULL) || (p_Sec->para_num == 0) || (p_Sec->page_num == 0))
+            continue;
+
+        tab_addr = p_Sec->tab_addr;
+        tab_page_size = p_Sec->tab_size / p_Sec->page_num;
+
+        for (uint16_t tab_i = 0; tab_i < p_Sec->page_num; tab_i ++)
+        {
+            /* a partial index would miss live item and let create add a duplicate */
+            if (!StorageIO_API->read(tab_addr, page_data_tmp, tab_page_size))
+            {
+                Storage_Index_Free(type);
+                return false;
+            }
+
+            item_list = (Storage_Item_TypeDef *)page_data_tmp;
+            for (uint16_t item_i = 0; item_i < (tab_page_size / StorageItem_Size); item_i ++)
+            {
+                if ((item_list[item_i].head_tag == STORAGE_ITEM_HEAD_TAG) && \
+                    (item_list[item_i].end_tag == STORAGE_ITEM_END_TAG) && \
+                    (memcmp(item_list[item_i].name, STORAGE_FREEITEM_NAME, strlen(STORAGE_FREEITEM_NAME)) != 0) && \
+                    Storage_Compare_ItemSlot_CRC(item_list[item_i]) && \
+                    !Storage_Index_Insert(type, &item_list[item_i], tab_addr + item_i * StorageItem_Size))
+                {
+                    Storage_Index_Free(type);
+                    return false;
+                }
+            }
+
+            tab_addr += tab_page_size;
+        }
+    }
+
+    return true;
+}
+
 /************************************************** External Flash IO API Section ************************************************/
 static bool Storage_External_Chip_W25Qxx_SelectPin_Ctl(bool state)
 {
@@ -1516,178 +2024,257 @@ static uint16_t Storage_External_Chip_W25Qxx_BusTrans(uint8_t *tx, uint8_t *rx,
     return 0;
 }
 
-static bool Storage_ExtFlash_Read(uint32_t addr_offset, uint8_t *p_data, uint32_t len)
+/* get w25qxx device and check the access range */
+static Storage_ExtFLashDevObj_TypeDef* Storage_ExtFlash_Get_Dev(uint32_t addr, uint32_t len, uint32_t *p_sector_size)
 {
-    uint32_t read_start_addr = 0;
-    uint32_t flash_end_addr = 0;
-    uint32_t section_start_addr = 0;
-    uint32_t next_read_addr = 0;
-    uint32_t section_size = 0;
-    uint32_t read_offset = 0;
-    uint32_t read_len = len;
-    Storage_ExtFLashDevObj_TypeDef *dev = NULL;
-    DevW25Qxx_Error_List state = DevW25Qxx_Ok;
+    Storage_ExtFLashDevObj_TypeDef *dev = (Storage_ExtFLashDevObj_TypeDef *)(Storage_Monitor.ExtDev_ptr);
+    DevW25Qxx_DeviceInfo_TypeDef info;
+
+    if ((dev == NULL) || \
+        (dev->chip_type != Storage_ChipType_W25Qxx) || \
+        (dev->dev_api == NULL) || \
+        (dev->dev_obj == NULL))
+        return NULL;
+
+    info = To_DevW25Qxx_API(dev->dev_api)->info(To_DevW25Qxx_OBJ(dev->dev_obj));
+    if ((addr < info.start_addr) || \
+        ((addr + len) > (info.start_addr + info.flash_size)) || \
+        (info.subsector_size == 0) || \
+        ((info.subsector_size * Storage_ExtFlash_Cache_Num) > sizeof(flash_write_tmp)))
+        return NULL;
+
+    if (p_sector_size)
+        *p_sector_size = info.subsector_size;
+
+    return dev;
+}
 
-    if ((Storage_Monitor.ExtDev_ptr != NULL) && p_data && len)
-    {
-        read_start_addr = Storage_Monitor.external_info.base_addr + addr_offset;       
-        dev = (Storage_ExtFLashDevObj_TypeDef *)(Storage_Monitor.ExtDev_ptr);
+static bool Storage_ExtFlash_Lock(Storage_ExtFLashDevObj_TypeDef *dev)
+{
+    if (dev->bus_lock == NULL)
+        return true;
 
-        switch((uint8_t)dev->chip_type)
+    return (osMutexWait(dev->bus_lock, ExtFlash_BusLock_TimeOut) == osOK);
+}
+
+static void Storage_ExtFlash_Unlock(Storage_ExtFLashDevObj_TypeDef *dev)
+{
+    if (dev->bus_lock)
+        osMutexRelease(dev->bus_lock);
+}
+
+static bool Storage_ExtFlash_Cache_WriteBack(Storage_ExtFLashDevObj_TypeDef *dev, Storage_SectorCache_TypeDef *p_cache, uint32_t sector_size)
+{
+    bool state = false;
+
+    if (!p_cache->valid || !p_cache->dirty)
+        return true;
+
+    if (!Storage_ExtFlash_Lock(dev))
+        return false;
+
+    state = (To_DevW25Qxx_API(dev->dev_api)->erase_sector(To_DevW25Qxx_OBJ(dev->dev_obj), p_cache->addr) == DevW25Qxx_Ok) && \
+            (To_DevW25Qxx_API(dev->dev_api)->write(To_DevW25Qxx_OBJ(dev->dev_obj), p_cache->addr, p_cache->p_buf, sector_size) == DevW25Qxx_Ok);
+    Storage_ExtFlash_Unlock(dev);
+
+    if (!state)
+        return false;
+
+    p_cache->dirty = false;
+    ExtFlash_Cache.flush_cnt ++;
+    return true;
+}
+
+/* sector erased outside the cache, drop the cached copy */
+static void Storage_ExtFlash_Cache_Drop(uint32_t sector_addr)
+{
+    for (uint8_t i = 0; i < Storage_ExtFlash_Cache_Num; i++)
+    {
+        if (ExtFlash_Cache.sector[i].valid && (ExtFlash_Cache.sector[i].addr == sector_addr))
         {
-            case Storage_ChipType_W25Qxx:
-                if (dev->dev_api && dev->dev_obj)
-                {
-                    section_size = To_DevW25Qxx_API(dev->dev_api)->info(To_DevW25Qxx_OBJ(dev->dev_obj)).subsector_size;
-                    /* get w25qxx device info */
-                    /* address check */
-                    flash_end_addr = To_DevW25Qxx_API(dev->dev_api)->info(To_DevW25Qxx_OBJ(dev->dev_obj)).start_addr;
-                    if (flash_end_addr > read_start_addr)
-                        return false;
+            ExtFlash_Cache.sector[i].valid = false;
+            ExtFlash_Cache.sector[i].dirty = false;
+        }
+    }
+}
 
-                    /* range check */
-                    flash_end_addr += To_DevW25Qxx_API(dev->dev_api)->info(To_DevW25Qxx_OBJ(dev->dev_obj)).flash_size;
-                    if ((len + read_start_addr) > flash_end_addr)
-                        return false;
+/*
+ * get cache of the sector, least recently used one is evicted when missed
+ * load sector from chip unless caller is going to overwrite the whole sector
+ */
+static Storage_SectorCache_TypeDef* Storage_ExtFlash_Cache_Get(Storage_ExtFLashDevObj_TypeDef *dev, uint32_t sector_addr, uint32_t sector_size, bool load)
+{
+    Storage_SectorCache_TypeDef *p_cache = NULL;
 
-                    if (section_size)
-                    {
-                        section_start_addr = To_DevW25Qxx_API(dev->dev_api)->get_section_start_addr(To_DevW25Qxx_OBJ(dev->dev_obj), read_start_addr);
-                        read_offset = read_start_addr - section_start_addr;
-                        if (section_size > sizeof(flash_read_tmp))
-                            return false;
+    for (uint8_t i = 0; i < Storage_ExtFlash_Cache_Num; i++)
+    {
+        if (ExtFlash_Cache.sector[i].valid && (ExtFlash_Cache.sector[i].addr == sector_addr))
+        {
+            ExtFlash_Cache.hit_cnt ++;
+            ExtFlash_Cache.sector[i].use_stamp = ++ ExtFlash_Cache.stamp;
+            return &ExtFlash_Cache.sector[i];
+        }
 
-                        while(true)
-                        {
-                            /* circumstances 1: store data size less than flash sector size and only none multiple sector read is needed */
-                            /* circumstances 2: store data size less than flash sector length but need to read from the end of the sector N to the start of the sector N + 1 */
-                            /* circumstances 3: store data size large than flash sector length */
-                            if (read_offset + read_len > section_size)
-                                read_len = section_size - read_offset;
-
-                            /* read whole section */
-                            if (To_DevW25Qxx_API(dev->dev_api)->read(To_DevW25Qxx_OBJ(dev->dev_obj), section_start_addr, flash_read_tmp, section_size) != DevW25Qxx_Ok)
-                                return false;
-                        
-                            memcpy(p_data, flash_read_tmp + read_offset, read_len);
-                            memset(flash_read_tmp, 0, section_size);
+        if ((p_cache == NULL) || \
+            !ExtFlash_Cache.sector[i].valid || \
+            (p_cache->valid && (ExtFlash_Cache.sector[i].use_stamp < p_cache->use_stamp)))
+            p_cache = &ExtFlash_Cache.sector[i];
+    }
 
-                            len -= read_len;
-                            if (len == 0)
-                                return true;
-                        
-                            read_offset = 0;
-                            next_read_addr = To_DevW25Qxx_API(dev->dev_api)->get_section_start_addr(To_DevW25Qxx_OBJ(dev->dev_obj), section_start_addr + read_len);
-                            if (next_read_addr == section_start_addr)
-                                read_offset = read_len;
-                            
-                            p_data += read_len;
-                            read_len = len;
-                            section_start_addr = next_read_addr;
-                        }
-                    }
-                }
-                break;
+    ExtFlash_Cache.miss_cnt ++;
+    if (!Storage_ExtFlash_Cache_WriteBack(dev, p_cache, sector_size))
+        return NULL;
 
-            default:
-                return false;
+    p_cache->valid = false;
+    p_cache->p_buf = flash_write_tmp + (p_cache - ExtFlash_Cache.sector) * sector_size;
+    if (load)
+    {
+        if (!Storage_ExtFlash_Lock(dev))
+            return NULL;
+
+        if (To_DevW25Qxx_API(dev->dev_api)->read(To_DevW25Qxx_OBJ(dev->dev_obj), sector_addr, p_cache->p_buf, sector_size) != DevW25Qxx_Ok)
+        {
+            Storage_ExtFlash_Unlock(dev);
+            return NULL;
         }
+
+        Storage_ExtFlash_Unlock(dev);
     }
 
-    return false;
+    p_cache->addr = sector_addr;
+    p_cache->valid = true;
+    p_cache->dirty = false;
+    p_cache->use_stamp = ++ ExtFlash_Cache.stamp;
+
+    return p_cache;
 }
 
+/* w25qxx can read any length from any address, read target range only */
+static bool Storage_ExtFlash_Read(uint32_t addr_offset, uint8_t *p_data, uint32_t len)
+{
+    Storage_ExtFLashDevObj_TypeDef *dev = NULL;
+    Storage_SectorCache_TypeDef *p_cache = NULL;
+    uint32_t read_start_addr = Storage_Monitor.external_info.base_addr + addr_offset;
+    uint32_t sector_size = 0;
+    uint32_t overlap_start = 0;
+    uint32_t overlap_end = 0;
+
+    if ((p_data == NULL) || (len == 0))
+        return false;
+
+    dev = Storage_ExtFlash_Get_Dev(read_start_addr, len, &sector_size);
+    if (dev == NULL)
+        return false;
+
+    if (!Storage_ExtFlash_Lock(dev))
+        return false;
+
+    if (To_DevW25Qxx_API(dev->dev_api)->read(To_DevW25Qxx_OBJ(dev->dev_obj), read_start_addr, p_data, len) != DevW25Qxx_Ok)
+    {
+        Storage_ExtFlash_Unlock(dev);
+        return false;
+    }
+
+    Storage_ExtFlash_Unlock(dev);
+
+    /* dirty cached sector hold newer data than the chip */
+    for (uint8_t i = 0; i < Storage_ExtFlash_Cache_Num; i++)
+    {
+        p_cache = &ExtFlash_Cache.sector[i];
+        if (!p_cache->valid || !p_cache->dirty)
+            continue;
+
+        overlap_start = (p_cache->addr > read_start_addr) ? p_cache->addr : read_start_addr;
+        overlap_end = ((p_cache->addr + sector_size) < (read_start_addr + len)) ? (p_cache->addr + sector_size) : (read_start_addr + len);
+
+        if (overlap_start < overlap_end)
+            memcpy(p_data + (overlap_start - read_start_addr), p_cache->p_buf + (overlap_start - p_cache->addr), overlap_end - overlap_start);
+    }
+
+    return true;
+}
+
+/*
+ * update sector in cache only, erase and program happen when sector is evicted or flushed
+ * several item update in the same sector cost one erase / program cycle
+ */
 static bool Storage_ExtFlash_Write(uint32_t addr_offset, uint8_t *p_data, uint32_t len)
 {
-    uint32_t write_start_addr = 0;
-    uint32_t flash_end_addr = 0;
-    uint32_t section_start_addr = 0;
-    uint32_t next_write_addr = 0;
-    uint32_t section_size = 0;
-    uint32_t write_offset = 0;
-    uint32_t write_len = len;
     Storage_ExtFLashDevObj_TypeDef *dev = NULL;
-    DevW25Qxx_Error_List state = DevW25Qxx_Ok;
+    Storage_SectorCache_TypeDef *p_cache = NULL;
+    uint32_t write_addr = Storage_Monitor.external_info.base_addr + addr_offset;
+    uint32_t sector_size = 0;
+    uint32_t write_offset = 0;
+    uint32_t write_len = 0;
+
+    if ((p_data == NULL) || (len == 0))
+        return false;
+
+    dev = Storage_ExtFlash_Get_Dev(write_addr, len, &sector_size);
+    if (dev == NULL)
+        return false;
 
-    if ((Storage_Monitor.ExtDev_ptr != NULL) && p_data && len)
+    while (len)
     {
-        write_start_addr = Storage_Monitor.external_info.base_addr + addr_offset;
-        dev = (Storage_ExtFLashDevObj_TypeDef *)(Storage_Monitor.ExtDev_ptr);
-    
-        switch((uint8_t)dev->chip_type)
+        write_offset = write_addr % sector_size;
+        write_len = sector_size - write_offset;
+        if (write_len > len)
+            write_len = len;
+
+        p_cache = Storage_ExtFlash_Cache_Get(dev, write_addr - write_offset, sector_size, (write_len != sector_size));
+        if (p_cache == NULL)
+            return false;
+
+        if ((write_len == sector_size) || (memcmp(p_cache->p_buf + write_offset, p_data, write_len) != 0))
         {
-            case Storage_ChipType_W25Qxx:
-                if (dev->dev_api && dev->dev_obj)
-                {
-                    section_size = To_DevW25Qxx_API(dev->dev_api)->info(To_DevW25Qxx_OBJ(dev->dev_obj)).subsector_size;
-                    /* get w25qxx device info */
-                    /* address check */
-                    flash_end_addr = To_DevW25Qxx_API(dev->dev_api)->info(To_DevW25Qxx_OBJ(dev->dev_obj)).start_addr;
-                    if (flash_end_addr > write_start_addr)
-                        return false;
+            memcpy(p_cache->p_buf + write_offset, p_data, write_len);
+            p_cache->dirty = true;
+        }
 
-                    /* range check */
-                    flash_end_addr += To_DevW25Qxx_API(dev->dev_api)->info(To_DevW25Qxx_OBJ(dev->dev_obj)).flash_size;
-                    if ((len + write_start_addr) > flash_end_addr)
-                        return false;
-                    
-                    if (section_size)
-                    {
-                        section_start_addr = To_DevW25Qxx_API(dev->dev_api)->get_section_start_addr(To_DevW25Qxx_OBJ(dev->dev_obj), write_start_addr);
-                        write_offset = write_start_addr - section_start_addr;
-                        if (section_size > sizeof(flash_write_tmp))
-                            return false;
+        write_addr += write_len;
+        p_data += write_len;
+        len -= write_len;
+    }
 
-                        while(true)
-                        {
-                            /* circumstances 1: store data size less than flash sector size and only none multiple sector write is needed */
-                            /* circumstances 2: store data size less than flash sector length but need to write from the end of the sector N to the start of the sector N + 1 */
-                            /* circumstances 3: store data size large than flash sector length */
-                            /* read whole section */
-                            if (To_DevW25Qxx_API(dev->dev_api)->read(To_DevW25Qxx_OBJ(dev->dev_obj), section_start_addr, flash_write_tmp, section_size) != DevW25Qxx_Ok)
-                                return false;
-
-                            /* erase whole section */
-                            if (To_DevW25Qxx_API(dev->dev_api)->erase_sector(To_DevW25Qxx_OBJ(dev->dev_obj), section_start_addr) != DevW25Qxx_Ok)
-                                return false;
-
-                            /* update whole section */
-                            if (write_offset + write_len > section_size)
-                                write_len = section_size - write_offset;
-                            
-                            /* copy data to section data read out */
-                            memcpy(flash_write_tmp + write_offset, p_data, write_len);
+    return true;
+}
 
-                            state = To_DevW25Qxx_API(dev->dev_api)->write(To_DevW25Qxx_OBJ(dev->dev_obj), section_start_addr, flash_write_tmp, section_size);
+static bool Storage_ExtFlash_Flush(void)
+{
+    Storage_ExtFLashDevObj_TypeDef *dev = NULL;
+    uint32_t sector_size = 0;
+    bool state = true;
 
-                            /* clear cache buff */
-                            memset(flash_write_tmp, 0, section_size);
-                            
-                            len -= write_len;
-                            if (state == DevW25Qxx_Ok)
-                            {
-                                if (len == 0)
-                                    return true;
-                            }
-                            else
-                                return false;
+    dev = Storage_ExtFlash_Get_Dev(Storage_Monitor.external_info.base_addr, 0, &sector_size);
+    if (dev == NULL)
+        return false;
 
-                            write_offset = 0;
-                            next_write_addr = To_DevW25Qxx_API(dev->dev_api)->get_section_start_addr(To_DevW25Qxx_OBJ(dev->dev_obj), section_start_addr + write_len);
-                            if (next_write_addr == section_start_addr)
-                                write_offset = write_len;
+    for (uint8_t i = 0; i < Storage_ExtFlash_Cache_Num; i++)
+    {
+        if (!Storage_ExtFlash_Cache_WriteBack(dev, &ExtFlash_Cache.sector[i], sector_size))
+            state = false;
+    }
 
-                            p_data += write_len;
-                            write_len = len;
-                            section_start_addr = next_write_addr; 
-                        }
-                    }
-                }
-                return false;
+    return state;
+}
 
-            default:
-                return false;
-        }
+/* write back every medium cache, call at the end of each storage operation */
+static bool Storage_Flush(Storage_MediumType_List type)
+{
+    switch ((uint8_t)type)
+    {
+        case Internal_Flash:
+            if (InternalFlash_IO.flush)
+                return InternalFlash_IO.flush();
+            return true;
+
+        case External_Flash:
+            if (ExternalFlash_IO.flush)
+                return ExternalFlash_IO.flush();
+            return true;
+
+        default:
+            return false;
     }
 }
 
@@ -1712,9 +2299,20 @@ static bool Storage_ExtFlash_Erase(uint32_t addr_offset, uint32_t len)
                     if (erase_start_addr < To_DevW25Qxx_API(dev->dev_api)->info(To_DevW25Qxx_OBJ(dev->dev_obj)).start_addr)
                         return false;
 
-                    /* W25Qxx device read */
+                    /* cached copy of the erased sector is out of date */
+                    Storage_ExtFlash_Cache_Drop(To_DevW25Qxx_API(dev->dev_api)->get_section_start_addr(To_DevW25Qxx_OBJ(dev->dev_obj), erase_start_addr));
+
+                    if (!Storage_ExtFlash_Lock(dev))
+                        return false;
+
+                    /* W25Qxx device erase */
                     if (To_DevW25Qxx_API(dev->dev_api)->erase_sector(To_DevW25Qxx_OBJ(dev->dev_obj), erase_start_addr) == DevW25Qxx_Ok)
+                    {
+                        Storage_ExtFlash_Unlock(dev);
                         return true;
+                    }
+
+                    Storage_ExtFlash_Unlock(dev);
                 }
                 break;
 
@@ -1796,6 +2394,7 @@ static bool Storage_OnChipFlash_Write(uint32_t addr_offset, uint8_t *p_data, uin
             return false;
 
         write_addr += write_size;
+        p_data += write_size;
         len -= write_size;
         if(len && len <= write_size)
             write_size = len;
@@ -2119,6 +2718,9 @@ static void Storage_Test(Storage_MediumType_List medium, Storage_ParaClassType_L
     }
 
     error_code = Storage_CreateItem(medium, class, test_name, test_data, strlen(test_data));
+    if (!Storage_Flush(medium) && (error_code == Storage_Error_None))
+        error_code = Storage_Write_Error;
+
     if(error_code != Storage_Error_None)
     {
         shellPrint(shell_obj, "\t[Storage Test Failed]\r\n");
@@ -2175,7 +2777,7 @@ static void Storage_Module_Format(Storage_MediumType_List medium)
         shellPrint(shell_obj, "\t[Rebuilding storage tab and section]\r\n");
 
         /* rebuild tab */
-        if (!Storage_Build_StorageInfo(External_Flash))
+        if (!Storage_Build_StorageInfo(External_Flash) || !Storage_Flush(External_Flash))
         {
             shellPrint(shell_obj, "\t[Rebuild storage tab and section failed]\r\n");
             return;
@@ -2264,6 +2866,164 @@ static void Storage_Show_ModuleInfo(void)
 }
 SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Storage_Show_ModuleInfo, Storage_Show_ModuleInfo, Storage Format);
 
+static void Storage_Show_Index(Storage_MediumType_List medium)
+{
+    Shell *shell_obj = Shell_GetInstence();
+    Storage_Index_TypeDef *p_index = NULL;
+
+    if (shell_obj == NULL)
+        return;
+
+    Storage_MediumType_Print(shell_obj);
+    p_index = Storage_Get_Index(medium);
+    if (p_index == NULL)
+    {
+        shellPrint(shell_obj, "\t[Medium Type Error]\r\n");
+        return;
+    }
+
+    if (p_index->p_item == NULL)
+    {
+        shellPrint(shell_obj, "\t[Index Unavaliable, Search Traverse Tab]\r\n");
+        return;
+    }
+
+    shellPrint(shell_obj, "\t[index capacity  %d]\r\n", p_index->capacity);
+    shellPrint(shell_obj, "\t[index item      %d]\r\n", p_index->num);
+    shellPrint(shell_obj, "\t[index deleted   %d]\r\n", p_index->deleted);
+    shellPrint(shell_obj, "\t[index max probe %d]\r\n", p_index->max_probe);
+    shellPrint(shell_obj, "\t[index ram size  %d byte]\r\n", p_index->capacity * sizeof(Storage_IndexItem_TypeDef));
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Storage_Show_Index, Storage_Show_Index, Storage Index Info);
+
+/* 
+ * WARNING: destroy data in the scratch subsector of the external flash chip
+ * measure external flash throughput in parameter (small item read modify write)
+ * and blackbox (sequential page program on pre-erased sector) style
+ */
+static void Storage_ExtFlash_Speed(uint32_t loop)
+{
+    Shell *shell_obj = Shell_GetInstence();
+    Storage_ExtFLashDevObj_TypeDef *p_ext_flash = NULL;
+    DevW25Qxx_TypeDef *p_api = NULL;
+    DevW25QxxObj_TypeDef *p_dev = NULL;
+    DevW25Qxx_DeviceInfo_TypeDef info;
+    DevW25Qxx_ReadMode_List read_mode;
+    uint32_t test_addr = 0;
+    uint32_t time_start = 0;
+    uint32_t time_diff = 0;
+    uint32_t poll_cnt = 0;
+    uint32_t page_cnt = 0;
+
+    if (shell_obj == NULL)
+        return;
+
+    if (!Storage_Monitor.module_init_reg.bit.external || (Storage_Monitor.ExtDev_ptr == NULL))
+    {
+        shellPrint(shell_obj, "\t[External_Flash Unavaliable]\r\n");
+        return;
+    }
+
+    p_ext_flash = Storage_Monitor.ExtDev_ptr;
+    if (p_ext_flash->chip_type != Storage_ChipType_W25Qxx)
+        return;
+
+    if (loop == 0)
+        loop = 16;
+
+    p_api = To_DevW25Qxx_API(p_ext_flash->dev_api);
+    p_dev = To_DevW25Qxx_OBJ(p_ext_flash->dev_obj);
+    info = p_api->info(p_dev);
+    read_mode = p_dev->read_mode;
+
+    /* scratch subsector is out of both parameter section and blackbox ring */
+    test_addr = ExtFlash_Scratch_Addr;
+    if ((info.subsector_size == 0) || \
+        (info.subsector_size > sizeof(flash_read_tmp)) || \
+        (info.subsector_size > ExtFlash_Scratch_Size) || \
+        (test_addr % info.subsector_size) || \
+        (test_addr < info.start_addr) || \
+        ((test_addr + info.subsector_size) > (info.start_addr + info.flash_size)))
+    {
+        shellPrint(shell_obj, "\t[No Scratch Subsector]\r\n");
+        return;
+    }
+
+    shellPrint(shell_obj, "\t[test address 0x%08x loop %d]\r\n", test_addr, loop);
+
+    /* read mode is switched on the shared chip object, keep blackbox off the bus meanwhile */
+    if (!Storage_ExtFlash_Lock(p_ext_flash))
+    {
+        shellPrint(shell_obj, "\t[Bus Lock TimeOut]\r\n");
+        return;
+    }
+
+    /* read throughput normal read (0x03) vs fast read (0x0B) */
+    for (uint8_t mode = DevW25Qxx_Read_Normal; mode <= DevW25Qxx_Read_Fast; mode ++)
+    {
+        if (p_api->set_read_mode(p_dev, mode) != DevW25Qxx_Ok)
+            continue;
+
+        time_start = SrvOsCommon.get_os_ms();
+        for (uint32_t i = 0; i < loop; i++)
+            p_api->read(p_dev, test_addr, flash_read_tmp, info.subsector_size);
+        time_diff = SrvOsCommon.get_os_ms() - time_start;
+
+        shellPrint(shell_obj, "\t[%s read  %d byte cost %d ms]\r\n", (mode == DevW25Qxx_Read_Fast) ? "fast" : "normal", loop * info.subsector_size, time_diff);
+    }
+    p_api->set_read_mode(p_dev, read_mode);
+    Storage_ExtFlash_Unlock(p_ext_flash);
+
+    /* parameter style, 64 byte item update cost one read erase program cycle on whole sector */
+    memset(flash_read_tmp, 0x5A, StorageItem_Size);
+    time_start = SrvOsCommon.get_os_ms();
+    for (uint32_t i = 0; i < loop; i++)
+    {
+        /* different item in the same sector, batched by write back cache */
+        flash_read_tmp[0] = i;
+        Storage_ExtFlash_Write(test_addr - Storage_Monitor.external_info.base_addr + (i % (info.subsector_size / StorageItem_Size)) * StorageItem_Size, flash_read_tmp, StorageItem_Size);
+    }
+    Storage_ExtFlash_Flush();
+    Storage_ExtFlash_Cache_Drop(test_addr);
+    time_diff = SrvOsCommon.get_os_ms() - time_start;
+    shellPrint(shell_obj, "\t[param  write %d item cost %d ms]\r\n", loop, time_diff);
+    shellPrint(shell_obj, "\t[sector cache hit %d miss %d flush %d]\r\n", ExtFlash_Cache.hit_cnt, ExtFlash_Cache.miss_cnt, ExtFlash_Cache.flush_cnt);
+
+    /* blackbox style, erase once then program page by page without blocking */
+    if (!Storage_ExtFlash_Lock(p_ext_flash))
+    {
+        shellPrint(shell_obj, "\t[Bus Lock TimeOut]\r\n");
+        return;
+    }
+
+    time_start = SrvOsCommon.get_os_ms();
+    if (p_api->erase_sector(p_dev, test_addr) != DevW25Qxx_Ok)
+    {
+        Storage_ExtFlash_Unlock(p_ext_flash);
+        shellPrint(shell_obj, "\t[erase failed]\r\n");
+        return;
+    }
+    time_diff = SrvOsCommon.get_os_ms() - time_start;
+    shellPrint(shell_obj, "\t[sector erase cost %d ms]\r\n", time_diff);
+
+    memset(flash_read_tmp, 0xA5, info.page_size);
+    page_cnt = info.subsector_size / info.page_size;
+    time_start = SrvOsCommon.get_os_ms();
+    for (uint32_t i = 0; i < page_cnt; i++)
+    {
+        while (p_api->write_page_nowait(p_dev, test_addr + i * info.page_size, flash_read_tmp, info.page_size) == DevW25Qxx_Busy)
+            poll_cnt ++;
+    }
+    while (p_api->busy(p_dev) == DevW25Qxx_Busy)
+        poll_cnt ++;
+    time_diff = SrvOsCommon.get_os_ms() - time_start;
+    Storage_ExtFlash_Unlock(p_ext_flash);
+    shellPrint(shell_obj, "\t[blackbox write %d byte cost %d ms busy poll %d]\r\n", page_cnt * info.page_size, time_diff, poll_cnt);
+
+    memset(flash_read_tmp, 0, sizeof(flash_read_tmp));
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Storage_ExtFlash_Speed, Storage_ExtFlash_Speed, External flash throughput test);
+
 static void Storage_Show_FreeSlot(Storage_MediumType_List medium, Storage_ParaClassType_List class)
 {
     Storage_FlashInfo_TypeDef *p_Flash = NULL;
@@ -2899,6 +3659,9 @@ static void Storage_UpdateData(Storage_MediumType_List medium, Storage_ParaClass
     }
 
     update_error_code = Storage_SlotData_Update(medium, class, item.data_addr, test_data, strlen(test_data)); 
+    if (!Storage_Flush(medium) && (update_error_code == Storage_Error_None))
+        update_error_code = Storage_Write_Error;
+
     if (update_error_code != Storage_Error_None)
     {
         shellPrint(shell_obj, "\t[Data update failed %s]\r\n", Storage_Error_Print(update_error_code));
@@ -25,6 +25,7 @@
 #define Storage_ReserveBlock_Size 128
 
 #define Storage_ExtFlash_Max_Capacity (1 Kb)
+#define ExtFlash_BusLock_TimeOut 1000   /* unit: ms, longer than one sector erase and program */
 
 #define StorageItem_Size sizeof(Storage_Item_TypeDef)
 
@@ -42,6 +43,11 @@
 #define STORAGE_MIN_BYTE_SIZE 1
 #define STORAGE_FREEITEM_NAME "Item_Avaliable"
 
+#define STORAGE_INDEX_MIN_CAPACITY 32   /* must be power of 2 */
+#define STORAGE_INDEX_LOAD_FACTOR 75    /* percent, grow index when reached */
+#define STORAGE_FNV_OFFSET_BASIS 0x811C9DC5
+#define STORAGE_FNV_PRIME 0x01000193
+
 typedef uint32_t storage_handle;
 
 typedef enum
@@ -180,6 +186,35 @@ typedef struct
 } Storage_FlashInfo_TypeDef;
 #pragma pack()
 
+typedef enum
+{
+    Storage_IndexItem_Empty = 0,
+    Storage_IndexItem_Used,
+    Storage_IndexItem_Deleted,
+} Storage_IndexItemState_List;
+
+/* in ram copy of tab item, locate by name hash */
+typedef struct
+{
+    uint32_t name_hash;     /* FNV-1a */
+    uint16_t name_crc;      /* second check, avoid hash collision matched */
+    uint8_t class;
+    uint8_t state;
+    uint32_t item_addr;     /* item address in tab */
+    uint32_t data_addr;
+    uint16_t len;
+    uint16_t item_crc;
+} Storage_IndexItem_TypeDef;
+
+typedef struct
+{
+    uint16_t capacity;
+    uint16_t num;
+    uint16_t deleted;
+    uint16_t max_probe;
+    Storage_IndexItem_TypeDef *p_item;
+} Storage_Index_TypeDef;
+
 typedef union
 {
     struct
@@ -216,6 +251,9 @@ typedef struct
 
     void *dev_obj;
     void *dev_api;
+
+    /* chip is shared by storage and blackbox, hold it through every chip transaction */
+    osMutexId bus_lock;
 } Storage_ExtFLashDevObj_TypeDef;
 
 typedef struct
@@ -244,14 +282,19 @@ typedef struct
 
     Storage_FlashInfo_TypeDef internal_info;
     Storage_FlashInfo_TypeDef external_info;
+
+    Storage_Index_TypeDef internal_index;
+    Storage_Index_TypeDef external_index;
 } Storage_Monitor_TypeDef;
 
 typedef struct
 {
     bool (*init)(Storage_ModuleState_TypeDef enable, Storage_ExtFLashDevObj_TypeDef *ExtDev);
     storage_handle (*search)(Storage_MediumType_List medium, Storage_ParaClassType_List class, const char *name);
-    bool (*save)(storage_handle hdl, uint8_t *p_data, uint16_t size);
-    bool (*get)(storage_handle hdl, uint8_t *p_data, uint16_t size);
+    Storage_ErrorCode_List (*create)(Storage_MediumType_List medium, Storage_ParaClassType_List class, const char *name, uint8_t *p_data, uint32_t size);
+    Storage_ErrorCode_List (*update)(Storage_MediumType_List medium, Storage_ParaClassType_List class, storage_handle hdl, uint8_t *p_data, uint16_t size);
+    Storage_ErrorCode_List (*get)(Storage_MediumType_List medium, Storage_ParaClassType_List class, storage_handle hdl, uint8_t *p_data, uint16_t size);
+    bool (*flush)(Storage_MediumType_List medium);    /* create / update only land in the medium cache until flush */
     bool (*clear)(storage_handle hdl);
 } Storage_TypeDef;
 
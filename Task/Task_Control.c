@@ -8,7 +8,9 @@
 #include "Task_Telemetry.h"
 #include "Srv_DataHub.h"
 #include "Srv_Actuator.h"
+#include "Srv_Param.h"
 #include "shell_port.h"
+#include "profiler.h"
 
 #define DEFAULT_CONTROL_MODEL Model_Quad
 #define DEFAULT_ESC_TYPE DevDshot_600
@@ -17,7 +19,9 @@
 #define ATTITUDE_PID_DIFF_MAX 30    /* unit: deg */
 #define ATTITUDE_PID_DIFF_MIN -30   /* unit: deg */
 
-#define ANGULAR_PID_ACCURACY 1000
+#define ANGULAR_CTL_I_MAX 100.0f
+#define ANGULAR_CTL_OUT_MAX 500.0f
+#define ANGULAR_CTL_D_LPF_CUTOFF 80.0f  /* unit: Hz */
 
 DataPipe_CreateDataObj(ControlData_TypeDef, Smp_Inuse_CtlData);
 
@@ -26,6 +30,7 @@ static uint32_t att_update_time = 0;
 static uint32_t tunning_time_stamp = 0;
 static uint8_t imu_err_code;
 static bool arm_state = true;
+static bool lst_arm_state = true;
 static bool failsafe = false;
 static bool imu_init_state = false;
 static bool att_update = false;
@@ -45,7 +50,16 @@ TaskControl_Monitor_TypeDef TaskControl_Monitor = {
     .IMU_Rt = 0,
 };
 
+typedef struct
+{
+    const char *name;
+    float *p_val;
+    SrvParam_Update_Callback callback;
+} TaskControl_Param_TypeDef;
+
 /* internal function */
+static void TaskControl_RateGain_Update(void *p_val);
+static void TaskControl_RateDTermLpf_Update(void *p_val);
 static bool TaskControl_AttitudeRing_PID_Update(TaskControl_Monitor_TypeDef *monitor, bool att_state);
 static bool TaskControl_AngularSpeedRing_PID_Update(TaskControl_Monitor_TypeDef *monitor);
 static void TaskControl_FlightControl_Polling(Srv_CtlExpectionData_TypeDef *exp_ctl_val);
@@ -54,6 +68,31 @@ static void TaskControl_CLI_Polling(void);
 
 /* internal var */
 static uint32_t TaskControl_Period = 0;
+static Kernel_CycleStatistic_TypeDef TaskControl_CycleStatistic;
+static float TaskControl_DTermLpf_Cutoff = ANGULAR_CTL_D_LPF_CUTOFF;
+
+/* tunable through mavlink parameter protocol, default is the value set in init */
+static const TaskControl_Param_TypeDef TaskControl_Param_List[] = {
+    {"ATT_PIT_P",   &TaskControl_Monitor.PitchCtl_PIDObj.gP, NULL},
+    {"ATT_PIT_I",   &TaskControl_Monitor.PitchCtl_PIDObj.gI, NULL},
+    {"ATT_PIT_D",   &TaskControl_Monitor.PitchCtl_PIDObj.gD, NULL},
+    {"ATT_ROL_P",   &TaskControl_Monitor.RollCtl_PIDObj.gP,  NULL},
+    {"ATT_ROL_I",   &TaskControl_Monitor.RollCtl_PIDObj.gI,  NULL},
+    {"ATT_ROL_D",   &TaskControl_Monitor.RollCtl_PIDObj.gD,  NULL},
+    {"RATE_X_P",    &TaskControl_Monitor.GyrCtl.gP[Axis_X],  TaskControl_RateGain_Update},
+    {"RATE_X_I",    &TaskControl_Monitor.GyrCtl.gI[Axis_X],  TaskControl_RateGain_Update},
+    {"RATE_X_D",    &TaskControl_Monitor.GyrCtl.gD[Axis_X],  TaskControl_RateGain_Update},
+    {"RATE_X_FF",   &TaskControl_Monitor.GyrCtl.gFF[Axis_X], TaskControl_RateGain_Update},
+    {"RATE_Y_P",    &TaskControl_Monitor.GyrCtl.gP[Axis_Y],  TaskControl_RateGain_Update},
+    {"RATE_Y_I",    &TaskControl_Monitor.GyrCtl.gI[Axis_Y],  TaskControl_RateGain_Update},
+    {"RATE_Y_D",    &TaskControl_Monitor.GyrCtl.gD[Axis_Y],  TaskControl_RateGain_Update},
+    {"RATE_Y_FF",   &TaskControl_Monitor.GyrCtl.gFF[Axis_Y], TaskControl_RateGain_Update},
+    {"RATE_Z_P",    &TaskControl_Monitor.GyrCtl.gP[Axis_Z],  TaskControl_RateGain_Update},
+    {"RATE_Z_I",    &TaskControl_Monitor.GyrCtl.gI[Axis_Z],  TaskControl_RateGain_Update},
+    {"RATE_Z_D",    &TaskControl_Monitor.GyrCtl.gD[Axis_Z],  TaskControl_RateGain_Update},
+    {"RATE_Z_FF",   &TaskControl_Monitor.GyrCtl.gFF[Axis_Z], TaskControl_RateGain_Update},
+    {"RATE_D_LPF",  &TaskControl_DTermLpf_Cutoff,            TaskControl_RateDTermLpf_Update},
+};
 
 void TaskControl_Init(uint32_t period)
 {
@@ -92,36 +131,19 @@ void TaskControl_Init(uint32_t period)
     TaskControl_Monitor.RollCtl_PIDObj.gI_Min = -50;
     TaskControl_Monitor.RollCtl_PIDObj.gD = 1;
 
-    /* angular PID control parameter section */
-    TaskControl_Monitor.GyrXCtl_PIDObj.accuracy_scale = ANGULAR_PID_ACCURACY;
-    // TaskControl_Monitor.GyrXCtl_PIDObj.diff_max       =;
-    // TaskControl_Monitor.GyrXCtl_PIDObj.diff_min       =;
-
-    // TaskControl_Monitor.GyrXCtl_PIDObj.gP = ;
-    // TaskControl_Monitor.GyrXCtl_PIDObj.gI = ;
-    // TaskControl_Monitor.GyrXCtl_PIDObj.gI_Max = ;
-    // TaskControl_Monitor.GyrXCtl_PIDObj.gI_Min = ;
-    // TaskControl_Monitor.GyrXCtl_PIDObj.gD = ;
+    /* angular speed control parameter section */
+    RateCtl_Init(&TaskControl_Monitor.GyrCtl, period * 0.001f);
+    for(i = Axis_X; i < Axis_Sum; i++)
+    {
+        /* gain not tuned yet, output stay zero until set */
+        RateCtl_Set_Gain(&TaskControl_Monitor.GyrCtl, i, 0.0f, 0.0f, 0.0f, 0.0f);
+        RateCtl_Set_Limit(&TaskControl_Monitor.GyrCtl, i, ANGULAR_CTL_I_MAX, ANGULAR_CTL_OUT_MAX);
+        RateCtl_Set_DTermLpf(&TaskControl_Monitor.GyrCtl, i, ANGULAR_CTL_D_LPF_CUTOFF);
+    }
 
-    TaskControl_Monitor.GyrYCtl_PIDObj.accuracy_scale = ANGULAR_PID_ACCURACY;
-    // TaskControl_Monitor.GyrYCtl_PIDObj.diff_max       =;
-    // TaskControl_Monitor.GyrYCtl_PIDObj.diff_min       =;
-    
-    // TaskControl_Monitor.GyrYCtl_PIDObj.gP = ;
-    // TaskControl_Monitor.GyrYCtl_PIDObj.gI = ;
-    // TaskControl_Monitor.GyrYCtl_PIDObj.gI_Max = ;
-    // TaskControl_Monitor.GyrYCtl_PIDObj.gI_Min = ;
-    // TaskControl_Monitor.GyrYCtl_PIDObj.gD = ;
-
-    TaskControl_Monitor.GyrZCtl_PIDObj.accuracy_scale = ANGULAR_PID_ACCURACY;
-    // TaskControl_Monitor.PitchCtl_PIDObj.diff_max       =;
-    // TaskControl_Monitor.RollCtl_PIDObj.diff_min        =;
-    
-    // TaskControl_Monitor.GyrZCtl_PIDObj.gP = ;
-    // TaskControl_Monitor.GyrZCtl_PIDObj.gI = ;
-    // TaskControl_Monitor.GyrZCtl_PIDObj.gI_Max = ;
-    // TaskControl_Monitor.GyrZCtl_PIDObj.gI_Min = ;
-    // TaskControl_Monitor.GyrZCtl_PIDObj.gD = ;
+    /* stored value override the default above */
+    for(i = 0; i < (sizeof(TaskControl_Param_List) / sizeof(TaskControl_Param_List[0])); i++)
+        SrvParam.regist(TaskControl_Param_List[i].name, SrvParam_F32, TaskControl_Param_List[i].p_val, TaskControl_Param_List[i].callback);
 
     osMessageQDef(MotoCLI_Data, 64, TaskControl_CLIData_TypeDef);
     TaskControl_Monitor.CLIMessage_ID = osMessageCreate(osMessageQ(MotoCLI_Data), NULL);
@@ -180,17 +202,35 @@ void TaskControl_Init(uint32_t period)
     TaskControl_Period = period;
 }
 
+/* gain applied through rate ctl so the integral limit follow the new gI */
+static void TaskControl_RateGain_Update(void *p_val)
+{
+    RateCtl_Obj_TypeDef *obj = &TaskControl_Monitor.GyrCtl;
+    UNUSED(p_val);
+
+    for(uint8_t axis = Axis_X; axis < Axis_Sum; axis++)
+        RateCtl_Set_Gain(obj, axis, obj->gP[axis], obj->gI[axis], obj->gD[axis], obj->gFF[axis]);
+}
+
+static void TaskControl_RateDTermLpf_Update(void *p_val)
+{
+    for(uint8_t axis = Axis_X; axis < Axis_Sum; axis++)
+        RateCtl_Set_DTermLpf(&TaskControl_Monitor.GyrCtl, axis, *(float *)p_val);
+}
+
 void TaskControl_Core(void const *arg)
 {
     uint32_t sys_time = SrvOsCommon.get_os_ms();
     ControlData_TypeDef CtlData;
     Srv_CtlExpectionData_TypeDef Cnv_CtlData;
+    uint32_t start_cyc = 0;
     
     memset(&CtlData, 0, sizeof(Srv_CtlDataArbitrate_TypeDef));
     memset(&Cnv_CtlData, 0, sizeof(ControlData_TypeDef));
 
     while(1)
     {
+        start_cyc = Kernel_Get_CycleCnt();
         Srv_CtlDataArbitrate.negociate_update(&CtlData);
         
         if(control_enable && !TaskControl_Monitor.CLI_enable)
@@ -217,10 +257,17 @@ void TaskControl_Core(void const *arg)
         /* pipe in use control data to data hub */
         DataPipe_SendTo(&InUseCtlData_Smp_DataPipe, &InUseCtlData_hub_DataPipe);
 
+        Kernel_CycleStatistic_Update(&TaskControl_CycleStatistic, start_cyc);
+        Profiler.section_end(Profiler_Sec_Control, start_cyc);
         SrvOsCommon.precise_delay(&sys_time, TaskControl_Period);
     }
 }
 
+Kernel_CycleStatistic_TypeDef *TaskControl_Get_CycleStatistic(void)
+{
+    return &TaskControl_CycleStatistic;
+}
+
 static bool TaskControl_AttitudeRing_PID_Update(TaskControl_Monitor_TypeDef *monitor, bool att_state)
 {
     if(monitor)
@@ -246,14 +293,8 @@ static bool TaskControl_AngularSpeedRing_PID_Update(TaskControl_Monitor_TypeDef
 {
     if(monitor && monitor->att_pid_state)
     {
-        /* gyro X PID Update */
-        PID_Update(&monitor->GyrXCtl_PIDObj, monitor->gyr[Axis_X], monitor->GyrXCtl_PIDObj.exp);
-
-        /* gyro Y PID Update */
-        PID_Update(&monitor->GyrYCtl_PIDObj, monitor->gyr[Axis_Y], monitor->GyrYCtl_PIDObj.exp);
-
-        /* gyro Z PID Update */
-        PID_Update(&monitor->GyrZCtl_PIDObj, monitor->gyr[Axis_Z], monitor->GyrZCtl_PIDObj.exp);
+        /* gyro X Y Z control update */
+        RateCtl_Update(&monitor->GyrCtl, monitor->gyr, monitor->exp_gyr);
 
         return true;
     }
@@ -269,9 +310,9 @@ static void TaskControl_Actuator_ControlValue_Update(TaskControl_Monitor_TypeDef
     {
         ctl_buf[Actuator_Ctl_Throttle] = monitor->throttle_percent;
 
-        ctl_buf[Actuator_Ctl_GyrX] = monitor->GyrXCtl_PIDObj.fout;
-        ctl_buf[Actuator_Ctl_GyrY] = monitor->GyrYCtl_PIDObj.fout;
-        ctl_buf[Actuator_Ctl_GyrZ] = monitor->GyrZCtl_PIDObj.fout;
+        ctl_buf[Actuator_Ctl_GyrX] = monitor->GyrCtl.fout[Axis_X];
+        ctl_buf[Actuator_Ctl_GyrY] = monitor->GyrCtl.fout[Axis_Y];
+        ctl_buf[Actuator_Ctl_GyrZ] = monitor->GyrCtl.fout[Axis_Z];
     }
 
     SrvActuator.moto_control(ctl_buf);
@@ -291,6 +332,13 @@ static void TaskControl_FlightControl_Polling(Srv_CtlExpectionData_TypeDef *exp_
         // get failsafe
         SrvDataHub.get_arm_state(&arm_state);
         SrvDataHub.get_failsafe(&failsafe);
+
+        /* integral and d term history must not carry over from one flight into the next */
+        if(arm_state != lst_arm_state)
+        {
+            RateCtl_Reset(&TaskControl_Monitor.GyrCtl);
+            lst_arm_state = arm_state;
+        }
         
         SrvDataHub.get_tunning_state(&tunning_time_stamp, &tunning_state, &tunning_port);
 
@@ -441,19 +489,19 @@ static void TaskControl_FlightControl_Polling(Srv_CtlExpectionData_TypeDef *exp_
     
                 TaskControl_AttitudeRing_PID_Update(&TaskControl_Monitor, att_update);
                 
-                TaskControl_Monitor.GyrXCtl_PIDObj.exp = TaskControl_Monitor.RollCtl_PIDObj.fout;
-                TaskControl_Monitor.GyrYCtl_PIDObj.exp = TaskControl_Monitor.PitchCtl_PIDObj.fout;
+                TaskControl_Monitor.exp_gyr[Axis_X] = TaskControl_Monitor.RollCtl_PIDObj.fout;
+                TaskControl_Monitor.exp_gyr[Axis_Y] = TaskControl_Monitor.PitchCtl_PIDObj.fout;
 
                 exp_ctl_val->exp_angularspeed[Axis_X] = TaskControl_Monitor.RollCtl_PIDObj.fout;
                 exp_ctl_val->exp_angularspeed[Axis_Y] = TaskControl_Monitor.PitchCtl_PIDObj.fout;
             }
             else
             {
-                TaskControl_Monitor.GyrXCtl_PIDObj.exp = exp_ctl_val->exp_angularspeed[Axis_X];
-                TaskControl_Monitor.GyrYCtl_PIDObj.exp = exp_ctl_val->exp_angularspeed[Axis_Y];
+                TaskControl_Monitor.exp_gyr[Axis_X] = exp_ctl_val->exp_angularspeed[Axis_X];
+                TaskControl_Monitor.exp_gyr[Axis_Y] = exp_ctl_val->exp_angularspeed[Axis_Y];
             }
 
-            TaskControl_Monitor.GyrZCtl_PIDObj.exp = exp_ctl_val->exp_angularspeed[Axis_Z];
+            TaskControl_Monitor.exp_gyr[Axis_Z] = exp_ctl_val->exp_angularspeed[Axis_Z];
             TaskControl_AngularSpeedRing_PID_Update(&TaskControl_Monitor);
             TaskControl_Actuator_ControlValue_Update(&TaskControl_Monitor);
 
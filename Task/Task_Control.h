@@ -7,7 +7,9 @@
 #include "imu_data.h"
 #include "Srv_OsCommon.h"
 #include "pid.h"
+#include "rate_ctl.h"
 #include "../common/util.h"
+#include "kernel.h"
 
 #define TASKCONTROL_SET_BIT(x) UTIL_SET_BIT(x)
 #define IMU_ERROR_UPDATE_MAX_COUNT 10
@@ -93,10 +95,8 @@ typedef struct
     PIDObj_TypeDef RollCtl_PIDObj;
     PIDObj_TypeDef PitchCtl_PIDObj;
 
-    /* inner ring angular speed control pid */
-    PIDObj_TypeDef GyrXCtl_PIDObj;
-    PIDObj_TypeDef GyrYCtl_PIDObj;
-    PIDObj_TypeDef GyrZCtl_PIDObj;
+    /* inner ring angular speed control, all 3 axis in one object */
+    RateCtl_Obj_TypeDef GyrCtl;
 
     osMessageQId CLIMessage_ID;
 } TaskControl_Monitor_TypeDef;
@@ -126,5 +126,6 @@ typedef struct
 
 void TaskControl_Init(uint32_t period);
 void TaskControl_Core(void const *arg);
+Kernel_CycleStatistic_TypeDef *TaskControl_Get_CycleStatistic(void);
 
 #endif
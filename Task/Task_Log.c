@@ -17,12 +17,21 @@
 #include "Task_Sample.h"
 #include "Dev_Led.h"
 #include "HW_Def.h"
-#include "minilzo.h"
+#include "imu_codec.h"
+#include "log_topic.h"
+#include "Srv_DataHub.h"
+#include "Blackbox.h"
 #include "Srv_OsCommon.h"
+#include "kernel.h"
+#include "profiler.h"
+#include "evt_trace.h"
+#include "shell_port.h"
 #include <stdio.h>
 
 #define LOG_FOLDER "log/"
 #define IMU_LOG_FILE "imu.log"
+#define TRACE_FILE "trace.trc"
+#define TRACE_WRITE_UNIT 512
 
 #define K_BYTE 1024
 #define M_BYTE (K_BYTE * K_BYTE)
@@ -30,13 +39,14 @@
 #define MAX_FILE_SIZE_K(x) (x * K_BYTE)
 #define MIN_CACHE_NUM 2
 
-#define LOG_COMPESS_HEADER 0xCA
+#define LOG_CODEC_HEADER 0xCB /* 0xCA was the lzo frame */
 #define LOG_COMPESS_ENDER 0xED
+#define LOG_CODEC_POP_SIZE (IMU_CODEC_BLOCK_SIZE * sizeof(ImuCodec_Sample_TypeDef))
 
-#define HEAP_ALLOC(var,size) \
-    lzo_align_t __LZO_MMODEL var [ ((size) + (sizeof(lzo_align_t) - 1)) / sizeof(lzo_align_t) ]
-
-static HEAP_ALLOC(wrkmem, LZO1X_1_MEM_COMPRESS);
+/* schema repeated so a wrapped blackbox or a cut log still decode from the next schema on */
+#define LOG_TOPIC_SCHEMA_PERIOD_MS 1000
+#define LOG_TOPIC_RC_CH_NUM 16
+#define LOG_TOPIC_MOTO_NUM 8
 
 typedef struct
 {
@@ -50,17 +60,11 @@ typedef struct
 }LogSummary_TypeDef;
 
 /* internal variable */
-static const LogData_Header_TypeDef LogIMU_Header = {
-    .header = LOG_HEADER,
-    .type = LOG_DATATYPE_IMU,
-    .size = sizeof(LogIMUDataUnion_TypeDef),
-};
-
 typedef struct
 {
     uint8_t buf[MAX_FILE_SIZE_K(2)];
     uint16_t compess_size;
-    uint8_t total;
+    uint16_t total;
 }LogCompess_Data_TypeDef;
 
 static LogCompess_Data_TypeDef LogCompess_Data = {
@@ -84,6 +88,14 @@ static LogData_Reg_TypeDef LogObj_Logging_Reg;
 static uint16_t QueueIMU_PopSize = 0;
 static uint32_t TaskLog_Period = 0;
 static Log_Statistics_TypeDef Log_Statistics;
+static bool LogTopic_Schema_Ready = false;
+static uint32_t LogTopic_Schema_Time = 0;
+#if (SD_CARD_ENABLE_STATE == ON)
+static volatile bool TraceSave_Req = false;
+static uint8_t TraceSave_Buf[TRACE_WRITE_UNIT];
+static uint16_t TraceSave_Len = 0;
+static bool TraceSave_Error = false;
+#endif
 
 static LogSummary_TypeDef LogIMU_Summary = {
     .max_rt_diff = 0,
@@ -97,7 +109,13 @@ static LogSummary_TypeDef LogIMU_Summary = {
 
 /* internal function */
 static void TaskLog_PipeTransFinish_Callback(DataPipeObj_TypeDef *obj);
+static bool TaskLog_Flush(void);
+static bool TaskLog_Append_Topic(uint32_t sys_ms);
+static void TaskLog_Topic_Regist(void);
 static void TaskLog_PushINFO_Data(uint8_t *info, uint16_t len);
+#if (SD_CARD_ENABLE_STATE == ON)
+static void TaskLog_Trace_Save(void);
+#endif
 
 void TaskLog_Init(uint32_t period)
 {
@@ -114,7 +132,9 @@ void TaskLog_Init(uint32_t period)
     LogObj_Logging_Reg.reg_val = 0;
 
     INFO_Queue_CreateState = Queue.create_auto(&INFO_Queue, "LOG Info", 1024);
+    TaskLog_Topic_Regist();
 
+#if (SD_CARD_ENABLE_STATE == ON)
     /* init module first then init task */
     if (Disk.init(&FATFS_Obj, TaskLog_PushINFO_Data))
     {
@@ -133,9 +153,6 @@ void TaskLog_Init(uint32_t period)
                 LogObj_Set_Reg._sec.IMU_Sec = true;
             
                 DataPipe_Enable(&IMU_Log_DataPipe);
-
-                if (lzo_init() != LZO_E_OK)
-                    enable_compess = false;
             }
         }
         else
@@ -148,6 +165,25 @@ void TaskLog_Init(uint32_t period)
     }
     else
         DataPipe_Disable(&IMU_Log_DataPipe);
+#else
+    /* no sd card, append compessed frame into blackbox on external flash */
+    if (Blackbox.ready() && Blackbox.start() && \
+        Queue.create_with_buf(&IMUData_Queue, "queue imu data", LogCache_L1_Buf, sizeof(LogCache_L1_Buf)))
+    {
+        LogFile_Ready = true;
+        LogObj_Enable_Reg._sec.IMU_Sec = true;
+        LogObj_Set_Reg._sec.IMU_Sec = true;
+
+        DataPipe_Enable(&IMU_Log_DataPipe);
+    }
+    else
+    {
+        LogFile_Ready = false;
+        LogObj_Enable_Reg._sec.IMU_Sec = false;
+        LogObj_Set_Reg._sec.IMU_Sec = false;
+        DataPipe_Disable(&IMU_Log_DataPipe);
+    }
+#endif
     
     TaskLog_Period = period;
 }
@@ -155,14 +191,14 @@ void TaskLog_Init(uint32_t period)
 void TaskLog_Core(void const *arg)
 {
     uint8_t *compess_buf_ptr = NULL;
-    uint16_t cur_compess_size = 0;
+    uint32_t cur_compess_size = 0;
     uint16_t input_compess_size = 0;
-    bool log_halt = false;
-    uint32_t income_log_size = 0;
     uint32_t sys_time = SrvOsCommon.get_os_ms();
+    uint32_t start_cyc = 0;
 
     while(1)
     {
+        start_cyc = Kernel_Get_CycleCnt();
         input_compess_size = QueueIMU_PopSize;
         // DebugPin.ctl(Debug_PB5, true);
 
@@ -175,9 +211,14 @@ void TaskLog_Core(void const *arg)
             {
                 QueueIMU_PopSize = 0;
                 LogObj_Logging_Reg._sec.IMU_Sec = true;
-                LogCompess_Data.buf[LogCompess_Data.compess_size] = LOG_COMPESS_HEADER;
-
-                if(lzo1x_1_compress(LogCache_L2_Buf, input_compess_size, compess_buf_ptr, &cur_compess_size, wrkmem) != LZO_E_OK)
+                LogCompess_Data.buf[LogCompess_Data.compess_size] = LOG_CODEC_HEADER;
+
+                /* frame : header + u32 size + codec block + ender */
+                cur_compess_size = ImuCodec_Encode((const ImuCodec_Sample_TypeDef *)LogCache_L2_Buf,
+                                                   input_compess_size / sizeof(ImuCodec_Sample_TypeDef),
+                                                   compess_buf_ptr,
+                                                   LogCompess_Data.total - (LogCompess_Data.compess_size + sizeof(uint32_t) + 2 * sizeof(uint8_t)));
+                if(cur_compess_size == 0)
                 {
                     enable_compess = false;
                     Log_Statistics.halt_type = Log_CompessFunc_Halt;
@@ -202,48 +243,7 @@ void TaskLog_Core(void const *arg)
                         LogCompess_Data.compess_size ++;
                         LogObj_Logging_Reg._sec.IMU_Sec = false;
 
-                        income_log_size = LogCompess_Data.compess_size;
-                        while(income_log_size >= 512)
-                        {
-                            // DebugPin.ctl(Debug_PB4, true);
-
-                            switch((uint8_t)Disk.write(&FATFS_Obj, &LogFile_Obj, LogCompess_Data.buf, 512))
-                            {
-                                case Disk_Write_Error:
-                                    log_halt = true;
-                                    Log_Statistics.halt_type = Log_DiskOprError_Halt;
-                                    break;
-
-                                case Disk_Write_Finish:
-                                    log_halt = true;
-                                    Log_Statistics.halt_type = Log_Finish_Halt;
-                                    break;
-                                
-                                default:
-                                    break;
-                            }
-
-                            /* some error triggered or log finish */
-                            if(log_halt)
-                            {
-                                LogFile_Ready = false;
-                                DataPipe_Disable(&IMU_Log_DataPipe);
-                                break;
-                            }
-
-                            Log_Statistics.write_file_cnt ++;
-                            Log_Statistics.log_byte_sum += 512;
-                            income_log_size -= 512;
-                            LogCompess_Data.compess_size = income_log_size;
-
-                            for(uint16_t t = 0; t < LogCompess_Data.compess_size; t++)
-                            {
-                                LogCompess_Data.buf[t] = LogCompess_Data.buf[t + 512];
-                                LogCompess_Data.buf[t + 512] = 0;
-                            }
-                        
-                            // DebugPin.ctl(Debug_PB4, false);
-                        }
+                        TaskLog_Flush();
                     }
                 }
 
@@ -253,16 +253,320 @@ void TaskLog_Core(void const *arg)
         else
             DevLED.ctl(Led1, false);
 
+        /* attitude / control / receiver / baro / actuator topic share the imu frame stream */
+        if(LogFile_Ready && TaskLog_Append_Topic(SrvOsCommon.get_os_ms()))
+            TaskLog_Flush();
+
+#if (SD_CARD_ENABLE_STATE == OFF)
+        /* program cached page and pre-erase next segment while flash chip is idle */
+        Blackbox.process();
+#else
+        if (TraceSave_Req)
+        {
+            TaskLog_Trace_Save();
+            TraceSave_Req = false;
+        }
+#endif
+
         // DebugPin.ctl(Debug_PB5, false);
 
+        Profiler.section_end(Profiler_Sec_Log, start_cyc);
         SrvOsCommon.precise_delay(&sys_time, TaskLog_Period);
     }
 }
 
+/************************************************** log topic section ************************************************/
+#pragma pack(1)
+typedef struct
+{
+    float pitch;
+    float roll;
+    float yaw;
+    float q[4];
+    uint8_t flip_over;
+} LogTopic_Att_TypeDef;
+
+typedef struct
+{
+    int16_t gimbal[Gimbal_Sum];
+    float exp_att[2];
+    float exp_gyr[Axis_Sum];
+    uint8_t mode;
+    uint8_t source;
+    uint8_t arm;
+    uint8_t failsafe;
+} LogTopic_Ctl_TypeDef;
+
+typedef struct
+{
+    uint8_t ch_num;
+    uint16_t ch[LOG_TOPIC_RC_CH_NUM];
+    uint16_t rssi;
+    uint8_t failsafe;
+} LogTopic_RC_TypeDef;
+
+typedef struct
+{
+    float pressure;
+    float alt;
+    float alt_offset;
+    float temp;
+    uint8_t error;
+} LogTopic_Baro_TypeDef;
+
+typedef struct
+{
+    uint8_t num;
+    uint16_t ch[LOG_TOPIC_MOTO_NUM];
+    float rpm[LOG_TOPIC_MOTO_NUM];
+} LogTopic_Moto_TypeDef;
+#pragma pack()
+
+/* field list must follow the record struct member order */
+static const LogTopic_Field_TypeDef LogTopic_Att_Field[] = {
+    {"pitch", LogTopic_F32, 1},
+    {"roll", LogTopic_F32, 1},
+    {"yaw", LogTopic_F32, 1},
+    {"q", LogTopic_F32, 4},
+    {"flip_over", LogTopic_U8, 1},
+};
+
+static const LogTopic_Field_TypeDef LogTopic_Ctl_Field[] = {
+    {"gimbal", LogTopic_I16, Gimbal_Sum},
+    {"exp_att", LogTopic_F32, 2},
+    {"exp_gyr", LogTopic_F32, Axis_Sum},
+    {"mode", LogTopic_U8, 1},
+    {"source", LogTopic_U8, 1},
+    {"arm", LogTopic_U8, 1},
+    {"failsafe", LogTopic_U8, 1},
+};
+
+static const LogTopic_Field_TypeDef LogTopic_RC_Field[] = {
+    {"ch_num", LogTopic_U8, 1},
+    {"ch", LogTopic_U16, LOG_TOPIC_RC_CH_NUM},
+    {"rssi", LogTopic_U16, 1},
+    {"failsafe", LogTopic_U8, 1},
+};
+
+static const LogTopic_Field_TypeDef LogTopic_Baro_Field[] = {
+    {"pressure", LogTopic_F32, 1},
+    {"alt", LogTopic_F32, 1},
+    {"alt_offset", LogTopic_F32, 1},
+    {"temp", LogTopic_F32, 1},
+    {"error", LogTopic_U8, 1},
+};
+
+static const LogTopic_Field_TypeDef LogTopic_Moto_Field[] = {
+    {"num", LogTopic_U8, 1},
+    {"ch", LogTopic_U16, LOG_TOPIC_MOTO_NUM},
+    {"rpm", LogTopic_F32, LOG_TOPIC_MOTO_NUM},
+};
+
+static bool TaskLog_Fill_Att(uint8_t *p_record)
+{
+    LogTopic_Att_TypeDef rec;
+    uint32_t time_stamp = 0;
+    bool flip_over = false;
+
+    if (!SrvDataHub.get_attitude(&time_stamp, &rec.pitch, &rec.roll, &rec.yaw, &rec.q[0], &rec.q[1], &rec.q[2], &rec.q[3], &flip_over))
+        return false;
+
+    rec.flip_over = flip_over;
+    memcpy(p_record, &rec, sizeof(rec));
+    return true;
+}
+
+static bool TaskLog_Fill_Ctl(uint8_t *p_record)
+{
+    LogTopic_Ctl_TypeDef rec;
+    ControlData_TypeDef ctl;
+
+    if (!SrvDataHub.get_inuse_control_data(&ctl))
+        return false;
+
+    memcpy(rec.gimbal, ctl.gimbal, sizeof(rec.gimbal));
+    rec.exp_att[0] = ctl.exp_att_pitch;
+    rec.exp_att[1] = ctl.exp_att_roll;
+    rec.exp_gyr[Axis_X] = ctl.exp_gyr_x;
+    rec.exp_gyr[Axis_Y] = ctl.exp_gyr_y;
+    rec.exp_gyr[Axis_Z] = ctl.exp_gyr_z;
+    rec.mode = ctl.control_mode;
+    rec.source = ctl.sig_source;
+    rec.arm = ctl.arm_state;
+    rec.failsafe = ctl.fail_safe;
+
+    memcpy(p_record, &rec, sizeof(rec));
+    return true;
+}
+
+static bool TaskLog_Fill_RC(uint8_t *p_record)
+{
+    LogTopic_RC_TypeDef rec;
+    ControlData_TypeDef ctl;
+
+    if (!SrvDataHub.get_rc_control_data(&ctl))
+        return false;
+
+    rec.ch_num = ctl.channel_sum;
+    memcpy(rec.ch, ctl.all_ch, sizeof(rec.ch));
+    rec.rssi = ctl.rssi;
+    rec.failsafe = ctl.fail_safe;
+
+    memcpy(p_record, &rec, sizeof(rec));
+    return true;
+}
+
+static bool TaskLog_Fill_Baro(uint8_t *p_record)
+{
+    LogTopic_Baro_TypeDef rec;
+    uint32_t time_stamp = 0;
+
+    if (!SrvDataHub.get_baro_altitude(&time_stamp, &rec.pressure, &rec.alt, &rec.alt_offset, &rec.temp, &rec.error))
+        return false;
+
+    memcpy(p_record, &rec, sizeof(rec));
+    return true;
+}
+
+static bool TaskLog_Fill_Moto(uint8_t *p_record)
+{
+    LogTopic_Moto_TypeDef rec;
+    uint16_t ch[LOG_TOPIC_MOTO_NUM] = {0};
+    uint8_t dir[LOG_TOPIC_MOTO_NUM] = {0};
+    float rpm[LOG_TOPIC_MOTO_NUM] = {0};
+    uint32_t time_stamp = 0;
+    uint8_t rpm_num = 0;
+
+    if (!SrvDataHub.get_moto(&time_stamp, &rec.num, ch, dir))
+        return false;
+
+    SrvDataHub.get_moto_rpm(&time_stamp, &rpm_num, rpm);
+
+    memcpy(rec.ch, ch, sizeof(rec.ch));
+    memcpy(rec.rpm, rpm, sizeof(rec.rpm));
+    memcpy(p_record, &rec, sizeof(rec));
+    return true;
+}
+
+static const LogTopic_Schema_TypeDef LogTopic_List[] = {
+    {"att",  10, LogTopic_Att_Field,  sizeof(LogTopic_Att_Field) / sizeof(LogTopic_Att_Field[0]),   TaskLog_Fill_Att},
+    {"ctl",  10, LogTopic_Ctl_Field,  sizeof(LogTopic_Ctl_Field) / sizeof(LogTopic_Ctl_Field[0]),   TaskLog_Fill_Ctl},
+    {"rc",   50, LogTopic_RC_Field,   sizeof(LogTopic_RC_Field) / sizeof(LogTopic_RC_Field[0]),     TaskLog_Fill_RC},
+    {"baro", 20, LogTopic_Baro_Field, sizeof(LogTopic_Baro_Field) / sizeof(LogTopic_Baro_Field[0]), TaskLog_Fill_Baro},
+    {"moto", 10, LogTopic_Moto_Field, sizeof(LogTopic_Moto_Field) / sizeof(LogTopic_Moto_Field[0]), TaskLog_Fill_Moto},
+};
+
+static void TaskLog_Topic_Regist(void)
+{
+    LogTopic_Schema_Ready = false;
+
+    for (uint8_t i = 0; i < sizeof(LogTopic_List) / sizeof(LogTopic_List[0]); i++)
+        LogTopic.regist(&LogTopic_List[i]);
+}
+
+/* write every whole sector in the frame buffer out, return false when the log halted */
+static bool TaskLog_Flush(void)
+{
+    bool log_halt = false;
+    uint32_t income_log_size = LogCompess_Data.compess_size;
+
+    while(income_log_size >= 512)
+    {
+        // DebugPin.ctl(Debug_PB4, true);
+        EvtTrace.record(EvtTrace_Log_Flush_Start, 0, 512);
+
+#if (SD_CARD_ENABLE_STATE == ON)
+        switch((uint8_t)Disk.write(&FATFS_Obj, &LogFile_Obj, LogCompess_Data.buf, 512))
+        {
+            case Disk_Write_Error:
+                log_halt = true;
+                Log_Statistics.halt_type = Log_DiskOprError_Halt;
+                break;
+
+            case Disk_Write_Finish:
+                log_halt = true;
+                Log_Statistics.halt_type = Log_Finish_Halt;
+                break;
+            
+            default:
+                break;
+        }
+#else
+        /* blackbox drop data when page cache is full or paused by dump, frame tag let decoder resync */
+        if (!Blackbox.ready())
+        {
+            log_halt = true;
+            Log_Statistics.halt_type = Log_DiskOprError_Halt;
+        }
+        else
+            Log_Statistics.drop_byte_sum += 512 - Blackbox.write(LogCompess_Data.buf, 512);
+#endif
+        EvtTrace.record(EvtTrace_Log_Flush_End, !log_halt, 0);
+
+        /* some error triggered or log finish */
+        if(log_halt)
+        {
+            LogFile_Ready = false;
+            DataPipe_Disable(&IMU_Log_DataPipe);
+            break;
+        }
+
+        Log_Statistics.write_file_cnt ++;
+        Log_Statistics.log_byte_sum += 512;
+        income_log_size -= 512;
+        LogCompess_Data.compess_size = income_log_size;
+
+        for(uint16_t t = 0; t < LogCompess_Data.compess_size; t++)
+        {
+            LogCompess_Data.buf[t] = LogCompess_Data.buf[t + 512];
+            LogCompess_Data.buf[t + 512] = 0;
+        }
+    
+        // DebugPin.ctl(Debug_PB4, false);
+    }
+
+    return !log_halt;
+}
+
+/* schema table go first and again every LOG_TOPIC_SCHEMA_PERIOD_MS, then records of every due topic, one frame per call */
+static bool TaskLog_Append_Topic(uint32_t sys_ms)
+{
+    uint8_t *p_frame = &LogCompess_Data.buf[LogCompess_Data.compess_size];
+    uint32_t remain = LogCompess_Data.total - LogCompess_Data.compess_size;
+    uint32_t size = 0;
+
+    if (remain <= (sizeof(uint32_t) + 2 * sizeof(uint8_t)))
+        return false;
+
+    remain -= sizeof(uint32_t) + 2 * sizeof(uint8_t);
+
+    if (!LogTopic_Schema_Ready || ((sys_ms - LogTopic_Schema_Time) >= LOG_TOPIC_SCHEMA_PERIOD_MS))
+    {
+        p_frame[0] = LOG_TOPIC_SCHEMA_HEADER;
+        size = LogTopic.get_schema(p_frame + sizeof(uint32_t) + sizeof(uint8_t), remain);
+        LogTopic_Schema_Ready = (size != 0);
+        LogTopic_Schema_Time = sys_ms;
+    }
+    else
+    {
+        p_frame[0] = LOG_TOPIC_DATA_HEADER;
+        size = LogTopic.poll(sys_ms, p_frame + sizeof(uint32_t) + sizeof(uint8_t), remain);
+    }
+
+    if (size == 0)
+        return false;
+
+    memcpy(&p_frame[1], &size, sizeof(uint32_t));
+    p_frame[size + sizeof(uint32_t) + sizeof(uint8_t)] = LOG_COMPESS_ENDER;
+    LogCompess_Data.compess_size += size + sizeof(uint32_t) + 2 * sizeof(uint8_t);
+
+    return true;
+}
+
 static void TaskLog_PipeTransFinish_Callback(DataPipeObj_TypeDef *obj)
 {
     uint32_t imu_pipe_rt_diff = 0;
-    LogIMUDataUnion_TypeDef Log_Buf;
+    ImuCodec_Sample_TypeDef Log_Buf;
 
     if ((obj == NULL) || !LogFile_Ready)
         return;
@@ -271,44 +575,38 @@ static void TaskLog_PipeTransFinish_Callback(DataPipeObj_TypeDef *obj)
     {
         LogIMU_Summary.pipe_cnt ++;
 
+        /* pop one codec block at a time */
         if(!LogObj_Logging_Reg._sec.IMU_Sec && enable_compess && 
-            Queue.size(IMUData_Queue) >= MAX_FILE_SIZE_K(1))
+            Queue.size(IMUData_Queue) >= LOG_CODEC_POP_SIZE)
         {
             Log_Statistics.queue_pop_cnt ++;
 
-            QueueIMU_PopSize = Queue.size(IMUData_Queue) / (LOG_HEADER_SIZE + sizeof(Log_Buf));
-            QueueIMU_PopSize *= LOG_HEADER_SIZE + sizeof(Log_Buf);
+            QueueIMU_PopSize = LOG_CODEC_POP_SIZE;
 
             /* queue pop count should equal to compess count */
             Queue.pop(&IMUData_Queue, LogCache_L2_Buf, QueueIMU_PopSize);
             Log_Statistics.uncompress_byte_sum += QueueIMU_PopSize;
         }
 
-        memset(Log_Buf.data.const_res, 0, sizeof(Log_Buf.data.const_res));
-        Log_Buf.data.time = ((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.time_stamp;
-        Log_Buf.data.acc_scale = ((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.acc_scale;
-        Log_Buf.data.gyr_scale = ((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.gyr_scale;
-        Log_Buf.data.cyc = ((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.cycle_cnt & 0x000000FF;
+        /* quantize to int16 by the sensor scale, the codec work on the raw lsb delta */
+        Log_Buf.time = ((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.time_stamp;
+        Log_Buf.acc_scale = ((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.acc_scale;
+        Log_Buf.gyr_scale = ((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.gyr_scale;
+        Log_Buf.cyc = ((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.cycle_cnt & 0x000000FF;
         
         for(uint8_t axis = Axis_X; axis < Axis_Sum; axis ++)
         {
-            Log_Buf.data.flt_acc[axis] = (int16_t)(Log_Buf.data.acc_scale * ((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.flt_acc[axis]);
-            Log_Buf.data.flt_gyr[axis] = (int16_t)(Log_Buf.data.gyr_scale * ((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.flt_gyr[axis]);
+            Log_Buf.ch[ImuCodec_FltAcc + axis] = ImuCodec_Quantize(((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.flt_acc[axis], Log_Buf.acc_scale);
+            Log_Buf.ch[ImuCodec_FltGyr + axis] = ImuCodec_Quantize(((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.flt_gyr[axis], Log_Buf.gyr_scale);
         
-            Log_Buf.data.org_acc[axis] = (int16_t)(Log_Buf.data.acc_scale * ((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.org_acc[axis]);
-            Log_Buf.data.org_gyr[axis] = (int16_t)(Log_Buf.data.gyr_scale * ((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.org_gyr[axis]);
-        }
-
-        for(uint8_t i = 0; i < sizeof(LogIMUDataUnion_TypeDef) - sizeof(uint8_t); i++)
-        {
-            Log_Buf.data.check_sum += Log_Buf.buff[i];
+            Log_Buf.ch[ImuCodec_OrgAcc + axis] = ImuCodec_Quantize(((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.org_acc[axis], Log_Buf.acc_scale);
+            Log_Buf.ch[ImuCodec_OrgGyr + axis] = ImuCodec_Quantize(((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.org_gyr[axis], Log_Buf.gyr_scale);
         }
 
         if ((Queue.state(IMUData_Queue) == Queue_ok) ||
             (Queue.state(IMUData_Queue) == Queue_empty))
         {
-            if((Queue.push(&IMUData_Queue, &LogIMU_Header, LOG_HEADER_SIZE) == Queue_ok) &&
-               (Queue.push(&IMUData_Queue, Log_Buf.buff, sizeof(Log_Buf)) == Queue_ok))
+            if(Queue.push(&IMUData_Queue, (uint8_t *)&Log_Buf, sizeof(Log_Buf)) == Queue_ok)
             {
                 if(LogIMU_Summary.start_rt == 0)
                     LogIMU_Summary.start_rt = ((SrvIMU_UnionData_TypeDef *)(IMU_Log_DataPipe.data_addr))->data.time_stamp;
@@ -338,6 +636,78 @@ static void TaskLog_PipeTransFinish_Callback(DataPipeObj_TypeDef *obj)
     }
 }
 
+#if (SD_CARD_ENABLE_STATE == ON)
+/* export callback, disk write in whole sector */
+static void TaskLog_Trace_Write(void *arg, const uint8_t *p_data, uint16_t size)
+{
+    uint16_t cpy_size = 0;
+
+    UNUSED(arg);
+
+    while (size && !TraceSave_Error)
+    {
+        cpy_size = TRACE_WRITE_UNIT - TraceSave_Len;
+        if (cpy_size > size)
+            cpy_size = size;
+
+        memcpy(&TraceSave_Buf[TraceSave_Len], p_data, cpy_size);
+        TraceSave_Len += cpy_size;
+        p_data += cpy_size;
+        size -= cpy_size;
+
+        if (TraceSave_Len == TRACE_WRITE_UNIT)
+        {
+            if (Disk.write(&FATFS_Obj, (Disk_FileObj_TypeDef *)&LogFile_Obj, TraceSave_Buf, TRACE_WRITE_UNIT) == Disk_Write_Error)
+                TraceSave_Error = true;
+
+            TraceSave_Len = 0;
+        }
+    }
+}
+
+/*
+ * disk io share one section cache between files, imu log can not keep writing beside the trace file
+ * saving the trace end the current imu log session
+ */
+static void TaskLog_Trace_Save(void)
+{
+    uint32_t image_size = 0;
+    uint32_t file_size = 0;
+    const char *info = NULL;
+
+    EvtTrace.enable(false);
+
+    if (LogFolder_Cluster == 0)
+        return;
+
+    LogFile_Ready = false;
+    DataPipe_Disable(&IMU_Log_DataPipe);
+    Log_Statistics.halt_type = Log_Finish_Halt;
+
+    image_size = EvtTrace.get_image_size();
+    file_size = ((image_size + TRACE_WRITE_UNIT - 1) / TRACE_WRITE_UNIT) * TRACE_WRITE_UNIT;
+
+    LogFile_Obj = Disk.create_file(&FATFS_Obj, TRACE_FILE, LogFolder_Cluster, file_size);
+    Disk.open(&FATFS_Obj, LOG_FOLDER, TRACE_FILE, (Disk_FileObj_TypeDef *)&LogFile_Obj);
+
+    TraceSave_Len = 0;
+    TraceSave_Error = false;
+    EvtTrace.export(TaskLog_Trace_Write, NULL);
+
+    /* tail sector padded with zero, host tool only read the announced event number */
+    if (TraceSave_Len && !TraceSave_Error)
+    {
+        memset(&TraceSave_Buf[TraceSave_Len], 0, TRACE_WRITE_UNIT - TraceSave_Len);
+        if (Disk.write(&FATFS_Obj, (Disk_FileObj_TypeDef *)&LogFile_Obj, TraceSave_Buf, TRACE_WRITE_UNIT) == Disk_Write_Error)
+            TraceSave_Error = true;
+        TraceSave_Len = 0;
+    }
+
+    info = TraceSave_Error ? "[Trace] save failed\r\n" : "[Trace] saved to " LOG_FOLDER TRACE_FILE "\r\n";
+    TaskLog_PushINFO_Data((uint8_t *)info, strlen(info));
+}
+#endif
+
 static void TaskLog_PushINFO_Data(uint8_t *info, uint16_t len)
 {
     if(INFO_Queue_CreateState)
@@ -362,3 +732,22 @@ uint16_t TaskLog_Get_Info(uint8_t *p_info, uint16_t buff_size)
 
     return queue_info_size;
 }
+
+/************************************************** shell section ************************************************/
+static void Trace_Save(void)
+{
+    Shell *shell_obj = Shell_GetInstence();
+
+    if (shell_obj == NULL)
+        return;
+
+#if (SD_CARD_ENABLE_STATE == ON)
+    /* request is served by log task, the only owner of the disk */
+    EvtTrace.enable(false);
+    TraceSave_Req = true;
+    shellPrint(shell_obj, "\t[Trace] saving to %s%s, imu log stopped\r\n", LOG_FOLDER, TRACE_FILE);
+#else
+    shellPrint(shell_obj, "\t[Trace] no sd card, use Trace_Dump\r\n");
+#endif
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Trace_Save, Trace_Save, Save event trace image to sd card);
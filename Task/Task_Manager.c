@@ -10,10 +10,14 @@
 #include "Dev_Led.h"
 #include "DiskIO.h"
 #include "Srv_ComProto.h"
+#include "Srv_Param.h"
 #include "Srv_OsCommon.h"
 #include "../DataPipe/DataPipe.h"
 #include "shell_port.h"
 #include "Storage.h"
+#include "Blackbox.h"
+#include "profiler.h"
+#include "error_log.h"
 
 #define TaskSample_Period_Def    1  /* unit: ms period 1ms  1000Hz */
 #define TaskControl_Period_Def   5  /* unit: ms period 2ms  200Hz  */
@@ -32,6 +36,9 @@ osThreadId TaskManager_Handle = NULL;
 
 void Task_Manager_Init(void)
 {
+    /* define heap region before any os object created */
+    SrvOsCommon.init();
+
 #if defined MATEKH743_V1_5
     DevLED.init(Led1);
     DevLED.init(Led2);
@@ -78,6 +85,7 @@ void Task_Manager_CreateTask(void)
             storage_ExtFlashObj->chip_type = ExtFlash_Chip_Type;
             storage_ExtFlashObj->dev_api = ExtFlash_Dev_Api;
             storage_ExtFlashObj->dev_obj = NULL;
+            storage_ExtFlashObj->bus_lock = NULL;
         }
         else
         {
@@ -93,17 +101,47 @@ void Task_Manager_CreateTask(void)
             DataPipe_Init();
 
             Storage.init(storage_module_enable, storage_ExtFlashObj);
+            SrvParam.init(storage_module_enable.bit.external ? External_Flash : Internal_Flash);
+#if (SD_CARD_ENABLE_STATE == OFF) && (FLASH_CHIP_STATE == ON)
+            /* no sd card on board, log into external flash chip */
+            Blackbox.init(storage_ExtFlashObj, ExtFlash_Blackbox_Addr);
+#endif
             SrvComProto.init(SrvComProto_Type_MAV, NULL);
             
+#if defined SITL_POSIX
+            /* host simulation run the whole task set on simulated sensor and receiver */
+            TaskSample_Init(TaskSample_Period_Def);
+            TaskTelemetry_Init(TaskTelemetry_Period_def);
+            TaskControl_Init(TaskControl_Period_Def);
+#else
             // TaskSample_Init(TaskSample_Period_Def);
             // TaskTelemetry_Init(TaskTelemetry_Period_def);
             // TaskControl_Init(TaskControl_Period_Def);
-#if (SD_CARD_ENABLE_STATE == ON)
+#endif
+#if (SD_CARD_ENABLE_STATE == ON) || (FLASH_CHIP_STATE == ON)
             TaskLog_Init(TaslLog_Period_Def);
 #endif
             TaskNavi_Init(TaslNavi_Period_Def);
             TaskFrameCTL_Init(TaskFrameCTL_Period_Def);
 
+            /* task loop execution budget is its period, ekf step run inside navi loop and has no budget of its own */
+            Profiler.set_budget(Profiler_Sec_Sample, TaskSample_Period_Def * 1000);
+            Profiler.set_budget(Profiler_Sec_Control, TaskControl_Period_Def * 1000);
+            Profiler.set_budget(Profiler_Sec_Telemetry, TaskTelemetry_Period_def * 1000);
+            Profiler.set_budget(Profiler_Sec_Log, TaslLog_Period_Def * 1000);
+            Profiler.set_budget(Profiler_Sec_Navi, TaslNavi_Period_Def * 1000);
+            Profiler.set_budget(Profiler_Sec_FrameCTL, TaskFrameCTL_Period_Def * 1000);
+
+#if defined SITL_POSIX
+            osThreadDef(SampleTask, TaskSample_Core, osPriorityRealtime, 0, 1024);
+            TaskInertial_Handle = osThreadCreate(osThread(SampleTask), NULL);
+
+            osThreadDef(ControlTask, TaskControl_Core, osPriorityAboveNormal, 0, 1024);
+            TaskControl_Handle = osThreadCreate(osThread(ControlTask), NULL);
+
+            osThreadDef(NavTask, TaskNavi_Core, osPriorityHigh, 0, 8192);
+            TaskNavi_Handle = osThreadCreate(osThread(NavTask), NULL);
+#else
             // osThreadDef(SampleTask, TaskSample_Core, osPriorityRealtime, 0, 1024);
             // TaskInertial_Handle = osThreadCreate(osThread(SampleTask), NULL);
 
@@ -112,13 +150,19 @@ void Task_Manager_CreateTask(void)
 
             // osThreadDef(NavTask, TaskNavi_Core, osPriorityHigh, 0, 8192);
             // TaskNavi_Handle = osThreadCreate(osThread(NavTask), NULL);
+#endif
 
-#if (SD_CARD_ENABLE_STATE  == ON)
+#if (SD_CARD_ENABLE_STATE  == ON) || (FLASH_CHIP_STATE == ON)
             osThreadDef(LogTask, TaskLog_Core, osPriorityAboveNormal, 0, 4096);
             TaskLog_Handle = osThreadCreate(osThread(LogTask), NULL);
 #endif
+#if defined SITL_POSIX
+            osThreadDef(TelemtryTask, TaskTelemetry_Core, osPriorityNormal, 0, 1024);
+            TaskTelemetry_Handle = osThreadCreate(osThread(TelemtryTask), NULL);
+#else
             // osThreadDef(TelemtryTask, TaskTelemetry_Core, osPriorityNormal, 0, 1024);
             // TaskTelemetry_Handle = osThreadCreate(osThread(TelemtryTask), NULL);
+#endif
 
             osThreadDef(FrameCTLTask, TaskFrameCTL_Core, osPriorityNormal, 0, 2048);
             TaskFrameCTL_Handle = osThreadCreate(osThread(FrameCTLTask), NULL);
@@ -126,7 +170,71 @@ void Task_Manager_CreateTask(void)
             init = true;
         }
 
-        /* run system statistic in this task */
+        /* run system statistic, error describe / process callback and parameter write back in this task */
+        Profiler.sample();
+        ErrorLog.proc();
+        SrvParam.proc();
         osDelay(10);
     }
 }
+
+/************************************************** Shell Section ************************************************/
+static void Task_Manager_Print_CycleStatistic(Shell *shell_obj, const char *name, Kernel_CycleStatistic_TypeDef *stat, uint32_t cyc_per_us)
+{
+    if (stat->cnt == 0)
+    {
+        shellPrint(shell_obj, "\t%s : no loop executed\r\n", name);
+        return;
+    }
+
+    shellPrint(shell_obj, "\t%s : loop %d avg %d cyc (%d us) max %d cyc (%d us)\r\n", name, stat->cnt, \
+                                                                                     stat->sum / stat->cnt, (stat->sum / stat->cnt) / cyc_per_us, \
+                                                                                     stat->max, stat->max / cyc_per_us);
+}
+
+/* run sample and control loop with cache off and on for the same duration, compare the cycle cost */
+static void Task_Manager_Cache_Bench(uint32_t duration)
+{
+    Shell *shell_obj = Shell_GetInstence();
+    Kernel_CycleStatistic_TypeDef stat[2][2];
+    bool cache_state = Kernel_Cache_State();
+    uint32_t cyc_per_us = Kernel_Get_SysClock() / 1000000;
+    uint8_t i = 0;
+
+    if (shell_obj == NULL)
+        return;
+
+    if (duration == 0)
+        duration = 1000;
+
+    if (cyc_per_us == 0)
+        cyc_per_us = 1;
+
+    shellPrint(shell_obj, "\t[Cache Bench] %d ms per state, core %d MHz\r\n", duration, cyc_per_us);
+
+    for (i = 0; i < 2; i++)
+    {
+        /* i == 0 cache off, i == 1 cache on */
+        Kernel_Cache_Ctl(i);
+        memset(TaskSample_Get_CycleStatistic(), 0, sizeof(Kernel_CycleStatistic_TypeDef));
+        memset(TaskControl_Get_CycleStatistic(), 0, sizeof(Kernel_CycleStatistic_TypeDef));
+
+        SrvOsCommon.delay_ms(duration);
+
+        stat[i][0] = *TaskSample_Get_CycleStatistic();
+        stat[i][1] = *TaskControl_Get_CycleStatistic();
+    }
+
+    Kernel_Cache_Ctl(cache_state);
+
+    for (i = 0; i < 2; i++)
+    {
+        shellPrint(shell_obj, "\r\n\tcache %s\r\n", i ? "on" : "off");
+        Task_Manager_Print_CycleStatistic(shell_obj, "sample ", &stat[i][0], cyc_per_us);
+        Task_Manager_Print_CycleStatistic(shell_obj, "control", &stat[i][1], cyc_per_us);
+    }
+
+    if (!Kernel_Cache_State() && !cache_state)
+        shellPrint(shell_obj, "\r\n\t[no cpu cache on this target]\r\n");
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Cache_Bench, Task_Manager_Cache_Bench, Sample and Control loop cycle cost with cache off and on);
@@ -7,6 +7,8 @@
 #include "MadgwickAHRS.h"
 #include "math_util.h"
 #include "Dev_Led.h"
+#include "shell_port.h"
+#include "profiler.h"
 
 /* IMU coordinate is x->forward y->right z->down */
 /*
@@ -15,8 +17,10 @@
     z Axis -> Yaw   anticlock wise rotate positice
 */
 #define FlipOver_Detect_HoldingTime 500 /* unit : ms */
+#define TaskNavi_Baro_Var 0.25f         /* unit : m^2 */
 
 static bool TaskNavi_FlipOver_Detect(float roll_angle);
+static void TaskNavi_EKF_Update(const SrvIMU_Delta_TypeDef *delta);
 
 /* internal vriable */
 TaskNavi_Monitor_TypeDef TaskNavi_Monitor;
@@ -24,6 +28,7 @@ TaskNavi_Monitor_TypeDef TaskNavi_Monitor;
 /* data structure definition */
 DataPipe_CreateDataObj(IMUAtt_TypeDef, Navi_Attitude);
 DataPipe_CreateDataObj(PosData_TypeDef, Navi_POS);
+DataPipe_CreateDataObj(PosVelData_TypeDef, Navi_Vel);
 
 void TaskNavi_Init(uint32_t period)
 {
@@ -32,9 +37,11 @@ void TaskNavi_Init(uint32_t period)
     /* init DataPipe */
     memset(&Attitude_smp_DataPipe, 0, sizeof(Attitude_smp_DataPipe));
     memset(&POS_smp_DataPipe, 0, sizeof(POS_smp_DataPipe));
+    memset(&Vel_smp_DataPipe, 0, sizeof(Vel_smp_DataPipe));
 
     memset(DataPipe_DataObjAddr(Navi_Attitude), 0, DataPipe_DataSize(Navi_Attitude));
     memset(DataPipe_DataObjAddr(Navi_POS), 0, DataPipe_DataSize(Navi_POS));
+    memset(DataPipe_DataObjAddr(Navi_Vel), 0, DataPipe_DataSize(Navi_Vel));
     
     Attitude_smp_DataPipe.data_addr = DataPipe_DataObjAddr(Navi_Attitude);
     Attitude_smp_DataPipe.data_size = DataPipe_DataSize(Navi_Attitude);
@@ -44,6 +51,12 @@ void TaskNavi_Init(uint32_t period)
     POS_smp_DataPipe.data_size = DataPipe_DataSize(Navi_POS);
     DataPipe_Enable(&POS_smp_DataPipe);
 
+    Vel_smp_DataPipe.data_addr = DataPipe_DataObjAddr(Navi_Vel);
+    Vel_smp_DataPipe.data_size = DataPipe_DataSize(Navi_Vel);
+    DataPipe_Enable(&Vel_smp_DataPipe);
+
+    NaviEKF_Init(&TaskNavi_Monitor.EKF, NULL);
+
     TaskNavi_Monitor.period = period;
 }
 
@@ -52,59 +65,49 @@ void TaskNavi_Core(void const *arg)
     uint32_t sys_time = SrvOsCommon.get_os_ms();
     bool imu_state = false;
     bool mag_state = false;
-    uint32_t Flt_IMU_TimeStamp = 0;
     uint32_t MAG_TimeStamp = 0;
-    float Acc_Scale = 0.0f;
-    float Gyr_Scale = 0.0f;
     float Mag_Scale = 0.0f;
-    IMUAtt_TypeDef attitude;
-    float Flt_Acc[Axis_Sum] = {0.0f};
-    float Flt_Gyr[Axis_Sum] = {0.0f};
     float Flt_Mag[Axis_Sum] = {0.0f};
-    float Flt_IMU_Tempra = 0.0f;
-    uint8_t IMU_Err = 0;
+    float Acc[Axis_Sum] = {0.0f};
     uint8_t MAG_Err = 0;
+    SrvIMU_Delta_TypeDef IMU_Delta;
+    IMUAtt_TypeDef attitude;
+    uint32_t start_cyc = 0;
 
     SrvDataHub.get_imu_init_state(&imu_state);
     SrvDataHub.get_mag_init_state(&mag_state);
     
-    bool Attitude_Update = false;
+    memset(&IMU_Delta, 0, sizeof(SrvIMU_Delta_TypeDef));
     memset(&attitude, 0, sizeof(IMUAtt_TypeDef));
+    MadgwickAHRS_Init(&TaskNavi_Monitor.AHRS, 0.0f, 1000);
     
     while(1)
     {
-        if(imu_state)
-        {
-            SrvDataHub.get_scaled_imu(&Flt_IMU_TimeStamp, &Acc_Scale, &Gyr_Scale, \
-                                      &Flt_Acc[Axis_X], &Flt_Acc[Axis_Y], &Flt_Acc[Axis_Z], \
-                                      &Flt_Gyr[Axis_X], &Flt_Gyr[Axis_Y], &Flt_Gyr[Axis_Z], \
-                                      &Flt_IMU_Tempra, &IMU_Err);
+        start_cyc = Kernel_Get_CycleCnt();
 
-            Attitude_Update = true;
-        }
-        
-        if(mag_state)
+        /* drain the pre-integrated window, windows closed while navi was late are already folded in */
+        if(imu_state && SrvDataHub.get_imu_delta(&IMU_Delta))
         {
-            SrvDataHub.get_scaled_mag(&MAG_TimeStamp, &Mag_Scale, \
-                                      &Flt_Mag[Axis_X], &Flt_Mag[Axis_Y], &Flt_Mag[Axis_Z], \
-                                      &MAG_Err);
-        }
-        else
-        {
-            Flt_Mag[Axis_X] = 0.0f;
-            Flt_Mag[Axis_Y] = 0.0f;
-            Flt_Mag[Axis_Z] = 0.0f;
-        }
-        
-        if(Attitude_Update)
-        {
-            /* update Attitude */
-            MadgwickAHRSupdate(Deg2Rad(Flt_Gyr[Axis_X]), Deg2Rad(-Flt_Gyr[Axis_Y]), Deg2Rad(-Flt_Gyr[Axis_Z]), \
-                               Flt_Acc[Axis_X],           -Flt_Acc[Axis_Y],         -Flt_Acc[Axis_Z], \
-                               Flt_Mag[Axis_X],           Flt_Mag[Axis_Y],          -Flt_Mag[Axis_Z]);
-            
-            if(MadgwickAHRS_Get_Attitude(&attitude.pitch, &attitude.roll, &attitude.yaw) && \
-               MadgwickAHRS_Get_Quraterion(&attitude.q0, &attitude.q1, &attitude.q2, &attitude.q3))
+            TaskNavi_Monitor.delta_merge_cnt += IMU_Delta.win_cnt - 1;
+
+            if(mag_state)
+            {
+                SrvDataHub.get_scaled_mag(&MAG_TimeStamp, &Mag_Scale, \
+                                          &Flt_Mag[Axis_X], &Flt_Mag[Axis_Y], &Flt_Mag[Axis_Z], \
+                                          &MAG_Err);
+            }
+
+            /* mean specific force over the window, madgwick only use its direction */
+            for(uint8_t i = Axis_X; i < Axis_Sum; i++)
+                Acc[i] = IMU_Delta.d_vel[i] / IMU_Delta.dt;
+
+            /* imu window is frd, coordinate of madgwick alogrithm is x ---> forward y ---> left z ---> up */
+            if(MadgwickAHRS_Update_DeltaAngle(&TaskNavi_Monitor.AHRS, IMU_Delta.dt, \
+                                              IMU_Delta.d_ang[Axis_X], -IMU_Delta.d_ang[Axis_Y], -IMU_Delta.d_ang[Axis_Z], \
+                                              Acc[Axis_X],             -Acc[Axis_Y],             -Acc[Axis_Z], \
+                                              Flt_Mag[Axis_X],         Flt_Mag[Axis_Y],          -Flt_Mag[Axis_Z]) && \
+               MadgwickAHRS_Get_Attitude(&TaskNavi_Monitor.AHRS, &attitude.pitch, &attitude.roll, &attitude.yaw) && \
+               MadgwickAHRS_Get_Quraterion(&TaskNavi_Monitor.AHRS, &attitude.q0, &attitude.q1, &attitude.q2, &attitude.q3))
             {
                 attitude.flip_over = TaskNavi_FlipOver_Detect(attitude.roll);
                 attitude.time_stamp = SrvOsCommon.get_os_ms();
@@ -113,13 +116,62 @@ void TaskNavi_Core(void const *arg)
 
             /* DataPipe Attitude Data to SrvDataHub */
             DataPipe_SendTo(&Attitude_smp_DataPipe, &Attitude_hub_DataPipe);
+
+            TaskNavi_EKF_Update(&IMU_Delta);
         }
 
+        Profiler.section_end(Profiler_Sec_Navi, start_cyc);
+
         /* check imu data update freq on test */
         SrvOsCommon.precise_delay(&sys_time, TaskNavi_Monitor.period);
     }
 }
 
+/* one ekf step per imu window, position and velocity published to SrvDataHub */
+static void TaskNavi_EKF_Update(const SrvIMU_Delta_TypeDef *delta)
+{
+    uint32_t start_cyc = Kernel_Get_CycleCnt();
+    uint32_t baro_time_stamp = 0;
+    float baro_pressure = 0.0f;
+    float baro_alt = 0.0f;
+    float baro_alt_offset = 0.0f;
+    float baro_tempra = 0.0f;
+    uint8_t baro_err = 0;
+    float pos[3];
+    float vel[3];
+
+    /* only fresh baro sample queued, ekf fuse it in the next step */
+    if (SrvDataHub.get_baro_altitude(&baro_time_stamp, &baro_pressure, &baro_alt, &baro_alt_offset, &baro_tempra, &baro_err) && \
+        (baro_time_stamp != TaskNavi_Monitor.baro_time_stamp))
+    {
+        TaskNavi_Monitor.baro_time_stamp = baro_time_stamp;
+
+        if (baro_err == 0)
+            NaviEKF_Set_Meas(&TaskNavi_Monitor.EKF, NaviEKF_Meas_Baro, baro_alt, TaskNavi_Baro_Var);
+    }
+
+    /* ekf work in frd, the imu window go in without any axis change so it share the body frame madgwick see */
+    NaviEKF_Step(&TaskNavi_Monitor.EKF, delta->d_ang, delta->d_vel, delta->dt);
+    Kernel_CycleStatistic_Update(&TaskNavi_Monitor.ekf_cyc, start_cyc);
+    Profiler.section_end(Profiler_Sec_EKF, start_cyc);
+
+    if (!NaviEKF_Get_PosVel(&TaskNavi_Monitor.EKF, pos, vel))
+        return;
+
+    DataPipe_DataObj(Navi_POS).XYZ_Pos.Pos_X = pos[0];
+    DataPipe_DataObj(Navi_POS).XYZ_Pos.Pos_Y = pos[1];
+    DataPipe_DataObj(Navi_POS).XYZ_Pos.Pos_Z = pos[2];
+    TaskNavi_Monitor.pos = DataPipe_DataObj(Navi_POS);
+
+    DataPipe_DataObj(Navi_Vel).XYZ_Vel.Vel_X = vel[0];
+    DataPipe_DataObj(Navi_Vel).XYZ_Vel.Vel_Y = vel[1];
+    DataPipe_DataObj(Navi_Vel).XYZ_Vel.Vel_Z = vel[2];
+    TaskNavi_Monitor.vel = DataPipe_DataObj(Navi_Vel);
+
+    DataPipe_SendTo(&POS_smp_DataPipe, &POS_hub_DataPipe);
+    DataPipe_SendTo(&Vel_smp_DataPipe, &Vel_hub_DataPipe);
+}
+
 static bool TaskNavi_FlipOver_Detect(float roll_angle)
 {
     /* use roll angle detect drone up side down state */
@@ -172,3 +224,48 @@ static bool TaskNavi_FlipOver_Detect(float roll_angle)
 
     return FlipOver_State;
 }
+
+/************************************************** Shell Section ************************************************/
+static void TaskNavi_EKF_Info(void)
+{
+    Shell *shell_obj = Shell_GetInstence();
+    NaviEKF_Obj_TypeDef *ekf = &TaskNavi_Monitor.EKF;
+    Kernel_CycleStatistic_TypeDef stat = TaskNavi_Monitor.ekf_cyc;
+    uint32_t cyc_per_us = Kernel_Get_SysClock() / 1000000;
+    float pitch = 0.0f;
+    float roll = 0.0f;
+    float yaw = 0.0f;
+    const char *meas_name[NaviEKF_Meas_Sum] = {"baro", "tof", "flow x", "flow y", "grav x", "grav y"};
+
+    if (shell_obj == NULL)
+        return;
+
+    if (cyc_per_us == 0)
+        cyc_per_us = 1;
+
+    if (!ekf->init)
+    {
+        shellPrint(shell_obj, "\t[EKF] not aligned\r\n");
+        return;
+    }
+
+    NaviEKF_Get_Attitude(ekf, &pitch, &roll, &yaw);
+
+    shellPrint(shell_obj, "\t[EKF] step %d imu window merged %d\r\n", ekf->step_cnt, TaskNavi_Monitor.delta_merge_cnt);
+    shellPrint(shell_obj, "\tatt  (0.01deg) : %d %d %d\r\n", (int32_t)(pitch * 100.0f), (int32_t)(roll * 100.0f), (int32_t)(yaw * 100.0f));
+    shellPrint(shell_obj, "\tpos  (mm)      : %d %d %d\r\n", (int32_t)(ekf->pos[0] * 1000.0f), (int32_t)(ekf->pos[1] * 1000.0f), (int32_t)(ekf->pos[2] * 1000.0f));
+    shellPrint(shell_obj, "\tvel  (mm/s)    : %d %d %d\r\n", (int32_t)(ekf->vel[0] * 1000.0f), (int32_t)(ekf->vel[1] * 1000.0f), (int32_t)(ekf->vel[2] * 1000.0f));
+    shellPrint(shell_obj, "\tgyr bias (mdeg/s) : %d %d %d\r\n", (int32_t)Rad2Deg(ekf->gyr_bias[0] * 1000.0f), (int32_t)Rad2Deg(ekf->gyr_bias[1] * 1000.0f), (int32_t)Rad2Deg(ekf->gyr_bias[2] * 1000.0f));
+    shellPrint(shell_obj, "\tacc bias (mm/s^2) : %d %d %d\r\n", (int32_t)(ekf->acc_bias[0] * 1000.0f), (int32_t)(ekf->acc_bias[1] * 1000.0f), (int32_t)(ekf->acc_bias[2] * 1000.0f));
+
+    for (uint8_t i = 0; i < NaviEKF_Meas_Sum; i++)
+    {
+        shellPrint(shell_obj, "\t%s : fuse %d reject %d innov %d e-3\r\n", meas_name[i], ekf->meas[i].fuse_cnt, ekf->meas[i].reject_cnt, (int32_t)(ekf->meas[i].innov * 1000.0f));
+    }
+
+    if (stat.cnt)
+    {
+        shellPrint(shell_obj, "\tstep cycle : last %d avg %d max %d (%d us)\r\n", stat.last, stat.sum / stat.cnt, stat.max, stat.max / cyc_per_us);
+    }
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, EKF_Info, TaskNavi_EKF_Info, navigation ekf state and step cost);
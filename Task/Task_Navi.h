@@ -5,6 +5,9 @@
 #include <stdbool.h>
 #include <string.h>
 #include "pos_data.h"
+#include "MadgwickAHRS.h"
+#include "navi_ekf.h"
+#include "kernel.h"
 
 typedef struct
 {
@@ -18,6 +21,13 @@ typedef struct
     PosData_TypeDef pos;
     PosVelData_TypeDef vel;
 
+    MadgwickAHRS_Obj_TypeDef AHRS;
+    uint32_t delta_merge_cnt;   /* window arrived folded with the next one, late but not lost */
+
+    NaviEKF_Obj_TypeDef EKF;
+    Kernel_CycleStatistic_TypeDef ekf_cyc;
+    uint32_t baro_time_stamp;
+
     uint16_t period;
 }TaskNavi_Monitor_TypeDef;
 
@@ -3,6 +3,8 @@
 #include "HW_Def.h"
 #include "Srv_ComProto.h"
 #include "Srv_DataHub.h"
+#include "kernel.h"
+#include "profiler.h"
 
 #define PROTO_STREAM_BUF_SIZE 512
 
@@ -56,19 +58,20 @@ SrvComProto_MsgInfo_TypeDef TaskProto_MAV_MotoChannel;
 SrvComProto_MsgInfo_TypeDef TaskProto_MAV_Attitude;
 SrvComProto_MsgInfo_TypeDef TaskProto_MAV_Exp_Attitude;
 SrvComProto_MsgInfo_TypeDef TaskProto_MAV_Altitude;
+SrvComProto_MsgInfo_TypeDef TaskProto_MAV_Profiler;
 
-SrvComProto_MsgInfo_TypeDef RadioProto_MAV_RawIMU;
-SrvComProto_MsgInfo_TypeDef RadioProto_MAV_ScaledIMU;
-SrvComProto_MsgInfo_TypeDef RadioProto_MAV_RcChannel;
-SrvComProto_MsgInfo_TypeDef RadioProto_MAV_MotoChannel;
-SrvComProto_MsgInfo_TypeDef RadioProto_MAV_Attitude;
-SrvComProto_MsgInfo_TypeDef RadioProto_MAV_Altitude;
+/* each message packed once per period and shared by all port */
+static SrvComProto_Scheduler_TypeDef MavSched;
+static __attribute__((section(".Perph_Section"))) uint8_t MavSchedBuf[SrvComProto_Sched_MaxMsg][MAVLINK_MAX_PACKET_LEN];
+static FrameCTL_Monitor_TypeDef USB_ProtoMonitor;
+static FrameCTL_Monitor_TypeDef Radio_ProtoMonitor;
+static int8_t MavSched_USBPort = -1;
+static int8_t MavSched_RadioPort = -1;
 
 static FrameCTL_Monitor_TypeDef FrameCTL_Monitor;
 static bool FrameCTL_MavProto_Enable = false;
 static FrameCTL_PortMonitor_TypeDef PortMonitor = {.init = false};
 static uint32_t FrameCTL_Period = 0;
-static __attribute__((section(".Perph_Section"))) uint8_t MavShareBuf[1024];
 static __attribute__((section(".Perph_Section"))) uint8_t CLIRxBuf[CLI_FUNC_BUF_SIZE];
 static uint8_t CLIProcBuf[CLI_FUNC_BUF_SIZE];
 static uint8_t Uart_RxBuf_Tmp[PROTO_STREAM_BUF_SIZE];
@@ -88,12 +91,6 @@ static SrvComProto_Stream_TypeDef USBRx_Stream = {
     .max_size = sizeof(USB_RxBuf_Tmp),
 };
 
-static SrvComProto_Stream_TypeDef MavStream = {
-    .p_buf = MavShareBuf,
-    .size = 0,
-    .max_size = sizeof(MavShareBuf),
-};
-
 static SrvComProto_Stream_TypeDef CLI_RX_Stream = {
     .p_buf = CLIRxBuf,
     .size = 0,
@@ -120,6 +117,7 @@ static void TaskFrameCTL_MavMsg_Trans(FrameCTL_Monitor_TypeDef *Obj, uint8_t *p_
 static void TaskFrameCTL_DefaultPort_Init(FrameCTL_PortMonitor_TypeDef *monitor);
 static void TaskFrameCTL_RadioPort_Init(FrameCTL_PortMonitor_TypeDef *monitor);
 static bool TaskFrameCTL_MAV_Msg_Init(void);
+static bool TaskFrameCTL_MAV_Sched_Init(void);
 static void TaskFrameCTL_Port_Rx_Callback(uint32_t RecObj_addr, uint8_t *p_data, uint16_t size);
 static void TaskFrameCTL_Port_TxCplt_Callback(uint32_t RecObj_addr, uint8_t *p_data, uint32_t *size);
 static uint32_t TaskFrameCTL_Set_RadioPort(FrameCTL_PortType_List port_type, uint16_t index);
@@ -142,7 +140,7 @@ void TaskFrameCTL_Init(uint32_t period)
     PortMonitor.init = true;
     
     /* init radio protocol*/
-    FrameCTL_MavProto_Enable = TaskFrameCTL_MAV_Msg_Init();
+    FrameCTL_MavProto_Enable = TaskFrameCTL_MAV_Msg_Init() && TaskFrameCTL_MAV_Sched_Init();
 
     if(period && (period <= FrameCTL_MAX_Period))
     {
@@ -156,9 +154,12 @@ void TaskFrameCTL_Init(uint32_t period)
 void TaskFrameCTL_Core(void *arg)
 {
     uint32_t per_time = SrvOsCommon.get_os_ms();
+    uint32_t start_cyc = 0;
 
     while(1)
     {
+        start_cyc = Kernel_Get_CycleCnt();
+
         /* frame protocol process */
         TaskFrameCTL_PortFrameOut_Process();
 
@@ -167,6 +168,7 @@ void TaskFrameCTL_Core(void *arg)
 
         TaskFrameCTL_ConnectStateCheck();
 
+        Profiler.section_end(Profiler_Sec_FrameCTL, start_cyc);
         SrvOsCommon.precise_delay(&per_time, FrameCTL_Period);
     }
 }
@@ -339,6 +341,7 @@ static void TaskFrameCTL_Port_Rx_Callback(uint32_t RecObj_addr, uint8_t *p_data,
     SrvComProto_Stream_TypeDef *p_stream = NULL;
     FrameCTL_PortProtoObj_TypeDef *p_RecObj = NULL;
     uint32_t port_addr = 0;
+    int8_t mav_port = -1;
     bool cli_state = false;
 
     /* use mavlink protocol tuning the flight parameter */
@@ -353,10 +356,12 @@ static void TaskFrameCTL_Port_Rx_Callback(uint32_t RecObj_addr, uint8_t *p_data,
         {
             case Port_USB:
                 p_stream = &USBRx_Stream;
+                mav_port = MavSched_USBPort;
                 break;
 
             case Port_Uart:
                 p_stream = &UartRx_Stream;
+                mav_port = MavSched_RadioPort;
                 break;
 
             default:
@@ -391,21 +396,26 @@ static void TaskFrameCTL_Port_Rx_Callback(uint32_t RecObj_addr, uint8_t *p_data,
             }
         }
 
+        /* noticed when drone is under disarmed state we can`t tune or send cli to drone for safety */
+        /* only process mavlink message when cli is disabled */
+        /* new byte go through the mavlink parser of its own port once, frame split between two receive stay in the parser */
+        /* parameter request is answered on the port it come from */
+        if (!cli_state && SrvComProto.mav_port_input(&MavSched, mav_port, p_data, size))
+        {
+            memset(p_stream->p_buf, 0, p_stream->max_size);
+            p_stream->size = 0;
+            return;
+        }
+
         stream_in = SrvComProto.msg_decode(p_stream->p_buf, p_stream->size);
     
-        /* noticed when drone is under disarmed state we can`t tune or send cli to drone for safety */
         if(stream_in.valid)
         {
             /* tag on recive time stamp */
             /* first come first serve */
             /* in case two different port tuning the same function or same parameter at the same time */
             /* if attach to configrator or in tunning then lock moto */
-            if(!cli_state && (stream_in.pac_type == ComFrame_MavMsg))
-            {
-                /* check mavline message frame type */
-                /* only process mavlink message when cli is disabled */
-            }
-            else if(stream_in.pac_type == ComFrame_CLI)
+            if(stream_in.pac_type == ComFrame_CLI)
             {
                 /* set current mode as cli mode */
                 /* all command line end up with "\r\n" */
@@ -423,6 +433,7 @@ static void TaskFrameCTL_Port_Rx_Callback(uint32_t RecObj_addr, uint8_t *p_data,
             }
         
             memset(p_stream->p_buf, 0, p_stream->max_size);
+            p_stream->size = 0;
         }
     }
 }
@@ -490,13 +501,9 @@ static bool TaskFrameCTL_MAV_Msg_Init(void)
         memset(&TaskProto_MAV_RcChannel, 0, sizeof(TaskProto_MAV_RcChannel));
         memset(&TaskProto_MAV_MotoChannel, 0, sizeof(TaskProto_MAV_MotoChannel));
         memset(&TaskProto_MAV_Attitude, 0, sizeof(TaskProto_MAV_Attitude));
- 
-        memset(&PckInfo, 0, sizeof(PckInfo));
-        memset(&RadioProto_MAV_RawIMU, 0, sizeof(TaskProto_MAV_RawIMU));
-        memset(&RadioProto_MAV_ScaledIMU, 0, sizeof(TaskProto_MAV_ScaledIMU));
-        memset(&RadioProto_MAV_RcChannel, 0, sizeof(TaskProto_MAV_RcChannel));
-        memset(&RadioProto_MAV_MotoChannel, 0, sizeof(TaskProto_MAV_MotoChannel));
-        memset(&RadioProto_MAV_Attitude, 0, sizeof(TaskProto_MAV_Attitude));
+        memset(&TaskProto_MAV_Exp_Attitude, 0, sizeof(TaskProto_MAV_Exp_Attitude));
+        memset(&TaskProto_MAV_Altitude, 0, sizeof(TaskProto_MAV_Altitude));
+        memset(&TaskProto_MAV_Profiler, 0, sizeof(TaskProto_MAV_Profiler));
  
         // period 10Ms 100Hz
         PckInfo.system_id = MAV_SysID_Drone;
@@ -504,9 +511,6 @@ static bool TaskFrameCTL_MAV_Msg_Init(void)
         PckInfo.chan = 0;
         SrvComProto.mav_msg_obj_init(&TaskProto_MAV_RawIMU, PckInfo, 10);
         SrvComProto.mav_msg_enable_ctl(&TaskProto_MAV_RawIMU, true);
- 
-        SrvComProto.mav_msg_obj_init(&RadioProto_MAV_RawIMU, PckInfo, 10);
-        SrvComProto.mav_msg_enable_ctl(&RadioProto_MAV_RawIMU, true);
              
         // period 10Ms 100Hz
         PckInfo.system_id = MAV_SysID_Drone;
@@ -514,9 +518,6 @@ static bool TaskFrameCTL_MAV_Msg_Init(void)
         PckInfo.chan = 0;
         SrvComProto.mav_msg_obj_init(&TaskProto_MAV_ScaledIMU, PckInfo, 10);
         SrvComProto.mav_msg_enable_ctl(&TaskProto_MAV_ScaledIMU, true);
-
-        SrvComProto.mav_msg_obj_init(&RadioProto_MAV_ScaledIMU, PckInfo, 10);
-        SrvComProto.mav_msg_enable_ctl(&RadioProto_MAV_ScaledIMU, true);
         
         // period 20Ms 50Hz
         PckInfo.system_id = MAV_SysID_Drone;
@@ -524,9 +525,6 @@ static bool TaskFrameCTL_MAV_Msg_Init(void)
         PckInfo.chan = 0;
         SrvComProto.mav_msg_obj_init(&TaskProto_MAV_RcChannel, PckInfo, 20);
         SrvComProto.mav_msg_enable_ctl(&TaskProto_MAV_RcChannel, true);
-
-        SrvComProto.mav_msg_obj_init(&RadioProto_MAV_RcChannel, PckInfo, 20);
-        SrvComProto.mav_msg_enable_ctl(&RadioProto_MAV_RcChannel, true);
         
         // period 10Ms 100Hz
         PckInfo.system_id = MAV_SysID_Drone;
@@ -534,9 +532,6 @@ static bool TaskFrameCTL_MAV_Msg_Init(void)
         PckInfo.chan = 0;
         SrvComProto.mav_msg_obj_init(&TaskProto_MAV_MotoChannel, PckInfo, 10);
         SrvComProto.mav_msg_enable_ctl(&TaskProto_MAV_MotoChannel, true);
-
-        SrvComProto.mav_msg_obj_init(&RadioProto_MAV_MotoChannel, PckInfo, 10);
-        SrvComProto.mav_msg_enable_ctl(&RadioProto_MAV_MotoChannel, true);
         
         // period 20Ms 50Hz
         PckInfo.system_id = MAV_SysID_Drone;
@@ -544,9 +539,6 @@ static bool TaskFrameCTL_MAV_Msg_Init(void)
         PckInfo.chan = 0;
         SrvComProto.mav_msg_obj_init(&TaskProto_MAV_Attitude, PckInfo, 20);
         SrvComProto.mav_msg_enable_ctl(&TaskProto_MAV_Attitude, true);
-
-        SrvComProto.mav_msg_obj_init(&RadioProto_MAV_Attitude, PckInfo, 20);
-        SrvComProto.mav_msg_enable_ctl(&RadioProto_MAV_Attitude, true);
                
         // period 20Ms 50Hz
         PckInfo.system_id = MAV_SysID_Drone;
@@ -555,15 +547,19 @@ static bool TaskFrameCTL_MAV_Msg_Init(void)
         SrvComProto.mav_msg_obj_init(&TaskProto_MAV_Exp_Attitude, PckInfo, 20);
         SrvComProto.mav_msg_enable_ctl(&TaskProto_MAV_Exp_Attitude, true);
  
-        // period 100MS 50Hz
+        // period 20MS 50Hz
         PckInfo.system_id = MAV_SysID_Drone;
         PckInfo.component_id = MAV_CompoID_Altitude;
         PckInfo.chan = 0;
         SrvComProto.mav_msg_obj_init(&TaskProto_MAV_Altitude, PckInfo, 20);
         SrvComProto.mav_msg_enable_ctl(&TaskProto_MAV_Altitude, true);
 
-        SrvComProto.mav_msg_obj_init(&RadioProto_MAV_Altitude, PckInfo, 20);
-        SrvComProto.mav_msg_enable_ctl(&RadioProto_MAV_Altitude, true);
+        // period 50MS 20Hz one profiler entry each frame
+        PckInfo.system_id = MAV_SysID_Drone;
+        PckInfo.component_id = MAV_CompoID_Profiler;
+        PckInfo.chan = 0;
+        SrvComProto.mav_msg_obj_init(&TaskProto_MAV_Profiler, PckInfo, 50);
+        SrvComProto.mav_msg_enable_ctl(&TaskProto_MAV_Profiler, true);
 
         return true;
     }
@@ -571,17 +567,66 @@ static bool TaskFrameCTL_MAV_Msg_Init(void)
     return false;
 }
 
+static bool TaskFrameCTL_MAV_Sched_Init(void)
+{
+    int8_t scaled_imu_id = -1;
+    int8_t attitude_id = -1;
+    int8_t rc_id = -1;
+    int8_t altitude_id = -1;
+    int8_t exp_att_id = -1;
+    int8_t profiler_id = -1;
+
+    if (!SrvComProto.mav_sched_init(&MavSched))
+        return false;
+
+    /* message only have to be registered once no matter how many port it goes to */
+    scaled_imu_id = SrvComProto.mav_sched_add_msg(&MavSched, &TaskProto_MAV_ScaledIMU,    MavSchedBuf[0], MAVLINK_MAX_PACKET_LEN);
+    attitude_id   = SrvComProto.mav_sched_add_msg(&MavSched, &TaskProto_MAV_Attitude,     MavSchedBuf[1], MAVLINK_MAX_PACKET_LEN);
+    rc_id         = SrvComProto.mav_sched_add_msg(&MavSched, &TaskProto_MAV_RcChannel,    MavSchedBuf[2], MAVLINK_MAX_PACKET_LEN);
+    altitude_id   = SrvComProto.mav_sched_add_msg(&MavSched, &TaskProto_MAV_Altitude,     MavSchedBuf[3], MAVLINK_MAX_PACKET_LEN);
+    exp_att_id    = SrvComProto.mav_sched_add_msg(&MavSched, &TaskProto_MAV_Exp_Attitude, MavSchedBuf[4], MAVLINK_MAX_PACKET_LEN);
+    profiler_id   = SrvComProto.mav_sched_add_msg(&MavSched, &TaskProto_MAV_Profiler,     MavSchedBuf[5], MAVLINK_MAX_PACKET_LEN);
+
+    /* default port USB VCP no bandwidth limit */
+    if (USB_VCP_Addr)
+    {
+        USB_ProtoMonitor.frame_type = ComFrame_MavMsg;
+        USB_ProtoMonitor.port_type = Port_USB;
+        USB_ProtoMonitor.port_addr = USB_VCP_Addr;
+
+        MavSched_USBPort = SrvComProto.mav_sched_add_port(&MavSched, &USB_ProtoMonitor, (ComProto_Callback)TaskFrameCTL_MavMsg_Trans, SrvComProto_Sched_Unlimited);
+        SrvComProto.mav_sched_set_rate(&MavSched, MavSched_USBPort, scaled_imu_id, TaskProto_MAV_ScaledIMU.period);
+        SrvComProto.mav_sched_set_rate(&MavSched, MavSched_USBPort, attitude_id,   TaskProto_MAV_Attitude.period);
+        SrvComProto.mav_sched_set_rate(&MavSched, MavSched_USBPort, rc_id,         TaskProto_MAV_RcChannel.period);
+        SrvComProto.mav_sched_set_rate(&MavSched, MavSched_USBPort, exp_att_id,    TaskProto_MAV_Exp_Attitude.period);
+        SrvComProto.mav_sched_set_rate(&MavSched, MavSched_USBPort, profiler_id,   TaskProto_MAV_Profiler.period);
+    }
+
+    /* radio port bandwidth budget come from its baudrate */
+    if (Radio_Addr)
+    {
+        Radio_ProtoMonitor.frame_type = ComFrame_MavMsg;
+        Radio_ProtoMonitor.port_type = Port_Uart;
+        Radio_ProtoMonitor.port_addr = Radio_Addr;
+
+        MavSched_RadioPort = SrvComProto.mav_sched_add_port(&MavSched, &Radio_ProtoMonitor, (ComProto_Callback)TaskFrameCTL_MavMsg_Trans, RADIO_PORT_BAUD);
+        SrvComProto.mav_sched_set_rate(&MavSched, MavSched_RadioPort, scaled_imu_id, TaskProto_MAV_ScaledIMU.period);
+        SrvComProto.mav_sched_set_rate(&MavSched, MavSched_RadioPort, attitude_id,   TaskProto_MAV_Attitude.period);
+        SrvComProto.mav_sched_set_rate(&MavSched, MavSched_RadioPort, rc_id,         TaskProto_MAV_RcChannel.period);
+        SrvComProto.mav_sched_set_rate(&MavSched, MavSched_RadioPort, altitude_id,   TaskProto_MAV_Altitude.period);
+    }
+
+    return true;
+}
+
 static void TaskFrameCTL_PortFrameOut_Process(void)
 {
-    FrameCTL_Monitor_TypeDef proto_monitor;
-    void *proto_arg = (void *)&proto_monitor;
     bool tunning_state = false;
     uint32_t tunning_time_stamp = 0;
     uint32_t tunning_port = 0;
     bool arm_state = false;
     bool CLI_state = false;
 
-    proto_monitor.frame_type = ComFrame_MavMsg;
     SrvDataHub.get_cli_state(&CLI_state);
 
     if(FrameCTL_MavProto_Enable && PortMonitor.VCP_Port.init_state && !CLI_state)
@@ -595,25 +640,8 @@ static void TaskFrameCTL_PortFrameOut_Process(void)
 
         if(!tunning_state)
         {
-            /* Proto mavlink message through Radio */
-            proto_monitor.port_type = Port_Uart;
-            proto_monitor.port_addr = Radio_Addr;
-            // SrvComProto.mav_msg_stream(&RadioProto_MAV_RawIMU,    &MavStream, proto_arg, (ComProto_Callback)TaskFrameCTL_MavMsg_Trans);
-            SrvComProto.mav_msg_stream(&RadioProto_MAV_ScaledIMU, &MavStream, proto_arg, (ComProto_Callback)TaskFrameCTL_MavMsg_Trans);
-            SrvComProto.mav_msg_stream(&RadioProto_MAV_Attitude,  &MavStream, proto_arg, (ComProto_Callback)TaskFrameCTL_MavMsg_Trans);
-            SrvComProto.mav_msg_stream(&RadioProto_MAV_RcChannel, &MavStream, proto_arg, (ComProto_Callback)TaskFrameCTL_MavMsg_Trans);
-            SrvComProto.mav_msg_stream(&RadioProto_MAV_Altitude,  &MavStream, proto_arg, (ComProto_Callback)TaskFrameCTL_MavMsg_Trans);
-            
-            /* Proto mavlink messa
-            ge through default port */
-            proto_monitor.port_type = Port_USB;
-            proto_monitor.port_addr = USB_VCP_Addr;
-            // SrvComProto.mav_msg_stream(&TaskProto_MAV_RawIMU,    &MavStream, proto_arg, (ComProto_Callback)TaskFrameCTL_MavMsg_Trans);
-            SrvComProto.mav_msg_stream(&TaskProto_MAV_ScaledIMU, &MavStream, proto_arg, (ComProto_Callback)TaskFrameCTL_MavMsg_Trans);
-            SrvComProto.mav_msg_stream(&TaskProto_MAV_Attitude,  &MavStream, proto_arg, (ComProto_Callback)TaskFrameCTL_MavMsg_Trans);
-            SrvComProto.mav_msg_stream(&TaskProto_MAV_RcChannel, &MavStream, proto_arg, (ComProto_Callback)TaskFrameCTL_MavMsg_Trans);
-            // SrvComProto.mav_msg_stream(&TaskProto_MAV_Altitude,  &MavStream, proto_arg, (ComProto_Callback)TaskFrameCTL_MavMsg_Trans);
-            SrvComProto.mav_msg_stream(&TaskProto_MAV_Exp_Attitude, &MavStream, proto_arg, (ComProto_Callback)TaskFrameCTL_MavMsg_Trans); 
+            /* pack each due message once and fan out to USB and radio port */
+            SrvComProto.mav_sched_run(&MavSched);
         }
         else if(tunning_state && (arm_state == DRONE_ARM))
         {
@@ -7,6 +7,8 @@
 #include "../FCHW_Config.h"
 #include "../System/DataPipe/DataPipe.h"
 #include "Srv_SensorMonitor.h"
+#include "Srv_DataHub.h"
+#include "profiler.h"
 
 #define DATAPIPE_TRANS_TIMEOUT_100Ms 100
 
@@ -20,8 +22,11 @@
 static Error_Handler TaskInertial_ErrorLog_Handle = NULL;
 static uint32_t TaskSample_Period = 0;
 static bool sample_enable = false;
+static bool IMU_Delta_Pending = false;
 static SrvSensorMonitorObj_TypeDef SensorMonitor;
+static Kernel_CycleStatistic_TypeDef TaskSample_CycleStatistic;
 DataPipe_CreateDataObj(SrvIMU_UnionData_TypeDef, IMU_Data);
+DataPipe_CreateDataObj(SrvIMU_Delta_TypeDef, IMU_Delta);
 DataPipe_CreateDataObj(SrvBaroData_TypeDef, Baro_Data);
 DataPipe_CreateDataObj(SrvSensorMonitor_GenReg_TypeDef, SensorEnable_State);
 DataPipe_CreateDataObj(SrvSensorMonitor_GenReg_TypeDef, SensorInit_State);
@@ -43,14 +48,20 @@ void TaskSample_Init(uint32_t period)
 
     memset(&SensorMonitor, 0, sizeof(SrvSensorMonitorObj_TypeDef));
     memset(&IMU_Smp_DataPipe, 0, sizeof(IMU_Smp_DataPipe));
+    memset(&IMU_Delta_Smp_DataPipe, 0, sizeof(IMU_Delta_Smp_DataPipe));
     memset(&Baro_smp_DataPipe, 0, sizeof(Baro_smp_DataPipe));
 
     memset(DataPipe_DataObjAddr(Baro_Data), 0, sizeof(DataPipe_DataObj(Baro_Data)));
     memset(DataPipe_DataObjAddr(IMU_Data), 0, sizeof(DataPipe_DataObj(IMU_Data)));
+    memset(DataPipe_DataObjAddr(IMU_Delta), 0, DataPipe_DataSize(IMU_Delta));
 
     IMU_Smp_DataPipe.data_addr = (uint32_t)DataPipe_DataObjAddr(IMU_Data);
     IMU_Smp_DataPipe.data_size = sizeof(DataPipe_DataObj(IMU_Data));
     DataPipe_Enable(&IMU_Smp_DataPipe);
+
+    IMU_Delta_Smp_DataPipe.data_addr = (uint32_t)DataPipe_DataObjAddr(IMU_Delta);
+    IMU_Delta_Smp_DataPipe.data_size = DataPipe_DataSize(IMU_Delta);
+    DataPipe_Enable(&IMU_Delta_Smp_DataPipe);
     
     Baro_smp_DataPipe.data_addr = (uint32_t)DataPipe_DataObjAddr(Baro_Data);
     Baro_smp_DataPipe.data_size = sizeof(DataPipe_DataObj(Baro_Data));
@@ -118,10 +129,25 @@ void TaskSample_Core(void const *arg)
 {
     uint32_t sys_time = SrvOsCommon.get_os_ms();
     
+    uint32_t start_cyc = 0;
+    SrvIMU_Delta_TypeDef imu_delta;
+#if (DSHOT_BIDIR == ON)
+    uint32_t rpm_time_stamp = 0;
+    uint8_t moto_cnt = 0;
+    float moto_rpm[SRV_ACTUATOR_MAX_MIX_MOTO] = {0.0f};
+#endif
+
     while(1)
     {
+        start_cyc = Kernel_Get_CycleCnt();
         TaskInertical_Blink_Notification(100);
 
+#if (DSHOT_BIDIR == ON)
+        /* latest moto rpm from bidirectional dshot telemetry, retune gyro rpm notch before sample */
+        if(sample_enable && SrvDataHub.get_moto_rpm(&rpm_time_stamp, &moto_cnt, moto_rpm))
+            SrvSensorMonitor.set_moto_rpm(&SensorMonitor, moto_rpm, moto_cnt);
+#endif
+
         if(sample_enable && SrvSensorMonitor.sample_ctl(&SensorMonitor))
         {
             DataPipe_DataObj(IMU_Data) = SrvSensorMonitor.get_imu_data(&SensorMonitor);
@@ -133,12 +159,32 @@ void TaskSample_Core(void const *arg)
             DataPipe_SendTo(&IMU_Smp_DataPipe, &IMU_hub_DataPipe);
             DataPipe_SendTo(&Baro_smp_DataPipe, &Baro_hub_DataPipe);
             // DebugPin.ctl(Debug_PB4, false);
+
+            /* pre-integrated delta angle and velocity, window not piped out yet is kept and the new one appended */
+            if(SrvSensorMonitor.get_imu_delta(&SensorMonitor, &imu_delta))
+            {
+                if(!IMU_Delta_Pending)
+                    DataPipe_DataObj(IMU_Delta).win_cnt = 0;
+
+                SrvIMU.merge_delta(DataPipe_DataObjAddr(IMU_Delta), &imu_delta);
+                IMU_Delta_Pending = true;
+            }
+
+            if(IMU_Delta_Pending)
+                IMU_Delta_Pending = !DataPipe_SendTo(&IMU_Delta_Smp_DataPipe, &IMU_Delta_hub_DataPipe);
         }
-        
+
+        Kernel_CycleStatistic_Update(&TaskSample_CycleStatistic, start_cyc);
+        Profiler.section_end(Profiler_Sec_Sample, start_cyc);
         SrvOsCommon.precise_delay(&sys_time, TaskSample_Period);
     }
 }
 
+Kernel_CycleStatistic_TypeDef *TaskSample_Get_CycleStatistic(void)
+{
+    return &TaskSample_CycleStatistic;
+}
+
 static void TaskInertical_Blink_Notification(uint16_t duration)
 {
     uint32_t Rt = 0;
@@ -7,8 +7,10 @@
 #include "imu_data.h"
 #include "Srv_OsCommon.h"
 #include "Srv_SensorMonitor.h"
+#include "kernel.h"
 
 void TaskSample_Init(uint32_t period);
 void TaskSample_Core(void const *arg);
+Kernel_CycleStatistic_TypeDef *TaskSample_Get_CycleStatistic(void);
 
 #endif
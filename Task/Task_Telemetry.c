@@ -28,6 +28,8 @@
 #include "Srv_OsCommon.h"
 #include "util.h"
 #include "Srv_ComProto.h"
+#include "kernel.h"
+#include "profiler.h"
 
 static SrvReceiverObj_TypeDef Receiver_Obj;
 static Telemetry_Monitor_TypeDef Telemetry_Monitor;
@@ -153,9 +155,11 @@ static bool Telemetry_Led_Control(bool state)
 void TaskTelemetry_Core(void const *arg)
 {
     uint32_t sys_time = SrvOsCommon.get_os_ms();
+    uint32_t start_cyc = 0;
 
     while(1)
     {
+        start_cyc = Kernel_Get_CycleCnt();
         // Telemetry_blink();
         
         /* RC receiver process */
@@ -164,6 +168,7 @@ void TaskTelemetry_Core(void const *arg)
         /* pipe data out */
         DataPipe_SendTo(&Receiver_Smp_DataPipe, &Receiver_hub_DataPipe);
         
+        Profiler.section_end(Profiler_Sec_Telemetry, start_cyc);
         SrvOsCommon.precise_delay(&sys_time, TaskTelemetry_Period);
     }
 }
@@ -0,0 +1,359 @@
+#include "imu_codec.h"
+
+#define IMU_CODEC_STREAM_TIME 0
+#define IMU_CODEC_STREAM_CYC 1
+#define IMU_CODEC_STREAM_CH 2
+
+typedef struct
+{
+    uint8_t *p_buf;
+    uint64_t acc;
+    uint8_t bit;
+} ImuCodec_BitWriter_TypeDef;
+
+typedef struct
+{
+    const uint8_t *p_buf;
+    uint64_t acc;
+    uint8_t bit;
+} ImuCodec_BitReader_TypeDef;
+
+/* internal function */
+static uint32_t ImuCodec_ZigZag(int32_t val);
+static int32_t ImuCodec_UnZigZag(uint32_t val);
+static uint8_t ImuCodec_Get_Width(uint32_t val);
+static uint32_t ImuCodec_Stream_Value(const ImuCodec_Sample_TypeDef *p_cur, const ImuCodec_Sample_TypeDef *p_lst, uint8_t stream);
+static void ImuCodec_Stream_Apply(ImuCodec_Sample_TypeDef *p_cur, const ImuCodec_Sample_TypeDef *p_lst, uint8_t stream, uint32_t val);
+static uint8_t ImuCodec_Put_Varint(uint8_t *p_out, uint32_t val);
+static uint8_t ImuCodec_Get_Varint(const uint8_t *p_in, uint16_t size, uint32_t *val);
+static void ImuCodec_BitWriter_Put(ImuCodec_BitWriter_TypeDef *writer, uint32_t val, uint8_t width);
+static uint32_t ImuCodec_BitReader_Get(ImuCodec_BitReader_TypeDef *reader, uint8_t width);
+static uint16_t ImuCodec_Encode_Block(const ImuCodec_Sample_TypeDef *p_in, uint8_t num, uint8_t *p_out, uint16_t out_size);
+static uint16_t ImuCodec_Decode_Block(const uint8_t *p_in, uint16_t in_size, ImuCodec_Sample_TypeDef *p_out, uint16_t out_num, uint8_t *num);
+
+static uint32_t ImuCodec_ZigZag(int32_t val)
+{
+    return ((uint32_t)val << 1) ^ (uint32_t)(val >> 31);
+}
+
+static int32_t ImuCodec_UnZigZag(uint32_t val)
+{
+    return (int32_t)(val >> 1) ^ -(int32_t)(val & 1);
+}
+
+static uint8_t ImuCodec_Get_Width(uint32_t val)
+{
+    uint8_t width = 0;
+
+    while (val)
+    {
+        width ++;
+        val >>= 1;
+    }
+
+    return width;
+}
+
+static uint32_t ImuCodec_Stream_Value(const ImuCodec_Sample_TypeDef *p_cur, const ImuCodec_Sample_TypeDef *p_lst, uint8_t stream)
+{
+    if (stream == IMU_CODEC_STREAM_TIME)
+        return p_cur->time - p_lst->time;
+
+    if (stream == IMU_CODEC_STREAM_CYC)
+        return (uint8_t)(p_cur->cyc - p_lst->cyc);
+
+    return ImuCodec_ZigZag((int32_t)p_cur->ch[stream - IMU_CODEC_STREAM_CH] - p_lst->ch[stream - IMU_CODEC_STREAM_CH]);
+}
+
+static void ImuCodec_Stream_Apply(ImuCodec_Sample_TypeDef *p_cur, const ImuCodec_Sample_TypeDef *p_lst, uint8_t stream, uint32_t val)
+{
+    if (stream == IMU_CODEC_STREAM_TIME)
+    {
+        p_cur->time = p_lst->time + val;
+    }
+    else if (stream == IMU_CODEC_STREAM_CYC)
+    {
+        p_cur->cyc = (uint8_t)(p_lst->cyc + val);
+    }
+    else
+        p_cur->ch[stream - IMU_CODEC_STREAM_CH] = (int16_t)(p_lst->ch[stream - IMU_CODEC_STREAM_CH] + ImuCodec_UnZigZag(val));
+}
+
+static uint8_t ImuCodec_Put_Varint(uint8_t *p_out, uint32_t val)
+{
+    uint8_t len = 0;
+
+    do
+    {
+        p_out[len] = (val & 0x7F) | ((val > 0x7F) ? 0x80 : 0);
+        val >>= 7;
+        len ++;
+    } while (val);
+
+    return len;
+}
+
+static uint8_t ImuCodec_Get_Varint(const uint8_t *p_in, uint16_t size, uint32_t *val)
+{
+    *val = 0;
+
+    for (uint8_t i = 0; (i < 5) && (i < size); i++)
+    {
+        *val |= (uint32_t)(p_in[i] & 0x7F) << (7 * i);
+
+        if ((p_in[i] & 0x80) == 0)
+            return i + 1;
+    }
+
+    return 0;
+}
+
+static void ImuCodec_BitWriter_Put(ImuCodec_BitWriter_TypeDef *writer, uint32_t val, uint8_t width)
+{
+    if (width == 0)
+        return;
+
+    writer->acc |= (uint64_t)val << writer->bit;
+    writer->bit += width;
+
+    while (writer->bit >= 8)
+    {
+        *writer->p_buf++ = (uint8_t)writer->acc;
+        writer->acc >>= 8;
+        writer->bit -= 8;
+    }
+}
+
+static uint32_t ImuCodec_BitReader_Get(ImuCodec_BitReader_TypeDef *reader, uint8_t width)
+{
+    uint32_t val = 0;
+
+    if (width == 0)
+        return 0;
+
+    while (reader->bit < width)
+    {
+        reader->acc |= (uint64_t)(*reader->p_buf++) << reader->bit;
+        reader->bit += 8;
+    }
+
+    val = (uint32_t)(reader->acc & ((width == 32) ? 0xFFFFFFFF : ((1UL << width) - 1)));
+    reader->acc >>= width;
+    reader->bit -= width;
+
+    return val;
+}
+
+/* two pass on the block, base and width first, then pack, no intermediate buffer */
+static uint16_t ImuCodec_Encode_Block(const ImuCodec_Sample_TypeDef *p_in, uint8_t num, uint8_t *p_out, uint16_t out_size)
+{
+    ImuCodec_BitWriter_TypeDef writer;
+    uint32_t base[IMU_CODEC_STREAM_NUM];
+    uint8_t width[IMU_CODEC_STREAM_NUM];
+    uint32_t max = 0;
+    uint32_t val = 0;
+    uint16_t size = 0;
+    uint32_t bit_sum = 0;
+    uint8_t check_sum = 0;
+
+    for (uint8_t s = 0; s < IMU_CODEC_STREAM_NUM; s++)
+    {
+        base[s] = 0xFFFFFFFF;
+        max = 0;
+
+        for (uint8_t i = 1; i < num; i++)
+        {
+            val = ImuCodec_Stream_Value(&p_in[i], &p_in[i - 1], s);
+
+            if (val < base[s])
+                base[s] = val;
+
+            if (val > max)
+                max = val;
+        }
+
+        if (num == 1)
+            base[s] = 0;
+
+        width[s] = ImuCodec_Get_Width(max - base[s]);
+        bit_sum += (uint32_t)width[s] * (num - 1);
+    }
+
+    if (out_size < (1 + IMU_CODEC_KEY_SIZE + IMU_CODEC_STREAM_NUM * 6 + (bit_sum + 7) / 8 + 1))
+        return 0;
+
+    p_out[size++] = num;
+    memcpy(&p_out[size], &p_in[0].time, sizeof(uint32_t));
+    size += sizeof(uint32_t);
+    p_out[size++] = p_in[0].cyc;
+    memcpy(&p_out[size], &p_in[0].acc_scale, sizeof(float));
+    size += sizeof(float);
+    memcpy(&p_out[size], &p_in[0].gyr_scale, sizeof(float));
+    size += sizeof(float);
+    memcpy(&p_out[size], p_in[0].ch, sizeof(p_in[0].ch));
+    size += sizeof(p_in[0].ch);
+
+    for (uint8_t s = 0; s < IMU_CODEC_STREAM_NUM; s++)
+    {
+        size += ImuCodec_Put_Varint(&p_out[size], base[s]);
+        p_out[size++] = width[s];
+    }
+
+    writer.p_buf = &p_out[size];
+    writer.acc = 0;
+    writer.bit = 0;
+
+    for (uint8_t s = 0; s < IMU_CODEC_STREAM_NUM; s++)
+    {
+        for (uint8_t i = 1; i < num; i++)
+            ImuCodec_BitWriter_Put(&writer, ImuCodec_Stream_Value(&p_in[i], &p_in[i - 1], s) - base[s], width[s]);
+    }
+
+    /* flush the tail bit */
+    ImuCodec_BitWriter_Put(&writer, 0, (8 - writer.bit) & 0x07);
+    size = writer.p_buf - p_out;
+
+    for (uint16_t i = 0; i < size; i++)
+        check_sum += p_out[i];
+
+    p_out[size++] = check_sum;
+
+    return size;
+}
+
+static uint16_t ImuCodec_Decode_Block(const uint8_t *p_in, uint16_t in_size, ImuCodec_Sample_TypeDef *p_out, uint16_t out_num, uint8_t *num)
+{
+    ImuCodec_BitReader_TypeDef reader;
+    uint32_t base[IMU_CODEC_STREAM_NUM];
+    uint8_t width[IMU_CODEC_STREAM_NUM];
+    uint32_t bit_sum = 0;
+    uint16_t size = 0;
+    uint8_t len = 0;
+    uint8_t check_sum = 0;
+
+    if (in_size < (1 + IMU_CODEC_KEY_SIZE))
+        return 0;
+
+    *num = p_in[size++];
+    if ((*num == 0) || (*num > IMU_CODEC_BLOCK_SIZE) || (*num > out_num))
+        return 0;
+
+    memcpy(&p_out[0].time, &p_in[size], sizeof(uint32_t));
+    size += sizeof(uint32_t);
+    p_out[0].cyc = p_in[size++];
+    memcpy(&p_out[0].acc_scale, &p_in[size], sizeof(float));
+    size += sizeof(float);
+    memcpy(&p_out[0].gyr_scale, &p_in[size], sizeof(float));
+    size += sizeof(float);
+    memcpy(p_out[0].ch, &p_in[size], sizeof(p_out[0].ch));
+    size += sizeof(p_out[0].ch);
+
+    for (uint8_t s = 0; s < IMU_CODEC_STREAM_NUM; s++)
+    {
+        len = ImuCodec_Get_Varint(&p_in[size], in_size - size, &base[s]);
+        if ((len == 0) || ((size + len) >= in_size))
+            return 0;
+
+        size += len;
+        width[s] = p_in[size++];
+        if (width[s] > 32)
+            return 0;
+
+        bit_sum += (uint32_t)width[s] * (*num - 1);
+    }
+
+    if ((size + (bit_sum + 7) / 8 + 1) > in_size)
+        return 0;
+
+    for (uint16_t i = 0; i < size + (bit_sum + 7) / 8; i++)
+        check_sum += p_in[i];
+
+    if (check_sum != p_in[size + (bit_sum + 7) / 8])
+        return 0;
+
+    for (uint8_t i = 1; i < *num; i++)
+    {
+        p_out[i].acc_scale = p_out[0].acc_scale;
+        p_out[i].gyr_scale = p_out[0].gyr_scale;
+    }
+
+    reader.p_buf = &p_in[size];
+    reader.acc = 0;
+    reader.bit = 0;
+
+    for (uint8_t s = 0; s < IMU_CODEC_STREAM_NUM; s++)
+    {
+        for (uint8_t i = 1; i < *num; i++)
+            ImuCodec_Stream_Apply(&p_out[i], &p_out[i - 1], s, ImuCodec_BitReader_Get(&reader, width[s]) + base[s]);
+    }
+
+    return size + (bit_sum + 7) / 8 + 1;
+}
+
+/* org data has its zero offset removed and can go past full scale, float to int16 cast is undefined out of range */
+int16_t ImuCodec_Quantize(float val, float scale)
+{
+    float lsb = val * scale;
+
+    if (lsb >= (float)INT16_MAX)
+        return INT16_MAX;
+
+    /* nan end up here as well */
+    if (!(lsb > (float)INT16_MIN))
+        return INT16_MIN;
+
+    return (int16_t)lroundf(lsb);
+}
+
+/* a new block start every IMU_CODEC_BLOCK_SIZE samples or when the scale changed */
+uint16_t ImuCodec_Encode(const ImuCodec_Sample_TypeDef *p_in, uint16_t num, uint8_t *p_out, uint16_t out_size)
+{
+    uint16_t size = 0;
+    uint16_t block_size = 0;
+    uint8_t block_num = 0;
+
+    if ((p_in == NULL) || (p_out == NULL))
+        return 0;
+
+    while (num)
+    {
+        block_num = 1;
+        while ((block_num < num) && (block_num < IMU_CODEC_BLOCK_SIZE) &&
+               (p_in[block_num].acc_scale == p_in[0].acc_scale) &&
+               (p_in[block_num].gyr_scale == p_in[0].gyr_scale))
+            block_num ++;
+
+        block_size = ImuCodec_Encode_Block(p_in, block_num, &p_out[size], out_size - size);
+        if (block_size == 0)
+            return 0;
+
+        size += block_size;
+        p_in += block_num;
+        num -= block_num;
+    }
+
+    return size;
+}
+
+uint16_t ImuCodec_Decode(const uint8_t *p_in, uint16_t in_size, ImuCodec_Sample_TypeDef *p_out, uint16_t out_num)
+{
+    uint16_t decode_num = 0;
+    uint16_t block_size = 0;
+    uint8_t block_num = 0;
+
+    if ((p_in == NULL) || (p_out == NULL))
+        return 0;
+
+    while (in_size)
+    {
+        block_size = ImuCodec_Decode_Block(p_in, in_size, &p_out[decode_num], out_num - decode_num, &block_num);
+        if (block_size == 0)
+            return 0;
+
+        decode_num += block_num;
+        p_in += block_size;
+        in_size -= block_size;
+    }
+
+    return decode_num;
+}
@@ -0,0 +1,62 @@
+#ifndef __IMU_CODEC_H
+#define __IMU_CODEC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+
+/*
+ * imu log block codec, replace lzo on the imu log path
+ * sample is already quantized to int16 by its scale, a block hold up to IMU_CODEC_BLOCK_SIZE samples with the same scale
+ *
+ * block layout (little endian)
+ *   u8  sample number
+ *   key sample : u32 time, u8 cyc, f32 acc scale, f32 gyr scale, i16 channel[IMU_CODEC_CH_NUM]
+ *   stream table : for time / cyc / every channel, varint base + u8 bit width
+ *   bit stream : stream by stream, (sample number - 1) delta of width bit, lsb first, padded to byte
+ *   u8  sum of all byte above
+ *
+ * time and cyc delta are unsigned, channel delta is zigzag, every stream subtract its block minimum (base) before packing
+ * noisy channel cost its noise bit width, steady time / cyc stream cost 0 bit per sample
+ *
+ * shared with Analysis_Tool/Log2Txt, keep it free of any firmware dependence
+ */
+#define IMU_CODEC_BLOCK_SIZE 32
+#define IMU_CODEC_CH_NUM 12
+#define IMU_CODEC_STREAM_NUM (IMU_CODEC_CH_NUM + 2)
+
+#define IMU_CODEC_KEY_SIZE (sizeof(uint32_t) + sizeof(uint8_t) + 2 * sizeof(float) + IMU_CODEC_CH_NUM * sizeof(int16_t))
+#define IMU_CODEC_STREAM_WIDTH_MAX (32 + 8 + IMU_CODEC_CH_NUM * 17)
+#define IMU_CODEC_BLOCK_MAX_BYTE (1 + IMU_CODEC_KEY_SIZE + IMU_CODEC_STREAM_NUM * 6 + \
+                                  ((IMU_CODEC_BLOCK_SIZE - 1) * IMU_CODEC_STREAM_WIDTH_MAX + 7) / 8 + 1)
+
+typedef enum
+{
+    ImuCodec_OrgAcc = 0,
+    ImuCodec_OrgGyr = 3,
+    ImuCodec_FltAcc = 6,
+    ImuCodec_FltGyr = 9,
+} ImuCodec_Channel_List;
+
+#pragma pack(1)
+typedef struct
+{
+    uint32_t time;
+    uint8_t cyc;
+    float acc_scale;
+    float gyr_scale;
+    int16_t ch[IMU_CODEC_CH_NUM];   /* axis x y z of org acc, org gyr, flt acc, flt gyr */
+} ImuCodec_Sample_TypeDef;
+#pragma pack()
+
+/* physical value to int16 lsb, rounded to nearest and clamped to the int16 range */
+int16_t ImuCodec_Quantize(float val, float scale);
+
+/* return byte encoded, 0 when p_out is too small */
+uint16_t ImuCodec_Encode(const ImuCodec_Sample_TypeDef *p_in, uint16_t num, uint8_t *p_out, uint16_t out_size);
+
+/* return sample decoded, 0 on broken block or when p_out is too small */
+uint16_t ImuCodec_Decode(const uint8_t *p_in, uint16_t in_size, ImuCodec_Sample_TypeDef *p_out, uint16_t out_num);
+
+#endif
@@ -1,206 +1,254 @@
 #include "error_log.h"
-#include "../DataStructure/CusQueue.h"
-#include <stdarg.h>
+#include "shell_port.h"
+#include <stdio.h>
 
 /*
-error data in queue
---------------------------------------------------------------------------------------------
-| out state | log state | info size |                    error describe                    |
---------------------------------------------------------------------------------------------
-*/
+ * event ring is multi producer single consumer
+ * producer reserve a slot by atomic increment, clear its seq, fill it, then publish seq = reserve index + 1
+ * ring overwrite the oldest event when the consumer fall behind, overwritten event is counted as lost
+ */
 
 /* internal vriable */
-static bool ErrorQueue_Init = false;
-static bool ErrorQueue_CreateState = false;
-static QueueObj_TypeDef ErrorQueue;
+static ErrorTable_TypeDef ErrorTable[ERROR_LOG_TABLE_MAX];
+static uint8_t ErrorTable_Num = 0;
+static ErrorEvent_TypeDef ErrorEvent_Ring[ERROR_EVENT_RING_SIZE];
+static volatile uint32_t ErrorEvent_Head = 0;
+static uint32_t ErrorEvent_Tail = 0;
+static uint32_t ErrorEvent_Lost = 0;
 static error_port_callback out_callback = NULL;
 static error_port_callback log_callback = NULL;
 static Error_Port_Reg port_reg;
+static char Error_Desc_Buf[ERROR_DESC_BUFFSIZE];
+
+/* internal function */
+static void Error_Event_Proc(const ErrorEvent_TypeDef *event);
 
 /* external function */
-static Error_Handler ErrorTree_Create(char *name);
+static Error_Handler ErrorTable_Create(char *name);
 static bool Error_Register(Error_Handler hdl, Error_Obj_Typedef *obj, uint16_t num);
 static bool Error_Trigger(Error_Handler hdl, int16_t code, uint8_t *p_arg, uint16_t size);
-static bool Error_Proc(Error_Handler hdl);
+static uint16_t Error_Proc(void);
+static uint32_t Error_Get_Lost(void);
 static void Error_Set_Callback(ErrorLog_Callback_Type_List type, error_port_callback callback);
-static uint32_t Error_DescToQueue(const char *str, ...);
+static uint32_t Error_Add_Desc(const char *str, ...);
 
 ErrorLog_TypeDef ErrorLog = {
-    .create = ErrorTree_Create,
+    .create = ErrorTable_Create,
     .proc = Error_Proc,
+    .get_lost = Error_Get_Lost,
     .registe = Error_Register,
     .trigger = Error_Trigger,
     .set_callback = Error_Set_Callback,
-    .add_desc = Error_DescToQueue,
+    .add_desc = Error_Add_Desc,
 };
 
-static data_handle Error_InsertPriority_Compare(data_handle l_addr, data_handle r_addr)
+/* handle is table index + 1, 0 stay invalid */
+static Error_Handler ErrorTable_Create(char *name)
 {
-    if ((l_addr == 0) && (r_addr == 0) && (l_addr != r_addr))
-        return 0;
-
-    ErrorTreeDataToObj(l_addr)->code;
-    ErrorTreeDataToObj(r_addr)->code;
+    ErrorTable_TypeDef *table = NULL;
 
-    if (ErrorTreeDataToObj(l_addr)->code > ErrorTreeDataToObj(r_addr)->code)
-        return r_addr;
+    if (ErrorTable_Num >= ERROR_LOG_TABLE_MAX)
+        return 0;
 
-    if (ErrorTreeDataToObj(l_addr)->code < ErrorTreeDataToObj(r_addr)->code)
-        return l_addr;
+    table = &ErrorTable[ErrorTable_Num];
+    memset(table, 0, sizeof(ErrorTable_TypeDef));
+    memset(table->slot, ERROR_LOG_NONE_SLOT, sizeof(table->slot));
+    table->name = name;
 
-    return 0;
+    ErrorTable_Num ++;
+    return ErrorTable_Num;
 }
 
-static uint8_t Error_Search(data_handle l_addr, data_handle r_addr)
+/* code of one list must span less than ERROR_LOG_CODE_RANGE_MAX */
+static bool Error_Register(Error_Handler hdl, Error_Obj_Typedef *Obj_List, uint16_t num)
 {
-    volatile int16_t node_code = ErrorTreeDataToObj(l_addr)->code;
-    volatile int16_t code = *((int16_t *)((uint32_t)r_addr));
+    ErrorTable_TypeDef *table = NULL;
+    int16_t code_min = 0;
+    int16_t code_max = 0;
 
-    if (node_code > code)
-        return Tree_Search_L;
+    if ((hdl == 0) || (hdl > ErrorTable_Num) || (Obj_List == NULL) || (num == 0) || (num >= ERROR_LOG_NONE_SLOT))
+        return false;
 
-    if (node_code < code)
-        return Tree_Search_R;
+    code_min = Obj_List[0].code;
+    code_max = Obj_List[0].code;
+    for (uint16_t i = 1; i < num; i++)
+    {
+        if (Obj_List[i].code < code_min)
+            code_min = Obj_List[i].code;
 
-    if (node_code == code)
-        return Tree_Search_D;
+        if (Obj_List[i].code > code_max)
+            code_max = Obj_List[i].code;
+    }
 
-    return 0;
-}
+    if ((code_max - code_min) >= ERROR_LOG_CODE_RANGE_MAX)
+        return false;
 
-static Error_Handler ErrorTree_Create(char *name)
-{
-    volatile ErrorTree_TypeDef *Error_Tmp = NULL;
+    table = &ErrorTable[hdl - 1];
+    memset(table->slot, ERROR_LOG_NONE_SLOT, sizeof(table->slot));
+    table->list = Obj_List;
+    table->code_base = code_min;
 
-    if (!ErrorQueue_Init)
-    {
-        ErrorQueue_CreateState = Queue.create_auto(&ErrorQueue, "ErrorQueue", ERROR_DESC_BUFFSIZE);
-        ErrorQueue_Init = true;
-    }
+    for (uint16_t i = 0; i < num; i++)
+        table->slot[Obj_List[i].code - code_min] = (uint8_t)i;
 
-    Error_Tmp = (ErrorTree_TypeDef *)ERROR_LOG_MALLOC(sizeof(ErrorTree_TypeDef));
+    table->reg_num = num;
+    return true;
+}
 
-    if (Error_Tmp == NULL)
-        return 0;
+static bool Error_Trigger(Error_Handler hdl, int16_t code, uint8_t *p_arg, uint16_t size)
+{
+    ErrorTable_TypeDef *table = NULL;
+    ErrorEvent_TypeDef *event = NULL;
+    int32_t index = 0;
+    uint32_t reserve = 0;
 
-    Error_Tmp->tree = BalanceTree.Create(name, Error_InsertPriority_Compare, Error_Search, Error_InsertPriority_Compare);
+    if ((hdl == 0) || (hdl > ErrorTable_Num))
+        return false;
 
-    if (Error_Tmp == NULL)
-        return 0;
+    table = &ErrorTable[hdl - 1];
+    index = code - table->code_base;
+    if ((table->list == NULL) || (index < 0) || (index >= ERROR_LOG_CODE_RANGE_MAX) || (table->slot[index] == ERROR_LOG_NONE_SLOT))
+        return false;
 
-    Error_Tmp->reg_num = 0;
-    Error_Tmp->link_node = NULL;
+    reserve = __atomic_fetch_add(&ErrorEvent_Head, 1, __ATOMIC_RELAXED);
+    event = &ErrorEvent_Ring[reserve & (ERROR_EVENT_RING_SIZE - 1)];
 
-    return (Error_Handler)Error_Tmp;
-}
+    /* slot may still be read by the consumer when the ring wrap */
+    __atomic_store_n(&event->seq, 0, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
 
-static bool Error_Register(Error_Handler hdl, Error_Obj_Typedef *Obj_List, uint16_t num)
-{
-    if (hdl == 0)
-        return false;
+    event->time_ms = SrvOsCommon.get_os_ms();
+    event->code = code;
+    event->table = hdl - 1;
+    event->p_arg = p_arg;
+    event->size = size;
+    event->arg_size = 0;
 
-    for (uint16_t i = 0; i < num; i++)
+    if (p_arg && size && (size <= ERROR_EVENT_ARG_SIZE))
     {
-        BalanceTree.Insert(ErrorHandleToObj(hdl)->tree, Obj_List[i].desc, (data_handle)(&Obj_List[i]));
+        memcpy(event->arg, p_arg, size);
+        event->arg_size = size;
     }
 
-    ErrorHandleToObj(hdl)->reg_num = num;
+    __atomic_store_n(&event->seq, reserve + 1, __ATOMIC_RELEASE);
     return true;
 }
 
-static uint32_t Error_DescToQueue(const char *str, ...)
+/* drain the ring, return event processed */
+static uint16_t Error_Proc(void)
 {
-    uint32_t length = 0;
-    char p_data[128] = {0};
-    va_list arp;
-    va_start(arp, str);
+    ErrorEvent_TypeDef event;
+    ErrorEvent_TypeDef *slot = NULL;
+    uint32_t head = 0;
+    uint32_t seq = 0;
+    uint16_t num = 0;
 
-    if (ErrorQueue_CreateState)
+    while (1)
     {
-        length = vsnprintf((char *)p_data, sizeof(p_data), (char *)str, arp);
+        head = __atomic_load_n(&ErrorEvent_Head, __ATOMIC_ACQUIRE);
+        if (head == ErrorEvent_Tail)
+            break;
+
+        if ((head - ErrorEvent_Tail) > ERROR_EVENT_RING_SIZE)
+        {
+            ErrorEvent_Lost += head - ErrorEvent_Tail - ERROR_EVENT_RING_SIZE;
+            ErrorEvent_Tail = head - ERROR_EVENT_RING_SIZE;
+        }
+
+        slot = &ErrorEvent_Ring[ErrorEvent_Tail & (ERROR_EVENT_RING_SIZE - 1)];
+        seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+
+        /* producer preempted half way, pick it up on the next call */
+        if (seq != (ErrorEvent_Tail + 1))
+        {
+            if ((int32_t)(seq - (ErrorEvent_Tail + 1)) <= 0)
+                break;
+
+            /* already overwritten by a later event */
+            ErrorEvent_Lost ++;
+            ErrorEvent_Tail ++;
+            continue;
+        }
+
+        memcpy(&event, slot, sizeof(ErrorEvent_TypeDef));
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+        /* overwritten while copying */
+        if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) != seq)
+        {
+            ErrorEvent_Lost ++;
+            ErrorEvent_Tail ++;
+            continue;
+        }
 
-        port_reg.section.len = length;
-        Queue.push(&ErrorQueue, (uint8_t *)&port_reg.val, sizeof(port_reg.val));
-        Queue.push(&ErrorQueue, (uint8_t *)p_data, length);
+        ErrorEvent_Tail ++;
+        Error_Event_Proc(&event);
+        num ++;
     }
 
-    va_end(arp);
-    return length;
+    return num;
 }
 
-/* still in half way */
-static bool Error_Trigger(Error_Handler hdl, int16_t code, uint8_t *p_arg, uint16_t size)
+static uint32_t Error_Get_Lost(void)
 {
-    int16_t code_tmp = code;
-    ErrorStream_TypeDef data_stream;
-    char *letter = NULL;
+    return ErrorEvent_Lost;
+}
+
+/* describe and process callback of one event, runs in the consumer context */
+static void Error_Event_Proc(const ErrorEvent_TypeDef *event)
+{
+    ErrorTable_TypeDef *table = &ErrorTable[event->table];
+    Error_Obj_Typedef *obj = &table->list[table->slot[event->code - table->code_base]];
+    uint8_t *p_arg = event->p_arg;
+
+    if (event->arg_size)
+        p_arg = (uint8_t *)event->arg;
+
+    obj->triggered = true;
+    obj->trigger_cnt ++;
+    obj->lst_ms = event->time_ms;
+    obj->prc_data_stream.p_data = p_arg;
+    obj->prc_data_stream.size = event->size;
 
     port_reg.val = 0;
+    port_reg.section.out_reg = obj->out;
+    port_reg.section.log_reg = obj->log;
 
-    if (hdl == 0)
-        return false;
+    if (port_reg.val)
+        Error_Add_Desc("[ %s ] %s", table->name, obj->desc);
 
-    TreeNode_Handle search_handle = BalanceTree.Search(ErrorHandleToObj(hdl)->tree, (data_handle)&code_tmp);
+    if ((obj->proc_type == Error_Proc_Immd) && obj->prc_callback)
+        obj->prc_callback(event->code, p_arg, event->size);
 
-    if(!search_handle)
-        return false;
+    port_reg.val = 0;
+}
 
-    data_stream.p_data = p_arg;
-    data_stream.size = size;
+/* only used inside the process callback, output follow the out / log setting of the event in process */
+static uint32_t Error_Add_Desc(const char *str, ...)
+{
+    int length = 0;
+    va_list arp;
 
-    (ErrorTreeDataToObj(TreeNodeHandleToObj(search_handle)->data)->prc_data_stream).p_data = p_arg;
-    (ErrorTreeDataToObj(TreeNodeHandleToObj(search_handle)->data)->prc_data_stream).size = size;
+    if ((port_reg.section.out_reg == 0) && (port_reg.section.log_reg == 0))
+        return 0;
 
-    /* find target node */
-    if (search_handle)
-    {
-        if (TreeNodeHandleToObj(search_handle)->data)
-        {
-            port_reg.section.log_reg = ErrorTreeDataToObj(TreeNodeHandleToObj(search_handle)->data)->log;
-            port_reg.section.out_reg = ErrorTreeDataToObj(TreeNodeHandleToObj(search_handle)->data)->out;
-            port_reg.section.len = strlen(ErrorTreeDataToObj(TreeNodeHandleToObj(search_handle)->data)->desc) + strlen(ErrorHandleToObj(hdl)->tree->name) + strlen("[  ] ");
-
-            if (ErrorQueue_CreateState && port_reg.val)
-            {
-                /* Push Error describe into Error_Queue */
-                /* push out or log state */
-                Queue.push(&ErrorQueue, (uint8_t *)&port_reg.val, sizeof(port_reg.val));
-                /* push error tree name */
-                letter = "[ ";
-                Queue.push(&ErrorQueue, (uint8_t *)letter, strlen(letter));
-
-                Queue.push(&ErrorQueue, (uint8_t *)ErrorHandleToObj(hdl)->tree->name, strlen(ErrorHandleToObj(hdl)->tree->name));
-
-                letter = " ] ";
-                Queue.push(&ErrorQueue, (uint8_t *)letter, strlen(letter));
-
-                /* push error decribe */
-                Queue.push(&ErrorQueue, (uint8_t *)ErrorTreeDataToObj(TreeNodeHandleToObj(search_handle)->data)->desc, strlen(ErrorTreeDataToObj(TreeNodeHandleToObj(search_handle)->data)->desc));
-            }
-
-            if (ErrorTreeDataToObj(TreeNodeHandleToObj(search_handle)->data)->proc_type == Error_Proc_Immd)
-            {
-                /* trigger process callback */
-                if (ErrorTreeDataToObj(TreeNodeHandleToObj(search_handle)->data)->prc_callback)
-                {
-                    ErrorTreeDataToObj(TreeNodeHandleToObj(search_handle)->data)->prc_callback(code, data_stream.p_data, data_stream.size);
-                }
-            }
-            else if (ErrorTreeDataToObj(TreeNodeHandleToObj(search_handle)->data)->proc_type == Error_Proc_Next)
-            {
-                /* add error into linked list */
-                /* reserve */
-            }
-            else if (ErrorTreeDataToObj(TreeNodeHandleToObj(search_handle)->data)->proc_type == Error_Proc_Ignore)
-            {
-                /* reserve */
-            }
-        }
-    }
+    va_start(arp, str);
+    length = vsnprintf(Error_Desc_Buf, sizeof(Error_Desc_Buf), str, arp);
+    va_end(arp);
 
-    port_reg.val = 0;
+    if (length <= 0)
+        return 0;
 
-    return true;
+    if (length >= (int)sizeof(Error_Desc_Buf))
+        length = sizeof(Error_Desc_Buf) - 1;
+
+    if (port_reg.section.out_reg && out_callback)
+        out_callback((uint8_t *)Error_Desc_Buf, length);
+
+    if (port_reg.section.log_reg && log_callback)
+        log_callback((uint8_t *)Error_Desc_Buf, length);
+
+    return length;
 }
 
 static void Error_Set_Callback(ErrorLog_Callback_Type_List type, error_port_callback callback)
@@ -219,51 +267,32 @@ static void Error_Set_Callback(ErrorLog_Callback_Type_List type, error_port_call
         break;
     }
 }
-/* still in half way */
-static bool Error_Proc(Error_Handler hdl)
+
+/************************************************** shell section ************************************************/
+static void Error_Show(void)
 {
-    ErrorStream_TypeDef stream;
-    Error_Port_Reg ErrorQueue_Head_State;
-    uint8_t *p_data = NULL;
+    Shell *shell_obj = Shell_GetInstence();
+    ErrorTable_TypeDef *table = NULL;
+    Error_Obj_Typedef *obj = NULL;
 
-    memset(&ErrorQueue_Head_State, 0, sizeof(Error_Port_Reg));
-    memset(&stream, 0, sizeof(ErrorStream_TypeDef));
+    if (shell_obj == NULL)
+        return;
 
-    if (hdl == 0 || !ErrorQueue_CreateState)
-        return false;
+    shellPrint(shell_obj, "\t[Error] %d table, %d event, %d lost, %d pending\r\n", ErrorTable_Num, ErrorEvent_Head,
+               ErrorEvent_Lost, ErrorEvent_Head - ErrorEvent_Tail);
 
-    /* reserved still developing */
-    if (ErrorHandleToObj(hdl)->link_node)
+    for (uint8_t t = 0; t < ErrorTable_Num; t++)
     {
-    }
+        table = &ErrorTable[t];
+        shellPrint(shell_obj, "\t%s : %d registered\r\n", table->name, table->reg_num);
 
-    Queue.check(&ErrorQueue, 0, (uint8_t *)&ErrorQueue_Head_State.val, sizeof(ErrorQueue_Head_State.val));
-
-    if ((ErrorQueue_Head_State.section.out_reg || ErrorQueue_Head_State.section.log_reg) && (out_callback || log_callback))
-    {
-        p_data = (uint8_t *)ERROR_LOG_MALLOC(ErrorQueue_Head_State.section.len);
-
-        if (p_data)
+        for (uint16_t i = 0; i < table->reg_num; i++)
         {
-            if ((Queue.state(ErrorQueue) == Queue_full) || (Queue.state(ErrorQueue) == Queue_ok))
-            {
-                Queue.pop(&ErrorQueue, (uint8_t *)&ErrorQueue_Head_State.val, sizeof(ErrorQueue_Head_State.val));
-                Queue.pop(&ErrorQueue, (uint8_t *)p_data, ErrorQueue_Head_State.section.len);
-
-                if (ErrorQueue_Head_State.section.out_reg && out_callback && p_data)
-                {
-                    out_callback(p_data, ErrorQueue_Head_State.section.len);
-                }
-
-                if (ErrorQueue_Head_State.section.log_reg && log_callback && p_data)
-                {
-                    log_callback(p_data, ErrorQueue_Head_State.section.len);
-                }
-            }
-
-            ERROR_LOG_FREE(p_data);
+            obj = &table->list[i];
+
+            if (obj->trigger_cnt)
+                shellPrint(shell_obj, "\t\tcode %4d cnt %5d last %8d ms %s", obj->code, obj->trigger_cnt, obj->lst_ms, obj->desc);
         }
     }
-
-    return true;
 }
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Error_Show, Error_Show, Show triggered error);
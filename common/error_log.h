@@ -5,16 +5,24 @@
 #include <stdbool.h>
 #include <string.h>
 #include <stdarg.h>
-#include "binary_tree.h"
 #include "Srv_OsCommon.h"
-#include "linked_list.h"
 
-#define ERROR_DESC_BUFFSIZE 1024
-#define ERROR_LOG_MALLOC(x) SrvOsCommon.malloc(x)
-#define ERROR_LOG_FREE(x) SrvOsCommon.free(x)
-
-#define ErrorHandleToObj(x) ((ErrorTree_TypeDef *)x)
-#define ErrorTreeDataToObj(x) ((Error_Obj_Typedef *)x)
+/*
+ * error event
+ * every module register a static error list, the list is indexed by code - lowest code once at register
+ * trigger only look up the slot and put a binary event (table, code, time, argument snapshot) into a ram ring
+ * no lock, no malloc and no string formatting on the trigger path, isr and time critical task can trigger
+ * describe output and process callback run later in ErrorLog.proc, called by a low priority task
+ *
+ * argument up to ERROR_EVENT_ARG_SIZE byte is copied into the event and handed to the callback from the copy
+ * bigger argument is handed by its pointer, it must stay valid (static object) until the event is processed
+ */
+#define ERROR_LOG_TABLE_MAX 8
+#define ERROR_LOG_CODE_RANGE_MAX 64
+#define ERROR_EVENT_RING_SIZE 32 /* power of 2 */
+#define ERROR_EVENT_ARG_SIZE 8
+#define ERROR_DESC_BUFFSIZE 128
+#define ERROR_LOG_NONE_SLOT 0xFF
 
 typedef int8_t (*error_port_callback)(uint8_t *p_data, uint16_t size);
 typedef void (*error_proc_callback)(int16_t code, uint8_t *p_data, uint16_t size);
@@ -29,8 +37,8 @@ typedef enum
 
 typedef enum
 {
-    Error_Proc_Immd = 0,
-    Error_Proc_Next,
+    Error_Proc_Immd = 0,    /* process callback run on the next ErrorLog.proc */
+    Error_Proc_Next,        /* reserve */
     Error_Proc_Ignore,
 } Error_Proc_List;
 
@@ -80,23 +88,39 @@ typedef struct
     bool log;
     error_proc_callback prc_callback;
     ErrorStream_TypeDef prc_data_stream;
-    item_obj *item;
+    uint16_t trigger_cnt;   /* counted by the consumer */
+    uint32_t lst_ms;
 } Error_Obj_Typedef;
+#pragma pack()
 
 typedef struct
 {
+    const char *name;
+    Error_Obj_Typedef *list;
     uint16_t reg_num;
-    Tree_TypeDef *tree;
-    list_obj *link_node;
-} ErrorTree_TypeDef;
-#pragma pack()
+    int16_t code_base;      /* lowest registered code */
+    uint8_t slot[ERROR_LOG_CODE_RANGE_MAX]; /* code - code_base -> list index */
+} ErrorTable_TypeDef;
+
+typedef struct
+{
+    volatile uint32_t seq;  /* reserve index + 1, set once the event is complete */
+    uint32_t time_ms;
+    int16_t code;
+    uint8_t table;          /* handle - 1 */
+    uint8_t arg_size;       /* byte copied into arg */
+    uint8_t *p_arg;         /* caller argument, used when it does not fit the copy */
+    uint16_t size;
+    uint8_t arg[ERROR_EVENT_ARG_SIZE];
+} ErrorEvent_TypeDef;
 
 typedef struct
 {
     Error_Handler (*create)(char *name);
     bool (*registe)(Error_Handler hdl, Error_Obj_Typedef *obj, uint16_t num);
     bool (*trigger)(Error_Handler hdl, int16_t code, uint8_t *p_arg, uint16_t size);
-    bool (*proc)(Error_Handler hdl);
+    uint16_t (*proc)(void);
+    uint32_t (*get_lost)(void);
     void (*set_callback)(ErrorLog_Callback_Type_List type, error_port_callback callback);
     uint32_t (*add_desc)(const char *str, ...);
 } ErrorLog_TypeDef;
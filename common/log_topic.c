@@ -0,0 +1,158 @@
+#include "log_topic.h"
+
+typedef struct
+{
+    const LogTopic_Schema_TypeDef *schema;
+    uint16_t record_size;
+    uint32_t lst_ms;
+    bool first;
+} LogTopic_Monitor_TypeDef;
+
+/* internal vriable */
+static const uint8_t LogTopic_TypeSize[LogTopic_Type_Sum] = LOG_TOPIC_TYPE_SIZE_TABLE;
+static LogTopic_Monitor_TypeDef LogTopic_Monitor[LOG_TOPIC_MAX];
+static uint8_t LogTopic_Num = 0;
+
+/* internal function */
+static uint16_t LogTopic_Put_String(uint8_t *p_buf, uint16_t size, const char *str);
+
+/* external function */
+static int8_t LogTopic_Regist(const LogTopic_Schema_TypeDef *schema);
+static uint8_t LogTopic_Get_Num(void);
+static uint16_t LogTopic_Get_Schema(uint8_t *p_buf, uint16_t size);
+static uint16_t LogTopic_Poll(uint32_t sys_ms, uint8_t *p_buf, uint16_t size);
+
+LogTopic_TypeDef LogTopic = {
+    .regist = LogTopic_Regist,
+    .get_num = LogTopic_Get_Num,
+    .get_schema = LogTopic_Get_Schema,
+    .poll = LogTopic_Poll,
+};
+
+static int8_t LogTopic_Regist(const LogTopic_Schema_TypeDef *schema)
+{
+    uint16_t record_size = 0;
+
+    if ((schema == NULL) || (schema->name == NULL) || (schema->fill == NULL) || (schema->field == NULL) ||
+        (schema->field_num == 0) || (schema->field_num > LOG_TOPIC_FIELD_MAX) || (LogTopic_Num >= LOG_TOPIC_MAX))
+        return -1;
+
+    for (uint8_t i = 0; i < schema->field_num; i++)
+    {
+        if ((schema->field[i].name == NULL) || (schema->field[i].type >= LogTopic_Type_Sum) || (schema->field[i].num == 0))
+            return -1;
+
+        record_size += LogTopic_TypeSize[schema->field[i].type] * schema->field[i].num;
+    }
+
+    if (record_size > LOG_TOPIC_RECORD_MAX)
+        return -1;
+
+    LogTopic_Monitor[LogTopic_Num].schema = schema;
+    LogTopic_Monitor[LogTopic_Num].record_size = record_size;
+    LogTopic_Monitor[LogTopic_Num].lst_ms = 0;
+    LogTopic_Monitor[LogTopic_Num].first = true;
+
+    return LogTopic_Num++;
+}
+
+static uint8_t LogTopic_Get_Num(void)
+{
+    return LogTopic_Num;
+}
+
+static uint16_t LogTopic_Put_String(uint8_t *p_buf, uint16_t size, const char *str)
+{
+    uint16_t len = strnlen(str, LOG_TOPIC_NAME_LEN - 1);
+
+    if (size < (len + 1))
+        return 0;
+
+    memcpy(p_buf, str, len);
+    p_buf[len] = '\0';
+
+    return len + 1;
+}
+
+/* return 0 when the table does not fit */
+static uint16_t LogTopic_Get_Schema(uint8_t *p_buf, uint16_t size)
+{
+    const LogTopic_Schema_TypeDef *schema = NULL;
+    uint16_t offset = 0;
+    uint16_t len = 0;
+
+    if ((p_buf == NULL) || (size < 2) || (LogTopic_Num == 0))
+        return 0;
+
+    p_buf[offset++] = LOG_TOPIC_VERSION;
+    p_buf[offset++] = LogTopic_Num;
+
+    for (uint8_t id = 0; id < LogTopic_Num; id++)
+    {
+        schema = LogTopic_Monitor[id].schema;
+
+        if ((size - offset) < 6)
+            return 0;
+
+        p_buf[offset++] = id;
+        memcpy(&p_buf[offset], &schema->period_ms, sizeof(uint16_t));
+        offset += sizeof(uint16_t);
+        memcpy(&p_buf[offset], &LogTopic_Monitor[id].record_size, sizeof(uint16_t));
+        offset += sizeof(uint16_t);
+        p_buf[offset++] = schema->field_num;
+
+        len = LogTopic_Put_String(&p_buf[offset], size - offset, schema->name);
+        if (len == 0)
+            return 0;
+        offset += len;
+
+        for (uint8_t i = 0; i < schema->field_num; i++)
+        {
+            if ((size - offset) < 2)
+                return 0;
+
+            p_buf[offset++] = schema->field[i].type;
+            p_buf[offset++] = schema->field[i].num;
+
+            len = LogTopic_Put_String(&p_buf[offset], size - offset, schema->field[i].name);
+            if (len == 0)
+                return 0;
+            offset += len;
+        }
+    }
+
+    return offset;
+}
+
+/* every topic due at sys_ms append one record, topic not fitting in the buffer wait for the next poll */
+static uint16_t LogTopic_Poll(uint32_t sys_ms, uint8_t *p_buf, uint16_t size)
+{
+    LogTopic_Monitor_TypeDef *monitor = NULL;
+    uint16_t offset = 0;
+
+    if (p_buf == NULL)
+        return 0;
+
+    for (uint8_t id = 0; id < LogTopic_Num; id++)
+    {
+        monitor = &LogTopic_Monitor[id];
+
+        if (!monitor->first && ((sys_ms - monitor->lst_ms) < monitor->schema->period_ms))
+            continue;
+
+        if ((size - offset) < (LOG_TOPIC_RECORD_HEAD + monitor->record_size))
+            continue;
+
+        if (!monitor->schema->fill(&p_buf[offset + LOG_TOPIC_RECORD_HEAD]))
+            continue;
+
+        p_buf[offset] = id;
+        memcpy(&p_buf[offset + 1], &sys_ms, sizeof(uint32_t));
+        offset += LOG_TOPIC_RECORD_HEAD + monitor->record_size;
+
+        monitor->lst_ms = sys_ms;
+        monitor->first = false;
+    }
+
+    return offset;
+}
@@ -0,0 +1,76 @@
+#ifndef __LOG_TOPIC_H
+#define __LOG_TOPIC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/*
+ * multi topic log
+ * every topic register a schema (name, period, field name / type / count) and a fill callback
+ * the schema table is the first frame of a log file, records after it are tagged by topic id
+ * so the host side decode any topic without knowing its layout
+ *
+ * both go into the log frame : header + u32 payload size + payload + 0xED
+ *   schema frame payload : u8 version, u8 topic num,
+ *                          per topic  : u8 id, u16 period ms, u16 record size, u8 field num, name \0
+ *                          per field  : u8 type, u8 count, name \0
+ *   data frame payload   : records back to back, u8 id + u32 time ms + packed fields in schema order
+ *
+ * shared with Analysis_Tool/Log2Txt, keep it free of any firmware dependence
+ */
+#define LOG_TOPIC_SCHEMA_HEADER 0xCD
+#define LOG_TOPIC_DATA_HEADER 0xCC
+#define LOG_TOPIC_VERSION 1
+
+#define LOG_TOPIC_MAX 8
+#define LOG_TOPIC_FIELD_MAX 24
+#define LOG_TOPIC_NAME_LEN 16
+#define LOG_TOPIC_RECORD_MAX 128
+#define LOG_TOPIC_RECORD_HEAD (sizeof(uint8_t) + sizeof(uint32_t))
+
+typedef enum
+{
+    LogTopic_U8 = 0,
+    LogTopic_I8,
+    LogTopic_U16,
+    LogTopic_I16,
+    LogTopic_U32,
+    LogTopic_I32,
+    LogTopic_F32,
+    LogTopic_F64,
+    LogTopic_Type_Sum,
+} LogTopic_Type_List;
+
+#define LOG_TOPIC_TYPE_SIZE_TABLE {1, 1, 2, 2, 4, 4, 4, 8}
+
+typedef struct
+{
+    const char *name;
+    LogTopic_Type_List type;
+    uint8_t num;            /* array count, 1 for a single value */
+} LogTopic_Field_TypeDef;
+
+/* write the packed record in schema order, return false to skip this period */
+typedef bool (*LogTopic_Fill_Callback)(uint8_t *p_record);
+
+typedef struct
+{
+    const char *name;
+    uint16_t period_ms;     /* record decimation, 0 record on every poll */
+    const LogTopic_Field_TypeDef *field;
+    uint8_t field_num;
+    LogTopic_Fill_Callback fill;
+} LogTopic_Schema_TypeDef;
+
+typedef struct
+{
+    int8_t (*regist)(const LogTopic_Schema_TypeDef *schema);
+    uint8_t (*get_num)(void);
+    uint16_t (*get_schema)(uint8_t *p_buf, uint16_t size);
+    uint16_t (*poll)(uint32_t sys_ms, uint8_t *p_buf, uint16_t size);
+} LogTopic_TypeDef;
+
+extern LogTopic_TypeDef LogTopic;
+
+#endif
@@ -12,6 +12,20 @@
 #define DEG_2_REG(x) (x / 57.29578f)
 #define REG_2_DEG(x) (x * 57.29578f)
 
+/*
+ * hot path placement
+ * ITCM_CODE : function copied to itcm at startup, zero wait state fetch
+ * DTCM_DATA : variable pinned to dtcm, zero wait state and out of dma coherency range
+ * target without tcm (at32f435) leave them empty
+ */
+#if defined STM32H743xx
+#define ITCM_CODE __attribute__((section(".itcm_text"), noinline))
+#define DTCM_DATA __attribute__((section(".dtcm_data")))
+#else
+#define ITCM_CODE
+#define DTCM_DATA
+#endif
+
 int16_t Common_CRC16(const uint8_t *pBuf, const uint32_t len);
 uint8_t Get_Bit_Index(uint16_t val);
 uint8_t Get_OnSet_Bit_Num(uint32_t value);
@@ -0,0 +1,581 @@
+/*
+ * hot kernel micro benchmark
+ * same source run on target over the shell (dwt cycle) and on host by Analysis_Tool/Bench (ns counter)
+ * input vector is integer generated so every run and every platform see the same data
+ */
+#include "bench.h"
+#include "kernel.h"
+#include "shell_port.h"
+#include "Srv_OsCommon.h"
+#include "filter.h"
+#include "rpm_filter.h"
+#include "MadgwickAHRS.h"
+#include "pid.h"
+#include "rate_ctl.h"
+#include "adrc.h"
+#include "CusQueue.h"
+#include "linked_list.h"
+#include "binary_tree.h"
+#include "math_util.h"
+
+#define BENCH_SMOOTH_WINDOW_SIZE 10
+#define BENCH_RPM_MOTO_NUM 4
+#define BENCH_RPM_HARMONIC 3
+#define BENCH_QUEUE_BUF_SIZE 256
+#define BENCH_QUEUE_FRAME_SIZE 16
+#define BENCH_LIST_ITEM_NUM 32
+#define BENCH_TREE_NODE_NUM 64  /* power of 2 */
+#define BENCH_TREE_SCRAMBLE 37  /* odd, walk every key once in a scrambled order */
+#define BENCH_OVERHEAD_TRY 16
+
+typedef struct
+{
+    const char *name;
+    bool (*init)(void);
+    void (*step)(uint32_t i);
+} Bench_Case_TypeDef;
+
+/* internal vriable */
+static bool Bench_Input_Ready = false;
+static float Bench_Input[BENCH_INPUT_SIZE];
+static volatile float Bench_Sink = 0.0f;
+static bool Bench_Init_Done[Bench_Case_Sum] = {false};
+static uint32_t Bench_Init_Cyc[Bench_Case_Sum] = {0};
+static uint32_t Bench_Init_Alloc[Bench_Case_Sum] = {0};
+
+static BWF_Object_Handle Bench_BWF_Hdl = 0;
+static SW_Object_Handle Bench_SW_Hdl = 0;
+static RpmFilter_Obj_TypeDef Bench_RpmFilter;
+static MadgwickAHRS_Obj_TypeDef Bench_AHRS;
+static uint32_t Bench_AHRS_Tick = 0;
+static PIDObj_TypeDef Bench_PID;
+static PIDObj_TypeDef Bench_PID_3Axis[RATE_CTL_AXIS_NUM];
+static RateCtl_Obj_TypeDef Bench_RateCtl;
+static ADRC_ESO_Def Bench_ESO;
+static QueueObj_TypeDef Bench_Queue;
+static uint8_t Bench_Queue_Buf[BENCH_QUEUE_BUF_SIZE];
+static uint8_t Bench_Queue_Frame[BENCH_QUEUE_FRAME_SIZE];
+static item_obj Bench_List_Item[BENCH_LIST_ITEM_NUM];
+static Tree_TypeDef *Bench_Tree = NULL;
+static int16_t Bench_Tree_Key[BENCH_TREE_NODE_NUM];
+
+/* internal function */
+static void Bench_Input_Init(void);
+static uint32_t Bench_Get_AllocCnt(void);
+static uint32_t Bench_Get_CounterOverhead(void);
+
+static bool Bench_BWF_Init(void);
+static void Bench_BWF_Step(uint32_t i);
+static bool Bench_SW_Init(void);
+static void Bench_SW_Step(uint32_t i);
+static bool Bench_RpmFilter_Init(void);
+static void Bench_RpmFilter_Step(uint32_t i);
+static bool Bench_AHRS_Init(void);
+static void Bench_AHRS_Step(uint32_t i);
+static bool Bench_PID_Init(void);
+static void Bench_PID_Step(uint32_t i);
+static bool Bench_PID_3Axis_Init(void);
+static void Bench_PID_3Axis_Step(uint32_t i);
+static bool Bench_RateCtl_Init(void);
+static void Bench_RateCtl_Step(uint32_t i);
+static bool Bench_ESO_Init(void);
+static void Bench_ESO_Step(uint32_t i);
+static bool Bench_Fhan_Init(void);
+static void Bench_Fhan_Step(uint32_t i);
+static bool Bench_Queue_Init(void);
+static void Bench_Queue_Step(uint32_t i);
+static int Bench_List_Sum(item_obj *item, void *data, void *sum);
+static bool Bench_List_Init(void);
+static void Bench_List_Step(uint32_t i);
+static data_handle Bench_Tree_Compare(data_handle l_addr, data_handle r_addr);
+static uint8_t Bench_Tree_Match(data_handle node_addr, data_handle key_addr);
+static bool Bench_Tree_Init(void);
+static void Bench_Tree_Step(uint32_t i);
+static bool Bench_Math_Init(void);
+static void Bench_Atan2_Step(uint32_t i);
+static void Bench_Pow_Step(uint32_t i);
+
+/* external function */
+static bool Bench_Run(Bench_Case_List id, Bench_Result_TypeDef *result);
+static uint32_t Bench_Cyc_To_Ns(uint32_t cyc);
+
+static const Bench_Case_TypeDef Bench_Case[Bench_Case_Sum] = {
+    [Bench_Butterworth_Update]  = {"Butterworth.update",  Bench_BWF_Init,   Bench_BWF_Step},
+    [Bench_SmoothWindow_Update] = {"SmoothWindow.update", Bench_SW_Init,    Bench_SW_Step},
+    [Bench_RpmFilter_Apply]     = {"RpmFilter_Apply",     Bench_RpmFilter_Init, Bench_RpmFilter_Step},
+    [Bench_Madgwick_Update]     = {"MadgwickAHRS_Update", Bench_AHRS_Init,  Bench_AHRS_Step},
+    [Bench_PID_Update]          = {"PID_Update",          Bench_PID_Init,   Bench_PID_Step},
+    [Bench_PID_Update_3Axis]    = {"PID_Update x3",       Bench_PID_3Axis_Init, Bench_PID_3Axis_Step},
+    [Bench_RateCtl_Update]      = {"RateCtl_Update",      Bench_RateCtl_Init,   Bench_RateCtl_Step},
+    [Bench_ADRC_ESO]            = {"adrc_eso",            Bench_ESO_Init,   Bench_ESO_Step},
+    [Bench_ADRC_Fhan]           = {"adrc_fhan",           Bench_Fhan_Init,  Bench_Fhan_Step},
+    [Bench_Queue_PushPop]       = {"Queue.push/pop",      Bench_Queue_Init, Bench_Queue_Step},
+    [Bench_List_Traverse]       = {"List_traverse",       Bench_List_Init,  Bench_List_Step},
+    [Bench_Tree_Search]         = {"BalanceTree.Search",  Bench_Tree_Init,  Bench_Tree_Step},
+    [Bench_Fast_Atan2]          = {"Fast_Atan2f",         Bench_Math_Init,  Bench_Atan2_Step},
+    [Bench_Fast_Pow]            = {"Fast_Powf",           Bench_Math_Init,  Bench_Pow_Step},
+};
+
+Bench_TypeDef Bench = {
+    .run = Bench_Run,
+    .cyc_to_ns = Bench_Cyc_To_Ns,
+};
+
+/* triangle wave plus lcg noise, about -1.1 ~ 1.1 */
+static void Bench_Input_Init(void)
+{
+    uint32_t seed = 0x1234567;
+    int32_t tri = 0;
+
+    if (Bench_Input_Ready)
+        return;
+
+    for (uint32_t i = 0; i < BENCH_INPUT_SIZE; i++)
+    {
+        seed = seed * 1664525 + 1013904223;
+        tri = (i < (BENCH_INPUT_SIZE / 2)) ? (int32_t)i : (int32_t)(BENCH_INPUT_SIZE - i);
+
+        Bench_Input[i] = (float)(tri - BENCH_INPUT_SIZE / 4) / (float)(BENCH_INPUT_SIZE / 4);
+        Bench_Input[i] += (float)((int32_t)((seed >> 16) & 0xFF) - 128) / 1280.0f;
+    }
+
+    Bench_Input_Ready = true;
+}
+
+static uint32_t Bench_Get_AllocCnt(void)
+{
+    SrvOs_HeapStatus_TypeDef status;
+
+    memset(&status, 0, sizeof(status));
+    SrvOsCommon.get_heap_status(&status);
+
+    return status.xNumberOfSuccessfulAllocations;
+}
+
+/* cost of one counter read pair, taken off every single call sample */
+static uint32_t Bench_Get_CounterOverhead(void)
+{
+    uint32_t overhead = UINT32_MAX;
+    uint32_t cyc = 0;
+
+    for (uint8_t i = 0; i < BENCH_OVERHEAD_TRY; i++)
+    {
+        cyc = Kernel_Get_CycleCnt();
+        cyc = Kernel_Get_CycleCnt() - cyc;
+
+        if (cyc < overhead)
+            overhead = cyc;
+    }
+
+    return overhead;
+}
+
+/************************************************** filter section ************************************************/
+static bool Bench_BWF_Init(void)
+{
+    FilterParam_Obj_TypeDef *param = NULL;
+
+    /* gyro filter setup of the sample task */
+    CREATE_FILTER_PARAM_OBJ(Bench, 5, 50Hz, 1K, param);
+    Bench_BWF_Hdl = Butterworth.init(param);
+
+    return Bench_BWF_Hdl != 0;
+}
+
+static void Bench_BWF_Step(uint32_t i)
+{
+    Bench_Sink = Butterworth.update(Bench_BWF_Hdl, Bench_Input[i & (BENCH_INPUT_SIZE - 1)]);
+}
+
+static bool Bench_SW_Init(void)
+{
+    Bench_SW_Hdl = SmoothWindow.init(BENCH_SMOOTH_WINDOW_SIZE);
+
+    return Bench_SW_Hdl != 0;
+}
+
+static void Bench_SW_Step(uint32_t i)
+{
+    Bench_Sink = SmoothWindow.update(Bench_SW_Hdl, Bench_Input[i & (BENCH_INPUT_SIZE - 1)]);
+}
+
+/* gyro notch bank of SrvIMU on a quad, every notch in band, attenuation checked by Analysis_Tool/RpmFilterCheck */
+static bool Bench_RpmFilter_Init(void)
+{
+    if (!RpmFilter_Init(&Bench_RpmFilter, 1000.0f, BENCH_RPM_MOTO_NUM, BENCH_RPM_HARMONIC, 5.0f, 80.0f))
+        return false;
+
+    for (uint8_t m = 0; m < BENCH_RPM_MOTO_NUM; m++)
+        RpmFilter_Set_Freq(&Bench_RpmFilter, m, 120.0f + 10.0f * m);
+
+    return true;
+}
+
+/* one coefficient refresh plus 12 notch x 3 axis per call */
+static void Bench_RpmFilter_Step(uint32_t i)
+{
+    float gyr[RPM_FILTER_AXIS_NUM];
+
+    gyr[0] = Bench_Input[i & (BENCH_INPUT_SIZE - 1)];
+    gyr[1] = Bench_Input[(i + 13) & (BENCH_INPUT_SIZE - 1)];
+    gyr[2] = Bench_Input[(i + 26) & (BENCH_INPUT_SIZE - 1)];
+
+    RpmFilter_Apply(&Bench_RpmFilter, gyr);
+    Bench_Sink = gyr[0];
+}
+
+/************************************************** navigation section ************************************************/
+static bool Bench_AHRS_Init(void)
+{
+    Bench_AHRS_Tick = 0;
+
+    /* us time stamp, first update only latch the tick */
+    if (!MadgwickAHRS_Init(&Bench_AHRS, 0.1f, 1000000))
+        return false;
+
+    MadgwickAHRS_Update(&Bench_AHRS, Bench_AHRS_Tick, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f);
+    return true;
+}
+
+/* 1KHz imu step, no mag */
+static void Bench_AHRS_Step(uint32_t i)
+{
+    float in = Bench_Input[i & (BENCH_INPUT_SIZE - 1)];
+
+    Bench_AHRS_Tick += 1000;
+    MadgwickAHRS_Update(&Bench_AHRS, Bench_AHRS_Tick, in, -0.5f * in, 0.25f * in, 0.05f * in, -0.05f * in, 1.0f, 0.0f, 0.0f, 0.0f);
+    Bench_Sink = Bench_AHRS.q0;
+}
+
+/************************************************** control section ************************************************/
+static bool Bench_PID_Init(void)
+{
+    memset(&Bench_PID, 0, sizeof(Bench_PID));
+
+    Bench_PID.accuracy_scale = 1000;
+    Bench_PID.diff_max = 500.0f;
+    Bench_PID.diff_min = -500.0f;
+    Bench_PID.gP = 0.5f;
+    Bench_PID.gI = 0.01f;
+    Bench_PID.gI_Max = 100.0f;
+    Bench_PID.gI_Min = -100.0f;
+    Bench_PID.gD = 0.02f;
+    Bench_PID.CTL_period = 0.001f;
+
+    return true;
+}
+
+/* measurement follow the input, setpoint step so the integral clamp get exercised */
+static void Bench_PID_Step(uint32_t i)
+{
+    PID_Update(&Bench_PID, Bench_Input[i & (BENCH_INPUT_SIZE - 1)] * 300.0f, (i & 0x40) ? 300.0f : -300.0f);
+    Bench_Sink = Bench_PID.fout;
+}
+
+/* the angular speed loop before RateCtl, one PIDObj per axis */
+static bool Bench_PID_3Axis_Init(void)
+{
+    memset(Bench_PID_3Axis, 0, sizeof(Bench_PID_3Axis));
+
+    for (uint8_t axis = 0; axis < RATE_CTL_AXIS_NUM; axis++)
+    {
+        Bench_PID_3Axis[axis].accuracy_scale = 1000;
+        Bench_PID_3Axis[axis].diff_max = 500.0f;
+        Bench_PID_3Axis[axis].diff_min = -500.0f;
+        Bench_PID_3Axis[axis].gP = 0.5f;
+        Bench_PID_3Axis[axis].gI = 0.01f;
+        Bench_PID_3Axis[axis].gI_Max = 100.0f;
+        Bench_PID_3Axis[axis].gI_Min = -100.0f;
+        Bench_PID_3Axis[axis].gD = 0.02f;
+        Bench_PID_3Axis[axis].CTL_period = 0.001f;
+    }
+
+    return true;
+}
+
+static void Bench_PID_3Axis_Step(uint32_t i)
+{
+    float exp = (i & 0x40) ? 300.0f : -300.0f;
+
+    for (uint8_t axis = 0; axis < RATE_CTL_AXIS_NUM; axis++)
+        PID_Update(&Bench_PID_3Axis[axis], Bench_Input[(i + axis * 13) & (BENCH_INPUT_SIZE - 1)] * 300.0f, exp);
+
+    Bench_Sink = Bench_PID_3Axis[0].fout;
+}
+
+/* same gain and input as the PID x3 case, all axis in one call */
+static bool Bench_RateCtl_Init(void)
+{
+    if (!RateCtl_Init(&Bench_RateCtl, 0.001f))
+        return false;
+
+    for (uint8_t axis = 0; axis < RATE_CTL_AXIS_NUM; axis++)
+    {
+        RateCtl_Set_Gain(&Bench_RateCtl, axis, 0.5f, 10.0f, 0.00002f, 0.1f);
+        RateCtl_Set_Limit(&Bench_RateCtl, axis, 100.0f, 500.0f);
+        RateCtl_Set_DTermLpf(&Bench_RateCtl, axis, 100.0f);
+    }
+
+    return true;
+}
+
+static void Bench_RateCtl_Step(uint32_t i)
+{
+    float mea[RATE_CTL_AXIS_NUM];
+    float exp[RATE_CTL_AXIS_NUM];
+
+    for (uint8_t axis = 0; axis < RATE_CTL_AXIS_NUM; axis++)
+    {
+        mea[axis] = Bench_Input[(i + axis * 13) & (BENCH_INPUT_SIZE - 1)] * 300.0f;
+        exp[axis] = (i & 0x40) ? 300.0f : -300.0f;
+    }
+
+    RateCtl_Update(&Bench_RateCtl, mea, exp);
+    Bench_Sink = Bench_RateCtl.fout[0];
+}
+
+static bool Bench_ESO_Init(void)
+{
+    adrc_eso_init(&Bench_ESO, 0.001f, 100.0f, 300.0f, 0.5f, 0.01f, 1.0f);
+
+    return true;
+}
+
+static void Bench_ESO_Step(uint32_t i)
+{
+    adrc_eso(&Bench_ESO, Bench_Input[i & (BENCH_INPUT_SIZE - 1)]);
+    Bench_Sink = Bench_ESO.z2;
+}
+
+static bool Bench_Fhan_Init(void)
+{
+    return true;
+}
+
+static void Bench_Fhan_Step(uint32_t i)
+{
+    Bench_Sink = adrc_fhan(Bench_Input[i & (BENCH_INPUT_SIZE - 1)], Bench_Input[(i + 7) & (BENCH_INPUT_SIZE - 1)], 100.0f, 0.005f);
+}
+
+/************************************************** data structure section ************************************************/
+static bool Bench_Queue_Init(void)
+{
+    for (uint8_t i = 0; i < BENCH_QUEUE_FRAME_SIZE; i++)
+        Bench_Queue_Frame[i] = i;
+
+    return Queue.create_with_buf(&Bench_Queue, "bench queue", Bench_Queue_Buf, sizeof(Bench_Queue_Buf));
+}
+
+/* one log frame in then out, head and end walk around the whole buffer */
+static void Bench_Queue_Step(uint32_t i)
+{
+    (void)i;
+
+    Queue.push(&Bench_Queue, Bench_Queue_Frame, BENCH_QUEUE_FRAME_SIZE);
+    Queue.pop(&Bench_Queue, Bench_Queue_Frame, BENCH_QUEUE_FRAME_SIZE);
+}
+
+static int Bench_List_Sum(item_obj *item, void *data, void *sum)
+{
+    (void)item;
+
+    if (data && sum)
+        *((float *)sum) += *((float *)data);
+
+    return 1;
+}
+
+static bool Bench_List_Init(void)
+{
+    for (uint8_t i = 0; i < BENCH_LIST_ITEM_NUM; i++)
+    {
+        List_ItemInit(&Bench_List_Item[i], &Bench_Input[i]);
+
+        if (i > 0)
+        {
+            Bench_List_Item[i - 1].nxt = &Bench_List_Item[i];
+            Bench_List_Item[i].prv = &Bench_List_Item[i - 1];
+        }
+    }
+
+    return true;
+}
+
+static void Bench_List_Step(uint32_t i)
+{
+    float sum = 0.0f;
+
+    (void)i;
+
+    List_traverse(&Bench_List_Item[0], Bench_List_Sum, &sum, pre_callback);
+    Bench_Sink = sum;
+}
+
+/* return the smaller data handle, same rule as the error log tree */
+static data_handle Bench_Tree_Compare(data_handle l_addr, data_handle r_addr)
+{
+    if (*((int16_t *)l_addr) > *((int16_t *)r_addr))
+        return r_addr;
+
+    if (*((int16_t *)l_addr) < *((int16_t *)r_addr))
+        return l_addr;
+
+    return 0;
+}
+
+static uint8_t Bench_Tree_Match(data_handle node_addr, data_handle key_addr)
+{
+    if (*((int16_t *)node_addr) > *((int16_t *)key_addr))
+        return Tree_Search_L;
+
+    if (*((int16_t *)node_addr) < *((int16_t *)key_addr))
+        return Tree_Search_R;
+
+    return Tree_Search_D;
+}
+
+/* tree is built once, node insert cost and allocation show up in the init figure */
+static bool Bench_Tree_Init(void)
+{
+    uint16_t key = 0;
+
+    Bench_Tree = BalanceTree.Create("bench tree", Bench_Tree_Compare, Bench_Tree_Match, Bench_Tree_Compare);
+    if (Bench_Tree == NULL)
+        return false;
+
+    for (uint16_t i = 0; i < BENCH_TREE_NODE_NUM; i++)
+    {
+        key = (i * BENCH_TREE_SCRAMBLE) & (BENCH_TREE_NODE_NUM - 1);
+        Bench_Tree_Key[key] = (int16_t)key;
+
+        if (!BalanceTree.Insert(Bench_Tree, "bench node", (data_handle)&Bench_Tree_Key[key]))
+            return false;
+    }
+
+    return true;
+}
+
+static void Bench_Tree_Step(uint32_t i)
+{
+    Bench_Sink = (float)(BalanceTree.Search(Bench_Tree, (data_handle)&Bench_Tree_Key[(i * BENCH_TREE_SCRAMBLE) & (BENCH_TREE_NODE_NUM - 1)]) != 0);
+}
+
+/************************************************** math section ************************************************/
+/* accuracy is checked on host by Analysis_Tool/MathCheck, only the call cost is taken here */
+static bool Bench_Math_Init(void)
+{
+    return true;
+}
+
+/* attitude extraction */
+static void Bench_Atan2_Step(uint32_t i)
+{
+    Bench_Sink = Fast_Atan2f(Bench_Input[i & (BENCH_INPUT_SIZE - 1)], 0.5f);
+}
+
+/* baro pressure ratio to altitude */
+static void Bench_Pow_Step(uint32_t i)
+{
+    Bench_Sink = Fast_Powf(1.0f + 0.25f * Bench_Input[i & (BENCH_INPUT_SIZE - 1)], 0.1903f);
+}
+
+/************************************************** external function ************************************************/
+static bool Bench_Run(Bench_Case_List id, Bench_Result_TypeDef *result)
+{
+    const Bench_Case_TypeDef *bench_case = NULL;
+    uint32_t overhead = 0;
+    uint32_t alloc = 0;
+    uint32_t cyc = 0;
+    uint32_t i = 0;
+
+    if ((id >= Bench_Case_Sum) || (result == NULL))
+        return false;
+
+    bench_case = &Bench_Case[id];
+    Bench_Input_Init();
+
+    if (!Bench_Init_Done[id])
+    {
+        alloc = Bench_Get_AllocCnt();
+        cyc = Kernel_Get_CycleCnt();
+
+        if (!bench_case->init())
+            return false;
+
+        Bench_Init_Cyc[id] = Kernel_Get_CycleCnt() - cyc;
+        Bench_Init_Alloc[id] = Bench_Get_AllocCnt() - alloc;
+        Bench_Init_Done[id] = true;
+    }
+
+    memset(result, 0, sizeof(Bench_Result_TypeDef));
+    result->name = bench_case->name;
+    result->init_cyc = Bench_Init_Cyc[id];
+    result->init_alloc = Bench_Init_Alloc[id];
+    result->loop = BENCH_LOOP;
+    result->min_cyc = UINT32_MAX;
+
+    /* back to back, call through the case table is part of every sample */
+    alloc = Bench_Get_AllocCnt();
+    cyc = Kernel_Get_CycleCnt();
+    for (i = 0; i < BENCH_LOOP; i++)
+        bench_case->step(i);
+    result->loop_cyc = Kernel_Get_CycleCnt() - cyc;
+    result->alloc = Bench_Get_AllocCnt() - alloc;
+
+    /* single call spread */
+    overhead = Bench_Get_CounterOverhead();
+    for (i = 0; i < BENCH_LOOP; i++)
+    {
+        cyc = Kernel_Get_CycleCnt();
+        bench_case->step(i);
+        cyc = Kernel_Get_CycleCnt() - cyc;
+        cyc = (cyc > overhead) ? (cyc - overhead) : 0;
+
+        if (cyc < result->min_cyc)
+            result->min_cyc = cyc;
+
+        if (cyc > result->max_cyc)
+            result->max_cyc = cyc;
+    }
+
+    return true;
+}
+
+static uint32_t Bench_Cyc_To_Ns(uint32_t cyc)
+{
+    uint32_t clock = Kernel_Get_SysClock();
+
+    if (clock == 0)
+        return 0;
+
+    return (uint32_t)(((uint64_t)cyc * 1000000000ULL) / clock);
+}
+
+/************************************************** shell section ************************************************/
+static void Bench_Kernel(void)
+{
+    Shell *shell_obj = Shell_GetInstence();
+    Bench_Result_TypeDef result;
+    uint32_t avg = 0;
+
+    if (shell_obj == NULL)
+        return;
+
+    shellPrint(shell_obj, "\t[Kernel Bench] %d loop, sys clock %d Hz\r\n", BENCH_LOOP, Kernel_Get_SysClock());
+    shellPrint(shell_obj, "\tcase                  avg cyc   min   max  ns/op  alloc  init cyc / alloc\r\n");
+
+    for (uint8_t i = 0; i < Bench_Case_Sum; i++)
+    {
+        if (!Bench_Run((Bench_Case_List)i, &result))
+        {
+            shellPrint(shell_obj, "\t%-20s init failed\r\n", Bench_Case[i].name);
+            continue;
+        }
+
+        avg = result.loop_cyc / result.loop;
+        shellPrint(shell_obj, "\t%-20s %7d %5d %5d %6d %6d  %8d / %d\r\n",
+                   result.name, avg, result.min_cyc, result.max_cyc,
+                   Bench_Cyc_To_Ns(avg), result.alloc, result.init_cyc, result.init_alloc);
+    }
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Bench_Kernel, Bench_Kernel, Algorithm and data structure kernel cycle bench);
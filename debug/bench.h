@@ -0,0 +1,57 @@
+#ifndef __BENCH_H
+#define __BENCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * hot kernel micro benchmark
+ * every case run the same fixed input vector on target (dwt cycle) and on host (ns counter)
+ * time unit is the kernel cycle counter, Kernel_Get_SysClock give its frequency
+ */
+#define BENCH_LOOP 1024
+#define BENCH_INPUT_SIZE 64 /* power of 2 */
+
+typedef enum
+{
+    Bench_Butterworth_Update = 0,
+    Bench_SmoothWindow_Update,
+    Bench_RpmFilter_Apply,
+    Bench_Madgwick_Update,
+    Bench_PID_Update,
+    Bench_PID_Update_3Axis,
+    Bench_RateCtl_Update,
+    Bench_ADRC_ESO,
+    Bench_ADRC_Fhan,
+    Bench_Queue_PushPop,
+    Bench_List_Traverse,
+    Bench_Tree_Search,
+    Bench_Fast_Atan2,
+    Bench_Fast_Pow,
+    Bench_Case_Sum,
+} Bench_Case_List;
+
+typedef struct
+{
+    const char *name;
+
+    /* one time setup, tree / filter object are kept across run */
+    uint32_t init_cyc;
+    uint32_t init_alloc;
+
+    uint32_t loop;
+    uint32_t loop_cyc;  /* back to back loop, for average and throughput */
+    uint32_t min_cyc;   /* single call, counter overhead removed */
+    uint32_t max_cyc;
+    uint32_t alloc;     /* allocation inside the timed loop, hot path expect 0 */
+} Bench_Result_TypeDef;
+
+typedef struct
+{
+    bool (*run)(Bench_Case_List id, Bench_Result_TypeDef *result);
+    uint32_t (*cyc_to_ns)(uint32_t cyc);
+} Bench_TypeDef;
+
+extern Bench_TypeDef Bench;
+
+#endif
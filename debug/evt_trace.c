@@ -0,0 +1,208 @@
+/*
+ * binary event trace ring
+ * record path is one atomic increment and one 8 byte store, no lock and no branch on the ring state
+ * an event reserved right before a freeze may still land while exporting, only the latest one can be torn
+ */
+#include "evt_trace.h"
+#include "kernel.h"
+#include "cmsis_os.h"
+#include "shell_port.h"
+
+#define EVT_TRACE_EXPORT_CHUNK 64 /* event per export callback */
+
+typedef struct
+{
+    volatile bool enable;
+    volatile uint32_t head;     /* total event reserved since enabled */
+} EvtTrace_Monitor_TypeDef;
+
+/* internal vriable */
+static EvtTrace_Monitor_TypeDef EvtTrace_Monitor = {
+    .enable = true,
+    .head = 0,
+};
+static EvtTrace_Event_TypeDef EvtTrace_Ring[EVT_TRACE_RING_SIZE];
+static TaskStatus_t EvtTrace_TaskStatus[EVT_TRACE_TASK_MAX];
+
+/* internal function */
+static uint8_t EvtTrace_Get_TaskNum(void);
+static uint32_t EvtTrace_Get_EventNum(void);
+
+/* external function */
+static void EvtTrace_Enable(bool state);
+static bool EvtTrace_Is_Enable(void);
+static void EvtTrace_Record(EvtTrace_Event_List id, uint8_t sub, uint16_t arg);
+static uint32_t EvtTrace_Get_ImageSize(void);
+static uint32_t EvtTrace_Export(EvtTrace_Export_Callback callback, void *arg);
+
+EvtTrace_TypeDef EvtTrace = {
+    .enable = EvtTrace_Enable,
+    .is_enable = EvtTrace_Is_Enable,
+    .record = EvtTrace_Record,
+    .get_image_size = EvtTrace_Get_ImageSize,
+    .export = EvtTrace_Export,
+};
+
+/* start from an empty ring each time recording is enabled */
+static void EvtTrace_Enable(bool state)
+{
+    if (state && !EvtTrace_Monitor.enable)
+        EvtTrace_Monitor.head = 0;
+
+    EvtTrace_Monitor.enable = state;
+}
+
+static bool EvtTrace_Is_Enable(void)
+{
+    return EvtTrace_Monitor.enable;
+}
+
+static void EvtTrace_Record(EvtTrace_Event_List id, uint8_t sub, uint16_t arg)
+{
+    EvtTrace_Event_TypeDef *p_evt = NULL;
+
+    if (!EvtTrace_Monitor.enable)
+        return;
+
+    p_evt = &EvtTrace_Ring[__atomic_fetch_add(&EvtTrace_Monitor.head, 1, __ATOMIC_RELAXED) & (EVT_TRACE_RING_SIZE - 1)];
+    p_evt->cyc = Kernel_Get_CycleCnt();
+    p_evt->id = id;
+    p_evt->sub = sub;
+    p_evt->arg = arg;
+}
+
+/* number is the tcb number, same as xTaskNumber in the task state table */
+void EvtTrace_Task_SwitchIn(uint32_t number)
+{
+    EvtTrace_Record(EvtTrace_Task_In, (uint8_t)number, 0);
+}
+
+void EvtTrace_Task_SwitchOut(uint32_t number)
+{
+    EvtTrace_Record(EvtTrace_Task_Out, (uint8_t)number, 0);
+}
+
+static uint8_t EvtTrace_Get_TaskNum(void)
+{
+    UBaseType_t task_num = uxTaskGetNumberOfTasks();
+
+    return (task_num > EVT_TRACE_TASK_MAX) ? EVT_TRACE_TASK_MAX : (uint8_t)task_num;
+}
+
+static uint32_t EvtTrace_Get_EventNum(void)
+{
+    return (EvtTrace_Monitor.head > EVT_TRACE_RING_SIZE) ? EVT_TRACE_RING_SIZE : EvtTrace_Monitor.head;
+}
+
+/* freeze recording first, otherwise the image keep growing */
+static uint32_t EvtTrace_Get_ImageSize(void)
+{
+    return sizeof(EvtTrace_Header_TypeDef) +
+           EvtTrace_Get_TaskNum() * sizeof(EvtTrace_Task_TypeDef) +
+           EvtTrace_Get_EventNum() * sizeof(EvtTrace_Event_TypeDef);
+}
+
+/* stop recording and stream the image out, return byte exported */
+static uint32_t EvtTrace_Export(EvtTrace_Export_Callback callback, void *arg)
+{
+    EvtTrace_Header_TypeDef header;
+    EvtTrace_Task_TypeDef task;
+    UBaseType_t status_num = 0;
+    uint32_t index = 0;
+    uint32_t remain = 0;
+    uint32_t chunk = 0;
+    uint32_t size = 0;
+
+    if (callback == NULL)
+        return 0;
+
+    EvtTrace_Monitor.enable = false;
+
+    memset(&header, 0, sizeof(header));
+    header.magic = EVT_TRACE_MAGIC;
+    header.version = EVT_TRACE_VERSION;
+    header.header_size = sizeof(EvtTrace_Header_TypeDef);
+    header.clock = Kernel_Get_SysClock();
+    header.event_num = EvtTrace_Get_EventNum();
+    header.lost_num = EvtTrace_Monitor.head - header.event_num;
+    header.task_num = EvtTrace_Get_TaskNum();
+
+    callback(arg, (const uint8_t *)&header, sizeof(header));
+    size += sizeof(header);
+
+    /* task created after the size was taken is dropped, missing one padded, image size stay as announced */
+    status_num = uxTaskGetSystemState(EvtTrace_TaskStatus, EVT_TRACE_TASK_MAX, NULL);
+    for (uint8_t i = 0; i < header.task_num; i++)
+    {
+        memset(&task, 0, sizeof(task));
+
+        if (i < status_num)
+        {
+            task.number = EvtTrace_TaskStatus[i].xTaskNumber;
+            strncpy(task.name, EvtTrace_TaskStatus[i].pcTaskName, EVT_TRACE_TASK_NAME_LEN - 1);
+        }
+
+        callback(arg, (const uint8_t *)&task, sizeof(task));
+        size += sizeof(task);
+    }
+
+    /* oldest event first, ring wrap split the copy in two */
+    index = (EvtTrace_Monitor.head - header.event_num) & (EVT_TRACE_RING_SIZE - 1);
+    remain = header.event_num;
+    while (remain)
+    {
+        chunk = EVT_TRACE_RING_SIZE - index;
+
+        if (chunk > remain)
+            chunk = remain;
+
+        if (chunk > EVT_TRACE_EXPORT_CHUNK)
+            chunk = EVT_TRACE_EXPORT_CHUNK;
+
+        callback(arg, (const uint8_t *)&EvtTrace_Ring[index], chunk * sizeof(EvtTrace_Event_TypeDef));
+        size += chunk * sizeof(EvtTrace_Event_TypeDef);
+
+        index = (index + chunk) & (EVT_TRACE_RING_SIZE - 1);
+        remain -= chunk;
+    }
+
+    return size;
+}
+
+/************************************************** shell section ************************************************/
+static void EvtTrace_Shell_Write(void *arg, const uint8_t *p_data, uint16_t size)
+{
+    ((Shell *)arg)->write((const char *)p_data, size);
+}
+
+static void Trace_Ctl(uint8_t state)
+{
+    Shell *shell_obj = Shell_GetInstence();
+
+    if (shell_obj == NULL)
+        return;
+
+    EvtTrace_Enable(state);
+    shellPrint(shell_obj, "\t[Trace] %s, ring %d event, %d recorded\r\n", state ? "recording" : "stopped",
+               EVT_TRACE_RING_SIZE, EvtTrace_Monitor.head);
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Trace_Ctl, Trace_Ctl, Event trace recording 1 start 0 stop);
+
+/*
+ * same framing as Blackbox_Dump, raw image between start and end tag
+ * recording stay stopped after the dump, restart it with Trace_Ctl 1
+ */
+static void Trace_Dump(void)
+{
+    Shell *shell_obj = Shell_GetInstence();
+
+    if (shell_obj == NULL)
+        return;
+
+    EvtTrace_Enable(false);
+
+    shellPrint(shell_obj, "[Trace Dump Start] %d\r\n", EvtTrace_Get_ImageSize());
+    EvtTrace_Export(EvtTrace_Shell_Write, shell_obj);
+    shellPrint(shell_obj, "\r\n[Trace Dump End]\r\n");
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Trace_Dump, Trace_Dump, Dump event trace image);
@@ -0,0 +1,86 @@
+#ifndef __EVT_TRACE_H
+#define __EVT_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * binary event trace
+ * every event is cycle counter + event id + sub id + argument, 8 byte, kept in a ram ring
+ * writer only reserve one slot by atomic increment, task and interrupt can record without lock
+ * ring overwrite the oldest event, a dump freeze recording and export the latest EVT_TRACE_RING_SIZE events
+ *
+ * exported image : header + task name table + events from oldest to latest
+ * host side Analysis_Tool/Trace2Json convert the image into chrome / perfetto trace json
+ */
+#define EVT_TRACE_RING_SIZE 2048 /* power of 2 */
+#define EVT_TRACE_TASK_MAX 16
+#define EVT_TRACE_TASK_NAME_LEN 16
+
+#define EVT_TRACE_MAGIC 0x31435254 /* "TRC1" */
+#define EVT_TRACE_VERSION 1
+
+typedef enum
+{
+    EvtTrace_None = 0,
+    EvtTrace_Task_In,           /* sub: task number */
+    EvtTrace_Task_Out,          /* sub: task number */
+    EvtTrace_Pipe_Start,        /* arg: data size */
+    EvtTrace_Pipe_Finish,       /* sub: 0 done 1 error */
+    EvtTrace_SPI_Start,         /* sub: 0 tx 1 rx 2 tx rx, arg: size */
+    EvtTrace_SPI_End,           /* sub: 0 error 1 done */
+    EvtTrace_IIC_Start,         /* sub: device address, arg: size */
+    EvtTrace_IIC_End,           /* sub: 0 error 1 done */
+    EvtTrace_Uart_Rx,           /* sub: port, arg: size */
+    EvtTrace_Uart_Tx,           /* sub: port */
+    EvtTrace_Log_Flush_Start,   /* arg: size */
+    EvtTrace_Log_Flush_End,     /* sub: 0 error 1 done */
+    EvtTrace_Sum,
+} EvtTrace_Event_List;
+
+typedef void (*EvtTrace_Export_Callback)(void *arg, const uint8_t *p_data, uint16_t size);
+
+typedef struct
+{
+    uint32_t cyc;
+    uint8_t id;
+    uint8_t sub;
+    uint16_t arg;
+} EvtTrace_Event_TypeDef;
+
+#pragma pack(1)
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t clock;         /* cycle counter frequency, unit: Hz */
+    uint32_t event_num;
+    uint32_t lost_num;      /* event overwritten before the dump */
+    uint8_t task_num;
+    uint8_t res[3];
+} EvtTrace_Header_TypeDef;
+
+typedef struct
+{
+    uint32_t number;
+    char name[EVT_TRACE_TASK_NAME_LEN];
+} EvtTrace_Task_TypeDef;
+#pragma pack()
+
+typedef struct
+{
+    void (*enable)(bool state);
+    bool (*is_enable)(void);
+    void (*record)(EvtTrace_Event_List id, uint8_t sub, uint16_t arg);
+    uint32_t (*get_image_size)(void);
+    uint32_t (*export)(EvtTrace_Export_Callback callback, void *arg);
+} EvtTrace_TypeDef;
+
+extern EvtTrace_TypeDef EvtTrace;
+
+/* freertos task switch hook, called from traceTASK_SWITCHED_IN / OUT with the tcb number */
+void EvtTrace_Task_SwitchIn(uint32_t number);
+void EvtTrace_Task_SwitchOut(uint32_t number);
+
+#endif
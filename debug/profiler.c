@@ -0,0 +1,363 @@
+/*
+ * runtime profiler
+ * freertos run time counter is the kernel cycle counter, 32 bit wrap every few second on target
+ * so every figure is taken as the delta over one sample window, never as an absolute value
+ */
+#include "profiler.h"
+#include "kernel.h"
+#include "cmsis_os.h"
+#include "Srv_OsCommon.h"
+#include "shell_port.h"
+
+#define PROFILER_LOAD_SCALE 10000
+#define PROFILER_IDLE_TASK_NAME "IDLE"
+
+typedef struct
+{
+    uint32_t lst_sample_cyc;
+    uint32_t lst_isr_cyc;
+
+    /* isr nest level and the cycle every level started, level 0 is the outer most one
+     * same source can nest into itself (exti / dma line at different priority), so start is kept per level not per source */
+    uint32_t isr_depth;
+    uint32_t isr_start_cyc[PROFILER_ISR_NEST_MAX];
+    uint32_t isr_total_cyc;
+
+    Profiler_Summary_TypeDef summary;
+} Profiler_Monitor_TypeDef;
+
+/* internal vriable */
+static Profiler_Monitor_TypeDef Profiler_Monitor;
+static Profiler_Task_TypeDef Profiler_Task[PROFILER_TASK_MAX];
+static TaskStatus_t Profiler_TaskStatus[PROFILER_TASK_MAX];
+
+static Profiler_Section_TypeDef Profiler_Section[Profiler_Sec_Sum] = {
+    [Profiler_Sec_Sample]    = {.name = "sample"},
+    [Profiler_Sec_Control]   = {.name = "control"},
+    [Profiler_Sec_Navi]      = {.name = "navi"},
+    [Profiler_Sec_EKF]       = {.name = "ekf"},
+    [Profiler_Sec_Telemetry] = {.name = "telemetry"},
+    [Profiler_Sec_Log]       = {.name = "log"},
+    [Profiler_Sec_FrameCTL]  = {.name = "framectl"},
+};
+
+static Profiler_Isr_TypeDef Profiler_Isr[Profiler_Isr_Sum] = {
+    [Profiler_Isr_Tick]  = {.name = "tick"},
+    [Profiler_Isr_Exti]  = {.name = "exti"},
+    [Profiler_Isr_DMA]   = {.name = "dma"},
+    [Profiler_Isr_Uart]  = {.name = "uart"},
+    [Profiler_Isr_IIC]   = {.name = "iic"},
+    [Profiler_Isr_USB]   = {.name = "usb"},
+    [Profiler_Isr_SDMMC] = {.name = "sdmmc"},
+    [Profiler_Isr_Timer] = {.name = "timer"},
+};
+
+/* internal function */
+static Profiler_Task_TypeDef *Profiler_Get_TaskSlot(uint32_t number, const char *name);
+static uint16_t Profiler_Get_Load(uint32_t cyc, uint32_t window);
+
+/* external function */
+static void Profiler_Set_Budget(Profiler_Section_List sec, uint32_t budget_us);
+static void Profiler_Section_End(Profiler_Section_List sec, uint32_t start_cyc);
+static void Profiler_Isr_Enter(Profiler_Isr_List isr);
+static void Profiler_Isr_Exit(Profiler_Isr_List isr);
+static void Profiler_Sample(void);
+static void Profiler_Reset(void);
+static bool Profiler_Get_Summary(Profiler_Summary_TypeDef *summary);
+static bool Profiler_Get_Task(uint8_t index, Profiler_Task_TypeDef *task);
+static bool Profiler_Get_Section(Profiler_Section_List sec, Profiler_Section_TypeDef *section);
+static bool Profiler_Get_Isr(Profiler_Isr_List isr, Profiler_Isr_TypeDef *isr_stat);
+
+Profiler_TypeDef Profiler = {
+    .set_budget = Profiler_Set_Budget,
+    .section_end = Profiler_Section_End,
+    .isr_enter = Profiler_Isr_Enter,
+    .isr_exit = Profiler_Isr_Exit,
+    .sample = Profiler_Sample,
+    .reset = Profiler_Reset,
+    .get_summary = Profiler_Get_Summary,
+    .get_task = Profiler_Get_Task,
+    .get_section = Profiler_Get_Section,
+    .get_isr = Profiler_Get_Isr,
+};
+
+static void Profiler_Set_Budget(Profiler_Section_List sec, uint32_t budget_us)
+{
+    if (sec >= Profiler_Sec_Sum)
+        return;
+
+    Profiler_Section[sec].budget_cyc = (Kernel_Get_SysClock() / 1000000) * budget_us;
+}
+
+/* only the task owning the section update it, no lock on this path */
+static void Profiler_Section_End(Profiler_Section_List sec, uint32_t start_cyc)
+{
+    Profiler_Section_TypeDef *p_sec = NULL;
+    uint32_t cyc = 0;
+
+    if (sec >= Profiler_Sec_Sum)
+        return;
+
+    cyc = Kernel_Get_CycleCnt() - start_cyc;
+    p_sec = &Profiler_Section[sec];
+
+    if ((p_sec->cnt == 0) || (cyc < p_sec->min_cyc))
+        p_sec->min_cyc = cyc;
+
+    if (cyc > p_sec->max_cyc)
+        p_sec->max_cyc = cyc;
+
+    if (p_sec->budget_cyc && (cyc > p_sec->budget_cyc))
+        p_sec->overrun_cnt ++;
+
+    p_sec->last_cyc = cyc;
+    p_sec->sum_cyc += cyc;
+    p_sec->cnt ++;
+}
+
+/* a nested interrupt always complete before the one it preempt, depth need no lock */
+static void Profiler_Isr_Enter(Profiler_Isr_List isr)
+{
+    uint32_t cyc = Kernel_Get_CycleCnt();
+
+    if (isr >= Profiler_Isr_Sum)
+        return;
+
+    /* level deeper than the stack still count depth, only its own time is not taken */
+    if (Profiler_Monitor.isr_depth < PROFILER_ISR_NEST_MAX)
+        Profiler_Monitor.isr_start_cyc[Profiler_Monitor.isr_depth] = cyc;
+
+    Profiler_Monitor.isr_depth ++;
+}
+
+static void Profiler_Isr_Exit(Profiler_Isr_List isr)
+{
+    uint32_t cyc = Kernel_Get_CycleCnt();
+    uint32_t exec_cyc = 0;
+
+    if ((isr >= Profiler_Isr_Sum) || (Profiler_Monitor.isr_depth == 0))
+        return;
+
+    Profiler_Monitor.isr_depth --;
+    if (Profiler_Monitor.isr_depth >= PROFILER_ISR_NEST_MAX)
+        return;
+
+    exec_cyc = cyc - Profiler_Monitor.isr_start_cyc[Profiler_Monitor.isr_depth];
+    Profiler_Isr[isr].cnt ++;
+    Profiler_Isr[isr].sum_cyc += exec_cyc;
+
+    if (exec_cyc > Profiler_Isr[isr].max_cyc)
+        Profiler_Isr[isr].max_cyc = exec_cyc;
+
+    if (Profiler_Monitor.isr_depth == 0)
+        Profiler_Monitor.isr_total_cyc += exec_cyc;
+}
+
+static uint16_t Profiler_Get_Load(uint32_t cyc, uint32_t window)
+{
+    uint64_t load = 0;
+
+    if (window == 0)
+        return 0;
+
+    load = ((uint64_t)cyc * PROFILER_LOAD_SCALE) / window;
+
+    return (load > PROFILER_LOAD_SCALE) ? PROFILER_LOAD_SCALE : (uint16_t)load;
+}
+
+static Profiler_Task_TypeDef *Profiler_Get_TaskSlot(uint32_t number, const char *name)
+{
+    Profiler_Task_TypeDef *slot = NULL;
+
+    for (uint8_t i = 0; i < Profiler_Monitor.summary.task_num; i++)
+    {
+        if (Profiler_Task[i].number == number)
+            return &Profiler_Task[i];
+    }
+
+    if (Profiler_Monitor.summary.task_num >= PROFILER_TASK_MAX)
+        return NULL;
+
+    slot = &Profiler_Task[Profiler_Monitor.summary.task_num];
+    memset(slot, 0, sizeof(Profiler_Task_TypeDef));
+    slot->number = number;
+    strncpy(slot->name, name, PROFILER_TASK_NAME_LEN - 1);
+    Profiler_Monitor.summary.task_num ++;
+
+    return slot;
+}
+
+/* call it periodically from a low priority task, only take effect once per window */
+static void Profiler_Sample(void)
+{
+    Profiler_Task_TypeDef *slot = NULL;
+    uint32_t now = Kernel_Get_CycleCnt();
+    uint32_t window = now - Profiler_Monitor.lst_sample_cyc;
+    uint32_t isr_cyc = 0;
+    uint16_t idle_load = 0;
+    UBaseType_t task_num = 0;
+
+    if (window < ((Kernel_Get_SysClock() / 1000) * PROFILER_WINDOW_MS))
+        return;
+
+    task_num = uxTaskGetSystemState(Profiler_TaskStatus, PROFILER_TASK_MAX, NULL);
+
+    /* task state list order change with task state, match slot by task number */
+    for (UBaseType_t i = 0; i < task_num; i++)
+    {
+        slot = Profiler_Get_TaskSlot(Profiler_TaskStatus[i].xTaskNumber, Profiler_TaskStatus[i].pcTaskName);
+        if (slot == NULL)
+            continue;
+
+        /* first window of a task only latch its counter */
+        if (Profiler_Monitor.summary.window_cnt)
+            slot->load = Profiler_Get_Load(Profiler_TaskStatus[i].ulRunTimeCounter - slot->lst_run_cyc, window);
+
+        slot->lst_run_cyc = Profiler_TaskStatus[i].ulRunTimeCounter;
+        slot->stack_free = (uint16_t)Profiler_TaskStatus[i].usStackHighWaterMark;
+
+        if (strcmp(slot->name, PROFILER_IDLE_TASK_NAME) == 0)
+            idle_load = slot->load;
+    }
+
+    SrvOsCommon.enter_critical();
+    isr_cyc = Profiler_Monitor.isr_total_cyc - Profiler_Monitor.lst_isr_cyc;
+    Profiler_Monitor.lst_isr_cyc = Profiler_Monitor.isr_total_cyc;
+    SrvOsCommon.exit_critical();
+
+    if (Profiler_Monitor.summary.window_cnt)
+    {
+        Profiler_Monitor.summary.cpu_load = PROFILER_LOAD_SCALE - idle_load;
+        Profiler_Monitor.summary.isr_load = Profiler_Get_Load(isr_cyc, window);
+    }
+
+    Profiler_Monitor.lst_sample_cyc = now;
+    Profiler_Monitor.summary.window_cnt ++;
+}
+
+/* clear section and isr statistic, budget and task window keep going */
+static void Profiler_Reset(void)
+{
+    SrvOsCommon.enter_critical();
+
+    for (uint8_t i = 0; i < Profiler_Sec_Sum; i++)
+    {
+        Profiler_Section[i].cnt = 0;
+        Profiler_Section[i].last_cyc = 0;
+        Profiler_Section[i].min_cyc = 0;
+        Profiler_Section[i].max_cyc = 0;
+        Profiler_Section[i].sum_cyc = 0;
+        Profiler_Section[i].overrun_cnt = 0;
+    }
+
+    for (uint8_t i = 0; i < Profiler_Isr_Sum; i++)
+    {
+        Profiler_Isr[i].cnt = 0;
+        Profiler_Isr[i].max_cyc = 0;
+        Profiler_Isr[i].sum_cyc = 0;
+    }
+
+    SrvOsCommon.exit_critical();
+}
+
+static bool Profiler_Get_Summary(Profiler_Summary_TypeDef *summary)
+{
+    if (summary == NULL)
+        return false;
+
+    *summary = Profiler_Monitor.summary;
+    return Profiler_Monitor.summary.window_cnt > 1;
+}
+
+static bool Profiler_Get_Task(uint8_t index, Profiler_Task_TypeDef *task)
+{
+    if ((task == NULL) || (index >= Profiler_Monitor.summary.task_num))
+        return false;
+
+    *task = Profiler_Task[index];
+    return true;
+}
+
+static bool Profiler_Get_Section(Profiler_Section_List sec, Profiler_Section_TypeDef *section)
+{
+    if ((section == NULL) || (sec >= Profiler_Sec_Sum))
+        return false;
+
+    SrvOsCommon.enter_critical();
+    *section = Profiler_Section[sec];
+    SrvOsCommon.exit_critical();
+
+    return true;
+}
+
+static bool Profiler_Get_Isr(Profiler_Isr_List isr, Profiler_Isr_TypeDef *isr_stat)
+{
+    if ((isr_stat == NULL) || (isr >= Profiler_Isr_Sum))
+        return false;
+
+    SrvOsCommon.enter_critical();
+    *isr_stat = Profiler_Isr[isr];
+    SrvOsCommon.exit_critical();
+
+    return true;
+}
+
+/************************************************** shell section ************************************************/
+static void Profiler_Info(uint8_t reset)
+{
+    Shell *shell_obj = Shell_GetInstence();
+    Profiler_Summary_TypeDef summary;
+    Profiler_Task_TypeDef task;
+    Profiler_Section_TypeDef section;
+    Profiler_Isr_TypeDef isr;
+    uint32_t cyc_per_us = Kernel_Get_SysClock() / 1000000;
+
+    if (shell_obj == NULL)
+        return;
+
+    if (cyc_per_us == 0)
+        cyc_per_us = 1;
+
+    if (!Profiler_Get_Summary(&summary))
+    {
+        shellPrint(shell_obj, "\t[Profiler] first window not closed yet\r\n");
+        return;
+    }
+
+    shellPrint(shell_obj, "\t[Profiler] window %d ms, cpu load %d.%02d %%, isr load %d.%02d %%\r\n", PROFILER_WINDOW_MS,
+               summary.cpu_load / 100, summary.cpu_load % 100, summary.isr_load / 100, summary.isr_load % 100);
+
+    shellPrint(shell_obj, "\r\n\ttask             load(%%)  stack free(word)\r\n");
+    for (uint8_t i = 0; Profiler_Get_Task(i, &task); i++)
+        shellPrint(shell_obj, "\t%-16s %3d.%02d   %d\r\n", task.name, task.load / 100, task.load % 100, task.stack_free);
+
+    shellPrint(shell_obj, "\r\n\tsection      cnt      min(us)  avg(us)  max(us)  budget(us)  overrun\r\n");
+    for (uint8_t i = 0; i < Profiler_Sec_Sum; i++)
+    {
+        Profiler_Get_Section((Profiler_Section_List)i, &section);
+        if (section.cnt == 0)
+            continue;
+
+        shellPrint(shell_obj, "\t%-12s %-8d %-8d %-8d %-8d %-11d %d\r\n", section.name, section.cnt,
+                   section.min_cyc / cyc_per_us, (uint32_t)(section.sum_cyc / section.cnt) / cyc_per_us,
+                   section.max_cyc / cyc_per_us, section.budget_cyc / cyc_per_us, section.overrun_cnt);
+    }
+
+    shellPrint(shell_obj, "\r\n\tisr          cnt      avg(us)  max(us)\r\n");
+    for (uint8_t i = 0; i < Profiler_Isr_Sum; i++)
+    {
+        Profiler_Get_Isr((Profiler_Isr_List)i, &isr);
+        if (isr.cnt == 0)
+            continue;
+
+        shellPrint(shell_obj, "\t%-12s %-8d %-8d %d\r\n", isr.name, isr.cnt,
+                   (uint32_t)(isr.sum_cyc / isr.cnt) / cyc_per_us, isr.max_cyc / cyc_per_us);
+    }
+
+    if (reset)
+    {
+        Profiler_Reset();
+        shellPrint(shell_obj, "\r\n\tsection and isr statistic cleared\r\n");
+    }
+}
+SHELL_EXPORT_CMD(SHELL_CMD_PERMISSION(0) | SHELL_CMD_TYPE(SHELL_TYPE_CMD_FUNC) | SHELL_CMD_DISABLE_RETURN, Profiler_Info, Profiler_Info, task load stack section and isr time (arg 1 clear after print));
@@ -0,0 +1,100 @@
+#ifndef __PROFILER_H
+#define __PROFILER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * runtime profiler on the kernel cycle counter (dwt on target)
+ *   task    : freertos run time stats sampled once per window, load and stack high water mark
+ *   section : task loop execution time against its period budget, min / avg / max and overrun count
+ *   isr     : interrupt time per source, nested interrupt only counted once in the total
+ */
+#define PROFILER_TASK_MAX 12
+#define PROFILER_TASK_NAME_LEN 16
+#define PROFILER_WINDOW_MS 1000
+#define PROFILER_ISR_NEST_MAX 8
+
+typedef enum
+{
+    Profiler_Sec_Sample = 0,
+    Profiler_Sec_Control,
+    Profiler_Sec_Navi,
+    Profiler_Sec_EKF,
+    Profiler_Sec_Telemetry,
+    Profiler_Sec_Log,
+    Profiler_Sec_FrameCTL,
+    Profiler_Sec_Sum,
+} Profiler_Section_List;
+
+typedef enum
+{
+    Profiler_Isr_Tick = 0,
+    Profiler_Isr_Exti,
+    Profiler_Isr_DMA,
+    Profiler_Isr_Uart,
+    Profiler_Isr_IIC,
+    Profiler_Isr_USB,
+    Profiler_Isr_SDMMC,
+    Profiler_Isr_Timer,
+    Profiler_Isr_Sum,
+} Profiler_Isr_List;
+
+typedef struct
+{
+    const char *name;
+    uint32_t budget_cyc;    /* 0 means no budget */
+
+    uint32_t cnt;
+    uint32_t last_cyc;
+    uint32_t min_cyc;
+    uint32_t max_cyc;
+    uint64_t sum_cyc;
+    uint32_t overrun_cnt;
+} Profiler_Section_TypeDef;
+
+typedef struct
+{
+    const char *name;
+
+    uint32_t cnt;
+    uint32_t max_cyc;
+    uint64_t sum_cyc;
+} Profiler_Isr_TypeDef;
+
+typedef struct
+{
+    char name[PROFILER_TASK_NAME_LEN];
+    uint32_t number;        /* freertos task number, stay the same for the task life */
+    uint32_t lst_run_cyc;
+
+    uint16_t load;          /* unit: 0.01% of the last window */
+    uint16_t stack_free;    /* minimum free stack since task created, unit: word */
+} Profiler_Task_TypeDef;
+
+typedef struct
+{
+    uint32_t window_cnt;
+    uint16_t cpu_load;      /* unit: 0.01%, everything but idle */
+    uint16_t isr_load;      /* unit: 0.01% */
+    uint8_t task_num;
+} Profiler_Summary_TypeDef;
+
+typedef struct
+{
+    void (*set_budget)(Profiler_Section_List sec, uint32_t budget_us);
+    void (*section_end)(Profiler_Section_List sec, uint32_t start_cyc);
+    void (*isr_enter)(Profiler_Isr_List isr);
+    void (*isr_exit)(Profiler_Isr_List isr);
+    void (*sample)(void);
+    void (*reset)(void);
+
+    bool (*get_summary)(Profiler_Summary_TypeDef *summary);
+    bool (*get_task)(uint8_t index, Profiler_Task_TypeDef *task);
+    bool (*get_section)(Profiler_Section_List sec, Profiler_Section_TypeDef *section);
+    bool (*get_isr)(Profiler_Isr_List isr, Profiler_Isr_TypeDef *isr_stat);
+} Profiler_TypeDef;
+
+extern Profiler_TypeDef Profiler;
+
+#endif